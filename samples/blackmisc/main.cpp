@@ -55,6 +55,16 @@ int main(int argc, char *argv[])
         qtout << "6e .. string utils vs.regex" << Qt::endl;
         qtout << "6f .. string concatenation (+=, arg, ..)" << Qt::endl;
         qtout << "6g .. const &QString vs. QStringLiteral" << Qt::endl;
+        qtout << "6h .. FSD line parsing (synthetic or raw FSD message log)" << Qt::endl;
+        qtout << "6i .. FSD positions, queued calls vs. lock-free queue" << Qt::endl;
+        qtout << "6j .. Store situations, single vs. batch (2000 aircraft, 5Hz)" << Qt::endl;
+        qtout << "6k .. Interpolator situation lookups, list vs. compact situations (1000 aircraft)" << Qt::endl;
+        qtout << "6l .. Interpolation kernels, objects vs. batch scalar/SIMD (1000 tracks)" << Qt::endl;
+        qtout << "6m .. Model cache file, JSON vs. binary (40000 models)" << Qt::endl;
+        qtout << "6n .. Matching reduction steps, list vs. indexed model set (30000 models)" << Qt::endl;
+        qtout << "6o .. Model string search, linear vs. trigram index (40000 strings)" << Qt::endl;
+        qtout << "6p .. X-Plane traffic per frame, DBus vectors vs. shared memory (500 planes)" << Qt::endl;
+        qtout << "6q .. Geo lookups, linear vs. spatial index (50000 airports, 10000 elevations)" << Qt::endl;
         qtout << "7 .. Algorithms" << Qt::endl;
         qtout << "8 .. File/Directory" << Qt::endl;
         qtout << "-----" << Qt::endl;
@@ -73,6 +83,20 @@ int main(int argc, char *argv[])
         else if (s.startsWith("6e")) { CSamplesPerformance::samplesStringUtilsVsRegEx(qtout); }
         else if (s.startsWith("6f")) { CSamplesPerformance::samplesStringConcat(qtout); }
         else if (s.startsWith("6g")) { CSamplesPerformance::samplesStringLiteralVsConstQString(qtout); }
+        else if (s.startsWith("6h"))
+        {
+            qtout << "raw FSD message log file (empty for synthetic traffic):" << Qt::endl;
+            CSamplesPerformance::samplesFsdParsing(qtout, qtin.readLine().trimmed());
+        }
+        else if (s.startsWith("6i")) { CSamplesPerformance::samplesFsdPositionQueue(qtout); }
+        else if (s.startsWith("6j")) { CSamplesPerformance::samplesStoreSituations(qtout); }
+        else if (s.startsWith("6k")) { CSamplesPerformance::samplesCompactSituations(qtout); }
+        else if (s.startsWith("6l")) { CSamplesPerformance::samplesInterpolationBatch(qtout); }
+        else if (s.startsWith("6m")) { CSamplesPerformance::samplesModelCacheFormats(qtout); }
+        else if (s.startsWith("6n")) { CSamplesPerformance::samplesMatchingIndex(qtout); }
+        else if (s.startsWith("6o")) { CSamplesPerformance::samplesFuzzySearch(qtout); }
+        else if (s.startsWith("6p")) { CSamplesPerformance::samplesSharedTraffic(qtout); }
+        else if (s.startsWith("6q")) { CSamplesPerformance::samplesSpatialIndex(qtout); }
         else if (s.startsWith("7"))  { CSamplesAlgorithm::samples(); }
         else if (s.startsWith("8"))  { CSamplesFile::samples(qtout); }
         else if (s.startsWith("x"))  { break; }
@@ -14,6 +14,9 @@ INCLUDEPATH += . $$SourceRoot/src
 
 DESTDIR = $$DestRoot/bin
 
+# shm_open for the shared memory traffic sample
+unix:!macx: LIBS += -lrt
+
 HEADERS += *.h
 SOURCES += *.cpp
 
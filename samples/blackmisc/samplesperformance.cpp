@@ -11,9 +11,22 @@
 
 #include "samplesperformance.h"
 #include "blackcore/db/databasereader.h"
+#include "blackcore/fsd/fsdline.h"
+#include "blackcore/fsd/fsdpositionrecord.h"
+#include "blackcore/fsd/pilotdataupdate.h"
+#include "blackcore/fsd/visualpilotdataupdate.h"
+#include "blackcore/fsd/visualpilotdataperiodic.h"
+#include "blackmisc/simulation/data/modelbinaryfile.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/compactsituation.h"
 #include "blackmisc/simulation/distributorlist.h"
+#include "blackmisc/simulation/interpolationbatch.h"
+#include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/simulation/xplane/sharedtrafficqtfree.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
+#include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/altitude.h"
@@ -22,16 +35,24 @@
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/liverylist.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
+#include "blackmisc/geo/elevationtilecache.h"
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/test/testing.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/lockfree.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/trigramindex.h"
 
 #include <QDateTime>
+#include <QDir>
 #include <QHash>
+#include <QJsonDocument>
 #include <QList>
+#include <QRandomGenerator>
 #include <QRegExp>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
@@ -40,10 +61,20 @@
 #include <QStringBuilder>
 #include <QTextStream>
 #include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextCodec>
+#include <QThread>
 #include <QVector>
 #include <Qt>
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -52,8 +83,11 @@ using namespace BlackMisc::Math;
 using namespace BlackMisc::Network;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::Data;
+using namespace BlackMisc::Simulation::XPlane::SharedTraffic;
 using namespace BlackMisc::Test;
 using namespace BlackCore::Db;
+using namespace BlackCore::Fsd;
 
 namespace BlackSample
 {
@@ -668,6 +702,785 @@ namespace BlackSample
         return EXIT_SUCCESS;
     }
 
+    int CSamplesPerformance::samplesFsdParsing(QTextStream &out, const QString &captureFile)
+    {
+        const QList<QByteArray> lines = CSamplesPerformance::fsdTrafficLines(captureFile, 100000);
+        if (lines.isEmpty()) { out << "No FSD lines" << Qt::endl; return EXIT_FAILURE; }
+        out << "FSD lines: " << lines.size() << (captureFile.isEmpty() ? QStringLiteral(" (synthetic)") : QStringLiteral(" from ") + captureFile) << Qt::endl;
+
+        QTextCodec *codec = QTextCodec::codecForName("utf-8");
+        static const QStringList pdus({ "#AA", "#AP", "%", "$ZC", "$ZR", "$ID", "$CQ", "$CR", "#DA", "#DP", "$FP", "#PC", "$DI", "$!!", "@", "^",
+                                        "#SL", "#ST", "$SF", "$PI", "$PO", "$ER", "#DL", "#TM", "#SB", "$XX", "SIMDATA", "!R", "-MD", "-PD" });
+        int positions = 0;
+        QElapsedTimer timer;
+
+        // former way: decode, trim, scan the PDUs, split
+        timer.start();
+        for (const QByteArray &lineEncoded : lines)
+        {
+            const QString line = codec->toUnicode(lineEncoded).trimmed();
+            QString cmd;
+            for (const QString &pdu : pdus)
+            {
+                if (line.startsWith(pdu)) { cmd = pdu; break; }
+            }
+            if (cmd.isEmpty()) { continue; }
+            const QStringList tokens = line.mid(cmd.size()).trimmed().split(':');
+            if (cmd == QLatin1String("@"))        { positions += PilotDataUpdate::fromTokens(tokens).isValid() ? 1 : 0; }
+            else if (cmd == QLatin1String("^"))   { positions += VisualPilotDataUpdate::fromTokens(tokens).isValid() ? 1 : 0; }
+            else if (cmd == QLatin1String("#SL")) { positions += VisualPilotDataPeriodic::fromTokens(tokens).isValid() ? 1 : 0; }
+        }
+        const qint64 nsSplit = timer.nsecsElapsed();
+        out << "QString split: " << nsSplit / 1000000 << "ms " << (lines.size() * 1.0e9 / qMax<qint64>(1, nsSplit)) << " lines/s, positions " << positions << Qt::endl;
+
+        // tokenized line, only needed tokens are converted
+        positions = 0;
+        timer.start();
+        for (const QByteArray &lineEncoded : lines)
+        {
+            const FsdLine line(lineEncoded);
+            switch (line.messageType())
+            {
+            case MessageType::PilotDataUpdate:         positions += PilotDataUpdate::fromTokens(line).isValid() ? 1 : 0; break;
+            case MessageType::VisualPilotDataUpdate:   positions += VisualPilotDataUpdate::fromTokens(line).isValid() ? 1 : 0; break;
+            case MessageType::VisualPilotDataPeriodic: positions += VisualPilotDataPeriodic::fromTokens(line).isValid() ? 1 : 0; break;
+            case MessageType::Unknown: break;
+            default: line.toTokens(codec); break; // decoded like in CFSDClient
+            }
+        }
+        const qint64 nsLine = timer.nsecsElapsed();
+        out << "FsdLine:       " << nsLine / 1000000 << "ms " << (lines.size() * 1.0e9 / qMax<qint64>(1, nsLine)) << " lines/s, positions " << positions << Qt::endl;
+        out << "Speedup: " << (static_cast<double>(nsSplit) / qMax<qint64>(1, nsLine)) << Qt::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesFsdPositionQueue(QTextStream &out)
+    {
+        constexpr int Aircraft = 2000;
+        constexpr int Updates  = 100000;
+        QStringList callsigns;
+        for (int i = 0; i < Aircraft; ++i) { callsigns.push_back("CS" + QString::number(i)); }
+
+        const auto record = [&](int i)
+        {
+            FsdPositionRecord r;
+            r.setCallsign(callsigns.at(i % Aircraft));
+            r.latitudeDeg  = 48.0 + (i % 100) * 0.01;
+            r.longitudeDeg = 11.0 + (i % 100) * 0.01;
+            r.altitudeTrueFt = 5000;
+            r.groundSpeedKts = 250;
+            r.transponderCode = 2000;
+            r.msSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+            return r;
+        };
+
+        // signal like: situation built in producer thread, one queued call per update
+        QObject receiver;
+        int received = 0;
+        double latSum = 0;
+        QElapsedTimer timer;
+        timer.start();
+        QThread *producer = QThread::create([&]
+        {
+            for (int i = 0; i < Updates; ++i)
+            {
+                const FsdPositionRecord r = record(i);
+                const CAircraftSituation situation = r.toSituation();
+                const CTransponder transponder = r.toTransponder();
+                QMetaObject::invokeMethod(&receiver, [&, situation, transponder]
+                {
+                    latSum += situation.latitude().value();
+                    received += transponder.getTransponderCode() > 0 ? 1 : 0;
+                }, Qt::QueuedConnection);
+            }
+        });
+        producer->start();
+        while (received < Updates) { QCoreApplication::processEvents(); }
+        producer->wait();
+        delete producer;
+        const qint64 nsSignals = timer.nsecsElapsed();
+        out << "queued calls:   " << nsSignals / 1000000 << "ms " << (Updates * 1.0e9 / qMax<qint64>(1, nsSignals)) << " updates/s" << Qt::endl;
+
+        // queue: records in producer thread, situation built by consumer in batches
+        LockFreeSpscQueue<FsdPositionRecord> queue(8192);
+        std::vector<FsdPositionRecord> batch(512);
+        received = 0;
+        latSum = 0;
+        timer.start();
+        producer = QThread::create([&]
+        {
+            for (int i = 0; i < Updates; ++i)
+            {
+                const FsdPositionRecord r = record(i);
+                while (!queue.push(r)) { QThread::yieldCurrentThread(); }
+            }
+        });
+        producer->start();
+        while (received < Updates)
+        {
+            const size_t n = queue.popBatch(batch.data(), batch.size());
+            for (size_t i = 0; i < n; ++i)
+            {
+                const CAircraftSituation situation = batch[i].toSituation();
+                latSum += situation.latitude().value();
+                received += batch[i].toTransponder().getTransponderCode() > 0 ? 1 : 0;
+            }
+            if (n == 0) { QThread::yieldCurrentThread(); }
+        }
+        producer->wait();
+        delete producer;
+        const qint64 nsQueue = timer.nsecsElapsed();
+        out << "position queue: " << nsQueue / 1000000 << "ms " << (Updates * 1.0e9 / qMax<qint64>(1, nsQueue)) << " updates/s" << Qt::endl;
+        out << "Speedup: " << (static_cast<double>(nsSignals) / qMax<qint64>(1, nsQueue)) << " (lat. checksum " << latSum << ")" << Qt::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesStoreSituations(QTextStream &out, int numberOfAircraft, int updatesPerSecond, int seconds)
+    {
+        // one list per processing interval, like visual pilot updates collected between two ticks
+        const qint64 baseTime = QDateTime::currentMSecsSinceEpoch();
+        const qint64 intervalMs = 1000 / qMax(1, updatesPerSecond);
+        QList<CAircraftSituationList> ticks;
+        for (int t = 0; t < updatesPerSecond * seconds; ++t)
+        {
+            CAircraftSituationList tick;
+            for (int a = 0; a < numberOfAircraft; ++a)
+            {
+                const double d = a * 0.001 + t * 0.0001;
+                CAircraftSituation s(CCallsign("CS" + QString::number(a)), CCoordinateGeodetic(48.0 + d, 11.0 + d, 10000));
+                s.setMSecsSinceEpoch(baseTime + t * intervalMs);
+                s.setTimeOffsetMs(intervalMs);
+                tick.push_back(s);
+            }
+            ticks.push_back(tick);
+        }
+        const int total = numberOfAircraft * updatesPerSecond * seconds;
+        out << "Situations: " << total << " (" << numberOfAircraft << " aircraft, " << updatesPerSecond << "Hz, " << seconds << "s)" << Qt::endl;
+
+        QElapsedTimer timer;
+        CRemoteAircraftProviderDummy single;
+        timer.start();
+        for (const CAircraftSituationList &tick : std::as_const(ticks))
+        {
+            for (const CAircraftSituation &situation : tick) { single.insertNewSituation(situation); }
+        }
+        const qint64 nsSingle = timer.nsecsElapsed();
+        out << "storeAircraftSituation:  " << nsSingle / 1000000 << "ms " << (total * 1.0e9 / qMax<qint64>(1, nsSingle)) << " situations/s" << Qt::endl;
+
+        CRemoteAircraftProviderDummy batch;
+        timer.start();
+        for (const CAircraftSituationList &tick : std::as_const(ticks)) { batch.storeAircraftSituations(tick); }
+        const qint64 nsBatch = timer.nsecsElapsed();
+        out << "storeAircraftSituations: " << nsBatch / 1000000 << "ms " << (total * 1.0e9 / qMax<qint64>(1, nsBatch)) << " situations/s" << Qt::endl;
+        out << "Speedup: " << (static_cast<double>(nsSingle) / qMax<qint64>(1, nsBatch)) << " real time budget used: " << (nsBatch / 1.0e7 / seconds) << "%" << Qt::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesCompactSituations(QTextStream &out, int numberOfAircraft)
+    {
+        // full histories as kept by the provider, latest first
+        const int historySize = IRemoteAircraftProvider::MaxSituationsPerCallsign;
+        const qint64 baseTime = QDateTime::currentMSecsSinceEpoch();
+        const qint64 intervalMs = 5000;
+        QList<CAircraftSituationList> histories;
+        QList<CCompactSituations> compactHistories;
+        for (int a = 0; a < numberOfAircraft; ++a)
+        {
+            CAircraftSituationList history;
+            for (int t = historySize - 1; t >= 0; --t)
+            {
+                const double d = a * 0.001 + t * 0.0001;
+                CAircraftSituation s(CCallsign("CS" + QString::number(a)), CCoordinateGeodetic(48.0 + d, 11.0 + d, 10000));
+                s.setMSecsSinceEpoch(baseTime + t * intervalMs);
+                s.setTimeOffsetMs(intervalMs);
+                history.push_back(s);
+            }
+            CCompactSituations compact;
+            compact.setSituations(history);
+            histories.push_back(history);
+            compactHistories.push_back(compact);
+        }
+
+        const size_t bytesList = sizeof(CAircraftSituation) * static_cast<size_t>(historySize);
+        const size_t bytesCompact = compactHistories.front().memoryBytes();
+        out << "Aircraft: " << numberOfAircraft << " situations per aircraft: " << historySize << Qt::endl;
+        out << "History per aircraft: list " << bytesList << " bytes (without heap data), compact " << bytesCompact << " bytes" << Qt::endl;
+
+        // the lookups the linear and spline interpolators do per recalculation
+        const int steps = 100;
+        const qint64 stepMs = (historySize * intervalMs) / steps;
+        QElapsedTimer timer;
+        qint64 checksumList = 0;
+        timer.start();
+        for (int step = 0; step < steps; ++step)
+        {
+            const qint64 now = baseTime + step * stepMs;
+            for (const CAircraftSituationList &history : std::as_const(histories))
+            {
+                const auto pivot = std::partition_point(history.begin(), history.end(), [ = ](const CAircraftSituation &s) { return s.getAdjustedMSecsSinceEpoch() > now; });
+                const CAircraftSituation older = history.findObjectBeforeAdjustedOrDefault(now - intervalMs);
+                checksumList += (pivot - history.begin()) + older.getMSecsSinceEpoch();
+            }
+        }
+        const qint64 nsList = timer.nsecsElapsed();
+
+        qint64 checksumCompact = 0;
+        timer.start();
+        for (int step = 0; step < steps; ++step)
+        {
+            const qint64 now = baseTime + step * stepMs;
+            for (int a = 0; a < numberOfAircraft; ++a)
+            {
+                const CCompactSituations &compact = compactHistories[a];
+                const int pivot = compact.indexOfFirstNotNewerThanAdjusted(now);
+                const int olderIndex = compact.indexOfFirstBeforeAdjusted(now - intervalMs);
+                const qint64 olderMs = olderIndex < 0 ? CAircraftSituation().getMSecsSinceEpoch() : compact[olderIndex].msSinceEpoch;
+                checksumCompact += pivot + olderMs;
+            }
+        }
+        const qint64 nsCompact = timer.nsecsElapsed();
+
+        const int lookups = steps * numberOfAircraft;
+        out << "List lookups:    " << (nsList / lookups) << "ns/aircraft" << Qt::endl;
+        out << "Compact lookups: " << (nsCompact / lookups) << "ns/aircraft" << Qt::endl;
+        out << "Same results: " << boolToYesNo(checksumList == checksumCompact) << Qt::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesInterpolationBatch(QTextStream &out, int numberOfTracks)
+    {
+        // synthetic tracks, 3 samples each: oldest, older, latest
+        const qint64 baseTime = QDateTime::currentMSecsSinceEpoch();
+        const qint64 intervalMs = 5000;
+        QList<std::array<CAircraftSituation, 3>> tracks;
+        InterpolationBatch batch;
+        batch.resize(numberOfTracks);
+        for (int a = 0; a < numberOfTracks; ++a)
+        {
+            std::array<CAircraftSituation, 3> track;
+            for (int s = 0; s < 3; ++s)
+            {
+                const double d = a * 0.001 + s * 0.01;
+                CAircraftSituation situation(CCallsign("CS" + QString::number(a)), CCoordinateGeodetic(48.0 + d, 11.0 + d, 10000 + s * 50));
+                situation.setHeading(CHeading((a + s * 5) % 360, CHeading::True, CAngleUnit::deg()));
+                situation.setPitch(CAngle(s, CAngleUnit::deg()));
+                situation.setBank(CAngle(-s, CAngleUnit::deg()));
+                situation.setGroundSpeed(CSpeed(250 + s, CSpeedUnit::kts()));
+                situation.setMSecsSinceEpoch(baseTime + (s - 2) * intervalMs);
+                situation.setTimeOffsetMs(intervalMs);
+                track[static_cast<size_t>(s)] = situation;
+            }
+            batch.setAircraft(a, CompactSituation::fromSituation(track[0]), CompactSituation::fromSituation(track[1]), CompactSituation::fromSituation(track[2]));
+            tracks.push_back(track);
+        }
+
+        // one frame per 20ms between the samples 1 and 2
+        const int frames = 250;
+        const double frameMs = static_cast<double>(intervalMs) / frames;
+        const double t1 = static_cast<double>(tracks.front()[1].getAdjustedMSecsSinceEpoch());
+        out << "Tracks: " << numberOfTracks << " frames: " << frames << " SIMD: " << interpolationBatchInstructionSet() << Qt::endl;
+
+        // per aircraft with the value objects, as CInterpolatorLinear
+        QElapsedTimer timer;
+        double checksumObjects = 0;
+        timer.start();
+        for (int f = 0; f < frames; ++f)
+        {
+            const double tf = f / static_cast<double>(frames);
+            for (const std::array<CAircraftSituation, 3> &track : std::as_const(tracks))
+            {
+                const CInterpolatorLinear::CInterpolant interpolant(track[1], track[2], tf, track[1].getMSecsSinceEpoch());
+                const CAircraftSituation situation = interpolant.interpolatePositionAndAltitude(track[1], false);
+                checksumObjects += situation.getAltitude().value(CLengthUnit::m()) + interpolant.pbh().getHeading().value(CAngleUnit::deg());
+            }
+        }
+        const qint64 nsObjects = timer.nsecsElapsed();
+
+        // batch kernels
+        InterpolationBatchResult result;
+        const auto runBatch = [&](bool spline, bool vectorized, double &checksum)
+        {
+            checksum = 0;
+            timer.start();
+            for (int f = 0; f < frames; ++f)
+            {
+                batch.currentTimeMs = t1 + f * frameMs;
+                if (spline) { interpolateSplineBatch(batch, result, vectorized); }
+                else { interpolateLinearBatch(batch, result, vectorized); }
+                for (int a = 0; a < numberOfTracks; ++a) { checksum += result.altitude[static_cast<size_t>(a)] + result.headingDeg[static_cast<size_t>(a)]; }
+            }
+            return timer.nsecsElapsed();
+        };
+
+        double checksumLinearScalar = 0;
+        double checksumLinearSimd = 0;
+        double checksumSplineScalar = 0;
+        double checksumSplineSimd = 0;
+        const qint64 nsLinearScalar = runBatch(false, false, checksumLinearScalar);
+        const qint64 nsLinearSimd   = runBatch(false, true,  checksumLinearSimd);
+        const qint64 nsSplineScalar = runBatch(true,  false, checksumSplineScalar);
+        const qint64 nsSplineSimd   = runBatch(true,  true,  checksumSplineSimd);
+
+        const int interpolations = frames * numberOfTracks;
+        out << "Linear, per aircraft objects: " << (nsObjects / interpolations) << "ns/aircraft" << Qt::endl;
+        out << "Linear, batch scalar:         " << (nsLinearScalar / interpolations) << "ns/aircraft" << Qt::endl;
+        out << "Linear, batch SIMD:           " << (nsLinearSimd / interpolations) << "ns/aircraft" << Qt::endl;
+        out << "Spline, batch scalar:         " << (nsSplineScalar / interpolations) << "ns/aircraft" << Qt::endl;
+        out << "Spline, batch SIMD:           " << (nsSplineSimd / interpolations) << "ns/aircraft" << Qt::endl;
+        out << "Same results linear objects/batch: " << boolToYesNo(qAbs(checksumObjects - checksumLinearScalar) < 1e-3 * interpolations) << Qt::endl;
+        out << "Same results scalar/SIMD: " << boolToYesNo(checksumLinearScalar == checksumLinearSimd && checksumSplineScalar == checksumSplineSimd) << Qt::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesModelCacheFormats(QTextStream &out, int numberOfModels)
+    {
+        // resident set size in kB, only available on Linux
+        const auto residentKb = []
+        {
+#ifdef Q_OS_LINUX
+            QFile status("/proc/self/status");
+            if (!status.open(QIODevice::ReadOnly)) { return -1; }
+            for (const QByteArray &line : status.readAll().split('\n'))
+            {
+                if (line.startsWith("VmRSS:")) { return line.mid(6).trimmed().split(' ').first().toInt(); }
+            }
+#endif
+            return -1;
+        };
+        const auto rssDelta = [&](int before) { const int rss = residentKb(); return (rss < 0 || before < 0) ? QStringLiteral("n/a") : QString::number(rss - before) + "kB"; };
+
+        CAircraftModelList models = createModels(numberOfModels, 500);
+        for (CAircraftModel &model : models)
+        {
+            model.setFileName("C:/Simulator/SimObjects/Airplanes/" + model.getModelString() + "/aircraft.cfg");
+            model.setFileTimestamp(QDateTime::currentMSecsSinceEpoch());
+        }
+        const QString jsonFile = CFileUtils::appendFilePaths(QDir::tempPath(), "swiftsamplemodels.json");
+        const QString binFile = CFileUtils::appendFilePaths(QDir::tempPath(), "swiftsamplemodels.bin");
+        const QString zFile = CFileUtils::appendFilePaths(QDir::tempPath(), "swiftsamplemodels.binz");
+        const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+
+        QElapsedTimer timer;
+        timer.start();
+        CFileUtils::writeByteArrayToFile(QJsonDocument(models.toMemoizedJson()).toJson(QJsonDocument::Compact), jsonFile);
+        const qint64 msWriteJson = timer.restart();
+        CModelBinaryFile::writeFile(models, ts, binFile);
+        const qint64 msWriteBin = timer.restart();
+        CModelBinaryFile::writeFile(models, ts, zFile, true);
+        const qint64 msWriteZ = timer.elapsed();
+        models.clear();
+
+        out << numberOfModels << " models" << Qt::endl;
+        out << "Size JSON:            " << QFileInfo(jsonFile).size() / 1024 << "kB, written in " << msWriteJson << "ms" << Qt::endl;
+        out << "Size binary:          " << QFileInfo(binFile).size() / 1024 << "kB, written in " << msWriteBin << "ms" << Qt::endl;
+        out << "Size binary compr.:   " << QFileInfo(zFile).size() / 1024 << "kB, written in " << msWriteZ << "ms" << Qt::endl << Qt::endl;
+
+        {
+            const int rss = residentKb();
+            timer.start();
+            QFile file(jsonFile);
+            file.open(QIODevice::ReadOnly);
+            CAircraftModelList jsonModels;
+            jsonModels.convertFromMemoizedJson(QJsonDocument::fromJson(file.readAll()).object());
+            out << "Load JSON:            " << timer.elapsed() << "ms, " << jsonModels.size() << " models, RSS +" << rssDelta(rss) << Qt::endl;
+        }
+        {
+            const int rss = residentKb();
+            timer.start();
+            CModelBinaryFile binary;
+            binary.open(binFile);
+            const qint64 msOpen = timer.restart();
+            const QString last = binary.modelStringAt(binary.size() - 1);
+            out << "Open binary (mapped): " << msOpen << "ms, " << binary.size() << " models, last '" << last << "', RSS +" << rssDelta(rss) << Qt::endl;
+
+            timer.start();
+            const CAircraftModelList binaryModels = binary.toModelList();
+            out << "Materialize binary:   " << timer.elapsed() << "ms, " << binaryModels.size() << " models, RSS +" << rssDelta(rss) << Qt::endl;
+        }
+        {
+            const int rss = residentKb();
+            timer.start();
+            CModelBinaryFile binary;
+            binary.open(zFile);
+            const CAircraftModelList binaryModels = binary.toModelList();
+            out << "Load binary compr.:   " << timer.elapsed() << "ms, " << binaryModels.size() << " models, RSS +" << rssDelta(rss) << Qt::endl;
+        }
+
+        QFile::remove(jsonFile);
+        QFile::remove(binFile);
+        QFile::remove(zFile);
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesMatchingIndex(QTextStream &out, int numberOfModels, int numberOfMatchings)
+    {
+        const CAircraftModelList models = createModels(numberOfModels, 500);
+        QVector<CAircraftModel> remotes;
+        for (int i = 0; i < numberOfMatchings; ++i)
+        {
+            // unknown model string, so all reduction steps are needed
+            CAircraftModel remote = models[CMathUtils::randomInteger(0, numberOfModels - 1)];
+            remote.setModelString("unknown" + QString::number(i));
+            remotes.push_back(remote);
+        }
+
+        // same steps as the stepwise reduction of the aircraft matcher
+        const auto reduce = [](const auto &set, const CAircraftModel &remote)
+        {
+            auto matched = set;
+            if (set.findFirstByModelStringAliasOrDefault(remote.getModelString()).hasModelString()) { return 1; }
+            const auto byLivery = matched.findByAircraftDesignatorAndLiveryCombinedCode(remote.getAircraftIcaoCodeDesignator(), remote.getLivery().getCombinedCode());
+            if (!byLivery.isEmpty()) { return byLivery.sizeInt(); }
+            const auto byAirline = matched.findByIcaoDesignators(CAircraftIcaoCode::null(), remote.getAirlineIcaoCode());
+            if (!byAirline.isEmpty()) { matched = byAirline; }
+            const auto byAircraft = matched.findByIcaoDesignators(remote.getAircraftIcaoCode(), CAirlineIcaoCode::null());
+            if (!byAircraft.isEmpty()) { matched = byAircraft; }
+            const auto byMilitary = matched.findByMilitaryFlag(remote.isMilitary());
+            if (!byMilitary.isEmpty()) { matched = byMilitary; }
+            const auto byCombined = matched.findByCombinedType(remote.getAircraftIcaoCode().getCombinedType());
+            if (!byCombined.isEmpty()) { matched = byCombined; }
+            const auto byManufacturer = matched.findByManufacturer(remote.getAircraftIcaoCode().getManufacturer());
+            if (!byManufacturer.isEmpty()) { matched = byManufacturer; }
+            return matched.sizeInt();
+        };
+
+        QElapsedTimer timer;
+        timer.start();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(models));
+        const qint64 msIndex = timer.elapsed();
+
+        timer.start();
+        QVector<int> listResults;
+        for (const CAircraftModel &remote : remotes) { listResults.push_back(reduce(models, remote)); }
+        const qint64 msList = qMax<qint64>(1, timer.elapsed());
+
+        timer.start();
+        QVector<int> viewResults;
+        for (const CAircraftModel &remote : remotes) { viewResults.push_back(reduce(view, remote)); }
+        const qint64 msView = qMax<qint64>(1, timer.elapsed());
+
+        out << numberOfModels << " models, " << numberOfMatchings << " matchings" << Qt::endl;
+        out << "Build index:  " << msIndex << "ms" << Qt::endl;
+        out << "List:         " << msList << "ms, " << (numberOfMatchings * 1000 / msList) << " matches/sec" << Qt::endl;
+        out << "Indexed view: " << msView << "ms, " << (numberOfMatchings * 1000 / msView) << " matches/sec" << Qt::endl;
+        out << "Same results: " << boolToYesNo(listResults == viewResults) << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesFuzzySearch(QTextStream &out, int numberOfStrings, int numberOfSearches)
+    {
+        static const QStringList prefixes({ "FSX", "P3D", "XP", "AI", "MSFS" });
+        static const QStringList types({ "A320", "A321NEO", "B738", "B77W", "E190", "CRJ900", "DH8D", "C172" });
+        static const QStringList airlines({ "Lufthansa", "Air France", "Ryanair", "easyJet", "KLM", "Swiss", "Iberia", "Delta" });
+
+        QStringList strings;
+        CTrigramIndex index;
+        for (int i = 0; i < numberOfStrings; ++i)
+        {
+            const QString str = prefixes[i % prefixes.size()] % u' ' % types[(i / 5) % types.size()] % u' ' % airlines[(i / 40) % airlines.size()] % u' ' % QString::number(i);
+            strings.push_back(str);
+            index.insert(i, str);
+        }
+
+        QStringList fragments;
+        for (int i = 0; i < numberOfSearches; ++i)
+        {
+            fragments.push_back(types[i % types.size()] % u' ' % airlines[(i / 3) % airlines.size()].left(5) % (i % 2 ? QString() : QStringLiteral(" 1")));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QVector<QVector<int>> linearResults;
+        for (const QString &fragment : fragments)
+        {
+            QVector<int> ids;
+            for (int i = 0; i < strings.size(); ++i)
+            {
+                if (strings[i].contains(fragment, Qt::CaseInsensitive)) { ids.push_back(i); }
+            }
+            linearResults.push_back(ids);
+        }
+        const qint64 nsLinear = timer.nsecsElapsed();
+
+        timer.start();
+        QVector<QVector<int>> indexResults;
+        for (const QString &fragment : fragments) { indexResults.push_back(index.findContaining(fragment)); }
+        const qint64 nsIndex = timer.nsecsElapsed();
+
+        timer.start();
+        int fuzzyFound = 0;
+        for (const QString &fragment : fragments) { fuzzyFound += index.findFuzzy(fragment, 10).size(); }
+        const qint64 nsFuzzy = timer.nsecsElapsed();
+
+        out << numberOfStrings << " strings, " << numberOfSearches << " searches" << Qt::endl;
+        out << "Linear contains: " << (nsLinear / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Trigram index:   " << (nsIndex / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Fuzzy top 10:    " << (nsFuzzy / numberOfSearches / 1000) << "us/search, " << fuzzyFound << " found" << Qt::endl;
+        out << "Same results: " << boolToYesNo(linearResults == indexResults) << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesSharedTraffic(QTextStream &out, int numberOfPlanes, int numberOfFrames)
+    {
+        const CAircraftSituationList situations = createSituations(QDateTime::currentMSecsSinceEpoch(), numberOfPlanes, 1);
+        std::unordered_map<std::string, int> planesByCallsign; // like XSwiftBus
+        for (int i = 0; i < numberOfPlanes; ++i) { planesByCallsign[situations[i].getCallsign().asString().toStdString()] = i; }
+        std::vector<double> appliedLatitudes(static_cast<size_t>(numberOfPlanes), 0.0);
+
+        // DBus: parallel lists like PlanesPositions/PlanesSurfaces/PlanesTransponders, unpacked into std::vectors
+        // and looked up on the XSwiftBus side (socket transfer not included), planes keyed by callsign or handle
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < numberOfFrames; ++frame)
+        {
+            QStringList callsigns;
+            QList<double> values[6 + 10]; // positions and surfaces
+            QList<bool> flags[1 + 5 + 2]; // on ground, lights, transponder
+            QList<int> codes;
+            for (const CAircraftSituation &situation : situations)
+            {
+                callsigns.push_back(situation.getCallsign().asString());
+                values[0].push_back(situation.latitude().value(CAngleUnit::deg()) + frame);
+                values[1].push_back(situation.longitude().value(CAngleUnit::deg()));
+                values[2].push_back(situation.getAltitude().value(CLengthUnit::ft()));
+                values[3].push_back(situation.getPitch().value(CAngleUnit::deg()));
+                values[4].push_back(situation.getBank().value(CAngleUnit::deg()));
+                values[5].push_back(situation.getHeading().value(CAngleUnit::deg()));
+                for (int v = 6; v < 16; ++v) { values[v].push_back(0.5); }
+                for (QList<bool> &f : flags) { f.push_back(true); }
+                codes.push_back(7000);
+            }
+
+            // XSwiftBus side, 3 calls each with own callsigns
+            for (int call = 0; call < 3; ++call)
+            {
+                std::vector<std::string> receivedCallsigns;
+                receivedCallsigns.reserve(static_cast<size_t>(callsigns.size()));
+                for (const QString &cs : std::as_const(callsigns)) { receivedCallsigns.push_back(cs.toStdString()); }
+                std::vector<std::vector<double>> receivedValues;
+                for (const QList<double> &v : values) { receivedValues.emplace_back(v.cbegin(), v.cend()); }
+                for (size_t i = 0; i < receivedCallsigns.size(); ++i)
+                {
+                    const auto it = planesByCallsign.find(receivedCallsigns[i]);
+                    if (it != planesByCallsign.end()) { appliedLatitudes[static_cast<size_t>(it->second)] = receivedValues[0][i]; }
+                }
+            }
+        }
+        const qint64 nsDBus = timer.nsecsElapsed();
+
+        std::vector<int> planesBySlot(static_cast<size_t>(numberOfPlanes)); // like XSwiftBus, handle == slot here
+        for (int i = 0; i < numberOfPlanes; ++i) { planesBySlot[static_cast<size_t>(i)] = i; }
+        timer.start();
+        for (int frame = 0; frame < numberOfFrames; ++frame)
+        {
+            QList<int> handles;
+            QList<double> values[6 + 10];
+            QList<bool> flags[1 + 5 + 2];
+            QList<int> codes;
+            for (int i = 0; i < numberOfPlanes; ++i)
+            {
+                const CAircraftSituation &situation = situations[i];
+                handles.push_back(i);
+                values[0].push_back(situation.latitude().value(CAngleUnit::deg()) + frame);
+                values[1].push_back(situation.longitude().value(CAngleUnit::deg()));
+                values[2].push_back(situation.getAltitude().value(CLengthUnit::ft()));
+                values[3].push_back(situation.getPitch().value(CAngleUnit::deg()));
+                values[4].push_back(situation.getBank().value(CAngleUnit::deg()));
+                values[5].push_back(situation.getHeading().value(CAngleUnit::deg()));
+                for (int v = 6; v < 16; ++v) { values[v].push_back(0.5); }
+                for (QList<bool> &f : flags) { f.push_back(true); }
+                codes.push_back(7000);
+            }
+
+            for (int call = 0; call < 3; ++call)
+            {
+                const std::vector<int> receivedHandles(handles.cbegin(), handles.cend());
+                std::vector<std::vector<double>> receivedValues;
+                for (const QList<double> &v : values) { receivedValues.emplace_back(v.cbegin(), v.cend()); }
+                for (size_t i = 0; i < receivedHandles.size(); ++i)
+                {
+                    const size_t slot = static_cast<size_t>(receivedHandles[i]);
+                    if (slot < planesBySlot.size()) { appliedLatitudes[static_cast<size_t>(planesBySlot[slot])] = receivedValues[0][i]; }
+                }
+            }
+        }
+        const qint64 nsDBusHandles = timer.nsecsElapsed();
+
+        out << numberOfPlanes << " planes, " << numberOfFrames << " frames" << Qt::endl;
+        out << "DBus vectors, callsigns:  " << (nsDBus / numberOfFrames / 1000) << "us/frame (no socket)" << Qt::endl;
+        out << "DBus vectors, handles:    " << (nsDBusHandles / numberOfFrames / 1000) << "us/frame (no socket)" << Qt::endl;
+
+        CSharedTrafficRing writer;
+        CSharedTrafficRing reader;
+        const std::string name = QStringLiteral("/swift_sample_traffic_%1").arg(QCoreApplication::applicationPid()).toStdString();
+        if (!writer.create(name) || !reader.open(name))
+        {
+            out << "Shared memory not supported" << Qt::endl;
+            return EXIT_SUCCESS;
+        }
+
+        // shared memory: fixed records keyed by handle, written and read in the same thread
+        const auto writeFrame = [&](int frame)
+        {
+            PlaneRecord *records = writer.beginFrame();
+            for (int i = 0; i < numberOfPlanes; ++i)
+            {
+                const CAircraftSituation &situation = situations[i];
+                PlaneRecord &record = records[i];
+                std::memset(static_cast<void *>(&record), 0, sizeof(record));
+                record.handle = i;
+                record.latitudeDeg = situation.latitude().value(CAngleUnit::deg()) + frame;
+                record.longitudeDeg = situation.longitude().value(CAngleUnit::deg());
+                record.altitudeFt = situation.getAltitude().value(CLengthUnit::ft());
+                record.pitchDeg = static_cast<float>(situation.getPitch().value(CAngleUnit::deg()));
+                record.rollDeg = static_cast<float>(situation.getBank().value(CAngleUnit::deg()));
+                record.headingDeg = static_cast<float>(situation.getHeading().value(CAngleUnit::deg()));
+                record.transponderCode = 7000;
+                record.flags = HasPosition | HasSurfaces | HasTransponder;
+            }
+            writer.publishFrame(static_cast<std::uint32_t>(numberOfPlanes));
+        };
+        const auto applyRecord = [&](const PlaneRecord &record) { appliedLatitudes[static_cast<size_t>(record.handle)] = record.latitudeDeg; };
+
+        timer.start();
+        for (int frame = 0; frame < numberOfFrames; ++frame)
+        {
+            writeFrame(frame);
+            reader.readFrames(applyRecord);
+        }
+        const qint64 nsShared = timer.nsecsElapsed();
+        out << "Shared memory ring:       " << (nsShared / numberOfFrames / 1000) << "us/frame" << Qt::endl;
+
+        // latency between publishing and reading, reader polling in another thread like the X-Plane flight loop
+        std::atomic_bool stop { false };
+        qint64 latencySumNs = 0;
+        qint64 latencyMaxNs = 0;
+        int framesRead = 0;
+        std::thread readerThread([&]
+        {
+            while (!stop)
+            {
+                if (reader.readFrames(applyRecord) == CSharedTrafficRing::NoNewFrame) { std::this_thread::yield(); continue; }
+                const qint64 latencyNs = static_cast<qint64>(reader.getLastLatencyNs());
+                latencySumNs += latencyNs;
+                latencyMaxNs = std::max(latencyMaxNs, latencyNs);
+                framesRead++;
+            }
+        });
+        for (int frame = 0; frame < numberOfFrames; ++frame)
+        {
+            writeFrame(frame);
+            QThread::usleep(500);
+        }
+        stop = true;
+        readerThread.join();
+
+        out << "Shared memory latency:    " << (framesRead > 0 ? latencySumNs / framesRead / 1000 : 0) << "us avg, " << (latencyMaxNs / 1000) << "us max, "
+            << framesRead << "/" << numberOfFrames << " frames read" << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int CSamplesPerformance::samplesSpatialIndex(QTextStream &out, int numberOfAirports, int numberOfElevations, int numberOfSearches)
+    {
+        QRandomGenerator &random = CMathUtils::randomGenerator();
+        const auto randomPosition = [&](double latSpan, double lngSpan, double lat0 = 0, double lng0 = 0)
+        {
+            return CCoordinateGeodetic(lat0 + (random.generateDouble() - 0.5) * latSpan, lng0 + (random.generateDouble() - 0.5) * lngSpan);
+        };
+
+        CAirportList airports;
+        for (int i = 0; i < numberOfAirports; ++i)
+        {
+            airports.push_back(CAirport(CAirportIcaoCode(QString::number(i, 36).toUpper()), randomPosition(160, 360)));
+        }
+
+        // elevations are clustered around some airports, like the elevations probed for aircraft on ground
+        CCoordinateGeodeticList elevations;
+        for (int i = 0; i < numberOfElevations; ++i)
+        {
+            const CAirport &airport = airports[i % 50];
+            elevations.push_back(randomPosition(0.05, 0.05, airport.latitude().value(CAngleUnit::deg()), airport.longitude().value(CAngleUnit::deg())));
+        }
+
+        QVector<CCoordinateGeodetic> airportSearches;
+        QVector<CCoordinateGeodetic> elevationSearches;
+        for (int i = 0; i < numberOfSearches; ++i)
+        {
+            airportSearches.push_back(randomPosition(160, 360));
+            const CCoordinateGeodetic &elevation = elevations[CMathUtils::randomInteger(0, numberOfElevations - 1)];
+            elevationSearches.push_back(CCoordinateGeodetic(elevation.latitude().value(CAngleUnit::deg()) + 0.0003, elevation.longitude().value(CAngleUnit::deg())));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const CGeoSpatialIndex airportIndex = airports.createSpatialIndex();
+        const CGeoSpatialIndex elevationIndex = elevations.createSpatialIndex();
+        const qint64 nsBuild = timer.nsecsElapsed();
+
+        // the elevation cache of the simulation environment provider, which needs MSL heights
+        timer.start();
+        CElevationTileCache elevationCache;
+        for (const CCoordinateGeodetic &elevation : elevations)
+        {
+            elevationCache.insert(CCoordinateGeodetic(elevation.latitude().value(CAngleUnit::deg()), elevation.longitude().value(CAngleUnit::deg()), 100), true, 0);
+        }
+        const qint64 nsBuildCache = timer.nsecsElapsed();
+
+        const CLength airportRange(100, CLengthUnit::km());
+        const CLength elevationRange(50, CLengthUnit::m());
+        bool same = true;
+        qint64 nsClosestLinear = 0, nsClosestIndex = 0, nsRangeLinear = 0, nsRangeIndex = 0, nsElvLinear = 0, nsElvIndex = 0, nsElvCache = 0;
+        int elevationsFound = 0;
+        for (int i = 0; i < numberOfSearches; ++i)
+        {
+            timer.start();
+            const CAirportList closestLinear = airports.findClosest(20, airportSearches[i]);
+            nsClosestLinear += timer.nsecsElapsed();
+            timer.start();
+            const CAirportList closestIndex = airports.findClosest(airportIndex, 20, airportSearches[i]);
+            nsClosestIndex += timer.nsecsElapsed();
+
+            timer.start();
+            const CAirportList inRangeLinear = airports.findWithinRange(airportSearches[i], airportRange);
+            nsRangeLinear += timer.nsecsElapsed();
+            timer.start();
+            const CAirportList inRangeIndex = airports.findWithinRange(airportIndex, airportSearches[i], airportRange);
+            nsRangeIndex += timer.nsecsElapsed();
+
+            timer.start();
+            const CCoordinateGeodetic elvLinear = elevations.findClosestWithinRange(elevationSearches[i], elevationRange);
+            nsElvLinear += timer.nsecsElapsed();
+            timer.start();
+            const CCoordinateGeodetic elvIndex = elevations.findClosestWithinRange(elevationIndex, elevationSearches[i], elevationRange);
+            nsElvIndex += timer.nsecsElapsed();
+            timer.start();
+            const CCoordinateGeodetic elvCache = elevationCache.findClosestWithinRange(elevationSearches[i], elevationRange);
+            nsElvCache += timer.nsecsElapsed();
+
+            if (!elvIndex.isNull()) { elevationsFound++; }
+            same = same && closestLinear.sizeInt() == closestIndex.sizeInt() && inRangeLinear.sizeInt() == inRangeIndex.sizeInt() &&
+                   elvLinear.isNull() == elvIndex.isNull() && elvLinear.isNull() == elvCache.isNull();
+        }
+
+        out << numberOfAirports << " airports, " << numberOfElevations << " elevations, " << numberOfSearches << " searches" << Qt::endl;
+        out << "Build both indexes:              " << (nsBuild / 1000000) << "ms" << Qt::endl;
+        out << "Airports closest 20, linear:     " << (nsClosestLinear / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Airports closest 20, index:      " << (nsClosestIndex / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Airports within 100km, linear:   " << (nsRangeLinear / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Airports within 100km, index:    " << (nsRangeIndex / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Closest elevation 50m, linear:   " << (nsElvLinear / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Closest elevation 50m, index:    " << (nsElvIndex / numberOfSearches / 1000) << "us/search, " << elevationsFound << " found" << Qt::endl;
+        out << "Build elevation tile cache:      " << (nsBuildCache / 1000000) << "ms" << Qt::endl;
+        out << "Closest elevation 50m, cache:    " << (nsElvCache / numberOfSearches / 1000) << "us/search" << Qt::endl;
+        out << "Same result sizes: " << boolToYesNo(same) << Qt::endl;
+        return EXIT_SUCCESS;
+    }
+
     CAircraftSituationList CSamplesPerformance::createSituations(qint64 baseTimeEpoch, int numberOfCallsigns, int numberOfTimes)
     {
         CAircraftSituationList situations;
@@ -820,6 +1633,50 @@ namespace BlackSample
         return situations;
     }
 
+    QList<QByteArray> CSamplesPerformance::fsdTrafficLines(const QString &captureFile, int syntheticLines)
+    {
+        QList<QByteArray> lines;
+        if (!captureFile.isEmpty())
+        {
+            // raw FSD message log, "hh:mm:ss.zzz FSD Recv=>line", sent lines are ignored
+            QFile file(captureFile);
+            if (!file.open(QIODevice::ReadOnly)) { return lines; }
+            const QByteArray recv("FSD Recv=>");
+            while (!file.atEnd())
+            {
+                const QByteArray l = file.readLine();
+                const int i = l.indexOf(recv);
+                if (i < 0) { continue; }
+                lines.push_back(l.mid(i + recv.size()));
+            }
+            return lines;
+        }
+
+        // mix as seen on busy events, mostly visual and fast position updates
+        for (int i = 0; i < syntheticLines; ++i)
+        {
+            const QByteArray cs = "DLH" + QByteArray::number(i % 1000);
+            const double lat = 48.0 + (i % 997) * 0.001234567;
+            const double lng = 11.0 + (i % 991) * 0.001234567;
+            switch (i % 10)
+            {
+            case 0:
+                lines.push_back("@N:" + cs + ":7000:1:" + QByteArray::number(lat, 'f', 5) + ":" + QByteArray::number(lng, 'f', 5) + ":12000:125:25132146:8\r\n");
+                break;
+            case 1:
+                lines.push_back("#SL" + cs + ":" + QByteArray::number(lat, 'f', 7) + ":" + QByteArray::number(lng, 'f', 7) + ":12000.12:1404.00:25132144:-1.0001:2.0001:3.0001:-0.0349:0.0175:0.0524:0.00\r\n");
+                break;
+            case 2:
+                lines.push_back("$CQ" + cs + ":@94836:ACC:{\"config\":{\"lights\":{\"strobe_on\":true}}}\r\n");
+                break;
+            default:
+                lines.push_back("^" + cs + ":" + QByteArray::number(lat, 'f', 7) + ":" + QByteArray::number(lng, 'f', 7) + ":12000.12:1404.00:25132144:-1.0001:2.0001:3.0001:-0.0349:0.0175:0.0524:0.00\r\n");
+                break;
+            }
+        }
+        return lines;
+    }
+
     const CAtcStationList &CSamplesPerformance::stations10k()
     {
         static const CAtcStationList s = CTesting::createAtcStations(10000, false);
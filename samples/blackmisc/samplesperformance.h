@@ -53,6 +53,37 @@ namespace BlackSample
         //! Callsign based hash/map comparison
         static int sampleQMapVsQHashByCallsign(QTextStream &out);
 
+        //! FSD line parsing, QString split vs. FsdLine tokenizer
+        //! \remark uses a raw FSD message log (rawfsdmessages.log) if provided, otherwise synthetic traffic
+        static int samplesFsdParsing(QTextStream &out, const QString &captureFile = {});
+
+        //! Positions from the FSD thread to a consumer thread, queued calls vs. lock-free position queue
+        static int samplesFsdPositionQueue(QTextStream &out);
+
+        //! Storing situations in the remote aircraft provider, one by one vs. batch
+        static int samplesStoreSituations(QTextStream &out, int numberOfAircraft = 2000, int updatesPerSecond = 5, int seconds = 10);
+
+        //! Interpolator situation lookups, CAircraftSituationList vs. CCompactSituations
+        static int samplesCompactSituations(QTextStream &out, int numberOfAircraft = 1000);
+
+        //! Interpolation of synthetic tracks, per aircraft objects vs. batch kernels scalar/SIMD
+        static int samplesInterpolationBatch(QTextStream &out, int numberOfTracks = 1000);
+
+        //! Loading a model cache file, memoized JSON vs. binary (mapped and compressed)
+        static int samplesModelCacheFormats(QTextStream &out, int numberOfModels = 40000);
+
+        //! Reduction steps of the model matching, model list finders vs. indexed model set view
+        static int samplesMatchingIndex(QTextStream &out, int numberOfModels = 30000, int numberOfMatchings = 2000);
+
+        //! Substring and fuzzy search in model strings, linear vs. trigram index
+        static int samplesFuzzySearch(QTextStream &out, int numberOfStrings = 40000, int numberOfSearches = 1000);
+
+        //! Per frame traffic transport to XSwiftBus, DBus vectors vs. shared memory ring
+        static int samplesSharedTraffic(QTextStream &out, int numberOfPlanes = 500, int numberOfFrames = 1000);
+
+        //! Airport and elevation lookups, linear vs. spatial index and elevation tile cache
+        static int samplesSpatialIndex(QTextStream &out, int numberOfAirports = 50000, int numberOfElevations = 10000, int numberOfSearches = 1000);
+
     private:
         static const qint64 DeltaTime = 10;
 
@@ -100,6 +131,9 @@ namespace BlackSample
 
         //! Situations hash
         static QHash<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CAircraftSituation> situationsHash(const BlackMisc::Aviation::CCallsignSet &callsigns);
+
+        //! Received FSD lines from a raw FSD message log, or synthetic lines if no file is given
+        static QList<QByteArray> fsdTrafficLines(const QString &captureFile, int syntheticLines);
     };
 } // namespace
 
@@ -15,6 +15,7 @@
 #include "blackmisc/simulation/ownaircraftproviderdummy.h"
 #include "blackmisc/simulation/remoteaircraftproviderdummy.h"
 #include <QCoreApplication>
+#include <QDebug>
 #include <QThread>
 
 using namespace BlackMisc::Network;
@@ -41,6 +42,21 @@ int main(int argc, char *argv[])
     client.setServer(server);
     client.setSimType(CSimulatorInfo::xplane());
     client.setPilotRating(PilotRating::Student);
+
+    // replay a capture written with startFsdCapture, e.g. "samplefsd capture.fsd 0" for max. speed
+    if (argc > 1)
+    {
+        const double speed = argc > 2 ? QString(argv[2]).toDouble() : 1.0;
+        QObject::connect(&client, &CFSDClient::fsdCaptureReplayFinished, &qa, [&](int lines, qint64 elapsedMs, qint64 maxLagMs)
+        {
+            qInfo() << "Replayed" << lines << "lines in" << elapsedMs << "ms, max. lag" << maxLagMs << "ms";
+            qa.quit();
+        });
+        client.replayFsdCapture(QString(argv[1]), speed);
+        if (!client.isReplayingFsdCapture()) { return 1; }
+        return qa.exec();
+    }
+
     client.printToConsole(true);
 
     /*client.sendFsdMessage("$CRLOWW_F_APP:LHA449:ATIS:V:voice.vacc.ch/loww_f_app\r\n");
@@ -8,6 +8,7 @@
 
 #include "blackcore/aircraftmatcher.h"
 #include "blackcore/application.h"
+#include "blackcore/matchingcache.h"
 #include "blackcore/webdataservices.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
 #include "blackmisc/simulation/matchingscript.h"
@@ -21,14 +22,25 @@
 #include "blackmisc/logmessage.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/swiftdirectories.h"
+#include "blackmisc/threadutils.h"
+#include "blackmisc/trigramindex.h"
 #include "blackmisc/directoryutils.h"
 
 #include <QList>
+#include <QVector>
 #include <QStringList>
 #include <QtGlobal>
 #include <QPair>
 #include <QStringBuilder>
 #include <QJSEngine>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QThreadStorage>
+#include <memory>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -37,6 +49,193 @@ using namespace BlackMisc::Simulation;
 
 namespace BlackCore
 {
+    namespace
+    {
+        //! Matching scripts compiled in one thread, a JS engine can only be used in the thread which created it
+        class CMatchingScriptContext
+        {
+        public:
+            //! Compiled script with its engine
+            struct Compiled
+            {
+                QString js;                                   //!< source
+                std::unique_ptr<MSWebServices> webServices;   //!< web services wrapper
+                std::unique_ptr<QJSEngine> engine;            //!< engine owning the function
+                QJSValue function;                            //!< the evaluated script, an error if it can not be evaluated
+            };
+
+            //! Script source, only read again if the file has changed
+            const QString &source(const QString &fileName)
+            {
+                Source &source = m_sources[fileName];
+                const QFileInfo fi(fileName);
+                const QDateTime lastModified = fi.lastModified();
+                const qint64 size = fi.size();
+                if (!source.read || source.lastModified != lastModified || source.size != size)
+                {
+                    source.js = CFileUtils::readFileToString(fileName);
+                    source.lastModified = lastModified;
+                    source.size = size;
+                    source.read = true;
+                }
+                return source.js;
+            }
+
+            //! Compiled script, compiled again if the source has changed
+            Compiled &compiled(MatchingScript script, const QString &js, const QString &fileName)
+            {
+                Compiled &compiled = m_compiled[script];
+                if (compiled.engine && compiled.js == js) { return compiled; }
+
+                compiled.function = QJSValue();
+                compiled.engine.reset(new QJSEngine());
+                compiled.webServices.reset(new MSWebServices());
+                QJSEngine::setObjectOwnership(compiled.webServices.get(), QJSEngine::CppOwnership);
+                compiled.engine->globalObject().setProperty("webServices", compiled.engine->newQObject(compiled.webServices.get()));
+                compiled.function = compiled.engine->evaluate(js, fileName);
+                compiled.js = js;
+                return compiled;
+            }
+
+            //! Context of the current thread, deleted when the thread finishes
+            static CMatchingScriptContext &forCurrentThread()
+            {
+                QThreadStorage<CMatchingScriptContext *> &storage = contexts();
+                if (!storage.hasLocalData())
+                {
+                    storage.setLocalData(new CMatchingScriptContext());
+
+                    // the main thread finishes after the application, but the engine has to be deleted before
+                    if (CThreadUtils::thisIsMainThread()) { qAddPostRoutine(&CMatchingScriptContext::deleteForCurrentThread); }
+                }
+                return *storage.localData();
+            }
+
+            //! Delete the context of the current thread
+            static void deleteForCurrentThread()
+            {
+                contexts().setLocalData(nullptr);
+            }
+
+        private:
+            //! Contexts of all threads
+            static QThreadStorage<CMatchingScriptContext *> &contexts()
+            {
+                // never destroyed, a destroyed storage would no longer delete the contexts of finishing threads
+                static QThreadStorage<CMatchingScriptContext *> *contexts = new QThreadStorage<CMatchingScriptContext *>();
+                return *contexts;
+            }
+
+            //! Script file content
+            struct Source
+            {
+                QString js;             //!< content
+                QDateTime lastModified; //!< file timestamp
+                qint64 size = -1;       //!< file size
+                bool read = false;      //!< read at least once
+            };
+
+            QHash<QString, Source> m_sources;     //!< by file name
+            QHash<int, Compiled> m_compiled;      //!< by MatchingScript
+        };
+
+        //! Run times of the matching scripts by MatchingScript
+        //! \threadsafe
+        class CMatchingScriptRunTimes
+        {
+        public:
+            //! Add a run
+            void add(MatchingScript script, qint64 runNs)
+            {
+                QMutexLocker l(&m_mutex);
+                CAircraftMatcher::ScriptRunTimes &times = m_times[script];
+                times.count++;
+                times.totalNs += runNs;
+                times.maxNs = qMax(times.maxNs, runNs);
+            }
+
+            //! Run times of a script
+            CAircraftMatcher::ScriptRunTimes get(MatchingScript script) const
+            {
+                QMutexLocker l(&m_mutex);
+                return m_times.value(script);
+            }
+
+            //! Shared by all threads
+            static CMatchingScriptRunTimes &instance()
+            {
+                static CMatchingScriptRunTimes runTimes;
+                return runTimes;
+            }
+
+        private:
+            mutable QMutex m_mutex;                              //!< guards m_times
+            QHash<int, CAircraftMatcher::ScriptRunTimes> m_times; //!< by MatchingScript
+        };
+
+        //! Airline names or telephony designators from the DB with their trigram index
+        struct DbStrings
+        {
+            QStringList strings;   //!< as in the DB
+            CTrigramIndex index;   //!< ids are the positions in strings
+        };
+
+        //! Min. score to use a similar DB string for a string not found in the DB
+        constexpr double MinSimilarDbStringScore = 0.7;
+
+        //! Shared DB strings, only indexed again if the DB data have changed
+        //! \threadsafe
+        QSharedPointer<const DbStrings> airlineDbStrings(bool telephony)
+        {
+            static QMutex mutex;
+            static QSharedPointer<const DbStrings> cached[2];
+            static QString revisions[2];
+
+            const QString revision = CMatchingCache::dbRevision();
+            QMutexLocker l(&mutex);
+            if (!cached[telephony] || revisions[telephony] != revision)
+            {
+                QSharedPointer<DbStrings> dbStrings = QSharedPointer<DbStrings>::create();
+                dbStrings->strings = telephony ? sApp->getWebDataServices()->getTelephonyDesignators() : sApp->getWebDataServices()->getAirlineNames();
+                for (int i = 0; i < dbStrings->strings.size(); ++i) { dbStrings->index.insert(i, dbStrings->strings[i]); }
+                cached[telephony] = dbStrings;
+                revisions[telephony] = revision;
+            }
+            return cached[telephony];
+        }
+
+        //! Equal (case insensitive) or with useSimilar most similar DB string, empty if none
+        QString lookupDbString(const QString &candidate, bool telephony, bool useSimilar, bool &similar)
+        {
+            const QSharedPointer<const DbStrings> dbStrings = airlineDbStrings(telephony);
+            const int id = dbStrings->index.findEqualOrMostSimilar(candidate, useSimilar, MinSimilarDbStringScore, &similar);
+            if (id < 0) { return {}; }
+            if (!similar) { return candidate; }
+
+            const QString &dbString = dbStrings->strings[id];
+            CLogMessage(static_cast<CAircraftMatcher *>(nullptr)).info(u"%1 '%2' not in DB, using similar '%3'") << (telephony ? u"Telephony designator" : u"Airline name") << candidate << dbString;
+            return dbString;
+        }
+
+        //! Shared index of a model set, only indexed again if the set has changed
+        //! \threadsafe
+        QSharedPointer<const CAircraftModelSetIndex> modelSetIndex(const CAircraftModelList &models)
+        {
+            static QMutex mutex;
+            static QSharedPointer<const CAircraftModelSetIndex> cached;
+            static QString cachedRevision;
+
+            const QString revision = CMatchingCache::modelSetRevision(models);
+            QMutexLocker l(&mutex);
+            if (!cached || cachedRevision != revision)
+            {
+                cached = QSharedPointer<const CAircraftModelSetIndex>::create(models);
+                cachedRevision = revision;
+            }
+            return cached;
+        }
+    }
+
     const QStringList &CAircraftMatcher::getLogCategories()
     {
         static const QStringList cats { CLogCategories::matching() };
@@ -51,6 +250,8 @@ namespace BlackCore
             const CAircraftCategoryList categories = sApp->getWebDataServices()->getAircraftCategories();
             m_categoryMatcher.setCategories(categories);
         }
+        this->updateMatchingRevision();
+        m_matchingThreads.setExpiryTimeout(-1);
     }
 
     CAircraftMatcher::CAircraftMatcher(QObject *parent) : CAircraftMatcher(CAircraftMatcherSetup(), parent)
@@ -65,6 +266,7 @@ namespace BlackCore
     {
         if (m_setup == setup) { return false; }
         m_setup = setup;
+        this->updateMatchingRevision();
         emit this->setupChanged();
         return true;
     }
@@ -141,6 +343,7 @@ namespace BlackCore
         }
 
         static const QString info("Multiple models (%1) with airline ICAOs for '%2'");
+        const CAircraftModelSetView set(modelSetIndex(models));
         CAirlineIcaoCode code;
 
         do
@@ -148,8 +351,8 @@ namespace BlackCore
             bool reduced = false;
             if (!primaryIcao.isEmpty())
             {
-                CAircraftModelList modelsWithAirline = models.findByIcaoDesignators({}, primaryIcao);
-                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.countPerAirlineIcao();
+                CAircraftModelSetView modelsWithAirline = set.findByIcaoDesignators({}, primaryIcao);
+                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.toModelList().countPerAirlineIcao();
                 if (countPerAirline.size() == 1)
                 {
                     code = countPerAirline.firstKey();
@@ -163,7 +366,7 @@ namespace BlackCore
                     {
                         modelsWithAirline = CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(callsign, airlineName, airlineTelephony, modelsWithAirline, info.arg(modelsWithAirline.size()).arg(primaryIcao), reduced, log);
                     }
-                    code = modelsWithAirline.getAirlineWithMaxCount();
+                    code = modelsWithAirline.toModelList().getAirlineWithMaxCount();
                     CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Using primary airline ICAO '%1' found '%2'").arg(primaryIcao, code.getDesignatorDbKey()), getLogCategories());
                     break;
                 }
@@ -171,8 +374,8 @@ namespace BlackCore
 
             if (!secondaryIcao.isEmpty())
             {
-                CAircraftModelList modelsWithAirline = models.findByIcaoDesignators({}, secondaryIcao);
-                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.countPerAirlineIcao();
+                CAircraftModelSetView modelsWithAirline = set.findByIcaoDesignators({}, secondaryIcao);
+                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.toModelList().countPerAirlineIcao();
                 if (countPerAirline.size() == 1)
                 {
                     code = countPerAirline.firstKey();
@@ -186,7 +389,7 @@ namespace BlackCore
                     {
                         modelsWithAirline = CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(callsign, airlineName, airlineTelephony, modelsWithAirline, info.arg(modelsWithAirline.size()).arg(secondaryIcao), reduced, log);
                     }
-                    code = modelsWithAirline.getAirlineWithMaxCount();
+                    code = modelsWithAirline.toModelList().getAirlineWithMaxCount();
                     CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Using secondary airline ICAO '%1' found '%2'").arg(primaryIcao, code.getDesignatorDbKey()), getLogCategories());
                     break;
                 }
@@ -202,8 +405,8 @@ namespace BlackCore
                     break;
                 }
 
-                CAircraftModelList modelsWithAirline = models.findByIcaoDesignators({}, airlinePrefix);
-                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.countPerAirlineIcao();
+                CAircraftModelSetView modelsWithAirline = set.findByIcaoDesignators({}, airlinePrefix);
+                const QMap<CAirlineIcaoCode, int> countPerAirline = modelsWithAirline.toModelList().countPerAirlineIcao();
                 if (countPerAirline.size() == 1)
                 {
                     code = countPerAirline.firstKey();
@@ -216,7 +419,7 @@ namespace BlackCore
                     {
                         modelsWithAirline = CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(callsign, airlineName, airlineTelephony, modelsWithAirline, info.arg(modelsWithAirline.size()).arg(airlinePrefix), reduced, log);
                     }
-                    code = modelsWithAirline.getAirlineWithMaxCount();
+                    code = modelsWithAirline.toModelList().getAirlineWithMaxCount();
                     CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Using callsign airline ICAO '%1' found '%2'").arg(airlinePrefix, code.getDesignatorDbKey()), getLogCategories());
                     break;
                 }
@@ -252,7 +455,7 @@ namespace BlackCore
 
     CAircraftModel CAircraftMatcher::getClosestMatch(const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript) const
     {
-        CAircraftModelList modelSet(m_modelSet); // Models for this matching
+        CAircraftModelSetView modelSet(m_modelSetIndex); // Models for this matching
         const CAircraftMatcherSetup setup = m_setup;
 
         static const QString format("hh:mm:ss.zzz");
@@ -277,7 +480,7 @@ namespace BlackCore
 
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m1.arg(startTime.toString(format)));
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m2.arg(remoteAircraft.getCallsignAsString(), removeSurroundingApostrophes(remoteAircraft.getModel().toQString())));
-        CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(modelSet.size()).arg(modelSet.coverageSummaryForModel(remoteAircraft.getModel())));
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m3.arg(modelSet.size()).arg(m_modelSet.coverageSummaryForModel(remoteAircraft.getModel()))); }
         CMatchingUtils::addLogDetailsToList(log, remoteAircraft, m4.arg(setup.toQString(true)));
 
         // Before I really search I check some special conditions
@@ -285,10 +488,21 @@ namespace BlackCore
         // 2) No model set at all
         // 3) Exact match by model string
 
-        // Manually set string?
+        // Same network identity matched before with the same model set and setup?
+        // random picks and manually set models are not cached, the matching script always runs
         CAircraftModel matchedModel;
+        const bool cacheable = setup.getPickStrategy() != CAircraftMatcherSetup::PickRandom && !remoteAircraft.getModel().hasManuallySetString();
+        const QString cacheKey = cacheable ? CMatchingCache::cacheKey(remoteAircraft.getModel(), m_matchingRevision % u'_' % CMatchingCache::dbRevision()) : QString();
+        const bool resolvedFromCache = cacheable && CMatchingCache::instance().lookup(CMatchingCache::ModelMatching, cacheKey, matchedModel);
+
+        // Manually set string?
         bool resolvedInPrephase = false;
-        if (remoteAircraft.getModel().hasManuallySetString())
+        if (resolvedFromCache)
+        {
+            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Cached match '" % matchedModel.getModelStringAndDbKey() % "'", getLogCategories());
+            resolvedInPrephase = true;
+        }
+        else if (remoteAircraft.getModel().hasManuallySetString())
         {
             // the user did a manual mapping "by hand", so he really should know what he is doing
             // no matching
@@ -351,14 +565,14 @@ namespace BlackCore
             switch (setup.getMatchingAlgorithm())
             {
             case CAircraftMatcherSetup::MatchingStepwiseReduce:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log).toModelList();
                 break;
             case CAircraftMatcherSetup::MatchingScoreBased:
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setup, remoteAircraft, maxScore, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet.toModelList(), setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
             default:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log).toModelList();
                 candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             }
@@ -393,6 +607,8 @@ namespace BlackCore
             }
         }
 
+        if (cacheable && !resolvedFromCache) { CMatchingCache::instance().insert(CMatchingCache::ModelMatching, cacheKey, matchedModel); }
+
         // copy over callsign validate
         matchedModel.setCallsign(remoteAircraft.getCallsign());
         matchedModel.setModelType(CAircraftModel::TypeModelMatching);
@@ -402,7 +618,7 @@ namespace BlackCore
         if (useMatchingScript && setup.doRunMsMatchingStageScript())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Matching script: Matching stage script used"));
-            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, modelSet, log);
+            const MatchingScriptReturnValues rv = CAircraftMatcher::matchingStageScript(remoteAircraft.getModel(), matchedModel, setup, modelSet.toModelList(), log);
             CAircraftModel matchedModelMs = matchedModel;
 
             if (rv.runScriptAndModified())
@@ -503,11 +719,31 @@ namespace BlackCore
         return model;
     }
 
+    CAircraftModelList CAircraftMatcher::getClosestMatches(const CSimulatedAircraftList &remoteAircraft, MatchingLog whatToLog, QHash<CCallsign, CStatusMessageList> *logs, bool useMatchingScript) const
+    {
+        const int count = remoteAircraft.sizeInt();
+        QVector<CAircraftModel> models(count);
+        QVector<CStatusMessageList> matchingLogs(logs ? count : 0);
+
+        // each task only writes its own slot, the model set index is shared read only
+        // the threads are kept, so are their compiled matching scripts
+        CThreadUtils::forEachIndex(count, count > 1, [&](int i)
+        {
+            models[i] = this->getClosestMatch(remoteAircraft[i], whatToLog, logs ? &matchingLogs[i] : nullptr, useMatchingScript);
+        }, &m_matchingThreads);
+
+        if (logs)
+        {
+            for (int i = 0; i < count; ++i) { logs->insert(remoteAircraft[i].getCallsign(), matchingLogs[i]); }
+        }
+        return CAircraftModelList(CSequence<CAircraftModel>(std::move(models)));
+    }
+
     MatchingScriptReturnValues CAircraftMatcher::reverseLookupScript(const CAircraftModel &inModel, const CAircraftMatcherSetup &setup, const CAircraftModelList &modelSet, CStatusMessageList *log)
     {
         if (!setup.doRunMsReverseLookupScript()) { return MatchingScriptReturnValues(inModel); }
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsReverseLookupFile());
+        const QString js = CMatchingScriptContext::forCurrentThread().source(setup.getMsReverseLookupFile());
         const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, inModel, setup, modelSet, ReverseLookup, log);
         return rv;
     }
@@ -516,11 +752,16 @@ namespace BlackCore
     {
         if (!setup.doRunMsMatchingStageScript()) { return MatchingScriptReturnValues(inModel); }
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsMatchingStageFile());
+        const QString js = CMatchingScriptContext::forCurrentThread().source(setup.getMsMatchingStageFile());
         const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, matchedModel, setup, modelSet, MatchingStage, log);
         return rv;
     }
 
+    CAircraftMatcher::ScriptRunTimes CAircraftMatcher::getMatchingScriptRunTimes(MatchingScript ms)
+    {
+        return CMatchingScriptRunTimes::instance().get(ms);
+    }
+
     MatchingScriptReturnValues CAircraftMatcher::matchingScript(const QString &js, const CAircraftModel &inModel, const CAircraftModel &matchedModel, const CAircraftMatcherSetup &setup, const CAircraftModelList &modelSet, MatchingScript script, CStatusMessageList *log)
     {
         MatchingScriptReturnValues rv(inModel);
@@ -546,7 +787,9 @@ namespace BlackCore
                 CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script models: %1").arg(modelSet.coverageSummary()));
             }
 
-            QJSEngine engine;
+            // engine and evaluated script are kept per thread, only the objects are set for every run
+            CMatchingScriptContext::Compiled &compiled = CMatchingScriptContext::forCurrentThread().compiled(script, js, msReverse ? logFileR : logFileM);
+            QJSEngine &engine = *compiled.engine;
             // engine.installExtensions(QJSEngine::ConsoleExtension);
 
             // Meta objects to create new JS objects, here causing JSValue can't be reassigned to another engine.
@@ -564,7 +807,12 @@ namespace BlackCore
             MSInOutValues outObject(matchedModel);     // set default values for out object
             MSModelSet modelSetObject(modelSet);       // as passed
             modelSetObject.initByAircraftAndAirline(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
-            MSWebServices webServices; // web services encapsulated
+
+            // objects live on the stack, the engine must never delete them
+            QJSEngine::setObjectOwnership(&inObject, QJSEngine::CppOwnership);
+            QJSEngine::setObjectOwnership(&matchedObject, QJSEngine::CppOwnership);
+            QJSEngine::setObjectOwnership(&outObject, QJSEngine::CppOwnership);
+            QJSEngine::setObjectOwnership(&modelSetObject, QJSEngine::CppOwnership);
 
             // object as from network
             const QJSValue jsInObject = engine.newQObject(&inObject);
@@ -582,12 +830,27 @@ namespace BlackCore
             const QJSValue jsModelSetObject = engine.newQObject(&modelSetObject);
             engine.globalObject().setProperty("modelSet", jsModelSetObject);
 
-            // wrapper for web services
-            const QJSValue jsWebServices = engine.newQObject(&webServices);
-            engine.globalObject().setProperty("webServices", jsWebServices);
+            // wrapper for web services is set when compiled
+            QElapsedTimer runTime;
+            runTime.start();
+            QJSValue ms = compiled.function.isCallable() ? compiled.function.call() : compiled.function;
+            const qint64 runNs = runTime.nsecsElapsed();
+            CMatchingScriptRunTimes::instance().add(script, runNs);
+            if (log)
+            {
+                const ScriptRunTimes times = CMatchingScriptRunTimes::instance().get(script);
+                const QString msg = QStringLiteral("Matching script run time: %1ms (runs: %2, average: %3ms, max: %4ms)")
+                                    .arg(static_cast<double>(runNs) / 1.0e6, 0, 'f', 3).arg(times.count)
+                                    .arg(times.averageMs(), 0, 'f', 3).arg(times.maxMs(), 0, 'f', 3);
+                CCallsign::addLogDetailsToList(log, callsign, msg);
+            }
+
+            // no references to the stack objects beyond this run
+            for (const QString &name : { QStringLiteral("inObject"), QStringLiteral("outObject"), QStringLiteral("matchedObject"), QStringLiteral("modelSet") })
+            {
+                engine.globalObject().setProperty(name, QJSValue());
+            }
 
-            QJSValue ms = engine.evaluate(js, msReverse ? logFileR : logFileM);
-            ms = ms.call();
             if (ms.isError())
             {
                 const QString msg = QStringLiteral("Matching script error: %1 '%2'").arg(ms.property("lineNumber").toInt()).arg(ms.toString());
@@ -1144,30 +1407,34 @@ namespace BlackCore
         return found;
     }
 
-    QString CAircraftMatcher::reverseLookupAirlineName(const QString &candidate, const CCallsign &callsign, CStatusMessageList *log)
+    QString CAircraftMatcher::reverseLookupAirlineName(const QString &candidate, const CCallsign &callsign, bool useSimilar, CStatusMessageList *log)
     {
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return {}; }
         if (candidate.isEmpty()) { return {}; }
-        const QStringList names = sApp->getWebDataServices()->getAirlineNames();
-        if (names.contains(candidate, Qt::CaseInsensitive))
+        bool similar = false;
+        const QString name = lookupDbString(candidate, false, useSimilar, similar);
+        if (!name.isEmpty())
         {
-            CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' found in DB").arg(candidate));
-            return candidate;
+            if (similar) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' not found, using similar DB name '%2'").arg(candidate, name)); }
+            else         { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' found in DB").arg(candidate)); }
+            return name;
         }
 
         CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' not found in DB").arg(candidate));
         return {};
     }
 
-    QString CAircraftMatcher::reverseLookupTelephonyDesignator(const QString &candidate, const CCallsign &callsign, CStatusMessageList *log)
+    QString CAircraftMatcher::reverseLookupTelephonyDesignator(const QString &candidate, const CCallsign &callsign, bool useSimilar, CStatusMessageList *log)
     {
         if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return {}; }
         if (candidate.isEmpty()) { return {}; }
-        const QStringList designators = sApp->getWebDataServices()->getTelephonyDesignators();
-        if (designators.contains(candidate, Qt::CaseInsensitive))
+        bool similar = false;
+        const QString designator = lookupDbString(candidate, true, useSimilar, similar);
+        if (!designator.isEmpty())
         {
-            CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' found").arg(candidate));
-            return candidate;
+            if (similar) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Telephony designator '%1' not found, using similar DB designator '%2'").arg(candidate, designator)); }
+            else         { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' found").arg(candidate)); }
+            return designator;
         }
 
         CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Airline name '%1' not found").arg(candidate));
@@ -1293,6 +1560,7 @@ namespace BlackCore
         // set values
         m_modelSet  = modelsCleaned;
         m_simulator = simulator;
+        this->updateModelSetIndex();
         m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(modelsCleaned.size());
         return models.size();
     }
@@ -1303,24 +1571,65 @@ namespace BlackCore
         {
             m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
             m_disabledModels.push_back(removedModels);
+            this->updateModelSetIndex();
         }
         else
         {
             this->restoreDisabledModels();
             m_disabledModels = removedModels;
             m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
+            this->updateModelSetIndex();
         }
     }
 
     void CAircraftMatcher::restoreDisabledModels()
     {
         m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+        this->updateModelSetIndex();
+    }
+
+    void CAircraftMatcher::updateModelSetIndex()
+    {
+        // built once per model set change, shared by all matchings
+        m_modelSetIndex = QSharedPointer<const CAircraftModelSetIndex>::create(m_modelSet);
+        this->updateMatchingRevision();
+    }
+
+    void CAircraftMatcher::updateMatchingRevision()
+    {
+        // results cached for an older revision are simply not found anymore
+        m_matchingRevision = CMatchingCache::modelSetRevision(m_modelSet) % u'_' %
+                             QString::number(qHash(m_setup.toQString(true))) % u'_' %
+                             m_defaultModel.getModelString();
     }
 
     void CAircraftMatcher::setDefaultModel(const CAircraftModel &defaultModel)
     {
         m_defaultModel = defaultModel;
         m_defaultModel.setModelType(CAircraftModel::TypeModelMatchingDefaultModel);
+        this->updateMatchingRevision();
+    }
+
+    CMatchingStatistics CAircraftMatcher::getCurrentStatistics() const
+    {
+        CMatchingStatistics statistics(m_statistics);
+        const CMatchingCache &cache = CMatchingCache::instance();
+        for (CMatchingCache::CacheType type : { CMatchingCache::ReverseLookup, CMatchingCache::ModelMatching })
+        {
+            const int hits = cache.getHits(type);
+            const int misses = cache.getMisses(type);
+            if (hits + misses < 1) { continue; }
+            const QString description = u"Cache " % CMatchingCache::cacheTypeToString(type);
+            statistics.setCacheCount(CMatchingStatisticsEntry::CacheHit,  {}, m_modelSetInfo, description, hits);
+            statistics.setCacheCount(CMatchingStatisticsEntry::CacheMiss, {}, m_modelSetInfo, description, misses);
+        }
+        return statistics;
+    }
+
+    void CAircraftMatcher::clearMatchingStatistics()
+    {
+        m_statistics.clear();
+        CMatchingCache::instance().resetCounters();
     }
 
     void CAircraftMatcher::evaluateStatisticsEntry(const QString &sessionId, const CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
@@ -1391,9 +1700,9 @@ namespace BlackCore
         return CFileUtils::writeStringToFile(json, CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), QStringLiteral("removed models %1.json").arg(ts)));
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelSetView &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
     {
-        CAircraftModelList matchedModels(modelSet);
+        CAircraftModelSetView matchedModels(modelSet);
         CAircraftModel matchedModel(remoteAircraft.getModel());
         Q_UNUSED(whatToLog)
 
@@ -1438,7 +1747,7 @@ namespace BlackCore
 
             if (setup.useCategoryMatching())
             {
-                matchedModels = categoryMatcher.reduceByCategories(matchedModels, modelSet, setup, remoteAircraft, reduced, whatToLog, log);
+                matchedModels = modelSet.withModels(categoryMatcher.reduceByCategories(matchedModels.toModelList(), modelSet.toModelList(), setup, remoteAircraft, reduced, whatToLog, log));
                 // ?? break here ??
             }
             else if (reduceLog)
@@ -1510,7 +1819,7 @@ namespace BlackCore
         return maxScoreAircraft;
     }
 
-    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelList &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::getCombinedTypeDefaultModel(const CAircraftModelSetView &modelSet, const CSimulatedAircraft &remoteAircraft, const CAircraftModel &defaultModel, MatchingLog whatToLog, CStatusMessageList *log)
     {
         const QString combinedType = remoteAircraft.getAircraftIcaoCombinedType();
         CStatusMessageList *combinedLog = log && whatToLog.testFlag(MatchingLogCombinedDefaultType) ? log : nullptr;
@@ -1527,7 +1836,7 @@ namespace BlackCore
         }
 
         CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Searching by combined type with color livery '" % combinedType % "'", getLogCategories());
-        CAircraftModelList matchedModels = modelSet.findByCombinedTypeWithColorLivery(combinedType);
+        CAircraftModelSetView matchedModels = modelSet.findByCombinedTypeWithColorLivery(combinedType);
         if (!matchedModels.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(combinedLog, remoteAircraft, u"Found " % QString::number(matchedModels.size()) % u" by combined type w/color livery '" % combinedType % "'", getLogCategories());
@@ -1547,7 +1856,7 @@ namespace BlackCore
         return matchedModels.front();
     }
 
-    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &models, MatchingLog whatToLog, CStatusMessageList *log)
+    CAircraftModel CAircraftMatcher::matchByExactModelString(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &models, MatchingLog whatToLog, CStatusMessageList *log)
     {
         CStatusMessageList *msLog = log && whatToLog.testFlag(MatchingLogModelstring) ? log : nullptr;
         if (remoteAircraft.getModelString().isEmpty())
@@ -1573,7 +1882,7 @@ namespace BlackCore
         return model;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getLivery().hasCombinedCode())
@@ -1582,7 +1891,7 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList byLivery(
+        const CAircraftModelSetView byLivery(
             inList.findByAircraftDesignatorAndLiveryCombinedCode(
                 remoteAircraft.getLivery().getCombinedCode(),
                 remoteAircraft.getAircraftIcaoCodeDesignator()
@@ -1597,7 +1906,7 @@ namespace BlackCore
         return byLivery;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
         if (inList.isEmpty())
@@ -1611,7 +1920,7 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
+            CAircraftModelSetView models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
             models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
             reduced = r1 || r2;
             if (reduced) { return models; }
@@ -1620,7 +1929,7 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
+            CAircraftModelSetView models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
             models = ifPossibleReduceByAirline(remoteAircraft, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
 
             // not finding anything so far means we have no valid aircraft/airline ICAO combination
@@ -1635,7 +1944,7 @@ namespace BlackCore
 
                 bool r3 = false;
                 QString usedFamily;
-                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
+                CAircraftModelSetView models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
                 models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setup, "Reduce family by airline second.", r3, log);
                 if (r3)
                 {
@@ -1657,13 +1966,13 @@ namespace BlackCore
         return inList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetView &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
     {
         reduced = false;
         usedFamily = remoteAircraft.getAircraftIcaoCode().getFamily();
         if (!usedFamily.isEmpty())
         {
-            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
+            CAircraftModelSetView matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
             if (reduced) { return matchedModels; }
         }
 
@@ -1672,7 +1981,7 @@ namespace BlackCore
         return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("ICAO treated as family"), reduced, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelSetView &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
     {
         // Use an algorithm to find the best match
         reduced = false;
@@ -1688,7 +1997,7 @@ namespace BlackCore
             return inList;
         }
 
-        CAircraftModelList foundByFamily(inList.findByFamily(family));
+        CAircraftModelSetView foundByFamily(inList.findByFamily(family));
         if (foundByFamily.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by family '" % family % u"' (" % hint % ")"); }
@@ -1700,7 +2009,7 @@ namespace BlackCore
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
         }
 
-        CAircraftModelList foundByCM;
+        CAircraftModelSetView foundByCM;
         if (allowPseudoFamily)
         {
             foundByCM = inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
@@ -1719,14 +2028,13 @@ namespace BlackCore
         reduced = true;
 
         // avoid dpulicates, then add
-        if (!foundByFamily.isEmpty()) { foundByCM.removeModelsWithString(foundByFamily.getModelStringList(), Qt::CaseInsensitive); }
-        foundByFamily.push_back(foundByCM);
+        foundByFamily = foundByFamily.unite(foundByCM);
 
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
         return foundByFamily;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1742,7 +2050,7 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByManufacturer(m));
+        const CAircraftModelSetView outList(inList.findByManufacturer(m));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Not found '" % m % u"', cannot reduce", getLogCategories()); }
@@ -1782,7 +2090,7 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1797,7 +2105,7 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+        const CAircraftModelSetView outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
@@ -1809,16 +2117,16 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetView &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
+        const CAircraftModelSetView outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
         if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outList; }
         QString family;
         return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, reduced, family, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1834,21 +2142,21 @@ namespace BlackCore
         }
 
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        CAircraftModelList outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
+        CAircraftModelSetView outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
         if (
             mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupSameAsAirline) ||
             (outList.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
         {
             if (remoteAircraft.getAirlineIcaoCode().hasGroupMembership())
             {
-                const CAircraftModelList groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
-                outList.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
+                const CAircraftModelSetView groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
+                outList = outList.replacedOrAdded(groupModels);
                 if (log)
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft,
                                                         groupModels.isEmpty() ?
                                                         QStringLiteral("No group models found by using airline group '%1'").arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator()) :
-                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.sizeInt()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(groupModels.getAirlineVDesignators(), ", ")),
+                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.sizeInt()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(groupModels.toModelList().getAirlineVDesignators(), ", ")),
                                                         getLogCategories());
                 }
             } // group membership
@@ -1865,7 +2173,7 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(const CCallsign &cs, const QString &airlineName, const QString &telephony, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceModelsByAirlineNameTelephonyDesignator(const CCallsign &cs, const QString &airlineName, const QString &telephony, const CAircraftModelSetView &inList, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1880,7 +2188,7 @@ namespace BlackCore
             return inList;
         }
 
-        CAircraftModelList step1Data = inList.findByAirlineNamesOrTelephonyDesignator(airlineName);
+        CAircraftModelSetView step1Data = inList.findByAirlineNamesOrTelephonyDesignator(airlineName);
         if (step1Data.isEmpty() || step1Data.size() == inList.size())
         {
             if (log) { CCallsign::addLogDetailsToList(log, cs, info % QStringLiteral(" cannot reduce by '%1'").arg(airlineName), getLogCategories()); }
@@ -1893,7 +2201,7 @@ namespace BlackCore
         }
         if (step1Data.size() == 1) { return step1Data; }
 
-        CAircraftModelList step2Data = inList.findByAirlineNamesOrTelephonyDesignator(telephony);
+        CAircraftModelSetView step2Data = inList.findByAirlineNamesOrTelephonyDesignator(telephony);
         if (step2Data.isEmpty() || step2Data.size() == inList.size())
         {
             if (log) { CCallsign::addLogDetailsToList(log, cs, info % QStringLiteral(" cannot reduce by '%1'").arg(telephony), getLogCategories()); }
@@ -1907,7 +2215,7 @@ namespace BlackCore
         return step2Data;
 
         /** alternative implementation using different finder
-        const CAircraftModelList reducedModels = inList.findByAirlineNameAndTelephonyDesignator(airlineName, telephony);
+        const CAircraftModelList reducedModels = inList.toModelList().findByAirlineNameAndTelephonyDesignator(airlineName, telephony);
         if (reducedModels.size() < 1 || reducedModels.size() == inList.size())
         {
             if (log) { CCallsign::addLogDetailsToList(log, cs, info % QStringLiteral(" cannot reduce by '%1'/'%2'").arg(airlineName, telephony), getLogCategories()); }
@@ -1915,11 +2223,11 @@ namespace BlackCore
         }
 
         reduced = true;
-        return reducedModels;
+        return inList.withModels(reducedModels);
         **/
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getAircraftIcaoCode().hasValidCombinedType())
@@ -1929,7 +2237,7 @@ namespace BlackCore
         }
 
         const QString cc = remoteAircraft.getAircraftIcaoCode().getCombinedType();
-        CAircraftModelList modelsByCombinedCode(inList.findByCombinedType(cc));
+        CAircraftModelSetView modelsByCombinedCode(inList.findByCombinedType(cc));
         if (modelsByCombinedCode.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by combined code " % cc, getLogCategories()); }
@@ -1946,11 +2254,11 @@ namespace BlackCore
         return modelsByCombinedCode;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         const bool military = remoteAircraft.getModel().isMilitary();
-        const CAircraftModelList byMilitaryFlag(inList.findByMilitaryFlag(military));
+        const CAircraftModelSetView byMilitaryFlag(inList.findByMilitaryFlag(military));
         const QString mil(military ? "military" : "civilian");
         if (byMilitaryFlag.isEmpty())
         {
@@ -1962,7 +2270,7 @@ namespace BlackCore
         return byMilitaryFlag;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    CAircraftModelSetView CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetView &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!inList.containsVtol())
@@ -1970,7 +2278,7 @@ namespace BlackCore
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, "Cannot reduce to VTOL aircraft", getLogCategories());
             return inList;
         }
-        CAircraftModelList vtolModels = inList.findByVtolFlag(true);
+        CAircraftModelSetView vtolModels = inList.findByVtolFlag(true);
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % QString::number(vtolModels.size()) % u" VTOL aircraft", getLogCategories()); }
         return vtolModels;
     }
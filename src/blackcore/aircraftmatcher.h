@@ -16,19 +16,24 @@
 #include "blackmisc/simulation/aircraftmodelsetprovider.h"
 #include "blackmisc/simulation/aircraftmatchersetup.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
 #include "blackmisc/simulation/matchingscriptmisc.h"
 #include "blackmisc/simulation/matchingstatistics.h"
 #include "blackmisc/simulation/matchinglog.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/simulation/categorymatcher.h"
 #include "blackmisc/statusmessage.h"
 #include "blackmisc/valueobject.h"
 #include "blackmisc/variant.h"
 
 #include <QFlags>
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QPair>
 #include <QSet>
+#include <QSharedPointer>
+#include <QThreadPool>
 
 namespace BlackMisc
 {
@@ -86,6 +91,17 @@ namespace BlackCore
             BlackMisc::CStatusMessageList *log,
             bool useMatchingScript) const;
 
+        //! Get the closest matching aircraft models for many aircraft, e.g. all aircraft in range after connecting.
+        //! The aircraft are matched in parallel against the current model set.
+        //! \remark models in the order of the aircraft, logs per callsign if logs is not null
+        //! \remark returns when all aircraft are matched, the matcher must not be changed meanwhile
+        //! \sa getClosestMatch
+        BlackMisc::Simulation::CAircraftModelList getClosestMatches(
+            const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft,
+            BlackMisc::Simulation::MatchingLog whatToLog,
+            QHash<BlackMisc::Aviation::CCallsign, BlackMisc::CStatusMessageList> *logs,
+            bool useMatchingScript) const;
+
         //! Return an valid airline ICAO code
         //! \threadsafe
         static BlackMisc::Aviation::CAirlineIcaoCode failoverValidAirlineIcaoDesignator(
@@ -94,7 +110,7 @@ namespace BlackCore
             bool airlineFromCallsign, const QString &airlineName, const QString &airlineTelephony, bool useWebServices, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Return an valid airline ICAO code from a given model list
-        //! \remarks model list could be the model set
+        //! \remarks model list could be the model set, its index is kept until another list is used
         //! \threadsafe
         static BlackMisc::Aviation::CAirlineIcaoCode failoverValidAirlineIcaoDesignator(
             const BlackMisc::Aviation::CCallsign &callsign,
@@ -123,6 +139,24 @@ namespace BlackCore
         //! \threadsafe
         static BlackMisc::Simulation::MatchingScriptReturnValues matchingStageScript(const BlackMisc::Simulation::CAircraftModel &inModel, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const BlackMisc::Simulation::CAircraftModelList &modelSet, BlackMisc::CStatusMessageList *log);
 
+        //! Run times of a matching script
+        struct ScriptRunTimes
+        {
+            int count = 0;      //!< number of runs
+            qint64 totalNs = 0; //!< sum of the run times
+            qint64 maxNs = 0;   //!< longest run
+
+            //! Average run time in ms, 0 without runs
+            double averageMs() const { return count > 0 ? static_cast<double>(totalNs) / count / 1.0e6 : 0.0; }
+
+            //! Longest run time in ms
+            double maxMs() const { return static_cast<double>(maxNs) / 1.0e6; }
+        };
+
+        //! Run times of the given matching script, all threads and matchers since start
+        //! \threadsafe
+        static ScriptRunTimes getMatchingScriptRunTimes(BlackMisc::Simulation::MatchingScript ms);
+
         //! Run the matching script
         //! \threadsafe
         static BlackMisc::Simulation::MatchingScriptReturnValues matchingScript(const QString &js,
@@ -224,16 +258,18 @@ namespace BlackCore
         static int reverseLookupByIds(const BlackMisc::Simulation::DBTripleIds &ids, BlackMisc::Aviation::CAircraftIcaoCode &aircraftIcao, BlackMisc::Aviation::CLivery &livery, const BlackMisc::Aviation::CCallsign &logCallsign, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Lookup of airline name
+        //! \remark with useSimilar a similar DB name is used if there is no equal one
         //! \threadsafe
         //! \ingroup reverselookup
         static QString reverseLookupAirlineName(
-            const QString &candidate, const BlackMisc::Aviation::CCallsign &callsign = {}, BlackMisc::CStatusMessageList *log = nullptr);
+            const QString &candidate, const BlackMisc::Aviation::CCallsign &callsign = {}, bool useSimilar = false, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Lookup of telephony designator
+        //! \remark with useSimilar a similar DB designator is used if there is no equal one
         //! \threadsafe
         //! \ingroup reverselookup
         static QString reverseLookupTelephonyDesignator(
-            const QString &candidate, const BlackMisc::Aviation::CCallsign &callsign = {},
+            const QString &candidate, const BlackMisc::Aviation::CCallsign &callsign = {}, bool useSimilar = false,
             BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Is this aircraft designator known?
@@ -293,11 +329,11 @@ namespace BlackCore
         //! Set default model, can be set by driver specific for simulator
         void setDefaultModel(const BlackMisc::Simulation::CAircraftModel &defaultModel);
 
-        //! The current statistics
-        const BlackMisc::Simulation::CMatchingStatistics &getCurrentStatistics() const { return m_statistics; }
+        //! The current statistics, including the hits and misses of the CMatchingCache
+        BlackMisc::Simulation::CMatchingStatistics getCurrentStatistics() const;
 
         //! Clear the statistics
-        void clearMatchingStatistics() { m_statistics.clear(); }
+        void clearMatchingStatistics();
 
         //! Evaluate if a statistics entry makes sense and add it
         void evaluateStatisticsEntry(const QString &sessionId, const BlackMisc::Aviation::CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
@@ -313,9 +349,15 @@ namespace BlackCore
         //! Save the disabled models if any
         bool saveDisabledForMatchingModels();
 
+        //! Rebuild the indexes after the model set has changed
+        void updateModelSetIndex();
+
+        //! Revision of the data used for matching, part of the CMatchingCache keys
+        void updateMatchingRevision();
+
         //! The search based implementation
-        static BlackMisc::Simulation::CAircraftModelList getClosestMatchStepwiseReduceImplementation(
-            const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+        static BlackMisc::Simulation::CAircraftModelSetView getClosestMatchStepwiseReduceImplementation(
+            const BlackMisc::Simulation::CAircraftModelSetView &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
             const BlackMisc::Simulation::CCategoryMatcher &categoryMatcher, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
             BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
@@ -325,32 +367,32 @@ namespace BlackCore
         //! Get combined type default model, i.e. get a default model under consideration of the combined code such as "L2J"
         //! \see BlackMisc::Simulation::CSimulatedAircraft::getAircraftIcaoCombinedType
         //! \remark in any case a (default) model is returned
-        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
+        static BlackMisc::Simulation::CAircraftModel getCombinedTypeDefaultModel(const BlackMisc::Simulation::CAircraftModelSetView &modelSet, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &defaultModel, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
         //! Search in models by key (aka model string)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModel matchByExactModelString(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &models, BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log);
 
         //! Installed models by ICAO data
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetView &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \remark pseudo family searches for same combined type and manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetView &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Search for exact livery and aircraft ICAO code
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
@@ -358,31 +400,31 @@ namespace BlackCore
 
         //! Reduce by aircraft ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by aircraft ICAO or family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetView &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline name/telephone designator
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceModelsByAirlineNameTelephonyDesignator(const BlackMisc::Aviation::CCallsign &cs, const QString &airlineName, const QString &telephony, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceModelsByAirlineNameTelephonyDesignator(const BlackMisc::Aviation::CCallsign &cs, const QString &airlineName, const QString &telephony, const BlackMisc::Simulation::CAircraftModelSetView &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Installed models by combined code (ie L2J, L1P, ...)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By military flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By VTOL flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetView ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetView &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Scores to string for debugging
         //! \threadsafe
@@ -402,11 +444,14 @@ namespace BlackCore
         BlackMisc::Simulation::CAircraftMatcherSetup m_setup;           //!< setup
         BlackMisc::Simulation::CAircraftModel        m_defaultModel;    //!< model to be used as default model
         BlackMisc::Simulation::CAircraftModelList    m_modelSet;        //!< models used for model matching
+        QSharedPointer<const BlackMisc::Simulation::CAircraftModelSetIndex> m_modelSetIndex; //!< indexes of m_modelSet
         BlackMisc::Simulation::CAircraftModelList    m_disabledModels;  //!< disabled models for matching
         BlackMisc::Simulation::CSimulatorInfo        m_simulator;       //!< simulator (optional)
         BlackMisc::Simulation::CMatchingStatistics   m_statistics;      //!< matching statistics
         BlackMisc::Simulation::CCategoryMatcher      m_categoryMatcher; //!< the category matcher
         QString                                      m_modelSetInfo;    //!< info string
+        QString                                      m_matchingRevision; //!< model set, setup and default model revision for the cache
+        mutable QThreadPool                          m_matchingThreads; //!< parallel matching, threads never expire as they keep their compiled scripts
     };
 } // namespace
 
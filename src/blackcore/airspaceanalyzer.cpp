@@ -10,7 +10,6 @@
 #include "blackcore/airspacemonitor.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/callsign.h"
-#include "blackmisc/aviation/transponder.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/statusmessage.h"
@@ -58,9 +57,7 @@ namespace BlackCore
         c = connect(fsdClient, &CFSDClient::connectionStatusChanged, this, &CAirspaceAnalyzer::onConnectionStatusChanged, Qt::QueuedConnection);
         Q_ASSERT(c);
 
-        // network situations
-        c = connect(fsdClient, &CFSDClient::pilotDataUpdateReceived, this, &CAirspaceAnalyzer::onNetworkPositionUpdate, Qt::QueuedConnection);
-        Q_ASSERT(c);
+        // network situations, aircraft are touched by CAirspaceMonitor::addedAircraftSituation
         c = connect(fsdClient, &CFSDClient::atcDataUpdateReceived, this, &CAirspaceAnalyzer::watchdogTouchAtcCallsign, Qt::QueuedConnection);
         Q_ASSERT(c);
 
@@ -97,12 +94,6 @@ namespace BlackCore
     CAirspaceAnalyzer::~CAirspaceAnalyzer()
     { }
 
-    void CAirspaceAnalyzer::onNetworkPositionUpdate(const CAircraftSituation &situation, const CTransponder &transponder)
-    {
-        Q_UNUSED(transponder)
-        this->watchdogTouchAircraftCallsign(situation);
-    }
-
     void CAirspaceAnalyzer::onChangedAtcStationOnlineConnectionStatus(const CAtcStation &station, bool isConnected)
     {
         const CCallsign cs = station.getCallsign();
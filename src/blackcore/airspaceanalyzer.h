@@ -36,7 +36,6 @@ namespace BlackMisc::Aviation
 {
     class CAircraftSituation;
     class CCallsign;
-    class CTransponder;
 }
 
 namespace BlackCore
@@ -110,9 +109,6 @@ namespace BlackCore
         //! Connection status of network changed
         void onConnectionStatusChanged(BlackMisc::Network::CConnectionStatus oldStatus, BlackMisc::Network::CConnectionStatus newStatus);
 
-        //! Network position update
-        void onNetworkPositionUpdate(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CTransponder &transponder);
-
         //! ATC stations online
         void onChangedAtcStationOnlineConnectionStatus(const BlackMisc::Aviation::CAtcStation &station, bool isConnected);
 
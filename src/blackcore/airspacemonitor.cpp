@@ -11,6 +11,7 @@
 #include "blackcore/vatsim/vatsimdatafilereader.h"
 #include "blackcore/airspaceanalyzer.h"
 #include "blackcore/aircraftmatcher.h"
+#include "blackcore/matchingcache.h"
 #include "blackcore/application.h"
 #include "blackcore/webdataservices.h"
 #include "blackcore/context/contextnetwork.h"
@@ -42,12 +43,16 @@
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QEventLoop>
+#include <QHash>
 #include <QReadLocker>
+#include <QStringBuilder>
 #include <QThread>
 #include <QTime>
 #include <QVariant>
 #include <QWriteLocker>
 #include <Qt>
+#include <utility>
+#include <vector>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -96,6 +101,9 @@ namespace BlackCore
         connect(m_fsdClient, &CFSDClient::connectionStatusChanged,         this, &CAirspaceMonitor::onConnectionStatusChanged);
         connect(m_fsdClient, &CFSDClient::revbAircraftConfigReceived,      this, &CAirspaceMonitor::onRevBAircraftConfigReceived);
 
+        // positions via signals, with ".fsd posqueue on" drained in batches by fastProcessing
+        m_positionBatch.resize(PositionBatchSize);
+
         // AutoConnection: this should also avoid race conditions by updating the bookings
         Q_ASSERT_X(sApp && sApp->hasWebDataServices(), Q_FUNC_INFO, "Missing data reader");
 
@@ -108,7 +116,9 @@ namespace BlackCore
 
         if (this->supportsVatsimDataFile())
         {
-            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::dataFileRead, this, &CAirspaceMonitor::onReceivedVatsimDataFile);
+            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::flightPlanRemarksChanged, this, &CAirspaceMonitor::onReceivedVatsimDataFile);
+            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::pilotsChanged,            this, &CAirspaceMonitor::onVatsimDataFilePilotsChanged);
+            connect(sApp->getWebDataServices()->getVatsimDataFileReader(), &CVatsimDataFileReader::controllersChanged,       this, &CAirspaceMonitor::onVatsimDataFileControllersChanged);
         }
 
         // Force snapshot in the main event loop
@@ -414,12 +424,33 @@ namespace BlackCore
                 const CLength d = CLength::parsedFromString(r);
                 this->setMaxRange(d);
             }
+            else if (parser.matchesPart(1, "capture") && parser.countParts() > 2 && m_fsdClient)
+            {
+                if (parser.matchesPart(2, "stop")) { m_fsdClient->stopFsdCapture(); }
+                else { m_fsdClient->startFsdCapture(parser.part(2)); }
+                return true;
+            }
+            else if (parser.matchesPart(1, "replay") && parser.countParts() > 2 && m_fsdClient)
+            {
+                if (parser.matchesPart(2, "stop")) { m_fsdClient->stopFsdCaptureReplay(); }
+                else { m_fsdClient->replayFsdCapture(parser.part(2), parser.toDouble(3, 1.0)); }
+                return true;
+            }
+            else if (parser.matchesPart(1, "posqueue") && parser.countParts() > 2 && m_fsdClient)
+            {
+                const bool on = parser.toBool(2);
+                m_fsdClient->setPositionQueueEnabled(on);
+                if (!on) { this->processQueuedPositions(); } // queued before the signals now emitted
+                CLogMessage(this).info(u"FSD positions via %1") << (on ? QStringLiteral("queue") : QStringLiteral("signals"));
+                return true;
+            }
         }
         return false;
     }
 
     void CAirspaceMonitor::fastProcessing()
     {
+        this->processQueuedPositions();
         if (!this->isConnectedAndNotShuttingDown()) { return; }
 
         // only send one query
@@ -428,6 +459,126 @@ namespace BlackCore
 
     }
 
+    void CAirspaceMonitor::processQueuedPositions()
+    {
+        if (!m_fsdClient) { return; }
+
+        // records of a previous session are discarded, the handlers check the connection
+        int n = 0;
+        do
+        {
+            n = m_fsdClient->takeQueuedPositions(m_positionBatch.data(), static_cast<int>(m_positionBatch.size()));
+            this->processPositionBatch(n);
+        }
+        while (n == static_cast<int>(m_positionBatch.size()));
+    }
+
+    void CAirspaceMonitor::processPositionBatch(int count)
+    {
+        Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Called in different thread");
+        if (count < 1 || !this->isConnectedAndNotShuttingDown()) { return; }
+
+        //! Position to be stored
+        struct QueuedPosition
+        {
+            CAircraftSituation situation;
+            CTransponder transponder;
+            bool isVisual = false;
+            bool isNew = false;        //!< new aircraft in range
+            bool samePosition = false; //!< visual update with the position of the latest situation
+        };
+
+        // same checks as onAircraftUpdateReceived/onAircraftVisualUpdateReceived
+        std::vector<QueuedPosition> positions;
+        positions.reserve(static_cast<size_t>(count));
+        CAircraftSituationList situations;
+        QHash<CCallsign, CAircraftSituation> latestInBatch; // not yet stored, but newer than the provider ones
+        CCallsignSet newInBatch;
+        for (int i = 0; i < count; ++i)
+        {
+            const FsdPositionRecord &record = m_positionBatch[static_cast<size_t>(i)];
+            QueuedPosition position;
+            position.situation = record.toSituation();
+            const CCallsign callsign(position.situation.getCallsign());
+            Q_ASSERT_X(!callsign.isEmpty(), Q_FUNC_INFO, "Empty callsign");
+            if (this->isCopilotAircraft(callsign)) { continue; }
+            const bool existsInRange = newInBatch.contains(callsign) || this->isAircraftInRange(callsign);
+
+            if (record.kind == FsdPositionRecord::VisualPilotData)
+            {
+                if (!existsInRange) { continue; }
+
+                // Visual packets do not have groundspeed, hence set the last known value.
+                // If there is no full position available yet, throw this visual position away.
+                const CAircraftSituation lastSituation = latestInBatch.contains(callsign) ? latestInBatch.value(callsign) : this->remoteAircraftSituation(callsign, 0);
+                if (lastSituation.isNull()) { continue; } // we need one full situation at least
+                position.situation.setCurrentUtcTime();
+                position.situation.setGroundSpeed(lastSituation.getGroundSpeed());
+                position.samePosition = lastSituation.equalNormalVectorDouble(position.situation);
+                position.isVisual = true;
+            }
+            else
+            {
+                // range (FSD overload issue)
+                const bool validMaxRange = this->handleMaxRange(position.situation);
+                if (!validMaxRange && !existsInRange) { continue; } // not valid at all
+                this->autoAdjustCientGndCapability(position.situation);
+                position.transponder = record.toTransponder();
+                position.isNew = !existsInRange;
+                if (position.isNew) { newInBatch.push_back(callsign); }
+            }
+
+            latestInBatch.insert(callsign, position.situation);
+            situations.push_back(position.situation);
+            positions.push_back(position);
+        }
+        if (positions.empty()) { return; }
+
+        // store situation history, one lock for all
+        this->storeAircraftSituationsCorrected(situations);
+
+        // update aircraft in the order received
+        for (const QueuedPosition &position : positions)
+        {
+            const CCallsign callsign(position.situation.getCallsign());
+            if (position.isVisual)
+            {
+                if (position.samePosition) { continue; } // nothing to update
+                this->updateAircraftInRangeDistanceBearing(
+                    callsign, position.situation,
+                    this->calculateDistanceToOwnAircraft(position.situation),
+                    this->calculateBearingToOwnAircraft(position.situation)
+                );
+            }
+            else if (position.isNew)
+            {
+                // NEW aircraft
+                const bool hasFsInnPacket = m_tempFsInnPackets.contains(callsign);
+
+                CSimulatedAircraft aircraft;
+                aircraft.setCallsign(callsign);
+                aircraft.setSituation(position.situation);
+                aircraft.setTransponder(position.transponder);
+                this->addNewAircraftInRange(aircraft);
+                this->sendInitialPilotQueries(callsign, true, !hasFsInnPacket);
+
+                // new client, there is a chance it has been already created by custom packet
+                const CClient client(callsign);
+                this->addNewClient(client);
+            }
+            else
+            {
+                // update, aircraft already exists
+                CPropertyIndexVariantMap vm;
+                vm.addValue(CSimulatedAircraft::IndexTransponder, position.transponder);
+                vm.addValue(CSimulatedAircraft::IndexSituation, position.situation);
+                vm.addValue(CSimulatedAircraft::IndexRelativeDistance, this->calculateDistanceToOwnAircraft(position.situation));
+                vm.addValue(CSimulatedAircraft::IndexRelativeBearing, this->calculateBearingToOwnAircraft(position.situation));
+                this->updateAircraftInRange(callsign, vm);
+            }
+        }
+    }
+
     void CAirspaceMonitor::slowProcessing()
     {
         if (!this->isConnectedAndNotShuttingDown()) { return; }
@@ -589,15 +740,17 @@ namespace BlackCore
         emit this->changedAtcStationsBooked(); // treat as stations were changed
     }
 
-    void CAirspaceMonitor::onReceivedVatsimDataFile()
+    void CAirspaceMonitor::onReceivedVatsimDataFile(const CCallsignSet &changedRemarks)
     {
         Q_ASSERT(CThreadUtils::isInThisThread(this));
         if (!sApp || sApp->isShuttingDown() || !sApp->getWebDataServices()) { return; }
+        if (changedRemarks.isEmpty()) { return; }
         CClientList clients(this->getClients()); // copy
         bool changed = false;
         for (auto client = clients.begin(); client != clients.end(); ++client)
         {
             if (client->hasSpecifiedVoiceCapabilities()) { continue; } // we already have voice caps
+            if (!changedRemarks.contains(client->getCallsign())) { continue; } // remarks unchanged, nothing new
             const CVoiceCapabilities vc = sApp->getWebDataServices()->getVoiceCapabilityForCallsign(client->getCallsign());
             if (vc.isUnknown()) { continue; }
             changed = true;
@@ -607,6 +760,48 @@ namespace BlackCore
         this->setClients(clients);
     }
 
+    void CAirspaceMonitor::onVatsimDataFilePilotsChanged(const CSimulatedAircraftList &added, const CSimulatedAircraftList &changed, const CCallsignSet &removed)
+    {
+        Q_ASSERT(CThreadUtils::isInThisThread(this));
+        Q_UNUSED(removed) // aircraft in range are removed by the network, not by the data file
+        if (!this->isConnectedAndNotShuttingDown()) { return; }
+
+        // complete the pilots of aircraft in range, data from the network take precedence
+        for (const CSimulatedAircraftList *aircraftList : { &added, &changed })
+        {
+            for (const CSimulatedAircraft &dataFileAircraft : *aircraftList)
+            {
+                const CCallsign callsign = dataFileAircraft.getCallsign();
+                if (!this->isAircraftInRange(callsign)) { continue; }
+                CUser pilot = this->getAircraftInRangeForCallsign(callsign).getPilot();
+                pilot.updateMissingParts(dataFileAircraft.getPilot());
+                this->updateAircraftInRange(callsign, CPropertyIndexVariantMap(CSimulatedAircraft::IndexPilot, CVariant::from(pilot)));
+            }
+        }
+    }
+
+    void CAirspaceMonitor::onVatsimDataFileControllersChanged(const CAtcStationList &added, const CAtcStationList &changed, const CCallsignSet &removed)
+    {
+        Q_ASSERT(CThreadUtils::isInThisThread(this));
+        Q_UNUSED(removed) // stations go offline by the network, not by the data file
+        if (!this->isConnectedAndNotShuttingDown()) { return; }
+
+        // complete the controllers of online stations, data from the network take precedence
+        int c = 0;
+        for (const CAtcStationList *stations : { &added, &changed })
+        {
+            for (const CAtcStation &dataFileStation : *stations)
+            {
+                const CCallsign callsign = dataFileStation.getCallsign();
+                if (!m_atcStationsOnline.containsCallsign(callsign)) { continue; }
+                CUser controller = m_atcStationsOnline.findFirstByCallsign(callsign).getController();
+                controller.updateMissingParts(dataFileStation.getController());
+                c += this->updateOnlineStation(callsign, CPropertyIndexVariantMap(CAtcStation::IndexController, CVariant::from(controller)), true, false);
+            }
+        }
+        if (c > 0) { emit this->changedAtcStationsOnline(); }
+    }
+
     CAirspaceMonitor::Readiness &CAirspaceMonitor::addMatchingReadinessFlag(const CCallsign &callsign, CAirspaceMonitor::MatchingReadinessFlag mrf)
     {
         Readiness &readiness = m_readiness[callsign].addFlag(mrf);
@@ -935,8 +1130,23 @@ namespace BlackCore
         CAircraftModel lookupModel; // result
         const CAircraftModelList modelSet = this->getModelSet();
         const CAircraftMatcherSetup setup = m_matchingSettings.get();
+
+        // the airline can be resolved from the callsign and the flight plan remarks, so the prefix and the remarks are part of the identity
+        const CFlightPlanRemarks fpRemarks = this->tryToGetFlightPlanRemarks(callsign);
+        const QString revision = CMatchingCache::modelSetRevision(modelSet) % u'_' % QString::number(qHash(setup.toQString(true))) % u'_' % QString::number(type) % u'_' % CMatchingCache::dbRevision();
+        const QString airlineIdentity = airlineIcaoString % u'/' % callsign.getAirlinePrefix() % u'/' % QString::number(qHash(fpRemarks.getRemarks()));
+        const QString cacheKey = CMatchingCache::cacheKey(aircraftIcaoString, airlineIdentity, liveryString, modelString, revision);
+        bool resolvedFromCache = false;
         do
         {
+            // same network identity resolved before with the same data?
+            if (CMatchingCache::instance().lookup(CMatchingCache::ReverseLookup, cacheKey, lookupModel))
+            {
+                CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Cached reverse lookup '%1'").arg(lookupModel.getModelStringAndDbKey()), CAirspaceMonitor::getLogCategories());
+                resolvedFromCache = true;
+                break;
+            }
+
             // directly check model string
             if (!modelString.isEmpty())
             {
@@ -990,7 +1200,6 @@ namespace BlackCore
             // if we have a livery, we already know the airline, or the livery is a color livery
             if (!airlineIcao.hasValidDbKey() && !livery.hasValidDbKey())
             {
-                const CFlightPlanRemarks fpRemarks = this->tryToGetFlightPlanRemarks(callsign);
                 // const bool hasParsedAirlineRemarks = fpRemarks.hasParsedAirlineRemarks();
 
                 QString airlineNameLookup;
@@ -1009,8 +1218,8 @@ namespace BlackCore
                     CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("FP rem.parsed: '%1'").arg(fpRemarks.toQString(true)));
 
                     // FP data if any
-                    telephonyFromFp   = CAircraftMatcher::reverseLookupTelephonyDesignator(fpRemarks.getRadioTelephony(), callsign, log);
-                    airlineNameFromFp = CAircraftMatcher::reverseLookupAirlineName(fpRemarks.getFlightOperator(), callsign, log);
+                    telephonyFromFp   = CAircraftMatcher::reverseLookupTelephonyDesignator(fpRemarks.getRadioTelephony(), callsign, setup.isReverseLookupSimilarAirlineNames(), log);
+                    airlineNameFromFp = CAircraftMatcher::reverseLookupAirlineName(fpRemarks.getFlightOperator(), callsign, setup.isReverseLookupSimilarAirlineNames(), log);
                     airlineIcaoFromFp = fpRemarks.getAirlineIcao().getDesignator();
 
                     // turn into names as in DB
@@ -1047,6 +1256,9 @@ namespace BlackCore
         }
         while (false);
 
+        // cached before the script, the script always runs
+        if (!resolvedFromCache) { CMatchingCache::instance().insert(CMatchingCache::ReverseLookup, cacheKey, lookupModel); }
+
         // model found
         lookupModel.setCallsign(callsign);
 
@@ -1429,6 +1641,9 @@ namespace BlackCore
     {
         Q_ASSERT(CThreadUtils::isInThisThread(this));
 
+        // positions received before the disconnect must not re-add the aircraft
+        this->processQueuedPositions();
+
         // in case of inconsistencies I always remove here
         this->removeFromAircraftCachesAndLogs(callsign);
         const bool removed = CRemoteAircraftProvider::removeAircraft(callsign);
@@ -1529,9 +1744,53 @@ namespace BlackCore
         BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "empty callsign");
         if (callsign.isEmpty()) { return situation; }
 
-        CAircraftSituation correctedSituation(allowTestOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
         bool needToRequestElevation  = false;
-        bool canLikelySkipNearGround = correctedSituation.canLikelySkipNearGroundInterpolation();
+        bool canLikelySkipNearGround = false;
+        CAircraftSituation correctedSituation = this->correctSituationBeforeStoring(situation, allowTestOffset, needToRequestElevation, canLikelySkipNearGround);
+
+        // store corrected situation
+        correctedSituation = CRemoteAircraftProvider::storeAircraftSituation(correctedSituation, false); // we already added offset if any
+        this->requestElevationAfterStoring(correctedSituation, needToRequestElevation, canLikelySkipNearGround);
+        return correctedSituation;
+    }
+
+    CAircraftSituationList CAirspaceMonitor::storeAircraftSituationsCorrected(const CAircraftSituationList &situations)
+    {
+        // corrected one by one, the situations of a callsign in this batch do not see each other
+        // this is fine for the few positions per callsign received between two fast processing cycles
+        CAircraftSituationList correctedSituations;
+        correctedSituations.reserve(situations.size());
+        QHash<CCallsign, std::pair<bool, bool>> elevationRequests; // latest situation per callsign: need to request, can skip
+        for (const CAircraftSituation &situation : situations)
+        {
+            const CCallsign callsign(situation.getCallsign());
+            BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "empty callsign");
+            if (callsign.isEmpty()) { continue; }
+
+            bool needToRequestElevation  = false;
+            bool canLikelySkipNearGround = false;
+            correctedSituations.push_back(this->correctSituationBeforeStoring(situation, true, needToRequestElevation, canLikelySkipNearGround));
+            elevationRequests.insert(callsign, { needToRequestElevation, canLikelySkipNearGround });
+        }
+
+        // one lock for all, stored situations are grouped by callsign, latest situation of a callsign last
+        const CAircraftSituationList stored = CRemoteAircraftProvider::storeAircraftSituations(correctedSituations, false); // we already added offset if any
+        QHash<CCallsign, int> latestStored;
+        for (int i = 0; i < stored.size(); ++i) { latestStored.insert(stored[i].getCallsign(), i); }
+        for (auto it = latestStored.cbegin(); it != latestStored.cend(); ++it)
+        {
+            const std::pair<bool, bool> request = elevationRequests.value(it.key());
+            this->requestElevationAfterStoring(stored[it.value()], request.first, request.second);
+        }
+        return stored;
+    }
+
+    CAircraftSituation CAirspaceMonitor::correctSituationBeforeStoring(const CAircraftSituation &situation, bool allowTestOffset, bool &needToRequestElevation, bool &canLikelySkipNearGround)
+    {
+        const CCallsign callsign(situation.getCallsign());
+        CAircraftSituation correctedSituation(allowTestOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
+        needToRequestElevation  = false;
+        canLikelySkipNearGround = correctedSituation.canLikelySkipNearGroundInterpolation();
         do
         {
             // Check if we can bail out and ignore all elevation handling
@@ -1689,23 +1948,21 @@ namespace BlackCore
         // CG from provider
         const CLength cg = this->getSimulatorOrDbCG(callsign, this->getCGFromDB(callsign)); // always x-check against simulator to override guessed values and reflect changed CGs
         if (!cg.isNull()) { correctedSituation.setCG(cg); }
+        return correctedSituation;
+    }
 
-        // store corrected situation
-        correctedSituation = CRemoteAircraftProvider::storeAircraftSituation(correctedSituation, false); // we already added offset if any
-
+    void CAirspaceMonitor::requestElevationAfterStoring(const CAircraftSituation &storedSituation, bool needToRequestElevation, bool canLikelySkipNearGround)
+    {
         // check if we need want to request
         if (needToRequestElevation && !canLikelySkipNearGround)
         {
             // we have not requested so far, but we are NEAR ground
             // we expect at least not transferred cache or we are moving and have no provider elevation yet
-            if (correctedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromCache, false) || (correctedSituation.isMoving() && correctedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromProvider, false)))
+            if (storedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromCache, false) || (storedSituation.isMoving() && storedSituation.isOtherElevationInfoBetter(CAircraftSituation::FromProvider, false)))
             {
-                needToRequestElevation = this->requestElevation(correctedSituation);
+                this->requestElevation(storedSituation);
             }
         }
-
-        Q_UNUSED(needToRequestElevation)
-        return correctedSituation;
     }
 
     void CAirspaceMonitor::sendInitialAtcQueries(const CCallsign &callsign)
@@ -11,6 +11,7 @@
 #ifndef BLACKCORE_AIRSPACE_MONITOR_H
 #define BLACKCORE_AIRSPACE_MONITOR_H
 
+#include "blackcore/fsd/fsdpositionrecord.h"
 #include "blackcore/blackcoreexport.h"
 #include "blackmisc/simulation/settings/modelmatchersettings.h"
 #include "blackmisc/simulation/aircraftmodelsetprovider.h"
@@ -50,6 +51,7 @@
 #include <QtGlobal>
 #include <QQueue>
 #include <functional>
+#include <vector>
 
 namespace BlackCore
 {
@@ -177,6 +179,11 @@ namespace BlackCore
         //! @{
         //! <pre>
         //! .fsd range distance        max.range e.g. ".fsd range 100NM"
+        //! .fsd capture file          capture received FSD lines to file
+        //! .fsd capture stop          stop capturing
+        //! .fsd replay file [speed]   replay a capture while disconnected, speed 0 is max.speed
+        //! .fsd replay stop           stop replay
+        //! .fsd posqueue on|off       positions via lock-free queue or signals (default)
         //! </pre>
         //! @}
         //! \copydoc BlackCore::Context::IContextNetwork::parseCommandLine
@@ -187,6 +194,9 @@ namespace BlackCore
         {
             if (BlackMisc::CSimpleCommandParser::registered("BlackCore::Fsd::CFSDClient")) { return; }
             BlackMisc::CSimpleCommandParser::registerCommand({".fsd range distance", "FSD max. range"});
+            BlackMisc::CSimpleCommandParser::registerCommand({".fsd capture file|stop", "capture received FSD lines"});
+            BlackMisc::CSimpleCommandParser::registerCommand({".fsd replay file [speed]|stop", "replay FSD capture"});
+            BlackMisc::CSimpleCommandParser::registerCommand({".fsd posqueue on|off", "FSD positions via queue"});
         }
 
     signals:
@@ -304,6 +314,17 @@ namespace BlackCore
         //! Fast processing by timer
         void fastProcessing();
 
+        //! Process the positions queued by the FSD client, see Fsd::CFSDClient::setPositionQueueEnabled
+        //! \remark also called before a pilot is removed, so older positions cannot re-add the aircraft
+        void processQueuedPositions();
+
+        //! Process the first count records of CAirspaceMonitor::m_positionBatch
+        //! \remark same as onAircraftUpdateReceived and onAircraftVisualUpdateReceived for each record, but the situations are stored with one batch call
+        void processPositionBatch(int count);
+
+        static constexpr int PositionBatchSize = 512; //!< records taken from the queue in one go
+        std::vector<Fsd::FsdPositionRecord> m_positionBatch; //!< reused batch buffer
+
         // Processing for validations etc. (slow)
         static constexpr int SlowProcessIntervalMs = 125 * 1000; //!< interval in ms
         QTimer m_slowProcessTimer; //!< process timer for slow updates
@@ -371,6 +392,17 @@ namespace BlackCore
         //! \remark uses gnd.elevation if found
         virtual BlackMisc::Aviation::CAircraftSituation storeAircraftSituation(const BlackMisc::Aviation::CAircraftSituation &situation, bool allowTestOffset = true) override;
 
+        //! Store multiple aircraft situations, corrected as by storeAircraftSituation, but with one batch call
+        //! emark elevations are only requested for the latest situation of each callsign
+        //! \sa BlackMisc::Simulation::CRemoteAircraftProvider::storeAircraftSituations
+        BlackMisc::Aviation::CAircraftSituationList storeAircraftSituationsCorrected(const BlackMisc::Aviation::CAircraftSituationList &situations);
+
+        //! Situation with gnd.flags/CG and elevation, as it will be stored
+        BlackMisc::Aviation::CAircraftSituation correctSituationBeforeStoring(const BlackMisc::Aviation::CAircraftSituation &situation, bool allowTestOffset, bool &needToRequestElevation, bool &canLikelySkipNearGround);
+
+        //! Request the elevation for a stored situation if it is still needed
+        void requestElevationAfterStoring(const BlackMisc::Aviation::CAircraftSituation &storedSituation, bool needToRequestElevation, bool canLikelySkipNearGround);
+
         //! Add or update aircraft
         BlackMisc::Simulation::CSimulatedAircraft addOrUpdateAircraftInRange(const BlackMisc::Aviation::CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, const QString &modelString, BlackMisc::Simulation::CAircraftModel::ModelType modelType, BlackMisc::CStatusMessageList *log);
 
@@ -451,7 +483,9 @@ namespace BlackCore
         void onFrequencyReceived(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::PhysicalQuantities::CFrequency &frequency);
         void onReceivedAtcBookings(const BlackMisc::Aviation::CAtcStationList &bookedStations);
         void onReadUnchangedAtcBookings();
-        void onReceivedVatsimDataFile();
+        void onReceivedVatsimDataFile(const BlackMisc::Aviation::CCallsignSet &changedRemarks);
+        void onVatsimDataFilePilotsChanged(const BlackMisc::Simulation::CSimulatedAircraftList &added, const BlackMisc::Simulation::CSimulatedAircraftList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
+        void onVatsimDataFileControllersChanged(const BlackMisc::Aviation::CAtcStationList &added, const BlackMisc::Aviation::CAtcStationList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
         void onAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QJsonObject &jsonObject, qint64 currentOffsetMs);
         void onAircraftInterimUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
         void onAircraftVisualUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
@@ -143,6 +143,12 @@ namespace BlackCore::Context
         return m_airspace->remoteAircraftSituation(callsign, index);
     }
 
+    CCompactSituations CContextNetwork::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        if (!this->canUseAirspaceMonitor()) { return {}; }
+        return m_airspace->remoteAircraftSituationsCompact(callsign);
+    }
+
     MillisecondsMinMaxMean CContextNetwork::remoteAircraftSituationsTimestampDifferenceMinMaxMean(const CCallsign &callsign) const
     {
         if (!this->canUseAirspaceMonitor()) { return {}; }
@@ -173,6 +179,16 @@ namespace BlackCore::Context
         return m_airspace->remoteAircraftPartsCount(callsign);
     }
 
+    CAircraftParts CContextNetwork::remoteAircraftPartsValidAt(const CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount) const
+    {
+        if (!this->canUseAirspaceMonitor())
+        {
+            if (partsCount) { *partsCount = 0; }
+            return {};
+        }
+        return m_airspace->remoteAircraftPartsValidAt(callsign, adjustedMsSinceEpoch, partsCount);
+    }
+
     int CContextNetwork::remoteAircraftSituationsCount(const CCallsign &callsign) const
     {
         if (!this->canUseAirspaceMonitor()) { return 0; }
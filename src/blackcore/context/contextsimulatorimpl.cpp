@@ -15,6 +15,7 @@
 #include "blackcore/db/databaseutils.h"
 #include "blackcore/corefacade.h"
 #include "blackcore/application.h"
+#include "blackcore/matchingcache.h"
 #include "blackcore/pluginmanagersimulator.h"
 #include "blackcore/simulator.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
@@ -147,6 +148,9 @@ namespace BlackCore::Context
         // if simconnect is running remotely it can take a while until it shutdowns
         m_listenersThread.quit();
         m_listenersThread.wait(10 * 1000);
+
+        // process wide cache used by all matchers and the airspace monitor, saved once
+        if (CMatchingCache::instance().hasChanges()) { CMatchingCache::instance().saveToFile(); }
     }
 
     CSimulatorPluginInfoList CContextSimulator::getAvailableSimulatorPlugins() const
@@ -293,13 +297,22 @@ namespace BlackCore::Context
     QStringList CContextSimulator::getModelSetStrings() const
     {
         if (m_debugEnabled) { CLogMessage(this, CLogCategories::contextSlot()).debug() << Q_FUNC_INFO; }
-        return this->getModelSet().getModelStringList(false);
+        const CSimulatorInfo simulator = this->getModelSetLoaderSimulator();
+        if (!simulator.isSingleSimulator()) { return {}; }
+
+        // from the binary snapshot without materializing the model set
+        CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().synchronizeCache(simulator);
+        return CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().getCachedModelStrings(simulator);
     }
 
     bool CContextSimulator::isKnownModelInSet(const QString &modelString) const
     {
         if (m_debugEnabled) { CLogMessage(this, CLogCategories::contextSlot()).debug() << Q_FUNC_INFO; }
-        const bool known = this->getModelSet().containsModelString(modelString);
+        const CSimulatorInfo simulator = this->getModelSetLoaderSimulator();
+        if (!simulator.isSingleSimulator()) { return false; }
+
+        CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().synchronizeCache(simulator);
+        const bool known = CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance().containsCachedModelString(simulator, modelString);
         return known;
     }
 
@@ -690,8 +703,40 @@ namespace BlackCore::Context
         MatchingLog whatToLog = m_logMatchingMessages;
         CStatusMessageList matchingMessages;
         CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
-        CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
-        Q_ASSERT_X(remoteAircraft.getCallsign() == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
+        const CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
+        this->addMatchedRemoteAircraft(remoteAircraft, aircraftModel, pMatchingMessages);
+    }
+
+    void CContextSimulator::xCtxAddedRemoteAircraftsReadyForModelMatching(const CSimulatedAircraftList &remoteAircraft)
+    {
+        if (!this->isSimulatorPluginAvailable()) { return; }
+
+        CSimulatedAircraftList aircraftWithCallsign;
+        for (const CSimulatedAircraft &aircraft : remoteAircraft)
+        {
+            BLACK_VERIFY_X(!aircraft.getCallsign().isEmpty(), Q_FUNC_INFO, "Remote aircraft with empty callsign");
+            if (!aircraft.getCallsign().isEmpty()) { aircraftWithCallsign.push_back(aircraft); }
+        }
+        if (aircraftWithCallsign.isEmpty()) { return; }
+
+        // matching in parallel, adding to the simulator one by one in this thread
+        const MatchingLog whatToLog = m_logMatchingMessages;
+        const bool logMatching = m_logMatchingMessages > 0;
+        QHash<CCallsign, CStatusMessageList> matchingMessages;
+        const CAircraftModelList models = m_aircraftMatcher.getClosestMatches(aircraftWithCallsign, whatToLog, logMatching ? &matchingMessages : nullptr, true);
+        for (int i = 0; i < aircraftWithCallsign.sizeInt(); ++i)
+        {
+            if (!this->isSimulatorPluginAvailable()) { return; }
+            CStatusMessageList messages = matchingMessages.value(aircraftWithCallsign[i].getCallsign());
+            this->addMatchedRemoteAircraft(aircraftWithCallsign[i], models[i], logMatching ? &messages : nullptr);
+        }
+    }
+
+    void CContextSimulator::addMatchedRemoteAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModel &matchedModel, CStatusMessageList *matchingMessages)
+    {
+        const CCallsign callsign = remoteAircraft.getCallsign();
+        CAircraftModel aircraftModel(matchedModel);
+        Q_ASSERT_X(callsign == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
 
         // decide CG
         const CLength cgModel = aircraftModel.getCG();
@@ -731,17 +776,17 @@ namespace BlackCore::Context
             CSimulatedAircraft brokenAircraft(aircraftAfterModelApplied);
             brokenAircraft.setEnabled(false);
             brokenAircraft.setRendered(false);
-            CCallsign::addLogDetailsToList(pMatchingMessages, callsign, QStringLiteral("Cannot add remote aircraft, no model string: '%1'").arg(brokenAircraft.toQString()));
+            CCallsign::addLogDetailsToList(matchingMessages, callsign, QStringLiteral("Cannot add remote aircraft, no model string: '%1'").arg(brokenAircraft.toQString()));
             emit this->aircraftRenderingChanged(brokenAircraft);
             return;
         }
 
         // here the model is added to the simulator
         m_simulatorPlugin.second->logicallyAddRemoteAircraft(aircraftAfterModelApplied);
-        CCallsign::addLogDetailsToList(pMatchingMessages, callsign, QStringLiteral("Logically added remote aircraft: %1").arg(aircraftAfterModelApplied.toQString()));
+        CCallsign::addLogDetailsToList(matchingMessages, callsign, QStringLiteral("Logically added remote aircraft: %1").arg(aircraftAfterModelApplied.toQString()));
 
         this->clearMatchingMessages(callsign);
-        this->addMatchingMessages(callsign, matchingMessages);
+        this->addMatchingMessages(callsign, matchingMessages ? *matchingMessages : CStatusMessageList());
 
         // done
         emit this->modelMatchingCompleted(aircraftAfterModelApplied);
@@ -766,11 +811,7 @@ namespace BlackCore::Context
 
             // initially add aircraft
             const CSimulatedAircraftList aircraft = networkContext->getAircraftInRange();
-            for (const CSimulatedAircraft &simulatedAircraft : aircraft)
-            {
-                BLACK_VERIFY_X(!simulatedAircraft.getCallsign().isEmpty(), Q_FUNC_INFO, "Need callsign");
-                this->xCtxAddedRemoteAircraftReadyForModelMatching(simulatedAircraft);
-            }
+            this->xCtxAddedRemoteAircraftsReadyForModelMatching(aircraft);
             m_initallyAddAircraft = false;
         }
 
@@ -1194,17 +1235,24 @@ namespace BlackCore::Context
         if (m_debugEnabled) { CLogMessage(this, CLogCategories::contextSlot()).debug() << Q_FUNC_INFO; }
         const CCallsignSet callsigns = this->getAircraftInRangeCallsigns();
         if (callsigns.isEmpty()) { return 0; }
-        int delayMs = 25;
+        if (!this->isSimulatorAvailable()) { return 0; }
+
+        // one batch instead of one matching per aircraft
         QPointer<CContextSimulator> myself(this);
-        for (const CCallsign &cs : callsigns)
+        QTimer::singleShot(2500, this, [ = ]
         {
-            QTimer::singleShot(delayMs, this, [ = ]
+            if (!sApp || sApp->isShuttingDown() || !myself) { return; }
+            CSimulatedAircraftList resetAircraft;
+            for (const CCallsign &cs : callsigns)
             {
-                if (!sApp || sApp->isShuttingDown() || !myself) { return; }
-                this->doMatchingAgain(cs);
-            });
-            delayMs += 25;
-        }
+                CSimulatedAircraft aircraft = this->getAircraftInRangeForCallsign(cs);
+                if (!aircraft.hasCallsign()) { continue; } // no longer valid
+                aircraft.resetToNetworkModel();
+                aircraft.setEnabled(true);
+                resetAircraft.push_back(aircraft);
+            }
+            this->xCtxAddedRemoteAircraftsReadyForModelMatching(resetAircraft);
+        });
         return callsigns.size();
     }
 
@@ -195,6 +195,9 @@ namespace BlackCore
             //! Remote aircraft added and ready for model matching
             void xCtxAddedRemoteAircraftReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft);
 
+            //! Many remote aircraft ready for model matching, matched in parallel
+            void xCtxAddedRemoteAircraftsReadyForModelMatching(const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft);
+
             //! Remove remote aircraft
             void xCtxRemovedRemoteAircraft(const BlackMisc::Aviation::CCallsign &callsign);
 
@@ -263,6 +266,9 @@ namespace BlackCore
             //! Call stop() on all loaded listeners
             void stopSimulatorListeners();
 
+            //! Apply the matched model and logically add the remote aircraft to the simulator
+            void addMatchedRemoteAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &matchedModel, BlackMisc::CStatusMessageList *matchingMessages);
+
             //! Add to message list for matching
             void addMatchingMessages(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::CStatusMessageList &messages);
 
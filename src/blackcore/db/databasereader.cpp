@@ -239,7 +239,8 @@ namespace BlackCore::Db
         const bool ok = this->setHeaderInfoPart(datastoreResponse, nwReply);
         if (ok)
         {
-            const QString dataFileData = nwReply->readAll();
+            // raw bytes, the entities are decoded from the UTF-8 data without QString and full QJsonDocument
+            const QByteArray dataFileData = nwReply->readAll();
             nwReply->close(); // close asap
             datastoreResponse.setStringSize(dataFileData.size());
             if (dataFileData.isEmpty())
@@ -248,7 +249,7 @@ namespace BlackCore::Db
             }
             else
             {
-                CDatabaseReader::stringToDatastoreResponse(dataFileData, datastoreResponse);
+                CDatabaseReader::dataToDatastoreResponse(dataFileData, datastoreResponse);
             }
         }
         return datastoreResponse;
@@ -753,6 +754,11 @@ namespace BlackCore::Db
     }
 
     void CDatabaseReader::stringToDatastoreResponse(const QString &jsonContent, JsonDatastoreResponse &datastoreResponse)
+    {
+        CDatabaseReader::dataToDatastoreResponse(jsonContent.toUtf8(), datastoreResponse);
+    }
+
+    void CDatabaseReader::dataToDatastoreResponse(const QByteArray &jsonContent, JsonDatastoreResponse &datastoreResponse)
     {
         const int status = datastoreResponse.getHttpStatusCode();
         if (jsonContent.isEmpty())
@@ -764,40 +770,41 @@ namespace BlackCore::Db
             return;
         }
 
-        const QJsonDocument jsonResponse = CDatabaseUtils::databaseJsonToQJsonDocument(jsonContent);
-        if (jsonResponse.isEmpty())
+        const QByteArray jsonData = CDatabaseUtils::databaseJsonToUtf8(jsonContent);
+        const CJsonArrayStreamReader jsonStream = CJsonArrayStreamReader::fromData(jsonData);
+        if (jsonData.isEmpty() || !jsonStream.isComplete())
         {
-            if (CNetworkUtils::looksLikePhpErrorMessage(jsonContent))
+            const QString content = QString::fromUtf8(jsonContent);
+            if (CNetworkUtils::looksLikePhpErrorMessage(content))
             {
                 static const QString errorMsg = "Looks like PHP errror, status %1, URL: '%2', msg: %3";
-                const QString phpErrorMessage = CNetworkUtils::removeHtmlPartsFromPhpErrorMessage(jsonContent);
+                const QString phpErrorMessage = CNetworkUtils::removeHtmlPartsFromPhpErrorMessage(content);
                 datastoreResponse.setMessage(CStatusMessage(static_cast<CDatabaseReader *>(nullptr),
                                                 CStatusMessage::SeverityError,
                                                 errorMsg.arg(status).arg(datastoreResponse.getUrlString(), phpErrorMessage)));
             }
             else
             {
-                static const QString errorMsg = "Empty JSON document, URL: '%1', load time: %2";
+                static const QString errorMsg = "Empty JSON document, URL: '%1', load time: %2 %3";
                 datastoreResponse.setMessage(CStatusMessage(static_cast<CDatabaseReader *>(nullptr),
                                                 CStatusMessage::SeverityError,
-                                                errorMsg.arg(datastoreResponse.getUrlString(), datastoreResponse.getLoadTimeStringWithStartedHint())));
+                                                errorMsg.arg(datastoreResponse.getUrlString(), datastoreResponse.getLoadTimeStringWithStartedHint(), jsonStream.getErrorMessage())));
             }
             return;
         }
 
-        if (jsonResponse.isArray())
+        datastoreResponse.setJsonStream(jsonStream);
+        if (jsonStream.isTopLevelArray())
         {
             // directly an array, no further info
-            datastoreResponse.setJsonArray(jsonResponse.array());
             datastoreResponse.setLastModifiedTimestamp(QDateTime::currentDateTimeUtc());
         }
         else
         {
-            const QJsonObject responseObject(jsonResponse.object());
-            datastoreResponse.setJsonArray(responseObject["data"].toArray());
-            const QString ts(responseObject["latest"].toString());
+            const QJsonObject &envelope = jsonStream.getEnvelope();
+            const QString ts(envelope["latest"].toString());
             datastoreResponse.setLastModifiedTimestamp(ts.isEmpty() ? QDateTime::currentDateTimeUtc() : CDatastoreUtility::parseTimestamp(ts));
-            datastoreResponse.setRestricted(responseObject["restricted"].toBool());
+            datastoreResponse.setRestricted(envelope["restricted"].toBool());
         }
     }
 
@@ -806,12 +813,6 @@ namespace BlackCore::Db
         return CNetworkWatchdog::isDbUrl(this->getUrl());
     }
 
-    void CDatabaseReader::JsonDatastoreResponse::setJsonArray(const QJsonArray &value)
-    {
-        m_jsonArray = value;
-        m_arraySize = value.size();
-    }
-
     QString CDatabaseReader::JsonDatastoreResponse::toQString() const
     {
         static const QString s("DB: %1 | restricted: %2 | array: %3 | string size: %4 | content: %5");
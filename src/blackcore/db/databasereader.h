@@ -16,6 +16,7 @@
 #include "blackmisc/db/dbinfolist.h"
 #include "blackmisc/pq/time.h"
 #include "blackmisc/network/url.h"
+#include "blackmisc/jsonarraystreamreader.h"
 #include "blackmisc/statusmessage.h"
 #include "blackcore/threadedreader.h"
 #include "blackmisc/sequence.h"
@@ -124,17 +125,17 @@ namespace BlackCore::Db
         };
 
         //!  Response from our database (depending on JSON DB backend generates)
+        //! \remark the entities are kept as raw JSON and decoded one by one, see BlackMisc::CJsonArrayStreamReader
         struct JsonDatastoreResponse : public HeaderResponse
         {
         private:
-            QJsonArray m_jsonArray;          //!< JSON array data
-            int        m_arraySize  = -1;    //!< size of array, if applicable (copied to member for debugging purposes)
+            BlackMisc::CJsonArrayStreamReader m_jsonStream; //!< JSON array data
             int        m_stringSize =  0;    //!< string size of JSON data
             bool       m_restricted = false; //!< restricted reponse, only changed data
 
         public:
             //! Any data?
-            bool isEmpty() const { return m_jsonArray.isEmpty(); }
+            bool isEmpty() const { return m_jsonStream.isEmpty(); }
 
             //! Is loaded from database
             bool isLoadedFromDb() const;
@@ -146,13 +147,17 @@ namespace BlackCore::Db
             void setRestricted(bool restricted) { m_restricted = restricted; }
 
             //! Get the JSON array
-            QJsonArray getJsonArray() const { return m_jsonArray; }
+            //! \remark decodes all elements at once, prefer getJsonStream
+            QJsonArray getJsonArray() const { return m_jsonStream.toJsonArray(); }
+
+            //! The JSON array elements, decoded on access
+            const BlackMisc::CJsonArrayStreamReader &getJsonStream() const { return m_jsonStream; }
 
             //! Number of elements
-            int getArraySize() const { return m_jsonArray.size(); }
+            int getArraySize() const { return m_jsonStream.getElementCount(); }
 
-            //! Set the JSON array
-            void setJsonArray(const QJsonArray &value);
+            //! Set the JSON array elements
+            void setJsonStream(const BlackMisc::CJsonArrayStreamReader &stream) { m_jsonStream = stream; }
 
             //! Set string size
             void setStringSize(int size) { m_stringSize = size; }
@@ -161,7 +166,7 @@ namespace BlackCore::Db
             QString toQString() const;
 
             //! Implicit conversion
-            operator QJsonArray() const { return m_jsonArray; }
+            operator QJsonArray() const { return this->getJsonArray(); }
         };
 
         //! Start reading in own thread
@@ -287,6 +292,9 @@ namespace BlackCore::Db
         //! \private used also for samples, that`s why it is declared public
         static void stringToDatastoreResponse(const QString &jsonContent, CDatabaseReader::JsonDatastoreResponse &datastoreResponse);
 
+        //! Parses the raw (UTF-8, maybe compressed) data into the response, the entities are not decoded yet
+        static void dataToDatastoreResponse(const QByteArray &jsonContent, CDatabaseReader::JsonDatastoreResponse &datastoreResponse);
+
     signals:
         //! DB have been read
         void swiftDbDataRead(bool success);
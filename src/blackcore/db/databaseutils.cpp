@@ -400,39 +400,38 @@ namespace BlackCore::Db
 
     QJsonDocument CDatabaseUtils::databaseJsonToQJsonDocument(const QString &content)
     {
-        static const QString compressed("swift:");
         if (content.isEmpty()) { return QJsonDocument(); }
-        QByteArray byteData;
-        if (Json::looksLikeJson(content))
+        const QByteArray byteData = CDatabaseUtils::databaseJsonToUtf8(content.toUtf8());
+        if (byteData.isEmpty()) { return QJsonDocument(); }
+        return QJsonDocument::fromJson(byteData);
+    }
+
+    QByteArray CDatabaseUtils::databaseJsonToUtf8(const QByteArray &content)
+    {
+        static const QByteArray compressed("swift:");
+        if (content.isEmpty()) { return QByteArray(); }
+        const QByteArray trimmed = content.trimmed();
+        if (trimmed.startsWith('{') && trimmed.endsWith('}'))
         {
-            // uncompressed
-            byteData = content.toUtf8();
+            // uncompressed, no copy
+            return content;
         }
-        else if (content.startsWith(compressed) && content.length() > compressed.length() + 3)
+
+        if (content.startsWith(compressed) && content.length() > compressed.length() + 3)
         {
-            do
-            {
-                // "swift:1234:base64encoded
-                const int cl = compressed.length();
-                const int contentIndex = content.indexOf(':', cl);
-                if (contentIndex < cl) break; // should not happen, malformed
-                const QString ls = content.mid(cl, contentIndex - cl); // content length
-                bool ok;
-                const qint32 size = ls.toInt(&ok);
-                if (!ok) break; // malformed size
-                if (size < 1) break;
-
-                QByteArray ba;
-                ba.append(content.mid(contentIndex));
-                ba = QByteArray::fromBase64(ba);
-                ba.insert(0, CCompressUtils::lengthHeader(size)); // adding 4 bytes length header
-                byteData = qUncompress(ba);
-            }
-            while (false);
+            // "swift:1234:base64encoded
+            const int cl = compressed.length();
+            const int contentIndex = content.indexOf(':', cl);
+            if (contentIndex < cl) { return QByteArray(); } // should not happen, malformed
+            bool ok;
+            const qint32 size = content.mid(cl, contentIndex - cl).toInt(&ok); // content length
+            if (!ok || size < 1) { return QByteArray(); } // malformed size
+
+            QByteArray ba = QByteArray::fromBase64(content.mid(contentIndex + 1));
+            ba.insert(0, CCompressUtils::lengthHeader(size)); // adding 4 bytes length header
+            return qUncompress(ba);
         }
-
-        if (byteData.isEmpty()) { return QJsonDocument(); }
-        return QJsonDocument::fromJson(byteData);
+        return QByteArray();
     }
 
     QJsonDocument CDatabaseUtils::readQJsonDocumentFromDatabaseFile(const QString &filename)
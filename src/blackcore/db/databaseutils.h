@@ -79,6 +79,10 @@ namespace BlackCore::Db
         //! Database JSON from content string, which can be compressed
         static QJsonDocument databaseJsonToQJsonDocument(const QString &content);
 
+        //! Uncompressed UTF-8 JSON from database content, which can be compressed
+        //! \remark empty if the content is neither JSON nor compressed JSON
+        static QByteArray databaseJsonToUtf8(const QByteArray &content);
+
         //! QJsonDocument from database JSON file (normally shared file)
         static QJsonDocument readQJsonDocumentFromDatabaseFile(const QString &filename);
 
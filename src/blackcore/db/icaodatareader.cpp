@@ -304,14 +304,14 @@ namespace BlackCore::Db
             return;
         }
 
-        emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadParsing, 0, url);
+        emit this->dataRead(CEntityFlags::AircraftIcaoEntity, CEntityFlags::ReadParsing, res.getArraySize(), url);
         CAircraftIcaoCodeList codes;
         CAircraftIcaoCodeList inconsistent;
         const CAircraftCategoryList categories = this->getAircraftCategories();
         if (res.isRestricted())
         {
             // create full list if it was just incremental
-            const CAircraftIcaoCodeList incrementalCodes(CAircraftIcaoCodeList::fromDatabaseJson(res, categories, true, &inconsistent));
+            const CAircraftIcaoCodeList incrementalCodes(CAircraftIcaoCodeList::fromDatabaseJson(res.getJsonStream(), categories, true, &inconsistent));
             if (incrementalCodes.isEmpty()) { return; } // currently ignored
             codes = this->getAircraftIcaoCodes();
             codes.replaceOrAddObjectsByKey(incrementalCodes);
@@ -321,7 +321,7 @@ namespace BlackCore::Db
             // normally read from special DB view which already filters incomplete
             QElapsedTimer time;
             time.start();
-            codes  = CAircraftIcaoCodeList::fromDatabaseJson(res, categories, true, &inconsistent);
+            codes  = CAircraftIcaoCodeList::fromDatabaseJson(res.getJsonStream(), categories, true, &inconsistent);
             this->logParseMessage("aircraft ICAO", codes.size(), static_cast<int>(time.elapsed()), res);
         }
 
@@ -307,12 +307,12 @@ namespace BlackCore::Db
         }
 
         // get all or incremental set of distributor
-        emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadParsing, 0, res.getUrl());
+        emit this->dataRead(CEntityFlags::LiveryEntity, CEntityFlags::ReadParsing, res.getArraySize(), res.getUrl());
         CLiveryList liveries;
         if (res.isRestricted())
         {
             // create full list if it was just incremental
-            const CLiveryList incrementalLiveries(CLiveryList::fromDatabaseJson(res));
+            const CLiveryList incrementalLiveries(CLiveryList::fromDatabaseJson(res.getJsonStream()));
             if (incrementalLiveries.isEmpty()) { return; } // currenty ignored
             liveries = this->getLiveries();
             liveries.replaceOrAddObjectsByKey(incrementalLiveries);
@@ -321,7 +321,7 @@ namespace BlackCore::Db
         {
             QElapsedTimer time;
             time.start();
-            liveries  = CLiveryList::fromDatabaseJson(res);
+            liveries  = CLiveryList::fromDatabaseJson(res.getJsonStream());
             this->logParseMessage("liveries", liveries.size(), static_cast<int>(time.elapsed()), res);
         }
 
@@ -355,12 +355,12 @@ namespace BlackCore::Db
         }
 
         // get all or incremental set of distributors
-        emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadParsing, 0, res.getUrl());
+        emit this->dataRead(CEntityFlags::DistributorEntity, CEntityFlags::ReadParsing, res.getArraySize(), res.getUrl());
         CDistributorList distributors;
         if (res.isRestricted())
         {
             // create full list if it was just incremental
-            const CDistributorList incrementalDistributors(CDistributorList::fromDatabaseJson(res));
+            const CDistributorList incrementalDistributors(CDistributorList::fromDatabaseJson(res.getJsonStream()));
             if (incrementalDistributors.isEmpty()) { return; } // currently ignored
             distributors = this->getDistributors();
             distributors.replaceOrAddObjectsByKey(incrementalDistributors);
@@ -369,7 +369,7 @@ namespace BlackCore::Db
         {
             QElapsedTimer time;
             time.start();
-            distributors = CDistributorList::fromDatabaseJson(res);
+            distributors = CDistributorList::fromDatabaseJson(res.getJsonStream());
             this->logParseMessage("distributors", distributors.size(), static_cast<int>(time.elapsed()), res);
         }
 
@@ -404,7 +404,7 @@ namespace BlackCore::Db
         }
 
         // get all or incremental set of models
-        emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadParsing, 0, res.getUrl());
+        emit this->dataRead(CEntityFlags::ModelEntity, CEntityFlags::ReadParsing, res.getArraySize(), res.getUrl());
 
         // use prefilled data:
         // this saves a lot of parsing time as the models do not need to re-parse the sub parts
@@ -418,7 +418,7 @@ namespace BlackCore::Db
         if (res.isRestricted())
         {
             // create full list if it was just incremental
-            const CAircraftModelList incrementalModels(CAircraftModelList::fromDatabaseJsonCaching(res, icaos, categories, liveries, distributors));
+            const CAircraftModelList incrementalModels(CAircraftModelList::fromDatabaseJsonCaching(res.getJsonStream(), icaos, categories, liveries, distributors));
             if (incrementalModels.isEmpty()) { return; } // currently ignored
             models = this->getModels();
             models.replaceOrAddObjectsByKey(incrementalModels);
@@ -427,7 +427,7 @@ namespace BlackCore::Db
         {
             QElapsedTimer time;
             time.start();
-            models = CAircraftModelList::fromDatabaseJsonCaching(res, icaos, categories, liveries, distributors);
+            models = CAircraftModelList::fromDatabaseJsonCaching(res.getJsonStream(), icaos, categories, liveries, distributors);
             this->logParseMessage("models", models.size(), static_cast<int>(time.elapsed()), res);
         }
 
@@ -0,0 +1,112 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/fsd/fsdcapture.h"
+
+#include <QDateTime>
+#include <QList>
+
+namespace BlackCore::Fsd
+{
+    const QByteArray &FsdCaptureFormat::magic()
+    {
+        static const QByteArray m("SWIFTFSDCAPTURE");
+        return m;
+    }
+
+    bool CFsdCaptureWriter::open(const QString &fileName, const QByteArray &codecName)
+    {
+        this->close();
+        m_file.setFileName(fileName);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+
+        const QByteArray header = FsdCaptureFormat::magic() + ' ' + QByteArray::number(FsdCaptureFormat::Version) + ' ' +
+                                  QByteArray::number(QDateTime::currentMSecsSinceEpoch()) + ' ' + (codecName.isEmpty() ? QByteArray("UTF-8") : codecName) + '\n';
+        m_file.write(header);
+        m_sinceStart.start();
+        m_lines = 0;
+        return true;
+    }
+
+    void CFsdCaptureWriter::writeLine(const QByteArray &lineEncoded)
+    {
+        if (!m_file.isOpen()) { return; }
+
+        int size = lineEncoded.size();
+        while (size > 0 && (lineEncoded[size - 1] == '\n' || lineEncoded[size - 1] == '\r')) { --size; }
+        if (size < 1) { return; }
+
+        m_file.write(QByteArray::number(m_sinceStart.elapsed()));
+        m_file.write(" ", 1);
+        m_file.write(lineEncoded.constData(), size);
+        m_file.write("\n", 1);
+        m_lines++;
+    }
+
+    void CFsdCaptureWriter::close()
+    {
+        if (m_file.isOpen()) { m_file.close(); }
+    }
+
+    bool CFsdCaptureReader::open(const QString &fileName)
+    {
+        this->close();
+        m_file.setFileName(fileName);
+        if (!m_file.open(QIODevice::ReadOnly)) { return false; }
+
+        const QList<QByteArray> header = m_file.readLine().trimmed().split(' ');
+        if (header.size() < 4 || header.at(0) != FsdCaptureFormat::magic() || header.at(1).toInt() > FsdCaptureFormat::Version)
+        {
+            this->close();
+            return false;
+        }
+        m_startMsSinceEpoch = header.at(2).toLongLong();
+        m_codecName = header.at(3);
+        this->readAhead();
+        return true;
+    }
+
+    void CFsdCaptureReader::close()
+    {
+        if (m_file.isOpen()) { m_file.close(); }
+        m_hasNext = false;
+        m_nextOffsetMs = -1;
+        m_nextLine.clear();
+    }
+
+    QByteArray CFsdCaptureReader::takeNextLine()
+    {
+        if (!m_hasNext) { return {}; }
+        const QByteArray line = m_nextLine;
+        this->readAhead();
+        return line;
+    }
+
+    void CFsdCaptureReader::readAhead()
+    {
+        m_hasNext = false;
+        while (m_file.isOpen() && !m_file.atEnd())
+        {
+            const QByteArray l = m_file.readLine();
+            const int separator = l.indexOf(' ');
+            if (separator < 1) { continue; } // skip broken lines
+
+            bool ok = false;
+            const qint64 offsetMs = l.left(separator).toLongLong(&ok);
+            if (!ok) { continue; }
+
+            // line as received, with the CR/LF FSD terminator
+            int end = l.size();
+            while (end > separator + 1 && (l[end - 1] == '\n' || l[end - 1] == '\r')) { --end; }
+            m_nextLine = l.mid(separator + 1, end - separator - 1) + "\r\n";
+            m_nextOffsetMs = offsetMs;
+            m_hasNext = true;
+            return;
+        }
+    }
+} // ns
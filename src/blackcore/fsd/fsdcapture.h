@@ -0,0 +1,102 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_FSDCAPTURE_H
+#define BLACKCORE_FSD_FSDCAPTURE_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+
+namespace BlackCore::Fsd
+{
+    //! FSD capture file format
+    //! \remark First line is the header "SWIFTFSDCAPTURE <version> <start ms since epoch> <codec>",
+    //!         followed by one line per received FSD line: "<ms since start> <encoded line without CR/LF>".
+    //!         The lines are stored as received (encoded), so a replay runs through the same decoding as live traffic.
+    struct BLACKCORE_EXPORT FsdCaptureFormat
+    {
+        //! Header magic
+        static const QByteArray &magic();
+
+        //! Format version
+        static constexpr int Version = 1;
+    };
+
+    //! Writes received FSD lines with timestamps to a capture file
+    class BLACKCORE_EXPORT CFsdCaptureWriter
+    {
+    public:
+        //! Open file and write header, an existing file is overwritten
+        bool open(const QString &fileName, const QByteArray &codecName);
+
+        //! Write a received line
+        void writeLine(const QByteArray &lineEncoded);
+
+        //! Close file
+        void close();
+
+        //! Is capturing?
+        bool isOpen() const { return m_file.isOpen(); }
+
+        //! Lines written since open
+        int getLinesWritten() const { return m_lines; }
+
+        //! File name
+        QString getFileName() const { return m_file.fileName(); }
+
+    private:
+        QFile m_file;
+        QElapsedTimer m_sinceStart;
+        int m_lines = 0;
+    };
+
+    //! Reads a capture file written by CFsdCaptureWriter
+    class BLACKCORE_EXPORT CFsdCaptureReader
+    {
+    public:
+        //! Open file and read header
+        bool open(const QString &fileName);
+
+        //! Close file
+        void close();
+
+        //! Any more lines?
+        bool atEnd() const { return !m_hasNext; }
+
+        //! Offset of the next line in ms since start of the capture, -1 if at end
+        qint64 nextOffsetMs() const { return m_hasNext ? m_nextOffsetMs : -1; }
+
+        //! Take the next line and read ahead
+        QByteArray takeNextLine();
+
+        //! Codec of the captured session
+        const QByteArray &getCodecName() const { return m_codecName; }
+
+        //! Start of the captured session in ms since epoch
+        qint64 getCaptureStartMsSinceEpoch() const { return m_startMsSinceEpoch; }
+
+    private:
+        //! Read ahead one line
+        void readAhead();
+
+        QFile m_file;
+        QByteArray m_codecName;
+        qint64 m_startMsSinceEpoch = -1;
+        bool m_hasNext = false;
+        qint64 m_nextOffsetMs = -1;
+        QByteArray m_nextLine;
+    };
+} // ns
+
+#endif // guard
@@ -55,6 +55,7 @@
 #include <QStringBuilder>
 #include <QStringView>
 #include <QNetworkReply>
+#include <limits>
 
 using namespace BlackConfig;
 using namespace BlackCore::Vatsim;
@@ -126,6 +127,9 @@ namespace BlackCore::Fsd
         m_fsdSendMessageTimer.setObjectName(this->objectName().append(":m_fsdSendMessageTimer"));
         connect(&m_fsdSendMessageTimer, &QTimer::timeout, this, &CFSDClient::sendQueuedMessage);
 
+        m_replayTimer.setObjectName(this->objectName().append(":m_replayTimer"));
+        connect(&m_replayTimer, &QTimer::timeout, this, &CFSDClient::replayFsdCaptureLines);
+
         fsdMessageSettingsChanged();
 
         if (!m_statistics && (CBuildConfig::isLocalDeveloperDebugBuild() || (sApp && sApp->getOwnDistribution().isRestricted())))
@@ -162,7 +166,8 @@ namespace BlackCore::Fsd
         QWriteLocker l(&m_lockUserClientBuffered);
         m_server           = server;
         m_protocolRevision = protocolRev;
-        m_fsdTextCodec     = textCodec;
+        if (m_replaying) { m_replaySavedTextCodec = textCodec; } // used after the replay
+        else { m_fsdTextCodec = textCodec; }
     }
 
     void CFSDClient::setCallsign(const CCallsign &callsign)
@@ -255,6 +260,8 @@ namespace BlackCore::Fsd
         if (m_hostApplication.isEmpty()) { m_hostApplication = this->getSimulatorNameAndVersion().replace(':', ' '); }
 
         this->clearState();
+        m_readBuffer.clear(); // not in clearState, which can be called while the buffer is parsed
+        m_readBufferOffset = 0;
         m_filterPasswordFromLogin = true;
 
         m_loginSince = QDateTime::currentMSecsSinceEpoch();
@@ -283,6 +290,12 @@ namespace BlackCore::Fsd
             return;
         }
 
+        if (m_replaying)
+        {
+            this->stopFsdCaptureReplay();
+            return;
+        }
+
         this->stopPositionTimers();
         this->updateConnectionStatus(CConnectionStatus::Disconnecting);
 
@@ -821,7 +834,7 @@ namespace BlackCore::Fsd
         if (message.isEmpty()) { return; }
         const QByteArray bufferEncoded = m_fsdTextCodec->fromUnicode(message);
         if (m_printToConsole) { qDebug() << "FSD Sent=>" << bufferEncoded; }
-        if (!m_unitTestMode)  { m_socket->write(bufferEncoded); }
+        if (!m_unitTestMode && !m_replaying) { m_socket->write(bufferEncoded); }
 
         // remove CR/LF and emit
         emitRawFsdMessage(message.trimmed(), true);
@@ -859,7 +872,7 @@ namespace BlackCore::Fsd
     void CFSDClient::sendFsdMessage(const QString &message)
     {
         // UNIT tests
-        parseMessage(message);
+        parseMessage(m_fsdTextCodec ? m_fsdTextCodec->fromUnicode(message) : message.toUtf8());
     }
 
     QString CFSDClient::getConfiguredModelString(const CSimulatedAircraft &myAircraft) const
@@ -1226,44 +1239,37 @@ namespace BlackCore::Fsd
         }
     }
 
-    void CFSDClient::handlePilotDataUpdate(const QStringList &tokens)
+    void CFSDClient::handlePilotDataUpdate(const FsdLine &line)
     {
-        const PilotDataUpdate dataUpdate = PilotDataUpdate::fromTokens(tokens);
+        const PilotDataUpdate dataUpdate = PilotDataUpdate::fromTokens(line);
         const CCallsign callsign(dataUpdate.sender(), CCallsign::Aircraft);
 
-        CAircraftSituation situation(
-            callsign,
-            CCoordinateGeodetic(dataUpdate.m_latitude, dataUpdate.m_longitude, dataUpdate.m_altitudeTrue),
-            CHeading(dataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
-            CAngle(dataUpdate.m_pitch, CAngleUnit::deg()),
-            CAngle(dataUpdate.m_bank, CAngleUnit::deg()),
-            CSpeed(dataUpdate.m_groundSpeed, CSpeedUnit::kts()));
-        situation.setPressureAltitude(CAltitude(dataUpdate.m_altitudePressure, CAltitude::MeanSeaLevel, CAltitude::PressureAltitude, CLengthUnit::ft()));
-        situation.setOnGround(dataUpdate.m_onGround);
+        FsdPositionRecord record;
+        record.kind = FsdPositionRecord::PilotData;
+        record.latitudeDeg  = dataUpdate.m_latitude;
+        record.longitudeDeg = dataUpdate.m_longitude;
+        record.altitudeTrueFt     = dataUpdate.m_altitudeTrue;
+        record.altitudePressureFt = dataUpdate.m_altitudePressure;
+        record.headingDeg = dataUpdate.m_heading;
+        record.pitchDeg   = dataUpdate.m_pitch;
+        record.bankDeg    = dataUpdate.m_bank;
+        record.groundSpeedKts  = dataUpdate.m_groundSpeed;
+        record.onGround        = dataUpdate.m_onGround;
+        record.transponderCode = dataUpdate.m_transponderCode;
+        record.transponderMode = dataUpdate.m_transponderMode;
 
         // Ref T297, default offset time
-        situation.setCurrentUtcTime();
-        const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
-        situation.setTimeOffsetMs(offsetTimeMs);
+        record.msSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+        record.timeOffsetMs = receivedPositionFixTsAndGetOffsetTime(callsign, record.msSinceEpoch);
 
         // I did have a situation where I got wrong transponder codes (KB)
         // So I now check for a valid code in order to detect such codes
-        CTransponder transponder;
-        if (CTransponder::isValidTransponderCode(dataUpdate.m_transponderCode))
+        if (!CTransponder::isValidTransponderCode(dataUpdate.m_transponderCode) && CBuildConfig::isLocalDeveloperDebugBuild())
         {
-            transponder = CTransponder(dataUpdate.m_transponderCode, dataUpdate.m_transponderMode);
+            CLogMessage(this).debug(u"Wrong transponder code '%1' for '%2'") << dataUpdate.m_transponderCode << callsign;
         }
-        else
-        {
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                CLogMessage(this).debug(u"Wrong transponder code '%1' for '%2'") << dataUpdate.m_transponderCode << callsign;
-            }
 
-            // I set a default: IFR standby is a reasonable default
-            transponder = CTransponder(2000, CTransponder::StateStandby);
-        }
-        emit pilotDataUpdateReceived(situation, transponder);
+        this->deliverPosition(record, callsign);
     }
 
     void CFSDClient::handleEuroscopeSimData(const QStringList &tokens)
@@ -1293,24 +1299,26 @@ namespace BlackCore::Fsd
         emit euroscopeSimDataUpdatedReceived(situation, parts, currentOffsetTime(data.sender()), data.m_model, data.m_livery);
     }
 
-    void CFSDClient::handleVisualPilotDataUpdate(const QStringList &tokens, MessageType messageType)
+    void CFSDClient::handleVisualPilotDataUpdate(const FsdLine &line, MessageType messageType)
     {
         VisualPilotDataUpdate dataUpdate;
         switch (messageType)
         {
-            case MessageType::VisualPilotDataUpdate:    dataUpdate = VisualPilotDataUpdate::fromTokens(tokens);                 break;
-            case MessageType::VisualPilotDataPeriodic:  dataUpdate = VisualPilotDataPeriodic::fromTokens(tokens).toUpdate();    break;
-            case MessageType::VisualPilotDataStopped:   dataUpdate = VisualPilotDataStopped::fromTokens(tokens).toUpdate();     break;
+            case MessageType::VisualPilotDataUpdate:    dataUpdate = VisualPilotDataUpdate::fromTokens(line);                 break;
+            case MessageType::VisualPilotDataPeriodic:  dataUpdate = VisualPilotDataPeriodic::fromTokens(line).toUpdate();    break;
+            case MessageType::VisualPilotDataStopped:   dataUpdate = VisualPilotDataStopped::fromTokens(line).toUpdate();     break;
             default: qFatal("Precondition violated");   break;
         }
         const CCallsign callsign(dataUpdate.sender(), CCallsign::Aircraft);
 
-        CAircraftSituation situation(
-            callsign,
-            CCoordinateGeodetic(dataUpdate.m_latitude, dataUpdate.m_longitude, dataUpdate.m_altitudeTrue),
-            CHeading(dataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
-            CAngle(dataUpdate.m_pitch, CAngleUnit::deg()),
-            CAngle(dataUpdate.m_bank, CAngleUnit::deg()));
+        FsdPositionRecord record;
+        record.kind = FsdPositionRecord::VisualPilotData;
+        record.latitudeDeg    = dataUpdate.m_latitude;
+        record.longitudeDeg   = dataUpdate.m_longitude;
+        record.altitudeTrueFt = dataUpdate.m_altitudeTrue;
+        record.headingDeg = dataUpdate.m_heading;
+        record.pitchDeg   = dataUpdate.m_pitch;
+        record.bankDeg    = dataUpdate.m_bank;
 
         // not used
         //situation.setVelocity(CAircraftVelocity(
@@ -1318,11 +1326,60 @@ namespace BlackCore::Fsd
         //    dataUpdate.m_pitchRadPerSec, dataUpdate.m_bankRadPerSec, dataUpdate.m_headingRadPerSec, CAngleUnit::rad(), CTimeUnit::s()));
 
         // Ref T297, default offset time
-        situation.setCurrentUtcTime();
-        const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
-        situation.setTimeOffsetMs(offsetTimeMs);
+        record.msSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+        record.timeOffsetMs = receivedPositionFixTsAndGetOffsetTime(callsign, record.msSinceEpoch);
+
+        this->deliverPosition(record, callsign);
+    }
 
-        emit visualPilotDataUpdateReceived(situation);
+    void CFSDClient::deliverPosition(FsdPositionRecord &record, const CCallsign &callsign)
+    {
+        // waiting positions first, so the positions of a callsign are not overtaken
+        this->flushPositionBacklog();
+        if (!m_positionQueueEnabled || !record.setCallsign(callsign.asString()))
+        {
+            this->emitPosition(record, callsign);
+            return;
+        }
+        if (m_positionBacklog.isEmpty() && m_positionQueue.push(record)) { return; }
+
+        // consumer too slow, better late than never
+        if (m_positionQueueOverflows++ == 0)
+        {
+            CLogMessage(this).warning(u"FSD position queue full (%1 records), positions wait in the FSD thread") << static_cast<int>(m_positionQueue.capacity());
+        }
+        m_positionBacklog.enqueue(record);
+        if (m_positionBacklog.size() > static_cast<int>(PositionQueueCapacity)) { m_positionBacklog.dequeue(); } // outdated anyway
+    }
+
+    void CFSDClient::flushPositionBacklog()
+    {
+        const bool queue = m_positionQueueEnabled;
+        while (!m_positionBacklog.isEmpty())
+        {
+            const FsdPositionRecord &record = m_positionBacklog.head();
+            if (queue)
+            {
+                if (!m_positionQueue.push(record)) { return; }
+            }
+            else
+            {
+                this->emitPosition(record, CCallsign(record.getCallsignAsString(), CCallsign::Aircraft));
+            }
+            m_positionBacklog.dequeue();
+        }
+    }
+
+    void CFSDClient::emitPosition(const FsdPositionRecord &record, const CCallsign &callsign)
+    {
+        if (record.kind == FsdPositionRecord::VisualPilotData)
+        {
+            emit visualPilotDataUpdateReceived(record.toSituation(callsign));
+        }
+        else
+        {
+            emit pilotDataUpdateReceived(record.toSituation(callsign), record.toTransponder());
+        }
     }
 
     void CFSDClient::handleVisualPilotDataToggle(const QStringList& tokens)
@@ -1984,6 +2041,7 @@ namespace BlackCore::Fsd
         m_lastOffsetTimes.clear();
         m_atcStations.clear();
         m_queuedFsdMessages.clear();
+        m_positionBacklog.clear();
         m_sentAircraftConfig = CAircraftParts::null();
         m_loginSince = -1;
     }
@@ -2155,6 +2213,7 @@ namespace BlackCore::Fsd
         QWriteLocker l(&m_lockStatistics);
         m_callStatistics.clear();
         m_callByTime.clear();
+        m_readSliceStatistics = {};
     }
 
     QString CFSDClient::getNetworkStatisticsAsText(bool reset, const QString &separator)
@@ -2162,14 +2221,16 @@ namespace BlackCore::Fsd
         QVector<std::pair<int, QString>> transformed;
         QMap <QString, int> callStatistics;
         QVector <QPair<qint64, QString>> callByTime;
+        ReadSliceStatistics readSlices;
 
         {
             QReadLocker l(&m_lockStatistics);
             callStatistics = m_callStatistics;
             callByTime     = m_callByTime;
+            readSlices     = m_readSliceStatistics;
         }
 
-        if (callStatistics.isEmpty()) { return QString(); }
+        if (callStatistics.isEmpty() && readSlices.slices < 1) { return QString(); }
         for (const auto [key, value] : makePairsRange(std::as_const(callStatistics)))
         {
             // key is pair.first, value is pair.second
@@ -2203,6 +2264,23 @@ namespace BlackCore::Fsd
             }
         }
 
+        if (readSlices.slices > 0)
+        {
+            stats +=
+                (stats.isEmpty() ? QString() : separator) %
+                u"socket read slices: " % QString::number(readSlices.slices) %
+                u" lines: " % QString::number(readSlices.lines) %
+                u" bytes: " % QString::number(readSlices.bytes) %
+                u" avg.us: " % QString::number(readSlices.timeNs / readSlices.slices / 1000.0, 'f', 1) %
+                u" max.us: " % QString::number(readSlices.maxTimeNs / 1000.0, 'f', 1) %
+                u" max.lines: " % QString::number(readSlices.maxLines) %
+                u" budget exceeded: " % QString::number(readSlices.budgetExceeded) %
+                separator %
+                u"last read slice lines: " % QString::number(readSlices.lastLines) %
+                u" bytes: " % QString::number(readSlices.lastBytes) %
+                u" us: " % QString::number(readSlices.lastTimeNs / 1000.0, 'f', 1);
+        }
+
         if (reset) { this->clearStatistics(); }
         return stats;
     }
@@ -2213,39 +2291,254 @@ namespace BlackCore::Fsd
         quitAndWait();
     }
 
-    void CFSDClient::readDataFromSocketMaxLines(int maxLines)
+    void CFSDClient::startFsdCapture(const QString &fileName)
     {
-        if (m_socket->bytesAvailable() < 1) { return; }
+        if (!CThreadUtils::isInThisThread(this))
+        {
+            QMetaObject::invokeMethod(this, [ = ]
+            {
+                if (sApp && !sApp->isShuttingDown()) { startFsdCapture(fileName); }
+            });
+            return;
+        }
 
-        int lines = 0;
+        QByteArray codecName;
+        {
+            QReadLocker l(&m_lockUserClientBuffered);
+            if (m_fsdTextCodec) { codecName = m_fsdTextCodec->name(); }
+        }
 
-        // reads at least one line if available
-        while (m_socket->canReadLine())
+        m_capturing = false;
+        if (!m_captureWriter.open(fileName, codecName))
         {
-            const QByteArray dataEncoded = m_socket->readLine();
-            if (dataEncoded.isEmpty()) { continue; }
-            const QString data = m_fsdTextCodec->toUnicode(dataEncoded);
-            this->parseMessage(data);
-            lines++;
+            CLogMessage(this).warning(u"Cannot open FSD capture file '%1'") << fileName;
+            return;
+        }
+        m_capturing = true;
+        CLogMessage(this).info(u"Capturing received FSD lines to '%1'") << fileName;
+    }
+
+    void CFSDClient::stopFsdCapture()
+    {
+        if (!CThreadUtils::isInThisThread(this))
+        {
+            QMetaObject::invokeMethod(this, [ = ]
+            {
+                if (sApp && !sApp->isShuttingDown()) { stopFsdCapture(); }
+            });
+            return;
+        }
 
-            static constexpr int MaxLines = 75 - 1;
-            if (maxLines < 0) { maxLines = MaxLines; }
+        if (!m_capturing) { return; }
+        m_capturing = false;
+        CLogMessage(this).info(u"Captured %1 FSD lines to '%2'") << m_captureWriter.getLinesWritten() << m_captureWriter.getFileName();
+        m_captureWriter.close();
+    }
 
-            if (lines > maxLines)
+    void CFSDClient::replayFsdCapture(const QString &fileName, double speedFactor)
+    {
+        if (!CThreadUtils::isInThisThread(this))
+        {
+            QMetaObject::invokeMethod(this, [ = ]
             {
-                static constexpr int DelayMs  = 10;
-                const int newMax = qRound(1.2 * lines); // 20% more
+                if (sApp && !sApp->isShuttingDown()) { replayFsdCapture(fileName, speedFactor); }
+            });
+            return;
+        }
 
-                CLogMessage(this).debug(u"ReadDataFromSocket has too many lines (>%1), will read again in %2ms") << MaxLines << DelayMs;
-                QPointer<CFSDClient> myself(this);
-                QTimer::singleShot(DelayMs, this, [ = ]
-                {
-                    if (!sApp || sApp->isShuttingDown()) { return; }
-                    if (myself) { myself->readDataFromSocketMaxLines(newMax); }
-                });
+        if (m_replaying || !this->isDisconnected())
+        {
+            CLogMessage(this).validationError(u"Cannot replay FSD capture while connected or replaying");
+            return;
+        }
+
+        if (!m_replayReader.open(fileName))
+        {
+            CLogMessage(this).validationError(u"Cannot open FSD capture '%1'") << fileName;
+            return;
+        }
+
+        // decode as the captured session
+        QTextCodec *textCodec = QTextCodec::codecForName(m_replayReader.getCodecName());
+        if (!textCodec) { textCodec = QTextCodec::codecForName("utf-8"); }
+        {
+            QWriteLocker l(&m_lockUserClientBuffered);
+            m_replaySavedTextCodec = m_fsdTextCodec;
+            m_fsdTextCodec = textCodec;
+        }
+
+        m_replaying = true;
+        m_replaySpeedFactor = speedFactor;
+        m_replayedLines  = 0;
+        m_replayMaxLagMs = 0;
+        this->clearState();
+        this->updateConnectionStatus(CConnectionStatus::Connecting);
+        this->updateConnectionStatus(CConnectionStatus::Connected);
+
+        CLogMessage(this).info(u"Replaying FSD capture '%1' with speed %2") << fileName << (speedFactor > 0 ? QString::number(speedFactor) : QStringLiteral("max"));
+        m_replayElapsed.start();
+        m_replayTimer.start(speedFactor > 0 ? 5 : 0);
+    }
+
+    void CFSDClient::stopFsdCaptureReplay()
+    {
+        if (!CThreadUtils::isInThisThread(this))
+        {
+            QMetaObject::invokeMethod(this, [ = ]
+            {
+                if (sApp && !sApp->isShuttingDown()) { stopFsdCaptureReplay(); }
+            });
+            return;
+        }
+        if (!m_replaying) { return; }
+        this->finishFsdCaptureReplay();
+    }
+
+    void CFSDClient::replayFsdCaptureLines()
+    {
+        if (!m_replaying) { m_replayTimer.stop(); return; }
+
+        const bool maxSpeed = m_replaySpeedFactor <= 0;
+        const qint64 scheduledUntilMs = maxSpeed ? std::numeric_limits<qint64>::max() : qRound64(m_replayElapsed.elapsed() * m_replaySpeedFactor);
+        for (int lines = 0; lines < MaxReplayLinesPerSlice; ++lines)
+        {
+            if (m_replayReader.atEnd())
+            {
+                this->finishFsdCaptureReplay();
+                return;
+            }
+
+            const qint64 offsetMs = m_replayReader.nextOffsetMs();
+            if (offsetMs > scheduledUntilMs) { break; }
+            if (!maxSpeed)
+            {
+                const qint64 lagMs = qRound64((scheduledUntilMs - offsetMs) / m_replaySpeedFactor);
+                if (lagMs > m_replayMaxLagMs) { m_replayMaxLagMs = lagMs; }
+            }
+
+            this->parseMessage(m_replayReader.takeNextLine());
+            m_replayedLines++;
+        }
+    }
+
+    void CFSDClient::finishFsdCaptureReplay()
+    {
+        m_replayTimer.stop();
+        m_replayReader.close();
+
+        const qint64 elapsedMs = m_replayElapsed.elapsed();
+        const int lines = m_replayedLines;
+        CLogMessage(this).info(u"Replayed %1 FSD lines in %2ms (%3 lines/s), max. lag %4ms") << lines << elapsedMs << (lines * 1000 / qMax<qint64>(1, elapsedMs)) << m_replayMaxLagMs;
+
+        {
+            QWriteLocker l(&m_lockUserClientBuffered);
+            m_fsdTextCodec = m_replaySavedTextCodec;
+            m_replaySavedTextCodec = nullptr;
+        }
+
+        m_replaying = false;
+        this->updateConnectionStatus(CConnectionStatus::Disconnecting);
+        this->updateConnectionStatus(CConnectionStatus::Disconnected);
+        emit this->fsdCaptureReplayFinished(lines, elapsedMs, m_replayMaxLagMs);
+    }
+
+    void CFSDClient::readDataFromSocket()
+    {
+        m_readContinuationPending = false;
+
+        // drain everything the socket has buffered in one chunk
+        const qint64 available = m_socket->bytesAvailable();
+        if (available > 0) { this->appendToReadBuffer(m_socket->readAll()); }
+        this->parseReadBuffer(qMax<qint64>(0, available));
+    }
+
+    void CFSDClient::receiveFsdData(const QByteArray &data)
+    {
+        // UNIT tests
+        this->appendToReadBuffer(data);
+        this->parseReadBuffer(data.size());
+    }
+
+    void CFSDClient::appendToReadBuffer(const QByteArray &data)
+    {
+        if (data.isEmpty()) { return; }
+        if (m_readBufferOffset > 0)
+        {
+            m_readBuffer.remove(0, m_readBufferOffset);
+            m_readBufferOffset = 0;
+        }
+        m_readBuffer.append(data);
+    }
+
+    void CFSDClient::parseReadBuffer(qint64 available)
+    {
+        if (m_readBufferOffset >= m_readBuffer.size()) { return; }
+
+        QElapsedTimer sliceTime;
+        sliceTime.start();
+        static constexpr qint64 BudgetNs = c_readSliceBudgetUsec * 1000LL;
+
+        int lines = 0;
+        bool budgetExceeded = false;
+        const int startOffset = m_readBufferOffset;
+        while (m_readBufferOffset < m_readBuffer.size())
+        {
+            const int eol = m_readBuffer.indexOf('\n', m_readBufferOffset);
+            if (eol < 0) { break; } // incomplete line, wait for more data
+
+            const int start = m_readBufferOffset;
+            m_readBufferOffset = eol + 1;
+            if (eol == start) { continue; }
+
+            // a copy, handlers can receive more data and so change the buffer
+            const QByteArray dataEncoded(m_readBuffer.constData() + start, eol + 1 - start);
+            if (m_capturing) { m_captureWriter.writeLine(dataEncoded); }
+            this->parseMessage(dataEncoded);
+            lines++;
+
+            // parsed at least one line, yield to the event loop if the budget is used up
+            if (sliceTime.nsecsElapsed() > BudgetNs)
+            {
+                budgetExceeded = m_readBuffer.indexOf('\n', m_readBufferOffset) >= 0;
                 break;
             }
+        }
+
+        this->flushPositionBacklog(); // the consumer might have caught up
+        const qint64 sliceNs = sliceTime.nsecsElapsed();
+        if (m_readBufferOffset >= m_readBuffer.size())
+        {
+            m_readBuffer.clear();
+            m_readBufferOffset = 0;
+        }
 
+        if (m_statistics)
+        {
+            QWriteLocker l(&m_lockStatistics);
+            ReadSliceStatistics &rs = m_readSliceStatistics;
+            rs.slices++;
+            rs.lines += lines;
+            rs.bytes += available;
+            rs.timeNs += sliceNs;
+            rs.maxTimeNs = qMax(rs.maxTimeNs, sliceNs);
+            rs.maxLines  = qMax(rs.maxLines, lines);
+            if (budgetExceeded) { rs.budgetExceeded++; }
+            rs.lastLines  = lines;
+            rs.lastBytes  = available;
+            rs.lastTimeNs = sliceNs;
+        }
+
+        if (budgetExceeded && !m_readContinuationPending)
+        {
+            // continue with the remaining lines as soon as pending events are processed, no fixed delay
+            m_readContinuationPending = true;
+            CLogMessage(this).debug(u"ReadDataFromSocket used its %1us budget for %2 lines (%3 bytes parsed), continuing") << c_readSliceBudgetUsec << lines << (m_readBufferOffset - startOffset);
+            QPointer<CFSDClient> myself(this);
+            QTimer::singleShot(0, this, [ = ]
+            {
+                if (!sApp || sApp->isShuttingDown()) { return; }
+                if (myself) { myself->readDataFromSocket(); }
+            });
         }
     }
 
@@ -2265,23 +2558,18 @@ namespace BlackCore::Fsd
         return metaEnum.valueToKey(error);
     }
 
-    void CFSDClient::parseMessage(const QString &lineRaw)
+    void CFSDClient::parseMessage(const QByteArray &lineEncoded)
     {
-        MessageType messageType = MessageType::Unknown;
-        QString cmd;
-        const QString line = lineRaw.trimmed();
-
-        if (m_printToConsole) { qDebug() << "FSD Recv=>" << line; }
-        emitRawFsdMessage(line, false);
+        // the line is only decoded as a whole if really needed,
+        // hot messages like position updates are parsed directly from the encoded tokens
+        const FsdLine line(lineEncoded);
+        const MessageType messageType = line.messageType();
 
-        for (const QString &str : makeKeysRange(std::as_const(m_messageTypeMapping)))
+        if (m_printToConsole || m_rawFsdMessagesEnabled || m_unitTestMode)
         {
-            if (line.startsWith(str))
-            {
-                cmd = str;
-                messageType = m_messageTypeMapping.value(str, MessageType::Unknown);
-                break;
-            }
+            const QString lineDecoded = line.toQString(m_fsdTextCodec);
+            if (m_printToConsole) { qDebug() << "FSD Recv=>" << lineDecoded; }
+            emitRawFsdMessage(lineDecoded, false);
         }
 
         // statistics
@@ -2290,63 +2578,65 @@ namespace BlackCore::Fsd
             increaseStatisticsValue(QStringLiteral("parseMessage"), this->messageTypeToString(messageType));
         }
 
-        if (messageType != MessageType::Unknown)
+        if (messageType == MessageType::Unknown)
         {
-            // Cutoff the cmd from the beginning
-            const QString payload = line.mid(cmd.size()).trimmed();
+            handleUnknownPacket(line.toQString(m_fsdTextCodec));
+            return;
+        }
 
-            // We expected a payload, but there is nothing
-            if (payload.length() == 0) { return; }
+        // We expected a payload, but there is nothing
+        if (!line.hasPayload()) { return; }
 
-            const QStringList tokens = payload.split(':');
-            switch (messageType)
-            {
-            // ignored ones
-            case MessageType::AddAtc:
-            case MessageType::AddPilot:
-            case MessageType::ServerHeartbeat:
-            case MessageType::ProController:
-            case MessageType::ClientIdentification:
-            case MessageType::RegistrationInfo:
-            case MessageType::RevBPilotDescription:
+        switch (messageType)
+        {
+        // ignored ones
+        case MessageType::AddAtc:
+        case MessageType::AddPilot:
+        case MessageType::ServerHeartbeat:
+        case MessageType::ProController:
+        case MessageType::ClientIdentification:
+        case MessageType::RegistrationInfo:
+        case MessageType::RevBPilotDescription:
+            return;
 
-                break;
+        // hot path, parsed from the encoded tokens
+        case MessageType::PilotDataUpdate:   handlePilotDataUpdate(line); return;
+        case MessageType::VisualPilotDataUpdate:
+        case MessageType::VisualPilotDataPeriodic:
+        case MessageType::VisualPilotDataStopped:  handleVisualPilotDataUpdate(line, messageType); return;
 
-            // handled ones
-            case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
-            case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
-            case MessageType::AuthResponse:      handleAuthResponse(tokens);      break;
-            case MessageType::ClientQuery:       handleClientQuery(tokens);       break;
-            case MessageType::ClientResponse:    handleClientReponse(tokens);     break;
-            case MessageType::DeleteATC:         handleDeleteATC(tokens);         break;
-            case MessageType::DeletePilot:       handleDeletePilot(tokens);       break;
-            case MessageType::FlightPlan:        handleFlightPlan(tokens);        break;
-            case MessageType::FsdIdentification: handleFsdIdentification(tokens); break;
-            case MessageType::KillRequest:       handleKillRequest(tokens);       break;
-            case MessageType::PilotDataUpdate:   handlePilotDataUpdate(tokens);   break;
-            case MessageType::Ping:              handlePing(tokens);              break;
-            case MessageType::Pong:              handlePong(tokens);              break;
-            case MessageType::ServerError:       handleServerError(tokens);       break;
-            case MessageType::TextMessage:       handleTextMessage(tokens);       break;
-            case MessageType::PilotClientCom:    handleCustomPilotPacket(tokens); break;
-            case MessageType::RevBClientParts:   handleRevBClientPartsPacket(tokens); break;
-            case MessageType::VisualPilotDataUpdate:
-            case MessageType::VisualPilotDataPeriodic:
-            case MessageType::VisualPilotDataStopped:  handleVisualPilotDataUpdate(tokens, messageType); break;
-            case MessageType::VisualPilotDataToggle:   handleVisualPilotDataToggle(tokens); break;
-            case MessageType::EuroscopeSimData:  handleEuroscopeSimData(tokens);  break;
-            case MessageType::Rehost:            handleRehost(tokens);            break;
-
-            // normally we should not get here
-            default:
-            case MessageType::Unknown:
-                handleUnknownPacket(tokens);
-                break;
-            }
+        default: break;
         }
-        else
+
+        // all others are decoded
+        const QStringList tokens = line.toTokens(m_fsdTextCodec);
+        switch (messageType)
         {
-            handleUnknownPacket(line);
+        case MessageType::AtcDataUpdate:     handleAtcDataUpdate(tokens);     break;
+        case MessageType::AuthChallenge:     handleAuthChallenge(tokens);     break;
+        case MessageType::AuthResponse:      handleAuthResponse(tokens);      break;
+        case MessageType::ClientQuery:       handleClientQuery(tokens);       break;
+        case MessageType::ClientResponse:    handleClientReponse(tokens);     break;
+        case MessageType::DeleteATC:         handleDeleteATC(tokens);         break;
+        case MessageType::DeletePilot:       handleDeletePilot(tokens);       break;
+        case MessageType::FlightPlan:        handleFlightPlan(tokens);        break;
+        case MessageType::FsdIdentification: handleFsdIdentification(tokens); break;
+        case MessageType::KillRequest:       handleKillRequest(tokens);       break;
+        case MessageType::Ping:              handlePing(tokens);              break;
+        case MessageType::Pong:              handlePong(tokens);              break;
+        case MessageType::ServerError:       handleServerError(tokens);       break;
+        case MessageType::TextMessage:       handleTextMessage(tokens);       break;
+        case MessageType::PilotClientCom:    handleCustomPilotPacket(tokens); break;
+        case MessageType::RevBClientParts:   handleRevBClientPartsPacket(tokens); break;
+        case MessageType::VisualPilotDataToggle:   handleVisualPilotDataToggle(tokens); break;
+        case MessageType::EuroscopeSimData:  handleEuroscopeSimData(tokens);  break;
+        case MessageType::Rehost:            handleRehost(tokens);            break;
+
+        // normally we should not get here
+        default:
+        case MessageType::Unknown:
+            handleUnknownPacket(tokens);
+            break;
         }
     }
 
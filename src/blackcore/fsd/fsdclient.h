@@ -15,6 +15,9 @@
 #include "blackcore/vatsim/vatsimsettings.h"
 #include "blackcore/fsd/enums.h"
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/fsdline.h"
+#include "blackcore/fsd/fsdcapture.h"
+#include "blackcore/fsd/fsdpositionrecord.h"
 
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
@@ -33,6 +36,7 @@
 #include "blackmisc/network/textmessagelist.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/digestsignal.h"
+#include "blackmisc/lockfree.h"
 #include "blackmisc/tokenbucket.h"
 
 #include "vatsim/vatsimauth.h"
@@ -207,6 +211,41 @@ namespace BlackCore::Fsd
         //! Gracefully shut down FSD client
         void gracefulShutdown();
 
+        //! Capture all received FSD lines with timestamps to a file, see FsdCaptureFormat
+        //! \threadsafe
+        //! @{
+        void startFsdCapture(const QString &fileName);
+        void stopFsdCapture();
+        bool isCapturingFsd() const { return m_capturing; }
+        //! @}
+
+        //! Replay a capture file as if it was received from a server, no socket is used
+        //! \param speedFactor 1.0 real time, 10.0 ten times faster, 0 or negative as fast as possible
+        //! \remark the client appears connected while replaying, so consumers like the airspace monitor process the data
+        //! \threadsafe
+        //! @{
+        void replayFsdCapture(const QString &fileName, double speedFactor = 1.0);
+        void stopFsdCaptureReplay();
+        bool isReplayingFsdCapture() const { return m_replaying; }
+        //! @}
+
+        //! Pass received positions (pilot and visual updates) as FsdPositionRecord through a lock-free queue
+        //! instead of pilotDataUpdateReceived/visualPilotDataUpdateReceived signals
+        //! \remark the queue has to be drained by exactly one consumer with takeQueuedPositions
+        //! \remark if the queue is full, positions wait in the FSD thread, so positions of a callsign keep their order
+        //! \remark positions waiting when the queue is disabled are emitted as signals before newer positions
+        //! @{
+        void setPositionQueueEnabled(bool enabled) { m_positionQueueEnabled = enabled; }
+        bool isPositionQueueEnabled() const { return m_positionQueueEnabled; }
+        //! @}
+
+        //! Take up to max queued positions, oldest first
+        //! \threadsafe for one consumer thread
+        int takeQueuedPositions(FsdPositionRecord *records, int max) { return static_cast<int>(m_positionQueue.popBatch(records, static_cast<size_t>(qMax(0, max)))); }
+
+        //! Positions which had to wait because the queue was full
+        int getPositionQueueOverflows() const { return m_positionQueueOverflows; }
+
     signals:
         //! Client responses received
         //! @{
@@ -253,6 +292,12 @@ namespace BlackCore::Fsd
         //! Kill request (aka kicked)
         void killRequestReceived(const QString &reason);
 
+        //! Replay of a capture file has finished
+        //! \param lines replayed lines
+        //! \param elapsedMs wall time of the replay
+        //! \param maxLagMs max. delay of a line compared to its scheduled (speed adjusted) time, 0 for max.speed
+        void fsdCaptureReplayFinished(int lines, qint64 elapsedMs, qint64 maxLagMs);
+
     private:
         //! \cond
         friend BlackFsdTest::CTestFSDClient;
@@ -292,7 +337,7 @@ namespace BlackCore::Fsd
         void sendQueudedMessage(const T &message)
         {
             if (!message.isValid()) { return; }
-            if (m_unitTestMode)
+            if (m_unitTestMode || m_replaying)
             {
                 this->sendDirectMessage(message);
                 return;
@@ -311,6 +356,7 @@ namespace BlackCore::Fsd
         //! Unit test/debug functions
         //! @{
         void sendFsdMessage(const QString &message);
+        void receiveFsdData(const QByteArray &data);
         void setUnitTestMode(bool on) { m_unitTestMode = on; }
         //! @}
 
@@ -347,9 +393,12 @@ namespace BlackCore::Fsd
         void sendClientIdentification(const QString &fsdChallenge);
         void sendIncrementalAircraftConfig();
 
-        void readDataFromSocket() { this->readDataFromSocketMaxLines(); }
-        void readDataFromSocketMaxLines(int maxLines = -1);
-        void parseMessage(const QString &lineRaw);
+        void readDataFromSocket();
+        void appendToReadBuffer(const QByteArray &data);
+        void parseReadBuffer(qint64 available);
+        void replayFsdCaptureLines();
+        void finishFsdCaptureReplay();
+        void parseMessage(const QByteArray &lineEncoded);
 
         QString socketErrorString(QAbstractSocket::SocketError error) const;
         static QString socketErrorToQString(QAbstractSocket::SocketError error);
@@ -368,8 +417,8 @@ namespace BlackCore::Fsd
         void handleDeleteATC(const QStringList &tokens);
         void handleDeletePilot(const QStringList &tokens);
         void handleTextMessage(const QStringList &tokens);
-        void handlePilotDataUpdate(const QStringList &tokens);
-        void handleVisualPilotDataUpdate(const QStringList &tokens, MessageType messageType);
+        void handlePilotDataUpdate(const FsdLine &line);
+        void handleVisualPilotDataUpdate(const FsdLine &line, MessageType messageType);
         void handleVisualPilotDataToggle(const QStringList &tokens);
         void handleEuroscopeSimData(const QStringList &tokens);
         void handlePing(const QStringList &tokens);
@@ -475,7 +524,7 @@ namespace BlackCore::Fsd
         static constexpr qint64 PendingConnectionTimeoutMs = 7500;
 
         // Parser
-        QHash<QString, MessageType> m_messageTypeMapping;
+        QHash<QString, MessageType> m_messageTypeMapping; //!< PDUs, used for statistics, parsing is done by FsdLine
 
         std::shared_ptr<QTcpSocket> m_socket = std::make_shared<QTcpSocket>(this); //!< used TCP socket, parent needed as it runs in worker thread
         void connectSocketSignals();
@@ -526,6 +575,19 @@ namespace BlackCore::Fsd
         std::atomic_bool m_rawFsdMessagesEnabled   { false };
         std::atomic_bool m_filterPasswordFromLogin { false };
 
+        // capture and replay
+        CFsdCaptureWriter m_captureWriter;            //!< records received lines
+        CFsdCaptureReader m_replayReader;             //!< replayed capture
+        QTimer            m_replayTimer  { this };    //!< replay slices
+        QElapsedTimer     m_replayElapsed;            //!< wall time since replay start
+        double            m_replaySpeedFactor = 1.0;  //!< replay speed, <= 0 max. speed
+        int               m_replayedLines = 0;        //!< lines replayed so far
+        qint64            m_replayMaxLagMs = 0;       //!< max. delay of a line compared to its scheduled time
+        QTextCodec       *m_replaySavedTextCodec = nullptr; //!< codec of the connection setup, restored after the replay
+        std::atomic_bool  m_capturing { false };
+        std::atomic_bool  m_replaying { false };
+        static constexpr int MaxReplayLinesPerSlice = 500; //!< lines per replay slice, allows queued signals to be processed
+
         // timer parents are needed as we move to thread
         QTimer m_scheduledConfigUpdate      { this }; //!< config updates
         QTimer m_positionUpdateTimer        { this }; //!< sending positions
@@ -540,6 +602,43 @@ namespace BlackCore::Fsd
         QVector <QPair<qint64, QString>> m_callByTime; //!< "last call vs. ms"
         mutable QReadWriteLock m_lockStatistics { QReadWriteLock::Recursive }; //!< for user, client and buffered data
 
+        //! Statistics of the socket read slices
+        struct ReadSliceStatistics
+        {
+            qint64 slices = 0;           //!< number of slices
+            qint64 lines = 0;            //!< lines parsed
+            qint64 bytes = 0;            //!< bytes read from socket
+            qint64 timeNs = 0;           //!< time spent in slices
+            qint64 maxTimeNs = 0;        //!< longest slice
+            int    maxLines = 0;         //!< most lines in one slice
+            qint64 budgetExceeded = 0;   //!< slices stopped by the time budget
+            int    lastLines = 0;        //!< lines of last slice
+            qint64 lastBytes = 0;        //!< bytes of last slice
+            qint64 lastTimeNs = 0;       //!< time of last slice
+        };
+        ReadSliceStatistics m_readSliceStatistics; //!< guarded by m_lockStatistics
+
+        // position queue, FSD thread is the producer
+        static constexpr size_t PositionQueueCapacity = 8192;  //!< several seconds of traffic from a busy server
+        BlackMisc::LockFreeSpscQueue<FsdPositionRecord> m_positionQueue { PositionQueueCapacity };
+        std::atomic_bool m_positionQueueEnabled { false };
+        std::atomic_int  m_positionQueueOverflows { 0 };
+        QQueue<FsdPositionRecord> m_positionBacklog; //!< positions waiting for space in the queue, FSD thread only
+
+        //! Queue or emit the position, waiting positions first
+        void deliverPosition(FsdPositionRecord &record, const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Queue the waiting positions, or emit them if the queue is disabled
+        void flushPositionBacklog();
+
+        //! Emit the position as signal
+        void emitPosition(const FsdPositionRecord &record, const BlackMisc::Aviation::CCallsign &callsign);
+
+        // socket reading
+        QByteArray m_readBuffer;                //!< data read from socket, not yet parsed
+        int        m_readBufferOffset = 0;      //!< start of the first unparsed line in m_readBuffer
+        bool       m_readContinuationPending = false; //!< a continuation slice is scheduled
+
         // User data
         BlackMisc::Network::CServer    m_server;
         BlackMisc::Network::CLoginMode m_loginMode;
@@ -582,6 +681,7 @@ namespace BlackCore::Fsd
         static int constexpr c_updateInterimPostionIntervalMsec = 1000; //!< interval for iterim position updates (send our position as interim position)
         static int constexpr c_updateVisualPositionIntervalMsec = 200;  //!< interval for the VATSIM visual position updates (send our position and 6DOF velocity)
         static int constexpr c_sendFsdMsgIntervalMsec           = 10;   //!< interval for FSD send messages
+        static int constexpr c_readSliceBudgetUsec              = 4000; //!< max. time parsing received lines before yielding to the event loop
         bool m_stoppedSendingVisualPositions = false; //!< for when velocity drops to zero
         bool m_serverWantsVisualPositions = false;    //!< there are interested clients in range
         unsigned m_visualPositionUpdateSentCount = 0; //!< for choosing when to send a periodic (slowfast) packet
@@ -0,0 +1,272 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/fsd/fsdline.h"
+
+#include <QTextCodec>
+#include <limits>
+
+namespace BlackCore::Fsd
+{
+    namespace
+    {
+        //! Same characters as removed by QByteArray::trimmed
+        bool isSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+    }
+
+    FsdLine::FsdLine(const QByteArray &lineEncoded)
+    {
+        const char *data = lineEncoded.constData();
+        int begin = 0;
+        int end = lineEncoded.size();
+        while (begin < end && isSpace(data[begin])) { ++begin; }
+        while (end > begin && isSpace(data[end - 1])) { --end; }
+
+        m_line = data + begin;
+        m_lineSize = end - begin;
+
+        int pduLength = 0;
+        m_messageType = detectMessageType(m_line, m_lineSize, pduLength);
+        if (m_messageType == MessageType::Unknown) { return; }
+
+        // payload is trimmed as well
+        int payloadStart = pduLength;
+        while (payloadStart < m_lineSize && isSpace(m_line[payloadStart])) { ++payloadStart; }
+        m_payloadStart = payloadStart;
+        m_payloadSize  = m_lineSize - payloadStart;
+
+        m_tokenStarts.append(payloadStart);
+        for (int i = payloadStart; i < m_lineSize; ++i)
+        {
+            if (m_line[i] == ':') { m_tokenStarts.append(i + 1); }
+        }
+        m_tokenStarts.append(m_lineSize + 1); // end marker, as if there was a trailing ':'
+    }
+
+    QLatin1String FsdLine::token(int index) const
+    {
+        if (index < 0 || index >= this->tokenCount()) { return {}; }
+        const int start = m_tokenStarts[index];
+        const int size  = m_tokenStarts[index + 1] - start - 1;
+        return QLatin1String(m_line + start, size);
+    }
+
+    QString FsdLine::tokenToQString(int index) const
+    {
+        const QLatin1String t = this->token(index);
+        return QString(t);
+    }
+
+    QString FsdLine::tokenToQString(int index, QTextCodec *codec) const
+    {
+        if (!codec) { return this->tokenToQString(index); }
+        const QLatin1String t = this->token(index);
+        return codec->toUnicode(t.data(), t.size());
+    }
+
+    double FsdLine::tokenToDouble(int index) const
+    {
+        const QLatin1String t = this->token(index);
+        return parseDouble(t.data(), t.size());
+    }
+
+    int FsdLine::tokenToInt(int index) const
+    {
+        const QLatin1String t = this->token(index);
+        bool ok = false;
+        const qint64 v = parseInteger(t.data(), t.size(), &ok);
+        if (!ok || v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max()) { return 0; }
+        return static_cast<int>(v);
+    }
+
+    quint32 FsdLine::tokenToUInt(int index) const
+    {
+        const QLatin1String t = this->token(index);
+        bool ok = false;
+        const qint64 v = parseInteger(t.data(), t.size(), &ok);
+        if (!ok || v < 0 || v > std::numeric_limits<quint32>::max()) { return 0; }
+        return static_cast<quint32>(v);
+    }
+
+    QStringList FsdLine::toTokens(QTextCodec *codec) const
+    {
+        QStringList tokens;
+        if (!this->isKnownMessageType()) { return tokens; }
+        tokens.reserve(this->tokenCount());
+        for (int i = 0; i < this->tokenCount(); ++i)
+        {
+            tokens.push_back(this->tokenToQString(i, codec));
+        }
+        return tokens;
+    }
+
+    QString FsdLine::toQString(QTextCodec *codec) const
+    {
+        if (!codec) { return QString::fromLatin1(m_line, m_lineSize); }
+        return codec->toUnicode(m_line, m_lineSize);
+    }
+
+    MessageType FsdLine::detectMessageType(const char *data, int size, int &pduLength)
+    {
+        pduLength = 0;
+        if (size < 1) { return MessageType::Unknown; }
+
+        // helper returning the type if the line is long enough for the PDU
+        const auto pdu = [&](int length, MessageType type)
+        {
+            if (size < length) { return MessageType::Unknown; }
+            pduLength = length;
+            return type;
+        };
+        const char c1 = size > 1 ? data[1] : '\0';
+        const char c2 = size > 2 ? data[2] : '\0';
+
+        switch (data[0])
+        {
+        case '@': return pdu(1, MessageType::PilotDataUpdate);
+        case '^': return pdu(1, MessageType::VisualPilotDataUpdate);
+        case '%': return pdu(1, MessageType::AtcDataUpdate);
+        case '#':
+            switch (c1)
+            {
+            case 'A':
+                if (c2 == 'A') { return pdu(3, MessageType::AddAtc); }
+                if (c2 == 'P') { return pdu(3, MessageType::AddPilot); }
+                break;
+            case 'D':
+                if (c2 == 'A') { return pdu(3, MessageType::DeleteATC); }
+                if (c2 == 'P') { return pdu(3, MessageType::DeletePilot); }
+                if (c2 == 'L') { return pdu(3, MessageType::ServerHeartbeat); }
+                break;
+            case 'P':
+                if (c2 == 'C') { return pdu(3, MessageType::ProController); }
+                break;
+            case 'S':
+                if (c2 == 'B') { return pdu(3, MessageType::PilotClientCom); }
+                if (c2 == 'L') { return pdu(3, MessageType::VisualPilotDataPeriodic); }
+                if (c2 == 'T') { return pdu(3, MessageType::VisualPilotDataStopped); }
+                break;
+            case 'T':
+                if (c2 == 'M') { return pdu(3, MessageType::TextMessage); }
+                break;
+            default: break;
+            }
+            break;
+        case '$':
+            switch (c1)
+            {
+            case 'C':
+                if (c2 == 'Q') { return pdu(3, MessageType::ClientQuery); }
+                if (c2 == 'R') { return pdu(3, MessageType::ClientResponse); }
+                break;
+            case 'Z':
+                if (c2 == 'C') { return pdu(3, MessageType::AuthChallenge); }
+                if (c2 == 'R') { return pdu(3, MessageType::AuthResponse); }
+                break;
+            case 'P':
+                if (c2 == 'I') { return pdu(3, MessageType::Ping); }
+                if (c2 == 'O') { return pdu(3, MessageType::Pong); }
+                break;
+            case 'I': if (c2 == 'D') { return pdu(3, MessageType::ClientIdentification); } break;
+            case 'F': if (c2 == 'P') { return pdu(3, MessageType::FlightPlan); } break;
+            case 'D': if (c2 == 'I') { return pdu(3, MessageType::FsdIdentification); } break;
+            case '!': if (c2 == '!') { return pdu(3, MessageType::KillRequest); } break;
+            case 'S': if (c2 == 'F') { return pdu(3, MessageType::VisualPilotDataToggle); } break;
+            case 'E': if (c2 == 'R') { return pdu(3, MessageType::ServerError); } break;
+            case 'X': if (c2 == 'X') { return pdu(3, MessageType::Rehost); } break;
+            default: break;
+            }
+            break;
+
+        // IVAO only
+        case '!':
+            if (c1 == 'R') { return pdu(2, MessageType::RegistrationInfo); }
+            break;
+        case '-':
+            if (c1 == 'M' && c2 == 'D') { return pdu(3, MessageType::RevBClientParts); }
+            if (c1 == 'P' && c2 == 'D') { return pdu(3, MessageType::RevBPilotDescription); }
+            break;
+
+        // Euroscope
+        case 'S':
+            if (size >= 7 && qstrncmp(data, "SIMDATA", 7) == 0) { return pdu(7, MessageType::EuroscopeSimData); }
+            break;
+
+        default: break;
+        }
+        return MessageType::Unknown;
+    }
+
+    double FsdLine::parseDouble(const char *data, int size)
+    {
+        // Fast path for [+-]digits[.digits] with at most 15 digits:
+        // mantissa and power of ten are exactly representable, so the division is correctly rounded
+        static constexpr double PowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+        static constexpr int MaxDigits = 15;
+
+        int i = 0;
+        bool negative = false;
+        if (i < size && (data[i] == '-' || data[i] == '+')) { negative = (data[i] == '-'); ++i; }
+
+        quint64 mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        bool hasDot = false;
+        bool fastPath = (i < size);
+        for (; fastPath && i < size; ++i)
+        {
+            const char c = data[i];
+            if (c >= '0' && c <= '9')
+            {
+                if (++digits > MaxDigits) { fastPath = false; break; }
+                mantissa = mantissa * 10 + static_cast<quint64>(c - '0');
+                if (hasDot) { ++fractionDigits; }
+            }
+            else if (c == '.' && !hasDot) { hasDot = true; }
+            else { fastPath = false; }
+        }
+
+        if (fastPath && digits > 0)
+        {
+            const double v = static_cast<double>(mantissa) / PowersOf10[fractionDigits];
+            return negative ? -v : v;
+        }
+
+        // exponents, whitespace, overlong numbers and invalid input
+        return QByteArray::fromRawData(data, size).toDouble();
+    }
+
+    qint64 FsdLine::parseInteger(const char *data, int size, bool *ok)
+    {
+        static constexpr int MaxDigits = 18; // always fits into qint64
+
+        int i = 0;
+        bool negative = false;
+        if (i < size && (data[i] == '-' || data[i] == '+')) { negative = (data[i] == '-'); ++i; }
+
+        qint64 value = 0;
+        int digits = 0;
+        bool fastPath = (i < size);
+        for (; fastPath && i < size; ++i)
+        {
+            const char c = data[i];
+            if (c < '0' || c > '9' || ++digits > MaxDigits) { fastPath = false; break; }
+            value = value * 10 + (c - '0');
+        }
+
+        if (fastPath)
+        {
+            if (ok) { *ok = true; }
+            return negative ? -value : value;
+        }
+        return QByteArray::fromRawData(data, size).toLongLong(ok);
+    }
+} // ns
@@ -0,0 +1,96 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_FSDLINE_H
+#define BLACKCORE_FSD_FSDLINE_H
+
+#include "blackcore/fsd/messagebase.h"
+#include "blackcore/blackcoreexport.h"
+
+#include <QByteArray>
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+#include <QVarLengthArray>
+
+class QTextCodec;
+
+namespace BlackCore::Fsd
+{
+    //! A received FSD line, split into PDU and ':' separated payload tokens.
+    //! \remark The tokens are views into the encoded line, nothing is copied or decoded unless explicitly requested.
+    //!         Tokens are indexed like the QStringList passed to the fromTokens functions of the messages.
+    //! \remark The line passed to the constructor must outlive this object.
+    class BLACKCORE_EXPORT FsdLine
+    {
+    public:
+        //! Constructor, detects the message type and tokenizes the payload
+        explicit FsdLine(const QByteArray &lineEncoded);
+
+        //! Message type, MessageType::Unknown if the PDU is not known
+        MessageType messageType() const { return m_messageType; }
+
+        //! Known message type?
+        bool isKnownMessageType() const { return m_messageType != MessageType::Unknown; }
+
+        //! Payload (without PDU) available?
+        bool hasPayload() const { return m_payloadSize > 0; }
+
+        //! Number of payload tokens
+        int tokenCount() const { return m_tokenStarts.size() - 1; }
+
+        //! Token as view on the encoded bytes, empty if index is out of range
+        QLatin1String token(int index) const;
+
+        //! Token as string
+        //! \remark only for ASCII tokens like callsigns or numbers, use the codec based version for text
+        QString tokenToQString(int index) const;
+
+        //! Token decoded with the given codec
+        QString tokenToQString(int index, QTextCodec *codec) const;
+
+        //! Token converted to number, same results as QString::toDouble/toInt/toUInt (0 if invalid)
+        //! @{
+        double  tokenToDouble(int index) const;
+        int     tokenToInt(int index) const;
+        quint32 tokenToUInt(int index) const;
+        //! @}
+
+        //! All tokens decoded, equivalent to the former QString::split(':') based tokenization
+        QStringList toTokens(QTextCodec *codec) const;
+
+        //! The whole (trimmed) line decoded
+        QString toQString(QTextCodec *codec) const;
+
+        //! Detect the message type from the PDU at the beginning of the line
+        //! \remark hand written trie over the known PDUs, no string compares or hashing
+        static MessageType detectMessageType(const char *data, int size, int &pduLength);
+
+        //! Number parsers used by the token conversion
+        //! \remark locale independent, fast path for the plain decimals used in FSD, falls back to QByteArray::toDouble
+        //! @{
+        static double  parseDouble(const char *data, int size);
+        static qint64  parseInteger(const char *data, int size, bool *ok);
+        //! @}
+
+    private:
+        //! Tokens kept without allocation, visual updates have 13 tokens, flight plans 17
+        static constexpr int PreallocatedTokens = 24;
+
+        const char *m_line = nullptr;    //!< trimmed line
+        int m_lineSize = 0;              //!< trimmed line size
+        int m_payloadStart = 0;          //!< offset of payload
+        int m_payloadSize  = 0;          //!< trimmed payload size
+        MessageType m_messageType = MessageType::Unknown;
+        QVarLengthArray<int, PreallocatedTokens + 1> m_tokenStarts; //!< start offsets of the tokens, last element is the end marker
+    };
+} // ns
+
+#endif // guard
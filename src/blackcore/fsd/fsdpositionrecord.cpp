@@ -0,0 +1,74 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/fsd/fsdpositionrecord.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackCore::Fsd
+{
+    bool FsdPositionRecord::setCallsign(const QString &cs)
+    {
+        if (cs.size() > MaxCallsignLength) { return false; }
+        int i = 0;
+        for (const QChar c : cs)
+        {
+            if (c.unicode() > 0xff) { return false; }
+            callsign[i++] = static_cast<char>(c.unicode());
+        }
+        callsign[i] = '\0';
+        return true;
+    }
+
+    CAircraftSituation FsdPositionRecord::toSituation() const
+    {
+        return this->toSituation(CCallsign(this->getCallsignAsString(), CCallsign::Aircraft));
+    }
+
+    CAircraftSituation FsdPositionRecord::toSituation(const CCallsign &cs) const
+    {
+        CAircraftSituation situation = (kind == PilotData) ?
+            CAircraftSituation(
+                cs,
+                CCoordinateGeodetic(latitudeDeg, longitudeDeg, altitudeTrueFt),
+                CHeading(headingDeg, CHeading::True, CAngleUnit::deg()),
+                CAngle(pitchDeg, CAngleUnit::deg()),
+                CAngle(bankDeg, CAngleUnit::deg()),
+                CSpeed(groundSpeedKts, CSpeedUnit::kts())) :
+            CAircraftSituation(
+                cs,
+                CCoordinateGeodetic(latitudeDeg, longitudeDeg, altitudeTrueFt),
+                CHeading(headingDeg, CHeading::True, CAngleUnit::deg()),
+                CAngle(pitchDeg, CAngleUnit::deg()),
+                CAngle(bankDeg, CAngleUnit::deg()));
+
+        if (kind == PilotData)
+        {
+            situation.setPressureAltitude(CAltitude(altitudePressureFt, CAltitude::MeanSeaLevel, CAltitude::PressureAltitude, CLengthUnit::ft()));
+            situation.setOnGround(onGround);
+        }
+        situation.setMSecsSinceEpoch(msSinceEpoch);
+        situation.setTimeOffsetMs(timeOffsetMs);
+        return situation;
+    }
+
+    CTransponder FsdPositionRecord::toTransponder() const
+    {
+        // I set a default: IFR standby is a reasonable default
+        if (!CTransponder::isValidTransponderCode(transponderCode)) { return CTransponder(2000, CTransponder::StateStandby); }
+        return CTransponder(transponderCode, static_cast<CTransponder::TransponderMode>(transponderMode));
+    }
+} // ns
@@ -0,0 +1,73 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_FSDPOSITIONRECORD_H
+#define BLACKCORE_FSD_FSDPOSITIONRECORD_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/transponder.h"
+
+#include <QString>
+#include <QtGlobal>
+#include <type_traits>
+
+namespace BlackCore::Fsd
+{
+    //! Received position as plain record, passed from the FSD thread to the airspace monitor via BlackMisc::LockFreeSpscQueue
+    //! \remark trivially copyable, no implicitly shared members
+    struct BLACKCORE_EXPORT FsdPositionRecord
+    {
+        //! Kind of position update
+        enum Kind : quint8
+        {
+            PilotData,      //!< @ full position with transponder
+            VisualPilotData //!< ^, \#SL, \#ST visual position
+        };
+
+        static constexpr int MaxCallsignLength = 15; //!< longer callsigns are not queued
+
+        char   callsign[MaxCallsignLength + 1] = {}; //!< Latin-1, zero terminated
+        Kind   kind = PilotData;
+        bool   onGround = false;
+        qint32 transponderCode = 0;
+        qint32 transponderMode = BlackMisc::Aviation::CTransponder::StateStandby;
+        double latitudeDeg = 0.0;
+        double longitudeDeg = 0.0;
+        double altitudeTrueFt = 0.0;
+        double altitudePressureFt = 0.0;
+        double headingDeg = 0.0;
+        double pitchDeg = 0.0;
+        double bankDeg = 0.0;
+        double groundSpeedKts = 0.0;
+        qint64 msSinceEpoch = 0;
+        qint64 timeOffsetMs = 0;
+
+        //! Set callsign, false if it is too long for the record
+        bool setCallsign(const QString &cs);
+
+        //! Callsign as string
+        QString getCallsignAsString() const { return QString::fromLatin1(callsign); }
+
+        //! The situation as emitted by the signal based path
+        //! @{
+        BlackMisc::Aviation::CAircraftSituation toSituation() const;
+        BlackMisc::Aviation::CAircraftSituation toSituation(const BlackMisc::Aviation::CCallsign &cs) const;
+        //! @}
+
+        //! Transponder, IFR standby for invalid codes
+        BlackMisc::Aviation::CTransponder toTransponder() const;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FsdPositionRecord>, "Record is copied by value between threads");
+} // ns
+
+#endif // guard
@@ -88,6 +88,13 @@ namespace BlackCore::Fsd
 
         onGround = pbhstrct.onground == 1;
     }
+
+    //! Unpack pitch, bank and heading from 32 bit integer, for PDUs without an onGround flag
+    inline void unpackPBH(quint32 pbh, double &pitch, double &bank, double &heading)
+    {
+        bool onGround = false;
+        unpackPBH(pbh, pitch, bank, heading, onGround);
+    }
 }
 
 #endif // guard
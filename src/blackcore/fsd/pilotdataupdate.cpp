@@ -75,4 +75,24 @@ namespace BlackCore::Fsd
                 tokens[4].toDouble(), tokens[5].toDouble(), tokens[6].toInt(), tokens[6].toInt() + tokens[9].toInt(), tokens[7].toInt(),
                 pitch, bank, heading, onGround);
     }
+
+    PilotDataUpdate PilotDataUpdate::fromTokens(const FsdLine &line)
+    {
+        if (line.tokenCount() < 10)
+        {
+            CLogMessage(static_cast<PilotDataUpdate *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+
+        double pitch = 0.0;
+        double bank  = 0.0;
+        double heading = 0.0;
+        bool onGround = false;
+        unpackPBH(line.tokenToUInt(8), pitch, bank, heading, onGround);
+
+        const int altitudeTrue = line.tokenToInt(6);
+        return PilotDataUpdate(fromQString<CTransponder::TransponderMode>(line.tokenToQString(0)), line.tokenToQString(1), line.tokenToInt(2), fromQString<PilotRating>(line.tokenToQString(3)),
+                line.tokenToDouble(4), line.tokenToDouble(5), altitudeTrue, altitudeTrue + line.tokenToInt(9), line.tokenToInt(7),
+                pitch, bank, heading, onGround);
+    }
 }
@@ -13,6 +13,7 @@
 
 #include "blackcore/fsd/messagebase.h"
 #include "blackcore/fsd/enums.h"
+#include "blackcore/fsd/fsdline.h"
 #include "blackmisc/aviation/transponder.h"
 
 namespace BlackCore::Fsd
@@ -32,6 +33,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static PilotDataUpdate fromTokens(const QStringList &tokens);
 
+        //! Construct from a tokenized line, only the sender is converted to a string
+        static PilotDataUpdate fromTokens(const FsdLine &line);
+
         //! PDU identifier
         static QString pdu() { return "@"; }
 
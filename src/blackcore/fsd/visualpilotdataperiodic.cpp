@@ -82,6 +82,24 @@ namespace BlackCore::Fsd
                 tokens[11].toDouble(), tokens[10].toDouble(), tokens.value(12, QStringLiteral("0")).toDouble());
     }
 
+    VisualPilotDataPeriodic VisualPilotDataPeriodic::fromTokens(const FsdLine &line)
+    {
+        if (line.tokenCount() < 12)
+        {
+            CLogMessage(static_cast<VisualPilotDataPeriodic *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+
+        double pitch = 0.0;
+        double bank  = 0.0;
+        double heading = 0.0;
+        unpackPBH(line.tokenToUInt(5), pitch, bank, heading);
+
+        return VisualPilotDataPeriodic(line.tokenToQString(0), line.tokenToDouble(1), line.tokenToDouble(2), line.tokenToDouble(3), line.tokenToDouble(4),
+                pitch, bank, heading, line.tokenToDouble(6), line.tokenToDouble(7), line.tokenToDouble(8), line.tokenToDouble(9),
+                line.tokenToDouble(11), line.tokenToDouble(10), line.tokenToDouble(12)); // missing token 12 is 0
+    }
+
     VisualPilotDataUpdate VisualPilotDataPeriodic::toUpdate() const
     {
         return VisualPilotDataUpdate(m_sender, m_latitude, m_longitude, m_altitudeTrue, m_heightAgl, m_pitch, m_bank, m_heading,
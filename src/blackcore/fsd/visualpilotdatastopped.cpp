@@ -68,6 +68,23 @@ namespace BlackCore::Fsd
                 pitch, bank, heading, tokens.value(12, QStringLiteral("0")).toDouble());
     }
 
+    VisualPilotDataStopped VisualPilotDataStopped::fromTokens(const FsdLine &line)
+    {
+        if (line.tokenCount() < 6)
+        {
+            CLogMessage(static_cast<VisualPilotDataStopped *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+
+        double pitch = 0.0;
+        double bank  = 0.0;
+        double heading = 0.0;
+        unpackPBH(line.tokenToUInt(5), pitch, bank, heading);
+
+        return VisualPilotDataStopped(line.tokenToQString(0), line.tokenToDouble(1), line.tokenToDouble(2), line.tokenToDouble(3), line.tokenToDouble(4),
+                pitch, bank, heading, line.tokenToDouble(12)); // missing token 12 is 0
+    }
+
     VisualPilotDataUpdate VisualPilotDataStopped::toUpdate() const
     {
         return VisualPilotDataUpdate(m_sender, m_latitude, m_longitude, m_altitudeTrue, m_heightAgl, m_pitch, m_bank, m_heading,
@@ -13,6 +13,7 @@
 
 #include "messagebase.h"
 #include "enums.h"
+#include "fsdline.h"
 
 namespace BlackCore::Fsd
 {
@@ -34,6 +35,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static VisualPilotDataUpdate fromTokens(const QStringList &tokens);
 
+        //! Construct from a tokenized line, only the sender is converted to a string
+        static VisualPilotDataUpdate fromTokens(const FsdLine &line);
+
         //! PDU identifier
         static QString pdu() { return "^"; }
 
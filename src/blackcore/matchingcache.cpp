@@ -0,0 +1,207 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/matchingcache.h"
+#include "blackcore/application.h"
+#include "blackcore/webdataservices.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/swiftdirectories.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/jsonexception.h"
+#include "blackmisc/logcategories.h"
+#include "blackmisc/logmessage.h"
+
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QStringBuilder>
+#include <array>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCore
+{
+    CMatchingCache::CMatchingCache(int maxEntries) : m_reverseLookup(maxEntries), m_matching(maxEntries)
+    { }
+
+    CMatchingCache &CMatchingCache::instance()
+    {
+        static CMatchingCache cache;
+        static const bool loaded = cache.loadFromFile();
+        Q_UNUSED(loaded)
+        return cache;
+    }
+
+    QString CMatchingCache::cacheKey(const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, const QString &modelString, const QString &revision)
+    {
+        return aircraftIcao.trimmed().toUpper() % u'|' %
+               airlineIcao.trimmed().toUpper() % u'|' %
+               livery.trimmed().toUpper() % u'|' %
+               modelString.trimmed().toUpper() % u'|' % revision;
+    }
+
+    QString CMatchingCache::cacheKey(const CAircraftModel &model, const QString &revision)
+    {
+        return CMatchingCache::cacheKey(
+                   model.getAircraftIcaoCode().getDesignatorDbKey(), model.getAirlineIcaoCode().getVDesignatorDbKey(),
+                   model.getLivery().getCombinedCodePlusInfoAndId(), model.getModelStringAndDbKey(), revision);
+    }
+
+    QString CMatchingCache::modelSetRevision(const CAircraftModelList &modelSet)
+    {
+        // model strings and DB keys, so any added, removed, renamed or re-assigned model is a new revision,
+        // also if the timestamps are unchanged
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        for (const CAircraftModel &model : modelSet)
+        {
+            const QString &modelString = model.getModelString();
+            const std::array<int, 4> keys
+            {{
+                model.getDbKey(), model.getAircraftIcaoCode().getDbKey(),
+                model.getLivery().getDbKey(), static_cast<int>(qHash(model.getDistributor().getDbKey()))
+            }};
+            hash.addData(reinterpret_cast<const char *>(modelString.constData()), modelString.size() * static_cast<int>(sizeof(QChar)));
+            hash.addData(reinterpret_cast<const char *>(keys.data()), static_cast<int>(sizeof(keys)));
+        }
+        return QString::number(modelSet.size()) % u'_' % QString::fromLatin1(hash.result().toHex());
+    }
+
+    QString CMatchingCache::dbRevision()
+    {
+        if (!sApp || !sApp->hasWebDataServices()) { return QStringLiteral("-1"); }
+        const QDateTime latest = sApp->getWebDataServices()->getLatestDbEntityCacheTimestamp();
+        return QString::number(latest.isValid() ? latest.toMSecsSinceEpoch() : -1);
+    }
+
+    bool CMatchingCache::lookup(CacheType type, const QString &key, CAircraftModel &model)
+    {
+        {
+            QMutexLocker l(&m_mutex);
+            const CAircraftModel *cached = this->cache(type).object(key); // also marks as recently used
+            if (cached)
+            {
+                model = *cached;
+                l.unlock();
+                ++m_hits[type];
+                return true;
+            }
+        }
+        ++m_misses[type];
+        return false;
+    }
+
+    void CMatchingCache::insert(CacheType type, const QString &key, const CAircraftModel &model)
+    {
+        if (key.isEmpty()) { return; }
+        QMutexLocker l(&m_mutex);
+        this->cache(type).insert(key, new CAircraftModel(model));
+        m_changed = true;
+    }
+
+    int CMatchingCache::getEntryCount(CacheType type) const
+    {
+        QMutexLocker l(&m_mutex);
+        return this->cache(type).size();
+    }
+
+    void CMatchingCache::clear()
+    {
+        QMutexLocker l(&m_mutex);
+        m_reverseLookup.clear();
+        m_matching.clear();
+        m_changed = true;
+    }
+
+    void CMatchingCache::resetCounters()
+    {
+        for (int t = ReverseLookup; t <= ModelMatching; ++t)
+        {
+            m_hits[t] = 0;
+            m_misses[t] = 0;
+        }
+    }
+
+    bool CMatchingCache::saveToFile(const QString &fileName) const
+    {
+        QJsonObject json;
+        {
+            QMutexLocker l(&m_mutex);
+            for (int t = ReverseLookup; t <= ModelMatching; ++t)
+            {
+                const CacheType type = static_cast<CacheType>(t);
+                const QCache<QString, CAircraftModel> &c = this->cache(type);
+                QJsonArray entries;
+                for (const QString &key : c.keys())
+                {
+                    QJsonObject entry;
+                    entry.insert(QStringLiteral("key"), key);
+                    entry.insert(QStringLiteral("model"), c.object(key)->toJson());
+                    entries.append(entry);
+                }
+                json.insert(cacheTypeToString(type), entries);
+            }
+        }
+
+        const QString file = fileName.isEmpty() ? defaultFileName() : fileName;
+        if (!CFileUtils::writeStringToFile(QJsonDocument(json).toJson(QJsonDocument::Compact), file)) { return false; }
+        m_changed = false;
+        return true;
+    }
+
+    bool CMatchingCache::loadFromFile(const QString &fileName)
+    {
+        const QString file = fileName.isEmpty() ? defaultFileName() : fileName;
+        const QString content = CFileUtils::readFileToString(file);
+        if (content.isEmpty()) { return false; }
+
+        const QJsonObject json = QJsonDocument::fromJson(content.toUtf8()).object();
+        if (json.isEmpty()) { return false; }
+
+        QMutexLocker l(&m_mutex);
+        try
+        {
+            for (int t = ReverseLookup; t <= ModelMatching; ++t)
+            {
+                const CacheType type = static_cast<CacheType>(t);
+                QCache<QString, CAircraftModel> &c = this->cache(type);
+                const QJsonArray entries = json.value(cacheTypeToString(type)).toArray();
+                for (const QJsonValue &value : entries)
+                {
+                    const QJsonObject entry = value.toObject();
+                    const QString key = entry.value(QStringLiteral("key")).toString();
+                    if (key.isEmpty()) { continue; }
+                    c.insert(key, new CAircraftModel(CAircraftModel::fromJson(entry.value(QStringLiteral("model")).toObject())));
+                }
+            }
+        }
+        catch (const CJsonException &ex)
+        {
+            m_reverseLookup.clear();
+            m_matching.clear();
+            CLogMessage(CLogCategories::matching()).warning(u"Cannot read matching cache '%1': %2") << file << QString(ex.what());
+            return false;
+        }
+        return true;
+    }
+
+    const QString &CMatchingCache::defaultFileName()
+    {
+        static const QString f = CFileUtils::appendFilePaths(CSwiftDirectories::normalizedApplicationDataDirectory(), QStringLiteral("matchingcache.json"));
+        return f;
+    }
+
+    const QString &CMatchingCache::cacheTypeToString(CacheType type)
+    {
+        static const QString rl("reverseLookup");
+        static const QString m("matching");
+        return type == ReverseLookup ? rl : m;
+    }
+} // ns
@@ -0,0 +1,119 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_MATCHINGCACHE_H
+#define BLACKCORE_MATCHINGCACHE_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+namespace BlackCore
+{
+    /*!
+     * Process wide cache of reverse lookup and model matching results.
+     *
+     * Results are keyed on the network identity of an aircraft (aircraft ICAO, airline ICAO, livery string, model string)
+     * plus a revision of the data used to compute them (model set, matching setup, swift DB data).
+     * A changed revision yields a different key, so outdated results are never returned and age out of the LRU caches.
+     * The process wide cache is loaded from the application data directory on first use,
+ * its owner saves it at shutdown by CMatchingCache::saveToFile.
+     * \threadsafe
+     */
+    class BLACKCORE_EXPORT CMatchingCache
+    {
+    public:
+        //! Cached results
+        enum CacheType
+        {
+            ReverseLookup,
+            ModelMatching
+        };
+
+        //! Max. entries per cache type
+        static constexpr int MaxEntries = 2500;
+
+        //! Constructor, empty cache
+        //! \remark use CMatchingCache::instance for the process wide cache
+        explicit CMatchingCache(int maxEntries = MaxEntries);
+
+        //! The process wide cache, loaded from the default file
+        static CMatchingCache &instance();
+
+        //! Key for a network identity and the revision of the data used
+        static QString cacheKey(const QString &aircraftIcao, const QString &airlineIcao, const QString &livery, const QString &modelString, const QString &revision);
+
+        //! Key for the model of a remote aircraft and the revision of the data used
+        static QString cacheKey(const BlackMisc::Simulation::CAircraftModel &model, const QString &revision);
+
+        //! Revision of a model set, changes whenever models are added, removed or updated
+        //! \remark hash over the model strings and the DB keys of the models, aircraft ICAO codes, liveries and distributors
+        static QString modelSetRevision(const BlackMisc::Simulation::CAircraftModelList &modelSet);
+
+        //! Revision of the swift DB data, i.e. the latest DB cache timestamp
+        static QString dbRevision();
+
+        //! Cached result, counts as hit or miss
+        bool lookup(CacheType type, const QString &key, BlackMisc::Simulation::CAircraftModel &model);
+
+        //! Cache a result
+        void insert(CacheType type, const QString &key, const BlackMisc::Simulation::CAircraftModel &model);
+
+        //! Number of cached results
+        int getEntryCount(CacheType type) const;
+
+        //! Clear all results
+        void clear();
+
+        //! Results inserted since loaded or saved?
+        bool hasChanges() const { return m_changed; }
+
+        //! \name Hits and misses since start or CMatchingCache::resetCounters
+        //! @{
+        int getHits(CacheType type) const { return m_hits[type]; }
+        int getMisses(CacheType type) const { return m_misses[type]; }
+        void resetCounters();
+        //! @}
+
+        //! Save to file, default file if empty
+        bool saveToFile(const QString &fileName = {}) const;
+
+        //! Load from file, default file if empty
+        bool loadFromFile(const QString &fileName = {});
+
+        //! Default file in the application data directory
+        static const QString &defaultFileName();
+
+        //! Type as string
+        static const QString &cacheTypeToString(CacheType type);
+
+    private:
+        //! Cache for type
+        //! \remark requires the mutex to be locked
+        QCache<QString, BlackMisc::Simulation::CAircraftModel> &cache(CacheType type) { return type == ReverseLookup ? m_reverseLookup : m_matching; }
+
+        //! Cache for type
+        //! \remark requires the mutex to be locked
+        const QCache<QString, BlackMisc::Simulation::CAircraftModel> &cache(CacheType type) const { return type == ReverseLookup ? m_reverseLookup : m_matching; }
+
+        mutable QMutex m_mutex;
+        QCache<QString, BlackMisc::Simulation::CAircraftModel> m_reverseLookup; //!< reverse lookup results
+        QCache<QString, BlackMisc::Simulation::CAircraftModel> m_matching;      //!< model matching results
+        mutable std::atomic_bool m_changed { false }; //!< inserted since loaded or saved
+        std::atomic_int m_hits[2] { {0}, {0} };   //!< hits per type
+        std::atomic_int m_misses[2] { {0}, {0} }; //!< misses per type
+    };
+} // ns
+
+#endif // guard
@@ -14,6 +14,8 @@
 #include "blackmisc/math/mathutils.h"
 #include "blackmisc/crashhandler.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/fileutils.h"
+#include "blackmisc/swiftdirectories.h"
 #include "blackmisc/threadutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
@@ -421,6 +423,12 @@ namespace BlackCore
         m_statsUpdateAircraftLimited     = 0;
         m_statsLastUpdateAircraftRequestedMs  = 0;
         m_statsUpdateAircraftRequestedDeltaMs = 0;
+        m_statsCurrentUpdateBytesSent         = -1;
+        m_statsCurrentUpdateBytesSaved        = 0;
+        m_statsUpdateAircraftBytesSentTotal   = 0;
+        m_statsUpdateAircraftBytesSavedTotal  = 0;
+        m_statsUpdateAircraftBytesSentAvg     = 0;
+        m_statsUpdateAircraftBytesSavedAvg    = 0;
         ISimulationEnvironmentProvider::resetSimulationEnvironmentStatistics();
     }
 
@@ -512,6 +520,14 @@ namespace BlackCore
             }
         } // logint
 
+        if (part1.startsWith("parallel") && parser.hasPart(2))
+        {
+            const bool enabled = parser.toBool(2);
+            this->setParallelInterpolationEnabled(enabled);
+            CLogMessage(this).info(u"Parallel interpolation: %1, %2 worker threads") << boolToOnOff(enabled) << m_interpolationPool.maxThreadCount();
+            return true;
+        }
+
         if (part1.startsWith("spline") || part1.startsWith("linear"))
         {
             if (parser.hasPart(2))
@@ -658,6 +674,7 @@ namespace BlackCore
         CSimpleCommandParser::registerCommand({".drv logint write", "write interpolator log to file"});
         CSimpleCommandParser::registerCommand({".drv logint clear", "clear current log"});
         CSimpleCommandParser::registerCommand({".drv logint max number", "max. number of entries logged"});
+        CSimpleCommandParser::registerCommand({".drv parallel on|off", "parallel interpolation of aircraft"});
         CSimpleCommandParser::registerCommand({".drv pos callsign", "show position for callsign"});
         CSimpleCommandParser::registerCommand({".drv spline|linear callsign", "set spline/linear interpolator for one/all callsign(s)"});
         CSimpleCommandParser::registerCommand({".drv aircraft readd callsign", "add again (re-add) a given callsign"});
@@ -670,6 +687,45 @@ namespace BlackCore
         }
     }
 
+    QVector<CInterpolationResult> ISimulator::interpolateRemoteAircraft(const QVector<CInterpolatorMulti *> &interpolators, const QVector<CInterpolationAndRenderingSetupPerCallsign> &setups, qint64 currentTimestamp)
+    {
+        Q_ASSERT_X(interpolators.size() == setups.size(), Q_FUNC_INFO, "Mismatching sizes");
+        const int count = interpolators.size();
+        QVector<CInterpolationResult> results(count);
+        if (count < 1) { return results; }
+
+        // detach once here, the workers write distinct elements
+        CInterpolationResult *resultsData = results.data();
+        const auto interpolate = [&](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                CInterpolatorMulti *interpolator = interpolators[i];
+                if (interpolator) { resultsData[i] = interpolator->getInterpolation(currentTimestamp, setups[i], i); }
+                else { resultsData[i].reset(); }
+            }
+        };
+
+        const int workers = m_interpolationPool.maxThreadCount();
+        if (!m_parallelInterpolation || workers < 1 || count < MinAircraftForParallelInterpolation)
+        {
+            interpolate(0, count);
+            return results;
+        }
+
+        // one chunk per worker, and one for this thread
+        // the event loop of this thread is blocked until all workers are done, so nothing else uses the interpolators meanwhile
+        const int chunkSize = (count + workers) / (workers + 1);
+        for (int begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            const int end = qMin(count, begin + chunkSize);
+            m_interpolationPool.start([ = ] { interpolate(begin, end); });
+        }
+        interpolate(0, chunkSize);
+        m_interpolationPool.waitForDone();
+        return results;
+    }
+
     QString ISimulator::statusToString(SimulatorStatus status)
     {
         QStringList s;
@@ -756,6 +812,10 @@ namespace BlackCore
         this->setObjectName("Simulator: " + pluginInfo.getIdentifier());
         m_interpolationLogger.setObjectName("Logger: " + pluginInfo.getIdentifier());
 
+        // this thread interpolates a share of the aircraft itself, so one worker less than cores
+        m_interpolationPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+        m_parallelInterpolation = QThread::idealThreadCount() > 1;
+
         ISimulator::registerHelp();
 
         // provider signals, hook up with remote aircraft provider
@@ -801,6 +861,10 @@ namespace BlackCore
         // model changed
         connect(this, &ISimulator::ownAircraftModelChanged, this, &ISimulator::onOwnModelChanged, Qt::QueuedConnection);
 
+        // elevations of the last sessions, e.g. at the home airport
+        const int elevations = this->loadElevationsFromFile(this->getElevationsFileName());
+        if (elevations > 0) { CLogMessage(this).info(u"Loaded %1 elevations from '%2'") << elevations << this->getElevationsFileName(); }
+
         // info
         CLogMessage(this).info(u"Initialized simulator driver: '%1'") <<
                 (this->getSimulatorInfo().isUnspecified() ?
@@ -942,7 +1006,7 @@ namespace BlackCore
         if (elevation.hasMSLGeodeticHeight())
         {
             const int aircraftCount = this->getAircraftInRangeCount();
-            this->setMaxElevationsRemembered(aircraftCount * 3); // at least 3 elevations per aircraft, even better as not all are requesting elevations
+            this->setMaxElevationsRemembered(aircraftCount * 10); // 10 elevations per aircraft, the least recently used ones are evicted
             this->rememberGroundElevation(callsign, likelyOnGroundElevation, elevation);
         }
 
@@ -1030,7 +1094,18 @@ namespace BlackCore
         const CAirportList airports = sApp->getWebDataServices()->getAirports();
         if (airports.isEmpty()) { return airports; }
         const CCoordinateGeodetic ownPosition = this->getOwnAircraftPosition();
-        CAirportList airportsInRange = airports.findClosest(maxAirportsInRange(), ownPosition);
+        CAirportList airportsInRange;
+        {
+            // the airports rarely change, so the index is only built again if they do
+            QMutexLocker l(&m_airportsIndexMutex);
+            if (m_airportsIndexed != airports)
+            {
+                m_airportsIndexed = airports;
+                m_airportsIndex = airports.createSpatialIndex();
+                Q_ASSERT_X(m_airportsIndexed.hasSameCoordinatesAsSpatialIndex(m_airportsIndex), Q_FUNC_INFO, "Spatial index not matching the airports");
+            }
+            airportsInRange = m_airportsIndexed.findClosest(m_airportsIndex, maxAirportsInRange(), ownPosition);
+        }
         if (recalculateDistance) { airportsInRange.calculcateAndUpdateRelativeDistanceAndBearing(this->getOwnAircraftPosition()); }
         return airportsInRange;
     }
@@ -1106,9 +1181,16 @@ namespace BlackCore
         const bool saved = m_autoPublishing.writeJsonToFile(); // empty data are ignored
         if (saved) { emit this->autoPublishDataWritten(this->getSimulatorInfo()); }
         m_autoPublishing.clear();
+        this->saveElevationsToFile(this->getElevationsFileName());
         m_remoteAircraftProviderConnections.disconnectAll(); // disconnect signals from provider
     }
 
+    QString ISimulator::getElevationsFileName() const
+    {
+        const QString fn = u"elevations_" % this->getSimulatorPluginInfo().getIdentifier() % u".bin";
+        return CFileUtils::appendFilePaths(CSwiftDirectories::normalizedApplicationDataDirectory(), fn);
+    }
+
     bool ISimulator::isAircraftInRangeOrTestMode(const CCallsign &callsign) const
     {
         return this->isTestMode() || this->isAircraftInRange(callsign);
@@ -1221,6 +1303,13 @@ namespace BlackCore
         m_statsUpdateAircraftTimeTotalMs += dt;
         m_statsUpdateAircraftRuns++;
         m_statsUpdateAircraftTimeAvgMs = static_cast<double>(m_statsUpdateAircraftTimeTotalMs) / static_cast<double>(m_statsUpdateAircraftRuns);
+        if (m_statsCurrentUpdateBytesSent >= 0)
+        {
+            m_statsUpdateAircraftBytesSentTotal  += m_statsCurrentUpdateBytesSent;
+            m_statsUpdateAircraftBytesSavedTotal += m_statsCurrentUpdateBytesSaved;
+            m_statsUpdateAircraftBytesSentAvg  = static_cast<double>(m_statsUpdateAircraftBytesSentTotal)  / static_cast<double>(m_statsUpdateAircraftRuns);
+            m_statsUpdateAircraftBytesSavedAvg = static_cast<double>(m_statsUpdateAircraftBytesSavedTotal) / static_cast<double>(m_statsUpdateAircraftRuns);
+        }
         m_updateRemoteAircraftInProgress = false;
         m_statsLastUpdateAircraftRequestedMs = startTime;
 
@@ -1231,6 +1320,12 @@ namespace BlackCore
         if (limited) { m_statsUpdateAircraftLimited++; }
     }
 
+    void ISimulator::setStatisticsUpdateAircraftBytes(qint64 sent, qint64 saved)
+    {
+        m_statsCurrentUpdateBytesSent  = sent;
+        m_statsCurrentUpdateBytesSaved = saved;
+    }
+
     void ISimulator::onOwnModelChanged(const CAircraftModel &newModel)
     {
         Q_UNUSED(newModel)
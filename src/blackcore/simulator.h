@@ -30,6 +30,7 @@
 #include "blackmisc/network/clientprovider.h"
 #include "blackmisc/weather/weathergridprovider.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/geo/geospatialindex.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/time.h"
 #include "blackmisc/statusmessage.h"
@@ -41,8 +42,11 @@
 #include "blackconfig/buildconfig.h"
 
 #include <QFlags>
+#include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
+#include <QVector>
 #include <atomic>
 
 namespace BlackMisc
@@ -295,6 +299,7 @@ namespace BlackCore
         //! .drv logint off                   no log information for interpolator     BlackCore::ISimulator
         //! .drv logint write                 write interpolator log to file          BlackCore::ISimulator
         //! .drv logint clear                 clear current log                       BlackCore::ISimulator
+        //! .drv parallel on|off              parallel interpolation of aircraft      BlackCore::ISimulator
         //! .drv pos callsign                 shows current position in simulator     BlackCore::ISimulator
         //! .drv spline|linear callsign       interpolator spline or linear           BlackCore::ISimulator
         //! .drv aircraft readd callsign      re-add (add again) aircraft             BlackCore::ISimulator
@@ -343,6 +348,18 @@ namespace BlackCore
         //! Time between two update requests
         qint64 getStatisticsAircraftUpdatedRequestedDeltaMs() const { return m_statsUpdateAircraftRequestedDeltaMs; }
 
+        //! Bytes sent to the simulator by the last update, -1 if not supported by the driver
+        qint64 getStatisticsCurrentUpdateBytesSent() const { return m_statsCurrentUpdateBytesSent; }
+
+        //! Bytes not sent to the simulator by the last update, as the values did not change
+        qint64 getStatisticsCurrentUpdateBytesSaved() const { return m_statsCurrentUpdateBytesSaved; }
+
+        //! Average bytes sent per update
+        double getStatisticsAverageUpdateBytesSent() const { return m_statsUpdateAircraftBytesSentAvg; }
+
+        //! Average bytes saved per update
+        double getStatisticsAverageUpdateBytesSaved() const { return m_statsUpdateAircraftBytesSavedAvg; }
+
         //! The traced loopback situations
         BlackMisc::Aviation::CAircraftSituationList getLoopbackSituations(const BlackMisc::Aviation::CCallsign &callsign) const;
 
@@ -357,10 +374,10 @@ namespace BlackCore
         QString updateAircraftLimitationInfo() const;
 
         //! Reset the last sent values
-        void resetLastSentValues();
+        virtual void resetLastSentValues();
 
         //! Reset the last sent values per callsign
-        void resetLastSentValues(const BlackMisc::Aviation::CCallsign &callsign);
+        virtual void resetLastSentValues(const BlackMisc::Aviation::CCallsign &callsign);
 
         //! Register help
         static void registerHelp();
@@ -569,6 +586,26 @@ namespace BlackCore
         //! Update stats and flags
         void finishUpdateRemoteAircraftAndSetStatistics(qint64 startTime, bool limited = false);
 
+        //! Bytes sent and saved by the current update
+        //! \remark call before finishUpdateRemoteAircraftAndSetStatistics
+        void setStatisticsUpdateAircraftBytes(qint64 sent, qint64 saved);
+
+        //! Interpolate the given remote aircraft for the current frame
+        //! \remark with enough aircraft the interpolators are distributed over worker threads, the calling thread waits for all results
+        //! \remark each interpolator must only be passed once, the results are in the order of the interpolators
+        //! \remark the interpolators only access the providers via their thread safe functions (snapshots taken under the provider locks)
+        QVector<BlackMisc::Simulation::CInterpolationResult> interpolateRemoteAircraft(const QVector<BlackMisc::Simulation::CInterpolatorMulti *> &interpolators,
+                const QVector<BlackMisc::Simulation::CInterpolationAndRenderingSetupPerCallsign> &setups, qint64 currentTimestamp);
+
+        //! Parallel interpolation in ISimulator::interpolateRemoteAircraft
+        //! @{
+        bool isParallelInterpolationEnabled() const { return m_parallelInterpolation; }
+        void setParallelInterpolationEnabled(bool enabled) { m_parallelInterpolation = enabled; }
+        //! @}
+
+        //! Fewer aircraft are interpolated in the calling thread, not worth distributing them
+        static constexpr int MinAircraftForParallelInterpolation = 24;
+
         //! Own model has been changed
         virtual void onOwnModelChanged(const BlackMisc::Simulation::CAircraftModel &newModel);
 
@@ -590,9 +627,13 @@ namespace BlackCore
         //! Lookup against DB data
         static BlackMisc::Simulation::CAircraftModel reverseLookupModel(const BlackMisc::Simulation::CAircraftModel &model);
 
+        //! File keeping the frequently used on ground elevations between sessions
+        QString getElevationsFileName() const;
+
         bool   m_pausedSimFreezesInterpolation  = false;  //!< paused simulator will also pause interpolation (so AI aircraft will hold)
         bool   m_updateRemoteAircraftInProgress = false;  //!< currently updating remote aircraft
         bool   m_enablePseudoElevation = false;           //!< return faked elevations (testing)
+        bool   m_parallelInterpolation = true;            //!< distribute interpolation over m_interpolationPool
         int    m_timerId = -1;                            //!< dispatch timer id
         int    m_statsUpdateAircraftRuns        = 0;      //!< statistics update count
         int    m_statsUpdateAircraftLimited     = 0;      //!< skipped because of max.update limitations
@@ -608,10 +649,20 @@ namespace BlackCore
         qint64 m_lastRecordedGndElevationMs     = 0;      //!< when gnd.elevation was last modified
         qint64 m_statsLastUpdateAircraftRequestedMs  = 0; //!< when was the last aircraft update requested
         qint64 m_statsUpdateAircraftRequestedDeltaMs = 0; //!< delta time between 2 aircraft updates
+        qint64 m_statsCurrentUpdateBytesSent    = -1;     //!< statistics bytes sent by the current update, -1 not supported
+        qint64 m_statsCurrentUpdateBytesSaved   = 0;      //!< statistics bytes saved by the current update
+        qint64 m_statsUpdateAircraftBytesSentTotal  = 0;  //!< statistics total bytes sent
+        qint64 m_statsUpdateAircraftBytesSavedTotal = 0;  //!< statistics total bytes saved
+        double m_statsUpdateAircraftBytesSentAvg    = 0;  //!< statistics average bytes sent per update
+        double m_statsUpdateAircraftBytesSavedAvg   = 0;  //!< statistics average bytes saved per update
 
         BlackMisc::Aviation::CAltitude              m_pseudoElevation { BlackMisc::Aviation::CAltitude::null() }; //!< pseudo elevation for testing purposes
         BlackMisc::Simulation::CSimulatorInternals  m_simulatorInternals;  //!< setup read from the sim
         BlackMisc::Simulation::CInterpolationLogger m_interpolationLogger; //!< log.interpolation
+        QThreadPool                                 m_interpolationPool;   //!< workers for ISimulator::interpolateRemoteAircraft
+        mutable QMutex                              m_airportsIndexMutex;  //!< lock m_airportsIndexed, m_airportsIndex
+        mutable BlackMisc::Aviation::CAirportList   m_airportsIndexed;     //!< airports of m_airportsIndex
+        mutable BlackMisc::Geo::CGeoSpatialIndex    m_airportsIndex;       //!< spatial index of the airports, built when they change
         BlackMisc::Simulation::CAutoPublishData     m_autoPublishing;      //!< for the DB
         BlackMisc::Aviation::CAircraftSituationPerCallsign m_lastSentSituations; //!< last situations sent to simulator
         BlackMisc::Aviation::CAircraftPartsPerCallsign     m_lastSentParts;      //!< last parts sent to simulator
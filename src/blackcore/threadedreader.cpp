@@ -116,6 +116,22 @@ namespace BlackCore
         return true;
     }
 
+    bool CThreadedReader::didContentChange(const QByteArray &content)
+    {
+        uint oldHash = 0;
+        {
+            QReadLocker rl(&m_lock);
+            oldHash = m_contentHash;
+        }
+        const uint newHash = qHash(content);
+        if (oldHash == newHash) { return false; }
+        {
+            QWriteLocker wl(&m_lock);
+            m_contentHash = newHash;
+        }
+        return true;
+    }
+
     bool CThreadedReader::isMarkedAsFailed() const
     {
         return m_markedAsFailed;
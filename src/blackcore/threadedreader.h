@@ -17,6 +17,7 @@
 #include "blackmisc/logcategories.h"
 #include "blackmisc/worker.h"
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QObject>
 #include <QReadWriteLock>
@@ -119,6 +120,10 @@ namespace BlackCore
         //! \threadsafe
         bool didContentChange(const QString &content, int startPosition = -1);
 
+        //! \copydoc didContentChange
+        //! \remark for raw data, avoids the conversion to QString
+        bool didContentChange(const QByteArray &content);
+
         //! Set initial and periodic times
         void setInitialAndPeriodicTime(int initialTime, int periodicTime);
 
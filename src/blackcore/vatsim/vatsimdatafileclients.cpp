@@ -0,0 +1,199 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/vatsim/vatsimdatafileclients.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/aviation/informationmessage.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/network/user.h"
+#include "blackmisc/pq/frequency.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/range.h"
+
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QLatin1String>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::Network;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCore::Vatsim
+{
+    namespace
+    {
+        //! \private Same values of the given fields
+        bool equalFields(const QJsonObject &o1, const QJsonObject &o2, std::initializer_list<QLatin1String> fields)
+        {
+            for (const QLatin1String &field : fields)
+            {
+                if (o1.value(field) != o2.value(field)) { return false; }
+            }
+            return true;
+        }
+    }
+
+    bool CVatsimDataFileClients::Changes::hasPilotChanges() const
+    {
+        return !addedAircraft.isEmpty() || !changedAircraft.isEmpty() || !removedAircraft.isEmpty();
+    }
+
+    bool CVatsimDataFileClients::Changes::hasControllerChanges() const
+    {
+        return !addedStations.isEmpty() || !changedStations.isEmpty() || !removedStations.isEmpty();
+    }
+
+    void CVatsimDataFileClients::beginFile()
+    {
+        m_newPilotEntries.clear();
+        m_newControllerEntries.clear();
+        m_newAircraft.clear();
+        m_newAtcStations.clear();
+        m_newFlightPlanRemarks.clear();
+        m_changes = {};
+    }
+
+    void CVatsimDataFileClients::insertPilot(const QJsonObject &pilot, QStringList &o_illegalEquipmentCodes)
+    {
+        const QString callsign = pilot["callsign"].toString();
+        const auto previous = m_pilotEntries.constFind(callsign);
+        const bool isNew = previous == m_pilotEntries.constEnd();
+        PilotEntry entry;
+        if (!isNew && isSamePilotData(previous->json, pilot))
+        {
+            // only the live fields changed
+            entry = previous.value();
+            if (entry.json != pilot)
+            {
+                entry.json = pilot;
+                entry.aircraft.setSituation(parsePilotSituation(pilot, entry.aircraft.getCallsign()));
+                entry.aircraft.setTransponderCode(pilot["transponder"].toString().toInt());
+            }
+        }
+        else
+        {
+            entry.json = pilot;
+            entry.aircraft = parsePilot(pilot, o_illegalEquipmentCodes);
+            entry.remarks = parseFlightPlanRemarks(pilot);
+            if (isNew) { m_changes.addedAircraft.push_back(entry.aircraft); }
+            else       { m_changes.changedAircraft.push_back(entry.aircraft); }
+            if (isNew || previous->remarks.getRemarks() != entry.remarks.getRemarks()) { m_changes.changedRemarks.insert(entry.aircraft.getCallsign()); }
+        }
+        m_newAircraft.push_back(entry.aircraft);
+        m_newFlightPlanRemarks.insert(entry.aircraft.getCallsign(), entry.remarks);
+        m_newPilotEntries.insert(callsign, entry);
+    }
+
+    void CVatsimDataFileClients::insertController(const QJsonObject &controller)
+    {
+        const QString callsign = controller["callsign"].toString();
+        const auto previous = m_controllerEntries.constFind(callsign);
+        const bool isNew = previous == m_controllerEntries.constEnd();
+        ControllerEntry entry;
+        if (!isNew && isSameControllerData(previous->json, controller))
+        {
+            entry = previous.value();
+        }
+        else
+        {
+            entry.json = controller;
+            entry.station = parseController(controller);
+            if (isNew) { m_changes.addedStations.push_back(entry.station); }
+            else       { m_changes.changedStations.push_back(entry.station); }
+        }
+        m_newAtcStations.push_back(entry.station);
+        m_newControllerEntries.insert(callsign, entry);
+    }
+
+    CVatsimDataFileClients::Changes CVatsimDataFileClients::endFile()
+    {
+        for (auto it = m_pilotEntries.cbegin(); it != m_pilotEntries.cend(); ++it)
+        {
+            if (m_newPilotEntries.contains(it.key())) { continue; }
+            m_changes.removedAircraft.insert(it->aircraft.getCallsign());
+            m_changes.changedRemarks.insert(it->aircraft.getCallsign());
+        }
+        for (auto it = m_controllerEntries.cbegin(); it != m_controllerEntries.cend(); ++it)
+        {
+            if (!m_newControllerEntries.contains(it.key())) { m_changes.removedStations.insert(it->station.getCallsign()); }
+        }
+
+        m_pilotEntries.swap(m_newPilotEntries);
+        m_controllerEntries.swap(m_newControllerEntries);
+        m_aircraft.swap(m_newAircraft);
+        m_atcStations.swap(m_newAtcStations);
+        m_flightPlanRemarks.swap(m_newFlightPlanRemarks);
+        const Changes changes = m_changes;
+        this->beginFile(); // release the previous file
+        return changes;
+    }
+
+    bool CVatsimDataFileClients::isSamePilotData(const QJsonObject &pilot1, const QJsonObject &pilot2)
+    {
+        if (!equalFields(pilot1, pilot2, { QLatin1String("cid"), QLatin1String("name") })) { return false; }
+        const QJsonObject fp1 = pilot1["flight_plan"].toObject();
+        const QJsonObject fp2 = pilot2["flight_plan"].toObject();
+        return equalFields(fp1, fp2, { QLatin1String("aircraft"), QLatin1String("remarks") });
+    }
+
+    bool CVatsimDataFileClients::isSameControllerData(const QJsonObject &controller1, const QJsonObject &controller2)
+    {
+        return equalFields(controller1, controller2, { QLatin1String("cid"), QLatin1String("name"), QLatin1String("frequency"), QLatin1String("visual_range"), QLatin1String("text_atis") });
+    }
+
+    CSimulatedAircraft CVatsimDataFileClients::parsePilot(const QJsonObject &pilot, QStringList &o_illegalEquipmentCodes)
+    {
+        const CCallsign callsign(pilot["callsign"].toString());
+        const CUser user(pilot["cid"].toString(), pilot["name"].toString(), callsign);
+        CSimulatedAircraft aircraft(callsign, user, parsePilotSituation(pilot, callsign));
+        const QString icaoAndEquipment(pilot["flight_plan"]["aircraft"].toString().trimmed());
+        const QString icao(CFlightPlan::aircraftIcaoCodeFromEquipmentCode(icaoAndEquipment));
+        if (CAircraftIcaoCode::isValidDesignator(icao))
+        {
+            aircraft.setAircraftIcaoCode(icao);
+        }
+        else if (!icaoAndEquipment.isEmpty())
+        {
+            o_illegalEquipmentCodes.push_back(icaoAndEquipment);
+        }
+        aircraft.setTransponderCode(pilot["transponder"].toString().toInt());
+        return aircraft;
+    }
+
+    CAircraftSituation CVatsimDataFileClients::parsePilotSituation(const QJsonObject &pilot, const CCallsign &callsign)
+    {
+        const CCoordinateGeodetic position(pilot["latitude"].toDouble(), pilot["longitude"].toDouble(), pilot["altitude"].toInt());
+        const CHeading heading(pilot["heading"].toInt(), CAngleUnit::deg());
+        const CSpeed groundspeed(pilot["groundspeed"].toInt(), CSpeedUnit::kts());
+        return CAircraftSituation(callsign, position, heading, {}, {}, groundspeed);
+    }
+
+    CFlightPlanRemarks CVatsimDataFileClients::parseFlightPlanRemarks(const QJsonObject &pilot)
+    {
+        return CFlightPlanRemarks(pilot["flight_plan"]["remarks"].toString().trimmed());
+    }
+
+    CAtcStation CVatsimDataFileClients::parseController(const QJsonObject &controller)
+    {
+        const CCallsign callsign(controller["callsign"].toString());
+        const CUser user(controller["cid"].toString(), controller["name"].toString(), callsign);
+        const CFrequency freq(controller["frequency"].toString().toDouble(), CFrequencyUnit::kHz());
+        const CLength range(controller["visual_range"].toInt(), CLengthUnit::NM());
+        const QJsonArray atisLines = controller["text_atis"].toArray();
+        const auto atisText = makeRange(atisLines).transform([](auto line) { return line.toString(); });
+        const CInformationMessage atis(CInformationMessage::ATIS, atisText.to<QStringList>().join('\n'));
+        return CAtcStation(callsign, user, freq, {}, range, true, {}, {}, atis);
+    }
+} // ns
@@ -0,0 +1,126 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_VATSIM_VATSIMDATAFILECLIENTS_H
+#define BLACKCORE_VATSIM_VATSIMDATAFILECLIENTS_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/flightplan.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+namespace BlackCore::Vatsim
+{
+    //! Pilots and controllers (including ATIS) of the VATSIM data file, compared with the previous file
+    //! \remark An entry is only parsed again and reported as changed if data used by the consumers changed
+    //!         (user, aircraft ICAO code, remarks, frequency, range, ATIS). The live fields of a pilot
+    //!         (position, heading, ground speed, transponder) and last_updated change with every file,
+    //!         they are taken over without reporting a change.
+    //! \remark not thread safe, used by the reader thread
+    class BLACKCORE_EXPORT CVatsimDataFileClients
+    {
+    public:
+        //! Changes compared with the previous file
+        struct Changes
+        {
+            BlackMisc::Simulation::CSimulatedAircraftList addedAircraft;   //!< new pilots
+            BlackMisc::Simulation::CSimulatedAircraftList changedAircraft; //!< pilots with changed data
+            BlackMisc::Aviation::CCallsignSet removedAircraft;             //!< pilots no longer in the file
+            BlackMisc::Aviation::CAtcStationList addedStations;            //!< new controllers
+            BlackMisc::Aviation::CAtcStationList changedStations;          //!< controllers with changed data
+            BlackMisc::Aviation::CCallsignSet removedStations;             //!< controllers no longer in the file
+            BlackMisc::Aviation::CCallsignSet changedRemarks;              //!< pilots with added, changed or removed remarks
+
+            //! Any pilot added, changed or removed?
+            bool hasPilotChanges() const;
+
+            //! Any controller added, changed or removed?
+            bool hasControllerChanges() const;
+        };
+
+        //! Start a new file
+        void beginFile();
+
+        //! Pilot of the new file
+        void insertPilot(const QJsonObject &pilot, QStringList &o_illegalEquipmentCodes);
+
+        //! Controller or ATIS of the new file
+        void insertController(const QJsonObject &controller);
+
+        //! End of the new file, it replaces the previous file
+        //! \return changes compared with the previous file
+        Changes endFile();
+
+        //! Aircraft of the last complete file
+        const BlackMisc::Simulation::CSimulatedAircraftList &getAircraft() const { return m_aircraft; }
+
+        //! ATC stations of the last complete file
+        const BlackMisc::Aviation::CAtcStationList &getAtcStations() const { return m_atcStations; }
+
+        //! Flight plan remarks of the last complete file
+        const QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlanRemarks> &getFlightPlanRemarks() const { return m_flightPlanRemarks; }
+
+        //! Same pilot data for the consumers, live fields and last_updated are ignored
+        static bool isSamePilotData(const QJsonObject &pilot1, const QJsonObject &pilot2);
+
+        //! Same controller data for the consumers, last_updated is ignored
+        static bool isSameControllerData(const QJsonObject &controller1, const QJsonObject &controller2);
+
+        //! Parse a pilot
+        static BlackMisc::Simulation::CSimulatedAircraft parsePilot(const QJsonObject &pilot, QStringList &o_illegalEquipmentCodes);
+
+        //! Parse the situation of a pilot (live fields)
+        static BlackMisc::Aviation::CAircraftSituation parsePilotSituation(const QJsonObject &pilot, const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Parse the flight plan remarks of a pilot
+        static BlackMisc::Aviation::CFlightPlanRemarks parseFlightPlanRemarks(const QJsonObject &pilot);
+
+        //! Parse a controller or ATIS
+        static BlackMisc::Aviation::CAtcStation parseController(const QJsonObject &controller);
+
+    private:
+        //! Pilot of a file
+        struct PilotEntry
+        {
+            QJsonObject json;                                   //!< pilot as in file
+            BlackMisc::Simulation::CSimulatedAircraft aircraft; //!< parsed aircraft
+            BlackMisc::Aviation::CFlightPlanRemarks remarks;    //!< parsed remarks
+        };
+
+        //! Controller or ATIS of a file
+        struct ControllerEntry
+        {
+            QJsonObject json;                         //!< controller as in file
+            BlackMisc::Aviation::CAtcStation station; //!< parsed station
+        };
+
+        QHash<QString, PilotEntry> m_pilotEntries;                  //!< pilots of the previous file by callsign
+        QHash<QString, ControllerEntry> m_controllerEntries;        //!< controllers of the previous file by callsign
+        QHash<QString, PilotEntry> m_newPilotEntries;               //!< pilots of the new file
+        QHash<QString, ControllerEntry> m_newControllerEntries;     //!< controllers of the new file
+        Changes m_changes;                                          //!< changes of the new file
+        BlackMisc::Simulation::CSimulatedAircraftList m_aircraft;   //!< aircraft, in file order
+        BlackMisc::Aviation::CAtcStationList m_atcStations;         //!< stations, in file order
+        BlackMisc::Simulation::CSimulatedAircraftList m_newAircraft; //!< aircraft of the new file
+        BlackMisc::Aviation::CAtcStationList m_newAtcStations;      //!< stations of the new file
+        QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlanRemarks> m_flightPlanRemarks;    //!< remarks by callsign
+        QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlanRemarks> m_newFlightPlanRemarks; //!< remarks of the new file
+    };
+} // ns
+
+#endif // guard
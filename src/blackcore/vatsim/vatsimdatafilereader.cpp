@@ -32,6 +32,9 @@
 #include <QStringBuilder>
 #include <QByteArray>
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
 #include <QMetaObject>
 #include <QNetworkReply>
 #include <QReadLocker>
@@ -216,7 +219,7 @@ namespace BlackCore::Vatsim
 
         if (nwReply->error() == QNetworkReply::NoError)
         {
-            const QString dataFileData = nwReply->readAll();
+            const QByteArray dataFileData = nwReply->readAll();
             nwReply->close(); // close asap
 
             if (dataFileData.isEmpty()) { return; }
@@ -225,14 +228,11 @@ namespace BlackCore::Vatsim
                 CLogMessage(this).info(u"VATSIM file '%1' has same content, skipped") << urlString;
                 return;
             }
-            auto jsonDoc = QJsonDocument::fromJson(dataFileData.toUtf8());
+            const QJsonDocument jsonDoc = QJsonDocument::fromJson(dataFileData);
             if (jsonDoc.isEmpty()) { return; }
 
             // build on local vars for thread safety
-            CServerList                         fsdServers;
-            CAtcStationList                     atcStations;
-            CSimulatedAircraftList              aircraft;
-            QMap<CCallsign, CFlightPlanRemarks> flightPlanRemarksMap;
+            CServerList fsdServers;
             auto updateTimestampFromFile = QDateTime::fromString(jsonDoc["general"]["update_timestamp"].toString(), Qt::ISODateWithMs);
 
             const bool alreadyRead = (updateTimestampFromFile == this->getUpdateTimestamp());
@@ -242,34 +242,33 @@ namespace BlackCore::Vatsim
                 return;
             }
 
-            for (QJsonValueRef pilot : jsonDoc["pilots"].toArray())
+            // diff against the previous file, only entries with changed data are parsed again
+            m_clients.beginFile();
+            const QJsonArray pilots = jsonDoc["pilots"].toArray();
+            for (const QJsonValue &value : pilots)
             {
                 if (!this->doWorkCheck())
                 {
                     CLogMessage(this).info(u"Terminated VATSIM file parsing process");
                     return;
                 }
-                aircraft.push_back(parsePilot(pilot.toObject(), illegalEquipmentCodes));
-                flightPlanRemarksMap.insert(aircraft.back().getCallsign(), parseFlightPlanRemarks(pilot.toObject()));
+                m_clients.insertPilot(value.toObject(), illegalEquipmentCodes);
             }
-            for (QJsonValueRef controller : jsonDoc["controllers"].toArray())
-            {
-                if (!this->doWorkCheck())
-                {
-                    CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                    return;
-                }
-                atcStations.push_back(parseController(controller.toObject()));
-            }
-            for (QJsonValueRef atis : jsonDoc["atis"].toArray())
+
+            for (const QString &section : { QStringLiteral("controllers"), QStringLiteral("atis") })
             {
-                if (!this->doWorkCheck())
+                const QJsonArray controllers = jsonDoc[section].toArray();
+                for (const QJsonValue &value : controllers)
                 {
-                    CLogMessage(this).info(u"Terminated VATSIM file parsing process");
-                    return;
+                    if (!this->doWorkCheck())
+                    {
+                        CLogMessage(this).info(u"Terminated VATSIM file parsing process");
+                        return;
+                    }
+                    m_clients.insertController(value.toObject());
                 }
-                atcStations.push_back(parseController(atis.toObject()));
             }
+            const CVatsimDataFileClients::Changes changes = m_clients.endFile();
 
             // Setup for VATSIM servers and sorting for comparison
             fsdServers.sortBy(&CServer::getName, &CServer::getDescription);
@@ -278,9 +277,26 @@ namespace BlackCore::Vatsim
             {
                 QWriteLocker wl(&m_lock);
                 this->setUpdateTimestamp(updateTimestampFromFile);
-                m_aircraft = aircraft;
-                m_atcStations = atcStations;
-                m_flightPlanRemarks = flightPlanRemarksMap;
+                m_aircraft = m_clients.getAircraft();
+                m_atcStations = m_clients.getAtcStations();
+                m_flightPlanRemarks = m_clients.getFlightPlanRemarks();
+            }
+
+            CLogMessage(this).debug(u"VATSIM file: pilots %1 added, %2 changed, %3 removed, controllers %4 added, %5 changed, %6 removed")
+                    << changes.addedAircraft.size() << changes.changedAircraft.size() << changes.removedAircraft.size()
+                    << changes.addedStations.size() << changes.changedStations.size() << changes.removedStations.size();
+
+            if (changes.hasPilotChanges())
+            {
+                emit this->pilotsChanged(changes.addedAircraft, changes.changedAircraft, changes.removedAircraft);
+            }
+            if (changes.hasControllerChanges())
+            {
+                emit this->controllersChanged(changes.addedStations, changes.changedStations, changes.removedStations);
+            }
+            if (!changes.changedRemarks.isEmpty())
+            {
+                emit this->flightPlanRemarksChanged(changes.changedRemarks);
             }
 
             // warnings, if required
@@ -304,46 +320,6 @@ namespace BlackCore::Vatsim
         }
     }
 
-    CSimulatedAircraft CVatsimDataFileReader::parsePilot(const QJsonObject &pilot, QStringList &o_illegalEquipmentCodes) const
-    {
-        const CCallsign callsign(pilot["callsign"].toString());
-        const CUser user(pilot["cid"].toString(), pilot["name"].toString(), callsign);
-        const CCoordinateGeodetic position(pilot["latitude"].toDouble(), pilot["longitude"].toDouble(), pilot["altitude"].toInt());
-        const CHeading heading(pilot["heading"].toInt(), CAngleUnit::deg());
-        const CSpeed groundspeed(pilot["groundspeed"].toInt(), CSpeedUnit::kts());
-        const CAircraftSituation situation(callsign, position, heading, {}, {}, groundspeed);
-        CSimulatedAircraft aircraft(callsign, user, situation);
-        const QString icaoAndEquipment(pilot["flight_plan"]["aircraft"].toString().trimmed());
-        const QString icao(CFlightPlan::aircraftIcaoCodeFromEquipmentCode(icaoAndEquipment));
-        if (CAircraftIcaoCode::isValidDesignator(icao))
-        {
-            aircraft.setAircraftIcaoCode(icao);
-        }
-        else if (!icaoAndEquipment.isEmpty())
-        {
-            o_illegalEquipmentCodes.push_back(icaoAndEquipment);
-        }
-        aircraft.setTransponderCode(pilot["transponder"].toString().toInt());
-        return aircraft;
-    }
-
-    CFlightPlanRemarks CVatsimDataFileReader::parseFlightPlanRemarks(const QJsonObject &pilot) const
-    {
-        return CFlightPlanRemarks(pilot["flight_plan"]["remarks"].toString().trimmed());
-    }
-
-    CAtcStation CVatsimDataFileReader::parseController(const QJsonObject &controller) const
-    {
-        const CCallsign callsign(controller["callsign"].toString());
-        const CUser user(controller["cid"].toString(), controller["name"].toString(), callsign);
-        const CFrequency freq(controller["frequency"].toString().toDouble(), CFrequencyUnit::kHz());
-        const CLength range(controller["visual_range"].toInt(), CLengthUnit::NM());
-        const QJsonArray atisLines = controller["text_atis"].toArray();
-        const auto atisText = makeRange(atisLines).transform([](auto line) { return line.toString(); });
-        const CInformationMessage atis(CInformationMessage::ATIS, atisText.to<QStringList>().join('\n'));
-        return CAtcStation(callsign, user, freq, {}, range, true, {}, {}, atis);
-    }
-
     void CVatsimDataFileReader::reloadSettings()
     {
         CReaderSettings s = m_settings.get();
@@ -13,6 +13,7 @@
 
 #include "blackcore/blackcoreexport.h"
 #include "blackcore/data/vatsimsetup.h"
+#include "blackcore/vatsim/vatsimdatafileclients.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
 #include "blackmisc/aviation/airlineicaocode.h"
 #include "blackmisc/aviation/atcstationlist.h"
@@ -27,6 +28,8 @@
 #include "blackmisc/datacache.h"
 #include "blackcore/threadedreader.h"
 
+#include <QHash>
+#include <QJsonObject>
 #include <QMap>
 #include <QObject>
 #include <QString>
@@ -123,6 +126,19 @@ namespace BlackCore::Vatsim
         //! Data have been read
         void dataRead(BlackMisc::Network::CEntityFlags::Entity entity, BlackMisc::Network::CEntityFlags::ReadState state, int number, const QUrl &url);
 
+        //! Pilots added, changed or removed compared with the previous data file
+        //! \remark emitted before dataFileRead, only if something changed
+        //! \remark changed means changed data, not changed positions, see CVatsimDataFileClients
+        void pilotsChanged(const BlackMisc::Simulation::CSimulatedAircraftList &added, const BlackMisc::Simulation::CSimulatedAircraftList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
+
+        //! Controllers and ATIS added, changed or removed compared with the previous data file
+        //! \remark emitted before dataFileRead, only if something changed
+        void controllersChanged(const BlackMisc::Aviation::CAtcStationList &added, const BlackMisc::Aviation::CAtcStationList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
+
+        //! Flight plan remarks (and hence voice capabilities) of these callsigns were added, changed or removed
+        //! \remark emitted before dataFileRead, only if something changed
+        void flightPlanRemarksChanged(const BlackMisc::Aviation::CCallsignSet &callsigns);
+
     protected:
         //! \name BlackCore::CThreadedReader overrides
         //! @{
@@ -144,14 +160,11 @@ namespace BlackCore::Vatsim
         BlackMisc::Simulation::CSimulatedAircraftList m_aircraft;
         BlackMisc::CSettingReadOnly<BlackCore::Vatsim::TVatsimDataFile> m_settings { this, &CVatsimDataFileReader::reloadSettings };
         QMap<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlanRemarks> m_flightPlanRemarks; //!< cache for flight plan remarks
+        CVatsimDataFileClients m_clients; //!< pilots and controllers of the previous file, only accessed in the reader thread
 
         //! Data have been read, parse VATSIM file
         void parseVatsimFile(QNetworkReply *nwReply);
 
-        BlackMisc::Simulation::CSimulatedAircraft parsePilot(const QJsonObject &, QStringList &o_illegalEquipmentCodes) const;
-        BlackMisc::Aviation::CFlightPlanRemarks parseFlightPlanRemarks(const QJsonObject &) const;
-        BlackMisc::Aviation::CAtcStation parseController(const QJsonObject &) const;
-
         //! Read / re-read data file
         void read();
 
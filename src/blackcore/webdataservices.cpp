@@ -1096,6 +1096,10 @@ namespace BlackCore
             Q_ASSERT_X(c, Q_FUNC_INFO, "VATSIM data reader signals");
             c = connect(m_vatsimDataFileReader, &CVatsimDataFileReader::dataRead, this, &CWebDataServices::dataRead, typeReaderReadSignals);
             Q_ASSERT_X(c, Q_FUNC_INFO, "connect failed VATSIM data file");
+            c = connect(m_vatsimDataFileReader, &CVatsimDataFileReader::pilotsChanged, this, &CWebDataServices::vatsimPilotsChanged, typeReaderReadSignals);
+            Q_ASSERT_X(c, Q_FUNC_INFO, "connect failed VATSIM data file pilots");
+            c = connect(m_vatsimDataFileReader, &CVatsimDataFileReader::controllersChanged, this, &CWebDataServices::vatsimControllersChanged, typeReaderReadSignals);
+            Q_ASSERT_X(c, Q_FUNC_INFO, "connect failed VATSIM data file controllers");
             m_entitiesPeriodicallyRead |= CEntityFlags::VatsimDataFile;
             m_vatsimDataFileReader->start(QThread::LowPriority);
             m_vatsimDataFileReader->startReader();
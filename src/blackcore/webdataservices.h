@@ -18,11 +18,13 @@
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/simulation/distributorlist.h"
 #include "blackmisc/simulation/distributor.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
 #include "blackmisc/aviation/airlineicaocodelist.h"
 #include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/airporticaocode.h"
 #include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/aviation/liverylist.h"
 #include "blackmisc/network/ecosystemprovider.h"
 #include "blackmisc/network/serverlist.h"
@@ -561,6 +563,14 @@ namespace BlackCore
         void swiftDbModelMatchingEntitiesRead();
         //! @}
 
+        //! VATSIM data file pilots added, changed or removed
+        //! \sa BlackCore::Vatsim::CVatsimDataFileReader::pilotsChanged
+        void vatsimPilotsChanged(const BlackMisc::Simulation::CSimulatedAircraftList &added, const BlackMisc::Simulation::CSimulatedAircraftList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
+
+        //! VATSIM data file controllers and ATIS added, changed or removed
+        //! \sa BlackCore::Vatsim::CVatsimDataFileReader::controllersChanged
+        void vatsimControllersChanged(const BlackMisc::Aviation::CAtcStationList &added, const BlackMisc::Aviation::CAtcStationList &changed, const BlackMisc::Aviation::CCallsignSet &removed);
+
     public slots:
         //! Call CWebDataServices::readInBackground by single shot
         void readDeferredInBackground(BlackMisc::Network::CEntityFlags::Entity entities, int delayMs);
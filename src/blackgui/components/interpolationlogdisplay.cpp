@@ -157,10 +157,20 @@ namespace BlackGui::Components
             static const QString updateTimes("%1ms avg: %2ms max: %3ms");
             const QString avgUpdateTimeRounded = QString::number(m_simulator->getStatisticsAverageUpdateTimeMs(), 'f', 2);
 
-            ui->le_UpdateTimes->setText(updateTimes.
-                                        arg(m_simulator->getStatisticsCurrentUpdateTimeMs()).
-                                        arg(avgUpdateTimeRounded).
-                                        arg(m_simulator->getStatisticsMaxUpdateTimeMs()));
+            QString updateTimesText = updateTimes.
+                                      arg(m_simulator->getStatisticsCurrentUpdateTimeMs()).
+                                      arg(avgUpdateTimeRounded).
+                                      arg(m_simulator->getStatisticsMaxUpdateTimeMs());
+            if (m_simulator->getStatisticsCurrentUpdateBytesSent() >= 0)
+            {
+                static const QString updateBytes(" bytes sent: %1 (avg: %2) saved: %3 (avg: %4)");
+                updateTimesText += updateBytes.
+                                   arg(m_simulator->getStatisticsCurrentUpdateBytesSent()).
+                                   arg(QString::number(m_simulator->getStatisticsAverageUpdateBytesSent(), 'f', 0)).
+                                   arg(m_simulator->getStatisticsCurrentUpdateBytesSaved()).
+                                   arg(QString::number(m_simulator->getStatisticsAverageUpdateBytesSaved(), 'f', 0));
+            }
+            ui->le_UpdateTimes->setText(updateTimesText);
             ui->le_UpdateTimes->home(false);
             ui->le_UpdateCount->setText(QString::number(m_simulator->getStatisticsUpdateRuns()));
             ui->le_UpdateReqTime->setText(msTimeStr.arg(m_simulator->getStatisticsAircraftUpdatedRequestedDeltaMs()));
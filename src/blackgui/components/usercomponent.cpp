@@ -12,6 +12,7 @@
 #include "blackgui/views/clientview.h"
 #include "blackgui/views/userview.h"
 #include "blackcore/context/contextnetwork.h"
+#include "blackcore/webdataservices.h"
 #include "blackmisc/network/connectionstatus.h"
 #include "blackmisc/network/userlist.h"
 #include "ui_usercomponent.h"
@@ -42,6 +43,12 @@ namespace BlackGui::Components
         connect(ui->tvp_Clients,  &CClientView::modelDataChangedDigest, this, &CUserComponent::onCountChanged);
         connect(sGui->getIContextNetwork(), &IContextNetwork::connectionStatusChanged, this, &CUserComponent::onConnectionStatusChanged);
         connect(&m_updateTimer, &QTimer::timeout, this, &CUserComponent::update);
+        if (sGui->getWebDataServices())
+        {
+            // users are completed with the VATSIM data file
+            connect(sGui->getWebDataServices(), &CWebDataServices::vatsimPilotsChanged,      this, &CUserComponent::onVatsimDataFileUsersChanged, Qt::QueuedConnection);
+            connect(sGui->getWebDataServices(), &CWebDataServices::vatsimControllersChanged, this, &CUserComponent::onVatsimDataFileUsersChanged, Qt::QueuedConnection);
+        }
         this->onSettingsChanged();
     }
 
@@ -111,6 +118,12 @@ namespace BlackGui::Components
         }
     }
 
+    void CUserComponent::onVatsimDataFileUsersChanged()
+    {
+        if (!m_updateTimer.isActive()) { return; } // not connected
+        this->update();
+    }
+
     void CUserComponent::onSettingsChanged()
     {
         const CViewUpdateSettings settings = m_settings.get();
@@ -60,6 +60,9 @@ namespace BlackGui::Components
         //! Connection status
         void onConnectionStatusChanged(const BlackMisc::Network::CConnectionStatus &from, const BlackMisc::Network::CConnectionStatus &to);
 
+        //! VATSIM data file pilots or controllers changed
+        void onVatsimDataFileUsersChanged();
+
         //! Settings have been changed
         void onSettingsChanged();
 
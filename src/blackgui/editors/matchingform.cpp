@@ -61,6 +61,7 @@ namespace BlackGui::Editors
         CGuiUtility::checkBoxReadOnly(ui->cb_CategoryMilitaryAircraft, readonly);
         CGuiUtility::checkBoxReadOnly(ui->cb_ReverseUseModelString, readonly);
         CGuiUtility::checkBoxReadOnly(ui->cb_ReverseUseSwiftLiveryIds, readonly);
+        CGuiUtility::checkBoxReadOnly(ui->cb_ReverseUseSimilarAirlineNames, readonly);
         CGuiUtility::checkBoxReadOnly(ui->cb_MsReverseLookup, readonly);
         CGuiUtility::checkBoxReadOnly(ui->cb_MsMatching, readonly);
 
@@ -126,6 +127,7 @@ namespace BlackGui::Editors
         ui->cb_ModelSetVerificationOnlyErrorWarning->setChecked(mode.testFlag(CAircraftMatcherSetup::ModelVerificationOnlyWarnError));
         ui->cb_ReverseUseModelString->setChecked(mode.testFlag(CAircraftMatcherSetup::ReverseLookupModelString));
         ui->cb_ReverseUseSwiftLiveryIds->setChecked(mode.testFlag(CAircraftMatcherSetup::ReverseLookupSwiftLiveryIds));
+        ui->cb_ReverseUseSimilarAirlineNames->setChecked(mode.testFlag(CAircraftMatcherSetup::ReverseLookupSimilarAirlineNames));
 
         this->setMatchingAlgorithm(setup);
         this->setPickStrategy(setup);
@@ -196,7 +198,7 @@ namespace BlackGui::Editors
     CAircraftMatcherSetup::MatchingMode CMatchingForm::matchingMode() const
     {
         return CAircraftMatcherSetup::matchingMode(
-                    ui->cb_ReverseUseModelString->isChecked(), ui->cb_ReverseUseSwiftLiveryIds->isChecked(),
+                    ui->cb_ReverseUseModelString->isChecked(), ui->cb_ReverseUseSwiftLiveryIds->isChecked(), ui->cb_ReverseUseSimilarAirlineNames->isChecked(),
                     ui->cb_ByModelString->isChecked(),
                     ui->rb_ByIcaoDataAircraft1st->isChecked(), ui->rb_ByIcaoDataAirline1st->isChecked(),
                     ui->cb_ByFamily->isChecked(), ui->cb_ByLivery->isChecked(),
@@ -11,11 +11,40 @@
 #include "blackmisc/aviation/airlineicaocode.h"
 #include "blackmisc/aviation/livery.h"
 #include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/trigramindex.h"
 
+#include <QMutex>
+#include <QSharedPointer>
+
+using namespace BlackMisc;
 using namespace BlackMisc::Simulation;
 
 namespace BlackGui::Models
 {
+    namespace
+    {
+        //! Model string index of the last filtered container, ids are the positions in the container
+        //! \remark the cached shallow copy shares the data with unchanged containers only, any change detaches them
+        QSharedPointer<const CTrigramIndex> modelStringIndex(const CAircraftModelList &models)
+        {
+            static QMutex mutex;
+            static CAircraftModelList cachedModels;
+            static QSharedPointer<const CTrigramIndex> cachedIndex;
+
+            QMutexLocker l(&mutex);
+            const CAircraftModelList &cached = cachedModels;
+            const bool sameData = cachedIndex && cached.size() == models.size() && (models.isEmpty() || &cached.front() == &models.front());
+            if (!sameData)
+            {
+                QSharedPointer<CTrigramIndex> index = QSharedPointer<CTrigramIndex>::create();
+                for (int id = 0; id < models.sizeInt(); ++id) { index->insert(id, models[id].getModelString()); }
+                cachedModels = models;
+                cachedIndex = index;
+            }
+            return cachedIndex;
+        }
+    }
+
     CAircraftModelFilter::CAircraftModelFilter(int id, const QString &modelKey, const QString &description,
             CAircraftModel::ModelModeFilter modelMode, BlackMisc::Db::DbKeyStateFilter dbKeyFilter,
             Qt::CheckState military, Qt::CheckState colorLiveries,
@@ -43,115 +72,129 @@ namespace BlackGui::Models
     {
         if (!this->isEnabled()) { return inContainer; }
         CAircraftModelList outContainer;
-        for (const CAircraftModel &model : inContainer)
+        if (m_id >= 0)
         {
-            if (m_id >= 0)
+            // search only for id
+            for (const CAircraftModel &model : inContainer)
             {
-                // search only for id
                 if (model.isLoadedFromDb() && model.getDbKey() == m_id)
                 {
                     outContainer.push_back(model);
                     break;
                 }
-                continue;
             }
+            return outContainer;
+        }
 
-            if (!m_simulatorInfo.isAllSimulators())
+        if (!m_modelKey.isEmpty())
+        {
+            // only the models found by the model string index are checked
+            for (int id : modelStringIndex(inContainer)->findByWildcard(m_modelKey))
             {
-                if (!m_simulatorInfo.matchesAny(model.getSimulator())) { continue; }
+                const CAircraftModel &model = inContainer[id];
+                if (this->matchesModel(model)) { outContainer.push_back(model); }
             }
+            return outContainer;
+        }
 
-            if (!m_modelKey.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getModelString(), m_modelKey)) { continue; }
-            }
+        for (const CAircraftModel &model : inContainer)
+        {
+            if (this->matchesModel(model)) { outContainer.push_back(model); }
+        }
+        return outContainer;
+    }
 
-            if (m_military != Qt::PartiallyChecked)
-            {
-                if (m_military == Qt::Checked)
-                {
-                    // military only
-                    if (!model.isMilitary()) { continue; }
-                }
-                else if (m_military == Qt::Unchecked)
-                {
-                    // civilian only
-                    if (model.isMilitary()) { continue; }
-                }
-            }
+    bool CAircraftModelFilter::matchesModel(const CAircraftModel &model) const
+    {
+        if (!m_simulatorInfo.isAllSimulators())
+        {
+            if (!m_simulatorInfo.matchesAny(model.getSimulator())) { return false; }
+        }
 
-            if (m_colorLiveries != Qt::PartiallyChecked)
+        if (m_military != Qt::PartiallyChecked)
+        {
+            if (m_military == Qt::Checked)
             {
-                if (m_colorLiveries == Qt::Checked)
-                {
-                    // only color liveries
-                    if (!model.getLivery().isColorLivery()) { continue; }
-                }
-                else if (m_colorLiveries == Qt::Unchecked)
-                {
-                    // Only airline liveries
-                    if (model.getLivery().isColorLivery()) { continue; }
-                }
+                // military only
+                if (!model.isMilitary()) { return false; }
             }
-
-            if (!m_description.isEmpty())
+            else if (m_military == Qt::Unchecked)
             {
-                if (!this->stringMatchesFilterExpression(model.getDescription(), m_description)) { continue; }
+                // civilian only
+                if (model.isMilitary()) { return false; }
             }
+        }
 
-            if (m_modelMode != CAircraftModel::All && m_modelMode != CAircraftModel::Undefined)
+        if (m_colorLiveries != Qt::PartiallyChecked)
+        {
+            if (m_colorLiveries == Qt::Checked)
             {
-                if (!model.matchesMode(m_modelMode)) { continue; }
+                // only color liveries
+                if (!model.getLivery().isColorLivery()) { return false; }
             }
-
-            if (m_dbKeyFilter != BlackMisc::Db::All && m_dbKeyFilter != BlackMisc::Db::Undefined)
+            else if (m_colorLiveries == Qt::Unchecked)
             {
-                if (!model.matchesDbKeyState(m_dbKeyFilter)) { continue; }
+                // Only airline liveries
+                if (model.getLivery().isColorLivery()) { return false; }
             }
+        }
 
-            if (!m_fileName.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getFileName(), m_fileName)) { continue; }
-            }
+        if (!m_description.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getDescription(), m_description)) { return false; }
+        }
 
-            if (!m_aircraftIcao.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getAircraftIcaoCodeDesignator(), m_aircraftIcao)) { continue; }
-            }
+        if (m_modelMode != CAircraftModel::All && m_modelMode != CAircraftModel::Undefined)
+        {
+            if (!model.matchesMode(m_modelMode)) { return false; }
+        }
 
-            if (!m_aircraftManufacturer.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getAircraftIcaoCode().getManufacturer(), m_aircraftManufacturer)) { continue; }
-            }
+        if (m_dbKeyFilter != BlackMisc::Db::All && m_dbKeyFilter != BlackMisc::Db::Undefined)
+        {
+            if (!model.matchesDbKeyState(m_dbKeyFilter)) { return false; }
+        }
 
-            if (!m_airlineIcao.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getAirlineIcaoCodeDesignator(), m_airlineIcao)) { continue; }
-            }
+        if (!m_fileName.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getFileName(), m_fileName)) { return false; }
+        }
 
-            if (!m_airlineName.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getAirlineIcaoCode().getName(), m_airlineName)) { continue; }
-            }
+        if (!m_aircraftIcao.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getAircraftIcaoCodeDesignator(), m_aircraftIcao)) { return false; }
+        }
 
-            if (!m_liveryCode.isEmpty())
-            {
-                if (!this->stringMatchesFilterExpression(model.getLivery().getCombinedCode(), m_liveryCode)) { continue; }
-            }
+        if (!m_aircraftManufacturer.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getAircraftIcaoCode().getManufacturer(), m_aircraftManufacturer)) { return false; }
+        }
 
-            if (m_distributor.hasValidDbKey())
-            {
-                if (!model.getDistributor().matchesKeyOrAlias(m_distributor)) { continue; }
-            }
+        if (!m_airlineIcao.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getAirlineIcaoCodeDesignator(), m_airlineIcao)) { return false; }
+        }
 
-            if (!m_combinedType.isEmpty())
-            {
-                if (!model.getAircraftIcaoCode().matchesCombinedType(m_combinedType)) { continue; }
-            }
+        if (!m_airlineName.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getAirlineIcaoCode().getName(), m_airlineName)) { return false; }
+        }
 
-            outContainer.push_back(model);
+        if (!m_liveryCode.isEmpty())
+        {
+            if (!this->stringMatchesFilterExpression(model.getLivery().getCombinedCode(), m_liveryCode)) { return false; }
         }
-        return outContainer;
+
+        if (m_distributor.hasValidDbKey())
+        {
+            if (!model.getDistributor().matchesKeyOrAlias(m_distributor)) { return false; }
+        }
+
+        if (!m_combinedType.isEmpty())
+        {
+            if (!model.getAircraftIcaoCode().matchesCombinedType(m_combinedType)) { return false; }
+        }
+
+        return true;
     }
 
     bool CAircraftModelFilter::valid() const
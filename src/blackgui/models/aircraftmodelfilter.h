@@ -62,6 +62,9 @@ namespace BlackGui::Models
         BlackMisc::Simulation::CSimulatorInfo m_simulatorInfo;
         BlackMisc::Simulation::CDistributor   m_distributor;
         bool valid() const;
+
+        //! Model passes all filters except id and model key
+        bool matchesModel(const BlackMisc::Simulation::CAircraftModel &model) const;
     };
 } // namespace
 
@@ -324,12 +324,12 @@ namespace BlackMisc::Aviation
         return { pair.first, pair.second };
     }
 
-    CAircraftIcaoCodeList CAircraftIcaoCodeList::fromDatabaseJson(const QJsonArray &array, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates, CAircraftIcaoCodeList *inconsistent)
+    namespace
     {
-        CAircraftIcaoCodeList codes;
-        for (const QJsonValue &value : array)
+        //! Add code from DB JSON, unless incomplete or duplicate
+        void addFromDatabaseJson(const QJsonObject &json, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates, CAircraftIcaoCodeList *inconsistent, CAircraftIcaoCodeList &codes)
         {
-            CAircraftIcaoCode icao(CAircraftIcaoCode::fromDatabaseJson(value.toObject()));
+            CAircraftIcaoCode icao(CAircraftIcaoCode::fromDatabaseJson(json));
             const int catId = icao.getCategory().getDbKey();
             if (!categories.isEmpty() && catId >= 0)
             {
@@ -342,24 +342,44 @@ namespace BlackMisc::Aviation
 
             if (!icao.hasSpecialDesignator() && !icao.hasCompleteData())
             {
-                if (ignoreIncompleteAndDuplicates) { continue; }
+                if (ignoreIncompleteAndDuplicates) { return; }
                 if (inconsistent)
                 {
                     inconsistent->push_back(icao);
-                    continue;
+                    return;
                 }
             }
             if (icao.isDbDuplicate())
             {
-                if (ignoreIncompleteAndDuplicates) { continue; }
+                if (ignoreIncompleteAndDuplicates) { return; }
                 if (inconsistent)
                 {
                     inconsistent->push_back(icao);
-                    continue;
+                    return;
                 }
             }
             codes.push_back(icao);
         }
+    }
+
+    CAircraftIcaoCodeList CAircraftIcaoCodeList::fromDatabaseJson(const QJsonArray &array, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates, CAircraftIcaoCodeList *inconsistent)
+    {
+        CAircraftIcaoCodeList codes;
+        for (const QJsonValue &value : array)
+        {
+            addFromDatabaseJson(value.toObject(), categories, ignoreIncompleteAndDuplicates, inconsistent, codes);
+        }
+        return codes;
+    }
+
+    CAircraftIcaoCodeList CAircraftIcaoCodeList::fromDatabaseJson(const CJsonArrayStreamReader &elements, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates, CAircraftIcaoCodeList *inconsistent)
+    {
+        CAircraftIcaoCodeList codes;
+        const int count = elements.getElementCount();
+        for (int i = 0; i < count; ++i)
+        {
+            addFromDatabaseJson(elements.getElement(i), categories, ignoreIncompleteAndDuplicates, inconsistent, codes);
+        }
         return codes;
     }
 
@@ -144,6 +144,9 @@ namespace BlackMisc::Aviation
 
         //! From our database JSON format
         static CAircraftIcaoCodeList fromDatabaseJson(const QJsonArray &array, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates = true, CAircraftIcaoCodeList *inconsistent = nullptr);
+
+        //! From our database JSON format, elements decoded one by one
+        static CAircraftIcaoCodeList fromDatabaseJson(const CJsonArrayStreamReader &elements, const CAircraftCategoryList &categories, bool ignoreIncompleteAndDuplicates = true, CAircraftIcaoCodeList *inconsistent = nullptr);
     };
 } // namespace
 
@@ -13,6 +13,7 @@
 
 #include "blackmisc/timestampobjectlist.h"
 #include "blackmisc/jsonexception.h"
+#include "blackmisc/jsonarraystreamreader.h"
 #include "blackmisc/db/datastore.h"
 #include "blackmisc/setbuilder.h"
 #include "blackmisc/mapbuilder.h"
@@ -359,6 +360,19 @@ namespace BlackMisc::Db
             return container;
         }
 
+        //! From DB JSON array elements, decoded one by one
+        //! \remark Specialized classes might have their own fromDatabaseJson implementation
+        static CONTAINER fromDatabaseJson(const CJsonArrayStreamReader &elements)
+        {
+            CONTAINER container;
+            const int count = elements.getElementCount();
+            for (int i = 0; i < count; ++i)
+            {
+                container.push_back(OBJ::fromDatabaseJson(elements.getElement(i)));
+            }
+            return container;
+        }
+
     protected:
         //! Constructor
         IDatastoreObjectList() = default;
@@ -14,6 +14,7 @@
 #include "blackmisc/blackmiscexport.h"
 #include <QDBusArgument>
 #include <QTextStream>
+#include <type_traits>
 
 namespace BlackMisc
 {
@@ -40,6 +41,24 @@ namespace BlackMisc
             return dBusSignature<ValueObj>(obj).size();
         }
 
+        //! Marshalled size of a DBus basic type, a DBus boolean has 32bit
+        template<typename T>
+        static constexpr int dBusBasicTypeSize()
+        {
+            static_assert(std::is_arithmetic_v<T>, "Only basic types have a fixed size");
+            return std::is_same_v<T, bool> ? 4 : static_cast<int>(sizeof(T));
+        }
+
+        //! Marshalled size of one element of each list, without alignment padding
+        template<typename... Lists>
+        static constexpr int dBusElementSize()
+        {
+            return (dBusBasicTypeSize<typename Lists::value_type>() + ... + 0);
+        }
+
+        //! Marshalled size of a DBus string, length, UTF-8 and terminating NUL
+        static int dBusStringSize(const QString &string) { return 4 + string.toUtf8().size() + 1; }
+
         //! Type as string
         static QString dbusTypeAsString(QDBusArgument::ElementType type);
 
@@ -0,0 +1,113 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/fileindex.h"
+#include "blackmisc/fileutils.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace BlackMisc
+{
+    CFileIndex::FileState CFileIndex::checkFile(const QFileInfo &fileInfo, QByteArray &content, bool compareContent) const
+    {
+        const Entry *entry = this->find(fileInfo.absoluteFilePath());
+        if (!entry) { return NotIndexed; }
+        if (entry->lastModifiedMs == fileInfo.lastModified().toMSecsSinceEpoch() && entry->size == fileInfo.size()) { return Unchanged; }
+        if (!compareContent) { return Changed; }
+
+        QFile file(fileInfo.absoluteFilePath());
+        if (!file.open(QIODevice::ReadOnly)) { return Changed; }
+        content = file.readAll();
+        return contentHash(content) == entry->hash ? UnchangedContent : Changed;
+    }
+
+    const CFileIndex::Entry *CFileIndex::find(const QString &path) const
+    {
+        const auto it = m_entries.constFind(path);
+        return it == m_entries.constEnd() ? nullptr : &it.value();
+    }
+
+    CFileIndex::Entry CFileIndex::createEntry(const QFileInfo &fileInfo, const QByteArray &content, const QJsonObject &data)
+    {
+        Entry entry;
+        entry.lastModifiedMs = fileInfo.lastModified().toMSecsSinceEpoch();
+        entry.size = fileInfo.size();
+        entry.hash = contentHash(content);
+        entry.data = data;
+        return entry;
+    }
+
+    int CFileIndex::retainOnly(const QSet<QString> &paths)
+    {
+        int removed = 0;
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (paths.contains(it.key())) { ++it; continue; }
+            it = m_entries.erase(it);
+            removed++;
+        }
+        return removed;
+    }
+
+    bool CFileIndex::load(const QString &fileName)
+    {
+        m_entries.clear();
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) { return false; }
+
+        const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+        if (json.value("version").toInt() != Version) { return false; }
+
+        const QJsonArray files = json.value("files").toArray();
+        for (const QJsonValue &value : files)
+        {
+            const QJsonObject f = value.toObject();
+            const QString path = f.value("path").toString();
+            if (path.isEmpty()) { continue; }
+            Entry entry;
+            entry.lastModifiedMs = static_cast<qint64>(f.value("mtime").toDouble(-1));
+            entry.size = static_cast<qint64>(f.value("size").toDouble(-1));
+            entry.hash = f.value("hash").toString().toLatin1();
+            entry.data = f.value("data").toObject();
+            m_entries.insert(path, entry);
+        }
+        return true;
+    }
+
+    bool CFileIndex::save(const QString &fileName) const
+    {
+        QJsonArray files;
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+        {
+            QJsonObject f;
+            f.insert("path", it.key());
+            f.insert("mtime", static_cast<double>(it->lastModifiedMs)); // exact up to 2^53
+            f.insert("size", static_cast<double>(it->size));
+            f.insert("hash", QString::fromLatin1(it->hash));
+            f.insert("data", it->data);
+            files.append(f);
+        }
+        QJsonObject json;
+        json.insert("version", Version);
+        json.insert("files", files);
+
+        const QFileInfo fi(fileName);
+        if (!QDir().mkpath(fi.absolutePath())) { return false; }
+        return CFileUtils::writeByteArrayToFile(QJsonDocument(json).toJson(QJsonDocument::Compact), fileName);
+    }
+
+    QByteArray CFileIndex::contentHash(const QByteArray &content)
+    {
+        return QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex();
+    }
+} // ns
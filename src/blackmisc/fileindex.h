@@ -0,0 +1,99 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_FILEINDEX_H
+#define BLACKMISC_FILEINDEX_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+
+namespace BlackMisc
+{
+    /*!
+     * Index of files (path, modification time, size, content hash) with data derived from each file.
+     * Used by the model loaders to re-parse only files which changed since the last scan.
+     * \remark a file counts as unchanged if time and size are the same, or if they differ but the content hash is the same
+     * \remark not thread safe, but const functions can be used from multiple threads as long as the index is not modified
+     */
+    class BLACKMISC_EXPORT CFileIndex
+    {
+    public:
+        //! Indexed file
+        struct Entry
+        {
+            qint64 lastModifiedMs = -1; //!< file modification time
+            qint64 size = -1;           //!< file size
+            QByteArray hash;            //!< content hash (hex)
+            QJsonObject data;           //!< data derived from the file, e.g. the parsed entries
+        };
+
+        //! State of a file compared with the index
+        enum FileState
+        {
+            NotIndexed,         //!< not in the index
+            Unchanged,          //!< same modification time and size
+            UnchangedContent,   //!< modification time or size changed, but same content
+            Changed             //!< content changed
+        };
+
+        //! Format version of the index file, older files are ignored
+        static constexpr int Version = 1;
+
+        //! Compare file with the index
+        //! \remark the content is only read if time or size changed, then it is returned in content so it does not need to be read again
+        //! \remark with compareContent=false the content is never read, any change of time or size means Changed
+        FileState checkFile(const QFileInfo &fileInfo, QByteArray &content, bool compareContent = true) const;
+
+        //! Unchanged (by time/size or content)?
+        static bool isUnchanged(FileState state) { return state == Unchanged || state == UnchangedContent; }
+
+        //! Entry for path, nullptr if not indexed
+        const Entry *find(const QString &path) const;
+
+        //! Create an entry for a file
+        static Entry createEntry(const QFileInfo &fileInfo, const QByteArray &content, const QJsonObject &data);
+
+        //! Add or replace an entry
+        void insert(const QString &path, const Entry &entry) { m_entries.insert(path, entry); }
+
+        //! Remove all entries whose path is not in paths (deleted files)
+        //! \return number of removed entries
+        int retainOnly(const QSet<QString> &paths);
+
+        //! Number of indexed files
+        int size() const { return m_entries.size(); }
+
+        //! Empty?
+        bool isEmpty() const { return m_entries.isEmpty(); }
+
+        //! Remove all entries
+        void clear() { m_entries.clear(); }
+
+        //! Load from file, an invalid or outdated file results in an empty index
+        bool load(const QString &fileName);
+
+        //! Save to file
+        bool save(const QString &fileName) const;
+
+        //! Content hash as used by the index
+        static QByteArray contentHash(const QByteArray &content);
+
+    private:
+        QHash<QString, Entry> m_entries; //!< entries by path
+    };
+} // ns
+
+#endif // guard
@@ -0,0 +1,500 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/geo/elevationtilecache.h"
+#include "blackmisc/geo/geospatialindex.h"
+#include "blackmisc/aviation/altitude.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Geo
+{
+    namespace
+    {
+        //! File format
+        constexpr quint32 FileMagic   = 0x454c5654; // "ELVT"
+        constexpr qint32  FileVersion = 1;
+
+        //! Tiles per row, 1deg
+        constexpr int TileColumns = 360;
+
+        //! Squared distance of normal vectors
+        double distanceSquared(const std::array<double, 3> &a, const std::array<double, 3> &b)
+        {
+            const double dx = a[0] - b[0];
+            const double dy = a[1] - b[1];
+            const double dz = a[2] - b[2];
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        //! Longitude in -180..180 (180 excluded)
+        double normalizedLongitude(double lngDeg)
+        {
+            double lng = std::fmod(lngDeg + 180.0, 360.0);
+            if (lng < 0) { lng += 360.0; }
+            return lng - 180.0;
+        }
+
+        //! Tile column of a column which might be outside -180..179
+        int normalizedColumn(int column)
+        {
+            return ((column + 180) % TileColumns + TileColumns) % TileColumns - 180;
+        }
+    }
+
+    bool CElevationTileCache::insert(const ICoordinateGeodetic &elevation, bool onGround, qint64 timestampMs, int hits)
+    {
+        if (elevation.isNull() || !elevation.hasMSLGeodeticHeight()) { return false; }
+
+        Entry entry;
+        entry.coordinate = CCoordinateGeodetic(elevation);
+        entry.normalVector = elevation.normalVectorDouble();
+        entry.latDeg = elevation.latitude().value(CAngleUnit::deg());
+        entry.lngDeg = normalizedLongitude(elevation.longitude().value(CAngleUnit::deg()));
+        entry.lastUsedMs = qMax<qint64>(0, timestampMs);
+        entry.hits = hits;
+        entry.onGround = onGround;
+        entry.isUsed = true;
+
+        const int key = tileKey(entry.latDeg, entry.lngDeg);
+        Tile &t = this->tile(key);
+        int index;
+        if (t.freeEntries.empty())
+        {
+            index = static_cast<int>(t.entries.size());
+            t.entries.push_back(std::move(entry));
+        }
+        else
+        {
+            index = t.freeEntries.back();
+            t.freeEntries.pop_back();
+            t.entries[static_cast<std::size_t>(index)] = std::move(entry);
+        }
+        this->insertIntoNode(t, 0, 0, index);
+        this->linkLru(t, key, index);
+
+        const int c = category(onGround);
+        t.counts[c]++;
+        m_counts[c]++;
+        return true;
+    }
+
+    CCoordinateGeodetic CElevationTileCache::findClosestWithinRange(const ICoordinateGeodetic &reference, const CLength &range, Key *key) const
+    {
+        Key closest;
+        double closestDistance = std::numeric_limits<double>::max();
+        this->visitWithinRange(reference, range, [&](int tile, int entry, double ds)
+        {
+            if (ds >= closestDistance) { return; }
+            closestDistance = ds;
+            closest = { tile, entry };
+        });
+
+        if (key) { *key = closest; }
+        if (closest.tile < 0) { return {}; }
+        return m_tiles.find(closest.tile)->entries[static_cast<std::size_t>(closest.entry)].coordinate;
+    }
+
+    CCoordinateGeodeticList CElevationTileCache::findWithinRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGroundOnly) const
+    {
+        std::vector<std::pair<double, const Entry *>> found;
+        this->visitWithinRange(reference, range, [&](int tile, int entry, double ds)
+        {
+            const Entry &e = m_tiles.find(tile)->entries[static_cast<std::size_t>(entry)];
+            if (onGroundOnly && !e.onGround) { return; }
+            found.emplace_back(ds, &e);
+        });
+        std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        CCoordinateGeodeticList coordinates;
+        coordinates.reserve(static_cast<int>(found.size()));
+        for (const auto &f : found) { coordinates.push_back(f.second->coordinate); }
+        return coordinates;
+    }
+
+    void CElevationTileCache::touch(const Key &key, qint64 timestampMs)
+    {
+        auto it = m_tiles.find(key.tile);
+        if (it == m_tiles.end() || key.entry < 0 || key.entry >= static_cast<int>(it->entries.size())) { return; }
+        Entry &e = it->entries[static_cast<std::size_t>(key.entry)];
+        if (!e.isUsed) { return; }
+        e.hits++;
+
+        // most recently used now
+        this->unlinkLru(*it, key.tile, key.entry);
+        it->entries[static_cast<std::size_t>(key.entry)].lastUsedMs = qMax<qint64>(0, timestampMs);
+        this->linkLru(*it, key.tile, key.entry);
+    }
+
+    bool CElevationTileCache::isOnGround(const Key &key) const
+    {
+        const auto it = m_tiles.constFind(key.tile);
+        if (it == m_tiles.constEnd() || key.entry < 0 || key.entry >= static_cast<int>(it->entries.size())) { return false; }
+        const Entry &e = it->entries[static_cast<std::size_t>(key.entry)];
+        return e.isUsed && e.onGround;
+    }
+
+    int CElevationTileCache::evict(int maxElevations, int maxElevationsOnGround)
+    {
+        int evicted = 0;
+        for (const int c : { 0, 1 })
+        {
+            const int max = qMax(0, c == 1 ? maxElevationsOnGround : maxElevations);
+            while (m_counts[c] > max && !m_tileLru[c].empty())
+            {
+                // least recently used elevation of the least recently used tile
+                const int key = m_tileLru[c].begin()->second;
+                const auto it = m_tiles.find(key);
+                this->removeEntry(*it, key, it->lruHead[c]);
+                if (it->counts[0] + it->counts[1] < 1) { m_tiles.erase(it); }
+                evicted++;
+            }
+        }
+        return evicted;
+    }
+
+    int CElevationTileCache::removeWithinRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGround)
+    {
+        if (reference.isNull()) { return 0; }
+        const double maxDistanceSquared = CGeoSpatialIndex::chordSquared(range);
+        if (maxDistanceSquared < 0) { return 0; }
+        const std::array<double, 3> v = reference.normalVectorDouble();
+        return this->removeIf([&](const Entry &e)
+        {
+            return e.onGround == onGround && distanceSquared(e.normalVector, v) <= maxDistanceSquared;
+        });
+    }
+
+    int CElevationTileCache::removeOutsideRange(const ICoordinateGeodetic &reference, const CLength &range, bool onGround)
+    {
+        if (reference.isNull()) { return 0; }
+        const double maxDistanceSquared = CGeoSpatialIndex::chordSquared(range);
+        if (maxDistanceSquared < 0) { return 0; }
+        const std::array<double, 3> v = reference.normalVectorDouble();
+        return this->removeIf([&](const Entry &e)
+        {
+            return e.onGround == onGround && distanceSquared(e.normalVector, v) > maxDistanceSquared;
+        });
+    }
+
+    void CElevationTileCache::clear()
+    {
+        m_tiles.clear();
+        m_tileLru[0].clear();
+        m_tileLru[1].clear();
+        m_counts = {{ 0, 0 }};
+    }
+
+    CCoordinateGeodeticList CElevationTileCache::toList(bool onGroundOnly) const
+    {
+        CCoordinateGeodeticList coordinates;
+        coordinates.reserve(onGroundOnly ? this->sizeOnGround() : this->size());
+        for (const Tile &t : m_tiles)
+        {
+            for (const Entry &e : t.entries)
+            {
+                if (!e.isUsed || (onGroundOnly && !e.onGround)) { continue; }
+                coordinates.push_back(e.coordinate);
+            }
+        }
+        return coordinates;
+    }
+
+    bool CElevationTileCache::writeToFile(const QString &fileName, int minHits) const
+    {
+        if (fileName.isEmpty()) { return false; }
+        QSaveFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly)) { return false; }
+
+        qint32 count = 0;
+        for (const Tile &t : m_tiles)
+        {
+            for (const Entry &e : t.entries)
+            {
+                if (e.isUsed && e.onGround && e.hits >= minHits) { count++; }
+            }
+        }
+
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_12);
+        out << FileMagic << FileVersion << count;
+        for (const Tile &t : m_tiles)
+        {
+            for (const Entry &e : t.entries)
+            {
+                if (!e.isUsed || !e.onGround || e.hits < minHits) { continue; }
+                out << e.latDeg << e.lngDeg << e.coordinate.geodeticHeight().value(CLengthUnit::ft()) << static_cast<qint32>(e.hits);
+            }
+        }
+        if (out.status() != QDataStream::Ok)
+        {
+            file.cancelWriting();
+            return false;
+        }
+        return file.commit();
+    }
+
+    int CElevationTileCache::readFromFile(const QString &fileName)
+    {
+        if (fileName.isEmpty()) { return -1; }
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) { return -1; }
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_12);
+        quint32 magic = 0;
+        qint32 version = 0;
+        qint32 count = 0;
+        in >> magic >> version >> count;
+        if (in.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || count < 0) { return -1; }
+
+        int read = 0;
+        for (qint32 i = 0; i < count; ++i)
+        {
+            double latDeg = 0;
+            double lngDeg = 0;
+            double elvFt = 0;
+            qint32 hits = 0;
+            in >> latDeg >> lngDeg >> elvFt >> hits;
+            if (in.status() != QDataStream::Ok) { break; }
+
+            // never used in this session, so evicted first, hits decay unless used again
+            if (this->insert(CCoordinateGeodetic(latDeg, lngDeg, elvFt), true, 0, hits / 2)) { read++; }
+        }
+        return read;
+    }
+
+    int CElevationTileCache::tileKey(double latDeg, double lngDeg)
+    {
+        const int row = qBound(0, static_cast<int>(std::floor(latDeg)) + 90, 179);
+        const int column = normalizedColumn(static_cast<int>(std::floor(lngDeg))) + 180;
+        return row * TileColumns + column;
+    }
+
+    CElevationTileCache::Tile &CElevationTileCache::tile(int key)
+    {
+        auto it = m_tiles.find(key);
+        if (it != m_tiles.end()) { return *it; }
+
+        Node root;
+        root.minLat = key / TileColumns - 90;
+        root.minLng = key % TileColumns - 180;
+        root.maxLat = root.minLat + 1;
+        root.maxLng = root.minLng + 1;
+        Tile t;
+        t.nodes.push_back(std::move(root));
+        return *m_tiles.insert(key, std::move(t));
+    }
+
+    void CElevationTileCache::insertIntoNode(Tile &tile, int node, int depth, int entry)
+    {
+        const Entry &e = tile.entries[static_cast<std::size_t>(entry)];
+        while (tile.nodes[static_cast<std::size_t>(node)].firstChild >= 0)
+        {
+            const Node &n = tile.nodes[static_cast<std::size_t>(node)];
+            const double midLat = (n.minLat + n.maxLat) / 2;
+            const double midLng = (n.minLng + n.maxLng) / 2;
+            node = n.firstChild + (e.latDeg >= midLat ? 2 : 0) + (e.lngDeg >= midLng ? 1 : 0);
+            depth++;
+        }
+
+        tile.nodes[static_cast<std::size_t>(node)].entries.push_back(entry);
+        if (depth >= MaxDepth || static_cast<int>(tile.nodes[static_cast<std::size_t>(node)].entries.size()) <= LeafCapacity) { return; }
+
+        // split the leaf, push_back invalidates node references
+        const Node leaf = tile.nodes[static_cast<std::size_t>(node)];
+        const double midLat = (leaf.minLat + leaf.maxLat) / 2;
+        const double midLng = (leaf.minLng + leaf.maxLng) / 2;
+        const int firstChild = static_cast<int>(tile.nodes.size());
+        for (int c = 0; c < 4; ++c)
+        {
+            Node child;
+            child.minLat = (c & 2) ? midLat : leaf.minLat;
+            child.maxLat = (c & 2) ? leaf.maxLat : midLat;
+            child.minLng = (c & 1) ? midLng : leaf.minLng;
+            child.maxLng = (c & 1) ? leaf.maxLng : midLng;
+            tile.nodes.push_back(std::move(child));
+        }
+        tile.nodes[static_cast<std::size_t>(node)].firstChild = firstChild;
+        tile.nodes[static_cast<std::size_t>(node)].entries.clear();
+        for (int i : leaf.entries) { this->insertIntoNode(tile, node, depth, i); }
+    }
+
+    void CElevationTileCache::removeEntry(Tile &tile, int tileKey, int entry)
+    {
+        if (entry < 0 || entry >= static_cast<int>(tile.entries.size())) { return; }
+        Entry &e = tile.entries[static_cast<std::size_t>(entry)];
+        if (!e.isUsed) { return; }
+        this->unlinkLru(tile, tileKey, entry);
+
+        int node = 0;
+        while (tile.nodes[static_cast<std::size_t>(node)].firstChild >= 0)
+        {
+            const Node &n = tile.nodes[static_cast<std::size_t>(node)];
+            const double midLat = (n.minLat + n.maxLat) / 2;
+            const double midLng = (n.minLng + n.maxLng) / 2;
+            node = n.firstChild + (e.latDeg >= midLat ? 2 : 0) + (e.lngDeg >= midLng ? 1 : 0);
+        }
+        std::vector<int> &leafEntries = tile.nodes[static_cast<std::size_t>(node)].entries;
+        leafEntries.erase(std::remove(leafEntries.begin(), leafEntries.end(), entry), leafEntries.end());
+
+        const int c = category(e.onGround);
+        tile.counts[c]--;
+        m_counts[c]--;
+        e = Entry();
+        tile.freeEntries.push_back(entry);
+    }
+
+    qint64 CElevationTileCache::latestUseMs(const Tile &tile, int category)
+    {
+        const int tail = tile.lruTail[category];
+        return tail < 0 ? -1 : tile.entries[static_cast<std::size_t>(tail)].lastUsedMs;
+    }
+
+    void CElevationTileCache::linkLru(Tile &tile, int tileKey, int entry)
+    {
+        Entry &e = tile.entries[static_cast<std::size_t>(entry)];
+        const int c = category(e.onGround);
+        const qint64 oldLatestUseMs = latestUseMs(tile, c);
+
+        // usually the most recently used, otherwise (e.g. read from file) sorted in from the least recently used
+        int next = -1;
+        if (e.lastUsedMs < oldLatestUseMs)
+        {
+            next = tile.lruHead[c];
+            while (tile.entries[static_cast<std::size_t>(next)].lastUsedMs <= e.lastUsedMs) { next = tile.entries[static_cast<std::size_t>(next)].lruNext; }
+        }
+        const int prev = next < 0 ? tile.lruTail[c] : tile.entries[static_cast<std::size_t>(next)].lruPrev;
+        e.lruPrev = prev;
+        e.lruNext = next;
+        if (prev < 0) { tile.lruHead[c] = entry; } else { tile.entries[static_cast<std::size_t>(prev)].lruNext = entry; }
+        if (next < 0) { tile.lruTail[c] = entry; } else { tile.entries[static_cast<std::size_t>(next)].lruPrev = entry; }
+
+        this->updateTileLru(tileKey, c, oldLatestUseMs, latestUseMs(tile, c));
+    }
+
+    void CElevationTileCache::unlinkLru(Tile &tile, int tileKey, int entry)
+    {
+        Entry &e = tile.entries[static_cast<std::size_t>(entry)];
+        const int c = category(e.onGround);
+        const qint64 oldLatestUseMs = latestUseMs(tile, c);
+
+        if (e.lruPrev < 0) { tile.lruHead[c] = e.lruNext; } else { tile.entries[static_cast<std::size_t>(e.lruPrev)].lruNext = e.lruNext; }
+        if (e.lruNext < 0) { tile.lruTail[c] = e.lruPrev; } else { tile.entries[static_cast<std::size_t>(e.lruNext)].lruPrev = e.lruPrev; }
+        e.lruPrev = -1;
+        e.lruNext = -1;
+
+        this->updateTileLru(tileKey, c, oldLatestUseMs, latestUseMs(tile, c));
+    }
+
+    void CElevationTileCache::updateTileLru(int tileKey, int category, qint64 oldLatestUseMs, qint64 newLatestUseMs)
+    {
+        if (oldLatestUseMs == newLatestUseMs) { return; }
+        if (oldLatestUseMs >= 0) { m_tileLru[category].erase({ oldLatestUseMs, tileKey }); }
+        if (newLatestUseMs >= 0) { m_tileLru[category].insert({ newLatestUseMs, tileKey }); }
+    }
+
+    template <class Visitor>
+    void CElevationTileCache::visitWithinRange(const ICoordinateGeodetic &reference, const CLength &range, Visitor visitor) const
+    {
+        if (reference.isNull() || m_tiles.isEmpty()) { return; }
+        const double maxDistanceSquared = CGeoSpatialIndex::chordSquared(range);
+        if (maxDistanceSquared < 0) { return; }
+
+        // bounding box of the range in degrees
+        constexpr double earthRadiusMeters = 6371000.8; // as in calculateGreatCircleDistance
+        const double angle = range.value(CLengthUnit::m()) / earthRadiusMeters;
+        const double dLat = angle * 180.0 / M_PI;
+        const double latDeg = reference.latitude().value(CAngleUnit::deg());
+        const double lngDeg = normalizedLongitude(reference.longitude().value(CAngleUnit::deg()));
+
+        Bounds bounds;
+        bounds.minLat = latDeg - dLat;
+        bounds.maxLat = latDeg + dLat;
+        bool allLongitudes = bounds.minLat <= -90.0 || bounds.maxLat >= 90.0;
+        double dLng = 180.0;
+        if (!allLongitudes)
+        {
+            // max. longitude difference of a circle not containing a pole
+            const double s = std::sin(angle) / std::cos(latDeg * M_PI / 180.0);
+            allLongitudes = s >= 1.0;
+            if (!allLongitudes) { dLng = std::asin(s) * 180.0 / M_PI; }
+        }
+        bounds.minLng = allLongitudes ? -180.0 : lngDeg - dLng;
+        bounds.maxLng = allLongitudes ?  180.0 : lngDeg + dLng;
+
+        const std::array<double, 3> v = reference.normalVectorDouble();
+        const int firstRow = qBound(0, static_cast<int>(std::floor(bounds.minLat)) + 90, 179);
+        const int lastRow  = qBound(0, static_cast<int>(std::floor(bounds.maxLat)) + 90, 179);
+        const int firstColumn = static_cast<int>(std::floor(bounds.minLng));
+        const int lastColumn  = qMin(static_cast<int>(std::floor(bounds.maxLng)), firstColumn + TileColumns - 1);
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+            {
+                const int normalized = normalizedColumn(column);
+                const int key = row * TileColumns + normalized + 180;
+                const auto it = m_tiles.constFind(key);
+                if (it == m_tiles.constEnd()) { continue; }
+
+                // bounds in the longitudes of the tile if the range crosses the antimeridian
+                const double shift = column - normalized;
+                Bounds tileBounds = bounds;
+                tileBounds.minLng -= shift;
+                tileBounds.maxLng -= shift;
+
+                auto entryVisitor = [&](int entry)
+                {
+                    const double ds = distanceSquared(it->entries[static_cast<std::size_t>(entry)].normalVector, v);
+                    if (ds <= maxDistanceSquared) { visitor(key, entry, ds); }
+                };
+                this->visitNode(*it, 0, tileBounds, entryVisitor);
+            }
+        }
+    }
+
+    template <class Visitor>
+    void CElevationTileCache::visitNode(const Tile &tile, int node, const Bounds &bounds, Visitor &visitor) const
+    {
+        const Node &n = tile.nodes[static_cast<std::size_t>(node)];
+        if (n.maxLat < bounds.minLat || n.minLat > bounds.maxLat || n.maxLng < bounds.minLng || n.minLng > bounds.maxLng) { return; }
+        if (n.firstChild < 0)
+        {
+            for (int entry : n.entries) { visitor(entry); }
+            return;
+        }
+        for (int c = 0; c < 4; ++c) { this->visitNode(tile, n.firstChild + c, bounds, visitor); }
+    }
+
+    template <class Predicate>
+    int CElevationTileCache::removeIf(Predicate predicate)
+    {
+        int removed = 0;
+        for (auto it = m_tiles.begin(); it != m_tiles.end();)
+        {
+            for (int i = 0; i < static_cast<int>(it->entries.size()); ++i)
+            {
+                const Entry &e = it->entries[static_cast<std::size_t>(i)];
+                if (!e.isUsed || !predicate(e)) { continue; }
+                this->removeEntry(*it, it.key(), i);
+                removed++;
+            }
+            if (it->counts[0] + it->counts[1] < 1) { it = m_tiles.erase(it); }
+            else { ++it; }
+        }
+        return removed;
+    }
+} // ns
@@ -0,0 +1,207 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_GEO_ELEVATIONTILECACHE_H
+#define BLACKMISC_GEO_ELEVATIONTILECACHE_H
+
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <array>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc::Geo
+{
+    /*!
+     * Cache of elevations in tiles of 1x1deg, each tile with its own quadtree.
+     *
+     * Lookups only visit the tiles and quadtree nodes overlapping the range, so they are O(log n).
+     * A CGeoSpatialIndex of all elevations is not used, it keeps evicted ids until it is built again.
+     * When the cache is full, the least recently used elevation of the least recently used tile is evicted.
+     * Each tile keeps its elevations in LRU order and the tiles are ordered by their latest use,
+     * so an eviction is O(log tiles). Elevations still in use, like at the departure airport, are kept while the own aircraft moves.
+     * On ground elevations used frequently can be written to a file and read in the next session.
+     * \remark not thread safe, the owner has to lock
+     */
+    class BLACKMISC_EXPORT CElevationTileCache
+    {
+    public:
+        //! Elevation in the cache
+        struct Key
+        {
+            int tile  = -1; //!< tile key
+            int entry = -1; //!< entry in the tile
+        };
+
+        //! Elevations per quadtree leaf before it is split
+        static constexpr int LeafCapacity = 16;
+
+        //! Max. quadtree depth, 1deg / 2^12 is about 27m
+        static constexpr int MaxDepth = 12;
+
+        //! Constructor
+        CElevationTileCache() = default;
+
+        //! Insert an elevation, which needs a MSL height
+        //! \remark timestamp 0 means never used, so it is evicted first
+        bool insert(const ICoordinateGeodetic &elevation, bool onGround, qint64 timestampMs, int hits = 0);
+
+        //! Closest elevation within range, NULL if there is none
+        CCoordinateGeodetic findClosestWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, Key *key = nullptr) const;
+
+        //! Elevations within range, closest first
+        CCoordinateGeodeticList findWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGroundOnly) const;
+
+        //! Elevation is used, for the LRU eviction
+        //! \remark timestamps are expected to increase, older ones are sorted in, which is slower
+        void touch(const Key &key, qint64 timestampMs);
+
+        //! On ground elevation?
+        bool isOnGround(const Key &key) const;
+
+        //! Evict the least recently used elevations until there are max. elevations
+        //! \return number of evicted elevations
+        int evict(int maxElevations, int maxElevationsOnGround);
+
+        //! Remove on ground or not on ground elevations within range
+        int removeWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGround);
+
+        //! Remove on ground or not on ground elevations outside range
+        int removeOutsideRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, bool onGround);
+
+        //! Remove all
+        void clear();
+
+        //! Number of elevations not on ground
+        int sizeNotOnGround() const { return m_counts[0]; }
+
+        //! Number of on ground elevations
+        int sizeOnGround() const { return m_counts[1]; }
+
+        //! Number of elevations
+        int size() const { return m_counts[0] + m_counts[1]; }
+
+        //! Number of tiles
+        int getTileCount() const { return m_tiles.size(); }
+
+        //! All elevations
+        CCoordinateGeodeticList toList(bool onGroundOnly) const;
+
+        //! Write the on ground elevations used at least minHits times
+        //! \remark written to a temporary file first, so an existing file is only replaced by a complete one
+        bool writeToFile(const QString &fileName, int minHits) const;
+
+        //! Read elevations written by writeToFile
+        //! \remark the hits are halved, so elevations not used for some sessions are no longer written
+        //! \return number of elevations read, -1 on error
+        int readFromFile(const QString &fileName);
+
+    private:
+        //! Cached elevation
+        struct Entry
+        {
+            CCoordinateGeodetic coordinate;          //!< elevation
+            std::array<double, 3> normalVector {};   //!< for the distance
+            double latDeg = 0;                       //!< latitude
+            double lngDeg = 0;                       //!< longitude, -180..180
+            qint64 lastUsedMs = 0;                   //!< for the LRU eviction
+            int lruPrev = -1;                        //!< less recently used entry of the same category
+            int lruNext = -1;                        //!< more recently used entry of the same category
+            int hits = 0;                            //!< times used
+            bool onGround = false;                   //!< on ground elevation
+            bool isUsed = false;                     //!< slot in use
+        };
+
+        //! Quadtree node
+        struct Node
+        {
+            double minLat = 0;       //!< bounds
+            double minLng = 0;       //!< bounds
+            double maxLat = 0;       //!< bounds
+            double maxLng = 0;       //!< bounds
+            int firstChild = -1;     //!< 4 children SW, SE, NW, NE, -1 for a leaf
+            std::vector<int> entries; //!< entries of a leaf
+        };
+
+        //! Tile of 1x1deg, the arrays are indexed by category (0 not on ground, 1 on ground)
+        struct Tile
+        {
+            std::vector<Entry> entries;       //!< elevations, unused slots are in freeEntries
+            std::vector<int>   freeEntries;   //!< unused slots
+            std::vector<Node>  nodes;         //!< quadtree, root first
+            std::array<int, 2> lruHead {{ -1, -1 }}; //!< least recently used entry
+            std::array<int, 2> lruTail {{ -1, -1 }}; //!< most recently used entry
+            std::array<int, 2> counts  {{  0,  0 }}; //!< elevations
+        };
+
+        //! Tiles ordered by the latest use of an elevation, (timestamp, tile key)
+        using TileLru = std::set<std::pair<qint64, int>>;
+
+        //! Query area in degrees
+        struct Bounds
+        {
+            double minLat = 0; //!< bounds
+            double minLng = 0; //!< bounds
+            double maxLat = 0; //!< bounds
+            double maxLng = 0; //!< bounds
+        };
+
+        //! Key of the tile containing the position
+        static int tileKey(double latDeg, double lngDeg);
+
+        //! Tile for the key, created if missing
+        Tile &tile(int key);
+
+        //! Insert entry into the quadtree
+        void insertIntoNode(Tile &tile, int node, int depth, int entry);
+
+        //! Remove an entry
+        void removeEntry(Tile &tile, int tileKey, int entry);
+
+        //! Category of the elevations
+        static int category(bool onGround) { return onGround ? 1 : 0; }
+
+        //! Latest use of an elevation of the category in the tile, -1 if there is none
+        static qint64 latestUseMs(const Tile &tile, int category);
+
+        //! Add the entry to the LRU order of its tile
+        void linkLru(Tile &tile, int tileKey, int entry);
+
+        //! Remove the entry from the LRU order of its tile
+        void unlinkLru(Tile &tile, int tileKey, int entry);
+
+        //! Move the tile in m_tileLru after its latest use changed
+        void updateTileLru(int tileKey, int category, qint64 oldLatestUseMs, qint64 newLatestUseMs);
+
+        //! Call visitor(tileKey, entry, distanceSquared) for all entries within range
+        template <class Visitor>
+        void visitWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, Visitor visitor) const;
+
+        //! Visit the entries of the nodes overlapping the bounds
+        template <class Visitor>
+        void visitNode(const Tile &tile, int node, const Bounds &bounds, Visitor &visitor) const;
+
+        //! Remove entries
+        template <class Predicate>
+        int removeIf(Predicate predicate);
+
+        QHash<int, Tile> m_tiles;              //!< tiles by key
+        std::array<TileLru, 2> m_tileLru;      //!< tiles with elevations by category
+        std::array<int, 2> m_counts {{ 0, 0 }}; //!< elevations by category
+    };
+} // ns
+
+#endif // guard
@@ -16,6 +16,7 @@
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/sequence.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/geospatialindex.h"
 
 #include <QList>
 #include <tuple>
@@ -217,6 +218,57 @@ namespace BlackMisc::Geo
             return closest;
         }
 
+        //! Spatial index of this list, the ids are the indexes in the list
+        //! \remark build the index again after the list was modified, appended objects can be added by CGeoSpatialIndex::append
+        CGeoSpatialIndex createSpatialIndex() const
+        {
+            std::vector<CGeoSpatialIndex::Vector> normalVectors;
+            normalVectors.reserve(static_cast<std::size_t>(this->container().size()));
+            for (const OBJ &obj : this->container()) { normalVectors.push_back(obj.normalVectorDouble()); }
+            CGeoSpatialIndex index;
+            index.build(normalVectors);
+            return index;
+        }
+
+        //! All objects still in the index at the same coordinates?
+        //! \remark linear, check once when an index is built or assigned, not with every query
+        bool hasSameCoordinatesAsSpatialIndex(const CGeoSpatialIndex &index) const
+        {
+            if (index.count() != this->container().size()) { return false; }
+            int id = 0;
+            for (const OBJ &obj : this->container())
+            {
+                if (!index.isRemoved(id) && index.normalVector(id) != obj.normalVectorDouble()) { return false; }
+                id++;
+            }
+            return true;
+        }
+
+        //! \name Using a spatial index created by createSpatialIndex
+        //! \remark the caller guarantees that the index was created for this list and kept in sync with it,
+        //!         only a different number of objects is detected and falls back to the linear search,
+        //!         other modifications can be detected once by hasSameCoordinatesAsSpatialIndex
+        //! @{
+        CONTAINER findWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
+        {
+            if (!this->isMatchingSpatialIndex(index)) { return this->findWithinRange(coordinate, range); }
+            return this->fromSpatialIndexIds(index.findWithinRange(coordinate, range));
+        }
+
+        CONTAINER findClosest(const CGeoSpatialIndex &index, int number, const ICoordinateGeodetic &coordinate) const
+        {
+            if (!this->isMatchingSpatialIndex(index)) { return this->findClosest(number, coordinate); }
+            return this->fromSpatialIndexIds(index.findClosest(number, coordinate));
+        }
+
+        OBJ findClosestWithinRange(const CGeoSpatialIndex &index, const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const
+        {
+            if (!this->isMatchingSpatialIndex(index)) { return this->findClosestWithinRange(coordinate, range); }
+            const int id = index.findClosestWithinRange(coordinate, range);
+            return id < 0 ? OBJ() : this->container()[id];
+        }
+        //! @}
+
         //! Sort by distance
         void sortByEuclideanDistanceSquared(const ICoordinateGeodetic &coordinate)
         {
@@ -239,6 +291,21 @@ namespace BlackMisc::Geo
         IGeoObjectList()
         { }
 
+        //! Index created for this list?
+        //! \remark the ids are the list indexes, so only the count is compared, constant time for every query
+        bool isMatchingSpatialIndex(const CGeoSpatialIndex &index) const
+        {
+            return index.count() == this->container().size();
+        }
+
+        //! Objects for the ids of a spatial index
+        CONTAINER fromSpatialIndexIds(const std::vector<int> &ids) const
+        {
+            CONTAINER objects;
+            for (int id : ids) { objects.push_back(this->container()[id]); }
+            return objects;
+        }
+
         //! Container
         const CONTAINER &container() const
         {
@@ -0,0 +1,241 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/geo/geospatialindex.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Geo
+{
+    namespace
+    {
+        //! Null vector?
+        bool isNullVector(const CGeoSpatialIndex::Vector &v)
+        {
+            return v[0] == 0.0 && v[1] == 0.0 && v[2] == 0.0;
+        }
+    }
+
+    void CGeoSpatialIndex::build(const std::vector<Vector> &normalVectors)
+    {
+        m_vectors = normalVectors;
+        m_isRemoved.assign(m_vectors.size(), false);
+        m_removed = 0;
+        for (std::size_t id = 0; id < m_vectors.size(); ++id)
+        {
+            if (!isNullVector(m_vectors[id])) { continue; }
+            m_isRemoved[id] = true;
+            m_removed++;
+        }
+        this->rebuildTree();
+    }
+
+    int CGeoSpatialIndex::append(const Vector &normalVector)
+    {
+        const int id = this->count();
+        m_vectors.push_back(normalVector);
+        if (isNullVector(normalVector))
+        {
+            m_isRemoved.push_back(true);
+            m_removed++;
+            return id;
+        }
+
+        m_isRemoved.push_back(false);
+        m_tail.push_back(id);
+
+        // linear scan of the tail is cheaper than rebuilding for every appended coordinate
+        if (m_tail.size() > 32 + m_tree.size() / 8) { this->rebuildTree(); }
+        return id;
+    }
+
+    int CGeoSpatialIndex::append(const ICoordinateGeodetic &coordinate)
+    {
+        return this->append(coordinate.normalVectorDouble());
+    }
+
+    bool CGeoSpatialIndex::remove(int id)
+    {
+        if (id < 0 || id >= this->count()) { return false; }
+        if (m_isRemoved[static_cast<std::size_t>(id)]) { return false; }
+        m_isRemoved[static_cast<std::size_t>(id)] = true;
+        m_removed++;
+        return true;
+    }
+
+    void CGeoSpatialIndex::clear()
+    {
+        m_vectors.clear();
+        m_isRemoved.clear();
+        m_tree.clear();
+        m_tail.clear();
+        m_removed = 0;
+    }
+
+    std::vector<int> CGeoSpatialIndex::findWithinRange(const ICoordinateGeodetic &coordinate, const CLength &range) const
+    {
+        std::vector<int> ids;
+        if (coordinate.isNull() || this->isEmpty()) { return ids; }
+        const double maxDistanceSquared = chordSquared(range);
+        if (maxDistanceSquared < 0) { return ids; }
+
+        const Vector v = coordinate.normalVectorDouble();
+        this->collectWithin(0, static_cast<int>(m_tree.size()), 0, v, maxDistanceSquared, ids);
+        for (int id : m_tail)
+        {
+            if (m_isRemoved[static_cast<std::size_t>(id)]) { continue; }
+            if (this->distanceSquared(id, v) <= maxDistanceSquared) { ids.push_back(id); }
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<int> CGeoSpatialIndex::findClosest(int number, const ICoordinateGeodetic &coordinate) const
+    {
+        if (number < 1 || coordinate.isNull()) { return {}; }
+        return this->findClosestIds(static_cast<std::size_t>(number), coordinate.normalVectorDouble(), std::numeric_limits<double>::max());
+    }
+
+    int CGeoSpatialIndex::findClosestWithinRange(const ICoordinateGeodetic &coordinate, const CLength &range) const
+    {
+        if (coordinate.isNull()) { return -1; }
+        const double maxDistanceSquared = chordSquared(range);
+        if (maxDistanceSquared < 0) { return -1; }
+        const std::vector<int> ids = this->findClosestIds(1, coordinate.normalVectorDouble(), maxDistanceSquared);
+        return ids.empty() ? -1 : ids.front();
+    }
+
+    double CGeoSpatialIndex::chordSquared(const CLength &range)
+    {
+        if (range.isNull()) { return -1.0; }
+        constexpr double earthRadiusMeters = 6371000.8; // as in calculateGreatCircleDistance
+        const double angle = range.value(CLengthUnit::m()) / earthRadiusMeters;
+        if (angle < 0) { return -1.0; }
+        if (angle >= M_PI) { return 4.0; }
+        const double chord = 2.0 * std::sin(angle / 2.0);
+        return chord * chord;
+    }
+
+    void CGeoSpatialIndex::buildTree(int begin, int end, int depth)
+    {
+        if (end - begin < 2) { return; }
+        const int mid = begin + (end - begin) / 2;
+        const std::size_t axis = static_cast<std::size_t>(depth % 3);
+        std::nth_element(m_tree.begin() + begin, m_tree.begin() + mid, m_tree.begin() + end, [&](int a, int b)
+        {
+            return m_vectors[static_cast<std::size_t>(a)][axis] < m_vectors[static_cast<std::size_t>(b)][axis];
+        });
+        this->buildTree(begin, mid, depth + 1);
+        this->buildTree(mid + 1, end, depth + 1);
+    }
+
+    void CGeoSpatialIndex::rebuildTree()
+    {
+        m_tree.clear();
+        m_tail.clear();
+        m_tree.reserve(static_cast<std::size_t>(this->size()));
+        for (int id = 0; id < this->count(); ++id)
+        {
+            if (!m_isRemoved[static_cast<std::size_t>(id)]) { m_tree.push_back(id); }
+        }
+        this->buildTree(0, static_cast<int>(m_tree.size()), 0);
+    }
+
+    double CGeoSpatialIndex::distanceSquared(int id, const Vector &v) const
+    {
+        const Vector &p = m_vectors[static_cast<std::size_t>(id)];
+        const double dx = p[0] - v[0];
+        const double dy = p[1] - v[1];
+        const double dz = p[2] - v[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    void CGeoSpatialIndex::collectWithin(int begin, int end, int depth, const Vector &v, double maxDistanceSquared, std::vector<int> &ids) const
+    {
+        if (begin >= end) { return; }
+        const int mid = begin + (end - begin) / 2;
+        const int id = m_tree[static_cast<std::size_t>(mid)];
+        if (!m_isRemoved[static_cast<std::size_t>(id)] && this->distanceSquared(id, v) <= maxDistanceSquared) { ids.push_back(id); }
+
+        // left of the node are values <= node, right values >= node
+        const std::size_t axis = static_cast<std::size_t>(depth % 3);
+        const double d = v[axis] - m_vectors[static_cast<std::size_t>(id)][axis];
+        if (d <= 0 || d * d <= maxDistanceSquared) { this->collectWithin(begin, mid, depth + 1, v, maxDistanceSquared, ids); }
+        if (d >= 0 || d * d <= maxDistanceSquared) { this->collectWithin(mid + 1, end, depth + 1, v, maxDistanceSquared, ids); }
+    }
+
+    void CGeoSpatialIndex::collectClosest(int begin, int end, int depth, const Vector &v, std::size_t number, double maxDistanceSquared, std::vector<std::pair<double, int>> &heap) const
+    {
+        if (begin >= end) { return; }
+        const int mid = begin + (end - begin) / 2;
+        const int id = m_tree[static_cast<std::size_t>(mid)];
+        if (!m_isRemoved[static_cast<std::size_t>(id)])
+        {
+            const double ds = this->distanceSquared(id, v);
+            if (ds <= maxDistanceSquared) { pushClosest(ds, id, number, heap); }
+        }
+
+        // the side of the query point first, the other side only if it can contain closer coordinates
+        const std::size_t axis = static_cast<std::size_t>(depth % 3);
+        const double d = v[axis] - m_vectors[static_cast<std::size_t>(id)][axis];
+        if (d < 0)
+        {
+            this->collectClosest(begin, mid, depth + 1, v, number, maxDistanceSquared, heap);
+            if (d * d <= heapRadius(number, heap, maxDistanceSquared)) { this->collectClosest(mid + 1, end, depth + 1, v, number, maxDistanceSquared, heap); }
+        }
+        else
+        {
+            this->collectClosest(mid + 1, end, depth + 1, v, number, maxDistanceSquared, heap);
+            if (d * d <= heapRadius(number, heap, maxDistanceSquared)) { this->collectClosest(begin, mid, depth + 1, v, number, maxDistanceSquared, heap); }
+        }
+    }
+
+    std::vector<int> CGeoSpatialIndex::findClosestIds(std::size_t number, const Vector &v, double maxDistanceSquared) const
+    {
+        std::vector<std::pair<double, int>> heap;
+        heap.reserve(number + 1);
+        for (int id : m_tail)
+        {
+            if (m_isRemoved[static_cast<std::size_t>(id)]) { continue; }
+            const double ds = this->distanceSquared(id, v);
+            if (ds <= maxDistanceSquared) { pushClosest(ds, id, number, heap); }
+        }
+        this->collectClosest(0, static_cast<int>(m_tree.size()), 0, v, number, maxDistanceSquared, heap);
+
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<int> ids;
+        ids.reserve(heap.size());
+        for (const auto &entry : heap) { ids.push_back(entry.second); }
+        return ids;
+    }
+
+    void CGeoSpatialIndex::pushClosest(double distanceSquared, int id, std::size_t number, std::vector<std::pair<double, int>> &heap)
+    {
+        if (heap.size() < number)
+        {
+            heap.emplace_back(distanceSquared, id);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (distanceSquared < heap.front().first)
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = { distanceSquared, id };
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    double CGeoSpatialIndex::heapRadius(std::size_t number, const std::vector<std::pair<double, int>> &heap, double maxDistanceSquared)
+    {
+        return heap.size() < number ? maxDistanceSquared : std::min(heap.front().first, maxDistanceSquared);
+    }
+} // ns
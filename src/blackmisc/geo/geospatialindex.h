@@ -0,0 +1,129 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_GEO_GEOSPATIALINDEX_H
+#define BLACKMISC_GEO_GEOSPATIALINDEX_H
+
+#include "blackmisc/blackmiscexport.h"
+#include "blackmisc/pq/length.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc::Geo
+{
+    class ICoordinateGeodetic;
+
+    /*!
+     * Spatial index of coordinates, a 3D k-d tree on the normal vectors.
+     *
+     * Each coordinate gets an id, with IGeoObjectList::createSpatialIndex the id is the index in the list.
+     * Appended coordinates are scanned linearly until enough are collected to rebuild the tree,
+     * removed coordinates are only flagged, so ids remain valid until the index is built again.
+     * Range checks use the chord length of the great circle distance, k nearest the Euclidean distance of the
+     * normal vectors, like IGeoObjectList.
+     * Suited for lists which rarely change, like the airports. Caches which evict, like the elevations, use
+     * CElevationTileCache instead, as removed ids are kept until the index is built again.
+     * \remark not thread safe, the owner has to lock
+     */
+    class BLACKMISC_EXPORT CGeoSpatialIndex
+    {
+    public:
+        //! Normal vector
+        using Vector = std::array<double, 3>;
+
+        //! Constructor
+        CGeoSpatialIndex() = default;
+
+        //! Build the index, ids are the indexes of the vectors
+        //! \remark null vectors are not indexed, but get an id
+        void build(const std::vector<Vector> &normalVectors);
+
+        //! Append a coordinate
+        //! \return id of the coordinate
+        int append(const Vector &normalVector);
+
+        //! Append a coordinate
+        //! \return id of the coordinate
+        int append(const ICoordinateGeodetic &coordinate);
+
+        //! Remove by id
+        bool remove(int id);
+
+        //! Remove all
+        void clear();
+
+        //! Number of ids, including removed ones
+        int count() const { return static_cast<int>(m_vectors.size()); }
+
+        //! Number of indexed coordinates
+        int size() const { return this->count() - m_removed; }
+
+        //! Empty?
+        bool isEmpty() const { return this->size() < 1; }
+
+        //! Normal vector of id
+        //! \remark id has to be valid
+        const Vector &normalVector(int id) const { return m_vectors[static_cast<std::size_t>(id)]; }
+
+        //! Removed (or null) id?
+        //! \remark id has to be valid
+        bool isRemoved(int id) const { return m_isRemoved[static_cast<std::size_t>(id)]; }
+
+        //! So many coordinates are removed that the owner should build the index again
+        bool isCompactionRecommended() const { return m_removed > 64 && m_removed > this->size(); }
+
+        //! Ids of the coordinates within range, ascending
+        std::vector<int> findWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+        //! Ids of the 0..n closest coordinates, closest first
+        std::vector<int> findClosest(int number, const ICoordinateGeodetic &coordinate) const;
+
+        //! Id of the closest coordinate within range, -1 if there is none
+        int findClosestWithinRange(const ICoordinateGeodetic &coordinate, const PhysicalQuantities::CLength &range) const;
+
+        //! Squared chord length of the normal vectors for a great circle distance
+        static double chordSquared(const PhysicalQuantities::CLength &range);
+
+    private:
+        //! Build the tree for m_tree[begin, end)
+        void buildTree(int begin, int end, int depth);
+
+        //! Rebuild the tree from all ids not removed
+        void rebuildTree();
+
+        //! Squared distance
+        double distanceSquared(int id, const Vector &v) const;
+
+        //! Collect ids within squared distance
+        void collectWithin(int begin, int end, int depth, const Vector &v, double maxDistanceSquared, std::vector<int> &ids) const;
+
+        //! Update closest ids within squared distance, a max.heap of (distance, id)
+        void collectClosest(int begin, int end, int depth, const Vector &v, std::size_t number, double maxDistanceSquared, std::vector<std::pair<double, int>> &heap) const;
+
+        //! Closest ids within squared distance, closest first
+        std::vector<int> findClosestIds(std::size_t number, const Vector &v, double maxDistanceSquared) const;
+
+        //! Add to the max.heap of closest ids
+        static void pushClosest(double distanceSquared, int id, std::size_t number, std::vector<std::pair<double, int>> &heap);
+
+        //! Current search radius of the heap
+        static double heapRadius(std::size_t number, const std::vector<std::pair<double, int>> &heap, double maxDistanceSquared);
+
+        std::vector<Vector> m_vectors;     //!< normal vectors by id
+        std::vector<bool>   m_isRemoved;   //!< removed or null, by id
+        std::vector<int>    m_tree;        //!< ids in k-d tree order, the median of a range is the node
+        std::vector<int>    m_tail;        //!< ids appended after the tree was built, scanned linearly
+        int                 m_removed = 0; //!< removed ids
+    };
+} // ns
+
+#endif // guard
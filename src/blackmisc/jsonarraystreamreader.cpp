@@ -0,0 +1,302 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/jsonarraystreamreader.h"
+
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        bool isJsonWhitespace(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        bool isScalarDelimiter(char c)
+        {
+            return c == ',' || c == ']' || c == '}' || isJsonWhitespace(c);
+        }
+    }
+
+    CJsonArrayStreamReader::CJsonArrayStreamReader(const QString &arrayMember) : m_arrayMember(arrayMember)
+    { }
+
+    void CJsonArrayStreamReader::addData(const QByteArray &data)
+    {
+        if (data.isEmpty() || m_state == Done || m_state == Error) { return; }
+        m_data.append(data);
+        this->scan();
+    }
+
+    CJsonArrayStreamReader CJsonArrayStreamReader::fromData(const QByteArray &data, const QString &arrayMember)
+    {
+        CJsonArrayStreamReader reader(arrayMember);
+        reader.addData(data);
+        return reader;
+    }
+
+    QJsonObject CJsonArrayStreamReader::getElement(int index) const
+    {
+        if (index < 0 || index >= m_elements.size()) { return QJsonObject(); }
+        const QPair<int, int> &element = m_elements[index];
+        if (m_data.at(element.first) != '{') { return QJsonObject(); }
+
+        // raw data avoids copying the element, the document does not keep a reference
+        const QByteArray json = QByteArray::fromRawData(m_data.constData() + element.first, element.second);
+        return QJsonDocument::fromJson(json).object();
+    }
+
+    QJsonValue CJsonArrayStreamReader::getElementValue(int index) const
+    {
+        if (index < 0 || index >= m_elements.size()) { return QJsonValue(); }
+        const QPair<int, int> &element = m_elements[index];
+        const QByteArray json = QByteArray::fromRawData(m_data.constData() + element.first, element.second);
+        return decodeValue(json);
+    }
+
+    QJsonArray CJsonArrayStreamReader::toJsonArray() const
+    {
+        QJsonArray array;
+        for (int i = 0; i < m_elements.size(); ++i)
+        {
+            array.append(this->getElementValue(i));
+        }
+        return array;
+    }
+
+    void CJsonArrayStreamReader::clear()
+    {
+        m_data.clear();
+        m_pos = 0;
+        m_state = ExpectTopLevel;
+        m_topLevelArray = false;
+        m_currentKey.clear();
+        m_elements.clear();
+        m_envelope = QJsonObject();
+        m_errorMessage.clear();
+    }
+
+    void CJsonArrayStreamReader::scan()
+    {
+        while (m_state != Done && m_state != Error)
+        {
+            const int pos = this->skipWhitespace(m_pos);
+            m_pos = pos;
+            if (pos >= m_data.size()) { return; } // wait for more data
+
+            const char c = m_data.at(pos);
+            switch (m_state)
+            {
+            case ExpectTopLevel:
+                if (c == '[')
+                {
+                    m_topLevelArray = true;
+                    m_state = ExpectElement;
+                }
+                else if (c == '{')
+                {
+                    m_state = ExpectKey;
+                }
+                else
+                {
+                    this->setError(QStringLiteral("Expected array or object at %1").arg(pos));
+                    return;
+                }
+                m_pos = pos + 1;
+                break;
+
+            case ExpectKey:
+                if (c == '}')
+                {
+                    m_state = Done;
+                    m_pos = pos + 1;
+                }
+                else if (c == '"')
+                {
+                    const int end = this->stringEnd(pos);
+                    if (end < 0) { return; }
+                    m_currentKey = decodeValue(m_data.mid(pos, end - pos)).toString();
+                    m_state = ExpectColon;
+                    m_pos = end;
+                }
+                else
+                {
+                    this->setError(QStringLiteral("Expected member name at %1").arg(pos));
+                    return;
+                }
+                break;
+
+            case ExpectColon:
+                if (c != ':')
+                {
+                    this->setError(QStringLiteral("Expected ':' at %1").arg(pos));
+                    return;
+                }
+                m_state = ExpectMemberValue;
+                m_pos = pos + 1;
+                break;
+
+            case ExpectMemberValue:
+                if (c == '[' && m_currentKey == m_arrayMember)
+                {
+                    m_state = ExpectElement;
+                    m_pos = pos + 1;
+                }
+                else
+                {
+                    const int end = this->valueEnd(pos);
+                    if (end == -1) { return; }
+                    if (end < 0)
+                    {
+                        this->setError(QStringLiteral("Malformed value of '%1' at %2").arg(m_currentKey).arg(pos));
+                        return;
+                    }
+                    m_envelope.insert(m_currentKey, decodeValue(m_data.mid(pos, end - pos)));
+                    m_state = ExpectMemberSeparator;
+                    m_pos = end;
+                }
+                break;
+
+            case ExpectMemberSeparator:
+                if (c == ',')      { m_state = ExpectKey; }
+                else if (c == '}') { m_state = Done; }
+                else
+                {
+                    this->setError(QStringLiteral("Expected ',' or '}' at %1").arg(pos));
+                    return;
+                }
+                m_pos = pos + 1;
+                break;
+
+            case ExpectElement:
+                if (c == ']')
+                {
+                    this->endOfArray(pos);
+                }
+                else
+                {
+                    const int end = this->valueEnd(pos);
+                    if (end == -1) { return; }
+                    if (end < 0)
+                    {
+                        this->setError(QStringLiteral("Malformed array element at %1").arg(pos));
+                        return;
+                    }
+                    m_elements.push_back({ pos, end - pos });
+                    m_state = ExpectElementSeparator;
+                    m_pos = end;
+                }
+                break;
+
+            case ExpectElementSeparator:
+                if (c == ',')
+                {
+                    m_state = ExpectElement;
+                    m_pos = pos + 1;
+                }
+                else if (c == ']')
+                {
+                    this->endOfArray(pos);
+                }
+                else
+                {
+                    this->setError(QStringLiteral("Expected ',' or ']' at %1").arg(pos));
+                    return;
+                }
+                break;
+
+            default:
+                return;
+            }
+        }
+    }
+
+    void CJsonArrayStreamReader::endOfArray(int pos)
+    {
+        m_state = m_topLevelArray ? Done : ExpectMemberSeparator;
+        m_pos = pos + 1;
+    }
+
+    void CJsonArrayStreamReader::setError(const QString &message)
+    {
+        m_state = Error;
+        m_errorMessage = message;
+    }
+
+    int CJsonArrayStreamReader::skipWhitespace(int pos) const
+    {
+        const int size = m_data.size();
+        while (pos < size && isJsonWhitespace(m_data.at(pos))) { ++pos; }
+        return pos;
+    }
+
+    int CJsonArrayStreamReader::valueEnd(int pos) const
+    {
+        const char first = m_data.at(pos);
+        if (first == '"') { return this->stringEnd(pos); }
+
+        const int size = m_data.size();
+        if (first == '{' || first == '[')
+        {
+            int depth = 0;
+            for (int i = pos; i < size; ++i)
+            {
+                const char c = m_data.at(i);
+                if (c == '"')
+                {
+                    const int end = this->stringEnd(i);
+                    if (end < 0) { return -1; }
+                    i = end - 1;
+                }
+                else if (c == '{' || c == '[') { ++depth; }
+                else if (c == '}' || c == ']')
+                {
+                    if (--depth == 0) { return i + 1; }
+                }
+            }
+            return -1;
+        }
+
+        // number, true, false, null
+        if (first == ':' || first == ',' || first == ']' || first == '}') { return -2; }
+        for (int i = pos; i < size; ++i)
+        {
+            if (isScalarDelimiter(m_data.at(i))) { return i; }
+        }
+        return -1;
+    }
+
+    int CJsonArrayStreamReader::stringEnd(int pos) const
+    {
+        const int size = m_data.size();
+        for (int i = pos + 1; i < size; ++i)
+        {
+            const char c = m_data.at(i);
+            if (c == '\\') { ++i; }
+            else if (c == '"') { return i + 1; }
+        }
+        return -1;
+    }
+
+    QJsonValue CJsonArrayStreamReader::decodeValue(const QByteArray &json)
+    {
+        if (json.startsWith('{'))
+        {
+            return QJsonDocument::fromJson(json).object();
+        }
+
+        // Qt only parses objects and arrays as documents, so wrap scalars
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson('[' + json + ']', &error);
+        if (error.error != QJsonParseError::NoError) { return QJsonValue(); }
+        return doc.array().at(0);
+    }
+} // ns
@@ -0,0 +1,133 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_JSONARRAYSTREAMREADER_H
+#define BLACKMISC_JSONARRAYSTREAMREADER_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    /*!
+     * Incremental reader for a (potentially huge) JSON array, e.g. the entities of a swift DB download.
+     *
+     * Accepts either a top level array, or an object with the array as member ("data" as in the DB responses).
+     * The raw UTF-8 bytes are scanned as they are added, only the positions of the array elements are recorded.
+     * Elements are decoded one by one on access, so no DOM of the whole document is ever built.
+     * All other members of the top level object are decoded and available as envelope (e.g. "latest", "restricted").
+     */
+    class BLACKMISC_EXPORT CJsonArrayStreamReader
+    {
+    public:
+        //! Constructor
+        //! \param arrayMember name of the member holding the array if the top level value is an object
+        explicit CJsonArrayStreamReader(const QString &arrayMember = QStringLiteral("data"));
+
+        //! Add the next chunk of bytes and scan as far as possible
+        void addData(const QByteArray &data);
+
+        //! Reader with all data added
+        static CJsonArrayStreamReader fromData(const QByteArray &data, const QString &arrayMember = QStringLiteral("data"));
+
+        //! Top level value completely read?
+        bool isComplete() const { return m_state == Done; }
+
+        //! Malformed data?
+        bool hasError() const { return m_state == Error; }
+
+        //! Error message if malformed
+        const QString &getErrorMessage() const { return m_errorMessage; }
+
+        //! Top level value is the array itself?
+        bool isTopLevelArray() const { return m_topLevelArray; }
+
+        //! Number of array elements found so far
+        int getElementCount() const { return m_elements.size(); }
+
+        //! No elements?
+        bool isEmpty() const { return m_elements.isEmpty(); }
+
+        //! Element decoded as object
+        //! \remark empty object if the element is no object or malformed
+        QJsonObject getElement(int index) const;
+
+        //! Element decoded as value
+        QJsonValue getElementValue(int index) const;
+
+        //! All elements as DOM array
+        //! \remark defeats the purpose of this class, only for compatibility
+        QJsonArray toJsonArray() const;
+
+        //! Other members of the top level object
+        const QJsonObject &getEnvelope() const { return m_envelope; }
+
+        //! Size of the raw data
+        int getDataSize() const { return m_data.size(); }
+
+        //! Reset, keeps the array member name
+        void clear();
+
+    private:
+        //! Scanner states
+        enum State
+        {
+            ExpectTopLevel,
+            ExpectKey,
+            ExpectColon,
+            ExpectMemberValue,
+            ExpectMemberSeparator,
+            ExpectElement,
+            ExpectElementSeparator,
+            Done,
+            Error
+        };
+
+        //! Scan the added data
+        void scan();
+
+        //! End of the array found
+        void endOfArray(int pos);
+
+        //! Mark as malformed
+        void setError(const QString &message);
+
+        //! First non whitespace position at or after pos
+        int skipWhitespace(int pos) const;
+
+        //! Position after the value starting at pos, -1 if more data is needed, -2 if malformed
+        int valueEnd(int pos) const;
+
+        //! Position after the string starting at pos, -1 if more data is needed
+        int stringEnd(int pos) const;
+
+        //! Decode a single JSON value
+        static QJsonValue decodeValue(const QByteArray &json);
+
+        QString m_arrayMember;                //!< member holding the array
+        QByteArray m_data;                    //!< raw data
+        int m_pos = 0;                        //!< scanner position
+        State m_state = ExpectTopLevel;       //!< scanner state
+        bool m_topLevelArray = false;         //!< top level value is the array
+        QString m_currentKey;                 //!< key of the current top level member
+        QVector<QPair<int, int>> m_elements;  //!< offset and length of the elements
+        QJsonObject m_envelope;               //!< other top level members
+        QString m_errorMessage;               //!< error if malformed
+    };
+} // ns
+
+#endif // guard
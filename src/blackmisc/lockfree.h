@@ -20,10 +20,12 @@
 #include <QString>
 #include <QThread>
 #include <QtGlobal>
+#include <atomic>
 #include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 // http://www.drdobbs.com/lock-free-data-structures/184401865
 // http://en.cppreference.com/w/cpp/memory/shared_ptr/atomic
@@ -308,6 +310,89 @@ namespace BlackMisc
         return { std::forward_as_tuple(vs.uniqueWrite()...) };
     }
 
+    /*!
+     * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+     *
+     * Ring buffer of trivially copyable records, no allocation after construction.
+     * If the queue is full, push() fails and the caller decides whether to drop or use another path.
+     */
+    template <typename T>
+    class LockFreeSpscQueue
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable records");
+
+    public:
+        //! Constructor, capacity is rounded up to a power of 2
+        explicit LockFreeSpscQueue(size_t capacity) : m_buffer(roundUpPowerOf2(capacity)), m_mask(m_buffer.size() - 1) {}
+
+        //! LockFreeSpscQueue cannot be copied or moved.
+        //! @{
+        LockFreeSpscQueue(const LockFreeSpscQueue &) = delete;
+        LockFreeSpscQueue &operator =(const LockFreeSpscQueue &) = delete;
+        //! @}
+
+        //! Append a record, false if the queue is full.
+        //! \remark producer thread only
+        bool push(const T &value)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_headCache > m_mask)
+            {
+                m_headCache = m_head.load(std::memory_order_acquire);
+                if (tail - m_headCache > m_mask) { return false; }
+            }
+            m_buffer[tail & m_mask] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Take the oldest record, false if the queue is empty.
+        //! \remark consumer thread only
+        bool pop(T &value)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) { return false; }
+            value = m_buffer[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Take up to max records in one go, returns the number of records copied to out.
+        //! \remark consumer thread only
+        size_t popBatch(T *out, size_t max)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t available = m_tail.load(std::memory_order_acquire) - head;
+            const size_t n = available < max ? available : max;
+            for (size_t i = 0; i < n; ++i) { out[i] = m_buffer[(head + i) & m_mask]; }
+            m_head.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        //! Number of queued records, only a snapshot if called while the other thread is active.
+        size_t size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+        //! Is empty? Only a snapshot if called while the other thread is active.
+        bool isEmpty() const { return size() == 0; }
+
+        //! Max. number of records
+        size_t capacity() const { return m_buffer.size(); }
+
+    private:
+        static size_t roundUpPowerOf2(size_t n)
+        {
+            size_t p = 2;
+            while (p < n) { p <<= 1; }
+            return p;
+        }
+
+        std::vector<T> m_buffer;
+        const size_t m_mask;
+        alignas(64) std::atomic<size_t> m_head { 0 }; //!< next read, written by consumer
+        alignas(64) std::atomic<size_t> m_tail { 0 }; //!< next write, written by producer
+        size_t m_headCache = 0;                       //!< producer's last seen m_head, avoids touching the consumer's cache line
+    };
+
     /*!
      * Non-member begin() and end() for so LockFree containers can be used in ranged for loops.
      */
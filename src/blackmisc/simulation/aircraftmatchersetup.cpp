@@ -55,6 +55,11 @@ namespace BlackMisc::Simulation
         return this->getMatchingMode().testFlag(ReverseLookupSwiftLiveryIds);
     }
 
+    bool CAircraftMatcherSetup::isReverseLookupSimilarAirlineNames() const
+    {
+        return this->getMatchingMode().testFlag(ReverseLookupSimilarAirlineNames);
+    }
+
     void CAircraftMatcherSetup::resetReverseLookup()
     {
         MatchingMode m = this->getMatchingMode();
@@ -218,6 +223,7 @@ namespace BlackMisc::Simulation
         static const QString categorySmallAircraft("small aircraft categories");
         static const QString revModelString("reverse model lookup");
         static const QString revLiveryIds("reverse livery ids");
+        static const QString revSimilarAirlineNames("reverse similar airline names");
         static const QString agSameAsAirline("group as airline");
         static const QString agIfNoAirline("group if no airline");
 
@@ -225,6 +231,7 @@ namespace BlackMisc::Simulation
         {
         case ReverseLookupModelString:    return revModelString;
         case ReverseLookupSwiftLiveryIds: return revLiveryIds;
+        case ReverseLookupSimilarAirlineNames: return revSimilarAirlineNames;
         case ByModelString:               return ms;
         case ByIcaoData:                  return icao;
         case ByFamily:                    return family;
@@ -260,6 +267,7 @@ namespace BlackMisc::Simulation
         QStringList modes;
         if (mode.testFlag(ReverseLookupModelString))    { modes << modeFlagToString(ReverseLookupModelString); }
         if (mode.testFlag(ReverseLookupSwiftLiveryIds)) { modes << modeFlagToString(ReverseLookupSwiftLiveryIds); }
+        if (mode.testFlag(ReverseLookupSimilarAirlineNames)) { modes << modeFlagToString(ReverseLookupSimilarAirlineNames); }
         if (mode.testFlag(ByModelString))               { modes << modeFlagToString(ByModelString); }
         if (mode.testFlag(ByIcaoData))                  { modes << modeFlagToString(ByIcaoData); }
         if (mode.testFlag(ByIcaoOrderAircraftFirst))    { modes << modeFlagToString(ByIcaoOrderAircraftFirst); }
@@ -333,7 +341,7 @@ namespace BlackMisc::Simulation
     }
 
     CAircraftMatcherSetup::MatchingMode CAircraftMatcherSetup::matchingMode(
-        bool revModelString,    bool revLiveryIds,
+        bool revModelString,    bool revLiveryIds,          bool revSimilarAirlineNames,
         bool byModelString,     bool byIcaoDataAircraft1st, bool byIcaoDataAirline1st, bool byFamily, bool byLivery, bool byCombinedType,
         bool byMilitary,        bool byCivilian,            bool byVtol,
         bool byGliderCategory,  bool byMilitaryCategory,    bool bySmallAircraftCategory,
@@ -366,6 +374,7 @@ namespace BlackMisc::Simulation
         if (modelFailover)              { mode |= ModelFailoverIfNoModelCanBeAdded; }
         if (revModelString)             { mode |= ReverseLookupModelString; }
         if (revLiveryIds)               { mode |= ReverseLookupSwiftLiveryIds; }
+        if (revSimilarAirlineNames)     { mode |= ReverseLookupSimilarAirlineNames; }
         return mode;
     }
 } // namespace
@@ -67,6 +67,7 @@ namespace BlackMisc::Simulation
             // --- reverse lookup ---
             ReverseLookupModelString    = 1 << 25,
             ReverseLookupSwiftLiveryIds = 1 << 26,
+            ReverseLookupSimilarAirlineNames = 1 << 27, //!< use a similar DB airline name or telephony designator if there is no equal one
             ReverseLookupDefault = ReverseLookupModelString | ReverseLookupSwiftLiveryIds,
 
             // --- score based matching ---
@@ -152,6 +153,7 @@ namespace BlackMisc::Simulation
         //! @{
         bool isReverseLookupModelString() const;
         bool isReverseLookupSwiftLiveryIds() const;
+        bool isReverseLookupSimilarAirlineNames() const;
         void resetReverseLookup();
         //! @}
 
@@ -264,7 +266,7 @@ namespace BlackMisc::Simulation
         static const QString &strategyToString(PickSimilarStrategy strategy);
 
         //! Mode by flags
-        static MatchingMode matchingMode(bool revModelString,  bool revLiveryIds,
+        static MatchingMode matchingMode(bool revModelString,  bool revLiveryIds,     bool revSimilarAirlineNames,
                                             bool byModelString,   bool byIcaoDataAircraft1st, bool byIcaoDataAirline1st,
                                             bool byFamily,        bool byLivery,              bool byCombinedType,
                                             bool byForceMilitary, bool byForceCivilian,
@@ -207,7 +207,7 @@ namespace BlackMisc::Simulation
 
             if (!telephony.isEmpty() && (icao.hasTelephonyDesignator() || !onlyIfExistInModel))
             {
-                if (!icao.getTelephonyDesignator().contains(name, Qt::CaseInsensitive)) { return false; }
+                if (!icao.getTelephonyDesignator().contains(telephony, Qt::CaseInsensitive)) { return false; }
             }
             return true;
         });
@@ -1884,6 +1884,28 @@ namespace BlackMisc::Simulation
         return models;
     }
 
+    CAircraftModelList CAircraftModelList::fromDatabaseJsonCaching(
+        const CJsonArrayStreamReader &elements,
+        const CAircraftIcaoCodeList &icaos,
+        const CAircraftCategoryList &categories,
+        const CLiveryList &liveries,
+        const CDistributorList &distributors
+    )
+    {
+        AircraftIcaoIdMap aircraftIcaosMap = icaos.toDbKeyValueMap();
+        LiveryIdMap       liveriesMap = liveries.toDbKeyValueMap();
+        DistributorIdMap  distributorsMap = distributors.toDbKeyValueMap();
+        const AircraftCategoryIdMap categoriesMap = categories.toDbKeyValueMap();
+
+        CAircraftModelList models;
+        const int count = elements.getElementCount();
+        for (int i = 0; i < count; ++i)
+        {
+            models.push_back(CAircraftModel::fromDatabaseJsonCaching(elements.getElement(i), aircraftIcaosMap, categoriesMap, liveriesMap, distributorsMap));
+        }
+        return models;
+    }
+
     const QString &CAircraftModelList::invalidModelFileAndPath()
     {
         static const QString f = CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), "invalidmodels.json");
@@ -567,6 +567,13 @@ namespace BlackMisc
                     const Aviation::CLiveryList &liveries = {},
                     const CDistributorList &distributors = {});
 
+            //! Newer version, elements decoded one by one
+            static CAircraftModelList fromDatabaseJsonCaching(const CJsonArrayStreamReader &elements,
+                    const Aviation::CAircraftIcaoCodeList &aircraftIcaos = {},
+                    const Aviation::CAircraftCategoryList &aircraftCategories = {},
+                    const Aviation::CLiveryList &liveries = {},
+                    const CDistributorList &distributors = {});
+
         private:
             //! Validate UNC paths (Windows)
             CStatusMessageList validateUncFiles(const QSet<QString> &uncFiles) const;
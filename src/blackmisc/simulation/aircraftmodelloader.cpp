@@ -173,7 +173,7 @@ namespace BlackMisc::Simulation
 
     bool IAircraftModelLoader::hasCachedData() const
     {
-        return !this->getCachedModels(m_simulator).isEmpty();
+        return this->getCachedModelsCount(m_simulator) > 0;
     }
 
     void IAircraftModelLoader::setObjectInfo(const CSimulatorInfo &simulatorInfo)
@@ -0,0 +1,428 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+
+#include <numeric>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        //! Sorted ids contain id?
+        bool containsId(const CAircraftModelSetIndex::Ids &sortedIds, int id)
+        {
+            return std::binary_search(sortedIds.cbegin(), sortedIds.cend(), id);
+        }
+
+        //! Add id once, ids are added in ascending order
+        void addId(CAircraftModelSetIndex::Ids &ids, int id)
+        {
+            if (ids.isEmpty() || ids.last() != id) { ids.push_back(id); }
+        }
+
+        //! Letters of the name only, as CAirlineIcaoCode::isContainedInSimplifiedName
+        QString simplifiedName(const QString &name)
+        {
+            QString simplified;
+            for (QChar c : name)
+            {
+                if (c.isLetter()) { simplified.push_back(c); }
+            }
+            return simplified;
+        }
+    }
+
+    CAircraftModelSetIndex::CAircraftModelSetIndex(const CAircraftModelList &models) : m_models(models)
+    {
+        const int count = m_models.sizeInt();
+        for (int id = 0; id < count; ++id)
+        {
+            const CAircraftModel &model = m_models[id];
+            const CAircraftIcaoCode &aircraftIcao = model.getAircraftIcaoCode();
+            const CAirlineIcaoCode &airlineIcao = model.getAirlineIcaoCode();
+
+            if (model.hasModelString()) { addId(m_byModelString[model.getModelString().toCaseFolded()], id); }
+            else { m_withoutModelString.push_back(id); }
+            if (model.hasModelStringAlias()) { addId(m_byModelString[model.getModelStringAlias().toCaseFolded()], id); }
+            if (model.hasAirlineDesignator() && model.hasValidDbKey())
+            {
+                // as CAirlineIcaoCode::matchesNamesOrTelephonyDesignator
+                m_withAirlineAndDbKey.push_back(id);
+                m_airlineNameSearch.insert(id, airlineIcao.getName());
+                m_airlineNameSearch.insert(id, airlineIcao.getTelephonyDesignator());
+                m_airlineNameSearch.insert(id, simplifiedName(airlineIcao.getName()));
+            }
+
+            m_byAircraftDesignator[aircraftIcao.getDesignator()].push_back(id);
+            m_byAirlineDesignator[airlineIcao.getDesignator()].push_back(id);
+            if (airlineIcao.getGroupId() >= 0) { m_byAirlineGroup[airlineIcao.getGroupId()].push_back(id); }
+            if (aircraftIcao.hasFamily()) { m_byFamily[aircraftIcao.getFamily()].push_back(id); }
+            m_byCombinedType[aircraftIcao.getCombinedType()].push_back(id);
+            m_byManufacturer[aircraftIcao.getManufacturer()].push_back(id);
+            if (model.getLivery().hasCombinedCode()) { m_byLiveryCode[model.getLivery().getCombinedCode()].push_back(id); }
+            m_byDistributor[model.getDistributor().getDbKey()].push_back(id);
+
+            if (!model.hasValidDbKey()) { m_withoutDbKey.push_back(id); }
+            if (model.getModelMode() == CAircraftModel::Exclude) { m_excluded.push_back(id); }
+            if (model.isMilitary()) { m_military.push_back(id); }
+            if (model.isVtol()) { m_vtol.push_back(id); }
+        }
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByModelStringOrAlias(const QString &modelString) const
+    {
+        return idsForKey(m_byModelString, modelString.toCaseFolded());
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByAircraftDesignator(const QString &designator) const
+    {
+        return idsForKey(m_byAircraftDesignator, designator);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByAirlineDesignator(const QString &designator) const
+    {
+        return idsForKey(m_byAirlineDesignator, designator);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByAirlineGroup(int groupId) const
+    {
+        static const Ids empty;
+        const auto it = m_byAirlineGroup.constFind(groupId);
+        return it == m_byAirlineGroup.cend() ? empty : it.value();
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByFamily(const QString &family) const
+    {
+        return idsForKey(m_byFamily, family);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByCombinedType(const QString &combinedType) const
+    {
+        return idsForKey(m_byCombinedType, combinedType);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByManufacturer(const QString &manufacturer) const
+    {
+        return idsForKey(m_byManufacturer, manufacturer);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByLiveryCode(const QString &combinedCode) const
+    {
+        return idsForKey(m_byLiveryCode, combinedCode);
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::getIdsByDistributor(const QString &distributorKey) const
+    {
+        return idsForKey(m_byDistributor, distributorKey);
+    }
+
+    int CAircraftModelSetIndex::findFirstIdByModelString(const QString &modelString) const
+    {
+        if (modelString.isEmpty()) { return -1; }
+        for (int id : this->getIdsByModelStringOrAlias(modelString))
+        {
+            if (m_models[id].matchesModelString(modelString, Qt::CaseInsensitive)) { return id; }
+        }
+        return -1;
+    }
+
+    const CAircraftModelSetIndex::Ids &CAircraftModelSetIndex::idsForKey(const QHash<QString, Ids> &index, const QString &key)
+    {
+        static const Ids empty;
+        const auto it = index.constFind(key);
+        return it == index.cend() ? empty : it.value();
+    }
+
+    CAircraftModelSetView::CAircraftModelSetView(const QSharedPointer<const CAircraftModelSetIndex> &index) :
+        m_index(index), m_all(!index.isNull())
+    { }
+
+    CAircraftModelSetView::CAircraftModelSetView(const QSharedPointer<const CAircraftModelSetIndex> &index, const Ids &ids) :
+        m_index(index), m_ids(ids)
+    { }
+
+    CAircraftModelSetView::Ids CAircraftModelSetView::getIds() const
+    {
+        if (!m_all) { return m_ids; }
+        Ids ids(m_index->size());
+        std::iota(ids.begin(), ids.end(), 0);
+        return ids;
+    }
+
+    int CAircraftModelSetView::size() const
+    {
+        if (m_index.isNull()) { return 0; }
+        return m_all ? m_index->size() : m_ids.size();
+    }
+
+    const CAircraftModel &CAircraftModelSetView::front() const
+    {
+        return (*this)[0];
+    }
+
+    const CAircraftModel &CAircraftModelSetView::operator [](int position) const
+    {
+        Q_ASSERT_X(position >= 0 && position < this->size(), Q_FUNC_INFO, "Wrong position");
+        return m_index->modelAt(m_all ? position : m_ids[position]);
+    }
+
+    CAircraftModelList CAircraftModelSetView::toModelList() const
+    {
+        if (m_index.isNull()) { return CAircraftModelList(); }
+        if (m_all) { return m_index->getModels(); }
+        CAircraftModelList models;
+        for (int id : m_ids) { models.push_back(m_index->modelAt(id)); }
+        return models;
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::withModels(const CAircraftModelList &models) const
+    {
+        if (m_index.isNull()) { return CAircraftModelSetView(); }
+        Ids ids;
+        QSet<int> added;
+        for (const CAircraftModel &model : models)
+        {
+            const int id = m_index->findFirstIdByModelString(model.getModelString());
+            if (id < 0 || added.contains(id)) { continue; }
+            added.insert(id);
+            ids.push_back(id);
+        }
+        return CAircraftModelSetView(m_index, ids);
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::unite(const CAircraftModelSetView &other) const
+    {
+        if (m_all || other.isEmpty()) { return *this; }
+        if (this->isEmpty()) { return other; }
+        Q_ASSERT_X(m_index == other.m_index, Q_FUNC_INFO, "Views of different sets");
+
+        Ids ids(m_ids);
+        const QSet<int> contained(m_ids.cbegin(), m_ids.cend());
+        for (int id : other.getIds())
+        {
+            if (!contained.contains(id)) { ids.push_back(id); }
+        }
+        return CAircraftModelSetView(m_index, ids);
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::replacedOrAdded(const CAircraftModelSetView &other) const
+    {
+        if (other.isEmpty()) { return *this; }
+        if (this->isEmpty()) { return other; }
+        Q_ASSERT_X(m_index == other.m_index, Q_FUNC_INFO, "Views of different sets");
+
+        const Ids otherIds = other.getIds();
+        const QSet<int> replaced(otherIds.cbegin(), otherIds.cend());
+        Ids ids;
+        for (int id : this->getIds())
+        {
+            if (!replaced.contains(id)) { ids.push_back(id); }
+        }
+        ids += otherIds;
+        return CAircraftModelSetView(m_index, ids);
+    }
+
+    CAircraftModel CAircraftModelSetView::findFirstByModelStringAliasOrDefault(const QString &modelString, Qt::CaseSensitivity sensitivity) const
+    {
+        if (modelString.isEmpty() || this->isEmpty()) { return CAircraftModel(); }
+        for (int id : this->candidates(m_index->getIdsByModelStringOrAlias(modelString)))
+        {
+            const CAircraftModel &model = m_index->modelAt(id);
+            if (model.matchesModelStringOrAlias(modelString, sensitivity)) { return model; }
+        }
+        return CAircraftModel();
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByIcaoDesignators(const CAircraftIcaoCode &aircraftIcaoCode, const CAirlineIcaoCode &airlineIcaoCode) const
+    {
+        if (this->isEmpty()) { return *this; }
+        const QString &aircraft = aircraftIcaoCode.getDesignator();
+        const QString &airline = airlineIcaoCode.getDesignator();
+        if (airline.isEmpty())
+        {
+            return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByAircraftDesignator(aircraft)));
+        }
+
+        const Ids &airlineIds = m_index->getIdsByAirlineDesignator(airline);
+        if (aircraft.isEmpty())
+        {
+            return CAircraftModelSetView(m_index, this->candidates(airlineIds));
+        }
+
+        Ids ids;
+        for (int id : this->candidates(m_index->getIdsByAircraftDesignator(aircraft)))
+        {
+            if (containsId(airlineIds, id)) { ids.push_back(id); }
+        }
+        return CAircraftModelSetView(m_index, ids);
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const
+    {
+        if (aircraftDesignator.isEmpty() || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+        const Ids ids = this->candidates(m_index->getIdsByAircraftDesignator(aircraftDesignator.trimmed().toUpper()));
+        return this->filtered(ids, [ & ](const CAircraftModel & model)
+        {
+            return model.getLivery().matchesCombinedCode(combinedCode);
+        });
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByAirlineGroup(const CAirlineIcaoCode &airline) const
+    {
+        const int id = airline.getGroupId();
+        if (id < 0 || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByAirlineGroup(id)));
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByFamily(const QString &family) const
+    {
+        if (family.isEmpty() || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByFamily(family.toUpper().trimmed())));
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByCombinedType(const QString &combinedType) const
+    {
+        const QString cc(combinedType.trimmed().toUpper());
+        if (combinedType.length() != 3 || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+
+        // wildcards as in CAircraftIcaoCode::matchesCombinedType can not be looked up
+        const QString exact = QString(cc).replace(' ', '*').replace('-', '*');
+        if (exact.contains('*') || exact.length() != 3)
+        {
+            return this->findBy([ & ](const CAircraftModel & model)
+            {
+                return model.getAircraftIcaoCode().matchesCombinedType(cc);
+            });
+        }
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByCombinedType(exact)));
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByCombinedTypeWithColorLivery(const QString &combinedType) const
+    {
+        return this->findByCombinedType(combinedType).findBy([](const CAircraftModel & model)
+        {
+            return model.getLivery().isColorLivery();
+        });
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByCombinedAndManufacturer(const CAircraftIcaoCode &icao) const
+    {
+        const QString combinedType = icao.getCombinedType();
+        const QString manufacturer = icao.getManufacturer();
+        if (manufacturer.isEmpty()) { return this->findByCombinedType(combinedType); }
+        if (combinedType.isEmpty()) { return this->findByManufacturer(manufacturer); }
+        return this->findByCombinedType(combinedType).findBy([ & ](const CAircraftModel & model)
+        {
+            return model.getAircraftIcaoCode().matchesCombinedTypeAndManufacturer(combinedType, manufacturer);
+        });
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByManufacturer(const QString &manufacturer) const
+    {
+        if (manufacturer.isEmpty() || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByManufacturer(manufacturer.toUpper().trimmed())));
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByLiveryCode(const CLivery &livery) const
+    {
+        if (!livery.hasCombinedCode() || this->isEmpty()) { return CAircraftModelSetView(m_index, {}); }
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsByLiveryCode(livery.getCombinedCode())));
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByDistributor(const CDistributor &distributor) const
+    {
+        if (this->isEmpty()) { return *this; }
+        return this->filtered(this->candidates(m_index->getIdsByDistributor(distributor.getDbKey())), [ & ](const CAircraftModel & model)
+        {
+            return model.getDistributor() == distributor;
+        });
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByMilitaryFlag(bool military) const
+    {
+        if (this->isEmpty()) { return *this; }
+        if (military) { return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsMilitary())); }
+        CAircraftModelSetView civilian(*this);
+        civilian.removeIds(m_index->getIdsMilitary());
+        return civilian;
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByVtolFlag(bool vtol) const
+    {
+        if (this->isEmpty()) { return *this; }
+        if (vtol) { return CAircraftModelSetView(m_index, this->candidates(m_index->getIdsVtol())); }
+        CAircraftModelSetView noVtol(*this);
+        noVtol.removeIds(m_index->getIdsVtol());
+        return noVtol;
+    }
+
+    bool CAircraftModelSetView::containsVtol() const
+    {
+        if (this->isEmpty()) { return false; }
+        const Ids &vtol = m_index->getIdsVtol();
+        if (m_all) { return !vtol.isEmpty(); }
+        return std::any_of(m_ids.cbegin(), m_ids.cend(), [ & ](int id) { return containsId(vtol, id); });
+    }
+
+    CAircraftModelSetView CAircraftModelSetView::findByAirlineNamesOrTelephonyDesignator(const QString &name) const
+    {
+        if (this->isEmpty()) { return *this; }
+        const Ids &withAirline = m_index->getIdsWithAirlineAndDbKey();
+        if (name.trimmed().isEmpty()) { return CAircraftModelSetView(m_index, this->candidates(withAirline)); } // empty name is contained in all names
+        return CAircraftModelSetView(m_index, this->candidates(m_index->getAirlineNameSearch().findContaining(name)));
+    }
+
+    int CAircraftModelSetView::removeAllWithoutModelString()
+    {
+        if (this->isEmpty()) { return 0; }
+        return this->removeIds(m_index->getIdsWithoutModelString());
+    }
+
+    int CAircraftModelSetView::removeObjectsWithoutDbKey()
+    {
+        if (this->isEmpty()) { return 0; }
+        return this->removeIds(m_index->getIdsWithoutDbKey());
+    }
+
+    int CAircraftModelSetView::removeIfExcluded()
+    {
+        if (this->isEmpty()) { return 0; }
+        return this->removeIds(m_index->getIdsExcluded());
+    }
+
+    CAircraftModelSetView::Ids CAircraftModelSetView::candidates(const Ids &sortedIds) const
+    {
+        if (m_all || sortedIds.isEmpty()) { return sortedIds; }
+        Ids ids;
+        for (int id : m_ids)
+        {
+            if (containsId(sortedIds, id)) { ids.push_back(id); }
+        }
+        return ids;
+    }
+
+    int CAircraftModelSetView::removeIds(const Ids &sortedIds)
+    {
+        if (sortedIds.isEmpty()) { return 0; }
+        const Ids current = this->getIds();
+        Ids ids;
+        ids.reserve(current.size());
+        for (int id : current)
+        {
+            if (!containsId(sortedIds, id)) { ids.push_back(id); }
+        }
+        const int removed = current.size() - ids.size();
+        if (removed < 1) { return 0; }
+        m_ids = ids;
+        m_all = false;
+        return removed;
+    }
+} // ns
@@ -0,0 +1,222 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/trigramindex.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+namespace BlackMisc::Simulation
+{
+    /*!
+     * Immutable hash indexes over a model set, built once and shared by all CAircraftModelSetView objects.
+     * Ids are the positions of the models in the set, all id lists are sorted ascending.
+     * \remark all functions are thread safe, the index is never changed after construction
+     */
+    class BLACKMISC_EXPORT CAircraftModelSetIndex
+    {
+    public:
+        //! Model ids (positions in the model set)
+        using Ids = QVector<int>;
+
+        //! Default constructor, empty set
+        CAircraftModelSetIndex() = default;
+
+        //! Constructor, builds all indexes
+        explicit CAircraftModelSetIndex(const CAircraftModelList &models);
+
+        //! The indexed models
+        const CAircraftModelList &getModels() const { return m_models; }
+
+        //! Number of models
+        int size() const { return m_models.sizeInt(); }
+
+        //! Model for id
+        const CAircraftModel &modelAt(int id) const { return m_models[id]; }
+
+        //! \name Ids by exact key
+        //! \remark the model string is case insensitive and includes the aliases
+        //! @{
+        const Ids &getIdsByModelStringOrAlias(const QString &modelString) const;
+        const Ids &getIdsByAircraftDesignator(const QString &designator) const;
+        const Ids &getIdsByAirlineDesignator(const QString &designator) const;
+        const Ids &getIdsByAirlineGroup(int groupId) const;
+        const Ids &getIdsByFamily(const QString &family) const;
+        const Ids &getIdsByCombinedType(const QString &combinedType) const;
+        const Ids &getIdsByManufacturer(const QString &manufacturer) const;
+        const Ids &getIdsByLiveryCode(const QString &combinedCode) const;
+        const Ids &getIdsByDistributor(const QString &distributorKey) const;
+        //! @}
+
+        //! \name Ids by property
+        //! @{
+        const Ids &getIdsWithoutModelString() const { return m_withoutModelString; }
+        const Ids &getIdsWithoutDbKey() const { return m_withoutDbKey; }
+        const Ids &getIdsExcluded() const { return m_excluded; }
+        const Ids &getIdsMilitary() const { return m_military; }
+        const Ids &getIdsVtol() const { return m_vtol; }
+        //! @}
+
+        //! Id of the first model with that model string (case insensitive), -1 if not found
+        int findFirstIdByModelString(const QString &modelString) const;
+
+        //! Airline names, simplified names and telephony designators of models with airline and DB key, ids are model ids
+        const CTrigramIndex &getAirlineNameSearch() const { return m_airlineNameSearch; }
+
+        //! Models with airline and DB key
+        const Ids &getIdsWithAirlineAndDbKey() const { return m_withAirlineAndDbKey; }
+
+    private:
+        //! Ids for key or empty
+        static const Ids &idsForKey(const QHash<QString, Ids> &index, const QString &key);
+
+        CAircraftModelList m_models;                   //!< the models, ids are the positions
+        QHash<QString, Ids> m_byModelString;           //!< case folded model string and alias
+        QHash<QString, Ids> m_byAircraftDesignator;    //!< aircraft ICAO designator
+        QHash<QString, Ids> m_byAirlineDesignator;     //!< airline ICAO designator
+        QHash<int, Ids>     m_byAirlineGroup;          //!< airline group id
+        QHash<QString, Ids> m_byFamily;                //!< aircraft family
+        QHash<QString, Ids> m_byCombinedType;          //!< combined type, e.g. L2J
+        QHash<QString, Ids> m_byManufacturer;          //!< aircraft manufacturer
+        QHash<QString, Ids> m_byLiveryCode;            //!< livery combined code
+        QHash<QString, Ids> m_byDistributor;           //!< distributor key
+        Ids m_withoutModelString;                      //!< models without model string
+        Ids m_withoutDbKey;                            //!< models without DB key
+        Ids m_excluded;                                //!< models marked excluded
+        Ids m_military;                                //!< military models
+        Ids m_vtol;                                    //!< VTOL models
+        Ids m_withAirlineAndDbKey;                     //!< models with airline designator and DB key
+        CTrigramIndex m_airlineNameSearch;             //!< airline names and telephony designators
+    };
+
+    /*!
+     * Subset of an indexed model set, represented by model ids instead of copied models.
+     * Offers the finders of CAircraftModelList used for matching, with the same results (content and order),
+     * indexed finders do not scan the whole set.
+     */
+    class BLACKMISC_EXPORT CAircraftModelSetView
+    {
+    public:
+        //! Model ids
+        using Ids = CAircraftModelSetIndex::Ids;
+
+        //! Default constructor, empty view
+        CAircraftModelSetView() = default;
+
+        //! View on all models of the index
+        explicit CAircraftModelSetView(const QSharedPointer<const CAircraftModelSetIndex> &index);
+
+        //! The index
+        const QSharedPointer<const CAircraftModelSetIndex> &getIndex() const { return m_index; }
+
+        //! Model ids in list order
+        Ids getIds() const;
+
+        //! Empty?
+        bool isEmpty() const { return this->size() < 1; }
+
+        //! Number of models
+        int size() const;
+
+        //! Number of models
+        int sizeInt() const { return this->size(); }
+
+        //! First model
+        //! \remark not empty
+        const CAircraftModel &front() const;
+
+        //! Model at list position
+        const CAircraftModel &operator [](int position) const;
+
+        //! The models as list
+        //! \remark all models are copied, except for a view on the whole set
+        CAircraftModelList toModelList() const;
+
+        //! View for models of the same set, looked up by model string, models not in the set are ignored
+        CAircraftModelSetView withModels(const CAircraftModelList &models) const;
+
+        //! All models of this view, then the models of other not in this view
+        CAircraftModelSetView unite(const CAircraftModelSetView &other) const;
+
+        //! Models of this view not in other, then all models of other
+        //! \remark same order as CAircraftModelList::replaceOrAddModelsWithString
+        CAircraftModelSetView replacedOrAdded(const CAircraftModelSetView &other) const;
+
+        //! Models matching the predicate
+        template <class Predicate>
+        CAircraftModelSetView findBy(Predicate predicate) const
+        {
+            return this->filtered(this->getIds(), predicate);
+        }
+
+        //! \name Finders like in CAircraftModelList
+        //! @{
+        CAircraftModel findFirstByModelStringAliasOrDefault(const QString &modelString, Qt::CaseSensitivity sensitivity = Qt::CaseInsensitive) const;
+        CAircraftModelSetView findByIcaoDesignators(const Aviation::CAircraftIcaoCode &aircraftIcaoCode, const Aviation::CAirlineIcaoCode &airlineIcaoCode) const;
+        CAircraftModelSetView findByAircraftDesignatorAndLiveryCombinedCode(const QString &aircraftDesignator, const QString &combinedCode) const;
+        CAircraftModelSetView findByAirlineGroup(const Aviation::CAirlineIcaoCode &airline) const;
+        CAircraftModelSetView findByFamily(const QString &family) const;
+        CAircraftModelSetView findByCombinedType(const QString &combinedType) const;
+        CAircraftModelSetView findByCombinedTypeWithColorLivery(const QString &combinedType) const;
+        CAircraftModelSetView findByCombinedAndManufacturer(const Aviation::CAircraftIcaoCode &icao) const;
+        CAircraftModelSetView findByManufacturer(const QString &manufacturer) const;
+        CAircraftModelSetView findByLiveryCode(const Aviation::CLivery &livery) const;
+        CAircraftModelSetView findByDistributor(const CDistributor &distributor) const;
+        CAircraftModelSetView findByMilitaryFlag(bool military) const;
+        CAircraftModelSetView findByVtolFlag(bool vtol) const;
+        CAircraftModelSetView findByAirlineNamesOrTelephonyDesignator(const QString &name) const;
+        bool containsVtol() const;
+        //! @}
+
+        //! \name Removal like in CAircraftModelList
+        //! @{
+        int removeAllWithoutModelString();
+        int removeObjectsWithoutDbKey();
+        int removeIfExcluded();
+        //! @}
+
+    private:
+        //! Constructor for subset
+        CAircraftModelSetView(const QSharedPointer<const CAircraftModelSetIndex> &index, const Ids &ids);
+
+        //! Candidates in this view, in view order
+        Ids candidates(const Ids &sortedIds) const;
+
+        //! Remove ids, returns number of removed models
+        int removeIds(const Ids &sortedIds);
+
+        //! Ids matching the predicate
+        template <class Predicate>
+        CAircraftModelSetView filtered(const Ids &ids, Predicate predicate) const
+        {
+            Ids result;
+            for (int id : ids)
+            {
+                if (predicate(m_index->modelAt(id))) { result.push_back(id); }
+            }
+            return CAircraftModelSetView(m_index, result);
+        }
+
+        QSharedPointer<const CAircraftModelSetIndex> m_index; //!< shared index
+        Ids m_ids;                                             //!< ids of this view in list order, unless all
+        bool m_all = false;                                    //!< all models of the index
+    };
+} // ns
+
+#endif // guard
@@ -0,0 +1,122 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/compactsituation.h"
+#include "blackmisc/pq/units.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        //! \private Value in unit, NaN if null
+        template <class PQ, class MU>
+        double valueOrNaN(const PQ &pq, const MU &unit)
+        {
+            return pq.isNull() ? std::numeric_limits<double>::quiet_NaN() : pq.value(unit);
+        }
+
+        //! \private Equal within epsilon or both NaN (null), like the physical quantity compare
+        bool equalOrBothNaN(double v1, double v2, double epsilon)
+        {
+            if (std::isnan(v1) || std::isnan(v2)) { return std::isnan(v1) && std::isnan(v2); }
+            return std::abs(v1 - v2) <= epsilon;
+        }
+    }
+
+    bool CompactSituation::hasGroundElevation() const
+    {
+        return !std::isnan(groundElevationM);
+    }
+
+    bool CompactSituation::equalPbhVectorAltitude(const CompactSituation &other) const
+    {
+        // same epsilons as ICoordinateGeodetic::equalNormalVectorDouble and the meter/degree units
+        static const double vectorEpsilon = std::numeric_limits<double>::epsilon();
+        constexpr double unitEpsilon = 1e-9;
+        for (size_t i = 0; i < normalVector.size(); i++)
+        {
+            if (std::abs(normalVector[i] - other.normalVector[i]) > vectorEpsilon) { return false; }
+        }
+        return equalOrBothNaN(pitchDeg, other.pitchDeg, unitEpsilon) && equalOrBothNaN(bankDeg, other.bankDeg, unitEpsilon) &&
+               equalOrBothNaN(headingDeg, other.headingDeg, unitEpsilon) && equalOrBothNaN(altitudeM, other.altitudeM, unitEpsilon);
+    }
+
+    void CompactSituation::setChangingValues(const CAircraftSituation &situation)
+    {
+        adjustedMsSinceEpoch = situation.getAdjustedMSecsSinceEpoch();
+        groundElevationM = situation.hasGroundElevation() ? situation.getGroundElevation().value(CLengthUnit::m()) : std::numeric_limits<double>::quiet_NaN();
+        onGroundFactor = situation.getOnGroundFactor();
+    }
+
+    CompactSituation CompactSituation::fromSituation(const CAircraftSituation &situation)
+    {
+        CompactSituation cs;
+        cs.msSinceEpoch = situation.getMSecsSinceEpoch();
+        cs.adjustedMsSinceEpoch = situation.getAdjustedMSecsSinceEpoch();
+        cs.normalVector = situation.getPosition().normalVectorDouble();
+        cs.altitudeM = valueOrNaN(situation.getAltitude(), CLengthUnit::m());
+        cs.groundElevationM = situation.hasGroundElevation() ? situation.getGroundElevation().value(CLengthUnit::m()) : std::numeric_limits<double>::quiet_NaN();
+        cs.headingDeg = valueOrNaN(situation.getHeading(), CAngleUnit::deg());
+        cs.pitchDeg = valueOrNaN(situation.getPitch(), CAngleUnit::deg());
+        cs.bankDeg = valueOrNaN(situation.getBank(), CAngleUnit::deg());
+        cs.groundSpeedMps = valueOrNaN(situation.getGroundSpeed(), CSpeedUnit::m_s());
+        cs.onGroundFactor = situation.getOnGroundFactor();
+        return cs;
+    }
+
+    void CCompactSituations::setSituations(const CAircraftSituationList &situationsLatestFirst)
+    {
+        m_situations.clear();
+        for (const CAircraftSituation &situation : situationsLatestFirst)
+        {
+            m_situations.push_back(CompactSituation::fromSituation(situation));
+        }
+    }
+
+    bool CCompactSituations::isSameSituations(const CAircraftSituationList &situationsLatestFirst) const
+    {
+        if (situationsLatestFirst.size() != this->size()) { return false; }
+        int i = 0;
+        for (const CAircraftSituation &situation : situationsLatestFirst)
+        {
+            const CompactSituation &cs = (*this)[i++];
+            if (cs.msSinceEpoch != situation.getMSecsSinceEpoch() || cs.adjustedMsSinceEpoch != situation.getAdjustedMSecsSinceEpoch()) { return false; }
+        }
+        return true;
+    }
+
+    void CCompactSituations::addAltitudeOffset(double offsetM)
+    {
+        for (CompactSituation &situation : m_situations) { situation.altitudeM += offsetM; }
+    }
+
+    void CCompactSituations::clear()
+    {
+        m_situations.clear();
+    }
+
+    int CCompactSituations::indexOfFirstNotNewerThanAdjusted(qint64 msSinceEpoch) const
+    {
+        // adjusted times are descending
+        const auto it = std::partition_point(m_situations.cbegin(), m_situations.cend(), [ = ](const CompactSituation &situation) { return situation.adjustedMsSinceEpoch > msSinceEpoch; });
+        return static_cast<int>(it - m_situations.cbegin());
+    }
+
+    int CCompactSituations::indexOfFirstBeforeAdjusted(qint64 msSinceEpoch) const
+    {
+        const int i = this->indexOfFirstNotNewerThanAdjusted(msSinceEpoch - 1);
+        return i < this->size() ? i : -1;
+    }
+} // ns
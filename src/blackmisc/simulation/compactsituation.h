@@ -0,0 +1,132 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_COMPACTSITUATION_H
+#define BLACKMISC_SIMULATION_COMPACTSITUATION_H
+
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QtGlobal>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace BlackMisc::Simulation
+{
+    //! The values of a CAircraftSituation an interpolator works with, as plain doubles
+    //! \remark lengths in m, speeds in m/s, angles in degrees, null values of the situation are NaN
+    struct BLACKMISC_EXPORT CompactSituation
+    {
+        qint64 msSinceEpoch = -1;         //!< timestamp
+        qint64 adjustedMsSinceEpoch = -1; //!< timestamp plus offset
+        std::array<double, 3> normalVector {{ 0, 0, 0 }}; //!< position as normal vector
+        double altitudeM = 0;             //!< altitude (MSL) in m
+        double groundElevationM = 0;      //!< ground elevation in m
+        double headingDeg = 0;            //!< heading in degrees
+        double pitchDeg = 0;              //!< pitch in degrees
+        double bankDeg = 0;               //!< bank in degrees
+        double groundSpeedMps = 0;        //!< ground speed in m/s
+        double onGroundFactor = -1;       //!< on ground factor, -1 if not available
+
+        //! Has ground elevation?
+        bool hasGroundElevation() const;
+
+        //! Same position, attitude and altitude, like CAircraftSituation::equalPbhVectorAltitude
+        bool equalPbhVectorAltitude(const CompactSituation &other) const;
+
+        //! Set the values which change for an already stored situation
+        //! \remark adjusted timestamp (offset correction), ground elevation and on ground factor
+        void setChangingValues(const Aviation::CAircraftSituation &situation);
+
+        //! From situation
+        static CompactSituation fromSituation(const Aviation::CAircraftSituation &situation);
+    };
+
+    static_assert(std::is_trivially_copyable_v<CompactSituation>, "Needs to be trivially copyable");
+
+    //! Compact copy of the situations of one callsign, latest first
+    //! \remark Kept by the remote aircraft provider next to its situation history and handed to the interpolators,
+    //!          which search the timestamps and compare the values without touching CAircraftSituation objects
+    class BLACKMISC_EXPORT CCompactSituations
+    {
+    public:
+        //! Set from situations sorted adjusted latest first, replaces the current values
+        //! \remark keeps the allocated memory
+        void setSituations(const Aviation::CAircraftSituationList &situationsLatestFirst);
+
+        //! Update from situations sorted latest first after the latest situation was stored or values were changed in place
+        //! \remark Only the latest and new situations are converted, situations with the same timestamp and position
+        //!          are kept and only their changing values are set (see CompactSituation::setChangingValues)
+        //! \remark SITUATIONS needs size() and operator[], e.g. CAircraftSituationList or a CTimestampRingBuffer
+        template <class SITUATIONS>
+        void update(const SITUATIONS &situationsLatestFirst)
+        {
+            m_updated.clear();
+            size_t old = 0;
+            for (int i = 0; i < situationsLatestFirst.size(); ++i)
+            {
+                const Aviation::CAircraftSituation &situation = situationsLatestFirst[i];
+                const qint64 ms = situation.getMSecsSinceEpoch();
+                while (old < m_situations.size() && m_situations[old].msSinceEpoch > ms) { old++; }
+                if (i > 0 && old < m_situations.size() && m_situations[old].msSinceEpoch == ms && m_situations[old].normalVector == situation.getPosition().normalVectorDouble())
+                {
+                    m_updated.push_back(m_situations[old++]);
+                    m_updated.back().setChangingValues(situation);
+                }
+                else
+                {
+                    m_updated.push_back(CompactSituation::fromSituation(situation));
+                }
+            }
+            m_situations.swap(m_updated);
+            m_updated.clear();
+        }
+
+        //! Same situations (number and timestamps) as situationsLatestFirst?
+        bool isSameSituations(const Aviation::CAircraftSituationList &situationsLatestFirst) const;
+
+        //! Add an altitude offset to all situations
+        void addAltitudeOffset(double offsetM);
+
+        //! Remove all values
+        void clear();
+
+        //! Number of situations
+        int size() const { return static_cast<int>(m_situations.size()); }
+
+        //! Empty?
+        bool isEmpty() const { return m_situations.empty(); }
+
+        //! Situation by index, 0 is the latest
+        const CompactSituation &operator [](int index) const { return m_situations[static_cast<size_t>(index)]; }
+
+        //! Index of the first (latest) situation with adjusted timestamp <= msSinceEpoch, size() if there is none
+        //! \remark binary search, same as std::partition_point on the list
+        int indexOfFirstNotNewerThanAdjusted(qint64 msSinceEpoch) const;
+
+        //! Index of the first (latest) situation with adjusted timestamp < msSinceEpoch, -1 if there is none
+        //! \remark index of the situation CAircraftSituationList::findObjectBeforeAdjustedOrDefault returns
+        int indexOfFirstBeforeAdjusted(qint64 msSinceEpoch) const;
+
+        //! Adjusted timestamp by index
+        qint64 adjustedMsSinceEpoch(int index) const { return (*this)[index].adjustedMsSinceEpoch; }
+
+        //! Bytes used by the situations
+        size_t memoryBytes() const { return m_situations.capacity() * sizeof(CompactSituation); }
+
+    private:
+        std::vector<CompactSituation> m_situations; //!< latest first
+        std::vector<CompactSituation> m_updated;    //!< buffer used by update, empty otherwise
+    };
+} // ns
+
+#endif // guard
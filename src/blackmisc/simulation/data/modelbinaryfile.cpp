@@ -0,0 +1,401 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/data/modelbinaryfile.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/memotable.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Simulation::Data
+{
+    namespace
+    {
+        //! File header, all offsets relative to the (uncompressed) payload following the header
+        //! \remark host byte order, a file written with other byte order fails the version check
+        struct Header
+        {
+            char magic[8];
+            quint32 version;
+            quint32 flags;
+            qint64 timestamp;
+            quint32 modelCount;
+            quint32 stringCount;
+            quint64 recordsOffset;
+            quint64 stringOffsetsOffset;
+            quint64 stringDataOffset;
+            quint64 tablesOffset;
+            quint64 tablesSize;
+            quint64 payloadSize;
+        };
+        static_assert(sizeof(Header) == 80, "Header layout is part of the file format");
+
+        //! Fixed size record of one model, strings and objects as indexes, -1 or NoString if not set
+        struct Record
+        {
+            qint64 timestampMs;
+            qint64 fileTimestamp;
+            double cgValue;
+            qint32 dbKey;
+            qint32 order;
+            qint32 simulator;
+            qint32 modelType;
+            qint32 modelMode;
+            qint32 aircraftIcao;
+            qint32 livery;
+            qint32 distributor;
+            qint32 callsign;
+            quint32 modelString;
+            quint32 modelStringAlias;
+            quint32 name;
+            quint32 description;
+            quint32 fileName;
+            quint32 iconFile;
+            quint32 supportedParts;
+            quint32 cgUnit;
+            quint32 reserved;
+        };
+        static_assert(sizeof(Record) == 96, "Record layout is part of the file format");
+
+        constexpr char Magic[8] = { 'S', 'W', 'I', 'F', 'T', 'M', 'D', 'L' };
+        constexpr quint32 FlagCompressed = 1;
+        constexpr quint32 NoString = std::numeric_limits<quint32>::max();
+
+        //! Round up to multiple of 8
+        quint64 align8(quint64 offset) { return (offset + 7) & ~quint64(7); }
+
+        //! Range [offset, offset + length) within size, without overflowing offset + length
+        bool isInRange(quint64 offset, quint64 length, quint64 size) { return offset <= size && length <= size - offset; }
+
+        using MemoHelper = CMemoHelper<CAircraftIcaoCode, CLivery, CDistributor, CCallsign>;
+
+        //! Object from table, default object for invalid index
+        template <typename T>
+        T fromTable(const CSequence<T> &table, qint32 index)
+        {
+            return (index >= 0 && index < table.sizeInt()) ? table[index] : T();
+        }
+    }
+
+    CModelBinaryFile::CModelBinaryFile()
+    { }
+
+    CModelBinaryFile::~CModelBinaryFile()
+    {
+        this->close();
+    }
+
+    QByteArray CModelBinaryFile::toBinary(const CAircraftModelList &models, qint64 timestamp, bool compress)
+    {
+        MemoHelper::CMemoizer memo;
+        CMemoTable<QString> strings;
+        const auto stringIndex = [&strings](const QString &s) { return s.isEmpty() ? NoString : static_cast<quint32>(strings.getIndex(s)); };
+
+        QByteArray records(models.sizeInt() * static_cast<int>(sizeof(Record)), Qt::Uninitialized);
+        char *recordPtr = records.data();
+        for (const CAircraftModel &model : models)
+        {
+            Record r;
+            std::memset(&r, 0, sizeof(r));
+            r.timestampMs = model.getMSecsSinceEpoch();
+            r.fileTimestamp = model.hasValidFileTimestamp() ? model.getFileTimestamp().toMSecsSinceEpoch() : -1;
+            r.cgValue = model.getCG().isNull() ? std::numeric_limits<double>::quiet_NaN() : model.getCG().value();
+            r.dbKey = model.getDbKey();
+            r.order = model.getOrder();
+            r.simulator = static_cast<qint32>(model.getSimulator().getSimulator());
+            r.modelType = static_cast<qint32>(model.getModelType());
+            r.modelMode = static_cast<qint32>(model.getModelMode());
+            r.aircraftIcao = memo.maybeMemoize(model.getAircraftIcaoCode());
+            r.livery = memo.maybeMemoize(model.getLivery());
+            r.distributor = memo.maybeMemoize(model.getDistributor());
+            r.callsign = model.getCallsign().isEmpty() ? -1 : memo.maybeMemoize(model.getCallsign());
+            r.modelString = stringIndex(model.getModelString());
+            r.modelStringAlias = stringIndex(model.getModelStringAlias());
+            r.name = stringIndex(model.getName());
+            r.description = stringIndex(model.getDescription());
+            r.fileName = stringIndex(model.getFileName());
+            r.iconFile = stringIndex(model.getIconFile());
+            r.supportedParts = stringIndex(model.getSupportedParts());
+            r.cgUnit = model.getCG().isNull() ? NoString : stringIndex(model.getCG().getUnit().getSymbol());
+            r.reserved = 0;
+            std::memcpy(recordPtr, &r, sizeof(r));
+            recordPtr += sizeof(r);
+        }
+
+        // string table, offsets in UTF-16 units
+        const CSequence<QString> &stringTable = strings.getTable();
+        QVector<quint32> stringOffsets;
+        stringOffsets.reserve(stringTable.sizeInt() + 1);
+        QString stringData;
+        for (const QString &s : stringTable)
+        {
+            stringOffsets.push_back(static_cast<quint32>(stringData.size()));
+            stringData += s;
+        }
+        stringOffsets.push_back(static_cast<quint32>(stringData.size()));
+
+        QByteArray tables;
+        {
+            QDataStream stream(&tables, QIODevice::WriteOnly);
+            stream << memo.getTable<CAircraftIcaoCode>() << memo.getTable<CLivery>() << memo.getTable<CDistributor>() << memo.getTable<CCallsign>();
+        }
+
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.flags = compress ? FlagCompressed : 0;
+        header.timestamp = timestamp;
+        header.modelCount = static_cast<quint32>(models.size());
+        header.stringCount = static_cast<quint32>(stringTable.size());
+        header.recordsOffset = 0;
+        header.stringOffsetsOffset = static_cast<quint64>(records.size());
+        header.stringDataOffset = header.stringOffsetsOffset + stringOffsets.size() * sizeof(quint32);
+        header.tablesOffset = align8(header.stringDataOffset + stringData.size() * sizeof(char16_t));
+        header.tablesSize = static_cast<quint64>(tables.size());
+        header.payloadSize = header.tablesOffset + header.tablesSize;
+
+        QByteArray payload(static_cast<int>(header.payloadSize), '\0');
+        std::memcpy(payload.data() + header.recordsOffset, records.constData(), static_cast<size_t>(records.size()));
+        std::memcpy(payload.data() + header.stringOffsetsOffset, stringOffsets.constData(), stringOffsets.size() * sizeof(quint32));
+        std::memcpy(payload.data() + header.stringDataOffset, stringData.utf16(), stringData.size() * sizeof(char16_t));
+        std::memcpy(payload.data() + header.tablesOffset, tables.constData(), static_cast<size_t>(tables.size()));
+        if (compress) { payload = qCompress(payload); }
+
+        QByteArray data(reinterpret_cast<const char *>(&header), sizeof(header));
+        data += payload;
+        return data;
+    }
+
+    bool CModelBinaryFile::writeFile(const CAircraftModelList &models, qint64 timestamp, const QString &fileName, bool compress)
+    {
+        if (fileName.isEmpty()) { return false; }
+        const QFileInfo fi(fileName);
+        if (!QDir().mkpath(fi.absolutePath())) { return false; }
+
+        // the file can be mapped by this or another process, so it is never truncated in place
+        QSaveFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly)) { return false; }
+        const QByteArray data = toBinary(models, timestamp, compress);
+        if (file.write(data) != data.size())
+        {
+            file.cancelWriting();
+            return false;
+        }
+        return file.commit();
+    }
+
+    bool CModelBinaryFile::open(const QString &fileName)
+    {
+        this->close();
+        auto file = std::make_unique<QFile>(fileName);
+        if (!file->open(QIODevice::ReadOnly)) { return false; }
+
+        Header header;
+        if (file->read(reinterpret_cast<char *>(&header), sizeof(header)) != static_cast<qint64>(sizeof(header))) { return false; }
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) { return false; }
+
+        if (header.flags & FlagCompressed)
+        {
+            // compressed files are read completely
+            file->seek(0);
+            return this->openData(file->readAll());
+        }
+
+        uchar *mapped = file->map(0, file->size());
+        if (!mapped) { return false; }
+        m_file = std::move(file);
+        m_mapped = mapped;
+        if (this->readPayload(reinterpret_cast<const char *>(mapped), m_file->size())) { return true; }
+        this->close();
+        return false;
+    }
+
+    bool CModelBinaryFile::openData(const QByteArray &data)
+    {
+        this->close();
+        if (data.size() < static_cast<int>(sizeof(Header))) { return false; }
+
+        Header header;
+        std::memcpy(&header, data.constData(), sizeof(header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) { return false; }
+
+        if (header.flags & FlagCompressed)
+        {
+            const QByteArray payload = qUncompress(reinterpret_cast<const uchar *>(data.constData()) + sizeof(header), data.size() - static_cast<int>(sizeof(header)));
+            if (payload.isEmpty()) { return false; }
+            m_data = data.left(static_cast<int>(sizeof(header))) + payload;
+        }
+        else
+        {
+            m_data = data;
+        }
+        if (this->readPayload(m_data.constData(), m_data.size())) { return true; }
+        this->close();
+        return false;
+    }
+
+    void CModelBinaryFile::close()
+    {
+        if (m_file)
+        {
+            if (m_mapped) { m_file->unmap(m_mapped); }
+            m_file->close();
+            m_file.reset();
+        }
+        m_mapped = nullptr;
+        m_data.clear();
+        m_payload = nullptr;
+        m_records = nullptr;
+        m_stringOffsets = nullptr;
+        m_stringData = nullptr;
+        m_modelCount = 0;
+        m_stringCount = 0;
+        m_stringDataSize = 0;
+        m_timestamp = -1;
+        m_aircraftIcaos.clear();
+        m_liveries.clear();
+        m_distributors.clear();
+        m_callsigns.clear();
+    }
+
+    bool CModelBinaryFile::readPayload(const char *data, qint64 size)
+    {
+        // data is header + uncompressed payload
+        if (size < static_cast<qint64>(sizeof(Header))) { return false; }
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        const char *payload = data + sizeof(Header);
+        const quint64 payloadSize = static_cast<quint64>(size) - sizeof(Header);
+
+        // validate offsets, so corrupt files never read beyond the data
+        // each offset + length is checked against the size before adding, so huge values cannot wrap around
+        if (header.payloadSize > payloadSize) { return false; }
+        if (!isInRange(header.recordsOffset, quint64(header.modelCount) * sizeof(Record), header.stringOffsetsOffset)) { return false; }
+        if (!isInRange(header.stringOffsetsOffset, (quint64(header.stringCount) + 1) * sizeof(quint32), header.stringDataOffset)) { return false; }
+        if (!isInRange(header.stringDataOffset, 0, header.tablesOffset) || (header.stringOffsetsOffset % 4) != 0 || (header.stringDataOffset % 2) != 0) { return false; }
+        if (!isInRange(header.tablesOffset, header.tablesSize, header.payloadSize)) { return false; }
+        if (header.tablesSize > static_cast<quint64>(std::numeric_limits<int>::max())) { return false; }
+
+        const quint32 *stringOffsets = reinterpret_cast<const quint32 *>(payload + header.stringOffsetsOffset);
+        const quint64 maxStringData = (header.tablesOffset - header.stringDataOffset) / sizeof(char16_t);
+        if (stringOffsets[header.stringCount] > maxStringData) { return false; }
+
+        {
+            const QByteArray tables = QByteArray::fromRawData(payload + header.tablesOffset, static_cast<int>(header.tablesSize));
+            QDataStream stream(tables);
+            stream >> m_aircraftIcaos >> m_liveries >> m_distributors >> m_callsigns;
+            if (stream.status() != QDataStream::Ok) { return false; }
+        }
+
+        m_payload = payload;
+        m_records = payload + header.recordsOffset;
+        m_stringOffsets = stringOffsets;
+        m_stringData = reinterpret_cast<const char16_t *>(payload + header.stringDataOffset);
+        m_modelCount = header.modelCount;
+        m_stringCount = header.stringCount;
+        m_stringDataSize = stringOffsets[header.stringCount];
+        m_timestamp = header.timestamp;
+        return true;
+    }
+
+    QString CModelBinaryFile::stringAt(quint32 index) const
+    {
+        if (index >= m_stringCount) { return {}; }
+        const quint32 begin = m_stringOffsets[index];
+        const quint32 end = m_stringOffsets[index + 1];
+        if (begin > end || end > m_stringDataSize) { return {}; }
+        return QString(reinterpret_cast<const QChar *>(m_stringData + begin), static_cast<int>(end - begin));
+    }
+
+    QString CModelBinaryFile::modelStringAt(int index) const
+    {
+        Q_ASSERT_X(index >= 0 && index < this->size(), Q_FUNC_INFO, "Index out of range");
+        quint32 modelString = NoString;
+        std::memcpy(&modelString, m_records + index * sizeof(Record) + offsetof(Record, modelString), sizeof(modelString));
+        return this->stringAt(modelString);
+    }
+
+    QStringList CModelBinaryFile::modelStrings() const
+    {
+        QStringList modelStrings;
+        const int count = this->size();
+        modelStrings.reserve(count);
+        for (int i = 0; i < count; i++)
+        {
+            const QString modelString = this->modelStringAt(i);
+            if (!modelString.isEmpty()) { modelStrings.push_back(modelString); }
+        }
+        return modelStrings;
+    }
+
+    int CModelBinaryFile::indexOfModelString(const QString &modelString, Qt::CaseSensitivity cs) const
+    {
+        if (modelString.isEmpty()) { return -1; }
+        const int count = this->size();
+        for (int i = 0; i < count; i++)
+        {
+            if (this->modelStringAt(i).compare(modelString, cs) == 0) { return i; }
+        }
+        return -1;
+    }
+
+    CAircraftModel CModelBinaryFile::modelAt(int index) const
+    {
+        Q_ASSERT_X(index >= 0 && index < this->size(), Q_FUNC_INFO, "Index out of range");
+        Record r;
+        std::memcpy(&r, m_records + index * sizeof(Record), sizeof(r));
+
+        CAircraftModel model;
+        model.setDbKey(r.dbKey);
+        model.setMSecsSinceEpoch(r.timestampMs);
+        model.setOrder(r.order);
+        if (r.callsign >= 0) { model.setCallsign(fromTable(m_callsigns, r.callsign)); }
+        model.setAircraftIcaoCode(fromTable(m_aircraftIcaos, r.aircraftIcao));
+        model.setLivery(fromTable(m_liveries, r.livery));
+        model.setDistributor(fromTable(m_distributors, r.distributor));
+        model.setSimulator(CSimulatorInfo(r.simulator));
+        model.setQueriedModelString(this->stringAt(r.modelString)); // stored as is, no trimming
+        model.setModelType(static_cast<CAircraftModel::ModelType>(r.modelType));
+        model.setModelStringAlias(this->stringAt(r.modelStringAlias));
+        model.setName(this->stringAt(r.name));
+        model.setDescription(this->stringAt(r.description));
+        model.setFileName(this->stringAt(r.fileName));
+        model.setIconFile(this->stringAt(r.iconFile));
+        model.setSupportedParts(this->stringAt(r.supportedParts));
+        model.setFileTimestamp(r.fileTimestamp);
+        model.setModelMode(static_cast<CAircraftModel::ModelMode>(r.modelMode));
+        model.setCG(std::isnan(r.cgValue) ?
+                    CLength::null() :
+                    CLength(r.cgValue, CMeasurementUnit::unitFromSymbol<CLengthUnit>(this->stringAt(r.cgUnit), false)));
+        return model;
+    }
+
+    CAircraftModelList CModelBinaryFile::toModelList() const
+    {
+        CAircraftModelList models;
+        const int count = this->size();
+        for (int i = 0; i < count; i++)
+        {
+            models.push_back(this->modelAt(i));
+        }
+        return models;
+    }
+} // ns
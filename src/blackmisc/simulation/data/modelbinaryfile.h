@@ -0,0 +1,127 @@
+/* Copyright (C) 2023
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_DATA_MODELBINARYFILE_H
+#define BLACKMISC_SIMULATION_DATA_MODELBINARYFILE_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <memory>
+
+class QFile;
+
+namespace BlackMisc::Simulation::Data
+{
+    /*!
+     * Versioned binary container for a CAircraftModelList, used as fast alternative to the JSON model caches.
+     *
+     * Layout: header, fixed size model records, string table, object tables. Strings are stored once (CMemoTable)
+     * as UTF-16, records refer to them by index. Aircraft ICAO codes, liveries, distributors and callsigns
+     * are memoized like in CAircraftModelList::toMemoizedJson and stored as QDataStream.
+     * An uncompressed file is memory-mapped, models are materialized on access only.
+     * \remark after open all const functions are thread safe
+     */
+    class BLACKMISC_EXPORT CModelBinaryFile
+    {
+    public:
+        //! Format version, files with other versions are not opened
+        static constexpr quint32 Version = 1;
+
+        //! Constructor
+        CModelBinaryFile();
+
+        //! Destructor
+        ~CModelBinaryFile();
+
+        //! Not copyable
+        //! @{
+        CModelBinaryFile(const CModelBinaryFile &) = delete;
+        CModelBinaryFile &operator =(const CModelBinaryFile &) = delete;
+        //! @}
+
+        //! Models as binary data
+        //! \remark a compressed container is smaller, but cannot be memory-mapped
+        static QByteArray toBinary(const CAircraftModelList &models, qint64 timestamp, bool compress = false);
+
+        //! Write models to file
+        //! \remark written to a temporary file which replaces the file, mapped files stay valid
+        static bool writeFile(const CAircraftModelList &models, qint64 timestamp, const QString &fileName, bool compress = false);
+
+        //! Open file, memory-mapped if not compressed
+        bool open(const QString &fileName);
+
+        //! Open from data, e.g. as created by toBinary
+        bool openData(const QByteArray &data);
+
+        //! Close, unmaps the file
+        void close();
+
+        //! Open?
+        bool isOpen() const { return m_payload != nullptr; }
+
+        //! Memory-mapped file?
+        bool isMapped() const { return m_mapped != nullptr; }
+
+        //! Number of models
+        int size() const { return isOpen() ? static_cast<int>(m_modelCount) : 0; }
+
+        //! Timestamp stored with the models, e.g. the cache timestamp
+        qint64 getTimestamp() const { return m_timestamp; }
+
+        //! Model at index, materialized from the records
+        //! \remark index < size()
+        CAircraftModel modelAt(int index) const;
+
+        //! Model string at index, without materializing the model
+        //! \remark index < size()
+        QString modelStringAt(int index) const;
+
+        //! All non-empty model strings, without materializing the models
+        QStringList modelStrings() const;
+
+        //! Index of the model with the given model string, -1 if not found
+        //! \remark without materializing the models
+        int indexOfModelString(const QString &modelString, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
+
+        //! All models
+        CAircraftModelList toModelList() const;
+
+    private:
+        //! String from the string table
+        QString stringAt(quint32 index) const;
+
+        //! Read header and tables of payload
+        bool readPayload(const char *payload, qint64 size);
+
+        std::unique_ptr<QFile> m_file;                    //!< mapped file
+        uchar *m_mapped = nullptr;                        //!< mapped memory
+        QByteArray m_data;                                //!< data if not mapped
+        const char *m_payload = nullptr;                  //!< records, strings, tables
+        const char *m_records = nullptr;                  //!< fixed size model records
+        const quint32 *m_stringOffsets = nullptr;         //!< string offsets in UTF-16 units, stringCount + 1 entries
+        const char16_t *m_stringData = nullptr;           //!< UTF-16 data of all strings
+        quint32 m_modelCount = 0;                         //!< number of models
+        quint32 m_stringCount = 0;                        //!< number of strings
+        quint32 m_stringDataSize = 0;                     //!< size of string data in UTF-16 units
+        qint64 m_timestamp = -1;                          //!< stored timestamp
+        CSequence<Aviation::CAircraftIcaoCode> m_aircraftIcaos; //!< aircraft ICAO table
+        CSequence<Aviation::CLivery> m_liveries;          //!< livery table
+        CSequence<CDistributor> m_distributors;           //!< distributor table
+        CSequence<Aviation::CCallsign> m_callsigns;       //!< callsign table
+    };
+} // ns
+
+#endif // guard
@@ -10,6 +10,10 @@
 #include "blackmisc/cachesettingsutils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
 #include <QtGlobal>
 
 using namespace BlackMisc;
@@ -75,11 +79,137 @@ namespace BlackMisc::Simulation::Data
         emit this->cacheChanged(simulator);
     }
 
+    void IMultiSimulatorModelCaches::changedElsewhere(const CSimulatorInfo &simulator)
+    {
+        if (this->hasBinarySnapshot(simulator))
+        {
+            // the JSON cache was not synchronized, so the next synchronization has to load it (or a new snapshot)
+            this->dropBinarySnapshot(simulator);
+            this->markCacheAsAlreadySynchronized(simulator, false);
+        }
+        this->emitCacheChanged(simulator);
+    }
+
+    QString IMultiSimulatorModelCaches::getBinaryFilename(const CSimulatorInfo &simulator) const
+    {
+        const QString fn = this->getFilename(simulator);
+        if (fn.isEmpty()) { return {}; }
+        const QFileInfo fi(fn);
+        return fi.absolutePath() + '/' + fi.completeBaseName() + QStringLiteral(".bin");
+    }
+
+    bool IMultiSimulatorModelCaches::openBinarySnapshot(const CSimulatorInfo &simulator)
+    {
+        Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+        if (!m_useBinarySnapshots) { return false; }
+        const QDateTime cacheTs = this->getCacheTimestamp(simulator);
+        const QString fn = this->getBinaryFilename(simulator);
+        if (!cacheTs.isValid() || fn.isEmpty() || !QFile::exists(fn)) { return false; }
+
+        QElapsedTimer time;
+        time.start();
+        auto file = std::make_unique<CModelBinaryFile>();
+        if (!file->open(fn)) { return false; }
+        if (file->getTimestamp() != cacheTs.toMSecsSinceEpoch()) { return false; } // outdated
+
+        const int count = file->size();
+        {
+            QMutexLocker l(&m_binarySnapshotsMutex);
+            BinarySnapshot &snapshot = m_binarySnapshots[simulator.getSimulator()];
+            snapshot.file = std::move(file);
+            snapshot.models.clear();
+            snapshot.materialized = false;
+        }
+        CLogMessage(this).info(u"Opened binary snapshot '%1' with %2 models in %3ms") << fn << count << time.elapsed();
+        return true;
+    }
+
+    void IMultiSimulatorModelCaches::writeBinarySnapshot(const CAircraftModelList &models, const CSimulatorInfo &simulator, qint64 timestamp)
+    {
+        Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+        this->dropBinarySnapshot(simulator);
+        if (!m_useBinarySnapshots) { return; }
+
+        const QString fn = this->getBinaryFilename(simulator);
+        if (fn.isEmpty()) { return; }
+        if (models.isEmpty() || timestamp <= 0)
+        {
+            QFile::remove(fn);
+            return;
+        }
+        if (!CModelBinaryFile::writeFile(models, timestamp, fn))
+        {
+            CLogMessage(this).warning(u"Writing binary snapshot '%1' failed") << fn;
+        }
+    }
+
+    void IMultiSimulatorModelCaches::dropBinarySnapshot(const CSimulatorInfo &simulator)
+    {
+        QMutexLocker l(&m_binarySnapshotsMutex);
+        m_binarySnapshots.erase(simulator.getSimulator());
+    }
+
+    bool IMultiSimulatorModelCaches::hasBinarySnapshot(const CSimulatorInfo &simulator) const
+    {
+        QMutexLocker l(&m_binarySnapshotsMutex);
+        return m_binarySnapshots.count(simulator.getSimulator()) > 0;
+    }
+
+    bool IMultiSimulatorModelCaches::getBinarySnapshotModels(const CSimulatorInfo &simulator, CAircraftModelList &models) const
+    {
+        QMutexLocker l(&m_binarySnapshotsMutex);
+        const auto it = m_binarySnapshots.find(simulator.getSimulator());
+        if (it == m_binarySnapshots.end()) { return false; }
+        BinarySnapshot &snapshot = it->second;
+        if (!snapshot.materialized)
+        {
+            snapshot.models = snapshot.file->toModelList();
+            snapshot.materialized = true;
+        }
+        models = snapshot.models;
+        return true;
+    }
+
     int IMultiSimulatorModelCaches::getCachedModelsCount(const CSimulatorInfo &simulator) const
     {
+        {
+            // count without materializing the models
+            QMutexLocker l(&m_binarySnapshotsMutex);
+            const auto it = m_binarySnapshots.find(simulator.getSimulator());
+            if (it != m_binarySnapshots.end()) { return it->second.file->size(); }
+        }
         return this->getCachedModels(simulator).size();
     }
 
+    QStringList IMultiSimulatorModelCaches::getCachedModelStrings(const CSimulatorInfo &simulator) const
+    {
+        {
+            // model strings without materializing the models
+            QMutexLocker l(&m_binarySnapshotsMutex);
+            const auto it = m_binarySnapshots.find(simulator.getSimulator());
+            if (it != m_binarySnapshots.end())
+            {
+                const BinarySnapshot &snapshot = it->second;
+                return snapshot.materialized ? snapshot.models.getModelStringList(false) : snapshot.file->modelStrings();
+            }
+        }
+        return this->getCachedModels(simulator).getModelStringList(false);
+    }
+
+    bool IMultiSimulatorModelCaches::containsCachedModelString(const CSimulatorInfo &simulator, const QString &modelString) const
+    {
+        {
+            QMutexLocker l(&m_binarySnapshotsMutex);
+            const auto it = m_binarySnapshots.find(simulator.getSimulator());
+            if (it != m_binarySnapshots.end())
+            {
+                const BinarySnapshot &snapshot = it->second;
+                return snapshot.materialized ? snapshot.models.containsModelString(modelString) : snapshot.file->indexOfModelString(modelString) >= 0;
+            }
+        }
+        return this->getCachedModels(simulator).containsModelString(modelString);
+    }
+
     bool IMultiSimulatorModelCaches::hasOtherVersionFile(const CApplicationInfo &info, const CSimulatorInfo &simulator) const
     {
         const QString fn = this->getFilename(simulator);
@@ -197,6 +327,8 @@ namespace BlackMisc::Simulation::Data
     CAircraftModelList CModelCaches::getCachedModels(const CSimulatorInfo &simulator) const
     {
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+        CAircraftModelList models;
+        if (this->getBinarySnapshotModels(simulator, models)) { return models; }
         switch (simulator.getSimulator())
         {
         case CSimulatorInfo::FS9:    return m_modelCacheFs9.get();
@@ -214,20 +346,22 @@ namespace BlackMisc::Simulation::Data
     {
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
         CStatusMessage msg;
+        qint64 ts = -1;
         CAircraftModelList setModels(models);
         setModels.setModelType(CAircraftModel::TypeOwnSimulatorModel); // unify type
 
         switch (simulator.getSimulator())
         {
-        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(setModels); break;
-        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(setModels); break;
-        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(setModels); break;
-        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(setModels); break;
-        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(setModels); break;
+        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(setModels); ts = m_modelCacheFs9.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(setModels); ts = m_modelCacheFsx.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(setModels); ts = m_modelCacheP3D.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(setModels); ts = m_modelCacheXP.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(setModels); ts = m_modelCacheFG.getTimestampMsSinceEpoch(); break;
         default:
             Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
             return CStatusMessage();
         }
+        if (msg.isSuccess()) { this->writeBinarySnapshot(setModels, simulator, ts); }
         this->emitCacheChanged(simulator); // set
         return msg;
     }
@@ -291,18 +425,23 @@ namespace BlackMisc::Simulation::Data
     {
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
         if (!ts.isValid()) { return CStatusMessage(this).error(u"Invalid timestamp for '%1'") << simulator.toQString() ; }
+
+        // not m_modelCacheX.get(), with a binary snapshot the JSON cache is not loaded
+        const CAircraftModelList models = this->getCachedModels(simulator);
+        CStatusMessage msg;
         switch (simulator.getSimulator())
         {
-        case CSimulatorInfo::FS9:    return m_modelCacheFs9.set(m_modelCacheFs9.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::FSX:    return m_modelCacheFsx.set(m_modelCacheFsx.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::P3D:    return m_modelCacheP3D.set(m_modelCacheP3D.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::XPLANE: return m_modelCacheXP.set(m_modelCacheXP.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::FG:     return m_modelCacheFG.set(m_modelCacheFG.get(), ts.toMSecsSinceEpoch());
+        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(models, ts.toMSecsSinceEpoch()); break;
         default:
             Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
-            break;
+            return CStatusMessage();
         }
-        return CStatusMessage();
+        if (msg.isSuccess()) { this->writeBinarySnapshot(models, simulator, ts.toMSecsSinceEpoch()); }
+        return msg;
     }
 
     void CModelCaches::synchronizeCache(const CSimulatorInfo &simulator)
@@ -354,16 +493,20 @@ namespace BlackMisc::Simulation::Data
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
         if (this->isCacheAlreadySynchronized(simulator)) { return; }
-        switch (simulator.getSimulator())
+        if (!this->openBinarySnapshot(simulator))
         {
-        case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
-        case CSimulatorInfo::FSX:    m_modelCacheFsx.synchronize(); break;
-        case CSimulatorInfo::P3D:    m_modelCacheP3D.synchronize(); break;
-        case CSimulatorInfo::XPLANE: m_modelCacheXP.synchronize();  break;
-        case CSimulatorInfo::FG:     m_modelCacheFG.synchronize();  break;
-        default:
-            Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
-            break;
+            switch (simulator.getSimulator())
+            {
+            case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
+            case CSimulatorInfo::FSX:    m_modelCacheFsx.synchronize(); break;
+            case CSimulatorInfo::P3D:    m_modelCacheP3D.synchronize(); break;
+            case CSimulatorInfo::XPLANE: m_modelCacheXP.synchronize();  break;
+            case CSimulatorInfo::FG:     m_modelCacheFG.synchronize();  break;
+            default:
+                Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
+                break;
+            }
+            this->writeBinarySnapshot(this->getCachedModels(simulator), simulator, this->getCacheTimestamp(simulator).toMSecsSinceEpoch());
         }
         this->markCacheAsAlreadySynchronized(simulator, true);
         this->emitCacheChanged(simulator); // sync
@@ -374,6 +517,7 @@ namespace BlackMisc::Simulation::Data
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
         if (this->isCacheAlreadySynchronized(simulator)) { return false; }
+        if (this->hasBinarySnapshot(simulator)) { return false; }
         switch (simulator.getSimulator())
         {
         case CSimulatorInfo::FS9:    m_modelCacheFs9.admit(); break;
@@ -416,6 +560,8 @@ namespace BlackMisc::Simulation::Data
     CAircraftModelList CModelSetCaches::getCachedModels(const CSimulatorInfo &simulator) const
     {
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
+        CAircraftModelList models;
+        if (this->getBinarySnapshotModels(simulator, models)) { return models; }
         switch (simulator.getSimulator())
         {
         case CSimulatorInfo::FS9:    return m_modelCacheFs9.get();
@@ -453,17 +599,19 @@ namespace BlackMisc::Simulation::Data
         }
 
         CStatusMessage msg;
+        qint64 ts = -1;
         switch (simulator.getSimulator())
         {
-        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(orderedModels); break;
-        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(orderedModels); break;
-        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(orderedModels); break;
-        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(orderedModels);  break;
-        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(orderedModels);  break;
+        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(orderedModels); ts = m_modelCacheFs9.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(orderedModels); ts = m_modelCacheFsx.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(orderedModels); ts = m_modelCacheP3D.getTimestampMsSinceEpoch(); break;
+        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(orderedModels); ts = m_modelCacheXP.getTimestampMsSinceEpoch();  break;
+        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(orderedModels); ts = m_modelCacheFG.getTimestampMsSinceEpoch();  break;
         default:
             Q_ASSERT_X(false, Q_FUNC_INFO, "wrong simulator");
             return CStatusMessage();
         }
+        if (msg.isSuccess()) { this->writeBinarySnapshot(orderedModels, simulator, ts); }
         this->emitCacheChanged(simulator); // set
         return msg;
     }
@@ -488,18 +636,23 @@ namespace BlackMisc::Simulation::Data
     {
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
         if (!ts.isValid()) { return CStatusMessage(this).error(u"Invalid timestamp for '%1'") << simulator.toQString() ; }
+
+        // not m_modelCacheX.get(), with a binary snapshot the JSON cache is not loaded
+        const CAircraftModelList models = this->getCachedModels(simulator);
+        CStatusMessage msg;
         switch (simulator.getSimulator())
         {
-        case CSimulatorInfo::FS9:    return m_modelCacheFs9.set(m_modelCacheFs9.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::FSX:    return m_modelCacheFsx.set(m_modelCacheFsx.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::P3D:    return m_modelCacheP3D.set(m_modelCacheP3D.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::XPLANE: return m_modelCacheXP.set(m_modelCacheXP.get(), ts.toMSecsSinceEpoch());
-        case CSimulatorInfo::FG:     return m_modelCacheFG.set(m_modelCacheFG.get(), ts.toMSecsSinceEpoch());
+        case CSimulatorInfo::FS9:    msg = m_modelCacheFs9.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::FSX:    msg = m_modelCacheFsx.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::P3D:    msg = m_modelCacheP3D.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::XPLANE: msg = m_modelCacheXP.set(models, ts.toMSecsSinceEpoch()); break;
+        case CSimulatorInfo::FG:     msg = m_modelCacheFG.set(models, ts.toMSecsSinceEpoch()); break;
         default:
             Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
-            break;
+            return CStatusMessage();
         }
-        return CStatusMessage();
+        if (msg.isSuccess()) { this->writeBinarySnapshot(models, simulator, ts.toMSecsSinceEpoch()); }
+        return msg;
     }
 
     void CModelSetCaches::synchronizeCache(const CSimulatorInfo &simulator)
@@ -551,16 +704,20 @@ namespace BlackMisc::Simulation::Data
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
         if (this->isCacheAlreadySynchronized(simulator)) { return; }
-        switch (simulator.getSimulator())
+        if (!this->openBinarySnapshot(simulator))
         {
-        case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
-        case CSimulatorInfo::FSX:    m_modelCacheFsx.synchronize(); break;
-        case CSimulatorInfo::P3D:    m_modelCacheP3D.synchronize(); break;
-        case CSimulatorInfo::XPLANE: m_modelCacheXP.synchronize();  break;
-        case CSimulatorInfo::FG:     m_modelCacheFG.synchronize();  break;
-        default:
-            Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
-            break;
+            switch (simulator.getSimulator())
+            {
+            case CSimulatorInfo::FS9:    m_modelCacheFs9.synchronize(); break;
+            case CSimulatorInfo::FSX:    m_modelCacheFsx.synchronize(); break;
+            case CSimulatorInfo::P3D:    m_modelCacheP3D.synchronize(); break;
+            case CSimulatorInfo::XPLANE: m_modelCacheXP.synchronize();  break;
+            case CSimulatorInfo::FG:     m_modelCacheFG.synchronize();  break;
+            default:
+                Q_ASSERT_X(false, Q_FUNC_INFO, "Wrong simulator");
+                break;
+            }
+            this->writeBinarySnapshot(this->getCachedModels(simulator), simulator, this->getCacheTimestamp(simulator).toMSecsSinceEpoch());
         }
         this->markCacheAsAlreadySynchronized(simulator, true);
         this->emitCacheChanged(simulator); // sync
@@ -571,6 +728,7 @@ namespace BlackMisc::Simulation::Data
         Q_ASSERT_X(simulator.isSingleSimulator(), Q_FUNC_INFO, "No single simulator");
 
         if (this->isCacheAlreadySynchronized(simulator)) { return false; }
+        if (this->hasBinarySnapshot(simulator)) { return false; }
         switch (simulator.getSimulator())
         {
         case CSimulatorInfo::FS9:    m_modelCacheFs9.admit(); break;
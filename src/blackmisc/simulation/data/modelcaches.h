@@ -11,6 +11,7 @@
 #ifndef BLACKMISC_SIMULATION_DATA_MODELCACHES
 #define BLACKMISC_SIMULATION_DATA_MODELCACHES
 
+#include "blackmisc/simulation/data/modelbinaryfile.h"
 #include "blackmisc/simulation/aircraftmodelinterfaces.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/simulatorinfo.h"
@@ -21,8 +22,11 @@
 #include "blackmisc/blackmiscexport.h"
 
 #include <QDateTime>
+#include <QMutex>
 #include <QObject>
 #include <atomic>
+#include <map>
+#include <memory>
 
 namespace BlackMisc::Simulation::Data
 {
@@ -184,6 +188,14 @@ namespace BlackMisc::Simulation::Data
         //! Count of models for simulator
         int getCachedModelsCount(const CSimulatorInfo &simulator) const;
 
+        //! Model strings of the models for simulator
+        //! \remark with a binary snapshot read from the mapped file, the models are not materialized
+        QStringList getCachedModelStrings(const CSimulatorInfo &simulator) const;
+
+        //! Model with model string (case insensitive) for simulator?
+        //! \remark with a binary snapshot read from the mapped file, the models are not materialized
+        bool containsCachedModelString(const CSimulatorInfo &simulator, const QString &modelString) const;
+
         //! Get filename for simulator cache file
         virtual QString getFilename(const CSimulatorInfo &simulator) const = 0;
 
@@ -269,6 +281,15 @@ namespace BlackMisc::Simulation::Data
         //! Descriptive text
         virtual QString getDescription() const = 0;
 
+        //! Binary snapshot file for simulator, stored next to the JSON cache file
+        QString getBinaryFilename(const CSimulatorInfo &simulator) const;
+
+        //! Use binary snapshots?
+        bool isUsingBinarySnapshots() const { return m_useBinarySnapshots; }
+
+        //! Use binary snapshots, the JSON cache files are always written
+        void setUsingBinarySnapshots(bool use) { m_useBinarySnapshots = use; }
+
     signals:
         //! Cache has been changed
         //! \note this detects caches changed elsewhere or set here (the normal caches detect only "elsewhere"
@@ -281,13 +302,16 @@ namespace BlackMisc::Simulation::Data
 
         //! Cache has been changed. This will only detect changes elsewhere, owned caches will not signal local changes
         //! @{
-        void changedFsx() { this->emitCacheChanged(CSimulatorInfo::fsx()); }
-        void changedFs9() { this->emitCacheChanged(CSimulatorInfo::fs9()); }
-        void changedP3D() { this->emitCacheChanged(CSimulatorInfo::p3d()); }
-        void changedXP()  { this->emitCacheChanged(CSimulatorInfo::xplane()); }
-        void changedFG()  { this->emitCacheChanged(CSimulatorInfo::fg()); }
+        void changedFsx() { this->changedElsewhere(CSimulatorInfo::fsx()); }
+        void changedFs9() { this->changedElsewhere(CSimulatorInfo::fs9()); }
+        void changedP3D() { this->changedElsewhere(CSimulatorInfo::p3d()); }
+        void changedXP()  { this->changedElsewhere(CSimulatorInfo::xplane()); }
+        void changedFG()  { this->changedElsewhere(CSimulatorInfo::fg()); }
         //! @}
 
+        //! Cache has been changed elsewhere, a binary snapshot is outdated
+        void changedElsewhere(const CSimulatorInfo &simulator);
+
         //! Is the cache already synchronized?
         //! \threadsafe
         void markCacheAsAlreadySynchronized(const CSimulatorInfo &simulator, bool synchronized);
@@ -295,6 +319,33 @@ namespace BlackMisc::Simulation::Data
         //! Emit cacheChanged() utility function (allows breakpoint)
         void emitCacheChanged(const CSimulatorInfo &simulator);
 
+        //! \name Binary snapshots
+        //! A binary snapshot (CModelBinaryFile) is written whenever models are set or loaded from the JSON cache.
+        //! If its timestamp matches the cache timestamp, it is opened memory-mapped instead of synchronizing the JSON cache.
+        //! @{
+
+        //! Open the snapshot if it matches the cache timestamp
+        //! \threadsafe
+        bool openBinarySnapshot(const CSimulatorInfo &simulator);
+
+        //! Write the snapshot for the given models
+        //! \threadsafe
+        void writeBinarySnapshot(const CAircraftModelList &models, const CSimulatorInfo &simulator, qint64 timestamp);
+
+        //! Close the snapshot
+        //! \threadsafe
+        void dropBinarySnapshot(const CSimulatorInfo &simulator);
+
+        //! Is a snapshot open?
+        //! \threadsafe
+        bool hasBinarySnapshot(const CSimulatorInfo &simulator) const;
+
+        //! Models of the open snapshot, materialized with the first call
+        //! \remark only needed for the complete list (getCachedModels), count, model strings and model string lookups use the mapped file
+        //! \threadsafe
+        bool getBinarySnapshotModels(const CSimulatorInfo &simulator, CAircraftModelList &models) const;
+        //! @}
+
         //! Cache synchronized flag
         //! @{
         std::atomic_bool m_syncFsx { false };
@@ -303,6 +354,19 @@ namespace BlackMisc::Simulation::Data
         std::atomic_bool m_syncFG  { false };
         std::atomic_bool m_syncXPlane { false };
         //! @}
+
+    private:
+        //! Open snapshot and its models once materialized
+        struct BinarySnapshot
+        {
+            std::unique_ptr<CModelBinaryFile> file; //!< mapped file
+            CAircraftModelList models;              //!< materialized models
+            bool materialized = false;              //!< models materialized
+        };
+
+        std::atomic_bool m_useBinarySnapshots { true };           //!< use binary snapshots
+        mutable QMutex m_binarySnapshotsMutex;                   //!< guards m_binarySnapshots
+        mutable std::map<int, BinarySnapshot> m_binarySnapshots; //!< snapshots by simulator
     };
 
     //! Bundle of caches for all simulators
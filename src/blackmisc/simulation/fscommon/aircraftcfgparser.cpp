@@ -9,28 +9,36 @@
 #include "blackmisc/simulation/fscommon/aircraftcfgentries.h"
 #include "blackmisc/simulation/fscommon/aircraftcfgparser.h"
 #include "blackmisc/simulation/fscommon/fsdirectories.h"
+#include "blackmisc/datacache.h"
 #include "blackmisc/fileutils.h"
+#include "blackmisc/jsonexception.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/statusmessagelist.h"
+#include "blackmisc/threadutils.h"
 #include "blackmisc/worker.h"
 #include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileInfoList>
 #include <QFlags>
 #include <QIODevice>
+#include <QJsonObject>
 #include <QList>
 #include <QMetaType>
+#include <QMutexLocker>
+#include <QSet>
 #include <QSettings>
 #include <QTextStream>
 #include <Qt>
 #include <QtGlobal>
 #include <atomic>
 #include <tuple>
+#include <vector>
 #include <QStringView>
 
 using namespace BlackConfig;
@@ -129,28 +137,188 @@ namespace BlackMisc::Simulation::FsCommon
 
     CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QStringList &directories, const QStringList &excludeDirectories, CStatusMessageList &messages)
     {
+        //
+        // function has to be threadsafe
+        //
+
+        QElapsedTimer time;
+        time.start();
+        const QStringList fileNames = this->findCfgFiles(directories, excludeDirectories, messages);
+        if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+
+        // the index is only changed here, while the workers run it is read only
+        QMutexLocker lock(&m_fileIndexMutex);
+        const bool incremental = m_incrementalParsing;
+        if (incremental && !m_fileIndexLoaded)
+        {
+            m_fileIndex.load(this->getFileIndexFileName());
+            m_fileIndexLoaded = true;
+        }
+
+        struct FileResult
+        {
+            CAircraftCfgEntriesList entries;
+            CStatusMessageList messages;
+            CFileIndex::Entry indexEntry;
+            qint64 savedNs = 0;
+            bool ok = false;
+            bool reused = false;
+            bool updateIndex = false;
+        };
+
+        std::vector<FileResult> results(static_cast<size_t>(fileNames.size()));
+        CThreadUtils::forEachIndex(fileNames.size(), m_parallelParsing, [&](int index)
+        {
+            if (m_cancelLoading) { return; }
+            FileResult &r = results[static_cast<size_t>(index)];
+            const QFileInfo fileInfo(CFileUtils::fixWindowsUncPath(fileNames[index]));
+            const QString fileName = fileInfo.absoluteFilePath();
+
+            QByteArray content;
+            if (incremental)
+            {
+                const CFileIndex::FileState state = m_fileIndex.checkFile(fileInfo, content);
+                if (CFileIndex::isUnchanged(state))
+                {
+                    const CFileIndex::Entry *indexed = m_fileIndex.find(fileName);
+                    try
+                    {
+                        r.entries.convertFromJson(indexed->data.value("entries").toObject());
+                        r.savedNs = static_cast<qint64>(indexed->data.value("parseNs").toDouble());
+                        r.ok = r.reused = true;
+                        if (state == CFileIndex::UnchangedContent)
+                        {
+                            // same content, but the file was touched
+                            const QDateTime ts = fileTimestamp(fileInfo);
+                            for (CAircraftCfgEntries &e : r.entries) { e.setUtcTimestamp(ts); }
+                            r.indexEntry = CFileIndex::createEntry(fileInfo, content, indexed->data);
+                            r.updateIndex = true;
+                        }
+                        return;
+                    }
+                    catch (const CJsonException &)
+                    {
+                        r.entries.clear(); // corrupt index entry, parse the file
+                    }
+                }
+            }
+
+            QElapsedTimer parseTime;
+            parseTime.start();
+            if (content.isEmpty())
+            {
+                QFile file(fileName);
+                if (!file.open(QFile::ReadOnly))
+                {
+                    const CStatusMessage m = CStatusMessage(this).warning(u"Unable to read file '%1'") << fileName;
+                    r.messages.push_back(m);
+                    return;
+                }
+                content = file.readAll();
+            }
+
+            r.entries = CAircraftCfgParser::performParsingOfSingleFile(fileName, content, r.ok, r.messages);
+            if (r.ok && incremental)
+            {
+                QJsonObject data;
+                data.insert("entries", r.entries.toJson());
+                data.insert("parseNs", static_cast<double>(parseTime.nsecsElapsed()));
+                r.indexEntry = CFileIndex::createEntry(fileInfo, content, data);
+                r.updateIndex = true;
+            }
+        });
+        if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+
+        // merge in the order the files were found
         CAircraftCfgEntriesList entries;
-        for (const QString &dir : directories)
+        QSet<QString> indexedFiles;
+        int parsed = 0;
+        int reused = 0;
+        int indexChanges = 0;
+        qint64 savedNs = 0;
+        for (int i = 0; i < fileNames.size(); ++i)
+        {
+            const FileResult &r = results[static_cast<size_t>(i)];
+            if (!r.ok)
+            {
+                const CStatusMessage m = CStatusMessage(this).warning(u"Parsing of '%1' failed") << fileNames[i];
+                messages.push_back(r.messages);
+                messages.push_back(m);
+                continue;
+            }
+
+            entries.push_back(r.entries);
+            if (r.reused) { reused++; savedNs += r.savedNs; }
+            else { parsed++; }
+
+            if (!incremental) { continue; }
+            const QString fileName = QFileInfo(CFileUtils::fixWindowsUncPath(fileNames[i])).absoluteFilePath();
+            indexedFiles.insert(fileName);
+            if (r.updateIndex)
+            {
+                m_fileIndex.insert(fileName, r.indexEntry);
+                indexChanges++;
+            }
+        }
+
+        if (incremental)
         {
-            entries.push_back(this->performParsing(dir, excludeDirectories, messages));
+            indexChanges += m_fileIndex.retainOnly(indexedFiles);
+            if (indexChanges > 0 && !m_fileIndex.save(this->getFileIndexFileName()))
+            {
+                const CStatusMessage m = CStatusMessage(this).warning(u"Unable to write aircraft.cfg index '%1'") << this->getFileIndexFileName();
+                messages.push_back(m);
+            }
         }
+
+        const qint64 ms = time.elapsed();
+        const double filesPerSecond = fileNames.size() * 1000.0 / qMax<qint64>(1, ms);
+        const CStatusMessage m = CStatusMessage(this).info(u"Scanned %1 cfg files in %2ms (%3 files/s): %4 parsed, %5 unchanged, about %6ms saved") <<
+                                 fileNames.size() << ms << QString::number(filesPerSecond, 'f', 1) << parsed << reused << (savedNs / 1000000);
+        messages.push_back(m); // reported with the loading messages, not logged twice
         return entries;
     }
 
-    CAircraftCfgEntriesList CAircraftCfgParser::performParsing(const QString &directory, const QStringList &excludeDirectories, CStatusMessageList &messages)
+    QStringList CAircraftCfgParser::findCfgFiles(const QStringList &directories, const QStringList &excludeDirectories, CStatusMessageList &messages)
+    {
+        QStringList fileNames;
+        for (const QString &directory : directories)
+        {
+            // sub directories are walked in parallel, results merged in the original order
+            QStringList subDirectories;
+            fileNames += this->findCfgFiles(directory, excludeDirectories, messages, &subDirectories);
+
+            std::vector<QStringList> subFileNames(static_cast<size_t>(subDirectories.size()));
+            std::vector<CStatusMessageList> subMessages(subFileNames.size());
+            CThreadUtils::forEachIndex(subDirectories.size(), m_parallelParsing, [&](int index)
+            {
+                const size_t i = static_cast<size_t>(index);
+                subFileNames[i] = this->findCfgFiles(subDirectories[index], excludeDirectories, subMessages[i]);
+            });
+
+            for (size_t i = 0; i < subFileNames.size(); ++i)
+            {
+                messages.push_back(subMessages[i]);
+                fileNames += subFileNames[i];
+            }
+        }
+        return fileNames;
+    }
+
+    QStringList CAircraftCfgParser::findCfgFiles(const QString &directory, const QStringList &excludeDirectories, CStatusMessageList &messages, QStringList *subDirectories)
     {
         //
         // function has to be threadsafe
         //
 
-        if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+        if (m_cancelLoading) { return {}; }
 
         // excluded?
         if (CFileUtils::isExcludedDirectory(directory, excludeDirectories) || isExcludedSubDirectory(directory))
         {
             const CStatusMessage m = CStatusMessage(this).info(u"Skipping directory '%1' (excluded)") << directory;
             messages.push_back(m);
-            return CAircraftCfgEntriesList();
+            return {};
         }
 
         // set directory with name filters, get aircraft.cfg and sub directories
@@ -159,11 +327,11 @@ namespace BlackMisc::Simulation::FsCommon
         dir.setNameFilters(fileNameFilters());
         if (!dir.exists())
         {
-            return CAircraftCfgEntriesList(); // can happen if there are shortcuts or linked dirs not available
+            return {}; // can happen if there are shortcuts or linked dirs not available
         }
 
         const QString currentDir = dir.absolutePath();
-        CAircraftCfgEntriesList result;
+        QStringList fileNames;
         emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing '%1'").arg(currentDir), -1);
 
         // Dirs last is crucial, since I will break recursion on "aircraft.cfg" level
@@ -184,23 +352,19 @@ namespace BlackMisc::Simulation::FsCommon
 
         for (const auto &fileInfo : files)
         {
-            if (m_cancelLoading) { return CAircraftCfgEntriesList(); }
+            if (m_cancelLoading) { return {}; }
             if (fileInfo.isDir())
             {
                 const QString nextDir = fileInfo.absoluteFilePath();
                 if (currentDir.startsWith(nextDir, Qt::CaseInsensitive)) { continue; } // do not go up
                 if (dir == currentDir) { continue; } // do not recursively call same directory
 
-                const CAircraftCfgEntriesList subList(performParsing(nextDir, excludeDirectories, messages));
-                if (messages.isSuccess())
+                if (subDirectories)
                 {
-                    result.push_back(subList);
-                }
-                else
-                {
-                    const CStatusMessage m = CStatusMessage(this).warning(u"Parsing failed for '%1'") << nextDir;
-                    messages.push_back(m);
+                    subDirectories->push_back(nextDir);
+                    continue;
                 }
+                fileNames += this->findCfgFiles(nextDir, excludeDirectories, messages);
             }
             else
             {
@@ -208,38 +372,34 @@ namespace BlackMisc::Simulation::FsCommon
                 if (getSimulator().isP3D() && !hasAirFiles) { continue; }
 
                 // due to the filter we expect only "aircraft.cfg"/"sim.cfg" here
-                // remark: in a 1st version I have used QSettings to parse to file as ini file
-                // unfortunately some files are malformed which could end up in wrong data
-
-                const QString fileName = fileInfo.absoluteFilePath(); // full path and name
-                bool fileOk = false;
-                CStatusMessageList fileMsgs;
-                const CAircraftCfgEntriesList fileResults = CAircraftCfgParser::performParsingOfSingleFile(fileName, fileOk, fileMsgs);
-                if (!fileOk)
-                {
-                    const CStatusMessage m = CStatusMessage(this).warning(u"Parsing of '%1' failed") << fileName;
-                    messages.push_back(fileMsgs);
-                    continue;
-                }
-
-                result.push_back(fileResults);
-
-                // With T514 we do not skip not anymore
-                // return result; // do not go any deeper in file tree, we found aircraft.cfg
+                // With T514 we do not stop at this level anymore
+                fileNames.push_back(fileInfo.absoluteFilePath()); // full path and name
             }
         }
 
         // all files finished,
         // normally reached when no aircraft.cfg is found
-        return result;
+        return fileNames;
     }
 
-    CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs)
+    QString CAircraftCfgParser::getFileIndexFileName() const
     {
-        // due to the filter we expect only "aircraft.cfg" files here
-        // remark: in a 1st version I have used QSettings to parse to file as ini file
-        // unfortunately some files are malformed which could end up in wrong data
+        const QString simulator = removeChars(this->getSimulator().toQString().toLower(), [](QChar c) { return !c.isLetterOrNumber(); });
+        return CFileUtils::appendFilePaths(CDataCache::persistentStore(), QStringLiteral("aircraftcfgindex_%1.json").arg(simulator));
+    }
 
+    QDateTime CAircraftCfgParser::fileTimestamp(const QFileInfo &fileInfo)
+    {
+        QDateTime timestamp(fileInfo.lastModified());
+        if (!timestamp.isValid() || fileInfo.birthTime() > timestamp)
+        {
+            timestamp = fileInfo.birthTime();
+        }
+        return timestamp;
+    }
+
+    CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs)
+    {
         ok = false;
         const QString fnFixed = CFileUtils::fixWindowsUncPath(fileName);
         QFile file(fnFixed); // includes path
@@ -249,8 +409,18 @@ namespace BlackMisc::Simulation::FsCommon
             msgs.push_back(m);
             return CAircraftCfgEntriesList();
         }
+        return performParsingOfSingleFile(fileName, file.readAll(), ok, msgs);
+    }
 
-        QTextStream in(&file);
+    CAircraftCfgEntriesList CAircraftCfgParser::performParsingOfSingleFile(const QString &fileName, const QByteArray &content, bool &ok, CStatusMessageList &msgs)
+    {
+        // due to the filter we expect only "aircraft.cfg" files here
+        // remark: in a 1st version I have used QSettings to parse to file as ini file
+        // unfortunately some files are malformed which could end up in wrong data
+
+        ok = false;
+        const QString fnFixed = CFileUtils::fixWindowsUncPath(fileName);
+        QTextStream in(content);
         QList<CAircraftCfgEntries> tempEntries;
 
         // parse through the file
@@ -373,16 +543,10 @@ namespace BlackMisc::Simulation::FsCommon
             case Unknown: break;
             }
         } // all lines
-        file.close();
 
         // store all entries
-        const QFileInfo fileInfo(fnFixed);
-        QDateTime fileTimestamp(fileInfo.lastModified());
-        if (!fileTimestamp.isValid() || fileInfo.birthTime() > fileTimestamp)
-        {
-            fileTimestamp = fileInfo.birthTime();
-        }
-        Q_ASSERT_X(fileTimestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
+        const QDateTime timestamp = fileTimestamp(QFileInfo(fnFixed));
+        Q_ASSERT_X(timestamp.isValid(), Q_FUNC_INFO, "Missing file timestamp");
 
         CAircraftCfgEntriesList result;
         for (const CAircraftCfgEntries &e : std::as_const(tempEntries))
@@ -396,7 +560,7 @@ namespace BlackMisc::Simulation::FsCommon
             CAircraftCfgEntries newEntries(e);
             newEntries.setAtcModel(atcModel);
             newEntries.setAtcType(atcType);
-            newEntries.setUtcTimestamp(fileTimestamp);
+            newEntries.setUtcTimestamp(timestamp);
             result.push_back(newEntries);
         }
         ok = true;
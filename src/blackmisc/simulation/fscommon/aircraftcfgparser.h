@@ -16,12 +16,16 @@
 #include "blackmisc/simulation/aircraftmodelloader.h"
 #include "blackmisc/simulation/fscommon/aircraftcfgentrieslist.h"
 #include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/fileindex.h"
 
+#include <QDateTime>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QVariant>
+#include <atomic>
 #include <memory>
 
 class QSettings;
@@ -54,6 +58,24 @@ namespace BlackMisc
             //! Parse a single file
             static CAircraftCfgEntriesList performParsingOfSingleFile(const QString &fileName, bool &ok, CStatusMessageList &msgs);
 
+            //! Parse a single file from its already read content
+            static CAircraftCfgEntriesList performParsingOfSingleFile(const QString &fileName, const QByteArray &content, bool &ok, CStatusMessageList &msgs);
+
+            //! Walk the directories and parse the files in parallel?
+            bool isParallelParsing() const { return m_parallelParsing; }
+
+            //! Walk the directories and parse the files in parallel
+            void setParallelParsing(bool parallel) { m_parallelParsing = parallel; }
+
+            //! Only parse files changed since the last scan?
+            bool isIncrementalParsing() const { return m_incrementalParsing; }
+
+            //! Only parse files changed since the last scan, the others are taken from the file index
+            void setIncrementalParsing(bool incremental) { m_incrementalParsing = incremental; }
+
+            //! File where the index of the parsed files is stored
+            QString getFileIndexFileName() const;
+
             //! Create an parser object for given simulator
             static CAircraftCfgParser *createModelLoader(const CSimulatorInfo &simInfo, QObject *parent = nullptr);
 
@@ -78,12 +100,22 @@ namespace BlackMisc
                 const QStringList &directories, const QStringList &excludeDirectories,
                 BlackMisc::CStatusMessageList &messages);
 
-            //! Perform the parsing for one directory
+            //! Find the cfg files of one directory
+            //! \remark sub directories are walked recursively, or returned in subDirectories if not nullptr
             //! \threadsafe
-            CAircraftCfgEntriesList performParsing(
+            QStringList findCfgFiles(
                 const QString &directory, const QStringList &excludeDirectories,
+                BlackMisc::CStatusMessageList &messages, QStringList *subDirectories = nullptr);
+
+            //! Find the cfg files of all directories, sub directories of the given directories are walked in parallel
+            //! \threadsafe
+            QStringList findCfgFiles(
+                const QStringList &directories, const QStringList &excludeDirectories,
                 BlackMisc::CStatusMessageList &messages);
 
+            //! Timestamp used for the entries of a file
+            static QDateTime fileTimestamp(const QFileInfo &fileInfo);
+
             //! Fix the content read
             static QString fixedStringContent(const QVariant &qv);
 
@@ -101,6 +133,11 @@ namespace BlackMisc
 
             CAircraftCfgEntriesList      m_parsedCfgEntriesList; //!< parsed entries
             QPointer<BlackMisc::CWorker> m_parserWorker;         //!< worker will destroy itself, so weak pointer
+            std::atomic_bool             m_parallelParsing    { true }; //!< parse the files in parallel threads
+            std::atomic_bool             m_incrementalParsing { true }; //!< reuse the entries of unchanged files from m_fileIndex
+            BlackMisc::CFileIndex        m_fileIndex;            //!< index of the parsed files, guarded by m_fileIndexMutex
+            bool                         m_fileIndexLoaded = false; //!< m_fileIndex loaded from file
+            QMutex                       m_fileIndexMutex;       //!< guards m_fileIndex, m_fileIndexLoaded
         };
     } // ns
 } // ns
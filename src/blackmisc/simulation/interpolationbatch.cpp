@@ -0,0 +1,319 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/interpolationbatch.h"
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define BLACKMISC_INTERPOLATIONBATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define BLACKMISC_INTERPOLATIONBATCH_SSE2
+#endif
+
+namespace BlackMisc::Simulation
+{
+    namespace
+    {
+        //! \private Scalar lane, fallback and tail of the vectorized loops
+        struct LaneScalar
+        {
+            using V = double;
+            using M = bool;
+            static constexpr size_t Width = 1;
+            static V load(const double *p) { return *p; }
+            static void store(double *p, V v) { *p = v; }
+            static V set1(double d) { return d; }
+            static V add(V a, V b) { return a + b; }
+            static V sub(V a, V b) { return a - b; }
+            static V mul(V a, V b) { return a * b; }
+            static V div(V a, V b) { return a / b; }
+            static V min(V a, V b) { return a < b ? a : b; } // second value if NaN, like minpd
+            static V max(V a, V b) { return a > b ? a : b; } // second value if NaN, like maxpd
+            static M greater(V a, V b) { return a > b; }
+            static M less(V a, V b) { return a < b; }
+            static M both(M a, M b) { return a && b; }
+            static V select(M m, V ifTrue, V ifFalse) { return m ? ifTrue : ifFalse; }
+        };
+
+#if defined(BLACKMISC_INTERPOLATIONBATCH_AVX2)
+        //! \private 4 doubles
+        struct LaneSimd
+        {
+            using V = __m256d;
+            using M = __m256d;
+            static constexpr size_t Width = 4;
+            static V load(const double *p) { return _mm256_loadu_pd(p); }
+            static void store(double *p, V v) { _mm256_storeu_pd(p, v); }
+            static V set1(double d) { return _mm256_set1_pd(d); }
+            static V add(V a, V b) { return _mm256_add_pd(a, b); }
+            static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+            static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+            static V div(V a, V b) { return _mm256_div_pd(a, b); }
+            static V min(V a, V b) { return _mm256_min_pd(a, b); }
+            static V max(V a, V b) { return _mm256_max_pd(a, b); }
+            static M greater(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+            static M less(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+            static M both(M a, M b) { return _mm256_and_pd(a, b); }
+            static V select(M m, V ifTrue, V ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, m); }
+        };
+#elif defined(BLACKMISC_INTERPOLATIONBATCH_SSE2)
+        //! \private 2 doubles
+        struct LaneSimd
+        {
+            using V = __m128d;
+            using M = __m128d;
+            static constexpr size_t Width = 2;
+            static V load(const double *p) { return _mm_loadu_pd(p); }
+            static void store(double *p, V v) { _mm_storeu_pd(p, v); }
+            static V set1(double d) { return _mm_set1_pd(d); }
+            static V add(V a, V b) { return _mm_add_pd(a, b); }
+            static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+            static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+            static V div(V a, V b) { return _mm_div_pd(a, b); }
+            static V min(V a, V b) { return _mm_min_pd(a, b); }
+            static V max(V a, V b) { return _mm_max_pd(a, b); }
+            static M greater(V a, V b) { return _mm_cmpgt_pd(a, b); }
+            static M less(V a, V b) { return _mm_cmplt_pd(a, b); }
+            static M both(M a, M b) { return _mm_and_pd(a, b); }
+            static V select(M m, V ifTrue, V ifFalse) { return _mm_or_pd(_mm_and_pd(m, ifTrue), _mm_andnot_pd(m, ifFalse)); }
+        };
+#else
+        //! \private No SIMD available
+        using LaneSimd = LaneScalar;
+#endif
+
+        //! \private Time fraction between samples 1 and 2 clamped to 0..1, 1 if the samples have no time difference
+        template <class L>
+        typename L::V timeFraction(const InterpolationBatch &batch, size_t i)
+        {
+            const typename L::V zero = L::set1(0.0);
+            const typename L::V one  = L::set1(1.0);
+            const typename L::V t1 = L::load(&batch.samples[1].t[i]);
+            const typename L::V t2 = L::load(&batch.samples[2].t[i]);
+            const typename L::V dt = L::sub(t2, t1);
+            const typename L::V tf = L::div(L::sub(L::set1(batch.currentTimeMs), t1), dt);
+            return L::select(L::greater(dt, zero), L::max(L::min(tf, one), zero), one);
+        }
+
+        //! \private (new - old) * tf + old
+        template <class L>
+        typename L::V lerp(typename L::V oldValue, typename L::V newValue, typename L::V tf)
+        {
+            return L::add(L::mul(L::sub(newValue, oldValue), tf), oldValue);
+        }
+
+        //! \private Angle interpolation in the shorter direction, as CInterpolatorPbh::interpolateAngle
+        template <class L>
+        typename L::V lerpAngleDeg(typename L::V oldDeg, typename L::V newDeg, typename L::V tf)
+        {
+            typename L::V delta = L::sub(newDeg, oldDeg);
+            delta = L::select(L::greater(delta, L::set1(180.0)),  L::sub(delta, L::set1(360.0)), delta);
+            delta = L::select(L::less(delta,    L::set1(-180.0)), L::add(delta, L::set1(360.0)), delta);
+            return L::add(oldDeg, L::mul(delta, tf));
+        }
+
+        //! \private PBH and ground speed between samples 1 and 2, as CInterpolatorPbh
+        template <class L>
+        void storePbh(const InterpolationBatch &batch, InterpolationBatchResult &result, size_t i, typename L::V tf)
+        {
+            const InterpolationBatch::Samples &o = batch.samples[1];
+            const InterpolationBatch::Samples &n = batch.samples[2];
+            L::store(&result.headingDeg[i],  lerpAngleDeg<L>(L::load(&o.headingDeg[i]), L::load(&n.headingDeg[i]), tf));
+            L::store(&result.pitchDeg[i],    lerpAngleDeg<L>(L::load(&o.pitchDeg[i]),   L::load(&n.pitchDeg[i]),   tf));
+            L::store(&result.bankDeg[i],     lerpAngleDeg<L>(L::load(&o.bankDeg[i]),    L::load(&n.bankDeg[i]),    tf));
+            L::store(&result.groundSpeed[i], lerp<L>(L::load(&o.groundSpeed[i]), L::load(&n.groundSpeed[i]), tf));
+        }
+
+        //! \private Linear kernel for [begin, end) in steps of the lane width
+        //! \return first index not interpolated
+        template <class L>
+        size_t linearKernel(const InterpolationBatch &batch, InterpolationBatchResult &result, size_t begin, size_t end)
+        {
+            const InterpolationBatch::Samples &o = batch.samples[1];
+            const InterpolationBatch::Samples &n = batch.samples[2];
+            size_t i = begin;
+            for (; i + L::Width <= end; i += L::Width)
+            {
+                const typename L::V tf = timeFraction<L>(batch, i);
+                L::store(&result.timeFraction[i], tf);
+                L::store(&result.x[i], lerp<L>(L::load(&o.x[i]), L::load(&n.x[i]), tf));
+                L::store(&result.y[i], lerp<L>(L::load(&o.y[i]), L::load(&n.y[i]), tf));
+                L::store(&result.z[i], lerp<L>(L::load(&o.z[i]), L::load(&n.z[i]), tf));
+                L::store(&result.altitude[i], lerp<L>(L::load(&o.altitude[i]), L::load(&n.altitude[i]), tf));
+                storePbh<L>(batch, result, i, tf);
+            }
+            return i;
+        }
+
+        //! \private Coefficients of the tridiagonal system for 3 samples, the same for all values of an aircraft
+        template <class L>
+        struct SplineCoefficients
+        {
+            typename L::V r0;     //!< 1 / (t1 - t0)
+            typename L::V r1;     //!< 1 / (t2 - t1)
+            typename L::V h1;     //!< t2 - t1
+            typename L::V denom1; //!< row 1 after forward sweep
+            typename L::V c1;     //!< superdiagonal row 1 after forward sweep
+            typename L::V denom2; //!< row 2 after forward sweep
+        };
+
+        //! \private Spline value between samples 1 and 2
+        //! \remark derivatives as getDerivatives/solveTridiagonal with N = 3 in interpolatorspline.cpp, then evalSplineInterval
+        template <class L>
+        typename L::V splineValue(const SplineCoefficients<L> &c, typename L::V y0, typename L::V y1, typename L::V y2, typename L::V tf)
+        {
+            const typename L::V three = L::set1(3.0);
+            const typename L::V dy0 = L::sub(y1, y0);
+            const typename L::V dy1 = L::sub(y2, y1);
+            const typename L::V b0 = L::mul(three, L::mul(dy0, L::mul(c.r0, c.r0)));
+            const typename L::V b2 = L::mul(three, L::mul(dy1, L::mul(c.r1, c.r1)));
+            const typename L::V b1 = L::add(b0, b2);
+
+            // forward sweep and back substitution, only the derivatives k1, k2 are needed
+            const typename L::V d0 = L::mul(L::set1(1.5), L::mul(dy0, c.r0)); // b0 / (2 r0)
+            const typename L::V d1 = L::div(L::sub(b1, L::mul(c.r0, d0)), c.denom1);
+            const typename L::V k2 = L::div(L::sub(b2, L::mul(c.r1, d1)), c.denom2);
+            const typename L::V k1 = L::sub(d1, L::mul(c.c1, k2));
+
+            // y = (1 - t) * y1 + t * y2 + t * (1 - t) * (a * (1 - t) + b * t)
+            const typename L::V u = L::sub(L::set1(1.0), tf);
+            const typename L::V a = L::sub(L::mul(k1, c.h1), dy1);
+            const typename L::V b = L::add(L::mul(L::sub(L::set1(0.0), k2), c.h1), dy1);
+            const typename L::V cubic = L::mul(L::mul(tf, u), L::add(L::mul(a, u), L::mul(b, tf)));
+            return L::add(L::add(L::mul(u, y1), L::mul(tf, y2)), cubic);
+        }
+
+        //! \private Spline kernel for [begin, end) in steps of the lane width
+        //! \return first index not interpolated
+        template <class L>
+        size_t splineKernel(const InterpolationBatch &batch, InterpolationBatchResult &result, size_t begin, size_t end)
+        {
+            const InterpolationBatch::Samples &s0 = batch.samples[0];
+            const InterpolationBatch::Samples &s1 = batch.samples[1];
+            const InterpolationBatch::Samples &s2 = batch.samples[2];
+            const typename L::V zero = L::set1(0.0);
+            const typename L::V one  = L::set1(1.0);
+            const typename L::V two  = L::set1(2.0);
+            size_t i = begin;
+            for (; i + L::Width <= end; i += L::Width)
+            {
+                const typename L::V t0 = L::load(&s0.t[i]);
+                const typename L::V t1 = L::load(&s1.t[i]);
+                const typename L::V t2 = L::load(&s2.t[i]);
+                const typename L::V h0 = L::sub(t1, t0);
+                const typename L::V h1 = L::sub(t2, t1);
+                const typename L::M ordered = L::both(L::greater(h0, zero), L::greater(h1, zero));
+
+                SplineCoefficients<L> c;
+                c.r0 = L::div(one, h0);
+                c.r1 = L::div(one, h1);
+                c.h1 = h1;
+                c.denom1 = L::add(L::mul(L::set1(1.5), c.r0), L::mul(two, c.r1)); // 2/h0 + 2/h1 - 1/h0 * 0.5
+                c.c1 = L::div(c.r1, c.denom1);
+                c.denom2 = L::sub(L::mul(two, c.r1), L::mul(c.r1, c.c1));
+
+                const typename L::V tf = timeFraction<L>(batch, i);
+                L::store(&result.timeFraction[i], tf);
+
+                const auto value = [&](const std::vector<double> &v0, const std::vector<double> &v1, const std::vector<double> &v2)
+                {
+                    const typename L::V y1 = L::load(&v1[i]);
+                    const typename L::V y2 = L::load(&v2[i]);
+                    return L::select(ordered, splineValue<L>(c, L::load(&v0[i]), y1, y2, tf), lerp<L>(y1, y2, tf));
+                };
+                L::store(&result.x[i], value(s0.x, s1.x, s2.x));
+                L::store(&result.y[i], value(s0.y, s1.y, s2.y));
+                L::store(&result.z[i], value(s0.z, s1.z, s2.z));
+                L::store(&result.altitude[i], value(s0.altitude, s1.altitude, s2.altitude));
+                storePbh<L>(batch, result, i, tf);
+            }
+            return i;
+        }
+    } // anonymous
+
+    void InterpolationBatch::Samples::resize(size_t count)
+    {
+        t.resize(count);
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        altitude.resize(count);
+        headingDeg.resize(count);
+        pitchDeg.resize(count);
+        bankDeg.resize(count);
+        groundSpeed.resize(count);
+    }
+
+    void InterpolationBatch::resize(int count)
+    {
+        for (Samples &s : samples) { s.resize(static_cast<size_t>(qMax(0, count))); }
+    }
+
+    void InterpolationBatch::setAircraft(int index, const CompactSituation &oldest, const CompactSituation &older, const CompactSituation &latest)
+    {
+        Q_ASSERT_X(index >= 0 && index < this->size(), Q_FUNC_INFO, "index");
+        const size_t i = static_cast<size_t>(index);
+        const std::array<const CompactSituation *, 3> situations {{ &oldest, &older, &latest }};
+        for (size_t s = 0; s < samples.size(); ++s)
+        {
+            const CompactSituation &cs = *situations[s];
+            samples[s].t[i] = static_cast<double>(cs.adjustedMsSinceEpoch);
+            samples[s].x[i] = cs.normalVector[0];
+            samples[s].y[i] = cs.normalVector[1];
+            samples[s].z[i] = cs.normalVector[2];
+            samples[s].altitude[i] = cs.altitudeM;
+            samples[s].headingDeg[i] = cs.headingDeg;
+            samples[s].pitchDeg[i] = cs.pitchDeg;
+            samples[s].bankDeg[i] = cs.bankDeg;
+            samples[s].groundSpeed[i] = cs.groundSpeedMps;
+        }
+    }
+
+    void InterpolationBatchResult::resize(int count)
+    {
+        const size_t c = static_cast<size_t>(qMax(0, count));
+        timeFraction.resize(c);
+        x.resize(c);
+        y.resize(c);
+        z.resize(c);
+        altitude.resize(c);
+        headingDeg.resize(c);
+        pitchDeg.resize(c);
+        bankDeg.resize(c);
+        groundSpeed.resize(c);
+    }
+
+    void interpolateLinearBatch(const InterpolationBatch &batch, InterpolationBatchResult &result, bool vectorized)
+    {
+        result.resize(batch.size());
+        const size_t count = static_cast<size_t>(batch.size());
+        const size_t tail = vectorized ? linearKernel<LaneSimd>(batch, result, 0, count) : 0;
+        linearKernel<LaneScalar>(batch, result, tail, count);
+    }
+
+    void interpolateSplineBatch(const InterpolationBatch &batch, InterpolationBatchResult &result, bool vectorized)
+    {
+        result.resize(batch.size());
+        const size_t count = static_cast<size_t>(batch.size());
+        const size_t tail = vectorized ? splineKernel<LaneSimd>(batch, result, 0, count) : 0;
+        splineKernel<LaneScalar>(batch, result, tail, count);
+    }
+
+    const QString &interpolationBatchInstructionSet()
+    {
+#if defined(BLACKMISC_INTERPOLATIONBATCH_AVX2)
+        static const QString is("AVX2");
+#elif defined(BLACKMISC_INTERPOLATIONBATCH_SSE2)
+        static const QString is("SSE2");
+#else
+        static const QString is("scalar");
+#endif
+        return is;
+    }
+} // ns
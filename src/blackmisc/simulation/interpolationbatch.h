@@ -0,0 +1,88 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+#define BLACKMISC_SIMULATION_INTERPOLATIONBATCH_H
+
+#include "blackmisc/simulation/compactsituation.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QString>
+#include <array>
+#include <vector>
+
+namespace BlackMisc::Simulation
+{
+    //! Input of the batch interpolation kernels, the values of many aircraft packed as struct of arrays
+    //! \remark 3 samples per aircraft, oldest -> latest. The spline kernel uses all 3, the linear kernel 1 (old) and 2 (new).
+    //! \remark Like in the interpolators the time fraction is based on the adjusted timestamps of samples 1 and 2.
+    struct BLACKMISC_EXPORT InterpolationBatch
+    {
+        //! Values of one sample for all aircraft
+        struct BLACKMISC_EXPORT Samples
+        {
+            std::vector<double> t;                 //!< adjusted timestamp in ms
+            std::vector<double> x, y, z;           //!< position as normal vector
+            std::vector<double> altitude;          //!< (corrected) altitude, same unit for all aircraft
+            std::vector<double> headingDeg;        //!< heading in degrees
+            std::vector<double> pitchDeg;          //!< pitch in degrees
+            std::vector<double> bankDeg;           //!< bank in degrees
+            std::vector<double> groundSpeed;       //!< ground speed, same unit for all aircraft
+
+            //! Resize all arrays
+            void resize(size_t count);
+        };
+
+        std::array<Samples, 3> samples; //!< oldest -> latest
+        double currentTimeMs = 0;       //!< time interpolated for, compared with the adjusted timestamps
+
+        //! Resize for number of aircraft
+        void resize(int count);
+
+        //! Number of aircraft
+        int size() const { return static_cast<int>(samples[0].t.size()); }
+
+        //! Set the samples of one aircraft, altitude in m and ground speed in m/s
+        //! \remark index < size()
+        void setAircraft(int index, const CompactSituation &oldest, const CompactSituation &older, const CompactSituation &latest);
+    };
+
+    //! Output of the batch interpolation kernels, one element per aircraft
+    struct BLACKMISC_EXPORT InterpolationBatchResult
+    {
+        std::vector<double> timeFraction;  //!< used time fraction 0..1
+        std::vector<double> x, y, z;       //!< interpolated position as normal vector
+        std::vector<double> altitude;      //!< interpolated altitude
+        std::vector<double> headingDeg;    //!< interpolated heading, not normalized to 0..360
+        std::vector<double> pitchDeg;      //!< interpolated pitch
+        std::vector<double> bankDeg;       //!< interpolated bank
+        std::vector<double> groundSpeed;   //!< interpolated ground speed
+
+        //! Resize for number of aircraft
+        void resize(int count);
+
+        //! Number of aircraft
+        int size() const { return static_cast<int>(timeFraction.size()); }
+    };
+
+    //! Linear interpolation of all aircraft in batch, same calculation as CInterpolatorLinear::CInterpolant and CInterpolatorPbh
+    //! \remark vectorized with AVX2 or SSE2 if available, otherwise or with vectorized=false the scalar fallback is used
+    BLACKMISC_EXPORT void interpolateLinearBatch(const InterpolationBatch &batch, InterpolationBatchResult &result, bool vectorized = true);
+
+    //! Spline interpolation of all aircraft in batch, same calculation as CInterpolatorSpline::CInterpolant and CInterpolatorPbh
+    //! \remark vectorized with AVX2 or SSE2 if available, otherwise or with vectorized=false the scalar fallback is used
+    //! \remark aircraft with samples not strictly ordered by time are interpolated linearly between samples 1 and 2
+    BLACKMISC_EXPORT void interpolateSplineBatch(const InterpolationBatch &batch, InterpolationBatchResult &result, bool vectorized = true);
+
+    //! Instruction set the batch kernels were compiled for ("AVX2", "SSE2" or "scalar")
+    BLACKMISC_EXPORT const QString &interpolationBatchInstructionSet();
+} // ns
+
+#endif // guard
@@ -414,33 +414,20 @@ namespace BlackMisc::Simulation
     {
         // (!) this code is used by linear and spline interpolator
 
-        // Parts are supposed to be in correct order, latest first
-        const CAircraftPartsList validParts = this->remoteAircraftParts(m_callsign);
+        // latest parts older than the current time, binary search in the provider's parts history
+        int partsCount = 0;
+        const CAircraftParts currentParts = this->remoteAircraftPartsValidAt(m_callsign, m_currentTimeMsSinceEpoch, &partsCount);
 
         // log for empty parts aircraft parts
-        if (validParts.isEmpty())
+        if (partsCount < 1)
         {
             static const CAircraftParts emptyParts;
-            this->logParts(emptyParts, validParts.size(), true);
+            this->logParts(emptyParts, 0, true);
             return emptyParts;
         }
 
         m_currentPartsStatus.setSupportsParts(true);
-        CAircraftParts currentParts;
-        do
-        {
-            // find the first parts earlier than the current time
-            const auto pivot = std::partition_point(validParts.begin(), validParts.end(), [ = ](auto &&p) { return p.getAdjustedMSecsSinceEpoch() > m_currentTimeMsSinceEpoch; });
-            const auto partsNewer = makeRange(validParts.begin(), pivot).reverse();
-            const auto partsOlder = makeRange(pivot, validParts.end());
-
-            // if (partsOlder.isEmpty()) { currentParts = *(partsNewer.end() - 1); break; }
-            if (partsOlder.isEmpty()) { currentParts = *(partsNewer.begin()); break; }
-            currentParts = partsOlder.front(); // latest older parts
-        }
-        while (false);
-
-        this->logParts(currentParts, validParts.size(), false);
+        this->logParts(currentParts, partsCount, false);
         return currentParts;
     }
 
@@ -688,6 +675,7 @@ namespace BlackMisc::Simulation
         m_currentSceneryOffset = CLength::null();
         m_pastSituationsChange = CAircraftSituationChange::null();
         m_currentSituations.clear();
+        m_currentCompactSituations.clear();
         m_currentTimeMsSinceEpoch = -1;
         m_situationsLastModified = -1;
         m_situationsLastModifiedUsed = -1;
@@ -717,6 +705,16 @@ namespace BlackMisc::Simulation
         {
             m_situationsLastModified = lastModifed;
             m_currentSituations = this->remoteAircraftSituationsAndChange(setup); // only update when needed
+            m_currentCompactSituations = this->remoteAircraftSituationsCompact(m_callsign);
+            if (!m_currentCompactSituations.isSameSituations(m_currentSituations))
+            {
+                // situations stored in between the two calls
+                m_currentCompactSituations.setSituations(m_currentSituations);
+            }
+            else if (!m_currentSceneryOffset.isNull())
+            {
+                m_currentCompactSituations.addAltitudeOffset(-m_currentSceneryOffset.value(CLengthUnit::m()));
+            }
         }
 
         if (!m_model.hasCG() || slowUpdateStep)
@@ -11,6 +11,7 @@
 #ifndef BLACKMISC_SIMULATION_INTERPOLATOR_H
 #define BLACKMISC_SIMULATION_INTERPOLATOR_H
 
+#include "blackmisc/simulation/compactsituation.h"
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/simulation/interpolationsetupprovider.h"
@@ -286,6 +287,7 @@ namespace BlackMisc
             qint64 m_currentTimeMsSinceEpoch = -1;                      //!< current time
             qint64 m_lastInvalidLogTs = -1;                             //!< last invalid situation timestamp
             Aviation::CAircraftSituationList m_currentSituations;       //!< current situations obtained by remoteAircraftSituationsAndChange
+            CCompactSituations m_currentCompactSituations;                //!< same situations as m_currentSituations, compact for the time lookups and compares
             Aviation::CAircraftSituationChange m_pastSituationsChange;  //!< situations change of provider (i.e. network) situations
             CInterpolationAndRenderingSetupPerCallsign m_currentSetup;  //!< used setup
             CInterpolationStatus m_currentInterpolationStatus;          //!< this step's situation status
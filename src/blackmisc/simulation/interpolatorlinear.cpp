@@ -128,7 +128,7 @@ namespace BlackMisc::Simulation
             m_situationsLastModifiedUsed = m_situationsLastModified;
 
             // find the first situation earlier than the current time
-            const auto pivot = std::partition_point(m_currentSituations.begin(), m_currentSituations.end(), [ = ](auto &&s) { return s.getAdjustedMSecsSinceEpoch() > m_currentTimeMsSinceEpoch; });
+            const auto pivot = m_currentSituations.begin() + m_currentCompactSituations.indexOfFirstNotNewerThanAdjusted(m_currentTimeMsSinceEpoch);
             const auto situationsNewer = makeRange(m_currentSituations.begin(), pivot);
             const auto situationsOlder = makeRange(pivot, m_currentSituations.end());
 
@@ -14,6 +14,7 @@
 #include "blackmisc/simulation/interpolator.h"
 #include "blackmisc/simulation/interpolationlogger.h"
 #include "blackmisc/simulation/interpolant.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
@@ -68,6 +69,10 @@ namespace BlackMisc
             //! Get the interpolant for the given time point
             CInterpolant getInterpolant(SituationLog &log);
 
+            //! Interpolate many aircraft at once from packed values, same calculation as CInterpolant
+            //! \remark batch counterpart of the per aircraft interpolation, see interpolateLinearBatch
+            static void interpolateBatch(const InterpolationBatch &batch, InterpolationBatchResult &result) { interpolateLinearBatch(batch, result); }
+
         private:
             CInterpolant m_interpolant; //!< current interpolant
         };
@@ -10,6 +10,8 @@
 
 #include "blackmisc/simulation/interpolatormulti.h"
 
+#include <QStringBuilder>
+
 using namespace BlackMisc::Aviation;
 
 namespace BlackMisc::Simulation
@@ -70,7 +72,7 @@ namespace BlackMisc::Simulation
     {
         switch (mode)
         {
-        case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getInterpolatorInfo();
+        case CInterpolationAndRenderingSetupBase::Spline: return m_spline.getInterpolatorInfo() % QStringLiteral(" ") % m_spline.getCoefficientsInfo();
         case CInterpolationAndRenderingSetupBase::Linear: return m_linear.getInterpolatorInfo();
         default: break;
         }
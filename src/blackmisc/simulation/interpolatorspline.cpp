@@ -115,6 +115,7 @@ namespace BlackMisc::Simulation
             {
                 // nothing we can do
                 m_s[0] = m_s[1] = m_s[2] = CAircraftSituation::null();
+                this->setUsedCompactSituations(-1, -1);
                 return false;
             }
             else
@@ -135,27 +136,30 @@ namespace BlackMisc::Simulation
         const qint64 os = qMax(CFsdSetup::c_minimumPositionTimeOffsetMsec, m_s[2].getTimeOffsetMs());
         m_s[0].addMsecs(-os); // oldest, Ref T297 default offset time to fill data
         m_s[2].addMsecs(os);  // latest, Ref T297 default offset time to fill data
-        if (m_currentSituations.isEmpty()) { return false; }
+        if (m_currentSituations.isEmpty())
+        {
+            this->setUsedCompactSituations(-1, -1);
+            return false;
+        }
 
         // and use the real values if available
         // m_s[0] .. oldest -> m_[2] .. latest
+        int latestIndex = -1;
         const CAircraftSituation latest = m_currentSituations.front();
-        if (latest.isNewerThanAdjusted(m_s[1])) { m_s[2] = latest; }
+        if (latest.isNewerThanAdjusted(m_s[1]))
+        {
+            m_s[2] = latest;
+            latestIndex = 0;
+        }
         const qint64 currentAdjusted = m_s[1].getAdjustedMSecsSinceEpoch();
 
         // with https://dev.swift-project.org/T668#15841 avoid 2 very close positions
         // currently done by time, maybe we can also choose distance
         const qint64 osNotTooClose = qRound64(0.8 * os);
-        const CAircraftSituation older = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted - osNotTooClose);
-        if (!older.isNull())
-        {
-            m_s[0] = older;
-        }
-        else
-        {
-            const CAircraftSituation closeOlder = m_currentSituations.findObjectBeforeAdjustedOrDefault(currentAdjusted);
-            if (!closeOlder.isNull()) { m_s[0] = closeOlder; }
-        }
+        int oldestIndex = m_currentCompactSituations.indexOfFirstBeforeAdjusted(currentAdjusted - osNotTooClose);
+        if (oldestIndex < 0) { oldestIndex = m_currentCompactSituations.indexOfFirstBeforeAdjusted(currentAdjusted); }
+        if (oldestIndex >= 0) { m_s[0] = m_currentSituations[oldestIndex]; }
+        this->setUsedCompactSituations(oldestIndex, latestIndex);
         const qint64 latestAdjusted = m_s[2].getAdjustedMSecsSinceEpoch();
         const qint64 olderAdjusted  = m_s[0].getAdjustedMSecsSinceEpoch();
 
@@ -177,6 +181,12 @@ namespace BlackMisc::Simulation
         return hasNewer;
     }
 
+    void CInterpolatorSpline::setUsedCompactSituations(int oldestIndex, int latestIndex)
+    {
+        m_oldestCompact = oldestIndex >= 0 ? m_currentCompactSituations[oldestIndex] : CompactSituation::fromSituation(m_s[0]);
+        m_latestCompact = latestIndex >= 0 ? m_currentCompactSituations[latestIndex] : CompactSituation::fromSituation(m_s[2]);
+    }
+
     // pin vtables to this file
     void CInterpolatorSpline::anchor()
     { }
@@ -185,11 +195,29 @@ namespace BlackMisc::Simulation
     {
         // recalculate derivatives only if they changed
         // m_situationsLastModified updated in initIniterpolationStepData
-        const bool recalculate = (m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime) || // new step
-                                    (m_situationsLastModified  >  m_situationsLastModifiedUsed); // modified
+        const bool newStep  = m_currentTimeMsSinceEpoch >= m_nextSampleAdjustedTime;
+        const bool modified = m_situationsLastModified > m_situationsLastModifiedUsed;
+        bool recalculate = newStep || modified;
+        bool updated = false;
+
+        // elevations and ground flags are updated in the provider for known situations,
+        // without a new situation the position coefficients remain valid
+        if (recalculate && !newStep && this->canUpdateCoefficients())
+        {
+            m_situationsLastModifiedUsed = m_situationsLastModified;
+            this->updateCoefficients();
+            m_coefficientsUpdated++;
+            recalculate = false;
+            updated = true;
+        }
+        else if (!recalculate)
+        {
+            m_coefficientsReused++;
+        }
 
         if (recalculate)
         {
+            m_coefficientsCalculated++;
             // with the latest updates of T243 the order and the offsets are supposed to be correct
             // so even mixing fast/slow updates shall work
             m_situationsLastModifiedUsed = m_situationsLastModified;
@@ -218,21 +246,13 @@ namespace BlackMisc::Simulation
             // - and the elevation remains (almost) constant for a wider area
             // - during flying the ground elevation not really matters
             this->updateElevations(true);
-            static const CLengthUnit altUnit = CAltitude::defaultUnit();
-            const CLength cg(this->getModelCG().switchedUnit(altUnit));
-            const double a0 = m_s[0].getCorrectedAltitude(cg).value(altUnit); // oldest
-            const double a1 = m_s[1].getCorrectedAltitude(cg).value(altUnit);
-            const double a2 = m_s[2].getCorrectedAltitude(cg).value(altUnit); // latest
-            pa.a    = {{ a0, a1, a2 }};
-            pa.gnd  = {{ m_s[0].getOnGroundFactor(), m_s[1].getOnGroundFactor(), m_s[2].getOnGroundFactor() }};
-            pa.da   = getDerivatives(pa.t, pa.a);
-            pa.dgnd = getDerivatives(pa.t, pa.gnd);
+            this->setAltitudeAndGroundCoefficients(pa);
 
             m_prevSampleAdjustedTime = m_s[1].getAdjustedMSecsSinceEpoch();
             m_nextSampleAdjustedTime = m_s[2].getAdjustedMSecsSinceEpoch(); // latest
             m_prevSampleTime = m_s[1].getMSecsSinceEpoch(); // last interpolated situation normally
             m_nextSampleTime = m_s[2].getMSecsSinceEpoch(); // latest
-            m_interpolant = CInterpolant(pa, altUnit, CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
+            m_interpolant = CInterpolant(pa, CAltitude::defaultUnit(), CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
             Q_ASSERT_X(m_prevSampleAdjustedTime < m_nextSampleAdjustedTime, Q_FUNC_INFO, "Wrong time order");
         }
 
@@ -264,7 +284,7 @@ namespace BlackMisc::Simulation
         // time fraction is expected between 0-1
         m_currentInterpolationStatus.setInterpolated(true);
         m_interpolant.setTimes(m_currentTimeMsSinceEpoch, timeFraction, interpolatedTime);
-        m_interpolant.setRecalculated(recalculate);
+        m_interpolant.setRecalculated(recalculate || updated);
 
         if (this->doLogging())
         {
@@ -282,6 +302,74 @@ namespace BlackMisc::Simulation
         return m_interpolant;
     }
 
+    void CInterpolatorSpline::setAltitudeAndGroundCoefficients(PosArray &pa)
+    {
+        static const CLengthUnit altUnit = CAltitude::defaultUnit();
+        const CLength cg(this->getModelCG().switchedUnit(altUnit));
+        const double a0 = m_s[0].getCorrectedAltitude(cg).value(altUnit); // oldest
+        const double a1 = m_s[1].getCorrectedAltitude(cg).value(altUnit);
+        const double a2 = m_s[2].getCorrectedAltitude(cg).value(altUnit); // latest
+        pa.a    = {{ a0, a1, a2 }};
+        pa.gnd  = {{ m_s[0].getOnGroundFactor(), m_s[1].getOnGroundFactor(), m_s[2].getOnGroundFactor() }};
+        pa.da   = getDerivatives(pa.t, pa.a);
+        pa.dgnd = getDerivatives(pa.t, pa.gnd);
+    }
+
+    bool CInterpolatorSpline::canUpdateCoefficients() const
+    {
+        if (!m_interpolant.isValid() || m_currentCompactSituations.isEmpty()) { return false; }
+
+        // still the same latest situation as used for this step, offset unchanged
+        const CompactSituation &latest = m_currentCompactSituations[0];
+        if (latest.msSinceEpoch != m_latestCompact.msSinceEpoch ||
+            latest.adjustedMsSinceEpoch != m_latestCompact.adjustedMsSinceEpoch) { return false; }
+
+        // a situation with the same timestamp replaces the stored one, then the position coefficients are outdated
+        if (!latest.equalPbhVectorAltitude(m_latestCompact)) { return false; }
+        const int oldest = this->indexOfUsedOldestSituation();
+        return oldest < 0 || m_currentCompactSituations[oldest].equalPbhVectorAltitude(m_oldestCompact);
+    }
+
+    int CInterpolatorSpline::indexOfUsedOldestSituation() const
+    {
+        const int oldest = m_currentCompactSituations.indexOfFirstNotNewerThanAdjusted(m_oldestCompact.adjustedMsSinceEpoch);
+        if (oldest >= m_currentCompactSituations.size()) { return -1; }
+        return m_currentCompactSituations.adjustedMsSinceEpoch(oldest) == m_oldestCompact.adjustedMsSinceEpoch ? oldest : -1;
+    }
+
+    void CInterpolatorSpline::updateCoefficients()
+    {
+        // take over the modified values of the known situations, m_s[1] is the last interpolated situation
+        m_s[2] = m_currentSituations.front();
+        const int oldest = this->indexOfUsedOldestSituation();
+        if (oldest >= 0) { m_s[0] = m_currentSituations[oldest]; }
+        this->setUsedCompactSituations(oldest, 0);
+
+        this->updateElevations(true);
+        PosArray pa = m_interpolant.getPa();
+        this->setAltitudeAndGroundCoefficients(pa);
+        m_interpolant = CInterpolant(pa, CAltitude::defaultUnit(), CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
+    }
+
+    double CInterpolatorSpline::getCoefficientsReusedRatio() const
+    {
+        const int all = m_coefficientsCalculated + m_coefficientsUpdated + m_coefficientsReused;
+        return all > 0 ? static_cast<double>(m_coefficientsReused) / all : 0.0;
+    }
+
+    QString CInterpolatorSpline::getCoefficientsInfo() const
+    {
+        static const QString info("coefficients calculated: %1 updated: %2 reused: %3 (%4%)");
+        return info.arg(m_coefficientsCalculated).arg(m_coefficientsUpdated).arg(m_coefficientsReused).arg(100.0 * this->getCoefficientsReusedRatio(), 0, 'f', 1);
+    }
+
+    void CInterpolatorSpline::resetCoefficientsStatistics()
+    {
+        m_coefficientsCalculated = 0;
+        m_coefficientsUpdated = 0;
+        m_coefficientsReused = 0;
+    }
+
     bool CInterpolatorSpline::updateElevations(bool canSkip)
     {
         bool updated = false;
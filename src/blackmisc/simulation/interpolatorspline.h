@@ -14,6 +14,7 @@
 #include "blackmisc/simulation/interpolator.h"
 #include "blackmisc/simulation/interpolationlogger.h"
 #include "blackmisc/simulation/interpolant.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/blackmiscexport.h"
 #include <QString>
@@ -85,7 +86,36 @@ namespace BlackMisc::Simulation
         //! Strategy used by CInterpolator::getInterpolatedSituation
         CInterpolant getInterpolant(SituationLog &log);
 
+        //! Interpolate many aircraft at once from packed values, same calculation as CInterpolant
+        //! \remark batch counterpart of the per aircraft interpolation, see interpolateSplineBatch
+        static void interpolateBatch(const InterpolationBatch &batch, InterpolationBatchResult &result) { interpolateSplineBatch(batch, result); }
+
+        //! Coefficients (interpolant) statistics
+        //! \remark calculated: new step or new situation, updated: only altitude/ground values changed, reused: frames without any calculation
+        //! @{
+        int getCoefficientsCalculated() const { return m_coefficientsCalculated; }
+        int getCoefficientsUpdated() const { return m_coefficientsUpdated; }
+        int getCoefficientsReused() const { return m_coefficientsReused; }
+        double getCoefficientsReusedRatio() const;
+        QString getCoefficientsInfo() const;
+        void resetCoefficientsStatistics();
+        //! @}
+
     private:
+        //! Coefficients of the current step still valid after the situations have been modified?
+        //! \remark true if no new situation was added, but elevations or ground flags of the known situations changed
+        //! \remark false if a used situation was replaced by one with the same timestamp, but another position
+        bool canUpdateCoefficients() const;
+
+        //! Index of CInterpolatorSpline::m_s[0] in the current situations, -1 if it is not one of them
+        int indexOfUsedOldestSituation() const;
+
+        //! Update the altitude and ground factor coefficients with the modified situations, keep the position coefficients
+        void updateCoefficients();
+
+        //! Altitude and ground factor values and derivatives from CInterpolatorSpline::m_s
+        void setAltitudeAndGroundCoefficients(PosArray &pa);
+
         //! Update the elevations used in CInterpolatorSpline::m_s
         bool updateElevations(bool canSkip);
 
@@ -98,12 +128,21 @@ namespace BlackMisc::Simulation
         //! Fill the situations array
         bool fillSituationsArray();
 
+        //! Set the compact values of CInterpolatorSpline::m_s[0] and m_s[2]
+        //! \remark index in the current situations, -1 if the situation is not one of them
+        void setUsedCompactSituations(int oldestIndex, int latestIndex);
+
         qint64 m_prevSampleAdjustedTime = 0; //!< previous sample time + offset
         qint64 m_nextSampleAdjustedTime = 0; //!< previous sample time + offset
         qint64 m_prevSampleTime = 0; //!< previous sample "real time"
         qint64 m_nextSampleTime = 0; //!< next sample "real time"
         std::array<Aviation::CAircraftSituation, 3> m_s; //!< used situations
+        CompactSituation m_oldestCompact; //!< compact m_s[0], compared with the current situations
+        CompactSituation m_latestCompact; //!< compact m_s[2], compared with the current situations
         CInterpolant m_interpolant;
+        int m_coefficientsCalculated = 0; //!< interpolant fully calculated
+        int m_coefficientsUpdated = 0;    //!< only altitude/ground values updated
+        int m_coefficientsReused = 0;     //!< interpolant reused as it was
     };
 } // ns
 
@@ -81,4 +81,19 @@ namespace BlackMisc::Simulation
         }
         this->push_back(CMatchingStatisticsEntry(type, sessionId, modelSetId, description, aircraftDesignator, airlineDesignator));
     }
+
+    void CMatchingStatistics::setCacheCount(CMatchingStatisticsEntry::EntryType type, const QString &sessionId, const QString &modelSetId, const QString &description, int count)
+    {
+        for (CMatchingStatisticsEntry &entry : *this)
+        {
+            if (entry.getEntryType() == type && entry.getSessionId() == sessionId && entry.getDescription() == description)
+            {
+                entry.setCount(count);
+                return;
+            }
+        }
+        CMatchingStatisticsEntry entry(type, sessionId, modelSetId, description, {});
+        entry.setCount(count);
+        this->push_back(entry);
+    }
 } // namespace
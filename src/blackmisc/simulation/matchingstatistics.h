@@ -61,6 +61,9 @@ namespace BlackMisc::Simulation
 
         //! Add a combination, normally with no duplicates (in that case count is increased
         void addAircraftAirlineCombination(CMatchingStatisticsEntry::EntryType type, const QString &sessionId, const QString &modelSetId, const QString &description, const QString &aircraftDesignator, const QString &airlineDesignator, bool avoidDuplicates = true);
+
+        //! Set the count of a cache entry (hits or misses of the cache named by description), added if not yet existing
+        void setCacheCount(CMatchingStatisticsEntry::EntryType type, const QString &sessionId, const QString &modelSetId, const QString &description, int count);
     };
 } // namespace
 
@@ -44,7 +44,9 @@ namespace BlackMisc::Simulation
         enum EntryType
         {
             Found,
-            Missing
+            Missing,
+            CacheHit,
+            CacheMiss
         };
 
         //! Default constructor.
@@ -98,6 +100,9 @@ namespace BlackMisc::Simulation
         //! Count increased by one
         void increaseCount();
 
+        //! Set the count
+        void setCount(int count) { m_count = count; }
+
         //! Matches given value?
         bool matches(EntryType type, const QString &sessionId, const QString &aircraftDesignator, const QString &airlineDesignator) const;
 
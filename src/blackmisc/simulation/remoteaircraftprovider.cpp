@@ -14,6 +14,9 @@
 #include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Geo;
@@ -22,6 +25,46 @@ using namespace BlackConfig;
 
 namespace BlackMisc::Simulation
 {
+    namespace
+    {
+        //! \private CAircraftSituationList::transferElevationForward for a situation history, latest first
+        template <class HISTORY>
+        int transferElevationForward(HISTORY &situations, const CLength &radius = CElevationPlane::singlePointRadius())
+        {
+            int c = 0;
+            for (int i = 1; i < situations.size(); ++i)
+            {
+                if (situations[i].transferGroundElevationFromMe(situations[i - 1], radius)) { c++; }
+            }
+            return c;
+        }
+
+        //! \private CAircraftSituationList::setOnGroundDetails for a situation history
+        template <class HISTORY>
+        int setOnGroundDetails(HISTORY &situations, CAircraftSituation::OnGroundDetails details)
+        {
+            int c = 0;
+            for (int i = 0; i < situations.size(); ++i)
+            {
+                if (situations[i].setOnGroundDetails(details)) { c++; }
+            }
+            return c;
+        }
+
+        //! \private CAircraftSituationList::adjustGroundFlag for a situation history
+        template <class HISTORY>
+        int adjustGroundFlag(HISTORY &situations, const CAircraftParts &parts)
+        {
+            int c = 0;
+            for (int i = 0; i < situations.size(); ++i)
+            {
+                situations[i].setOnGroundDetails(CAircraftSituation::InFromParts);
+                if (situations[i].adjustGroundFlag(parts, true)) { c++; }
+            }
+            return c;
+        }
+    }
+
     IRemoteAircraftProvider::IRemoteAircraftProvider()
     { }
 
@@ -72,15 +115,23 @@ namespace BlackMisc::Simulation
     {
         static const CAircraftSituationList empty;
         QReadLocker l(&m_lockSituations);
-        if (!m_situationsByCallsign.contains(callsign)) { return empty; }
-        return m_situationsByCallsign[callsign];
+        const auto it = m_situationsByCallsign.constFind(callsign);
+        if (it == m_situationsByCallsign.constEnd()) { return empty; }
+        return it->toList();
     }
 
     CAircraftSituation CRemoteAircraftProvider::remoteAircraftSituation(const CCallsign &callsign, int index) const
     {
-        const CAircraftSituationList situations = this->remoteAircraftSituations(callsign);
-        if (index < 0 || index >= situations.size()) { return CAircraftSituation::null(); }
-        return situations[index];
+        QReadLocker l(&m_lockSituations);
+        const auto it = m_situationsByCallsign.constFind(callsign);
+        if (it == m_situationsByCallsign.constEnd() || index < 0 || index >= it->size()) { return CAircraftSituation::null(); }
+        return (*it)[index];
+    }
+
+    CCompactSituations CRemoteAircraftProvider::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        QReadLocker l(&m_lockSituations);
+        return m_compactSituationsByCallsign.value(callsign);
     }
 
     MillisecondsMinMaxMean CRemoteAircraftProvider::remoteAircraftSituationsTimestampDifferenceMinMaxMean(const CCallsign &callsign) const
@@ -108,16 +159,18 @@ namespace BlackMisc::Simulation
     int CRemoteAircraftProvider::remoteAircraftSituationsCount(const CCallsign &callsign) const
     {
         QReadLocker l(&m_lockSituations);
-        if (!m_situationsByCallsign.contains(callsign)) { return -1; }
-        return m_situationsByCallsign[callsign].size();
+        const auto it = m_situationsByCallsign.constFind(callsign);
+        if (it == m_situationsByCallsign.constEnd()) { return -1; }
+        return it->size();
     }
 
     CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(const CCallsign &callsign) const
     {
         static const CAircraftPartsList empty;
         QReadLocker l(&m_lockParts);
-        if (!m_partsByCallsign.contains(callsign)) { return empty; }
-        return m_partsByCallsign[callsign];
+        const auto it = m_partsByCallsign.constFind(callsign);
+        if (it == m_partsByCallsign.constEnd()) { return empty; }
+        return it->toList();
     }
 
     int CRemoteAircraftProvider::remoteAircraftPartsCount(const CCallsign &callsign) const
@@ -127,6 +180,19 @@ namespace BlackMisc::Simulation
         return m_partsByCallsign[callsign].size();
     }
 
+    CAircraftParts CRemoteAircraftProvider::remoteAircraftPartsValidAt(const CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount) const
+    {
+        QReadLocker l(&m_lockParts);
+        const auto it = m_partsByCallsign.constFind(callsign);
+        if (it == m_partsByCallsign.constEnd())
+        {
+            if (partsCount) { *partsCount = 0; }
+            return {};
+        }
+        if (partsCount) { *partsCount = it->size(); }
+        return it->findObjectValidAtAdjustedOrDefault(adjustedMsSinceEpoch);
+    }
+
     bool CRemoteAircraftProvider::isRemoteAircraftSupportingParts(const CCallsign &callsign) const
     {
         QReadLocker l(&m_lockParts);
@@ -178,6 +244,7 @@ namespace BlackMisc::Simulation
         {
             QWriteLocker l(&m_lockSituations);
             m_situationsByCallsign.clear();
+            m_compactSituationsByCallsign.clear();
             m_latestSituationByCallsign.clear();
             m_latestOnGroundProviderElevation.clear();
             m_situationsAdded = 0;
@@ -281,51 +348,12 @@ namespace BlackMisc::Simulation
             const qint64 now = QDateTime::currentMSecsSinceEpoch();
             QWriteLocker lock(&m_lockSituations);
             m_situationsAdded++;
-            m_situationsLastModified[cs] = now;
-            CAircraftSituationList &newSituationsList = m_situationsByCallsign[cs];
-            newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-            const int situations = newSituationsList.size();
-            if (situations < 1)
-            {
-                newSituationsList.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-            }
-            else if (!situationCorrected.hasVelocity() && newSituationsList.front().hasVelocity())
-            {
-                return situationCorrected;
-            }
-            else
-            {
-                // newSituationsList.push_frontKeepLatestFirstIgnoreOverlapping(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-                newSituationsList.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
-
-                // unify all inbound ground information
-                if (situation.hasInboundGroundDetails())
-                {
-                    newSituationsList.setOnGroundDetails(situation.getOnGroundDetails());
-                }
-            }
+            this->setSituationsModifiedLocked(cs, now);
+            CAircraftSituationHistory &history = m_situationsByCallsign[cs];
+            if (!this->storeAircraftSituationLocked(history, situationCorrected, aircraftModel)) { return situationCorrected; }
+            this->updateCompactSituationsLocked(cs, history);
             m_latestSituationByCallsign[cs] = situationCorrected;
-
-            // check sort order
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                BLACK_VERIFY_X(newSituationsList.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
-                BLACK_VERIFY_X(newSituationsList.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
-                BLACK_VERIFY_X(newSituationsList.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
-            }
-
-            if (!situation.hasInboundGroundDetails())
-            {
-                // first use a version without standard deviations to guess "on ground
-                const CAircraftSituationChange simpleChange(updatedSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true, false);
-
-                // guess GND
-                simpleChange.guessOnGround(newSituationsList.front(), aircraftModel);
-            }
-            updatedSituations = m_situationsByCallsign[cs];
-
+            updatedSituations = history.toList();
         } // lock
 
         // calculate change AFTER gnd. was guessed
@@ -340,7 +368,8 @@ namespace BlackMisc::Simulation
 
             QWriteLocker lock(&m_lockSituations);
             m_latestSituationByCallsign[cs].setSceneryOffset(offset);
-            m_situationsByCallsign[cs].front().setSceneryOffset(offset);
+            CAircraftSituationHistory &history = m_situationsByCallsign[cs];
+            if (!history.isEmpty()) { history.front().setSceneryOffset(offset); } // removed in between?
         }
 
         // situation has been added
@@ -350,6 +379,147 @@ namespace BlackMisc::Simulation
         return situationCorrected;
     }
 
+    CAircraftSituationList CRemoteAircraftProvider::storeAircraftSituations(const CAircraftSituationList &situations, bool allowTestAltitudeOffset)
+    {
+        // group by callsign, keeping the order within each callsign
+        QHash<CCallsign, CAircraftSituationList> situationsPerCallsign;
+        QList<CCallsign> callsigns; // first appearance order
+        for (const CAircraftSituation &situation : situations)
+        {
+            const CCallsign &cs = situation.getCallsign();
+            if (cs.isEmpty()) { continue; }
+            CAircraftSituationList &csSituations = situationsPerCallsign[cs];
+            if (csSituations.isEmpty()) { callsigns.push_back(cs); }
+            csSituations.push_back(allowTestAltitudeOffset ? this->addTestAltitudeOffsetToSituation(situation) : situation);
+        }
+        if (callsigns.isEmpty()) { return {}; }
+
+        // models once per callsign, outside the situation lock
+        QHash<CCallsign, CAircraftModel> models;
+        for (const CCallsign &cs : std::as_const(callsigns))
+        {
+            const CAircraftModel aircraftModel = this->getAircraftInRangeModelForCallsign(cs);
+            const CAircraftSituation &latest = situationsPerCallsign[cs].back();
+            if (latest.hasCG() && aircraftModel.getCG() != latest.getCG())
+            {
+                this->updateCG(cs, latest.getCG());
+            }
+            models.insert(cs, aircraftModel);
+        }
+
+        // one lock for all situations
+        CAircraftSituationList stored;
+        QHash<CCallsign, int> latestStoredIndex; // index in stored
+        QHash<CCallsign, CAircraftSituationList> updatedSituationsPerCallsign;
+        {
+            const qint64 now = QDateTime::currentMSecsSinceEpoch();
+            QWriteLocker lock(&m_lockSituations);
+            for (const CCallsign &cs : std::as_const(callsigns))
+            {
+                const CAircraftModel &aircraftModel = models[cs];
+                CAircraftSituationHistory &history = m_situationsByCallsign[cs];
+                this->setSituationsModifiedLocked(cs, now);
+                int latestIndex = -1;
+                for (const CAircraftSituation &situationCorrected : std::as_const(situationsPerCallsign[cs]))
+                {
+                    m_situationsAdded++;
+                    if (!this->storeAircraftSituationLocked(history, situationCorrected, aircraftModel)) { continue; }
+                    latestIndex = stored.size();
+                    stored.push_back(situationCorrected);
+                }
+                if (latestIndex < 0) { continue; }
+                this->updateCompactSituationsLocked(cs, history);
+                m_latestSituationByCallsign[cs] = stored[latestIndex];
+                latestStoredIndex.insert(cs, latestIndex);
+                updatedSituationsPerCallsign.insert(cs, history.toList());
+            }
+        } // lock
+
+        // change and scenery deviation for the latest situation per callsign
+        QHash<CCallsign, CLength> sceneryOffsets;
+        for (auto it = updatedSituationsPerCallsign.cbegin(); it != updatedSituationsPerCallsign.cend(); ++it)
+        {
+            const CAircraftSituationList &updatedSituations = it.value();
+            const CAircraftModel &aircraftModel = models[it.key()];
+            const CAircraftSituationChange change(updatedSituations, updatedSituations.front().getCG(), aircraftModel.isVtol(), true, true);
+            this->storeChange(change);
+            if (change.hasSceneryDeviation()) { sceneryOffsets.insert(it.key(), change.getGuessedSceneryDeviation()); }
+        }
+
+        if (!sceneryOffsets.isEmpty())
+        {
+            QWriteLocker lock(&m_lockSituations);
+            for (auto it = sceneryOffsets.cbegin(); it != sceneryOffsets.cend(); ++it)
+            {
+                stored[latestStoredIndex.value(it.key())].setSceneryOffset(it.value());
+                m_latestSituationByCallsign[it.key()].setSceneryOffset(it.value());
+                CAircraftSituationHistory &history = m_situationsByCallsign[it.key()];
+                if (!history.isEmpty()) { history.front().setSceneryOffset(it.value()); }
+            }
+        }
+
+        // situations have been added
+        for (const CAircraftSituation &situation : std::as_const(stored))
+        {
+            emit this->addedAircraftSituation(situation);
+        }
+        return stored;
+    }
+
+    void CRemoteAircraftProvider::setSituationsModifiedLocked(const CCallsign &callsign, qint64 now)
+    {
+        qint64 &lastModified = m_situationsLastModified[callsign];
+        lastModified = qMax(now, lastModified + 1);
+    }
+
+    void CRemoteAircraftProvider::updateCompactSituationsLocked(const CCallsign &callsign, const CAircraftSituationHistory &history)
+    {
+        m_compactSituationsByCallsign[callsign].update(history);
+    }
+
+    bool CRemoteAircraftProvider::storeAircraftSituationLocked(CAircraftSituationHistory &history, const CAircraftSituation &situationCorrected, const CAircraftModel &aircraftModel)
+    {
+        if (history.isEmpty())
+        {
+            history.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+        }
+        else if (!situationCorrected.hasVelocity() && history.front().hasVelocity())
+        {
+            return false;
+        }
+        else
+        {
+            // O(1), the oldest situation is overwritten
+            history.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true);
+            transferElevationForward(history); // transfer elevations, will do nothing if elevations already exist
+
+            // unify all inbound ground information
+            if (situationCorrected.hasInboundGroundDetails())
+            {
+                setOnGroundDetails(history, situationCorrected.getOnGroundDetails());
+            }
+        }
+
+        // check sort order
+        if (CBuildConfig::isLocalDeveloperDebugBuild())
+        {
+            const CAircraftSituationList situations = history.toList();
+            BLACK_VERIFY_X(situations.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
+            BLACK_VERIFY_X(situations.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
+        }
+
+        if (!situationCorrected.hasInboundGroundDetails())
+        {
+            // first use a version without standard deviations to guess "on ground
+            // no history is passed, the change only provides the model dependent guessing
+            const CAircraftSituationChange simpleChange(CAircraftSituationList(), situationCorrected.getCG(), aircraftModel.isVtol(), true, false);
+
+            // guess GND
+            simpleChange.guessOnGround(history.front(), aircraftModel);
+        }
+        return true;
+    }
+
     void CRemoteAircraftProvider::storeAircraftParts(const CCallsign &callsign, const CAircraftParts &parts, bool removeOutdated)
     {
         BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "empty callsign");
@@ -357,31 +527,34 @@ namespace BlackMisc::Simulation
 
         // list sorted from new to old
         const qint64 ts = QDateTime::currentMSecsSinceEpoch();
-        CAircraftPartsList correctiveParts;
+        bool hasParts = false;
         {
             QWriteLocker lock(&m_lockParts);
             m_partsAdded++;
             m_partsLastModified[callsign] = ts;
-            CAircraftPartsList &partsList = m_partsByCallsign[callsign];
-            partsList.push_frontKeepLatestFirstAdjustOffset(parts, true, IRemoteAircraftProvider::MaxPartsPerCallsign);
-            partsList.setAdjustedSortHint(CAircraftPartsList::AdjustedTimestampLatestFirst);
+            CAircraftPartsHistory &partsHistory = m_partsByCallsign[callsign];
+            partsHistory.push_frontKeepLatestFirstAdjustOffset(parts, true);
 
             // remove outdated parts (but never remove the most recent one)
-            if (removeOutdated) { IRemoteAircraftProvider::removeOutdatedParts(partsList); }
-            correctiveParts = partsList;
-
-            // check sort order
-            Q_ASSERT_X(partsList.isSortedAdjustedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
-            Q_ASSERT_X(partsList.size() <= IRemoteAircraftProvider::MaxPartsPerCallsign, Q_FUNC_INFO, "Wrong size");
+            if (removeOutdated && !partsHistory.isEmpty())
+            {
+                partsHistory.removeBeforeKeepLatest(partsHistory.front().getMSecsSinceEpoch() - MaxPartsAgePerCallsignSecs * 1000);
+            }
+            hasParts = !partsHistory.isEmpty();
+            Q_ASSERT_X(partsHistory.size() <= IRemoteAircraftProvider::MaxPartsPerCallsign, Q_FUNC_INFO, "Wrong size");
         } // lock
 
         // adjust gnd.flag from parts
-        if (!correctiveParts.isEmpty())
+        if (hasParts)
         {
             QWriteLocker lock(&m_lockSituations);
-            CAircraftSituationList &situationList = m_situationsByCallsign[callsign];
-            const int c = situationList.adjustGroundFlag(parts);
-            if (c > 0) { m_situationsLastModified[callsign] = ts; }
+            CAircraftSituationHistory &history = m_situationsByCallsign[callsign];
+            const int c = adjustGroundFlag(history, parts);
+            if (c > 0)
+            {
+                this->setSituationsModifiedLocked(callsign, ts);
+                this->updateCompactSituationsLocked(callsign, history);
+            }
         }
 
         // update aircraft
@@ -441,7 +614,7 @@ namespace BlackMisc::Simulation
 
                             // treat as incremental
                             CLogMessage(this).warning(u"Treating %1 attributes as incremental") << attributes;
-                            parts = this->remoteAircraftParts(callsign).frontOrDefault(); // latest
+                            parts = this->getLatestAircraftParts(callsign);
                             const QJsonObject config = applyIncrementalObject(parts.toJson(), jsonObject);
                             parts.convertFromJson(config);
                         }
@@ -452,7 +625,7 @@ namespace BlackMisc::Simulation
             else
             {
                 // incremental update
-                parts = this->remoteAircraftParts(callsign).frontOrDefault(); // latest
+                parts = this->getLatestAircraftParts(callsign);
                 const QJsonObject config = applyIncrementalObject(parts.toJson(), jsonObject);
                 parts.convertFromJson(config);
             }
@@ -589,12 +762,13 @@ namespace BlackMisc::Simulation
         int updated = 0;
         {
             QWriteLocker l(&m_lockSituations);
-            CAircraftSituationList &situations = m_situationsByCallsign[callsign];
-            if (situations.isEmpty()) { return 0; }
-            updated = setGroundElevationCheckedAndGuessGround(situations, elevation, info, model, &change, &setForOnGndPosition);
+            CAircraftSituationHistory &history = m_situationsByCallsign[callsign];
+            if (history.isEmpty()) { return 0; }
+            updated = setGroundElevationCheckedAndGuessGround(history, elevation, info, model, &change, &setForOnGndPosition);
             if (updated < 1) { return 0; }
-            m_situationsLastModified[callsign] = now;
-            const CAircraftSituation latestSituation = situations.front();
+            this->setSituationsModifiedLocked(callsign, now);
+            this->updateCompactSituationsLocked(callsign, history);
+            const CAircraftSituation latestSituation = history.front();
             if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
             {
                 m_latestOnGroundProviderElevation[callsign] = latestSituation;
@@ -774,7 +948,7 @@ namespace BlackMisc::Simulation
     }
 
     int CRemoteAircraftProvider::setGroundElevationCheckedAndGuessGround(
-        CAircraftSituationList &situations, const CElevationPlane &elevationPlane, CAircraftSituation::GndElevationInfo info, const CAircraftModel &model,
+        CAircraftSituationHistory &situations, const CElevationPlane &elevationPlane, CAircraftSituation::GndElevationInfo info, const CAircraftModel &model,
         CAircraftSituationChange *changeOut, bool *setForOnGroundPosition)
     {
         if (setForOnGroundPosition)  { *setForOnGroundPosition = false; } // set a default
@@ -783,13 +957,14 @@ namespace BlackMisc::Simulation
 
         // the change has the timestamps of the latest situation
         //Q_ASSERT_X(situations.m_tsAdjustedSortHint == CAircraftSituationList::AdjustedTimestampLatestFirst || situations.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "Need sorted situations without NULL positions");
-        const CAircraftSituationChange simpleChange(situations, model.getCG(), model.isVtol(), true, false);
+        const CAircraftSituationChange simpleChange(situations.toList(), model.getCG(), model.isVtol(), true, false);
         int c = 0; // changed elevations
         bool latest = true;
         bool setForOnGndPosition = false;
 
-        for (CAircraftSituation &s : situations)
+        for (int i = 0; i < situations.size(); ++i)
         {
+            CAircraftSituation &s = situations[i];
             const bool set = s.setGroundElevationChecked(elevationPlane, info);
             if (set)
             {
@@ -812,7 +987,7 @@ namespace BlackMisc::Simulation
         if (setForOnGroundPosition) { *setForOnGroundPosition = setForOnGndPosition; }
         if (changeOut)
         {
-            const CAircraftSituationChange change(situations, model.getCG(), model.isVtol(), true, true);
+            const CAircraftSituationChange change(situations.toList(), model.getCG(), model.isVtol(), true, true);
             *changeOut = change;
         }
 
@@ -928,6 +1103,7 @@ namespace BlackMisc::Simulation
         {
             QWriteLocker l2(&m_lockSituations);
             m_situationsByCallsign.remove(callsign);
+            m_compactSituationsByCallsign.remove(callsign);
             m_latestSituationByCallsign.remove(callsign);
             m_latestOnGroundProviderElevation.remove(callsign);
             m_situationsLastModified.remove(callsign);
@@ -1006,6 +1182,12 @@ namespace BlackMisc::Simulation
         return this->provider()->remoteAircraftSituation(callsign, index);
     }
 
+    CCompactSituations CRemoteAircraftAware::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+        return this->provider()->remoteAircraftSituationsCompact(callsign);
+    }
+
     CAircraftSituationList CRemoteAircraftAware::latestRemoteAircraftSituations() const
     {
         Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -1036,6 +1218,12 @@ namespace BlackMisc::Simulation
         return this->provider()->remoteAircraftPartsCount(callsign);
     }
 
+    CAircraftParts CRemoteAircraftAware::remoteAircraftPartsValidAt(const CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount) const
+    {
+        Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+        return this->provider()->remoteAircraftPartsValidAt(callsign, adjustedMsSinceEpoch, partsCount);
+    }
+
     CCallsignSet CRemoteAircraftAware::remoteAircraftSupportingParts() const
     {
         Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
@@ -1164,9 +1352,24 @@ namespace BlackMisc::Simulation
 
     CAircraftParts IRemoteAircraftProvider::getLatestAircraftParts(const CCallsign &callsign) const
     {
-        static const CAircraftParts empty;
+        // history is sorted latest first, so the latest parts are valid at any later time
+        return this->remoteAircraftPartsValidAt(callsign, std::numeric_limits<qint64>::max());
+    }
+
+    CCompactSituations IRemoteAircraftProvider::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        CCompactSituations situations;
+        situations.setSituations(this->remoteAircraftSituations(callsign));
+        return situations;
+    }
+
+    CAircraftParts IRemoteAircraftProvider::remoteAircraftPartsValidAt(const CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount) const
+    {
         const CAircraftPartsList parts = this->remoteAircraftParts(callsign);
-        return parts.isEmpty() ? empty : parts.latestObject();
+        if (partsCount) { *partsCount = parts.sizeInt(); }
+        if (parts.isEmpty()) { return {}; }
+        const auto pivot = std::partition_point(parts.begin(), parts.end(), [ = ](const CAircraftParts &p) { return p.getAdjustedMSecsSinceEpoch() > adjustedMsSinceEpoch; });
+        return pivot == parts.end() ? parts.back() : *pivot;
     }
 
     void IRemoteAircraftProvider::removeOutdatedParts(CAircraftPartsList &partsList)
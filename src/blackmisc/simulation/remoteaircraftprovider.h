@@ -12,6 +12,7 @@
 #define BLACKMISC_SIMULATION_REMOTEAIRCRAFTPROVIDER_H
 
 #include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/compactsituation.h"
 #include "blackmisc/simulation/airspaceaircraftsnapshot.h"
 #include "blackmisc/simulation/reverselookup.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
@@ -23,6 +24,7 @@
 #include "blackmisc/provider.h"
 #include "blackmisc/blackmiscexport.h"
 #include "blackmisc/identifiable.h"
+#include "blackmisc/timestampringbuffer.h"
 
 #include <QHash>
 #include <QList>
@@ -98,6 +100,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Rendered aircraft situations as compact situations, same order as remoteAircraftSituations
+            //! \remark default implementation converts remoteAircraftSituations
+            //! \threadsafe
+            virtual CCompactSituations remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const;
+
             //! Rendered aircraft situations (per callsign and index)
             //! \remark if situation does not exist, an NULL situation is returned
             //! \param callsign
@@ -127,6 +134,12 @@ namespace BlackMisc
             //! \threadsafe
             virtual int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Parts valid at the given adjusted time, i.e. the latest parts not newer than that time, or the oldest parts if all parts are newer
+            //! \remark default parts if there are none, partsCount (optional) is the size of the parts history
+            //! \remark default implementation searches remoteAircraftParts
+            //! \threadsafe
+            virtual Aviation::CAircraftParts remoteAircraftPartsValidAt(const Aviation::CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount = nullptr) const;
+
             //! Is remote aircraft supporting parts?
             //! \threadsafe
             virtual bool isRemoteAircraftSupportingParts(const Aviation::CCallsign &callsign) const = 0;
@@ -313,12 +326,14 @@ namespace BlackMisc::Simulation
         virtual bool isVtolAircraft(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const override;
+        virtual CCompactSituations remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const override;
         virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
         virtual Aviation::CAircraftSituationList latestOnGroundProviderElevations() const override;
         virtual int remoteAircraftSituationsCount(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftPartsList remoteAircraftParts(const Aviation::CCallsign &callsign) const override;
         virtual int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const override;
+        virtual Aviation::CAircraftParts remoteAircraftPartsValidAt(const Aviation::CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount = nullptr) const override;
         virtual bool isRemoteAircraftSupportingParts(const Aviation::CCallsign &callsign) const override;
         virtual int getRemoteAircraftSupportingPartsCount() const override;
         virtual Aviation::CCallsignSet remoteAircraftSupportingParts() const override;
@@ -452,6 +467,14 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         virtual Aviation::CAircraftSituation storeAircraftSituation(const Aviation::CAircraftSituation &situation, bool allowTestAltitudeOffset = true);
 
+        //! Store multiple aircraft situations, e.g. all situations received since the last processing
+        //! \remark same histories as storeAircraftSituation for each situation in the given order, but the situation lock
+        //!         is taken once and model lookup, CG check and change calculation are done once per callsign
+        //! \remark bypasses overrides of storeAircraftSituation
+        //! \return the stored (corrected) situations, skipped situations are not contained
+        //! \threadsafe
+        Aviation::CAircraftSituationList storeAircraftSituations(const Aviation::CAircraftSituationList &situations, bool allowTestAltitudeOffset = true);
+
         //! Store an aircraft part
         //! \remark latest parts are kept first
         //! \threadsafe
@@ -471,20 +494,40 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         ReverseLookupLogging whatToReverseLog() const;
 
+        //! Situation history per callsign, latest first
+        using CAircraftSituationHistory = CTimestampRingBuffer<Aviation::CAircraftSituation, Aviation::CAircraftSituationList, IRemoteAircraftProvider::MaxSituationsPerCallsign>;
+
         //! Set ground elevation from elevation plane and guess ground
-        //! \note requires a sorted list latest first
-        static int setGroundElevationCheckedAndGuessGround(Aviation::CAircraftSituationList &situations, const Geo::CElevationPlane &elevationPlane, Aviation::CAircraftSituation::GndElevationInfo info, const Simulation::CAircraftModel &model, Aviation::CAircraftSituationChange *changeOut, bool *setForOnGroundPosition);
+        static int setGroundElevationCheckedAndGuessGround(CAircraftSituationHistory &situations, const Geo::CElevationPlane &elevationPlane, Aviation::CAircraftSituation::GndElevationInfo info, const Simulation::CAircraftModel &model, Aviation::CAircraftSituationChange *changeOut, bool *setForOnGroundPosition);
 
     private:
+        //! Parts history per callsign, latest first
+        using CAircraftPartsHistory = CTimestampRingBuffer<Aviation::CAircraftParts, Aviation::CAircraftPartsList, IRemoteAircraftProvider::MaxPartsPerCallsign>;
+
+        //! Add the situation to the situations of its callsign
+        //! \remark m_lockSituations must be locked for writing
+        //! \return false if the situation was skipped
+        bool storeAircraftSituationLocked(CAircraftSituationHistory &history, const Aviation::CAircraftSituation &situationCorrected, const CAircraftModel &aircraftModel);
+
+        //! Mark the situations of a callsign as modified
+        //! \remark strictly increasing, so interpolators also detect changes within the same ms
+        //! \remark m_lockSituations must be locked for writing
+        void setSituationsModifiedLocked(const Aviation::CCallsign &callsign, qint64 now);
+
+        //! Update the compact situations of a callsign from its history
+        //! \remark m_lockSituations must be locked for writing
+        void updateCompactSituationsLocked(const Aviation::CCallsign &callsign, const CAircraftSituationHistory &history);
+
         //! Store the latest changes
         //! \remark latest first
         //! \threadsafe
         void storeChange(const Aviation::CAircraftSituationChange &change);
 
-        Aviation::CAircraftSituationListPerCallsign m_situationsByCallsign;        //!< situations, for performance reasons per callsign, thread safe access required
+        QHash<Aviation::CCallsign, CAircraftSituationHistory> m_situationsByCallsign; //!< situations, for performance reasons per callsign, thread safe access required
+        QHash<Aviation::CCallsign, CCompactSituations> m_compactSituationsByCallsign; //!< same situations as m_situationsByCallsign, compact for the interpolators
         Aviation::CAircraftSituationPerCallsign m_latestSituationByCallsign;       //!< latest situations, for performance reasons per callsign, thread safe access required
         Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation; //!< situations on ground with elevation from provider
-        Aviation::CAircraftPartsListPerCallsign m_partsByCallsign;                 //!< parts, for performance reasons per callsign, thread safe access required
+        QHash<Aviation::CCallsign, CAircraftPartsHistory> m_partsByCallsign;       //!< parts, for performance reasons per callsign, thread safe access required
         Aviation::CAircraftSituationChangeListPerCallsign m_changesByCallsign;     //!< changes, for performance reasons per callsign, thread safe access required (same timestamps as corresponding situations)
         Aviation::CCallsignSet m_aircraftWithParts;                                //!< aircraft supporting parts, thread safe access required
         int m_situationsAdded = 0; //!< total number of situations added, thread safe access required
@@ -503,7 +546,7 @@ namespace BlackMisc::Simulation
         bool m_enableAircraftPartsHistory = true;  //!< shall we keep a history of aircraft parts
 
         // locks
-        mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign
+        mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign, m_compactSituationsByCallsign
         mutable QReadWriteLock m_lockParts;        //!< lock for parts: m_partsByCallsign, m_aircraftSupportingParts
         mutable QReadWriteLock m_lockChanges;      //!< lock for changes: m_changesByCallsign
         mutable QReadWriteLock m_lockAircraft;     //!< lock aircraft: m_aircraftInRange, m_dbCGPerCallsign
@@ -548,6 +591,9 @@ namespace BlackMisc::Simulation
         //! \copydoc IRemoteAircraftProvider::remoteAircraftSituation
         Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const;
 
+        //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationsCompact
+        CCompactSituations remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const;
+
         //! \copydoc IRemoteAircraftProvider::latestRemoteAircraftSituations
         Aviation::CAircraftSituationList latestRemoteAircraftSituations() const;
 
@@ -563,6 +609,9 @@ namespace BlackMisc::Simulation
         //! \copydoc IRemoteAircraftProvider::remoteAircraftPartsCount
         int remoteAircraftPartsCount(const Aviation::CCallsign &callsign) const;
 
+        //! \copydoc IRemoteAircraftProvider::remoteAircraftPartsValidAt
+        Aviation::CAircraftParts remoteAircraftPartsValidAt(const Aviation::CCallsign &callsign, qint64 adjustedMsSinceEpoch, int *partsCount = nullptr) const;
+
         //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationChanges
         Aviation::CAircraftSituationChangeList remoteAircraftSituationChanges(const Aviation::CCallsign &callsign) const;
 
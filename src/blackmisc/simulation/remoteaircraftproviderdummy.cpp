@@ -31,10 +31,7 @@ namespace BlackMisc::Simulation
 
     void CRemoteAircraftProviderDummy::insertNewSituations(const CAircraftSituationList &situations)
     {
-        for (const CAircraftSituation &situation : situations)
-        {
-            this->storeAircraftSituation(situation);
-        }
+        this->storeAircraftSituations(situations);
     }
 
     void CRemoteAircraftProviderDummy::insertNewAircraftParts(const CCallsign &callsign, const CAircraftParts &parts, bool removeOutdatedParts)
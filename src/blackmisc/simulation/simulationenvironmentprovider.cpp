@@ -36,23 +36,24 @@ namespace BlackMisc::Simulation
         const double elvFt = elevationCoordinate.geodeticHeight().value(CLengthUnit::ft());
 
         CCoordinateGeodetic alreadyInRange;
-        CCoordinateGeodetic alreadyInRangeGnd;
+        bool alreadyInRangeGnd = false;
         {
             QReadLocker l(&m_lockElvCoordinates);
             if (!m_enableElevation) { return false; }
 
             // check if we have already an elevation within range
-            alreadyInRangeGnd = m_elvCoordinatesGnd.findFirstWithinRangeOrDefault(elevationCoordinate, minRange);
-            alreadyInRange    = m_elvCoordinates.findFirstWithinRangeOrDefault(elevationCoordinate, minRange);
+            CElevationTileCache::Key key;
+            alreadyInRange    = m_elvCache.findClosestWithinRange(elevationCoordinate, minRange, &key);
+            alreadyInRangeGnd = m_elvCache.isOnGround(key);
         }
 
         constexpr double maxDistFt = 30.0;
 
         // here we deal with gnd situation and do not expect a lot of variance
-        if (!alreadyInRangeGnd.isNull())
+        if (!alreadyInRange.isNull() && alreadyInRangeGnd)
         {
             // found
-            const double distFt = qAbs(alreadyInRangeGnd.geodeticHeight().value(CLengthUnit::ft()) - elvFt);
+            const double distFt = qAbs(alreadyInRange.geodeticHeight().value(CLengthUnit::ft()) - elvFt);
             if (distFt > maxDistFt)
             {
                 // such a huge distance to existing value
@@ -79,20 +80,11 @@ namespace BlackMisc::Simulation
 
         const qint64 now = QDateTime::currentMSecsSinceEpoch();
         {
-            // we keep latest at front
-            // * we assume we find them faster
-            // * and need them more frequently (the recent ones)
+            // the least recently used elevations are evicted,
+            // so the ones still in use (e.g. at the departure airport) are kept
             QWriteLocker l(&m_lockElvCoordinates);
-            if (likelyOnGroundElevation)
-            {
-                if (m_elvCoordinatesGnd.size() > m_maxElevationsGnd) { m_elvCoordinatesGnd.pop_back(); }
-                m_elvCoordinatesGnd.push_front(elevationCoordinate);
-            }
-            else
-            {
-                if (m_elvCoordinates.size() > m_maxElevations) { m_elvCoordinates.pop_back(); }
-                m_elvCoordinates.push_front(elevationCoordinate);
-            }
+            m_elvCache.insert(elevationCoordinate, likelyOnGroundElevation, now);
+            m_elvCache.evict(m_maxElevations, m_maxElevationsGnd);
 
             // statistics
             if (m_pendingElevationRequests.contains(requestedForCallsign))
@@ -271,20 +263,22 @@ namespace BlackMisc::Simulation
     CCoordinateGeodeticList ISimulationEnvironmentProvider::getAllElevationCoordinates() const
     {
         QReadLocker l(&m_lockElvCoordinates);
-        CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-        cl.push_back(m_elvCoordinates);
-        return cl;
+        return m_elvCache.toList(false);
     }
 
     CCoordinateGeodeticList ISimulationEnvironmentProvider::getElevationCoordinatesOnGround() const
     {
         QReadLocker l(&m_lockElvCoordinates);
-        return m_elvCoordinatesGnd;
+        return m_elvCache.toList(true);
     }
 
     CElevationPlane ISimulationEnvironmentProvider::averageElevationOfOnGroundAircraft(const CAircraftSituation &reference, const CLength &range, int minValues, int sufficientValues) const
     {
-        const CCoordinateGeodeticList coordinates = this->getElevationCoordinatesOnGround();
+        CCoordinateGeodeticList coordinates;
+        {
+            QReadLocker l(&m_lockElvCoordinates);
+            coordinates = m_elvCache.findWithinRange(reference, range, true);
+        }
         return coordinates.averageGeodeticHeight(reference, range, CAircraftSituation::allowedAltitudeDeviation(), minValues, sufficientValues);
     }
 
@@ -299,26 +293,28 @@ namespace BlackMisc::Simulation
     {
         QReadLocker l(&m_lockElvCoordinates);
         maxRemembered = m_maxElevations;
-        CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-        cl.push_back(m_elvCoordinates);
-        return cl;
+        return m_elvCache.toList(false);
     }
 
-    int ISimulationEnvironmentProvider::cleanUpElevations(const ICoordinateGeodetic &referenceCoordinate, int maxNumber)
+    int ISimulationEnvironmentProvider::cleanUpElevations(int maxNumber)
     {
-        int currentMax;
-        CCoordinateGeodeticList coordinates(this->getAllElevationCoordinates(currentMax));
-        if (maxNumber < 0) { maxNumber = currentMax; }
-        const int size = coordinates.size();
-        if (size <= maxNumber) { return 0; }
-        coordinates.sortByEuclideanDistanceSquared(referenceCoordinate);
-        coordinates.truncate(maxNumber);
-        const int delta = size - coordinates.size();
-        {
-            QWriteLocker l(&m_lockElvCoordinates);
-            m_elvCoordinates = coordinates;
-        }
-        return delta;
+        QWriteLocker l(&m_lockElvCoordinates);
+        if (maxNumber < 0) { maxNumber = m_maxElevations; }
+        return m_elvCache.evict(maxNumber, m_maxElevationsGnd);
+    }
+
+    bool ISimulationEnvironmentProvider::saveElevationsToFile(const QString &fileName, int minHits) const
+    {
+        QReadLocker l(&m_lockElvCoordinates);
+        return m_elvCache.writeToFile(fileName, minHits);
+    }
+
+    int ISimulationEnvironmentProvider::loadElevationsFromFile(const QString &fileName)
+    {
+        QWriteLocker l(&m_lockElvCoordinates);
+        const int read = m_elvCache.readFromFile(fileName);
+        m_elvCache.evict(m_maxElevations, m_maxElevationsGnd);
+        return read;
     }
 
     CElevationPlane ISimulationEnvironmentProvider::findClosestElevationWithinRange(const ICoordinateGeodetic &reference, const CLength &range) const
@@ -327,25 +323,21 @@ namespace BlackMisc::Simulation
 
         // for single point we use a slightly optimized version
         const bool singlePoint = (&range == &CElevationPlane::singlePointRadius() || range.isNull() || range <= CElevationPlane::singlePointRadius());
-        const CCoordinateGeodeticList elevations = this->getAllElevationCoordinates();
-        const CCoordinateGeodetic coordinate = singlePoint ?
-                                                elevations.findFirstWithinRangeOrDefault(reference, CElevationPlane::singlePointRadius()) :
-                                                elevations.findClosestWithinRange(reference, range);
-        const bool found = !coordinate.isNull();
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
 
+        // write locked, as the LRU order changes and the key is only valid until the next eviction
+        QWriteLocker l(&m_lockElvCoordinates);
+        CElevationTileCache::Key key;
+        const CCoordinateGeodetic coordinate = m_elvCache.findClosestWithinRange(reference, singlePoint ? CElevationPlane::singlePointRadius() : range, &key);
+        if (coordinate.isNull())
         {
-            QWriteLocker l{&m_lockElvCoordinates };
-            if (found)
-            {
-                m_elvFound++;
-                return CElevationPlane(coordinate, reference); // plane with radius = distance to reference
-            }
-            else
-            {
-                m_elvMissed++;
-                return CElevationPlane::null();
-            }
+            m_elvMissed++;
+            return CElevationPlane::null();
         }
+
+        m_elvFound++;
+        m_elvCache.touch(key, now);
+        return CElevationPlane(coordinate, reference); // plane with radius = distance to reference
     }
 
     CElevationPlane ISimulationEnvironmentProvider::findClosestElevationWithinRangeOrRequest(const ICoordinateGeodetic &reference, const CLength &range, const CCallsign &callsign)
@@ -376,7 +368,7 @@ namespace BlackMisc::Simulation
 
     QString ISimulationEnvironmentProvider::getElevationsFoundMissedInfo() const
     {
-        static const QString info("%1/%2 %3% in %4 (all)/%5 (gnd)");
+        static const QString info("%1/%2 %3% in %4 (all)/%5 (gnd) %6 tiles");
         const QPair<int, int> foundMissed = this->getElevationsFoundMissed();
         const int f = foundMissed.first;
         const int m = foundMissed.second;
@@ -384,12 +376,14 @@ namespace BlackMisc::Simulation
 
         int elvGnd;
         int elv;
+        int tiles;
         {
             QReadLocker l(&m_lockElvCoordinates);
-            elvGnd = m_elvCoordinatesGnd.sizeInt();
-            elv    = m_elvCoordinates.sizeInt();
+            elvGnd = m_elvCache.sizeOnGround();
+            elv    = m_elvCache.sizeNotOnGround();
+            tiles  = m_elvCache.getTileCount();
         }
-        return info.arg(f).arg(m).arg(QString::number(hitRatioPercent, 'f', 1)).arg(elv).arg(elvGnd);
+        return info.arg(f).arg(m).arg(QString::number(hitRatioPercent, 'f', 1)).arg(elv).arg(elvGnd).arg(tiles);
     }
 
     QPair<qint64, qint64> ISimulationEnvironmentProvider::getElevationRequestTimes() const
@@ -531,7 +525,7 @@ namespace BlackMisc::Simulation
     int ISimulationEnvironmentProvider::setMaxElevationsRemembered(int max)
     {
         QWriteLocker l(&m_lockElvCoordinates);
-        m_maxElevations = qMax(max, 50);
+        m_maxElevations = qMax(max, MinElevationsRemembered);
         return m_maxElevations;
     }
 
@@ -552,8 +546,7 @@ namespace BlackMisc::Simulation
     int ISimulationEnvironmentProvider::removeElevationValues(const CAircraftSituation &reference, const CLength &removeRange)
     {
         QWriteLocker l(&m_lockElvCoordinates);
-        const int r = m_elvCoordinatesGnd.removeInsideRange(reference, removeRange);
-        return r;
+        return m_elvCache.removeWithinRange(reference, removeRange, true);
     }
 
     bool ISimulationEnvironmentProvider::cleanElevationValues(const CAircraftSituation &reference, const CLength &keptRange, bool forced)
@@ -561,44 +554,11 @@ namespace BlackMisc::Simulation
         if (reference.isNull() || keptRange.isNull()) { return false; }
         const CLength r = minRange(keptRange);
 
-        CCoordinateGeodeticList cleanedKeptElvs;
-        bool maxReached = false;
-        bool cleaned    = false;
-
-        {
-            QReadLocker l(&m_lockElvCoordinates);
-            cleanedKeptElvs = m_elvCoordinates;
-            maxReached = m_elvCoordinates.size() >= m_maxElevations;
-        }
-        if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
-        {
-            const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-            if (removed > 0)
-            {
-                cleaned = true;
-                QWriteLocker l(&m_lockElvCoordinates);
-                m_elvCoordinates = cleanedKeptElvs;
-            }
-        }
-
-        cleanedKeptElvs.clear();
-        {
-            QReadLocker l(&m_lockElvCoordinates);
-            cleanedKeptElvs = m_elvCoordinatesGnd;
-            maxReached = m_elvCoordinatesGnd.size() >= m_maxElevationsGnd;
-        }
-        if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
-        {
-            const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-            if (removed > 0)
-            {
-                cleaned = true;
-                QWriteLocker l(&m_lockElvCoordinates);
-                m_elvCoordinatesGnd = cleanedKeptElvs;
-            }
-        }
-
-        return cleaned;
+        int removed = 0;
+        QWriteLocker l(&m_lockElvCoordinates);
+        if (forced || m_elvCache.sizeNotOnGround() >= m_maxElevations) { removed += m_elvCache.removeOutsideRange(reference, r, false); }
+        if (forced || m_elvCache.sizeOnGround() >= m_maxElevationsGnd) { removed += m_elvCache.removeOutsideRange(reference, r, true); }
+        return removed > 0;
     }
 
     ISimulationEnvironmentProvider::ISimulationEnvironmentProvider(const CSimulatorPluginInfo &pluginInfo) :
@@ -693,8 +653,7 @@ namespace BlackMisc::Simulation
     void ISimulationEnvironmentProvider::clearElevations()
     {
         QWriteLocker l(&m_lockElvCoordinates);
-        m_elvCoordinates.clear();
-        m_elvCoordinatesGnd.clear();
+        m_elvCache.clear();
         m_pendingElevationRequests.clear();
         m_statsCurrentElevRequestTimeMs = -1;
         m_statsMaxElevRequestTimeMs     = -1;
@@ -18,6 +18,7 @@
 #include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/geo/coordinategeodeticlist.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/geo/elevationtilecache.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/provider.h"
 
@@ -132,7 +133,10 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         bool hasSameSimulatorCG(const PhysicalQuantities::CLength &cg, const Aviation::CCallsign &callsign) const;
 
-        //! Set number of elevations kept
+        //! Min. number of elevations not on ground kept
+        static constexpr int MinElevationsRemembered = 250;
+
+        //! Set number of elevations not on ground kept, at least MinElevationsRemembered
         //! \threadsafe
         int setMaxElevationsRemembered(int max);
 
@@ -222,9 +226,17 @@ namespace BlackMisc::Simulation
         //! \threadsafe
         void clearSimulationEnvironmentData();
 
-        //! Only keep closest ones
+        //! Only keep the recently used ones
+        //! \threadsafe
+        int cleanUpElevations(int maxNumber = -1);
+
+        //! Write the on ground elevations used at least minHits times, e.g. for the next session
+        //! \threadsafe
+        bool saveElevationsToFile(const QString &fileName, int minHits = 2) const;
+
+        //! Read elevations written by saveElevationsToFile
         //! \threadsafe
-        int cleanUpElevations(const Geo::ICoordinateGeodetic &referenceCoordinate, int maxNumber = -1);
+        int loadElevationsFromFile(const QString &fileName);
 
         //! Remember a given elevation
         //! \threadsafe
@@ -289,10 +301,9 @@ namespace BlackMisc::Simulation
         CAircraftModel m_defaultModel; //!< default model
 
         // idea: the elevations on gnd are likely taxiways and runways, so we keep those
-        int m_maxElevations    = 100;   //!< How many elevations we keep
-        int m_maxElevationsGnd = 400;   //!< How many elevations we keep for elevations on gnd.
-        Geo::CCoordinateGeodeticList    m_elvCoordinates;    //!< elevation cache
-        Geo::CCoordinateGeodeticList    m_elvCoordinatesGnd; //!< elevation cache for on ground situations
+        int m_maxElevations    = MinElevationsRemembered; //!< How many elevations we keep
+        int m_maxElevationsGnd = 10000;                   //!< How many elevations we keep for elevations on gnd.
+        mutable Geo::CElevationTileCache m_elvCache;       //!< elevation cache, least recently used ones are evicted, mutable as lookups change the LRU order
 
         Aviation::CTimestampPerCallsign m_pendingElevationRequests; //!< pending elevation requests for aircraft callsign
         Aviation::CLengthPerCallsign    m_cgsPerCallsign;           //!< CGs per callsign
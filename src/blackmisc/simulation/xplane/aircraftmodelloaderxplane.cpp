@@ -16,7 +16,10 @@
 #include "blackmisc/aviation/airlineicaocode.h"
 #include "blackmisc/aviation/livery.h"
 #include "blackmisc/worker.h"
+#include "blackmisc/threadutils.h"
 #include "blackmisc/stringutils.h"
+#include "blackmisc/datacache.h"
+#include "blackmisc/jsonexception.h"
 #include "blackmisc/fileutils.h"
 #include "blackmisc/directoryutils.h"
 #include "blackmisc/statusmessage.h"
@@ -29,10 +32,12 @@
 #include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFlags>
 #include <QIODevice>
+#include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QRegularExpression>
@@ -40,6 +45,7 @@
 #include <QStringBuilder>
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -161,12 +167,39 @@ namespace BlackMisc::Simulation::XPlane
 
     CAircraftModelList CAircraftModelLoaderXPlane::performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories)
     {
+        QElapsedTimer time;
+        time.start();
+        if (m_incrementalParsing && !m_fileIndexLoaded)
+        {
+            m_fileIndex.load(getFileIndexFileName());
+            m_fileIndexLoaded = true;
+        }
+        m_indexedFiles.clear();
+        m_fileIndexModified = false;
+        m_filesParsed = 0;
+        m_filesReused = 0;
+
         CAircraftModelList allModels;
         for (const QString &rootDirectory : rootDirectories)
         {
             allModels.push_back(parseCslPackages(rootDirectory, excludeDirectories));
             allModels.push_back(parseFlyableAirplanes(rootDirectory, excludeDirectories));
         }
+
+        if (m_incrementalParsing)
+        {
+            // files no longer found are removed from the index
+            m_fileIndexModified |= m_fileIndex.retainOnly(m_indexedFiles) > 0;
+            if (m_fileIndexModified && !m_fileIndex.save(getFileIndexFileName()))
+            {
+                const CStatusMessage m = CStatusMessage(this).warning(u"Unable to write XPlane model index '%1'") << getFileIndexFileName();
+                m_loadingMessages.push_back(m);
+            }
+        }
+
+        const CStatusMessage m = CStatusMessage(this).info(u"XPlane scanned %1 packages and airplanes in %2ms: %3 parsed, %4 unchanged") <<
+                                 (m_filesParsed + m_filesReused) << time.elapsed() << m_filesParsed << m_filesReused;
+        m_loadingMessages.push_back(m);
         return allModels;
     }
 
@@ -191,17 +224,51 @@ namespace BlackMisc::Simulation::XPlane
 
         emit loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable airplanes in '%1'").arg(rootDirectory), -1);
 
-        CAircraftModelList installedModels;
+        QVector<QFileInfo> acfFiles;
         while (aircraftIt.hasNext())
         {
             aircraftIt.next();
             if (CFileUtils::isExcludedDirectory(aircraftIt.fileInfo(), excludeDirectories, Qt::CaseInsensitive)) { continue; }
+            acfFiles.push_back(aircraftIt.fileInfo());
+        }
+
+        // the airplanes are independent, the (large) acf files are parsed in parallel
+        // acf files are not hashed, any change of time or size means parsing again
+        struct AcfResult
+        {
+            CAircraftModel model;
+            bool reused = false;
+        };
+
+        const bool incremental = m_incrementalParsing;
+        std::vector<AcfResult> results(static_cast<size_t>(acfFiles.size()));
+        CThreadUtils::forEachIndex(acfFiles.size(), m_parallelParsing, [&](int index)
+        {
+            const QFileInfo &fileInfo = acfFiles[index];
+            AcfResult &result = results[static_cast<size_t>(index)];
+            CAircraftModel &model = result.model;
+            if (incremental)
+            {
+                QByteArray unused;
+                if (CFileIndex::isUnchanged(m_fileIndex.checkFile(fileInfo, unused, false)))
+                {
+                    try
+                    {
+                        model.convertFromJson(m_fileIndex.find(fileInfo.absoluteFilePath())->data.value("model").toObject());
+                        result.reused = true;
+                        return;
+                    }
+                    catch (const CJsonException &)
+                    {
+                        model = CAircraftModel(); // corrupt index entry, parse the file
+                    }
+                }
+            }
 
             using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
-            AcfProperties acfProperties = extractAcfProperties(aircraftIt.filePath().toStdString());
+            AcfProperties acfProperties = extractAcfProperties(fileInfo.filePath().toStdString());
 
             const CDistributor dist({}, QString::fromStdString(acfProperties.author), {}, {}, CSimulatorInfo::XPLANE);
-            CAircraftModel model;
             model.setAircraftIcaoCode(QString::fromStdString(acfProperties.aircraftIcaoCode));
             model.setDescription(QString::fromStdString(acfProperties.modelDescription));
             model.setName(QString::fromStdString(acfProperties.modelName));
@@ -210,13 +277,35 @@ namespace BlackMisc::Simulation::XPlane
             if (!model.hasDescription()) { model.setDescription(descriptionForFlyableModel(model)); }
             model.setModelType(CAircraftModel::TypeOwnSimulatorModel);
             model.setSimulator(CSimulatorInfo::xplane());
-            model.setFileDetailsAndTimestamp(aircraftIt.fileInfo());
+            model.setFileDetailsAndTimestamp(fileInfo);
             model.setModelMode(CAircraftModel::Exclude);
+        });
+
+        CAircraftModelList installedModels;
+        for (int i = 0; i < acfFiles.size(); ++i)
+        {
+            const QFileInfo &fileInfo = acfFiles[i];
+            const AcfResult &result = results[static_cast<size_t>(i)];
+            CAircraftModel model = result.model;
+            m_indexedFiles.insert(fileInfo.absoluteFilePath());
+            if (result.reused) { m_filesReused++; }
+            else
+            {
+                m_filesParsed++;
+                if (incremental)
+                {
+                    QJsonObject data;
+                    data.insert("model", model.toJson());
+                    m_fileIndex.insert(fileInfo.absoluteFilePath(), CFileIndex::createEntry(fileInfo, {}, data));
+                    m_fileIndexModified = true;
+                }
+            }
             addUniqueModel(model, installedModels);
 
+            // liveries are only directories, they are always listed again
             const QString baseModelString = model.getModelString();
-            QDirIterator liveryIt(CFileUtils::appendFilePaths(aircraftIt.fileInfo().canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
-            emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable liveries in '%1'").arg(aircraftIt.fileInfo().canonicalPath()), -1);
+            QDirIterator liveryIt(CFileUtils::appendFilePaths(fileInfo.canonicalPath(), QStringLiteral("liveries")), QDir::Dirs | QDir::NoDotAndDotDot);
+            emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing flyable liveries in '%1'").arg(fileInfo.canonicalPath()), -1);
             while (liveryIt.hasNext())
             {
                 liveryIt.next();
@@ -234,81 +323,221 @@ namespace BlackMisc::Simulation::XPlane
 
         m_cslPackages.clear();
 
+        // Headers first, the names of all packages are needed to resolve the references of the full run.
+        // The package name is kept in the index, so unchanged packages are not read at all.
+        struct PackageFile
+        {
+            QFileInfo fileInfo;
+            QByteArray content;                         //!< content if already read
+            const CFileIndex::Entry *indexed = nullptr; //!< unchanged and indexed
+            bool touchedSameContent = false;            //!< time or size changed, but same content, the index entry is updated
+            CAircraftModelList models;
+            bool reused = false;
+        };
+
+        const bool incremental = m_incrementalParsing;
+        std::vector<PackageFile> packageFiles;
+
         QDir searchPath(rootDirectory, fileFilterCsl());
         QDirIterator it(searchPath, QDirIterator::Subdirectories);
         while (it.hasNext())
         {
-            QString packageFile = it.next();
+            it.next();
             if (CFileUtils::isExcludedDirectory(it.filePath(), excludeDirectories)) { continue; }
 
-            const QString packageFilePath = it.fileInfo().absolutePath();
-            QFile file(packageFile);
-            file.open(QIODevice::ReadOnly);
-            QString content;
+            const QFileInfo fileInfo = it.fileInfo();
+            const QString packageFilePath = fileInfo.absolutePath();
+            m_indexedFiles.insert(fileInfo.absoluteFilePath());
+
+            QByteArray content;
+            const CFileIndex::Entry *indexed = nullptr;
+            CFileIndex::FileState state = CFileIndex::NotIndexed;
+            if (incremental)
+            {
+                state = m_fileIndex.checkFile(fileInfo, content);
+                if (CFileIndex::isUnchanged(state)) { indexed = m_fileIndex.find(fileInfo.absoluteFilePath()); }
+            }
 
-            QTextStream ts(&file);
-            content.append(ts.readAll());
-            file.close();
+            CSLPackage package;
+            if (indexed && indexed->data.contains("name"))
+            {
+                parseExportCommand({ QStringLiteral("EXPORT_NAME"), indexed->data.value("name").toString() }, package, packageFilePath, 0);
+            }
+            else
+            {
+                indexed = nullptr;
+                if (content.isEmpty())
+                {
+                    QFile file(fileInfo.absoluteFilePath());
+                    file.open(QIODevice::ReadOnly);
+                    content = file.readAll();
+                }
+                package = parsePackageHeader(packageFilePath, decodedContent(content));
+            }
 
-            const auto package = parsePackageHeader(packageFilePath, content);
-            if (package.hasValidHeader()) m_cslPackages.push_back(package);
+            m_loadingMessages.push_back(package.messages);
+            package.messages.clear();
+            if (!package.hasValidHeader()) { continue; }
+
+            m_cslPackages.push_back(package);
+            PackageFile packageFile;
+            packageFile.fileInfo = fileInfo;
+            packageFile.content = content;
+            packageFile.indexed = indexed;
+            packageFile.touchedSameContent = state == CFileIndex::UnchangedContent;
+            packageFiles.push_back(packageFile);
         }
 
-        CAircraftModelList installedModels;
+        // Now we do a full run, the packages are independent of each other
+        // m_cslPackages is not resized, the other packages are only read to resolve references
+        CThreadUtils::forEachIndex(m_cslPackages.size(), m_parallelParsing, [&](int index)
+        {
+            CSLPackage &package = m_cslPackages[index];
+            PackageFile &packageFile = packageFiles[static_cast<size_t>(index)];
+            if (packageFile.indexed && hasSameReferences(packageFile.indexed->data))
+            {
+                try
+                {
+                    packageFile.models.convertFromJson(packageFile.indexed->data.value("models").toObject());
+                    package.messages.convertFromJson(packageFile.indexed->data.value("messages").toObject());
+                    packageFile.reused = true;
+                    return;
+                }
+                catch (const CJsonException &)
+                {
+                    packageFile.models.clear(); // corrupt index entry, parse the package
+                    package.messages.clear();
+                }
+            }
+
+            const QString fileName = packageFile.fileInfo.absoluteFilePath();
+            emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing CSL '%1'").arg(fileName), -1);
+
+            if (packageFile.content.isEmpty())
+            {
+                QFile file(fileName);
+                file.open(QIODevice::ReadOnly);
+                packageFile.content = file.readAll();
+            }
+            parseFullPackage(decodedContent(packageFile.content), package);
+            packageFile.models = modelsFromPackage(package);
+        });
 
-        // Now we do a full run
-        for (auto &package : m_cslPackages)
+        // the index is updated when done, inserting could invalidate the entries referenced by packageFiles
+        QVector<QPair<QString, CFileIndex::Entry>> indexUpdates;
+        CAircraftModelList installedModels;
+        for (int i = 0; i < m_cslPackages.size(); ++i)
         {
-            const QString packageFile = CFileUtils::appendFilePaths(package.path, QStringLiteral("xsb_aircraft.txt"));
-            emit this->loadingProgress(this->getSimulator(), QStringLiteral("Parsing CSL '%1'").arg(packageFile), -1);
+            const CSLPackage &package = m_cslPackages[i];
+            const PackageFile &packageFile = packageFiles[static_cast<size_t>(i)];
+            m_loadingMessages.push_back(package.messages);
+            if (packageFile.reused) { m_filesReused++; }
+            else { m_filesParsed++; }
 
-            QFile file(packageFile);
-            file.open(QIODevice::ReadOnly);
-            QString content;
+            if (incremental && (!packageFile.reused || packageFile.touchedSameContent))
+            {
+                QJsonObject resolvedPaths;
+                for (auto rp = package.resolvedPaths.cbegin(); rp != package.resolvedPaths.cend(); ++rp) { resolvedPaths.insert(rp.key(), rp.value()); }
+                QJsonObject dependencies;
+                for (auto d = package.dependencies.cbegin(); d != package.dependencies.cend(); ++d) { dependencies.insert(d.key(), d.value()); }
 
-            QTextStream ts(&file);
-            content.append(ts.readAll());
-            file.close();
-            parseFullPackage(content, package);
+                QJsonObject data = packageFile.reused ? packageFile.indexed->data : QJsonObject();
+                if (!packageFile.reused)
+                {
+                    data.insert("name", package.name);
+                    data.insert("models", packageFile.models.toJson());
+                    data.insert("messages", package.messages.toJson());
+                    data.insert("resolvedPaths", resolvedPaths);
+                    data.insert("dependencies", dependencies);
+                }
+                indexUpdates.push_back({ packageFile.fileInfo.absoluteFilePath(), CFileIndex::createEntry(packageFile.fileInfo, packageFile.content, data) });
+            }
 
-            for (const auto &plane : std::as_const(package.planes))
+            for (const CAircraftModel &model : packageFile.models)
             {
-                if (installedModels.containsModelString(plane.getModelName()))
+                if (installedModels.containsModelString(model.getModelString()))
                 {
-                    const CStatusMessage msg = CStatusMessage(this).warning(u"XPlane model '%1' exists already! Potential model string conflict! Ignoring it.") << plane.getModelName();
+                    const CStatusMessage msg = CStatusMessage(this).warning(u"XPlane model '%1' exists already! Potential model string conflict! Ignoring it.") << model.getModelString();
                     m_loadingMessages.push_back(msg);
                     continue;
                 }
+                installedModels.push_back(model);
+            }
+        }
 
-                CAircraftModel model(plane.getModelName(), CAircraftModel::TypeOwnSimulatorModel);
-                const CAircraftIcaoCode icao(plane.icao);
-                const QFileInfo modelFileInfo(plane.filePath);
-                model.setFileDetailsAndTimestamp(modelFileInfo);
-                model.setAircraftIcaoCode(icao);
+        for (const auto &update : std::as_const(indexUpdates)) { m_fileIndex.insert(update.first, update.second); }
+        m_fileIndexModified |= !indexUpdates.isEmpty();
+        return installedModels;
+    }
 
-                if (CBuildConfig::isLocalDeveloperDebugBuild())
-                {
-                    BLACK_AUDIT_X(modelFileInfo.exists(), Q_FUNC_INFO, "Model does NOT exist");
-                }
+    CAircraftModelList CAircraftModelLoaderXPlane::modelsFromPackage(const CSLPackage &package) const
+    {
+        CAircraftModelList models;
+        for (const auto &plane : std::as_const(package.planes))
+        {
+            CAircraftModel model(plane.getModelName(), CAircraftModel::TypeOwnSimulatorModel);
+            const CAircraftIcaoCode icao(plane.icao);
+            const QFileInfo modelFileInfo(plane.filePath);
+            model.setFileDetailsAndTimestamp(modelFileInfo);
+            model.setAircraftIcaoCode(icao);
 
-                CLivery livery;
-                livery.setCombinedCode(plane.livery);
-                CAirlineIcaoCode airline(plane.airline);
-                livery.setAirlineIcaoCode(airline);
-                model.setLivery(livery);
-
-                model.setSimulator(CSimulatorInfo::xplane());
-                QString modelDescription("[CSL]");
-                if (plane.objectVersion == CSLPlane::OBJ7) { modelDescription += "[OBJ7]"; }
-                else if (plane.objectVersion == CSLPlane::OBJ8) { modelDescription += "[OBJ8]"; }
-                model.setDescription(modelDescription);
-                installedModels.push_back(model);
+            if (CBuildConfig::isLocalDeveloperDebugBuild())
+            {
+                BLACK_AUDIT_X(modelFileInfo.exists(), Q_FUNC_INFO, "Model does NOT exist");
             }
+
+            CLivery livery;
+            livery.setCombinedCode(plane.livery);
+            CAirlineIcaoCode airline(plane.airline);
+            livery.setAirlineIcaoCode(airline);
+            model.setLivery(livery);
+
+            model.setSimulator(CSimulatorInfo::xplane());
+            QString modelDescription("[CSL]");
+            if (plane.objectVersion == CSLPlane::OBJ7) { modelDescription += "[OBJ7]"; }
+            else if (plane.objectVersion == CSLPlane::OBJ8) { modelDescription += "[OBJ8]"; }
+            model.setDescription(modelDescription);
+            models.push_back(model);
         }
-        return installedModels;
+        return models;
     }
 
-    bool CAircraftModelLoaderXPlane::doPackageSub(QString &ioPath)
+    bool CAircraftModelLoaderXPlane::hasSameReferences(const QJsonObject &indexedPackage) const
+    {
+        if (!indexedPackage.contains("models")) { return false; }
+
+        // a reference resolved to a package which was added, removed or moved since the package was indexed
+        const QJsonObject resolvedPaths = indexedPackage.value("resolvedPaths").toObject();
+        for (auto it = resolvedPaths.constBegin(); it != resolvedPaths.constEnd(); ++it)
+        {
+            QString path = it.key();
+            if (!doPackageSub(path)) { path.clear(); }
+            if (path != it.value().toString()) { return false; }
+        }
+
+        const QJsonObject dependencies = indexedPackage.value("dependencies").toObject();
+        for (auto it = dependencies.constBegin(); it != dependencies.constEnd(); ++it)
+        {
+            const QString name = it.key();
+            const bool found = std::any_of(m_cslPackages.cbegin(), m_cslPackages.cend(), [&name](const CSLPackage & p) { return p.name == name; });
+            if (found != it.value().toBool()) { return false; }
+        }
+        return true;
+    }
+
+    QString CAircraftModelLoaderXPlane::decodedContent(const QByteArray &content)
+    {
+        QTextStream ts(content);
+        return ts.readAll();
+    }
+
+    QString CAircraftModelLoaderXPlane::getFileIndexFileName() const
+    {
+        if (!m_fileIndexFileName.isEmpty()) { return m_fileIndexFileName; }
+        return CFileUtils::appendFilePaths(CDataCache::persistentStore(), QStringLiteral("xplanemodelindex.json"));
+    }
+
+    bool CAircraftModelLoaderXPlane::doPackageSub(QString &ioPath) const
     {
         for (auto i = m_cslPackages.cbegin(); i != m_cslPackages.cend(); ++i)
         {
@@ -327,7 +556,7 @@ namespace BlackMisc::Simulation::XPlane
         if (tokens.size() != 2)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : EXPORT_NAME command requires 1 argument.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
 
@@ -341,25 +570,26 @@ namespace BlackMisc::Simulation::XPlane
         else
         {
             const CStatusMessage m = CStatusMessage(this).error(u"XPlane package name '%1' already in use by '%2' reqested by use by '%3'") << tokens[1] << p->path << path;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
     }
 
     bool CAircraftModelLoaderXPlane::parseDependencyCommand(const QStringList &tokens, CSLPackage &package, const QString &path, int lineNum)
     {
-        Q_UNUSED(package);
         if (tokens.size() != 2)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : DEPENDENCY command requires 1 argument.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
 
-        if (std::count_if(m_cslPackages.cbegin(), m_cslPackages.cend(), [&tokens](const CSLPackage & p) { return p.name == tokens[1]; }) == 0)
+        const bool found = std::count_if(m_cslPackages.cbegin(), m_cslPackages.cend(), [&tokens](const CSLPackage & p) { return p.name == tokens[1]; }) > 0;
+        package.dependencies.insert(tokens[1], found);
+        if (!found)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"XPlane required package %1 not found. Aborting processing of this package.") << tokens[1];
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
 
@@ -384,7 +614,7 @@ namespace BlackMisc::Simulation::XPlane
         package.planes.push_back(CSLPlane());
 
         const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-        m_loadingMessages.push_back(m);
+        package.messages.push_back(m);
         return false;
     }
 
@@ -393,7 +623,7 @@ namespace BlackMisc::Simulation::XPlane
         if (!package.planes.isEmpty() && !package.planes.back().hasErrors)
         {
             const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
         }
         return false;
     }
@@ -403,7 +633,7 @@ namespace BlackMisc::Simulation::XPlane
         package.planes.push_back(CSLPlane());
 
         const auto m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported legacy CSL format.") << path << lineNum;
-        m_loadingMessages.push_back(m);
+        package.messages.push_back(m);
         return false;
     }
 
@@ -415,7 +645,7 @@ namespace BlackMisc::Simulation::XPlane
         if (tokens.size() != 2)
         {
             const CStatusMessage m = CStatusMessage(this).warning(u"%1/xsb_aircraft.txt Line %2 : OBJ8_AIRCARFT command requires 1 argument.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             if (tokens.size() < 2)
             {
                 return false;
@@ -435,18 +665,18 @@ namespace BlackMisc::Simulation::XPlane
             if (tokens.size() == 5 || tokens.size() == 6)
             {
                 const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unsupported IVAO CSL format - consider using CSL2XSB.") << path << lineNum;
-                m_loadingMessages.push_back(m);
+                package.messages.push_back(m);
             }
             else
             {
                 const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : OBJ8 command takes 3 arguments.") << path << lineNum;
-                m_loadingMessages.push_back(m);
+                package.messages.push_back(m);
             }
             return false;
         }
         if (package.planes.isEmpty())
         {
-            m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+            package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
             return false;
         }
 
@@ -455,10 +685,12 @@ namespace BlackMisc::Simulation::XPlane
         QString relativePath(tokens[3]);
         normalizePath(relativePath);
         QString fullPath(relativePath);
-        if (!doPackageSub(fullPath))
+        const bool resolved = doPackageSub(fullPath);
+        package.resolvedPaths.insert(relativePath, resolved ? fullPath : QString());
+        if (!resolved)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : package not found.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
 
@@ -485,12 +717,12 @@ namespace BlackMisc::Simulation::XPlane
         if (tokens.size() != 2)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : ICAO command requires 1 argument.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
         if (package.planes.isEmpty())
         {
-            m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+            package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
             return false;
         }
 
@@ -505,12 +737,12 @@ namespace BlackMisc::Simulation::XPlane
         if (tokens.size() != 3)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : AIRLINE command requires 2 arguments.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
         if (package.planes.isEmpty())
         {
-            m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+            package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
             return false;
         }
 
@@ -527,12 +759,12 @@ namespace BlackMisc::Simulation::XPlane
         if (tokens.size() != 4)
         {
             const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : LIVERY command requires 3 arguments.") << path << lineNum;
-            m_loadingMessages.push_back(m);
+            package.messages.push_back(m);
             return false;
         }
         if (package.planes.isEmpty())
         {
-            m_loadingMessages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
+            package.messages.push_back(CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : invalid position for command.") << path << lineNum);
             return false;
         }
 
@@ -630,7 +862,7 @@ namespace BlackMisc::Simulation::XPlane
                 else
                 {
                     const CStatusMessage m = CStatusMessage(this).error(u"%1/xsb_aircraft.txt Line %2 : Unrecognized CSL command: '%3'") << package.path << lineNum << tokens[0];
-                    m_loadingMessages.push_back(m);
+                    package.messages.push_back(m);
                 }
             }
         }
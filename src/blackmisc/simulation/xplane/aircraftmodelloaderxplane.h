@@ -15,14 +15,20 @@
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/aircraftmodelloader.h"
 #include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/statusmessagelist.h"
+#include "blackmisc/fileindex.h"
 
+#include <QMap>
 #include <QObject>
 #include <QPointer>
 #include <QString>
 #include <QStringList>
+#include <QSet>
 #include <QVector>
 #include <QtGlobal>
+#include <atomic>
 
+namespace BlackMiscTest { class CTestXPlane; }
 namespace BlackMisc
 {
     class CWorker;
@@ -51,6 +57,25 @@ namespace BlackMisc
             //! Parsed or injected models
             void updateInstalledModels(const CAircraftModelList &models);
 
+            //! Parse independent CSL packages and flyable airplanes in parallel?
+            bool isParallelParsing() const { return m_parallelParsing; }
+
+            //! Parse independent CSL packages and flyable airplanes in parallel
+            void setParallelParsing(bool parallel) { m_parallelParsing = parallel; }
+
+            //! Only parse packages and airplanes changed since the last load?
+            bool isIncrementalParsing() const { return m_incrementalParsing; }
+
+            //! Only parse packages and airplanes changed since the last load, the others are taken from the file index
+            void setIncrementalParsing(bool incremental) { m_incrementalParsing = incremental; }
+
+            //! File where the index of the parsed packages and airplanes is stored
+            QString getFileIndexFileName() const;
+
+            //! Store the index in another file, by default it is in the persistent store
+            //! \remark set before loading, the index is read once
+            void setFileIndexFileName(const QString &fileName) { m_fileIndexFileName = fileName; }
+
         protected:
             //! \name Interface functions
             //! @{
@@ -58,6 +83,10 @@ namespace BlackMisc
             //! @}
 
         private:
+            //! \cond
+            friend BlackMiscTest::CTestXPlane;
+            //! \endcond
+
             //! CSL Plane data
             struct CSLPlane
             {
@@ -95,13 +124,25 @@ namespace BlackMisc
                 QString name;
                 QString path;
                 QVector<CSLPlane> planes;
+                CStatusMessageList messages;         //!< messages of parsing this package
+                QMap<QString, QString> resolvedPaths; //!< package relative paths -> full paths, empty if not resolved
+                QMap<QString, bool> dependencies;     //!< required packages -> found
             };
 
             CAircraftModelList performParsing(const QStringList &rootDirectories, const QStringList &excludeDirectories);
             CAircraftModelList parseFlyableAirplanes(const QString &rootDirectory, const QStringList &excludeDirectories);
             CAircraftModelList parseCslPackages(const QString &rootDirectory, const QStringList &excludeDirectories);
 
-            bool doPackageSub(QString &ioPath);
+            //! Models of a fully parsed package, model string conflicts are not checked
+            CAircraftModelList modelsFromPackage(const CSLPackage &package) const;
+
+            //! Do the package references stored with an indexed package still resolve to the same packages?
+            bool hasSameReferences(const QJsonObject &indexedPackage) const;
+
+            //! Content of a file as text
+            static QString decodedContent(const QByteArray &content);
+
+            bool doPackageSub(QString &ioPath) const;
 
             bool parseExportCommand(const QStringList &tokens, CSLPackage &package, const QString &path, int lineNum);
             bool parseDependencyCommand(const QStringList &tokens, CSLPackage &package, const QString &path, int lineNum);
@@ -123,6 +164,15 @@ namespace BlackMisc
 
             QPointer<CWorker> m_parserWorker;  //!< worker will destroy itself, so weak pointer
             QVector<CSLPackage> m_cslPackages; //!< Parsed Packages. No lock required since accessed only from one thread
+            CFileIndex m_fileIndex;            //!< index of parsed packages and airplanes, accessed only from the parsing thread
+            QString m_fileIndexFileName;       //!< index file, default if empty
+            bool m_fileIndexLoaded = false;    //!< index read from disk
+            bool m_fileIndexModified = false;  //!< index changed by the current parsing
+            QSet<QString> m_indexedFiles;      //!< files found by the current parsing
+            int m_filesParsed = 0;             //!< files parsed by the current parsing
+            int m_filesReused = 0;             //!< files taken from the index by the current parsing
+            std::atomic_bool m_parallelParsing    { true };
+            std::atomic_bool m_incrementalParsing { true };
 
             static const QString &fileFilterFlyable();
             static const QString &fileFilterCsl();
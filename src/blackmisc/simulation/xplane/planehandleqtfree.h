@@ -0,0 +1,54 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_PLANEHANDLEQTFREE_H
+#define BLACKMISC_SIMULATION_XPLANE_PLANEHANDLEQTFREE_H
+
+// Strict header only plane handle encoding shared between the X-Plane driver and XSwiftBus.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc::Simulation::XPlane::PlaneHandle
+{
+    //! \name Handle layout
+    //! A handle is a slot, reused after a plane is removed, and a generation incremented whenever the slot is reused.
+    //! So XSwiftBus can index its planes by slot, but a stale handle never matches a plane added later.
+    //! @{
+    constexpr int SlotBits       = 16;                      //!< bits of the slot
+    constexpr int MaxSlots       = 1 << SlotBits;           //!< max. planes at the same time
+    constexpr int SlotMask       = MaxSlots - 1;            //!< slot part of a handle
+    constexpr int GenerationMask = 0x7fff;                  //!< generation part, keeps handles positive
+    //! @}
+
+    //! Handle for a slot and generation
+    inline int makeHandle(int slot, int generation)
+    {
+        return (slot & SlotMask) | ((generation & GenerationMask) << SlotBits);
+    }
+
+    //! Slot of a handle, the index of the plane
+    inline int slotOf(int handle)
+    {
+        return handle & SlotMask;
+    }
+
+    //! Generation of a handle
+    inline int generationOf(int handle)
+    {
+        return (handle >> SlotBits) & GenerationMask;
+    }
+
+    //! Valid handle?
+    inline bool isValid(int handle)
+    {
+        return handle >= 0;
+    }
+} // ns
+
+#endif // guard
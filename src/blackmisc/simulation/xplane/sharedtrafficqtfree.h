@@ -0,0 +1,360 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_SHAREDTRAFFICQTFREE_H
+#define BLACKMISC_SIMULATION_XPLANE_SHAREDTRAFFICQTFREE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Strict header only shared memory traffic transport shared between the X-Plane driver and XSwiftBus.
+// Header only is necessary to no require XSwiftBus to link against BlackMisc.
+
+namespace BlackMisc::Simulation::XPlane::SharedTraffic
+{
+    constexpr std::uint32_t Magic      = 0x53575446; //!< "SWTF", marks a valid shared memory object
+    constexpr std::uint32_t Version    = 2;          //!< layout version, driver and XSwiftBus need the same
+    constexpr std::uint32_t MaxPlanes  = 1024;       //!< max. records per frame
+    constexpr std::uint32_t FrameSlots = 4;          //!< frames in the ring
+
+    //! Content of a plane record
+    enum RecordFlag : std::uint32_t
+    {
+        HasPosition      = 1u << 0,  //!< position values are set
+        HasSurfaces      = 1u << 1,  //!< surfaces and lights are set
+        HasTransponder   = 1u << 2,  //!< transponder values are set
+        OnGround         = 1u << 3,  //!< position is on ground
+        LandLights       = 1u << 4,  //!< landing lights on
+        TaxiLights       = 1u << 5,  //!< taxi lights on
+        BeaconLights     = 1u << 6,  //!< beacon lights on
+        StrobeLights     = 1u << 7,  //!< strobe lights on
+        NavLights        = 1u << 8,  //!< nav lights on
+        TransponderModeC = 1u << 9,  //!< transponder mode C
+        TransponderIdent = 1u << 10  //!< transponder ident
+    };
+
+    //! Fixed layout per plane and frame, keyed by the plane handle
+    struct PlaneRecord
+    {
+        std::int32_t  handle;           //!< plane handle as passed to addPlane, see PlaneHandle
+        std::uint32_t flags;            //!< RecordFlag values
+        std::int32_t  transponderCode;  //!< transponder code
+        std::int32_t  lightPattern;     //!< light flash pattern
+        double latitudeDeg;             //!< latitude
+        double longitudeDeg;            //!< longitude
+        double altitudeFt;              //!< altitude
+        float pitchDeg;                 //!< pitch
+        float rollDeg;                  //!< roll (bank)
+        float headingDeg;               //!< heading
+        float gear;                     //!< gear ratio
+        float flaps;                    //!< flaps ratio
+        float spoilers;                 //!< spoilers ratio
+        float speedBrakes;              //!< speed brakes ratio
+        float slats;                    //!< slats ratio
+        float wingSweep;                //!< wing sweep ratio
+        float thrust;                   //!< thrust ratio
+        float elevator;                 //!< elevator (yoke pitch)
+        float rudder;                   //!< rudder (yoke heading)
+        float aileron;                  //!< aileron (yoke roll)
+        std::uint32_t reserved;         //!< padding
+
+        //! Set a flag
+        void setFlag(RecordFlag flag, bool on) { flags = on ? (flags | flag) : (flags & ~static_cast<std::uint32_t>(flag)); }
+
+        //! Is flag set?
+        bool hasFlag(RecordFlag flag) const { return (flags & flag) != 0; }
+    };
+
+    //! One frame of the ring
+    struct Frame
+    {
+        std::atomic<std::uint64_t> sequence; //!< 2 * frame number + 1 while written, 2 * frame number + 2 when complete
+        std::uint64_t publishedNs;           //!< steady clock when published, for latency statistics
+        std::uint32_t count;                 //!< number of records
+        std::uint32_t reserved;              //!< padding
+        PlaneRecord records[MaxPlanes];      //!< records, one per plane
+    };
+
+    //! The shared memory object
+    struct Layout
+    {
+        std::uint32_t magic;                        //!< Magic
+        std::uint32_t version;                      //!< Version
+        std::uint32_t recordSize;                   //!< sizeof(PlaneRecord)
+        std::uint32_t maxPlanes;                    //!< MaxPlanes
+        std::atomic<std::uint64_t> latestFrame;     //!< number of the latest complete frame, 0 for none
+        std::atomic<std::uint32_t> resyncRequests;  //!< incremented by the reader when frames were missed
+        std::atomic<std::uint32_t> readerAttached;  //!< 1 while a reader has the ring opened
+        Frame frames[FrameSlots];                   //!< the ring
+    };
+
+    static_assert(std::is_trivially_copyable_v<PlaneRecord>, "PlaneRecord is copied with memcpy");
+    static_assert(sizeof(PlaneRecord) == 96, "Fixed layout shared between processes");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Atomics in shared memory need to be lock free");
+
+    //! Steady clock nanoseconds, comparable between processes on the same machine
+    inline std::uint64_t steadyNs()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /*!
+     * Ring of traffic frames in POSIX shared memory.
+     *
+     * The driver creates the ring and is the only writer, XSwiftBus opens it and is the only reader.
+     * Each frame slot is guarded by a sequence counter, so the reader never applies a frame which is overwritten while reading.
+     * If the reader falls behind by more than the ring size it asks the writer for a resync, i.e. a frame with all planes.
+     * \remark only supported on Linux, elsewhere all functions fail and DBus is used
+     */
+    class CSharedTrafficRing
+    {
+    public:
+        //! Result of CSharedTrafficRing::readFrames
+        enum ReadResult
+        {
+            NoNewFrame,     //!< nothing published since the last read
+            FramesRead,     //!< all frames since the last read
+            FramesMissed    //!< some frames were overwritten, resync requested
+        };
+
+        //! Constructor
+        CSharedTrafficRing() = default;
+
+        //! Destructor
+        ~CSharedTrafficRing() { this->close(); }
+
+        //! Not copyable
+        //! @{
+        CSharedTrafficRing(const CSharedTrafficRing &) = delete;
+        CSharedTrafficRing &operator =(const CSharedTrafficRing &) = delete;
+        //! @}
+
+        //! Shared memory supported on this platform?
+        static constexpr bool isSupported()
+        {
+#if defined(__linux__)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        //! Create the shared memory object as writer, name like "/swift_traffic_1234"
+        bool create(const std::string &name)
+        {
+            this->close();
+#if defined(__linux__)
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0 && errno == EEXIST)
+            {
+                // left over from a crashed session
+                shm_unlink(name.c_str());
+                fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            }
+            if (fd < 0) { return false; }
+            if (ftruncate(fd, sizeof(Layout)) != 0)
+            {
+                ::close(fd);
+                shm_unlink(name.c_str());
+                return false;
+            }
+            void *memory = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED)
+            {
+                shm_unlink(name.c_str());
+                return false;
+            }
+
+            m_layout = new (memory) Layout {};
+            m_layout->magic = Magic;
+            m_layout->version = Version;
+            m_layout->recordSize = sizeof(PlaneRecord);
+            m_layout->maxPlanes = MaxPlanes;
+            m_name = name;
+            m_owner = true;
+            return true;
+#else
+            (void) name;
+            return false;
+#endif
+        }
+
+        //! Open an existing shared memory object as reader
+        bool open(const std::string &name)
+        {
+            this->close();
+#if defined(__linux__)
+            const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd < 0) { return false; }
+            struct stat info {};
+            if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Layout))
+            {
+                ::close(fd);
+                return false;
+            }
+            void *memory = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED) { return false; }
+
+            Layout *layout = static_cast<Layout *>(memory);
+            if (layout->magic != Magic || layout->version != Version || layout->recordSize != sizeof(PlaneRecord) || layout->maxPlanes != MaxPlanes)
+            {
+                munmap(memory, sizeof(Layout));
+                return false;
+            }
+
+            m_layout = layout;
+            m_name = name;
+            m_owner = false;
+            m_lastReadFrame = m_layout->latestFrame.load(std::memory_order_acquire);
+            m_layout->readerAttached.store(1, std::memory_order_release);
+            return true;
+#else
+            (void) name;
+            return false;
+#endif
+        }
+
+        //! Unmap, the writer also removes the shared memory object
+        void close()
+        {
+#if defined(__linux__)
+            if (!m_layout) { return; }
+            if (!m_owner) { m_layout->readerAttached.store(0, std::memory_order_release); }
+            munmap(static_cast<void *>(m_layout), sizeof(Layout));
+            if (m_owner) { shm_unlink(m_name.c_str()); }
+#endif
+            m_layout = nullptr;
+            m_name.clear();
+            m_owner = false;
+            m_writing = false;
+            m_lastReadFrame = 0;
+        }
+
+        //! Opened or created?
+        bool isOpen() const { return m_layout != nullptr; }
+
+        //! Name of the shared memory object
+        const std::string &getName() const { return m_name; }
+
+        //! Has a reader opened the ring?
+        bool isReaderAttached() const { return m_layout && m_layout->readerAttached.load(std::memory_order_acquire) != 0; }
+
+        //! \name Writer
+        //! @{
+
+        //! Records of the next frame, up to MaxPlanes can be filled before CSharedTrafficRing::publishFrame
+        PlaneRecord *beginFrame()
+        {
+            if (!m_layout || !m_owner) { return nullptr; }
+            const std::uint64_t frame = m_layout->latestFrame.load(std::memory_order_relaxed) + 1;
+            Frame &slot = m_layout->frames[frame % FrameSlots];
+            slot.sequence.store(2 * frame + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_writing = true;
+            return slot.records;
+        }
+
+        //! Publish the frame started by CSharedTrafficRing::beginFrame with count records
+        void publishFrame(std::uint32_t count)
+        {
+            if (!m_layout || !m_writing) { return; }
+            const std::uint64_t frame = m_layout->latestFrame.load(std::memory_order_relaxed) + 1;
+            Frame &slot = m_layout->frames[frame % FrameSlots];
+            slot.count = count < MaxPlanes ? count : MaxPlanes;
+            slot.publishedNs = steadyNs();
+            slot.sequence.store(2 * frame + 2, std::memory_order_release);
+            m_layout->latestFrame.store(frame, std::memory_order_release);
+            m_writing = false;
+        }
+
+        //! Did the reader ask for a resync since the last call?
+        bool takeResyncRequest()
+        {
+            if (!m_layout) { return false; }
+            return m_layout->resyncRequests.exchange(0, std::memory_order_acq_rel) != 0;
+        }
+        //! @}
+
+        //! \name Reader
+        //! @{
+
+        //! Read all frames published since the last read, in publishing order, calling handler(const PlaneRecord &) per record
+        template <class Handler>
+        ReadResult readFrames(Handler handler)
+        {
+            if (!m_layout || m_owner) { return NoNewFrame; }
+            const std::uint64_t latest = m_layout->latestFrame.load(std::memory_order_acquire);
+            if (latest <= m_lastReadFrame) { return NoNewFrame; }
+
+            // the writer can already write the slot after the latest frame
+            bool missed = false;
+            std::uint64_t first = m_lastReadFrame + 1;
+            if (latest - m_lastReadFrame > FrameSlots - 1)
+            {
+                first = latest - (FrameSlots - 2);
+                missed = true;
+            }
+
+            for (std::uint64_t frame = first; frame <= latest; ++frame)
+            {
+                const Frame &slot = m_layout->frames[frame % FrameSlots];
+                const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before != 2 * frame + 2) { missed = true; continue; }
+
+                const std::uint32_t count = slot.count < MaxPlanes ? slot.count : MaxPlanes;
+                m_buffer.resize(count);
+                if (count > 0) { std::memcpy(static_cast<void *>(m_buffer.data()), slot.records, count * sizeof(PlaneRecord)); }
+                const std::uint64_t publishedNs = slot.publishedNs;
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != before) { missed = true; continue; }
+
+                for (const PlaneRecord &record : m_buffer) { handler(record); }
+                m_lastLatencyNs = steadyNs() - publishedNs;
+            }
+
+            m_lastReadFrame = latest;
+            if (missed) { m_layout->resyncRequests.fetch_add(1, std::memory_order_acq_rel); }
+            return missed ? FramesMissed : FramesRead;
+        }
+
+        //! Time between publishing and reading of the last frame read
+        std::uint64_t getLastLatencyNs() const { return m_lastLatencyNs; }
+        //! @}
+
+    private:
+        Layout *m_layout = nullptr;           //!< mapped shared memory
+        std::string m_name;                   //!< shared memory object name
+        bool m_owner = false;                 //!< writer, created the object
+        bool m_writing = false;               //!< frame begun, not yet published
+        std::uint64_t m_lastReadFrame = 0;    //!< reader: last frame read
+        std::uint64_t m_lastLatencyNs = 0;    //!< reader: latency of the last frame read
+        std::vector<PlaneRecord> m_buffer;    //!< reader: copy of a frame
+    };
+} // ns
+
+#endif // guard
@@ -11,7 +11,11 @@
 #include <QCoreApplication>
 #include <QObject>
 #include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
 #include <QtGlobal>
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <sstream>
 
@@ -35,4 +39,33 @@ namespace BlackMisc
         const QString id = QString::fromStdString(oss.str());
         return QStringLiteral("%1 (%2) prio %3").arg(id).arg(thread->objectName()).arg(thread->priority());
     }
+
+    void CThreadUtils::forEachIndex(int count, bool parallel, const std::function<void(int)> &task, QThreadPool *pool)
+    {
+        if (count < 1) { return; }
+        std::atomic_int next { 0 };
+        const auto run = [&]
+        {
+            for (int i = next++; i < count; i = next++) { task(i); }
+        };
+
+        const int workers = parallel ? std::min(count, QThread::idealThreadCount()) - 1 : 0;
+        if (workers < 1) { run(); return; }
+
+        QThreadPool temporaryPool;
+        QThreadPool *usedPool = pool ? pool : &temporaryPool;
+
+        // the pool can be used by others, so only wait for the own workers
+        QSemaphore done;
+        for (int w = 0; w < workers; ++w)
+        {
+            usedPool->start([&]
+            {
+                run();
+                done.release();
+            });
+        }
+        run();
+        done.acquire(workers);
+    }
 } // ns
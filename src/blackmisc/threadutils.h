@@ -21,6 +21,8 @@
 #include <QSharedPointer>
 #include <functional>
 
+class QThreadPool;
+
 namespace BlackMisc
 {
     /*!
@@ -67,6 +69,11 @@ namespace BlackMisc
 
         //! Info about current thread, for debug messages
         static QString currentThreadInfo();
+
+        //! Call task for all indexes 0..count-1, in parallel by a thread pool and the calling thread
+        //! \remark returns when all tasks are done, with parallel=false all tasks run in the calling thread
+        //! \remark without a pool a temporary one is used, with a pool its threads and their thread local data can be reused
+        static void forEachIndex(int count, bool parallel, const std::function<void(int)> &task, QThreadPool *pool = nullptr);
     };
 } // ns
 
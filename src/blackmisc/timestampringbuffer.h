@@ -0,0 +1,183 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_TIMESTAMPRINGBUFFER_H
+#define BLACKMISC_TIMESTAMPRINGBUFFER_H
+
+#include "blackmisc/timestampbased.h"
+#include <QtGlobal>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace BlackMisc
+{
+    /*!
+     * Fixed capacity history of timestamp with offset based objects, latest first.
+     * Used for the per callsign parts and situation histories, pushing a new object is O(1) and overwrites the oldest object,
+     * lookups by adjusted time are binary searches.
+     * \remark Keeps the same order and offsets as LIST::push_frontKeepLatestFirstAdjustOffset with maxElements = Capacity,
+     *         so toList() returns what a LIST maintained that way would contain.
+     * \remark Not thread safe, access has to be guarded by the owner
+     */
+    template <class OBJ, class LIST, int Capacity>
+    class CTimestampRingBuffer
+    {
+        static_assert(std::is_base_of_v<ITimestampWithOffsetBased, OBJ>, "OBJ needs to implement ITimestampWithOffsetBased");
+        static_assert(Capacity > 1, "Capacity needs to be > 1");
+
+    public:
+        //! Number of objects
+        int size() const { return m_size; }
+
+        //! Empty?
+        bool isEmpty() const { return m_size < 1; }
+
+        //! Full? Next push will overwrite the oldest object
+        bool isFull() const { return m_size >= Capacity; }
+
+        //! Max.number of objects
+        static constexpr int capacity() { return Capacity; }
+
+        //! Object by index, 0 is the latest
+        //! @{
+        const OBJ &operator [](int index) const { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "index"); return m_data[slot(index)]; }
+        OBJ &operator [](int index) { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "index"); return m_data[slot(index)]; }
+        //! @}
+
+        //! Latest object
+        //! \pre not empty
+        //! @{
+        const OBJ &front() const { return (*this)[0]; }
+        OBJ &front() { return (*this)[0]; }
+        //! @}
+
+        //! Oldest object
+        //! \pre not empty
+        const OBJ &back() const { return (*this)[m_size - 1]; }
+
+        //! Latest object or default
+        OBJ frontOrDefault() const { return this->isEmpty() ? OBJ() : this->front(); }
+
+        //! Remove all objects
+        void clear() { m_size = 0; m_head = 0; }
+
+        //! Insert as first element by keeping the latest first
+        //! \remark same as LIST::push_frontKeepLatestFirstAdjustOffset, O(1) unless the value is older than the latest object
+        void push_frontKeepLatestFirstAdjustOffset(const OBJ &value, bool replaceSameTimestamp = true)
+        {
+            if (m_data.empty()) { m_data.resize(Capacity); }
+            if (replaceSameTimestamp && m_size > 0 && this->front().getMSecsSinceEpoch() == value.getMSecsSinceEpoch())
+            {
+                this->front() = value;
+            }
+            else
+            {
+                const bool needSort = m_size > 0 && value.isOlderThan(this->front());
+                m_head = (m_head + Capacity - 1) % Capacity; // overwrites the oldest if full
+                m_data[m_head] = value;
+                if (m_size < Capacity) { m_size++; }
+
+                // out of order, move to its position
+                for (int i = 0; needSort && i < m_size - 1 && (*this)[i].isOlderThan((*this)[i + 1]); ++i)
+                {
+                    std::swap((*this)[i], (*this)[i + 1]);
+                }
+            }
+
+            // same offset adjustment as in the list
+            if (m_size < 2) { return; }
+            OBJ &first = this->front();
+            const OBJ &second = (*this)[1];
+            if (!first.isNewerThanAdjusted(second))
+            {
+                const qint64 minReqOs = second.getAdjustedMSecsSinceEpoch() - first.getMSecsSinceEpoch();
+                const qint64 avgOs = (first.getTimeOffsetMs() + second.getTimeOffsetMs()) / 2;
+                first.setTimeOffsetMs(qMax(minReqOs + 1, avgOs));
+            }
+        }
+
+        //! Replace all objects by value and copies of value with older timestamps
+        //! \remark same as LIST::prefillLatestAdjustedFirst, at most Capacity objects
+        void prefillLatestAdjustedFirst(const OBJ &value, int elements, qint64 deltaTimeMs = -1)
+        {
+            if (m_data.empty()) { m_data.resize(Capacity); }
+            const qint64 os = -1 * qAbs(deltaTimeMs < 0 ? value.getTimeOffsetMs() : deltaTimeMs);
+            m_head = 0;
+            m_size = qBound(1, elements, Capacity);
+            for (int i = 0; i < m_size; i++)
+            {
+                m_data[i] = value;
+                m_data[i].addMsecs(os * i);
+            }
+        }
+
+        //! Remove objects with a timestamp before msSinceEpoch, but keep the latest one
+        //! \return number of removed objects
+        int removeBeforeKeepLatest(qint64 msSinceEpoch)
+        {
+            int removed = 0;
+            while (m_size > 1 && this->back().getMSecsSinceEpoch() < msSinceEpoch) { m_size--; removed++; }
+            return removed;
+        }
+
+        //! Index of the first (latest) object with adjusted timestamp <= msSinceEpoch, size() if there is none
+        //! \remark binary search, requires adjusted timestamps sorted latest first
+        int indexOfFirstNotNewerThanAdjusted(qint64 msSinceEpoch) const
+        {
+            int first = 0;
+            int count = m_size;
+            while (count > 0)
+            {
+                const int step = count / 2;
+                const int i = first + step;
+                if ((*this)[i].getAdjustedMSecsSinceEpoch() > msSinceEpoch) { first = i + 1; count -= step + 1; }
+                else { count = step; }
+            }
+            return first;
+        }
+
+        //! Latest object with adjusted timestamp <= msSinceEpoch, or the oldest object if all objects are newer
+        //! \remark what an interpolator uses for "current" values, default object if empty
+        OBJ findObjectValidAtAdjustedOrDefault(qint64 msSinceEpoch) const
+        {
+            if (this->isEmpty()) { return OBJ(); }
+            const int i = this->indexOfFirstNotNewerThanAdjusted(msSinceEpoch);
+            return i < m_size ? (*this)[i] : this->back();
+        }
+
+        //! Latest object with adjusted timestamp < msSinceEpoch, default object if none
+        //! \remark same result as LIST::findObjectBeforeAdjustedOrDefault
+        OBJ findObjectBeforeAdjustedOrDefault(qint64 msSinceEpoch) const
+        {
+            const int i = this->indexOfFirstNotNewerThanAdjusted(msSinceEpoch - 1);
+            return i < m_size ? (*this)[i] : OBJ();
+        }
+
+        //! All objects as list, latest first
+        LIST toList() const
+        {
+            LIST list;
+            for (int i = 0; i < m_size; ++i) { list.push_back((*this)[i]); }
+            list.setAdjustedSortHint(LIST::AdjustedTimestampLatestFirst);
+            return list;
+        }
+
+    private:
+        //! Slot in m_data for index
+        int slot(int index) const { return (m_head + index) % Capacity; }
+
+        std::vector<OBJ> m_data; //!< allocated on first push
+        int m_head = 0;          //!< slot of the latest object
+        int m_size = 0;          //!< number of objects
+    };
+} // ns
+
+#endif // guard
@@ -0,0 +1,220 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/trigramindex.h"
+
+#include <QStringList>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace BlackMisc
+{
+    namespace
+    {
+        //! Text matching the parts of a wildcard expression split at '*'
+        bool matchesWildcardParts(const QString &text, const QStringList &parts)
+        {
+            const QString &first = parts.front();
+            const QString &last = parts.back();
+            if (text.size() < first.size() + last.size()) { return false; }
+            if (!text.startsWith(first) || !text.endsWith(last)) { return false; }
+
+            int pos = first.size();
+            const int end = text.size() - last.size();
+            for (int i = 1; i < parts.size() - 1; ++i)
+            {
+                const QString &part = parts[i];
+                if (part.isEmpty()) { continue; }
+                const int found = text.indexOf(part, pos);
+                if (found < 0 || found + part.size() > end) { return false; }
+                pos = found + part.size();
+            }
+            return true;
+        }
+    }
+
+    void CTrigramIndex::insert(int id, const QString &text)
+    {
+        const QString folded = fold(text);
+        if (folded.isEmpty()) { return; }
+
+        const int position = m_texts.size();
+        const QVector<Trigram> trigrams = CTrigramIndex::trigrams(folded, true);
+        for (Trigram trigram : trigrams)
+        {
+            m_postings[trigram].push_back(position);
+        }
+        m_equal[folded].push_back(position);
+        m_texts.push_back(folded);
+        m_ids.push_back(id);
+        m_trigramCounts.push_back(trigrams.size());
+    }
+
+    void CTrigramIndex::clear()
+    {
+        m_texts.clear();
+        m_ids.clear();
+        m_trigramCounts.clear();
+        m_postings.clear();
+        m_equal.clear();
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::findEqual(const QString &text) const
+    {
+        const auto it = m_equal.constFind(fold(text));
+        if (it == m_equal.constEnd()) { return {}; }
+        return this->verified(it.value(), [](const QString &) { return true; });
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::findContaining(const QString &fragment) const
+    {
+        const QString folded = fold(fragment);
+        return this->verified(this->candidates(folded), [&](const QString &text) { return text.contains(folded); });
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::findStartingWith(const QString &prefix) const
+    {
+        const QString folded = fold(prefix);
+        return this->verified(this->candidates(folded), [&](const QString &text) { return text.startsWith(folded); });
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::findEndingWith(const QString &suffix) const
+    {
+        const QString folded = fold(suffix);
+        return this->verified(this->candidates(folded), [&](const QString &text) { return text.endsWith(folded); });
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::findByWildcard(const QString &expression) const
+    {
+        const QString folded = fold(expression);
+        if (!folded.contains('*')) { return this->findEqual(folded); }
+
+        // the longest part selects the candidates, all parts are verified
+        const QStringList parts = folded.split('*');
+        const QString longest = *std::max_element(parts.begin(), parts.end(), [](const QString &a, const QString &b) { return a.size() < b.size(); });
+        return this->verified(this->candidates(longest), [&](const QString &text) { return matchesWildcardParts(text, parts); });
+    }
+
+    int CTrigramIndex::findEqualOrMostSimilar(const QString &text, bool allowSimilar, double minScore, bool *similar) const
+    {
+        if (similar) { *similar = false; }
+        const Ids equal = this->findEqual(text);
+        if (!equal.isEmpty()) { return equal.front(); }
+        if (!allowSimilar) { return -1; }
+
+        const QVector<Match> matches = this->findFuzzy(text, 1, minScore);
+        if (matches.isEmpty()) { return -1; }
+        if (similar) { *similar = true; }
+        return matches.front().id;
+    }
+
+    QVector<CTrigramIndex::Match> CTrigramIndex::findFuzzy(const QString &query, int maxResults, double minScore) const
+    {
+        const QString folded = fold(query);
+        if (folded.isEmpty() || m_texts.isEmpty()) { return {}; }
+
+        // count the common trigrams of all texts sharing at least one trigram with the query
+        const QVector<Trigram> trigrams = CTrigramIndex::trigrams(folded, true);
+        QVector<int> common(m_texts.size(), 0);
+        QVector<int> touched;
+        for (Trigram trigram : trigrams)
+        {
+            const auto it = m_postings.constFind(trigram);
+            if (it == m_postings.constEnd()) { continue; }
+            for (int position : it.value())
+            {
+                if (common[position]++ == 0) { touched.push_back(position); }
+            }
+        }
+
+        // Dice coefficient, best score per id
+        QHash<int, double> best;
+        for (int position : touched)
+        {
+            const double score = 2.0 * common[position] / (trigrams.size() + m_trigramCounts[position]);
+            if (score < minScore) { continue; }
+            double &idScore = best[m_ids[position]];
+            if (score > idScore) { idScore = score; }
+        }
+
+        QVector<Match> matches;
+        matches.reserve(best.size());
+        for (auto it = best.constBegin(); it != best.constEnd(); ++it)
+        {
+            matches.push_back({ it.key(), it.value() });
+        }
+        std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b)
+        {
+            return a.score != b.score ? a.score > b.score : a.id < b.id;
+        });
+        if (maxResults > 0 && matches.size() > maxResults) { matches.resize(maxResults); }
+        return matches;
+    }
+
+    QString CTrigramIndex::fold(const QString &text)
+    {
+        return text.trimmed().toCaseFolded();
+    }
+
+    QVector<CTrigramIndex::Trigram> CTrigramIndex::trigrams(const QString &folded, bool padded)
+    {
+        const QString text = padded ? QStringLiteral("  ") + folded + QLatin1Char(' ') : folded;
+        QVector<Trigram> trigrams;
+        if (text.size() < 3) { return trigrams; }
+        trigrams.reserve(text.size() - 2);
+        for (int i = 0; i + 2 < text.size(); ++i)
+        {
+            trigrams.push_back(
+                (static_cast<Trigram>(text[i].unicode()) << 32) |
+                (static_cast<Trigram>(text[i + 1].unicode()) << 16) |
+                static_cast<Trigram>(text[i + 2].unicode()));
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        return trigrams;
+    }
+
+    QVector<int> CTrigramIndex::candidates(const QString &folded) const
+    {
+        QVector<int> positions;
+        if (folded.size() < 3)
+        {
+            // too short for a trigram, all texts are candidates
+            positions.resize(m_texts.size());
+            std::iota(positions.begin(), positions.end(), 0);
+            return positions;
+        }
+
+        // intersect the posting lists, shortest first
+        QVector<const QVector<int> *> postings;
+        for (Trigram trigram : CTrigramIndex::trigrams(folded, false))
+        {
+            const auto it = m_postings.constFind(trigram);
+            if (it == m_postings.constEnd()) { return {}; }
+            postings.push_back(&it.value());
+        }
+        std::sort(postings.begin(), postings.end(), [](const QVector<int> *a, const QVector<int> *b) { return a->size() < b->size(); });
+
+        positions = *postings.front();
+        for (int i = 1; i < postings.size() && !positions.isEmpty(); ++i)
+        {
+            QVector<int> intersection;
+            std::set_intersection(positions.cbegin(), positions.cend(), postings[i]->cbegin(), postings[i]->cend(), std::back_inserter(intersection));
+            positions = std::move(intersection);
+        }
+        return positions;
+    }
+
+    CTrigramIndex::Ids CTrigramIndex::sortedUnique(Ids ids)
+    {
+        if (!std::is_sorted(ids.cbegin(), ids.cend())) { std::sort(ids.begin(), ids.end()); }
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+} // ns
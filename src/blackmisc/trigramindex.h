@@ -0,0 +1,114 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_TRIGRAMINDEX_H
+#define BLACKMISC_TRIGRAMINDEX_H
+
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    /*!
+     * Inverted trigram index over strings (e.g. model strings, airline names), case insensitive.
+     *
+     * Each text belongs to an id chosen by the caller (e.g. the position in a list), an id can have several texts (e.g. aliases).
+     * Substring, prefix, suffix and wildcard lookups only verify the texts containing all trigrams of the searched fragment,
+     * fuzzy lookups rank the texts by the share of common trigrams.
+     * \remark built once, all const functions can be used concurrently
+     */
+    class BLACKMISC_EXPORT CTrigramIndex
+    {
+    public:
+        //! Ids, ascending
+        using Ids = QVector<int>;
+
+        //! Result of a fuzzy lookup
+        struct Match
+        {
+            int id = -1;        //!< id of the text
+            double score = 0.0; //!< 0..1, 1 for equal texts
+        };
+
+        //! Default constructor, empty index
+        CTrigramIndex() = default;
+
+        //! Add a text for an id
+        //! \remark empty texts are ignored
+        void insert(int id, const QString &text);
+
+        //! Number of texts
+        int size() const { return m_texts.size(); }
+
+        //! No texts?
+        bool isEmpty() const { return m_texts.isEmpty(); }
+
+        //! Remove all texts
+        void clear();
+
+        //! \name Lookups, results as ascending ids without duplicates
+        //! @{
+        Ids findEqual(const QString &text) const;
+        Ids findContaining(const QString &fragment) const;
+        Ids findStartingWith(const QString &prefix) const;
+        Ids findEndingWith(const QString &suffix) const;
+        //! @}
+
+        //! Lookup by a filter expression with '*' wildcards like "*320*", "A3*", "*NEO" or "A3*NEO"
+        //! \remark without wildcard the whole text has to be equal
+        Ids findByWildcard(const QString &expression) const;
+
+        //! Most similar texts first, each id only once with its best score
+        QVector<Match> findFuzzy(const QString &query, int maxResults = 10, double minScore = 0.3) const;
+
+        //! Id of an equal text, with allowSimilar else of the most similar text, -1 if there is none
+        //! \remark similar is set if the id is not the one of an equal text
+        int findEqualOrMostSimilar(const QString &text, bool allowSimilar, double minScore, bool *similar = nullptr) const;
+
+        //! Trimmed and case folded as stored in the index
+        static QString fold(const QString &text);
+
+    private:
+        //! Three characters packed
+        using Trigram = quint64;
+
+        //! Distinct trigrams of a folded text, padded to also weight start and end of the text
+        static QVector<Trigram> trigrams(const QString &folded, bool padded);
+
+        //! Positions of the texts containing all trigrams of the folded fragment
+        QVector<int> candidates(const QString &folded) const;
+
+        //! Ids of the candidate texts fulfilling the predicate
+        template <class Predicate>
+        Ids verified(const QVector<int> &positions, Predicate predicate) const
+        {
+            Ids ids;
+            for (int position : positions)
+            {
+                if (predicate(m_texts[position])) { ids.push_back(m_ids[position]); }
+            }
+            return sortedUnique(ids);
+        }
+
+        //! Sorted and without duplicates
+        static Ids sortedUnique(Ids ids);
+
+        QVector<QString> m_texts;               //!< folded texts
+        QVector<int> m_ids;                     //!< id per text
+        QVector<int> m_trigramCounts;           //!< distinct padded trigrams per text
+        QHash<Trigram, QVector<int>> m_postings; //!< text positions per trigram, ascending
+        QHash<QString, QVector<int>> m_equal;   //!< text positions per folded text
+    };
+} // ns
+
+#endif // guard
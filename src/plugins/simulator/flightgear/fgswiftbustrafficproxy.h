@@ -12,6 +12,7 @@
 #define BLACKSIMPLUGIN_FLIGHTGEAR_TRAFFIC_PROXY_H
 
 #include "blackmisc/genericdbusinterface.h"
+#include "blackmisc/dbusutils.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/callsign.h"
@@ -77,6 +78,13 @@ namespace BlackSimPlugin::Flightgear
         QList<double> headingsDeg;     //!< List of headings
         QList<double> groundSpeedKts; //!<List of groundspeeds
         QList<bool> onGrounds;      //!< List of onGrounds
+
+        //! DBus payload per plane without the callsign
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(latitudesDeg), decltype(longitudesDeg), decltype(altitudesFt),
+                   decltype(pitchesDeg), decltype(rollsDeg), decltype(headingsDeg), decltype(groundSpeedKts), decltype(onGrounds)>();
+        }
     };
 
     //! Planes surfaces
@@ -124,6 +132,14 @@ namespace BlackSimPlugin::Flightgear
         QList<bool> navLights;      //!< List of navLights
         QList<int> lightPatterns;   //!< List of lightPatterns
         QList<bool> taxiLights;     //!< List of taxi lights
+
+        //! DBus payload per plane without the callsign
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(gears), decltype(flaps), decltype(spoilers), decltype(speedBrakes),
+                   decltype(slats), decltype(wingSweeps), decltype(thrusts), decltype(elevators), decltype(rudders), decltype(ailerons),
+                   decltype(landLights), decltype(beaconLights), decltype(strobeLights), decltype(navLights), decltype(lightPatterns), decltype(taxiLights)>();
+        }
     };
 
     //! Plane Transponders
@@ -136,6 +152,12 @@ namespace BlackSimPlugin::Flightgear
         QList<int> codes;       //!< List of transponder codes
         QList<bool> modeCs;     //!< List of active mode C's
         QList<bool> idents;     //!< List of active idents
+
+        //! DBus payload per plane without the callsign
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(codes), decltype(modeCs), decltype(idents)>();
+        }
     };
 
     //! Multiplayer Acquire Info
@@ -111,6 +111,9 @@ namespace BlackSimPlugin::Flightgear
         m_airportUpdater.start(60 * 1000);
         m_pendingAddedTimer.start(5000);
 
+        // DBus payload per plane, the planes are keyed by callsign
+        this->setRemoteAircraftDeltaWireSizes({ PlanesPositions::dBusSizePerPlane(), PlanesSurfaces::dBusSizePerPlane(), PlanesTransponders::dBusSizePerPlane(), 0, true });
+
         this->setDefaultModel({ "FG c172p", CAircraftModel::TypeModelMatchingDefaultModel,
                                 "C172", CAircraftIcaoCode("C172", "L1P")});
         this->resetFlightgearData();
@@ -652,9 +655,13 @@ namespace BlackSimPlugin::Flightgear
         PlanesSurfaces planesSurfaces;
         PlanesTransponders planesTransponders;
 
-        int aircraftNumber = 0;
+        // aircraft no longer in range are removed from m_flightgearAircraftObjects by physicallyRemoveRemoteAircraft,
+        // so no per frame check against the callsigns in range
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
-        const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+        this->beginRemoteAircraftDelta(updateAllAircraft, currentTimestamp);
+        QVector<const CFlightgearMPAircraft *> aircraftToInterpolate;
+        QVector<CInterpolatorMulti *> interpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
         for (const CFlightgearMPAircraft &flightgearAircraft : std::as_const(m_flightgearAircraftObjects))
         {
             const CCallsign callsign(flightgearAircraft.getCallsign());
@@ -666,26 +673,34 @@ namespace BlackSimPlugin::Flightgear
                 continue;
             }
 
-            // skip no longer in range
-            if (!callsignsInRange.contains(callsign)) { continue; }
-
-            planesTransponders.callsigns.push_back(callsign.asString());
-            planesTransponders.codes.push_back(flightgearAircraft.getAircraft().getTransponderCode());
-            CTransponder::TransponderMode transponderMode = flightgearAircraft.getAircraft().getTransponderMode();
-            planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
-            planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
-
             // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            aircraftToInterpolate.push_back(&flightgearAircraft);
+            interpolators.push_back(flightgearAircraft.getInterpolator());
+            setups.push_back(this->getInterpolationSetupConsolidated(callsign, updateAllAircraft));
+        }
+
+        // interpolated situations/parts, all aircraft in one call
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(interpolators, setups, currentTimestamp);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const CFlightgearMPAircraft &flightgearAircraft = *aircraftToInterpolate[i];
+            const CCallsign callsign(flightgearAircraft.getCallsign());
+            const CInterpolationResult &result = results[i];
+            const CTransponder transponder = flightgearAircraft.getAircraft().getTransponder();
+            if (this->isSendingRemoteAircraftDelta(callsign, transponder))
+            {
+                planesTransponders.callsigns.push_back(callsign.asString());
+                planesTransponders.codes.push_back(transponder.getTransponderCode());
+                planesTransponders.idents.push_back(transponder.getTransponderMode() == CTransponder::StateIdent);
+                planesTransponders.modeCs.push_back(transponder.getTransponderMode() == CTransponder::ModeC);
+            }
 
-            // interpolated situation/parts
-            const CInterpolationResult result = flightgearAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
             if (result.getInterpolationStatus().hasValidSituation())
             {
                 const CAircraftSituation interpolatedSituation(result);
 
                 // update situation
-                if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                if (this->isSendingRemoteAircraftDelta(interpolatedSituation))
                 {
                     this->rememberLastSent(interpolatedSituation);
                     planesPositions.push_back(interpolatedSituation);
@@ -699,7 +714,7 @@ namespace BlackSimPlugin::Flightgear
             const CAircraftParts parts(result);
             if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
             {
-                if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
+                if (this->isSendingRemoteAircraftDelta(callsign, parts))
                 {
                     this->rememberLastSent(parts, callsign);
                     planesSurfaces.push_back(flightgearAircraft.getCallsign(), parts);
@@ -728,6 +743,7 @@ namespace BlackSimPlugin::Flightgear
         }
 
         // stats
+        this->finishRemoteAircraftDelta();
         this->finishUpdateRemoteAircraftAndSetStatistics(currentTimestamp);
     }
 
@@ -790,8 +806,9 @@ namespace BlackSimPlugin::Flightgear
             BLACK_VERIFY_X(!emptyCs, Q_FUNC_INFO, "Need callsign");
             if (emptyCs) { continue; }
             const CCallsign cs(callsigns[i]);
-            if (!m_flightgearAircraftObjects.contains(cs)) { continue; }
-            const CFlightgearMPAircraft fgAircraft = m_flightgearAircraftObjects[cs];
+            const auto it = m_flightgearAircraftObjects.constFind(cs);
+            if (it == m_flightgearAircraftObjects.constEnd()) { continue; }
+            const CFlightgearMPAircraft fgAircraft = it.value();
             BLACK_VERIFY_X(fgAircraft.hasCallsign(), Q_FUNC_INFO, "Need callsign");
             if (!fgAircraft.hasCallsign()) { continue; }
 
@@ -2012,9 +2012,11 @@ namespace BlackSimPlugin::FsxCommon
         // interpolation for all remote aircraft
         const QList<CSimConnectObject> simObjects(m_simConnectObjects.values());
 
-        int simObjectNumber = 0;
         const bool traceSendId       = this->isTracingSendId();
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
+        QVector<const CSimConnectObject *> simObjectsToInterpolate;
+        QVector<CInterpolatorMulti *> interpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
         for (const CSimConnectObject &simObject : simObjects)
         {
             // happening if aircraft is not yet added to simulator or to be deleted
@@ -2027,16 +2029,25 @@ namespace BlackSimPlugin::FsxCommon
             BLACK_VERIFY_X(hasCs, Q_FUNC_INFO, "missing callsign");
             BLACK_AUDIT_X(hasValidIds, Q_FUNC_INFO, "Missing ids");
             if (!hasCs || !hasValidIds) { continue; } // not supposed to happen
-            const DWORD objectId = simObject.getObjectId();
 
             // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            simObjectsToInterpolate.push_back(&simObject);
+            interpolators.push_back(simObject.getInterpolator());
+            setups.push_back(this->getInterpolationSetupConsolidated(callsign, updateAllAircraft));
+        }
+
+        // Interpolated situations, all aircraft in one call
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(interpolators, setups, currentTimestamp);
+        for (int simObjectNumber = 0; simObjectNumber < results.size(); ++simObjectNumber)
+        {
+            const CSimConnectObject &simObject = *simObjectsToInterpolate[simObjectNumber];
+            const DWORD objectId = simObject.getObjectId();
+            const CInterpolationAndRenderingSetupPerCallsign &setup = setups[simObjectNumber];
             const bool sendGround = setup.isSendingGndFlagToSimulator();
 
-            // Interpolated situation
-            // simObjectNumber is passed to equally distributed steps like guessing parts
+            // simObjectNumber was passed to equally distributed steps like guessing parts
             const bool slowUpdate = (((m_statsUpdateAircraftRuns + simObjectNumber) % 40) == 0);
-            const CInterpolationResult result = simObject.getInterpolation(currentTimestamp, setup, simObjectNumber++);
+            const CInterpolationResult &result = results[simObjectNumber];
             const bool forceUpdate = slowUpdate || updateAllAircraft || setup.isForcingFullInterpolation();
             if (result.getInterpolationStatus().hasValidSituation())
             {
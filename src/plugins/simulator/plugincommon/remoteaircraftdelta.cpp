@@ -0,0 +1,201 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "remoteaircraftdelta.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/transponder.h"
+#include "blackmisc/dbusutils.h"
+#include "blackmisc/stringutils.h"
+
+#include <QtMath>
+#include <cmath>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackSimPlugin::Common
+{
+    namespace
+    {
+        //! Meters per degree latitude
+        constexpr double MetersPerDegree = 111320.0;
+
+        //! Difference of 2 angles in degrees, 0..180
+        double angleDifferenceDeg(double a, double b)
+        {
+            const double d = std::fmod(std::abs(a - b), 360.0);
+            return d > 180.0 ? 360.0 - d : d;
+        }
+
+        //! Parts relevant for the simulator as bits
+        int partsFlags(const CAircraftParts &parts)
+        {
+            const CAircraftLights lights = parts.getLights();
+            int flags = 0;
+            if (parts.isGearDown())      { flags |= 1 << 0; }
+            if (parts.isSpoilersOut())   { flags |= 1 << 1; }
+            if (parts.isAnyEngineOn())   { flags |= 1 << 2; }
+            if (parts.isOnGround())      { flags |= 1 << 3; }
+            if (lights.isLandingOn())    { flags |= 1 << 4; }
+            if (lights.isTaxiOn())       { flags |= 1 << 5; }
+            if (lights.isBeaconOn())     { flags |= 1 << 6; }
+            if (lights.isStrobeOn())     { flags |= 1 << 7; }
+            if (lights.isNavOn())        { flags |= 1 << 8; }
+            if (lights.isLogoOn())       { flags |= 1 << 9; }
+            return flags;
+        }
+    }
+
+    void CRemoteAircraftDelta::beginFrame(bool updateAll, qint64 currentTimestamp)
+    {
+        m_updateAll = updateAll;
+        m_frameTimestamp = currentTimestamp;
+        m_frame++;
+        m_frameBytesSent = 0;
+        m_frameBytesFull = 0;
+    }
+
+    bool CRemoteAircraftDelta::isSending(const CAircraftSituation &situation)
+    {
+        Sent &sent = m_sent[situation.getCallsign()];
+        if (!m_enabled)
+        {
+            this->count(sent, m_wireSizes.situation + this->keyBytes(situation.getCallsign()), true);
+            return true;
+        }
+
+        const double latDeg = situation.latitude().value(CAngleUnit::deg());
+        const double lonDeg = situation.longitude().value(CAngleUnit::deg());
+        const double altM = situation.getAltitude().value(CLengthUnit::m());
+        const double pitchDeg = situation.getPitch().value(CAngleUnit::deg());
+        const double bankDeg = situation.getBank().value(CAngleUnit::deg());
+        const double headingDeg = situation.getHeading().value(CAngleUnit::deg());
+        const double gsKts = situation.getGroundSpeed().value(CSpeedUnit::kts());
+        const int onGround = static_cast<int>(situation.getOnGround());
+
+        bool sending = this->isDue(sent.situationMs) || sent.onGround != onGround;
+        if (!sending)
+        {
+            const double dNorthM = (latDeg - sent.latitudeDeg) * MetersPerDegree;
+            const double dEastM = angleDifferenceDeg(lonDeg, sent.longitudeDeg) * MetersPerDegree * std::cos(qDegreesToRadians(latDeg));
+            sending = std::hypot(dNorthM, dEastM) > m_tolerances.positionM ||
+                      std::abs(altM - sent.altitudeM) > m_tolerances.altitudeM ||
+                      angleDifferenceDeg(pitchDeg, sent.pitchDeg) > m_tolerances.angleDeg ||
+                      angleDifferenceDeg(bankDeg, sent.bankDeg) > m_tolerances.angleDeg ||
+                      angleDifferenceDeg(headingDeg, sent.headingDeg) > m_tolerances.angleDeg ||
+                      std::abs(gsKts - sent.groundSpeedKts) > m_tolerances.groundSpeedKts;
+        }
+
+        if (sending)
+        {
+            sent.situationMs = m_frameTimestamp;
+            sent.latitudeDeg = latDeg;
+            sent.longitudeDeg = lonDeg;
+            sent.altitudeM = altM;
+            sent.pitchDeg = pitchDeg;
+            sent.bankDeg = bankDeg;
+            sent.headingDeg = headingDeg;
+            sent.groundSpeedKts = gsKts;
+            sent.onGround = onGround;
+        }
+        this->count(sent, m_wireSizes.situation + this->keyBytes(situation.getCallsign()), sending);
+        return sending;
+    }
+
+    bool CRemoteAircraftDelta::isSending(const CCallsign &callsign, const CAircraftParts &parts)
+    {
+        Sent &sent = m_sent[callsign];
+        if (!m_enabled)
+        {
+            this->count(sent, m_wireSizes.parts + this->keyBytes(callsign), true);
+            return true;
+        }
+
+        const double flapsRatio = parts.getFlapsPercent() / 100.0;
+        const int flags = partsFlags(parts);
+
+        const bool sending = this->isDue(sent.partsMs) || sent.partsFlags != flags ||
+                             std::abs(flapsRatio - sent.flapsRatio) > m_tolerances.ratio;
+        if (sending)
+        {
+            sent.partsMs = m_frameTimestamp;
+            sent.flapsRatio = flapsRatio;
+            sent.partsFlags = flags;
+        }
+        this->count(sent, m_wireSizes.parts + this->keyBytes(callsign), sending);
+        return sending;
+    }
+
+    bool CRemoteAircraftDelta::isSending(const CCallsign &callsign, const CTransponder &transponder)
+    {
+        Sent &sent = m_sent[callsign];
+        if (!m_enabled)
+        {
+            this->count(sent, m_wireSizes.transponder + this->keyBytes(callsign), true);
+            return true;
+        }
+
+        const int code = transponder.getTransponderCode();
+        const int mode = static_cast<int>(transponder.getTransponderMode());
+
+        const bool sending = this->isDue(sent.transponderMs) || sent.transponderCode != code || sent.transponderMode != mode;
+        if (sending)
+        {
+            sent.transponderMs = m_frameTimestamp;
+            sent.transponderCode = code;
+            sent.transponderMode = mode;
+        }
+        this->count(sent, m_wireSizes.transponder + this->keyBytes(callsign), sending);
+        return sending;
+    }
+
+    void CRemoteAircraftDelta::finishFrame()
+    {
+        m_updateAll = false;
+    }
+
+    QString CRemoteAircraftDelta::toQString() const
+    {
+        static const QString s("delta encoding: %1 tolerances: %2m alt: %3m angles: %4deg gs: %5kts ratios: %6 aircraft: %7");
+        return s.arg(boolToOnOff(m_enabled)).
+               arg(m_tolerances.positionM).arg(m_tolerances.altitudeM).arg(m_tolerances.angleDeg).
+               arg(m_tolerances.groundSpeedKts).arg(m_tolerances.ratio).arg(m_sent.size());
+    }
+
+    bool CRemoteAircraftDelta::isDue(qint64 sentMs) const
+    {
+        if (sentMs < 0) { return true; } // never sent
+        return m_updateAll && (m_frameTimestamp - sentMs) >= RefreshMs;
+    }
+
+    int CRemoteAircraftDelta::keyBytes(const CCallsign &callsign) const
+    {
+        return m_wireSizes.callsignKey ? CDBusUtils::dBusStringSize(callsign.asString()) : 0;
+    }
+
+    void CRemoteAircraftDelta::count(Sent &sent, int groupBytes, bool sending)
+    {
+        m_frameBytesFull += groupBytes;
+        if (sending) { m_frameBytesSent += groupBytes; }
+        if (m_wireSizes.record <= 0) { return; }
+
+        // the record is sent once per aircraft and frame, whatever group it contains
+        if (sent.recordFrame != m_frame)
+        {
+            sent.recordFrame = m_frame;
+            m_frameBytesFull += m_wireSizes.record;
+        }
+        if (sending && sent.recordSentFrame != m_frame)
+        {
+            sent.recordSentFrame = m_frame;
+            m_frameBytesSent += m_wireSizes.record;
+        }
+    }
+} // ns
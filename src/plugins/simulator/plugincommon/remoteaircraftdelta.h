@@ -0,0 +1,148 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSIMPLUGIN_COMMON_REMOTEAIRCRAFTDELTA_H
+#define BLACKSIMPLUGIN_COMMON_REMOTEAIRCRAFTDELTA_H
+
+#include "plugins/simulator/plugincommon/simulatorplugincommonexport.h"
+#include "blackmisc/aviation/callsign.h"
+#include <QHash>
+#include <QString>
+
+namespace BlackMisc::Aviation
+{
+    class CAircraftParts;
+    class CAircraftSituation;
+    class CTransponder;
+}
+
+namespace BlackSimPlugin::Common
+{
+    /*!
+     * Delta encoding of the per frame remote aircraft updates sent to a simulator.
+     *
+     * The values last sent are remembered per aircraft. A value group (situation, parts, transponder) is only sent again
+     * if at least one of its fields changed by more than the tolerance for that field.
+     * The group is the smallest unit, as the simulator interfaces (e.g. XSwiftBus) take all fields of a group in one call.
+     * While all remote aircraft are to be updated (ISimulator::isUpdateAllRemoteAircraft) every group is sent
+     * at least every CRemoteAircraftDelta::RefreshMs, not every frame.
+     */
+    class SIMULATORPLUGINCOMMON_EXPORT CRemoteAircraftDelta
+    {
+    public:
+        //! Change tolerances per field
+        struct Tolerances
+        {
+            double positionM      = 0.01;  //!< horizontal position, 1cm
+            double altitudeM      = 0.01;  //!< altitude, 1cm
+            double angleDeg       = 0.01;  //!< pitch, bank, heading
+            double groundSpeedKts = 0.1;   //!< ground speed
+            double ratio          = 0.01;  //!< ratios like flaps (0..1)
+        };
+
+        //! Bytes sent to the simulator, for the statistics
+        struct WireSizes
+        {
+            int situation   = 0; //!< per situation
+            int parts       = 0; //!< per parts
+            int transponder = 0; //!< per transponder
+            int record      = 0; //!< per aircraft with at least one group, for transports with a fixed size record per aircraft
+            bool callsignKey = false; //!< each group also carries the callsign as DBus string
+        };
+
+        //! Min. time between sending a group while all aircraft are updated
+        static constexpr qint64 RefreshMs = 1000;
+
+        //! Constructor
+        CRemoteAircraftDelta() = default;
+
+        //! \name Settings
+        //! @{
+        bool isEnabled() const { return m_enabled; }
+        void setEnabled(bool enabled) { m_enabled = enabled; this->reset(); }
+        const Tolerances &getTolerances() const { return m_tolerances; }
+        void setTolerances(const Tolerances &tolerances) { m_tolerances = tolerances; }
+        void setWireSizes(const WireSizes &sizes) { m_wireSizes = sizes; }
+        //! @}
+
+        //! Start a frame
+        void beginFrame(bool updateAll, qint64 currentTimestamp);
+
+        //! \name Send the group? If so it is remembered as sent
+        //! \remark call once per aircraft and frame
+        //! @{
+        bool isSending(const BlackMisc::Aviation::CAircraftSituation &situation);
+        bool isSending(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CAircraftParts &parts);
+        bool isSending(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CTransponder &transponder);
+        //! @}
+
+        //! Finish a frame
+        void finishFrame();
+
+        //! \name Bytes of the last frame
+        //! @{
+        qint64 getFrameBytesSent() const { return m_frameBytesSent; }
+        qint64 getFrameBytesSaved() const { return m_frameBytesFull - m_frameBytesSent; }
+        //! @}
+
+        //! Forget all values sent, so everything is sent with the next frame
+        void reset() { m_sent.clear(); }
+
+        //! Forget the values sent for one aircraft
+        void reset(const BlackMisc::Aviation::CCallsign &callsign) { m_sent.remove(callsign); }
+
+        //! Settings as string
+        QString toQString() const;
+
+    private:
+        //! Values last sent per aircraft
+        struct Sent
+        {
+            qint64 situationMs     = -1; //!< when the situation was sent, -1 never
+            qint64 partsMs         = -1; //!< when the parts were sent, -1 never
+            qint64 transponderMs   = -1; //!< when the transponder was sent, -1 never
+            double latitudeDeg     = 0;  //!< latitude
+            double longitudeDeg    = 0;  //!< longitude
+            double altitudeM       = 0;  //!< altitude
+            double pitchDeg        = 0;  //!< pitch
+            double bankDeg         = 0;  //!< bank
+            double headingDeg      = 0;  //!< heading
+            double groundSpeedKts  = 0;  //!< ground speed
+            int    onGround        = 0;  //!< CAircraftSituation::IsOnGround
+            double flapsRatio      = 0;  //!< flaps
+            int    partsFlags      = 0;  //!< gear, spoilers, engines, lights
+            int    transponderCode = 0;  //!< code
+            int    transponderMode = 0;  //!< CTransponder::TransponderMode
+            qint64 recordFrame     = -1; //!< frame in which the record was counted
+            qint64 recordSentFrame = -1; //!< frame in which the record was counted as sent
+        };
+
+        //! Send a group last sent at that time?
+        bool isDue(qint64 sentMs) const;
+
+        //! Bytes of a group and its record
+        void count(Sent &sent, int groupBytes, bool sending);
+
+        //! Bytes of the key of a group
+        int keyBytes(const BlackMisc::Aviation::CCallsign &callsign) const;
+
+        QHash<BlackMisc::Aviation::CCallsign, Sent> m_sent; //!< values last sent
+        Tolerances m_tolerances;                           //!< tolerances
+        WireSizes m_wireSizes;                             //!< bytes per group
+        bool m_enabled = true;                             //!< if disabled every group is sent every frame
+        bool m_updateAll = false;                          //!< current frame updates all aircraft
+        qint64 m_frameTimestamp = 0;                       //!< current frame
+        qint64 m_frame = 0;                                //!< current frame number
+        qint64 m_frameBytesSent = 0;                       //!< current or last frame
+        qint64 m_frameBytesFull = 0;                       //!< current or last frame without delta encoding
+    };
+} // ns
+
+#endif // guard
@@ -10,11 +10,13 @@
 #include "blackgui/components/interpolationlogdisplaydialog.h"
 #include "blackgui/guiapplication.h"
 #include "blackmisc/simplecommandparser.h"
+#include "blackmisc/logmessage.h"
 
 using namespace BlackGui;
 using namespace BlackGui::Components;
 using namespace BlackCore;
 using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Network;
 using namespace BlackMisc::Simulation;
 using namespace BlackMisc::Weather;
@@ -72,6 +74,27 @@ namespace BlackSimPlugin::Common
             this->showInterpolationDisplay();
             return true;
         }
+
+        // .driver delta on|off, .driver delta tolerance 0.05
+        if (parser.matchesPart(1, "delta") && parser.hasPart(2))
+        {
+            if (parser.matchesPart(2, "tolerance"))
+            {
+                if (!parser.isDouble(3)) { return false; }
+                const double positionM = parser.toDouble(3);
+                if (positionM < 0) { return false; }
+                CRemoteAircraftDelta::Tolerances tolerances = m_remoteAircraftDelta.getTolerances();
+                tolerances.positionM = positionM;
+                tolerances.altitudeM = positionM;
+                m_remoteAircraftDelta.setTolerances(tolerances);
+            }
+            else
+            {
+                m_remoteAircraftDelta.setEnabled(parser.toBool(2));
+            }
+            CLogMessage(this).info(m_remoteAircraftDelta.toQString());
+            return true;
+        }
         return false;
     }
 
@@ -87,9 +110,34 @@ namespace BlackSimPlugin::Common
         return ISimulator::disconnectFrom();
     }
 
+    void CSimulatorPluginCommon::resetLastSentValues()
+    {
+        ISimulator::resetLastSentValues();
+        m_remoteAircraftDelta.reset();
+    }
+
+    void CSimulatorPluginCommon::resetLastSentValues(const CCallsign &callsign)
+    {
+        ISimulator::resetLastSentValues(callsign);
+        m_remoteAircraftDelta.reset(callsign);
+    }
+
+    void CSimulatorPluginCommon::beginRemoteAircraftDelta(bool updateAll, qint64 currentTimestamp)
+    {
+        m_remoteAircraftDelta.beginFrame(updateAll, currentTimestamp);
+    }
+
+    void CSimulatorPluginCommon::finishRemoteAircraftDelta()
+    {
+        m_remoteAircraftDelta.finishFrame();
+        this->setStatisticsUpdateAircraftBytes(m_remoteAircraftDelta.getFrameBytesSent(), m_remoteAircraftDelta.getFrameBytesSaved());
+    }
+
     void CSimulatorPluginCommon::registerHelp()
     {
         if (CSimpleCommandParser::registered("BlackSimPlugin::Common::CSimulatorPluginCommon")) { return; }
         CSimpleCommandParser::registerCommand({".drv intdisplay", "interpolation display"});
+        CSimpleCommandParser::registerCommand({".drv delta on|off", "delta encoding of remote aircraft updates"});
+        CSimpleCommandParser::registerCommand({".drv delta tolerance m", "position tolerance of the delta encoding"});
     }
 } // namespace
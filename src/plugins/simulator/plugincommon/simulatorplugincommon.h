@@ -12,6 +12,7 @@
 #define BLACKSIMPLUGIN_COMMON_SIMULATORPLUGINCOMMON_H
 
 #include "plugins/simulator/plugincommon/simulatorplugincommonexport.h"
+#include "plugins/simulator/plugincommon/remoteaircraftdelta.h"
 #include "blackcore/simulator.h"
 #include <QObject>
 #include <QPointer>
@@ -34,6 +35,8 @@ namespace BlackSimPlugin::Common
         // --------- ISimulator implementations ------------
         virtual void unload() override;
         virtual bool disconnectFrom() override;
+        virtual void resetLastSentValues() override;
+        virtual void resetLastSentValues(const BlackMisc::Aviation::CCallsign &callsign) override;
 
     protected:
         //! Constructor
@@ -48,6 +51,8 @@ namespace BlackSimPlugin::Common
         //! @{
         //! <pre>
         //! .drv intdisplay interpolation log display
+        //! .drv delta on|off           delta encoding of remote aircraft updates
+        //! .drv delta tolerance m      position tolerance of the delta encoding
         //! </pre>
         //! @}
         virtual bool parseDetails(const BlackMisc::CSimpleCommandParser &parser) override;
@@ -55,6 +60,19 @@ namespace BlackSimPlugin::Common
         //! Register help
         static void registerHelp();
 
+        //! \name Delta encoding of the remote aircraft updates
+        //! \remark begin and finish a frame before ISimulator::finishUpdateRemoteAircraftAndSetStatistics
+        //! @{
+        void beginRemoteAircraftDelta(bool updateAll, qint64 currentTimestamp);
+        bool isSendingRemoteAircraftDelta(const BlackMisc::Aviation::CAircraftSituation &situation) { return m_remoteAircraftDelta.isSending(situation); }
+        bool isSendingRemoteAircraftDelta(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CAircraftParts &parts) { return m_remoteAircraftDelta.isSending(callsign, parts); }
+        bool isSendingRemoteAircraftDelta(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CTransponder &transponder) { return m_remoteAircraftDelta.isSending(callsign, transponder); }
+        void finishRemoteAircraftDelta();
+        //! @}
+
+        //! Bytes per group sent by the driver
+        void setRemoteAircraftDeltaWireSizes(const CRemoteAircraftDelta::WireSizes &sizes) { m_remoteAircraftDelta.setWireSizes(sizes); }
+
     private:
         //! Show the interpolator display
         void showInterpolationDisplay();
@@ -63,6 +81,7 @@ namespace BlackSimPlugin::Common
         void deleteInterpolationDisplay();
 
         QPointer<BlackGui::Components::CInterpolationLogDisplayDialog> m_interpolationDisplayDialog; //!< can be owned by main window after setting a parent
+        CRemoteAircraftDelta m_remoteAircraftDelta; //!< values sent to the simulator
     };
 } // namespace
 
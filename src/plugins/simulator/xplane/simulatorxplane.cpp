@@ -51,8 +51,11 @@
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/dbusserver.h"
 #include "blackmisc/iterator.h"
+#include "blackmisc/logcategories.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/setbuilder.h"
+#include "blackmisc/simplecommandparser.h"
+#include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
 #include "dbus/dbus.h"
@@ -118,6 +121,9 @@ namespace BlackSimPlugin::XPlane
         m_slowTimer.start(1000);
         m_airportUpdater.start(60 * 1000);
         m_pendingAddedTimer.start(5000);
+        CSimulatorXPlane::registerHelp();
+
+        this->updateRemoteAircraftDeltaWireSizes();
 
         this->setDefaultModel({ "Jets A320_a A320_a_Austrian_Airlines A320_a_Austrian_Airlines", CAircraftModel::TypeModelMatchingDefaultModel,
                                 "A320 AUA", CAircraftIcaoCode("A320", "L2J")});
@@ -141,7 +147,7 @@ namespace BlackSimPlugin::XPlane
 
     QString CSimulatorXPlane::getStatisticsSimulatorSpecific() const
     {
-        return QStringLiteral("Add-time: %1ms/%2ms").arg(m_statsAddCurrentTimeMs).arg(m_statsAddMaxTimeMs);
+        return QStringLiteral("Add-time: %1ms/%2ms traffic: %3").arg(m_statsAddCurrentTimeMs).arg(m_statsAddMaxTimeMs).arg(m_sharedTraffic.isOpen() ? QStringLiteral("shared memory") : QStringLiteral("DBus"));
     }
 
     void CSimulatorXPlane::resetAircraftStatistics()
@@ -161,13 +167,15 @@ namespace BlackSimPlugin::XPlane
     {
         if (this->isShuttingDownOrDisconnected()) { return false; }
         if (!m_trafficProxy) { return false; }
-        if (!m_xplaneAircraftObjects.contains(callsign)) { return false; }
+        const auto it = m_xplaneAircraftObjects.constFind(callsign);
+        if (it == m_xplaneAircraftObjects.constEnd()) { return false; }
+        const int handle = it->getHandle();
 
         int u = 0;
         if (!situation.isNull())
         {
             PlanesPositions planesPositions;
-            planesPositions.push_back(situation);
+            planesPositions.push_back(handle, situation);
             m_trafficProxy->setPlanesPositions(planesPositions);
             u++;
         }
@@ -175,7 +183,7 @@ namespace BlackSimPlugin::XPlane
         if (!parts.isNull())
         {
             PlanesSurfaces surfaces;
-            surfaces.push_back(callsign, parts);
+            surfaces.push_back(handle, parts);
             m_trafficProxy->setPlanesSurfaces(surfaces);
             u++;
         }
@@ -539,6 +547,8 @@ namespace BlackSimPlugin::XPlane
         connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAddingFailed, this, &CSimulatorXPlane::onRemoteAircraftAddingFailed);
         if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
         m_trafficProxy->removeAllPlanes();
+        m_planeHandles.releaseAll();
+        this->openSharedTraffic();
 
         // send the settings
         this->sendXSwiftBusSettings();
@@ -578,6 +588,7 @@ namespace BlackSimPlugin::XPlane
 
         if (m_dbusMode == P2P) { m_dBusConnection.disconnectFromPeer(m_dBusConnection.name()); }
         m_dBusConnection = QDBusConnection { "default" };
+        m_sharedTraffic.close();
         if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
         delete m_serviceProxy;
         delete m_trafficProxy;
@@ -823,6 +834,13 @@ namespace BlackSimPlugin::XPlane
         if (this->canAddAircraft())
         {
             // no aircraft pending, add
+            const int handle = m_planeHandles.assign(newRemoteAircraft.getCallsign());
+            if (handle < 0)
+            {
+                CLogMessage(this).warning(u"No plane handle left for '%1', will not add") << newRemoteAircraft.getCallsign();
+                return false;
+            }
+
             this->logAddingAircraftModel(newRemoteAircraft);
             const qint64 now = QDateTime::currentMSecsSinceEpoch();
             m_addingInProgressAircraft.insert(newRemoteAircraft.getCallsign(), now);
@@ -839,16 +857,16 @@ namespace BlackSimPlugin::XPlane
             }
 
             const QString livery = aircraftModel.getLivery().getCombinedCode(); //! \todo livery resolution for XP
-            m_trafficProxy->addPlane(callsign, aircraftModel.getModelString(),
+            m_trafficProxy->addPlane(handle, callsign, aircraftModel.getModelString(),
                                         newRemoteAircraft.getAircraftIcaoCode().getDesignator(),
                                         newRemoteAircraft.getAirlineIcaoCode().getDesignator(),
                                         livery);
             PlanesPositions pos;
-            pos.push_back(newRemoteAircraft.getSituation());
+            pos.push_back(handle, newRemoteAircraft.getSituation());
             m_trafficProxy->setPlanesPositions(pos);
 
             PlanesSurfaces surfaces;
-            surfaces.push_back(newRemoteAircraft.getCallsign(), newRemoteAircraft.getParts());
+            surfaces.push_back(handle, newRemoteAircraft.getParts());
             m_trafficProxy->setPlanesSurfaces(surfaces);
         }
         else
@@ -910,6 +928,7 @@ namespace BlackSimPlugin::XPlane
 
         m_trafficProxy->removePlane(callsign.asString());
         m_xplaneAircraftObjects.remove(callsign);
+        m_planeHandles.release(callsign);
         m_pendingToBeAddedAircraft.removeByCallsign(callsign);
 
         // bye
@@ -930,6 +949,27 @@ namespace BlackSimPlugin::XPlane
         return this->getAircraftInRange().findByRendered(true).getCallsigns(); // just a poor workaround
     }
 
+    bool CSimulatorXPlane::parseDetails(const CSimpleCommandParser &parser)
+    {
+        // .driver shm on|off
+        if (parser.matchesPart(1, "shm") && parser.hasPart(2))
+        {
+            m_useSharedTraffic = parser.toBool(2);
+            if (m_useSharedTraffic) { this->openSharedTraffic(); }
+            else { this->closeSharedTraffic(); }
+            CLogMessage(this, CLogCategories::cmdLine()).info(u"Traffic via shared memory is '%1'") << boolToOnOff(m_sharedTraffic.isOpen());
+            return true;
+        }
+        return CSimulatorPluginCommon::parseDetails(parser);
+    }
+
+    void CSimulatorXPlane::registerHelp()
+    {
+        if (CSimpleCommandParser::registered("BlackSimPlugin::XPlane::CSimulatorXPlane")) { return; }
+        CSimpleCommandParser::registerCommand({".drv", "alias: .driver .plugin"});
+        CSimpleCommandParser::registerCommand({".drv shm on|off", "traffic via shared memory (Linux) or DBus"});
+    }
+
     bool CSimulatorXPlane::followAircraft(const CCallsign &callsign)
     {
         if (! m_trafficProxy || ! m_trafficProxy->isValid()) { return false; }
@@ -1059,9 +1099,21 @@ namespace BlackSimPlugin::XPlane
         PlanesSurfaces planesSurfaces;
         PlanesTransponders planesTransponders;
 
-        int aircraftNumber = 0;
+        // via shared memory all planes with a handle, via DBus the others
+        const bool sharedTraffic = m_sharedTraffic.isOpen();
+        if (sharedTraffic)
+        {
+            if (m_sharedTraffic.takeResyncRequest()) { this->resetLastSentValues(); }
+            m_sharedTraffic.beginFrame();
+        }
+
+        // aircraft no longer in range are removed from m_xplaneAircraftObjects by physicallyRemoveRemoteAircraft,
+        // so no per frame check against the callsigns in range
         const bool updateAllAircraft = this->isUpdateAllRemoteAircraft(currentTimestamp);
-        const CCallsignSet callsignsInRange = this->getAircraftInRangeCallsigns();
+        this->beginRemoteAircraftDelta(updateAllAircraft, currentTimestamp);
+        QVector<const CXPlaneMPAircraft *> aircraftToInterpolate;
+        QVector<CInterpolatorMulti *> interpolators;
+        QVector<CInterpolationAndRenderingSetupPerCallsign> setups;
         for (const CXPlaneMPAircraft &xplaneAircraft : std::as_const(m_xplaneAircraftObjects))
         {
             const CCallsign callsign(xplaneAircraft.getCallsign());
@@ -1073,20 +1125,28 @@ namespace BlackSimPlugin::XPlane
                 continue;
             }
 
-            // skip no longer in range
-            if (!callsignsInRange.contains(callsign)) { continue; }
-
-            planesTransponders.callsigns.push_back(callsign.asString());
-            planesTransponders.codes.push_back(xplaneAircraft.getAircraft().getTransponderCode());
-            CTransponder::TransponderMode transponderMode = xplaneAircraft.getAircraft().getTransponderMode();
-            planesTransponders.idents.push_back(transponderMode == CTransponder::StateIdent);
-            planesTransponders.modeCs.push_back(transponderMode == CTransponder::ModeC);
-
             // setup
-            const CInterpolationAndRenderingSetupPerCallsign setup = this->getInterpolationSetupConsolidated(callsign, updateAllAircraft);
+            aircraftToInterpolate.push_back(&xplaneAircraft);
+            interpolators.push_back(xplaneAircraft.getInterpolator());
+            setups.push_back(this->getInterpolationSetupConsolidated(callsign, updateAllAircraft));
+        }
+
+        // interpolated situations/parts, all aircraft in one call
+        const QVector<CInterpolationResult> results = this->interpolateRemoteAircraft(interpolators, setups, currentTimestamp);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const CXPlaneMPAircraft &xplaneAircraft = *aircraftToInterpolate[i];
+            const CCallsign callsign(xplaneAircraft.getCallsign());
+            const CInterpolationResult &result = results[i];
+            const int handle = xplaneAircraft.getHandle();
+            CXSwiftBusSharedTraffic::PlaneRecord *record = sharedTraffic ? m_sharedTraffic.addRecord(handle) : nullptr;
+            const CTransponder transponder = xplaneAircraft.getAircraft().getTransponder();
+            if (this->isSendingRemoteAircraftDelta(callsign, transponder))
+            {
+                if (record) { CXSwiftBusSharedTraffic::setTransponder(*record, transponder); }
+                else { planesTransponders.push_back(handle, transponder); }
+            }
 
-            // interpolated situation/parts
-            const CInterpolationResult result = xplaneAircraft.getInterpolation(currentTimestamp, setup, aircraftNumber++);
             if (result.getInterpolationStatus().hasValidSituation())
             {
                 CAircraftSituation interpolatedSituation(result);
@@ -1098,10 +1158,11 @@ namespace BlackSimPlugin::XPlane
                 interpolatedSituation.setAltitude({ alt, interpolatedSituation.getAltitude().getReferenceDatum() });
 
                 // update situation
-                if (updateAllAircraft || !this->isEqualLastSent(interpolatedSituation))
+                if (this->isSendingRemoteAircraftDelta(interpolatedSituation))
                 {
                     this->rememberLastSent(interpolatedSituation);
-                    planesPositions.push_back(interpolatedSituation);
+                    if (record) { CXSwiftBusSharedTraffic::setPosition(*record, interpolatedSituation); }
+                    else { planesPositions.push_back(handle, interpolatedSituation); }
                 }
             }
             else
@@ -1112,15 +1173,18 @@ namespace BlackSimPlugin::XPlane
             const CAircraftParts parts(result);
             if (result.getPartsStatus().isSupportingParts() || parts.getPartsDetails() == CAircraftParts::GuessedParts)
             {
-                if (updateAllAircraft || !this->isEqualLastSent(parts, callsign))
+                if (this->isSendingRemoteAircraftDelta(callsign, parts))
                 {
                     this->rememberLastSent(parts, callsign);
-                    planesSurfaces.push_back(xplaneAircraft.getCallsign(), parts);
+                    if (record) { CXSwiftBusSharedTraffic::setSurfaces(*record, parts); }
+                    else { planesSurfaces.push_back(handle, parts); }
                 }
             }
 
         } // all callsigns
 
+        if (sharedTraffic) { m_sharedTraffic.publishFrame(); }
+
         if (!planesTransponders.isEmpty())
         {
             m_trafficProxy->setPlanesTransponders(planesTransponders);
@@ -1141,6 +1205,7 @@ namespace BlackSimPlugin::XPlane
         }
 
         // stats
+        this->finishRemoteAircraftDelta();
         this->finishUpdateRemoteAircraftAndSetStatistics(currentTimestamp);
     }
 
@@ -1161,12 +1226,19 @@ namespace BlackSimPlugin::XPlane
     {
         if (callsigns.isEmpty()) { return; }
         if (!m_trafficProxy || this->isShuttingDown()) { return; }
-        const QStringList csStrings = callsigns.getCallsignStrings();
+        QList<int> requestedHandles;
+        for (const CCallsign &callsign : callsigns)
+        {
+            const int handle = m_planeHandles.getHandle(callsign);
+            if (handle >= 0) { requestedHandles.push_back(handle); }
+        }
+        if (requestedHandles.isEmpty()) { return; }
+
         QPointer<CSimulatorXPlane> myself(this);
-        m_trafficProxy->getRemoteAircraftData(csStrings, [ = ](const QStringList & callsigns, const QDoubleList & latitudesDeg, const QDoubleList & longitudesDeg, const QDoubleList & elevationsMeters, const QBoolList & waterFlags, const QDoubleList & verticalOffsetsMeters)
+        m_trafficProxy->getRemoteAircraftData(requestedHandles, [ = ](const QList<int> & handles, const QDoubleList & latitudesDeg, const QDoubleList & longitudesDeg, const QDoubleList & elevationsMeters, const QBoolList & waterFlags, const QDoubleList & verticalOffsetsMeters)
         {
             if (!myself) { return; }
-            this->updateRemoteAircraftFromSimulator(callsigns, latitudesDeg, longitudesDeg, elevationsMeters, waterFlags, verticalOffsetsMeters);
+            this->updateRemoteAircraftFromSimulator(handles, latitudesDeg, longitudesDeg, elevationsMeters, waterFlags, verticalOffsetsMeters);
         });
     }
 
@@ -1182,10 +1254,10 @@ namespace BlackSimPlugin::XPlane
     }
 
     void CSimulatorXPlane::updateRemoteAircraftFromSimulator(
-        const QStringList &callsigns,        const QDoubleList &latitudesDeg, const QDoubleList &longitudesDeg,
+        const QList<int> &handles,           const QDoubleList &latitudesDeg, const QDoubleList &longitudesDeg,
         const QDoubleList &elevationsMeters, const QBoolList &waterFlags,     const QDoubleList &verticalOffsetsMeters)
     {
-        const int size = callsigns.size();
+        const int size = handles.size();
 
         // we skip if we are not near ground
         if (CBuildConfig::isLocalDeveloperDebugBuild())
@@ -1201,13 +1273,13 @@ namespace BlackSimPlugin::XPlane
         static const QString hint("remote acft.");
         for (int i = 0; i < size; i++)
         {
-            const bool emptyCs = callsigns[i].isEmpty();
-            BLACK_VERIFY_X(!emptyCs, Q_FUNC_INFO, "Need callsign");
-            if (emptyCs) { continue; }
+            // plane removed in the meantime
+            const CCallsign cs = m_planeHandles.getCallsign(handles[i]);
+            if (cs.isEmpty()) { continue; }
 
-            const CCallsign cs(callsigns[i]);
-            if (!m_xplaneAircraftObjects.contains(cs)) { continue; }
-            const CXPlaneMPAircraft xpAircraft = m_xplaneAircraftObjects[cs];
+            const auto it = m_xplaneAircraftObjects.constFind(cs);
+            if (it == m_xplaneAircraftObjects.constEnd()) { continue; }
+            const CXPlaneMPAircraft xpAircraft = it.value();
             BLACK_VERIFY_X(xpAircraft.hasCallsign(), Q_FUNC_INFO, "Need callsign");
             if (!xpAircraft.hasCallsign()) { continue; }
 
@@ -1254,14 +1326,65 @@ namespace BlackSimPlugin::XPlane
     {
         if (m_dBusConnection.isConnected())
         {
+            this->closeSharedTraffic();
             if (m_trafficProxy) { m_trafficProxy->cleanup(); }
 
             if (m_dbusMode == P2P) { QDBusConnection::disconnectFromPeer(m_dBusConnection.name()); }
             else { QDBusConnection::disconnectFromBus(m_dBusConnection.name()); }
         }
+        m_sharedTraffic.close();
+        this->updateRemoteAircraftDeltaWireSizes();
         m_dBusConnection = QDBusConnection { "default" };
     }
 
+    bool CSimulatorXPlane::openSharedTraffic()
+    {
+        if (!m_useSharedTraffic || !CXSwiftBusSharedTraffic::isSupported()) { return false; }
+        if (!m_trafficProxy || !m_trafficProxy->isValid()) { return false; }
+        if (m_sharedTraffic.isOpen()) { return true; }
+
+        if (!m_sharedTraffic.create())
+        {
+            CLogMessage(this).warning(u"Cannot create shared memory for traffic, using DBus");
+            return false;
+        }
+
+        // fails with an older XSwiftBus or if XSwiftBus runs on another machine
+        if (!m_trafficProxy->openSharedTraffic(m_sharedTraffic.getName()))
+        {
+            m_sharedTraffic.close();
+            CLogMessage(this).info(u"XSwiftBus cannot read traffic from shared memory, using DBus");
+            return false;
+        }
+
+        // everything is sent again via shared memory
+        this->updateRemoteAircraftDeltaWireSizes();
+        this->resetLastSentValues();
+        CLogMessage(this).info(u"Sending traffic via shared memory '%1'") << m_sharedTraffic.getName();
+        return true;
+    }
+
+    void CSimulatorXPlane::closeSharedTraffic()
+    {
+        if (!m_sharedTraffic.isOpen()) { return; }
+        if (m_trafficProxy) { m_trafficProxy->closeSharedTraffic(); }
+        m_sharedTraffic.close();
+        this->updateRemoteAircraftDeltaWireSizes();
+    }
+
+    void CSimulatorXPlane::updateRemoteAircraftDeltaWireSizes()
+    {
+        if (m_sharedTraffic.isOpen())
+        {
+            // one record per plane and frame, whatever it contains
+            this->setRemoteAircraftDeltaWireSizes({ 0, 0, 0, static_cast<int>(sizeof(CXSwiftBusSharedTraffic::PlaneRecord)) });
+        }
+        else
+        {
+            this->setRemoteAircraftDeltaWireSizes({ PlanesPositions::dBusSizePerPlane(), PlanesSurfaces::dBusSizePerPlane(), PlanesTransponders::dBusSizePerPlane() });
+        }
+    }
+
     bool CSimulatorXPlane::sendXSwiftBusSettings()
     {
         if (this->isShuttingDownOrDisconnected()) { return false; }
@@ -1337,6 +1460,15 @@ namespace BlackSimPlugin::XPlane
             m_addingInProgressAircraft.remove(cs);
         }
 
+        // removed while adding was in progress, the handle is released
+        const int handle = m_planeHandles.getHandle(cs);
+        if (handle < 0)
+        {
+            CLogMessage(this).warning(u"Aircraft '%1' was removed while being added, dropping it") << callsign;
+            m_trafficProxy->removePlane(callsign);
+            return;
+        }
+
         if (!addedRemoteAircraft.hasCallsign())
         {
             CLogMessage(this).warning(u"Aircraft '%1' no longer in range, will be removed") << callsign;
@@ -1360,7 +1492,7 @@ namespace BlackSimPlugin::XPlane
 
         Q_ASSERT_X(addedRemoteAircraft.hasCallsign(), Q_FUNC_INFO, "No callsign"); // already checked above, MUST never happen
         Q_ASSERT_X(addedRemoteAircraft.getCallsign() == cs, Q_FUNC_INFO, "No callsign"); // already checked above, MUST never happen
-        m_xplaneAircraftObjects.insert(cs, CXPlaneMPAircraft(addedRemoteAircraft, this, &m_interpolationLogger));
+        m_xplaneAircraftObjects.insert(cs, CXPlaneMPAircraft(addedRemoteAircraft, handle, this, &m_interpolationLogger));
         emit this->aircraftRenderingChanged(addedRemoteAircraft);
     }
 
@@ -1383,6 +1515,7 @@ namespace BlackSimPlugin::XPlane
 
         const bool wasPending = (m_addingInProgressAircraft.remove(cs) > 0);
         Q_UNUSED(wasPending)
+        m_planeHandles.release(cs); // a new one when trying again
 
         if (failedRemoteAircraft.hasCallsign() && !m_aircraftAddedFailed.containsCallsign(cs))
         {
@@ -1577,7 +1710,15 @@ namespace BlackSimPlugin::XPlane
         }
         else if (commitHash() != xswiftbusCommitHash)
         {
-            CLogMessage(this).error(u"You are using an incorrect version of XSwiftBus. The version of XSwiftBus (%1) should match the version of swift (%2). Consider upgrading!") << xswiftbusVersion << swiftVersion;
+            CLogMessage(this).warning(u"You are using another version of XSwiftBus. The version of XSwiftBus (%1) should match the version of swift (%2). Consider upgrading!") << xswiftbusVersion << swiftVersion;
+        }
+
+        // only an incompatible traffic interface cannot be used, e.g. older versions keyed by callsign instead of plane handles
+        const int protocolVersion = traffic.getProtocolVersion();
+        if (protocolVersion != CXSwiftBusTrafficProxy::ProtocolVersion)
+        {
+            CLogMessage(this).error(u"The traffic protocol of XSwiftBus (%1) is not compatible with swift (%2), not connecting. Please upgrade XSwiftBus!") << protocolVersion << CXSwiftBusTrafficProxy::ProtocolVersion;
+            return;
         }
 
         if (!traffic.initialize())
@@ -12,6 +12,7 @@
 #define BLACKSIMPLUGIN_SIMULATOR_XPLANE_H
 
 #include "xplanempaircraft.h"
+#include "xswiftbussharedtraffic.h"
 #include "plugins/simulator/xplaneconfig/simulatorxplaneconfig.h"
 #include "plugins/simulator/plugincommon/simulatorplugincommon.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
@@ -156,6 +157,12 @@ namespace BlackSimPlugin::XPlane
         virtual void setFlightNetworkConnected(bool connected) override;
         //! @}
 
+        //! \copydoc Common::CSimulatorPluginCommon::parseDetails
+        virtual bool parseDetails(const BlackMisc::CSimpleCommandParser &parser) override;
+
+        //! Register help
+        static void registerHelp();
+
         //! \copydoc BlackMisc::Simulation::ISimulationEnvironmentProvider::requestElevation
         virtual bool requestElevation(const BlackMisc::Geo::ICoordinateGeodetic &reference, const BlackMisc::Aviation::CCallsign &callsign) override;
 
@@ -234,13 +241,22 @@ namespace BlackSimPlugin::XPlane
         //! @{
         void onRemoteAircraftAdded(const QString &callsign);
         void onRemoteAircraftAddingFailed(const QString &callsign);
-        void updateRemoteAircraftFromSimulator(const QStringList &callsigns, const QDoubleList &latitudesDeg, const QDoubleList &longitudesDeg,
+        void updateRemoteAircraftFromSimulator(const QList<int> &handles, const QDoubleList &latitudesDeg, const QDoubleList &longitudesDeg,
                                                 const QDoubleList &elevationsMeters, const QBoolList &waterFlags, const QDoubleList &verticalOffsetsMeters);
         //! @}
 
         //! Disconnect from DBus
         void disconnectFromDBus();
 
+        //! Shared memory traffic with XSwiftBus
+        //! @{
+        bool openSharedTraffic();
+        void closeSharedTraffic();
+        //! @}
+
+        //! Bytes sent per plane with the current traffic transport, for the statistics
+        void updateRemoteAircraftDeltaWireSizes();
+
         //! Send/receive settings
         //! @{
         bool sendXSwiftBusSettings();
@@ -278,6 +294,9 @@ namespace BlackSimPlugin::XPlane
 
         BlackMisc::Aviation::CAirportList m_airportsInRange; //!< aiports in range of own aircraft
         CXPlaneMPAircraftObjects m_xplaneAircraftObjects;    //!< XPlane multiplayer aircraft
+        CXPlaneMPAircraftHandles m_planeHandles;             //!< handles of the planes in XSwiftBus, assigned when adding
+        CXSwiftBusSharedTraffic m_sharedTraffic;             //!< traffic via shared memory, if supported
+        bool m_useSharedTraffic = CXSwiftBusSharedTraffic::isSupported(); //!< use shared memory if XSwiftBus can open it
 
         BlackMisc::Simulation::CSimulatedAircraftList m_pendingToBeAddedAircraft;      //!< aircraft to be added
         QHash<BlackMisc::Aviation::CCallsign, qint64> m_addingInProgressAircraft;      //!< aircraft just adding
@@ -12,6 +12,8 @@ DEPENDPATH += . $$SourceRoot/src
 INCLUDEPATH += . $$SourceRoot/src
 
 unix:!macx {
+    # shm_open for the shared memory traffic
+    LIBS += -lrt
     INCLUDEPATH *= /usr/include/dbus-1.0
     exists (/usr/lib/x86_64-linux-gnu){
     INCLUDEPATH *= /usr/lib/x86_64-linux-gnu/dbus-1.0/include
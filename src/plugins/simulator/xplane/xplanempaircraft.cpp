@@ -9,11 +9,13 @@
 #include "xplanempaircraft.h"
 #include "blackcore/simulator.h"
 #include "blackmisc/simulation/interpolatormulti.h"
+#include "blackmisc/simulation/xplane/planehandleqtfree.h"
 
 using namespace BlackCore;
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::XPlane;
 
 namespace BlackSimPlugin::XPlane
 {
@@ -21,8 +23,8 @@ namespace BlackSimPlugin::XPlane
     { }
 
     CXPlaneMPAircraft::CXPlaneMPAircraft(
-        const CSimulatedAircraft &aircraft, ISimulator *simulator, CInterpolationLogger *logger) :
-        m_aircraft(aircraft),
+        const CSimulatedAircraft &aircraft, int handle, ISimulator *simulator, CInterpolationLogger *logger) :
+        m_aircraft(aircraft), m_handle(handle),
         m_interpolator(QSharedPointer<CInterpolatorMulti>::create(aircraft.getCallsign(), simulator, simulator, simulator->getRemoteAircraftProvider(), logger))
     {
         m_interpolator->attachLogger(logger);
@@ -66,4 +68,60 @@ namespace BlackSimPlugin::XPlane
     {
         return this->getAllCallsigns().getCallsignStrings(sorted);
     }
+
+    int CXPlaneMPAircraftHandles::assign(const CCallsign &callsign)
+    {
+        const auto it = m_handles.constFind(callsign);
+        if (it != m_handles.constEnd()) { return it.value(); }
+
+        int slot = -1;
+        if (!m_freeSlots.isEmpty())
+        {
+            slot = m_freeSlots.takeLast();
+        }
+        else if (m_slotHandles.size() < PlaneHandle::MaxSlots)
+        {
+            slot = m_slotHandles.size();
+            m_slotHandles.push_back(PlaneHandle::makeHandle(slot, 0));
+            m_callsigns.push_back({});
+        }
+        if (slot < 0) { return -1; }
+
+        const int handle = PlaneHandle::makeHandle(slot, PlaneHandle::generationOf(m_slotHandles[slot]) + 1);
+        m_slotHandles[slot] = handle;
+        m_callsigns[slot] = callsign;
+        m_handles.insert(callsign, handle);
+        return handle;
+    }
+
+    void CXPlaneMPAircraftHandles::release(const CCallsign &callsign)
+    {
+        const auto it = m_handles.find(callsign);
+        if (it == m_handles.end()) { return; }
+        const int slot = PlaneHandle::slotOf(it.value());
+        m_callsigns[slot] = {};
+        m_freeSlots.push_back(slot);
+        m_handles.erase(it);
+    }
+
+    void CXPlaneMPAircraftHandles::releaseAll()
+    {
+        // keep the generations, so handles from before are still stale
+        m_handles.clear();
+        m_freeSlots.clear();
+        for (int slot = m_slotHandles.size() - 1; slot >= 0; --slot)
+        {
+            m_callsigns[slot] = {};
+            m_freeSlots.push_back(slot);
+        }
+    }
+
+    const CCallsign &CXPlaneMPAircraftHandles::getCallsign(int handle) const
+    {
+        static const CCallsign empty;
+        if (!PlaneHandle::isValid(handle)) { return empty; }
+        const int slot = PlaneHandle::slotOf(handle);
+        if (slot >= m_slotHandles.size() || m_slotHandles[slot] != handle) { return empty; }
+        return m_callsigns[slot];
+    }
 } // namespace
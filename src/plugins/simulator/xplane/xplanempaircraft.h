@@ -13,8 +13,10 @@
 
 #include "blackmisc/simulation/simulatedaircraft.h"
 #include "blackmisc/simulation/interpolatormulti.h"
+#include <QHash>
 #include <QSharedPointer>
 #include <QStringList>
+#include <QVector>
 
 namespace BlackCore { class ISimulator; }
 namespace BlackSimPlugin::XPlane
@@ -27,7 +29,7 @@ namespace BlackSimPlugin::XPlane
         CXPlaneMPAircraft();
 
         //! Constructor providing initial situation/parts
-        CXPlaneMPAircraft(const BlackMisc::Simulation::CSimulatedAircraft &aircraft,
+        CXPlaneMPAircraft(const BlackMisc::Simulation::CSimulatedAircraft &aircraft, int handle,
                             BlackCore::ISimulator *simulator,
                             BlackMisc::Simulation::CInterpolationLogger *logger);
 
@@ -43,6 +45,9 @@ namespace BlackSimPlugin::XPlane
         //! Has callsign
         bool hasCallsign() const { return m_aircraft.hasCallsign(); }
 
+        //! Handle of the plane in XSwiftBus
+        int getHandle() const { return m_handle; }
+
         //! Simulated aircraft (as added)
         const BlackMisc::Simulation::CSimulatedAircraft &getAircraft() const { return m_aircraft; }
 
@@ -69,6 +74,7 @@ namespace BlackSimPlugin::XPlane
 
     private:
         BlackMisc::Simulation::CSimulatedAircraft m_aircraft; //!< corresponding aircraft
+        int m_handle = -1; //!< handle in XSwiftBus
         QSharedPointer<BlackMisc::Simulation::CInterpolatorMulti> m_interpolator; //!< shared pointer because CSimConnectObject can be copied
     };
 
@@ -91,6 +97,40 @@ namespace BlackSimPlugin::XPlane
         //! Toggle interpolator modes
         void toggleInterpolatorMode(const BlackMisc::Aviation::CCallsign &callsign);
     };
+
+    /*!
+     * Integer handles of the planes in XSwiftBus, all per frame traffic is keyed by handle instead of callsign.
+     * A handle is assigned before the plane is added and released when it is removed,
+     * see BlackMisc::Simulation::XPlane::PlaneHandle for the layout.
+     */
+    class CXPlaneMPAircraftHandles
+    {
+    public:
+        //! Assign a handle, the existing one if the plane already has one
+        //! \remark -1 if all slots are in use
+        int assign(const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Release the handle of a plane
+        void release(const BlackMisc::Aviation::CCallsign &callsign);
+
+        //! Release all handles
+        void releaseAll();
+
+        //! Handle of a plane, -1 if none
+        int getHandle(const BlackMisc::Aviation::CCallsign &callsign) const { return m_handles.value(callsign, -1); }
+
+        //! Plane of a handle, empty callsign if the handle has been released
+        const BlackMisc::Aviation::CCallsign &getCallsign(int handle) const;
+
+        //! Number of assigned handles
+        int size() const { return m_handles.size(); }
+
+    private:
+        QHash<BlackMisc::Aviation::CCallsign, int> m_handles; //!< handle per plane
+        QVector<BlackMisc::Aviation::CCallsign> m_callsigns;  //!< plane per slot, empty if free
+        QVector<int> m_slotHandles;                           //!< latest handle per slot, its generation is incremented when reused
+        QVector<int> m_freeSlots;                             //!< released slots
+    };
 } // namespace
 
 #endif // guard
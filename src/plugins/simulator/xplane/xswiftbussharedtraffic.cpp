@@ -0,0 +1,103 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "xswiftbussharedtraffic.h"
+#include "xswiftbustrafficproxy.h"
+
+#include <QCoreApplication>
+#include <QRandomGenerator>
+#include <cstring>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation::XPlane::SharedTraffic;
+
+namespace BlackSimPlugin::XPlane
+{
+    bool CXSwiftBusSharedTraffic::create()
+    {
+        // unique, so a XSwiftBus on another machine (P2P DBus) cannot open an unrelated ring
+        const QString name = QStringLiteral("/swift_xswiftbus_traffic_%1_%2").arg(QCoreApplication::applicationPid()).arg(QRandomGenerator::global()->generate(), 8, 16, QChar('0'));
+        m_frame = nullptr;
+        m_frameCount = 0;
+        return m_ring.create(name.toStdString());
+    }
+
+    void CXSwiftBusSharedTraffic::close()
+    {
+        m_ring.close();
+        m_frame = nullptr;
+        m_frameCount = 0;
+    }
+
+    void CXSwiftBusSharedTraffic::beginFrame()
+    {
+        m_frame = m_ring.beginFrame();
+        m_frameCount = 0;
+    }
+
+    CXSwiftBusSharedTraffic::PlaneRecord *CXSwiftBusSharedTraffic::addRecord(int handle)
+    {
+        if (!m_frame || m_frameCount >= MaxPlanes || handle < 0) { return nullptr; }
+        PlaneRecord &record = m_frame[m_frameCount++];
+        std::memset(static_cast<void *>(&record), 0, sizeof(record));
+        record.handle = handle;
+        return &record;
+    }
+
+    void CXSwiftBusSharedTraffic::publishFrame()
+    {
+        if (!m_frame) { return; }
+        m_ring.publishFrame(m_frameCount);
+        m_frame = nullptr;
+        m_frameCount = 0;
+    }
+
+    void CXSwiftBusSharedTraffic::setPosition(PlaneRecord &record, const CAircraftSituation &situation)
+    {
+        const PlanePosition position = PlanePosition::fromSituation(situation);
+        record.latitudeDeg = position.latitudeDeg;
+        record.longitudeDeg = position.longitudeDeg;
+        record.altitudeFt = position.altitudeFt;
+        record.pitchDeg = static_cast<float>(position.pitchDeg);
+        record.rollDeg = static_cast<float>(position.rollDeg);
+        record.headingDeg = static_cast<float>(position.headingDeg);
+        record.setFlag(OnGround, position.onGround);
+        record.setFlag(HasPosition, true);
+    }
+
+    void CXSwiftBusSharedTraffic::setSurfaces(PlaneRecord &record, const CAircraftParts &parts)
+    {
+        const PlaneSurfaces surfaces = PlaneSurfaces::fromParts(parts);
+        record.gear = static_cast<float>(surfaces.gear);
+        record.flaps = static_cast<float>(surfaces.flaps);
+        record.spoilers = static_cast<float>(surfaces.spoilers);
+        record.speedBrakes = static_cast<float>(surfaces.speedBrakes);
+        record.slats = static_cast<float>(surfaces.slats);
+        record.wingSweep = static_cast<float>(surfaces.wingSweep);
+        record.thrust = static_cast<float>(surfaces.thrust);
+        record.elevator = static_cast<float>(surfaces.elevator);
+        record.rudder = static_cast<float>(surfaces.rudder);
+        record.aileron = static_cast<float>(surfaces.aileron);
+        record.lightPattern = surfaces.lightPattern;
+        record.setFlag(LandLights, surfaces.landLight);
+        record.setFlag(TaxiLights, surfaces.taxiLight);
+        record.setFlag(BeaconLights, surfaces.beaconLight);
+        record.setFlag(StrobeLights, surfaces.strobeLight);
+        record.setFlag(NavLights, surfaces.navLight);
+        record.setFlag(HasSurfaces, true);
+    }
+
+    void CXSwiftBusSharedTraffic::setTransponder(PlaneRecord &record, const CTransponder &transponder)
+    {
+        const PlaneTransponder t = PlaneTransponder::fromTransponder(transponder);
+        record.transponderCode = t.code;
+        record.setFlag(TransponderIdent, t.ident);
+        record.setFlag(TransponderModeC, t.modeC);
+        record.setFlag(HasTransponder, true);
+    }
+} // ns
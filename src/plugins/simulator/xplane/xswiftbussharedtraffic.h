@@ -0,0 +1,85 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSIMPLUGIN_XSWIFTBUS_SHAREDTRAFFIC_H
+#define BLACKSIMPLUGIN_XSWIFTBUS_SHAREDTRAFFIC_H
+
+#include "blackmisc/simulation/xplane/sharedtrafficqtfree.h"
+
+#include <QString>
+
+namespace BlackMisc::Aviation
+{
+    class CAircraftParts;
+    class CAircraftSituation;
+    class CTransponder;
+}
+
+namespace BlackSimPlugin::XPlane
+{
+    /*!
+     * Writer side of the shared memory traffic ring read by XSwiftBus.
+     *
+     * The per frame records are keyed by the plane handles, see CXPlaneMPAircraftHandles.
+     * Positions, surfaces and transponders of a frame are written to the ring, DBus is only used to open and close it.
+     * Values are converted by PlanePosition, PlaneSurfaces and PlaneTransponder, like for DBus.
+     */
+    class CXSwiftBusSharedTraffic
+    {
+    public:
+        //! Record in the ring
+        using PlaneRecord = BlackMisc::Simulation::XPlane::SharedTraffic::PlaneRecord;
+
+        //! Constructor
+        CXSwiftBusSharedTraffic() = default;
+
+        //! Supported on this platform?
+        static constexpr bool isSupported() { return BlackMisc::Simulation::XPlane::SharedTraffic::CSharedTrafficRing::isSupported(); }
+
+        //! Create the ring with a name unique for this process
+        bool create();
+
+        //! Close and remove the ring
+        void close();
+
+        //! Ring created?
+        bool isOpen() const { return m_ring.isOpen(); }
+
+        //! Name of the shared memory object
+        QString getName() const { return QString::fromStdString(m_ring.getName()); }
+
+        //! Start a frame
+        void beginFrame();
+
+        //! Record of the plane in the current frame, nullptr if the handle is invalid or the frame is full
+        //! \remark call once per plane and frame
+        PlaneRecord *addRecord(int handle);
+
+        //! Publish the current frame
+        void publishFrame();
+
+        //! Did XSwiftBus miss frames, so everything has to be sent again?
+        bool takeResyncRequest() { return m_ring.takeResyncRequest(); }
+
+        //! \name Record values
+        //! @{
+        static void setPosition(PlaneRecord &record, const BlackMisc::Aviation::CAircraftSituation &situation);
+        static void setSurfaces(PlaneRecord &record, const BlackMisc::Aviation::CAircraftParts &parts);
+        static void setTransponder(PlaneRecord &record, const BlackMisc::Aviation::CTransponder &transponder);
+        //! @}
+
+    private:
+        BlackMisc::Simulation::XPlane::SharedTraffic::CSharedTrafficRing m_ring;
+        PlaneRecord *m_frame = nullptr; //!< records of the current frame
+        quint32 m_frameCount = 0;       //!< records in the current frame
+    };
+} // ns
+
+#endif // guard
@@ -62,6 +62,11 @@ namespace BlackSimPlugin::XPlane
         return info;
     }
 
+    int CXSwiftBusTrafficProxy::getProtocolVersion()
+    {
+        return m_dbusInterface->callDBusRet<int>(QLatin1String("getProtocolVersion"));
+    }
+
     bool CXSwiftBusTrafficProxy::initialize()
     {
         return m_dbusInterface->callDBusRet<bool>(QLatin1String("initialize"));
@@ -92,9 +97,9 @@ namespace BlackSimPlugin::XPlane
         m_dbusInterface->callDBus(QLatin1String("setMaxDrawDistance"), nauticalMiles);
     }
 
-    void CXSwiftBusTrafficProxy::addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
+    void CXSwiftBusTrafficProxy::addPlane(int handle, const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
     {
-        m_dbusInterface->callDBus(QLatin1String("addPlane"), callsign, modelName, aircraftIcao, airlineIcao, livery);
+        m_dbusInterface->callDBus(QLatin1String("addPlane"), handle, callsign, modelName, aircraftIcao, airlineIcao, livery);
     }
 
     void CXSwiftBusTrafficProxy::removePlane(const QString &callsign)
@@ -110,7 +115,7 @@ namespace BlackSimPlugin::XPlane
     void CXSwiftBusTrafficProxy::setPlanesPositions(const PlanesPositions &planesPositions)
     {
         m_dbusInterface->callDBus(QLatin1String("setPlanesPositions"),
-                                    planesPositions.callsigns, planesPositions.latitudesDeg, planesPositions.longitudesDeg,
+                                    planesPositions.handles, planesPositions.latitudesDeg, planesPositions.longitudesDeg,
                                     planesPositions.altitudesFt, planesPositions.pitchesDeg, planesPositions.rollsDeg,
                                     planesPositions.headingsDeg, planesPositions.onGrounds);
     }
@@ -118,7 +123,7 @@ namespace BlackSimPlugin::XPlane
     void CXSwiftBusTrafficProxy::setPlanesSurfaces(const PlanesSurfaces &planesSurfaces)
     {
         m_dbusInterface->callDBus(QLatin1String("setPlanesSurfaces"),
-                                    planesSurfaces.callsigns, planesSurfaces.gears, planesSurfaces.flaps,
+                                    planesSurfaces.handles, planesSurfaces.gears, planesSurfaces.flaps,
                                     planesSurfaces.spoilers, planesSurfaces.speedBrakes, planesSurfaces.slats,
                                     planesSurfaces.wingSweeps, planesSurfaces.thrusts, planesSurfaces.elevators,
                                     planesSurfaces.rudders, planesSurfaces.ailerons,
@@ -130,30 +135,40 @@ namespace BlackSimPlugin::XPlane
     void CXSwiftBusTrafficProxy::setPlanesTransponders(const PlanesTransponders &planesTransponders)
     {
         m_dbusInterface->callDBus(QLatin1String("setPlanesTransponders"),
-                                    planesTransponders.callsigns, planesTransponders.codes,
+                                    planesTransponders.handles, planesTransponders.codes,
                                     planesTransponders.modeCs, planesTransponders.idents);
     }
 
+    bool CXSwiftBusTrafficProxy::openSharedTraffic(const QString &name)
+    {
+        return m_dbusInterface->callDBusRet<bool>(QLatin1String("openSharedTraffic"), name);
+    }
+
+    void CXSwiftBusTrafficProxy::closeSharedTraffic()
+    {
+        m_dbusInterface->callDBus(QLatin1String("closeSharedTraffic"));
+    }
+
     void CXSwiftBusTrafficProxy::setInterpolatorMode(const QString &callsign, bool spline)
     {
         m_dbusInterface->callDBus(QLatin1String("setInterpolatorMode"), callsign, spline);
     }
 
-    void CXSwiftBusTrafficProxy::getRemoteAircraftData(const QStringList &callsigns, const RemoteAircraftDataCallback &setter) const
+    void CXSwiftBusTrafficProxy::getRemoteAircraftData(const QList<int> &handles, const RemoteAircraftDataCallback &setter) const
     {
         std::function<void(QDBusPendingCallWatcher *)> callback = [ = ](QDBusPendingCallWatcher * watcher)
         {
-            QDBusPendingReply<QStringList, QList<double>, QList<double>, QList<double>, QList<bool>, QList<double>> reply = *watcher;
+            QDBusPendingReply<QList<int>, QList<double>, QList<double>, QList<double>, QList<bool>, QList<double>> reply = *watcher;
             if (!reply.isError())
             {
-                const QStringList callsigns = reply.argumentAt<0>();
+                const QList<int> handles = reply.argumentAt<0>();
                 const QList<double> latitudesDeg  = reply.argumentAt<1>();
                 const QList<double> longitudesDeg = reply.argumentAt<2>();
                 const QList<double> elevationsM   = reply.argumentAt<3>();
                 const QList<bool>   waterFlags    = reply.argumentAt<4>();
                 const QList<double> verticalOffsets = reply.argumentAt<5>();
 
-                setter(callsigns, latitudesDeg, longitudesDeg, elevationsM, waterFlags, verticalOffsets);
+                setter(handles, latitudesDeg, longitudesDeg, elevationsM, waterFlags, verticalOffsets);
             }
             else
             {
@@ -162,7 +177,7 @@ namespace BlackSimPlugin::XPlane
             }
             watcher->deleteLater();
         };
-        m_dbusInterface->callDBusAsync(QLatin1String("getRemoteAircraftData"), callback, callsigns);
+        m_dbusInterface->callDBusAsync(QLatin1String("getRemoteAircraftData"), callback, handles);
     }
 
     void CXSwiftBusTrafficProxy::getElevationAtPosition(const CCallsign &callsign, double latitudeDeg, double longitudeDeg, double altitudeMeters,
@@ -12,9 +12,11 @@
 #define BLACKSIMPLUGIN_XSWIFTBUS_TRAFFIC_PROXY_H
 
 #include "blackmisc/genericdbusinterface.h"
+#include "blackmisc/dbusutils.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/transponder.h"
 #include "blackmisc/geo/elevationplane.h"
 #include "blackmisc/logcategories.h"
 
@@ -29,6 +31,7 @@ class QDBusConnection;
 //! \cond PRIVATE
 #define XSWIFTBUS_TRAFFIC_INTERFACENAME "org.swift_project.xswiftbus.traffic"
 #define XSWIFTBUS_TRAFFIC_OBJECTPATH "/xswiftbus/traffic"
+#define XSWIFTBUS_TRAFFIC_PROTOCOL_VERSION 1
 //! \endcond
 
 namespace BlackSimPlugin::XPlane
@@ -39,16 +42,100 @@ namespace BlackSimPlugin::XPlane
     //! List of bools
     using QBoolList = QList<bool>;
 
+    //! Position of a plane converted to the XSwiftBus values
+    struct PlanePosition
+    {
+        double latitudeDeg = 0;  //!< latitude
+        double longitudeDeg = 0; //!< longitude
+        double altitudeFt = 0;   //!< altitude
+        double pitchDeg = 0;     //!< pitch
+        double rollDeg = 0;      //!< roll
+        double headingDeg = 0;   //!< heading
+        bool onGround = false;   //!< on ground
+
+        //! Converted from the situation
+        static PlanePosition fromSituation(const BlackMisc::Aviation::CAircraftSituation &situation)
+        {
+            using namespace BlackMisc::PhysicalQuantities;
+            PlanePosition p;
+            p.latitudeDeg = situation.latitude().value(CAngleUnit::deg());
+            p.longitudeDeg = situation.longitude().value(CAngleUnit::deg());
+            p.altitudeFt = situation.getAltitude().value(CLengthUnit::ft());
+            p.pitchDeg = situation.getPitch().value(CAngleUnit::deg());
+            p.rollDeg = situation.getBank().value(CAngleUnit::deg());
+            p.headingDeg = situation.getHeading().value(CAngleUnit::deg());
+            p.onGround = situation.getOnGround() == BlackMisc::Aviation::CAircraftSituation::OnGround;
+            return p;
+        }
+    };
+
+    //! Surfaces of a plane converted to the XSwiftBus values
+    struct PlaneSurfaces
+    {
+        double gear = 0;         //!< gear
+        double flaps = 0;        //!< flaps
+        double spoilers = 0;     //!< spoilers
+        double speedBrakes = 0;  //!< speed brakes
+        double slats = 0;        //!< slats
+        double wingSweep = 0;    //!< wing sweep
+        double thrust = 0;       //!< thrust
+        double elevator = 0;     //!< elevator
+        double rudder = 0;       //!< rudder
+        double aileron = 0;      //!< aileron
+        bool landLight = false;   //!< landing light
+        bool taxiLight = false;   //!< taxi light
+        bool beaconLight = false; //!< beacon light
+        bool strobeLight = false; //!< strobe light
+        bool navLight = false;    //!< nav light
+        int lightPattern = 0;     //!< light pattern
+
+        //! Converted from the parts
+        static PlaneSurfaces fromParts(const BlackMisc::Aviation::CAircraftParts &parts)
+        {
+            PlaneSurfaces s;
+            s.gear = parts.isFixedGearDown() ? 1 : 0;
+            s.flaps = parts.getFlapsPercent() / 100.0;
+            s.spoilers = parts.isSpoilersOut() ? 1 : 0;
+            s.speedBrakes = parts.isSpoilersOut() ? 1 : 0;
+            s.slats = parts.getFlapsPercent() / 100.0;
+            s.thrust = parts.isAnyEngineOn() ? 0.75 : 0;
+            s.landLight = parts.getLights().isLandingOn();
+            s.taxiLight = parts.getLights().isTaxiOn();
+            s.beaconLight = parts.getLights().isBeaconOn();
+            s.strobeLight = parts.getLights().isStrobeOn();
+            s.navLight = parts.getLights().isNavOn();
+            return s;
+        }
+    };
+
+    //! Transponder of a plane converted to the XSwiftBus values
+    struct PlaneTransponder
+    {
+        int code = 0;       //!< transponder code
+        bool modeC = false; //!< mode C
+        bool ident = false; //!< ident
+
+        //! Converted from the transponder
+        static PlaneTransponder fromTransponder(const BlackMisc::Aviation::CTransponder &transponder)
+        {
+            PlaneTransponder t;
+            t.code = transponder.getTransponderCode();
+            t.ident = transponder.getTransponderMode() == BlackMisc::Aviation::CTransponder::StateIdent;
+            t.modeC = transponder.getTransponderMode() == BlackMisc::Aviation::CTransponder::ModeC;
+            return t;
+        }
+    };
+
     //! Planes positions
     struct PlanesPositions
     {
         //! Is empty?
-        bool isEmpty() const { return callsigns.isEmpty(); }
+        bool isEmpty() const { return handles.isEmpty(); }
 
         //! Check function
         bool hasSameSizes() const
         {
-            const int s = callsigns.size();
+            const int s = handles.size();
             if (s != latitudesDeg.size())  { return false; }
             if (s != longitudesDeg.size()) { return false; }
             if (s != altitudesFt.size())   { return false; }
@@ -58,20 +145,21 @@ namespace BlackSimPlugin::XPlane
             return true;
         }
 
-        //! Push back the latest situation
-        void push_back(const BlackMisc::Aviation::CAircraftSituation &situation)
+        //! Push back the latest situation of the plane with handle
+        void push_back(int handle, const BlackMisc::Aviation::CAircraftSituation &situation)
         {
-            this->callsigns.push_back(situation.getCallsign().asString());
-            this->latitudesDeg.push_back(situation.latitude().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
-            this->longitudesDeg.push_back(situation.longitude().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
-            this->altitudesFt.push_back(situation.getAltitude().value(BlackMisc::PhysicalQuantities::CLengthUnit::ft()));
-            this->pitchesDeg.push_back(situation.getPitch().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
-            this->rollsDeg.push_back(situation.getBank().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
-            this->headingsDeg.push_back(situation.getHeading().value(BlackMisc::PhysicalQuantities::CAngleUnit::deg()));
-            this->onGrounds.push_back(situation.getOnGround() == BlackMisc::Aviation::CAircraftSituation::OnGround);
+            const PlanePosition position = PlanePosition::fromSituation(situation);
+            this->handles.push_back(handle);
+            this->latitudesDeg.push_back(position.latitudeDeg);
+            this->longitudesDeg.push_back(position.longitudeDeg);
+            this->altitudesFt.push_back(position.altitudeFt);
+            this->pitchesDeg.push_back(position.pitchDeg);
+            this->rollsDeg.push_back(position.rollDeg);
+            this->headingsDeg.push_back(position.headingDeg);
+            this->onGrounds.push_back(position.onGround);
         }
 
-        QStringList   callsigns;       //!< List of callsigns
+        QList<int>    handles;         //!< List of plane handles
         QList<double> latitudesDeg;    //!< List of latitudes
         QList<double> longitudesDeg;   //!< List of longitudes
         QList<double> altitudesFt;     //!< List of altitudes
@@ -79,37 +167,45 @@ namespace BlackSimPlugin::XPlane
         QList<double> rollsDeg;        //!< List of rolls
         QList<double> headingsDeg;     //!< List of headings
         QList<bool>   onGrounds;       //!< List of onGrounds
+
+        //! DBus payload per plane
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(handles), decltype(latitudesDeg), decltype(longitudesDeg), decltype(altitudesFt),
+                   decltype(pitchesDeg), decltype(rollsDeg), decltype(headingsDeg), decltype(onGrounds)>();
+        }
     };
 
     //! Planes surfaces
     struct PlanesSurfaces
     {
         //! Is empty?
-        bool isEmpty() const { return callsigns.isEmpty(); }
+        bool isEmpty() const { return handles.isEmpty(); }
 
-        //! Push back the latest parts
-        void push_back(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::Aviation::CAircraftParts &parts)
+        //! Push back the latest parts of the plane with handle
+        void push_back(int handle, const BlackMisc::Aviation::CAircraftParts &parts)
         {
-            this->callsigns.push_back(callsign.asString());
-            this->gears.push_back(parts.isFixedGearDown() ? 1 : 0);
-            this->flaps.push_back(parts.getFlapsPercent() / 100.0);
-            this->spoilers.push_back(parts.isSpoilersOut() ? 1 : 0);
-            this->speedBrakes.push_back(parts.isSpoilersOut() ? 1 : 0);
-            this->slats.push_back(parts.getFlapsPercent() / 100.0);
-            this->wingSweeps.push_back(0.0);
-            this->thrusts.push_back(parts.isAnyEngineOn() ? 0.75 : 0);
-            this->elevators.push_back(0.0);
-            this->rudders.push_back(0.0);
-            this->ailerons.push_back(0.0);
-            this->landLights.push_back(parts.getLights().isLandingOn());
-            this->taxiLights.push_back(parts.getLights().isTaxiOn());
-            this->beaconLights.push_back(parts.getLights().isBeaconOn());
-            this->strobeLights.push_back(parts.getLights().isStrobeOn());
-            this->navLights.push_back(parts.getLights().isNavOn());
-            this->lightPatterns.push_back(0);
+            const PlaneSurfaces surfaces = PlaneSurfaces::fromParts(parts);
+            this->handles.push_back(handle);
+            this->gears.push_back(surfaces.gear);
+            this->flaps.push_back(surfaces.flaps);
+            this->spoilers.push_back(surfaces.spoilers);
+            this->speedBrakes.push_back(surfaces.speedBrakes);
+            this->slats.push_back(surfaces.slats);
+            this->wingSweeps.push_back(surfaces.wingSweep);
+            this->thrusts.push_back(surfaces.thrust);
+            this->elevators.push_back(surfaces.elevator);
+            this->rudders.push_back(surfaces.rudder);
+            this->ailerons.push_back(surfaces.aileron);
+            this->landLights.push_back(surfaces.landLight);
+            this->taxiLights.push_back(surfaces.taxiLight);
+            this->beaconLights.push_back(surfaces.beaconLight);
+            this->strobeLights.push_back(surfaces.strobeLight);
+            this->navLights.push_back(surfaces.navLight);
+            this->lightPatterns.push_back(surfaces.lightPattern);
         }
 
-        QStringList callsigns;      //!< List of callsigns
+        QList<int> handles;         //!< List of plane handles
         QList<double> gears;        //!< List of gears
         QList<double> flaps;        //!< List of flaps
         QList<double> spoilers;     //!< List of spoilers
@@ -126,18 +222,42 @@ namespace BlackSimPlugin::XPlane
         QList<bool> strobeLights;   //!< List of strobe lights
         QList<bool> navLights;      //!< List of nav lights
         QList<int> lightPatterns;   //!< List of light patterns
+
+        //! DBus payload per plane
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(handles), decltype(gears), decltype(flaps), decltype(spoilers), decltype(speedBrakes),
+                   decltype(slats), decltype(wingSweeps), decltype(thrusts), decltype(elevators), decltype(rudders), decltype(ailerons),
+                   decltype(landLights), decltype(taxiLights), decltype(beaconLights), decltype(strobeLights), decltype(navLights), decltype(lightPatterns)>();
+        }
     };
 
     //! Plane Transponders
     struct PlanesTransponders
     {
         //! Is empty?
-        bool isEmpty() const { return callsigns.isEmpty(); }
+        bool isEmpty() const { return handles.isEmpty(); }
+
+        //! Push back the transponder of the plane with handle
+        void push_back(int handle, const BlackMisc::Aviation::CTransponder &transponder)
+        {
+            const PlaneTransponder t = PlaneTransponder::fromTransponder(transponder);
+            this->handles.push_back(handle);
+            this->codes.push_back(t.code);
+            this->idents.push_back(t.ident);
+            this->modeCs.push_back(t.modeC);
+        }
 
-        QStringList callsigns;  //!< List of callsigns
+        QList<int> handles;     //!< List of plane handles
         QList<int> codes;       //!< List of transponder codes
         QList<bool> modeCs;     //!< List of active mode C's
         QList<bool> idents;     //!< List of active idents
+
+        //! DBus payload per plane
+        static constexpr int dBusSizePerPlane()
+        {
+            return BlackMisc::CDBusUtils::dBusElementSize<decltype(handles), decltype(codes), decltype(modeCs), decltype(idents)>();
+        }
     };
 
     //! Multiplayer Acquire Info
@@ -159,7 +279,7 @@ namespace BlackSimPlugin::XPlane
         using ElevationCallback = std::function<void (const BlackMisc::Geo::CElevationPlane &, const BlackMisc::Aviation::CCallsign &, bool)>;
 
         //! Remote aircrafts data callback
-        using RemoteAircraftDataCallback = std::function<void (const QStringList &, const QDoubleList &, const QDoubleList &, const QDoubleList &, const QBoolList &, const QDoubleList &)>;
+        using RemoteAircraftDataCallback = std::function<void (const QList<int> &, const QDoubleList &, const QDoubleList &, const QDoubleList &, const QBoolList &, const QDoubleList &)>;
 
         //! Service name
         static const QString &InterfaceName()
@@ -199,6 +319,13 @@ namespace BlackSimPlugin::XPlane
         //! \copydoc XSwiftBus::CTraffic::acquireMultiplayerPlanes
         MultiplayerAcquireInfo acquireMultiplayerPlanes();
 
+        //! \copydoc XSwiftBus::CTraffic::ProtocolVersion
+        static constexpr int ProtocolVersion = XSWIFTBUS_TRAFFIC_PROTOCOL_VERSION;
+
+        //! \copydoc XSwiftBus::CTraffic::getProtocolVersion
+        //! \remark 0 for versions without protocol version
+        int getProtocolVersion();
+
         //! \copydoc XSwiftBus::CTraffic::initialize
         bool initialize();
 
@@ -218,7 +345,7 @@ namespace BlackSimPlugin::XPlane
         void setMaxDrawDistance(double nauticalMiles);
 
         //! \copydoc XSwiftBus::CTraffic::addPlane
-        void addPlane(const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
+        void addPlane(int handle, const QString &callsign, const QString &modelName, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
 
         //! \copydoc XSwiftBus::CTraffic::removePlane
         void removePlane(const QString &callsign);
@@ -238,8 +365,14 @@ namespace BlackSimPlugin::XPlane
         //! \deprecated XSwiftBus::CTraffic::setInterpolatorMode
         void setInterpolatorMode(const QString &callsign, bool spline);
 
+        //! \copydoc XSwiftBus::CTraffic::openSharedTraffic
+        bool openSharedTraffic(const QString &name);
+
+        //! \copydoc XSwiftBus::CTraffic::closeSharedTraffic
+        void closeSharedTraffic();
+
         //! \copydoc XSwiftBus::CTraffic::getRemoteAircraftData
-        void getRemoteAircraftData(const QStringList &callsigns, const RemoteAircraftDataCallback &setter) const;
+        void getRemoteAircraftData(const QList<int> &handles, const RemoteAircraftDataCallback &setter) const;
 
         //! \copydoc XSwiftBus::CTraffic::getElevationAtPosition
         void getElevationAtPosition(const BlackMisc::Aviation::CCallsign &callsign, double latitudeDeg, double longitudeDeg, double altitudeMeters,
@@ -109,6 +109,15 @@ namespace XSwiftBus
         dbus_message_iter_append_basic(&m_messageIterator, DBUS_TYPE_DOUBLE, &value);
     }
 
+    void CDBusMessage::appendArgument(const std::vector<int> &array)
+    {
+        DBusMessageIter arrayIterator;
+        dbus_message_iter_open_container(&m_messageIterator, DBUS_TYPE_ARRAY, DBUS_TYPE_INT32_AS_STRING, &arrayIterator);
+        const dbus_int32_t *ptr = array.data();
+        dbus_message_iter_append_fixed_array(&arrayIterator, DBUS_TYPE_INT32, &ptr, static_cast<int>(array.size()));
+        dbus_message_iter_close_container(&m_messageIterator, &arrayIterator);
+    }
+
     void CDBusMessage::appendArgument(const std::vector<bool> &array)
     {
         // array.data() not existing for bool
@@ -32,13 +32,15 @@
 
 float XPMP_PrepListHook(float, float, int, void *); // defined in xplanemp2/src/Renderer.cpp
 
+using namespace BlackMisc::Simulation::XPlane;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+using namespace BlackMisc::Simulation::XPlane::SharedTraffic;
 using namespace std::chrono_literals;
 
 namespace XSwiftBus
 {
-    CTraffic::Plane::Plane(void *id_, const std::string &callsign_, const std::string &aircraftIcao_, const std::string &airlineIcao_, const std::string &livery_, const std::string &modelName_)
-        : id(id_), callsign(callsign_), aircraftIcao(aircraftIcao_), airlineIcao(airlineIcao_), livery(livery_), modelName(modelName_)
+    CTraffic::Plane::Plane(void *id_, int handle_, const std::string &callsign_, const std::string &aircraftIcao_, const std::string &airlineIcao_, const std::string &livery_, const std::string &modelName_)
+        : id(id_), handle(handle_), callsign(callsign_), aircraftIcao(aircraftIcao_), airlineIcao(airlineIcao_), livery(livery_), modelName(modelName_)
     {
         std::memset(static_cast<void *>(&positions), 0, sizeof(positions));
         for (auto &position : positions) { position.size = sizeof(position); }
@@ -133,6 +135,7 @@ namespace XSwiftBus
 
     void CTraffic::cleanup()
     {
+        closeSharedTraffic();
         removeAllPlanes();
 
         if (m_enabledMultiplayer)
@@ -300,11 +303,18 @@ namespace XSwiftBus
         if (s.setMaxDrawDistanceNM(nauticalMiles)) { this->setSettings(s); }
     }
 
-    void CTraffic::addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery)
+    void CTraffic::addPlane(int handle, const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery)
     {
         auto planeIt = m_planesByCallsign.find(callsign);
         if (planeIt != m_planesByCallsign.end()) { return; }
 
+        if (!PlaneHandle::isValid(handle))
+        {
+            WARNING_LOG("Invalid handle for " + callsign);
+            emitPlaneAddingFailed(callsign);
+            return;
+        }
+
         XPMPPlaneID id = nullptr;
         if (modelName.empty() || m_modelStrings.count(modelName) == 0)
         {
@@ -322,10 +332,14 @@ namespace XSwiftBus
             return;
         }
 
-        Plane *plane = new Plane(id, callsign, aircraftIcao, airlineIcao, livery, modelName);
+        Plane *plane = new Plane(id, handle, callsign, aircraftIcao, airlineIcao, livery, modelName);
         m_planesByCallsign[callsign] = plane;
         m_planesById[id] = plane;
 
+        const size_t slot = static_cast<size_t>(PlaneHandle::slotOf(handle));
+        if (slot >= m_planesBySlot.size()) { m_planesBySlot.resize(slot + 1, nullptr); }
+        m_planesBySlot[slot] = plane;
+
         // Create view menu item
         CMenuItem planeViewMenuItem = m_followPlaneViewSubMenu.item(callsign, [this, callsign] { switchToFollowPlaneView(callsign); });
         m_followPlaneViewMenuItems[callsign] = planeViewMenuItem;
@@ -352,6 +366,8 @@ namespace XSwiftBus
         Plane *plane = planeIt->second;
         m_planesByCallsign.erase(callsign);
         m_planesById.erase(plane->id);
+        Plane *&slotPlane = m_planesBySlot[static_cast<size_t>(PlaneHandle::slotOf(plane->handle))];
+        if (slotPlane == plane) { slotPlane = nullptr; }
         XPMPDestroyPlane(plane->id);
         delete plane;
     }
@@ -374,45 +390,25 @@ namespace XSwiftBus
 
         m_planesByCallsign.clear();
         m_planesById.clear();
+        m_planesBySlot.clear();
         m_followPlaneViewMenuItems.clear();
         m_followPlaneViewSequence.clear();
     }
 
-    void CTraffic::setPlanesPositions(const std::vector<std::string> &callsigns, std::vector<double> latitudesDeg, std::vector<double> longitudesDeg, std::vector<double> altitudesFt,
+    void CTraffic::setPlanesPositions(const std::vector<int> &handles, std::vector<double> latitudesDeg, std::vector<double> longitudesDeg, std::vector<double> altitudesFt,
                                       std::vector<double> pitchesDeg, std::vector<double> rollsDeg, std::vector<double> headingsDeg, const std::vector<bool> &onGrounds)
     {
-        const bool setOnGround = onGrounds.size() == callsigns.size();
-        for (size_t i = 0; i < callsigns.size(); i++)
+        const bool setOnGround = onGrounds.size() == handles.size();
+        for (size_t i = 0; i < handles.size(); i++)
         {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
-
-            Plane *plane = planeIt->second;
+            Plane *plane = planeByHandle(handles.at(i));
             if (!plane) { continue; }
-            plane->positions[2].lat = latitudesDeg.at(i);
-            plane->positions[2].lon = longitudesDeg.at(i);
-            plane->positions[2].elevation = altitudesFt.at(i);
-            plane->positions[2].pitch   = static_cast<float>(pitchesDeg.at(i));
-            plane->positions[2].roll    = static_cast<float>(rollsDeg.at(i));
-            plane->positions[2].heading = static_cast<float>(headingsDeg.at(i));
-            plane->positions[2].offsetScale = 1.0f;
-            plane->positions[2].clampToGround = true;
-            plane->positionTimes[2] = std::chrono::steady_clock::now();
-
-            // save 2 positions at 1-second intervals for use in interpolation
-            if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
-            {
-                plane->positionTimes[0] = plane->positionTimes[1];
-                plane->positionTimes[1] = plane->positionTimes[2];
-                std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
-                std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
-            }
-
+            setPlanePosition(plane, latitudesDeg.at(i), longitudesDeg.at(i), altitudesFt.at(i), pitchesDeg.at(i), rollsDeg.at(i), headingsDeg.at(i));
             if (setOnGround) { plane->isOnGround = onGrounds.at(i); }
         }
     }
 
-    void CTraffic::setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
+    void CTraffic::setPlanesSurfaces(const std::vector<int> &handles, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
                                      const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
                                      const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
                                      const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
@@ -420,80 +416,159 @@ namespace XSwiftBus
     {
         const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
 
-        for (size_t i = 0; i < callsigns.size(); i++)
+        for (size_t i = 0; i < handles.size(); i++)
         {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
+            Plane *plane = planeByHandle(handles.at(i));
+            if (!plane) { continue; }
+
+            setPlaneSurfaces(plane, gears.at(i), flaps.at(i), spoilers.at(i), speedBrakes.at(i), slats.at(i), wingSweeps.at(i), thrusts.at(i),
+                             elevators.at(i), rudders.at(i), ailerons.at(i), landLights.at(i), taxiLights.at(i), beaconLights.at(i),
+                             strobeLights.at(i), navLights.at(i), lightPatterns.at(i), bundleTaxiLandingLights);
+        }
+    }
 
-            Plane *plane = planeIt->second;
+    void CTraffic::setPlanesTransponders(const std::vector<int> &handles, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents)
+    {
+        for (size_t i = 0; i < handles.size(); i++)
+        {
+            Plane *plane = planeByHandle(handles.at(i));
             if (!plane) { continue; }
+            setPlaneTransponder(plane, codes.at(i), modeCs.at(i), idents.at(i));
+        }
+    }
 
-            plane->hasSurfaces = true;
-            plane->targetGearPosition = static_cast<float>(gears.at(i));
-            plane->surfaces.flapRatio = static_cast<float>(flaps.at(i));
-            plane->surfaces.spoilerRatio = static_cast<float>(spoilers.at(i));
-            plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrakes.at(i));
-            plane->surfaces.slatRatio = static_cast<float>(slats.at(i));
-            plane->surfaces.wingSweep = static_cast<float>(wingSweeps.at(i));
-            plane->surfaces.thrust = static_cast<float>(thrusts.at(i));
-            plane->surfaces.yokePitch = static_cast<float>(elevators.at(i));
-            plane->surfaces.yokeHeading = static_cast<float>(rudders.at(i));
-            plane->surfaces.yokeRoll = static_cast<float>(ailerons.at(i));
-            if (bundleTaxiLandingLights)
-            {
-                const bool on = landLights.at(i) || taxiLights.at(i);
-                plane->surfaces.lights.landLights = on;
-                plane->surfaces.lights.taxiLights = on;
-            }
-            else
-            {
-                plane->surfaces.lights.landLights = landLights.at(i);
-                plane->surfaces.lights.taxiLights = taxiLights.at(i);
-            }
-            plane->surfaces.lights.bcnLights = beaconLights.at(i);
-            plane->surfaces.lights.strbLights = strobeLights.at(i);
-            plane->surfaces.lights.navLights = navLights.at(i);
-            plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPatterns.at(i));
+    void CTraffic::setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg)
+    {
+        plane->positions[2].lat = latitudeDeg;
+        plane->positions[2].lon = longitudeDeg;
+        plane->positions[2].elevation = altitudeFt;
+        plane->positions[2].pitch   = static_cast<float>(pitchDeg);
+        plane->positions[2].roll    = static_cast<float>(rollDeg);
+        plane->positions[2].heading = static_cast<float>(headingDeg);
+        plane->positions[2].offsetScale = 1.0f;
+        plane->positions[2].clampToGround = true;
+        plane->positionTimes[2] = std::chrono::steady_clock::now();
+
+        // save 2 positions at 1-second intervals for use in interpolation
+        if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
+        {
+            plane->positionTimes[0] = plane->positionTimes[1];
+            plane->positionTimes[1] = plane->positionTimes[2];
+            std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
+            std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
         }
     }
 
-    void CTraffic::setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents)
+    void CTraffic::setPlaneSurfaces(Plane *plane, double gear, double flaps, double spoilers, double speedBrakes, double slats, double wingSweep, double thrust,
+                                    double elevator, double rudder, double aileron, bool landLights, bool taxiLights, bool beaconLights, bool strobeLights, bool navLights,
+                                    int lightPattern, bool bundleTaxiLandingLights)
     {
-        for (size_t i = 0; i < callsigns.size(); i++)
+        plane->hasSurfaces = true;
+        plane->targetGearPosition = static_cast<float>(gear);
+        plane->surfaces.flapRatio = static_cast<float>(flaps);
+        plane->surfaces.spoilerRatio = static_cast<float>(spoilers);
+        plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrakes);
+        plane->surfaces.slatRatio = static_cast<float>(slats);
+        plane->surfaces.wingSweep = static_cast<float>(wingSweep);
+        plane->surfaces.thrust = static_cast<float>(thrust);
+        plane->surfaces.yokePitch = static_cast<float>(elevator);
+        plane->surfaces.yokeHeading = static_cast<float>(rudder);
+        plane->surfaces.yokeRoll = static_cast<float>(aileron);
+        if (bundleTaxiLandingLights)
+        {
+            const bool on = landLights || taxiLights;
+            plane->surfaces.lights.landLights = on;
+            plane->surfaces.lights.taxiLights = on;
+        }
+        else
         {
-            auto planeIt = m_planesByCallsign.find(callsigns.at(i));
-            if (planeIt == m_planesByCallsign.end()) { continue; }
+            plane->surfaces.lights.landLights = landLights;
+            plane->surfaces.lights.taxiLights = taxiLights;
+        }
+        plane->surfaces.lights.bcnLights = beaconLights;
+        plane->surfaces.lights.strbLights = strobeLights;
+        plane->surfaces.lights.navLights = navLights;
+        plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPattern);
+    }
 
-            Plane *plane = planeIt->second;
-            if (!plane) { continue; }
+    void CTraffic::setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident)
+    {
+        plane->surveillance.code = code;
+        if (ident) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
+        else if (modeC) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
+        else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    }
 
-            plane->surveillance.code = codes.at(i);
-            if (idents.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
-            else if (modeCs.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
-            else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    bool CTraffic::openSharedTraffic(const std::string &name)
+    {
+        if (!m_sharedTraffic.open(name))
+        {
+            DEBUG_LOG("Cannot open shared traffic memory " + name + ", using DBus");
+            return false;
         }
+        INFO_LOG("Reading traffic from shared memory " + name);
+        return true;
     }
 
-    void CTraffic::getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
+    void CTraffic::closeSharedTraffic()
+    {
+        if (!m_sharedTraffic.isOpen()) { return; }
+        m_sharedTraffic.close();
+    }
+
+    CTraffic::Plane *CTraffic::planeByHandle(int handle) const
+    {
+        // records can arrive via shared memory before a removal or an addition via DBus, so the generation is checked
+        if (!PlaneHandle::isValid(handle)) { return nullptr; }
+        const size_t slot = static_cast<size_t>(PlaneHandle::slotOf(handle));
+        if (slot >= m_planesBySlot.size()) { return nullptr; }
+        Plane *plane = m_planesBySlot[slot];
+        return plane && plane->handle == handle ? plane : nullptr;
+    }
+
+    void CTraffic::readSharedTraffic()
+    {
+        if (!m_sharedTraffic.isOpen()) { return; }
+        const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
+        m_sharedTraffic.readFrames([ & ](const PlaneRecord & record)
+        {
+            Plane *plane = planeByHandle(record.handle);
+            if (!plane) { return; }
+            if (record.hasFlag(HasPosition))
+            {
+                setPlanePosition(plane, record.latitudeDeg, record.longitudeDeg, record.altitudeFt, record.pitchDeg, record.rollDeg, record.headingDeg);
+                plane->isOnGround = record.hasFlag(OnGround);
+            }
+            if (record.hasFlag(HasSurfaces))
+            {
+                setPlaneSurfaces(plane, record.gear, record.flaps, record.spoilers, record.speedBrakes, record.slats, record.wingSweep, record.thrust,
+                                 record.elevator, record.rudder, record.aileron, record.hasFlag(LandLights), record.hasFlag(TaxiLights),
+                                 record.hasFlag(BeaconLights), record.hasFlag(StrobeLights), record.hasFlag(NavLights), record.lightPattern, bundleTaxiLandingLights);
+            }
+            if (record.hasFlag(HasTransponder))
+            {
+                setPlaneTransponder(plane, record.transponderCode, record.hasFlag(TransponderModeC), record.hasFlag(TransponderIdent));
+            }
+        });
+    }
+
+    void CTraffic::getRemoteAircraftData(std::vector<int> &handles, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
                                          std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const
     {
-        if (callsigns.empty() || m_planesByCallsign.empty()) { return; }
+        if (handles.empty() || m_planesByCallsign.empty()) { return; }
 
-        const auto requestedCallsigns = callsigns;
-        callsigns.clear();
+        const auto requestedHandles = handles;
+        handles.clear();
         latitudesDeg.clear();
         longitudesDeg.clear();
         elevationsM.clear();
         verticalOffsets.clear();
         waterFlags.clear();
 
-        for (const auto &requestedCallsign : requestedCallsigns)
+        for (const int requestedHandle : requestedHandles)
         {
-            const auto planeIt = m_planesByCallsign.find(requestedCallsign);
-            if (planeIt == m_planesByCallsign.end()) { continue; }
-
-            const Plane *plane = planeIt->second;
-            assert(plane);
+            const Plane *plane = planeByHandle(requestedHandle);
+            if (!plane) { continue; }
 
             const double latDeg = plane->positions[2].lat;
             const double lonDeg = plane->positions[2].lon;
@@ -502,11 +577,11 @@ namespace XSwiftBus
             if (getSettings().isTerrainProbeEnabled())
             {
                 // we expect elevation in meters
-                groundElevation = plane->terrainProbe.getElevation(latDeg, lonDeg, plane->positions[2].elevation, requestedCallsign, isWater).front();
+                groundElevation = plane->terrainProbe.getElevation(latDeg, lonDeg, plane->positions[2].elevation, plane->callsign, isWater).front();
                 if (std::isnan(groundElevation)) { groundElevation = 0.0; }
             }
 
-            callsigns.push_back(requestedCallsign);
+            handles.push_back(requestedHandle);
             latitudesDeg.push_back(latDeg);
             longitudesDeg.push_back(lonDeg);
             elevationsM.push_back(groundElevation);
@@ -538,6 +613,7 @@ namespace XSwiftBus
 
     void CTraffic::dbusDisconnectedHandler()
     {
+        closeSharedTraffic();
         removeAllPlanes();
     }
 
@@ -578,6 +654,10 @@ namespace XSwiftBus
                     sendDBusMessage(reply);
                 });
             }
+            else if (message.getMethodName() == "getProtocolVersion")
+            {
+                sendDBusReply(sender, serial, getProtocolVersion());
+            }
             else if (message.getMethodName() == "initialize")
             {
                 sendDBusReply(sender, serial, initialize());
@@ -635,12 +715,14 @@ namespace XSwiftBus
             else if (message.getMethodName() == "addPlane")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
+                int handle = -1;
                 std::string callsign;
                 std::string modelName;
                 std::string aircraftIcao;
                 std::string airlineIcao;
                 std::string livery;
                 message.beginArgumentRead();
+                message.getArgument(handle);
                 message.getArgument(callsign);
                 message.getArgument(modelName);
                 message.getArgument(aircraftIcao);
@@ -649,7 +731,7 @@ namespace XSwiftBus
 
                 queueDBusCall([ = ]()
                 {
-                    addPlane(callsign, modelName, aircraftIcao, airlineIcao, livery);
+                    addPlane(handle, callsign, modelName, aircraftIcao, airlineIcao, livery);
                 });
             }
             else if (message.getMethodName() == "removePlane")
@@ -674,7 +756,7 @@ namespace XSwiftBus
             else if (message.getMethodName() == "setPlanesPositions")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
-                std::vector<std::string> callsigns;
+                std::vector<int> handles;
                 std::vector<double> latitudes;
                 std::vector<double> longitudes;
                 std::vector<double> altitudes;
@@ -683,7 +765,7 @@ namespace XSwiftBus
                 std::vector<double> headings;
                 std::vector<bool> onGrounds;
                 message.beginArgumentRead();
-                message.getArgument(callsigns);
+                message.getArgument(handles);
                 message.getArgument(latitudes);
                 message.getArgument(longitudes);
                 message.getArgument(altitudes);
@@ -693,13 +775,13 @@ namespace XSwiftBus
                 message.getArgument(onGrounds);
                 queueDBusCall([ = ]()
                 {
-                    setPlanesPositions(callsigns, latitudes, longitudes, altitudes, pitches, rolls, headings, onGrounds);
+                    setPlanesPositions(handles, latitudes, longitudes, altitudes, pitches, rolls, headings, onGrounds);
                 });
             }
             else if (message.getMethodName() == "setPlanesSurfaces")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
-                std::vector<std::string> callsigns;
+                std::vector<int> handles;
                 std::vector<double> gears;
                 std::vector<double> flaps;
                 std::vector<double> spoilers;
@@ -717,7 +799,7 @@ namespace XSwiftBus
                 std::vector<bool> navLights;
                 std::vector<int> lightPatterns;
                 message.beginArgumentRead();
-                message.getArgument(callsigns);
+                message.getArgument(handles);
                 message.getArgument(gears);
                 message.getArgument(flaps);
                 message.getArgument(spoilers);
@@ -736,44 +818,62 @@ namespace XSwiftBus
                 message.getArgument(lightPatterns);
                 queueDBusCall([ = ]()
                 {
-                    setPlanesSurfaces(callsigns, gears, flaps, spoilers, speedBrakes, slats, wingSweeps, thrusts, elevators,
+                    setPlanesSurfaces(handles, gears, flaps, spoilers, speedBrakes, slats, wingSweeps, thrusts, elevators,
                                       rudders, ailerons, landLights, taxiLights, beaconLights, strobeLights, navLights, lightPatterns);
                 });
             }
             else if (message.getMethodName() == "setPlanesTransponders")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
-                std::vector<std::string> callsigns;
+                std::vector<int> handles;
                 std::vector<int> codes;
                 std::vector<bool> modeCs;
                 std::vector<bool> idents;
                 message.beginArgumentRead();
-                message.getArgument(callsigns);
+                message.getArgument(handles);
                 message.getArgument(codes);
                 message.getArgument(modeCs);
                 message.getArgument(idents);
                 queueDBusCall([ = ]()
                 {
-                    setPlanesTransponders(callsigns, codes, modeCs, idents);
+                    setPlanesTransponders(handles, codes, modeCs, idents);
+                });
+            }
+            else if (message.getMethodName() == "openSharedTraffic")
+            {
+                std::string name;
+                message.beginArgumentRead();
+                message.getArgument(name);
+                queueDBusCall([ = ]()
+                {
+                    sendDBusReply(sender, serial, openSharedTraffic(name));
+                });
+            }
+            else if (message.getMethodName() == "closeSharedTraffic")
+            {
+                maybeSendEmptyDBusReply(wantsReply, sender, serial);
+                queueDBusCall([ = ]()
+                {
+                    closeSharedTraffic();
                 });
             }
             else if (message.getMethodName() == "getRemoteAircraftData")
             {
-                std::vector<std::string> requestedCallsigns;
+                std::vector<int> requestedHandles;
                 message.beginArgumentRead();
-                message.getArgument(requestedCallsigns);
+                message.getArgument(requestedHandles);
                 queueDBusCall([ = ]()
                 {
-                    std::vector<std::string> callsigns = requestedCallsigns;
+                    std::vector<int> handles = requestedHandles;
                     std::vector<double> latitudesDeg;
                     std::vector<double> longitudesDeg;
                     std::vector<double> elevationsM;
                     std::vector<bool>   waterFlags;
                     std::vector<double> verticalOffsets;
-                    getRemoteAircraftData(callsigns, latitudesDeg, longitudesDeg, elevationsM, waterFlags, verticalOffsets);
+                    getRemoteAircraftData(handles, latitudesDeg, longitudesDeg, elevationsM, waterFlags, verticalOffsets);
                     CDBusMessage reply = CDBusMessage::createReply(sender, serial);
                     reply.beginArgumentWrite();
-                    reply.appendArgument(callsigns);
+                    reply.appendArgument(handles);
                     reply.appendArgument(latitudesDeg);
                     reply.appendArgument(longitudesDeg);
                     reply.appendArgument(elevationsM);
@@ -830,6 +930,7 @@ namespace XSwiftBus
     int CTraffic::process()
     {
         invokeQueuedDBusCalls();
+        readSharedTraffic();
         doPlaneUpdates();
         setDrawingLabels(getSettings().isDrawingLabels(), getSettings().getLabelColor());
         emitSimFrame();
@@ -19,6 +19,8 @@
 #include "drawable.h"
 #include "menus.h"
 #include "XPMPMultiplayer.h"
+#include "blackmisc/simulation/xplane/planehandleqtfree.h"
+#include "blackmisc/simulation/xplane/sharedtrafficqtfree.h"
 #include <XPLM/XPLMCamera.h>
 #include <XPLM/XPLMDisplay.h>
 #include <functional>
@@ -27,6 +29,7 @@
 //! \cond PRIVATE
 #define XSWIFTBUS_TRAFFIC_INTERFACENAME "org.swift_project.xswiftbus.traffic"
 #define XSWIFTBUS_TRAFFIC_OBJECTPATH "/xswiftbus/traffic"
+#define XSWIFTBUS_TRAFFIC_PROTOCOL_VERSION 1
 //! \endcond
 
 namespace XSwiftBus
@@ -57,6 +60,13 @@ namespace XSwiftBus
             return s;
         }
 
+        //! Version of the traffic interface, increased with each incompatible change of the traffic methods or the shared memory ring
+        //! \remark the driver only connects to the same version, other XSwiftBus versions are fine
+        static constexpr int ProtocolVersion = XSWIFTBUS_TRAFFIC_PROTOCOL_VERSION;
+
+        //! Version of the traffic interface
+        int getProtocolVersion() const { return ProtocolVersion; }
+
         //! Set plane view submenu
         void setPlaneViewMenu(const CMenu &planeViewSubMenu);
 
@@ -87,8 +97,8 @@ namespace XSwiftBus
         //! Set the maximum distance at which to draw aircraft (nautical miles).
         void setMaxDrawDistance(double nauticalMiles);
 
-        //! Introduce a new traffic aircraft
-        void addPlane(const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery);
+        //! Introduce a new traffic aircraft, the handle assigned by the driver keys all per frame updates
+        void addPlane(int handle, const std::string &callsign, const std::string &modelName, const std::string &aircraftIcao, const std::string &airlineIcao, const std::string &livery);
 
         //! Remove a traffic aircraft
         void removePlane(const std::string &callsign);
@@ -97,22 +107,29 @@ namespace XSwiftBus
         void removeAllPlanes();
 
         //! Set the position of multiple traffic aircrafts
-        void setPlanesPositions(const std::vector<std::string> &callsigns,
+        void setPlanesPositions(const std::vector<int> &handles,
                                 std::vector<double> latitudesDeg, std::vector<double> longitudesDeg, std::vector<double> altitudesFt,
                                 std::vector<double> pitchesDeg, std::vector<double> rollsDeg, std::vector<double> headingsDeg, const std::vector<bool> &onGrounds);
 
         //! Set the flight control surfaces and lights of multiple traffic aircrafts
-        void setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
+        void setPlanesSurfaces(const std::vector<int> &handles, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
                                const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
                                const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
                                const std::vector<bool> &landLights, const std::vector<bool> &taxiLights,
                                const std::vector<bool> &beaconLights, const std::vector<bool> &strobeLights, const std::vector<bool> &navLights, const std::vector<int> &lightPatterns);
 
         //! Set the transponder of multiple traffic aircraft
-        void setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
+        void setPlanesTransponders(const std::vector<int> &handles, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
+
+        //! Open the shared memory traffic ring created by the driver, afterwards positions, surfaces and transponders are read from it
+        //! \remark returns false if not supported or the ring cannot be opened (e.g. driver on another machine), then DBus is used
+        bool openSharedTraffic(const std::string &name);
+
+        //! Close the shared memory traffic ring
+        void closeSharedTraffic();
 
-        //! Get remote aircrafts data (lat, lon, elevation and CG)
-        void getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
+        //! Get remote aircrafts data (lat, lon, elevation and CG), handles of unknown planes are removed
+        void getRemoteAircraftData(std::vector<int> &handles, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
                                    std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const;
 
         //! Get the ground elevation at an arbitrary position
@@ -151,6 +168,7 @@ namespace XSwiftBus
         CTerrainProbe m_terrainProbe;
 
         void emitSimFrame();
+        void readSharedTraffic();
         void emitPlaneAdded(const std::string &callsign);
         void emitPlaneAddingFailed(const std::string &callsign);
         void switchToFollowPlaneView(const std::string &callsign);
@@ -169,6 +187,7 @@ namespace XSwiftBus
         struct Plane
         {
             void *id = nullptr;
+            int handle = -1;
             std::string callsign;
             std::string aircraftIcao;
             std::string airlineIcao;
@@ -185,10 +204,22 @@ namespace XSwiftBus
             std::chrono::steady_clock::time_point positionTimes[3];
             XPMPPlanePosition_t positions[4]; // 1 as input for extrapolation, 1 as next input, 1 latest, 1 as output
             XPMPPlaneSurveillance_t surveillance;
-            Plane(void *id_, const std::string &callsign_, const std::string &aircraftIcao_, const std::string &airlineIcao_,
+            Plane(void *id_, int handle_, const std::string &callsign_, const std::string &aircraftIcao_, const std::string &airlineIcao_,
                   const std::string &livery_, const std::string &modelName_);
         };
 
+        //! Apply values to a plane
+        //! @{
+        static void setPlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg);
+        static void setPlaneSurfaces(Plane *plane, double gear, double flaps, double spoilers, double speedBrakes, double slats, double wingSweep, double thrust,
+                                     double elevator, double rudder, double aileron, bool landLights, bool taxiLights, bool beaconLights, bool strobeLights, bool navLights,
+                                     int lightPattern, bool bundleTaxiLandingLights);
+        static void setPlaneTransponder(Plane *plane, int code, bool modeC, bool ident);
+        //! @}
+
+        //! Plane for a handle, nullptr if the handle is unknown or stale
+        Plane *planeByHandle(int handle) const;
+
         //! Label renderer
         class Labels : public CDrawable
         {
@@ -242,6 +273,8 @@ namespace XSwiftBus
         std::unordered_map<std::string, std::string> m_modelStrings; // mapping uppercase to mixedcase
         std::unordered_map<std::string, Plane *> m_planesByCallsign;
         std::unordered_map<void *, Plane *> m_planesById;
+        std::vector<Plane *> m_planesBySlot; // by handle slot, see PlaneHandle
+        BlackMisc::Simulation::XPlane::SharedTraffic::CSharedTrafficRing m_sharedTraffic;
         std::vector<std::string> m_followPlaneViewSequence;
         // std::chrono::system_clock::time_point m_timestampLastSimFrame = std::chrono::system_clock::now();
 
@@ -49,6 +49,8 @@ INCLUDEPATH += ./xplanemp2 ./xplanemp2/include ./xplanemp2/src ./xplanemp2/obj8
 !macx: SOURCES -= xplanemp2/src/AplFSUtil.cpp
 
 unix:!macx {
+    # shm_open for the shared memory traffic
+    LIBS += -lrt
     INCLUDEPATH *= /usr/include/dbus-1.0
     exists (/usr/lib/x86_64-linux-gnu){
     INCLUDEPATH *= /usr/lib/x86_64-linux-gnu/dbus-1.0/include
@@ -4,3 +4,5 @@ SUBDIRS += \
     context \
     fsd \
     testconnectivity \
+    testmatchingcache \
+    testvatsimdatafileclients \
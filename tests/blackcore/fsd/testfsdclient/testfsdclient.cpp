@@ -63,6 +63,7 @@ namespace BlackFsdTest
         void testTextMessage();
         void testRadioMessage();
         void testPilotDataUpdate();
+        void testReceiveFsdData();
         void testAtcDataUpdate();
         void testPong();
         void testClientResponseEmptyType();
@@ -256,6 +257,50 @@ namespace BlackFsdTest
         //        QCOMPARE(arguments.at(12).toBool(), false);
     }
 
+    void CTestFSDClient::testReceiveFsdData()
+    {
+        const auto pilotData = [](const QString &callsign)
+        {
+            return QStringLiteral("@N:%1:1200:1:48.353855:11.786155:110:0:4290769188:1\r\n").arg(callsign).toLatin1();
+        };
+        const auto callsignAt = [](QSignalSpy &spy, int i)
+        {
+            return spy.at(i).at(0).value<CAircraftSituation>().getCallsign().asString();
+        };
+
+        // lines split across received chunks
+        QSignalSpy spy(m_client, &CFSDClient::pilotDataUpdateReceived);
+        const QByteArray line1 = pilotData("ABCD");
+        m_client->receiveFsdData(line1.left(20));
+        QCOMPARE(spy.count(), 0);
+        const QByteArray line3 = pilotData("IJKL");
+        m_client->receiveFsdData(line1.mid(20) + pilotData("EFGH") + line3.left(10));
+        QCOMPARE(spy.count(), 2);
+        m_client->receiveFsdData(line3.mid(10));
+        QCOMPARE(spy.count(), 3);
+        QCOMPARE(callsignAt(spy, 0), QStringLiteral("ABCD"));
+        QCOMPARE(callsignAt(spy, 1), QStringLiteral("EFGH"));
+        QCOMPARE(callsignAt(spy, 2), QStringLiteral("IJKL"));
+        spy.clear();
+
+        // a handler receiving data while a line is parsed changes the buffer
+        bool received = false;
+        connect(m_client, &CFSDClient::pilotDataUpdateReceived, this, [&]
+        {
+            if (received) { return; }
+            received = true;
+            QByteArray more;
+            for (int i = 0; i < 20; ++i) { more += pilotData(QStringLiteral("XY%1").arg(i)); }
+            m_client->receiveFsdData(more);
+        });
+        m_client->receiveFsdData(pilotData("MNOP") + pilotData("QRST"));
+        QCOMPARE(spy.count(), 22);
+        QCOMPARE(callsignAt(spy, 0), QStringLiteral("MNOP"));
+        QCOMPARE(callsignAt(spy, 1), QStringLiteral("QRST"));
+        QCOMPARE(callsignAt(spy, 2), QStringLiteral("XY0"));
+        QCOMPARE(callsignAt(spy, 21), QStringLiteral("XY19"));
+    }
+
     void CTestFSDClient::testAtcDataUpdate()
     {
         QSignalSpy spy(m_client, &CFSDClient::atcDataUpdateReceived);
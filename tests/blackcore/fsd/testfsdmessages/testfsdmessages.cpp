@@ -33,11 +33,15 @@
 #include "blackcore/fsd/clientquery.h"
 #include "blackcore/fsd/clientresponse.h"
 #include "blackcore/fsd/flightplan.h"
+#include "blackcore/fsd/fsdcapture.h"
+#include "blackcore/fsd/fsdline.h"
 #include "blackcore/fsd/fsdidentification.h"
 #include "blackcore/fsd/serializer.h"
 #include "blackcore/fsd/servererror.h"
 #include "blackcore/fsd/interimpilotdataupdate.h"
 #include "blackcore/fsd/visualpilotdataupdate.h"
+#include "blackcore/fsd/visualpilotdataperiodic.h"
+#include "blackcore/fsd/visualpilotdatastopped.h"
 #include "blackcore/fsd/visualpilotdatatoggle.h"
 #include "blackcore/fsd/planeinforequest.h"
 #include "blackcore/fsd/planeinformation.h"
@@ -47,6 +51,7 @@
 #include "test.h"
 
 #include <QObject>
+#include <QTemporaryDir>
 #include <QTest>
 
 using namespace BlackMisc::Aviation;
@@ -82,6 +87,9 @@ namespace BlackMiscTest
         void testEuroscopeSimData();
         void testFlightPlan();
         void testFSDIdentification();
+        void testFsdLine();
+        void testFsdLineMessages();
+        void testFsdCapture();
         void testInterimPilotDataUpdate();
         void testKillRequest();
         void testPBH();
@@ -708,6 +716,122 @@ namespace BlackMiscTest
     {
 
     }
+
+    void CTestFsdMessages::testFsdLine()
+    {
+        const QByteArray pilotLine("@N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8\r\n");
+        const FsdLine pilot(pilotLine);
+        QCOMPARE(pilot.messageType(), MessageType::PilotDataUpdate);
+        QCOMPARE(pilot.tokenCount(), 10);
+        QCOMPARE(pilot.token(0), QLatin1String("N"));
+        QCOMPARE(pilot.token(9), QLatin1String("8"));
+        QCOMPARE(pilot.token(10), QLatin1String());
+        QCOMPARE(pilot.tokenToQString(1), QString("ABCD"));
+        QCOMPARE(pilot.tokenToInt(6), 12000);
+        QCOMPARE(pilot.tokenToUInt(8), 25132146u);
+        QCOMPARE(pilot.tokenToDouble(4), 43.12578);
+        QCOMPARE(pilot.tokenToDouble(5), -72.15841);
+        QCOMPARE(pilot.toQString(nullptr), QString("@N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8"));
+
+        // same tokens as the former split based tokenization, including empty ones
+        const QByteArray responseLine("  $CRDLH123:BER721:RN:Jon Doe::1  \r\n");
+        const FsdLine response(responseLine);
+        QCOMPARE(response.messageType(), MessageType::ClientResponse);
+        QCOMPARE(response.toTokens(nullptr), QString("DLH123:BER721:RN:Jon Doe::1").split(':'));
+
+        // PDU detection
+        int pduLength = 0;
+        QCOMPARE(FsdLine::detectMessageType("#AA", 3, pduLength), MessageType::AddAtc);
+        QCOMPARE(FsdLine::detectMessageType("#SLABCD", 7, pduLength), MessageType::VisualPilotDataPeriodic);
+        QCOMPARE(FsdLine::detectMessageType("$!!SERVER", 9, pduLength), MessageType::KillRequest);
+        QCOMPARE(pduLength, 3);
+        QCOMPARE(FsdLine::detectMessageType("SIMDATA:ABCD", 12, pduLength), MessageType::EuroscopeSimData);
+        QCOMPARE(pduLength, 7);
+        QCOMPARE(FsdLine::detectMessageType("!RABCD", 6, pduLength), MessageType::RegistrationInfo);
+        QCOMPARE(FsdLine::detectMessageType("$Q", 2, pduLength), MessageType::Unknown);
+        QCOMPARE(FsdLine::detectMessageType("SIMDAT", 6, pduLength), MessageType::Unknown);
+        QCOMPARE(FsdLine::detectMessageType("", 0, pduLength), MessageType::Unknown);
+        QVERIFY(!FsdLine(QByteArray("@   \r\n")).hasPayload());
+        QVERIFY(!FsdLine(QByteArray("XYZ:ABC")).isKnownMessageType());
+
+        // numbers, same as QString conversion
+        const QStringList numbers({ "0", "-0.5", "+3.25", "1e3", "12.", ".5", "abc", "", "123456789012345678", "-0.0000001", "4294967295", "4294967296", "-1" });
+        for (const QString &n : numbers)
+        {
+            const QByteArray b = n.toLatin1();
+            QCOMPARE(FsdLine::parseDouble(b.constData(), b.size()), n.toDouble());
+            bool ok1 = false;
+            bool ok2 = false;
+            QCOMPARE(FsdLine::parseInteger(b.constData(), b.size(), &ok1), n.toLongLong(&ok2));
+            QCOMPARE(ok1, ok2);
+        }
+    }
+
+    void CTestFsdMessages::testFsdLineMessages()
+    {
+        const QString pilot("N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8");
+        const PilotDataUpdate pilotFromStrings = PilotDataUpdate::fromTokens(pilot.split(':'));
+        const QByteArray pilotLine = "@" + pilot.toLatin1();
+        const PilotDataUpdate pilotFromLine = PilotDataUpdate::fromTokens(FsdLine(pilotLine));
+        QCOMPARE(pilotFromLine, pilotFromStrings);
+
+        const QString visual("ABCD:43.1257891:-72.1584142:12000.12:1404.00:25132144:-1.0001:2.0001:3.0001:-0.0349:0.0175:0.0524:0.00");
+        const QByteArray visualLine = "^" + visual.toLatin1();
+        const VisualPilotDataUpdate visualFromStrings = VisualPilotDataUpdate::fromTokens(visual.split(':'));
+        const VisualPilotDataUpdate visualFromLine = VisualPilotDataUpdate::fromTokens(FsdLine(visualLine));
+        QCOMPARE(visualFromLine.sender(), visualFromStrings.sender());
+        QCOMPARE(visualFromLine.m_latitude, visualFromStrings.m_latitude);
+        QCOMPARE(visualFromLine.m_longitude, visualFromStrings.m_longitude);
+        QCOMPARE(visualFromLine.m_altitudeTrue, visualFromStrings.m_altitudeTrue);
+        QCOMPARE(visualFromLine.m_heading, visualFromStrings.m_heading);
+        QCOMPARE(visualFromLine.m_headingRadPerSec, visualFromStrings.m_headingRadPerSec);
+        QCOMPARE(visualFromLine.m_noseGearAngle, visualFromStrings.m_noseGearAngle);
+
+        const QByteArray periodicLine = "#SL" + visual.toLatin1();
+        const VisualPilotDataPeriodic periodic = VisualPilotDataPeriodic::fromTokens(FsdLine(periodicLine));
+        QCOMPARE(periodic.m_bankRadPerSec, visualFromStrings.m_bankRadPerSec);
+
+        const QByteArray stoppedLine = "#ST" + visual.toLatin1();
+        const VisualPilotDataStopped stopped = VisualPilotDataStopped::fromTokens(FsdLine(stoppedLine));
+        QCOMPARE(stopped.m_altitudeTrue, visualFromStrings.m_altitudeTrue);
+    }
+
+    void CTestFsdMessages::testFsdCapture()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath("capture.fsd");
+
+        const QList<QByteArray> lines =
+        {
+            "@N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8\r\n",
+            "#TMABCD:@94835:Hello \xe4\r\n",
+            "$DIserver:client:some random string\r\n"
+        };
+
+        CFsdCaptureWriter writer;
+        QVERIFY(writer.open(fileName, "ISO-8859-1"));
+        for (const QByteArray &line : lines) { writer.writeLine(line); }
+        writer.writeLine("\r\n"); // empty lines are skipped
+        QCOMPARE(writer.getLinesWritten(), lines.size());
+        writer.close();
+
+        CFsdCaptureReader reader;
+        QVERIFY(reader.open(fileName));
+        QCOMPARE(reader.getCodecName(), QByteArray("ISO-8859-1"));
+        QVERIFY(reader.getCaptureStartMsSinceEpoch() > 0);
+
+        qint64 lastOffsetMs = 0;
+        for (const QByteArray &line : lines)
+        {
+            QVERIFY(!reader.atEnd());
+            QVERIFY(reader.nextOffsetMs() >= lastOffsetMs);
+            lastOffsetMs = reader.nextOffsetMs();
+            QCOMPARE(reader.takeNextLine(), line);
+        }
+        QVERIFY(reader.atEnd());
+        QCOMPARE(reader.nextOffsetMs(), static_cast<qint64>(-1));
+    }
 }
 
 //! main
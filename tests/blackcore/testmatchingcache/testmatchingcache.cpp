@@ -0,0 +1,156 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/matchingcache.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "test.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc::Simulation;
+using namespace BlackCore;
+
+namespace BlackCoreTest
+{
+    //! Matching cache tests
+    class CTestMatchingCache : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Least recently used results are evicted
+        void lruEviction();
+
+        //! Results of another revision are not returned
+        void revisionKeys();
+
+        //! Model set revision changes with the model strings and DB keys
+        void modelSetRevision();
+
+        //! Save and load
+        void saveAndLoad();
+
+    private:
+        //! Key for a model string
+        static QString key(const QString &modelString, const QString &revision = QStringLiteral("1"));
+
+        //! Model with model string
+        static CAircraftModel model(const QString &modelString);
+    };
+
+    void CTestMatchingCache::lruEviction()
+    {
+        CMatchingCache cache(3);
+        cache.insert(CMatchingCache::ModelMatching, key("A"), model("A"));
+        cache.insert(CMatchingCache::ModelMatching, key("B"), model("B"));
+        cache.insert(CMatchingCache::ModelMatching, key("C"), model("C"));
+        QCOMPARE(cache.getEntryCount(CMatchingCache::ModelMatching), 3);
+
+        // A used, so B is the least recently used
+        CAircraftModel found;
+        QVERIFY(cache.lookup(CMatchingCache::ModelMatching, key("A"), found));
+        QCOMPARE(found.getModelString(), QStringLiteral("A"));
+        cache.insert(CMatchingCache::ModelMatching, key("D"), model("D"));
+        QCOMPARE(cache.getEntryCount(CMatchingCache::ModelMatching), 3);
+        QVERIFY(!cache.lookup(CMatchingCache::ModelMatching, key("B"), found));
+        QVERIFY(cache.lookup(CMatchingCache::ModelMatching, key("A"), found));
+        QVERIFY(cache.lookup(CMatchingCache::ModelMatching, key("C"), found));
+        QVERIFY(cache.lookup(CMatchingCache::ModelMatching, key("D"), found));
+
+        // types are separate
+        QCOMPARE(cache.getEntryCount(CMatchingCache::ReverseLookup), 0);
+        QVERIFY(!cache.lookup(CMatchingCache::ReverseLookup, key("A"), found));
+        QCOMPARE(cache.getHits(CMatchingCache::ModelMatching), 4);
+        QCOMPARE(cache.getMisses(CMatchingCache::ModelMatching), 1);
+        QCOMPARE(cache.getMisses(CMatchingCache::ReverseLookup), 1);
+    }
+
+    void CTestMatchingCache::revisionKeys()
+    {
+        CMatchingCache cache;
+        QCOMPARE(key("a320 dlh"), key(" A320 DLH "));
+        QVERIFY(key("A320", "1") != key("A320", "2"));
+
+        cache.insert(CMatchingCache::ReverseLookup, key("A320", "1"), model("A320"));
+        CAircraftModel found;
+        QVERIFY(!cache.lookup(CMatchingCache::ReverseLookup, key("A320", "2"), found));
+        QVERIFY(cache.lookup(CMatchingCache::ReverseLookup, key("A320", "1"), found));
+
+        // empty keys are not cached
+        cache.insert(CMatchingCache::ReverseLookup, QString(), model("B738"));
+        QCOMPARE(cache.getEntryCount(CMatchingCache::ReverseLookup), 1);
+    }
+
+    void CTestMatchingCache::modelSetRevision()
+    {
+        const CAircraftModelList modelSet({ model("A320"), model("B738") });
+        const QString revision = CMatchingCache::modelSetRevision(modelSet);
+        QCOMPARE(CMatchingCache::modelSetRevision(CAircraftModelList({ model("A320"), model("B738") })), revision);
+
+        // renamed model, same size
+        QVERIFY(CMatchingCache::modelSetRevision(CAircraftModelList({ model("A320"), model("B739") })) != revision);
+
+        // re-assigned DB key, same model strings
+        CAircraftModelList reassigned(modelSet);
+        reassigned.front().setDbKey(4711);
+        QVERIFY(CMatchingCache::modelSetRevision(reassigned) != revision);
+    }
+
+    void CTestMatchingCache::saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("matchingcache.json");
+
+        CMatchingCache cache;
+        QVERIFY(!cache.hasChanges());
+        cache.insert(CMatchingCache::ReverseLookup, key("A320"), model("A320"));
+        cache.insert(CMatchingCache::ModelMatching, key("B738"), model("B738"));
+        cache.insert(CMatchingCache::ModelMatching, key("B744"), model("B744"));
+        QVERIFY(cache.hasChanges());
+        QVERIFY(cache.saveToFile(file));
+        QVERIFY(!cache.hasChanges());
+
+        CMatchingCache loaded;
+        QVERIFY(loaded.loadFromFile(file));
+        QVERIFY(!loaded.hasChanges());
+        QCOMPARE(loaded.getEntryCount(CMatchingCache::ReverseLookup), 1);
+        QCOMPARE(loaded.getEntryCount(CMatchingCache::ModelMatching), 2);
+
+        CAircraftModel found;
+        QVERIFY(loaded.lookup(CMatchingCache::ModelMatching, key("B744"), found));
+        QCOMPARE(found.getModelString(), QStringLiteral("B744"));
+        QVERIFY(!loaded.lookup(CMatchingCache::ReverseLookup, key("B744"), found));
+
+        QVERIFY(!loaded.loadFromFile(dir.filePath("missing.json")));
+    }
+
+    QString CTestMatchingCache::key(const QString &modelString, const QString &revision)
+    {
+        return CMatchingCache::cacheKey(QStringLiteral("A320"), QStringLiteral("DLH"), {}, modelString, revision);
+    }
+
+    CAircraftModel CTestMatchingCache::model(const QString &modelString)
+    {
+        return CAircraftModel(modelString, CAircraftModel::TypeModelMatching);
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestMatchingCache);
+
+#include "testmatchingcache.moc"
+
+//! \endcond
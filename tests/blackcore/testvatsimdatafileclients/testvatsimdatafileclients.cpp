@@ -0,0 +1,161 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/vatsim/vatsimdatafileclients.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore::Vatsim;
+
+namespace BlackCoreTest
+{
+    //! VATSIM data file pilots and controllers compared with the previous file
+    class CTestVatsimDataFileClients : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Pilots added, changed and removed
+        void pilotChanges();
+
+        //! Controllers added, changed and removed
+        void controllerChanges();
+
+        //! Live fields and last_updated are no changes
+        void liveFieldsIgnored();
+
+    private:
+        //! Pilot as in the data file
+        static QJsonObject pilot(const QString &callsign, const QString &name, const QString &remarks, double latitude = 48.0);
+
+        //! Controller as in the data file
+        static QJsonObject controller(const QString &callsign, const QString &frequency, const QString &atis);
+
+        //! Parse a file
+        static CVatsimDataFileClients::Changes parseFile(CVatsimDataFileClients &clients, const QList<QJsonObject> &pilots, const QList<QJsonObject> &controllers);
+    };
+
+    void CTestVatsimDataFileClients::pilotChanges()
+    {
+        CVatsimDataFileClients clients;
+        CVatsimDataFileClients::Changes changes = parseFile(clients, { pilot("DLH1", "Joe", "/V/"), pilot("DLH2", "Jane", "/V/") }, {});
+        QCOMPARE(changes.addedAircraft.size(), 2);
+        QVERIFY(changes.changedAircraft.isEmpty());
+        QVERIFY(changes.removedAircraft.isEmpty());
+        QCOMPARE(changes.changedRemarks.size(), 2);
+        QCOMPARE(clients.getAircraft().size(), 2);
+
+        // DLH1 changed name, DLH2 removed, DLH3 added
+        changes = parseFile(clients, { pilot("DLH1", "Joe Doe", "/V/"), pilot("DLH3", "Jim", "/T/") }, {});
+        QCOMPARE(changes.addedAircraft.size(), 1);
+        QCOMPARE(changes.addedAircraft.front().getCallsign(), CCallsign("DLH3"));
+        QCOMPARE(changes.changedAircraft.size(), 1);
+        QCOMPARE(changes.changedAircraft.front().getPilot().getRealName(), QStringLiteral("Joe Doe"));
+        QCOMPARE(changes.removedAircraft, CCallsignSet({ "DLH2" }));
+        QCOMPARE(changes.changedRemarks, CCallsignSet({ "DLH2", "DLH3" })); // DLH1 remarks unchanged
+        QVERIFY(changes.hasPilotChanges());
+        QVERIFY(!changes.hasControllerChanges());
+        QCOMPARE(clients.getAircraft().size(), 2);
+        QCOMPARE(clients.getFlightPlanRemarks().value(CCallsign("DLH3")).getRemarks(), QStringLiteral("/T/"));
+
+        // changed remarks
+        changes = parseFile(clients, { pilot("DLH1", "Joe Doe", "/T/"), pilot("DLH3", "Jim", "/T/") }, {});
+        QCOMPARE(changes.changedAircraft.size(), 1);
+        QCOMPARE(changes.changedRemarks, CCallsignSet({ "DLH1" }));
+    }
+
+    void CTestVatsimDataFileClients::controllerChanges()
+    {
+        CVatsimDataFileClients clients;
+        CVatsimDataFileClients::Changes changes = parseFile(clients, {}, { controller("EDDM_TWR", "118700", "Info A"), controller("EDDF_TWR", "119900", "Info B") });
+        QCOMPARE(changes.addedStations.size(), 2);
+        QVERIFY(!changes.hasPilotChanges());
+
+        // same data, only last_updated changed
+        QJsonObject eddm = controller("EDDM_TWR", "118700", "Info A");
+        eddm["last_updated"] = QStringLiteral("2023-01-01T12:05:00Z");
+        changes = parseFile(clients, {}, { eddm, controller("EDDF_TWR", "119900", "Info B") });
+        QVERIFY(!changes.hasControllerChanges());
+
+        // ATIS changed, EDDF removed, EDDK added
+        changes = parseFile(clients, {}, { controller("EDDM_TWR", "118700", "Info C"), controller("EDDK_TWR", "124970", "") });
+        QCOMPARE(changes.addedStations.size(), 1);
+        QCOMPARE(changes.changedStations.size(), 1);
+        QCOMPARE(changes.changedStations.front().getAtis().getMessage(), QStringLiteral("Info C"));
+        QCOMPARE(changes.removedStations, CCallsignSet({ "EDDF_TWR" }));
+        QCOMPARE(clients.getAtcStations().size(), 2);
+    }
+
+    void CTestVatsimDataFileClients::liveFieldsIgnored()
+    {
+        CVatsimDataFileClients clients;
+        parseFile(clients, { pilot("DLH1", "Joe", "/V/", 48.0) }, {});
+
+        // moved, new transponder code and last_updated, no change for the consumers
+        QJsonObject moved = pilot("DLH1", "Joe", "/V/", 49.0);
+        moved["transponder"] = QStringLiteral("7000");
+        moved["last_updated"] = QStringLiteral("2023-01-01T12:05:00Z");
+        QVERIFY(CVatsimDataFileClients::isSamePilotData(pilot("DLH1", "Joe", "/V/", 48.0), moved));
+        const CVatsimDataFileClients::Changes changes = parseFile(clients, { moved }, {});
+        QVERIFY(!changes.hasPilotChanges());
+        QVERIFY(changes.changedRemarks.isEmpty());
+
+        // but the kept aircraft has the latest position
+        const CSimulatedAircraft aircraft = clients.getAircraft().findFirstByCallsign(CCallsign("DLH1"));
+        QCOMPARE(aircraft.getPilot().getRealName(), QStringLiteral("Joe"));
+        QVERIFY(qAbs(aircraft.latitude().value(CAngleUnit::deg()) - 49.0) < 1e-6);
+        QCOMPARE(aircraft.getTransponderCode(), 7000);
+    }
+
+    QJsonObject CTestVatsimDataFileClients::pilot(const QString &callsign, const QString &name, const QString &remarks, double latitude)
+    {
+        return QJsonObject
+        {
+            { "cid", 1000000 }, { "name", name }, { "callsign", callsign },
+            { "latitude", latitude }, { "longitude", 11.0 }, { "altitude", 10000 }, { "groundspeed", 250 }, { "heading", 90 },
+            { "transponder", "2000" }, { "last_updated", "2023-01-01T12:00:00Z" },
+            { "flight_plan", QJsonObject { { "aircraft", "A320/M-SDE2E3FGHIJ1RWXY/LB1" }, { "remarks", remarks } } }
+        };
+    }
+
+    QJsonObject CTestVatsimDataFileClients::controller(const QString &callsign, const QString &frequency, const QString &atis)
+    {
+        return QJsonObject
+        {
+            { "cid", 1000001 }, { "name", "Controller" }, { "callsign", callsign }, { "frequency", frequency }, { "visual_range", 50 },
+            { "text_atis", QJsonArray { atis } }, { "last_updated", "2023-01-01T12:00:00Z" }
+        };
+    }
+
+    CVatsimDataFileClients::Changes CTestVatsimDataFileClients::parseFile(CVatsimDataFileClients &clients, const QList<QJsonObject> &pilots, const QList<QJsonObject> &controllers)
+    {
+        QStringList illegalEquipmentCodes;
+        clients.beginFile();
+        for (const QJsonObject &p : pilots) { clients.insertPilot(p, illegalEquipmentCodes); }
+        for (const QJsonObject &c : controllers) { clients.insertController(c); }
+        return clients.endFile();
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestVatsimDataFileClients);
+
+#include "testvatsimdatafileclients.moc"
+
+//! \endcond
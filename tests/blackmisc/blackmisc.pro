@@ -11,6 +11,7 @@ SUBDIRS += \
     testcontainers \
     testdatastream \
     testdbus \
+    testfileindex \
     testicon \
     testidentifier \
     testlibrarypath \
@@ -11,12 +11,15 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
 #include "blackmisc/geo/earthangle.h"
+#include "blackmisc/geo/elevationtilecache.h"
 #include "blackmisc/geo/latitude.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/pq/units.h"
 #include "test.h"
 
+#include <QTemporaryDir>
 #include <QTest>
 
 using namespace BlackMisc::Geo;
@@ -36,6 +39,12 @@ namespace BlackMiscTest
 
         //! CCoordinateGeodetic unit tests
         void coordinateGeodetic();
+
+        //! CGeoSpatialIndex against the linear search
+        void spatialIndex();
+
+        //! CElevationTileCache lookups and eviction
+        void elevationTileCache();
     };
 
     void CTestGeo::geoBasics()
@@ -79,6 +88,92 @@ namespace BlackMiscTest
         latValue = testCoordinate.latitude().value(CAngleUnit::deg());
         QCOMPARE(latValue, newLat.value(CAngleUnit::deg()));
     }
+
+    void CTestGeo::spatialIndex()
+    {
+        CCoordinateGeodeticList coordinates;
+        for (int lat = -10; lat <= 10; lat++)
+        {
+            for (int lng = -10; lng <= 10; lng++) { coordinates.push_back(CCoordinateGeodetic(lat, lng)); }
+        }
+
+        CGeoSpatialIndex index = coordinates.createSpatialIndex();
+        QCOMPARE(index.size(), coordinates.sizeInt());
+        QVERIFY(coordinates.hasSameCoordinatesAsSpatialIndex(index));
+
+        const CCoordinateGeodetic reference(0.3, 0.4);
+        const CLength range(250, CLengthUnit::km());
+        QCOMPARE(coordinates.findWithinRange(index, reference, range), coordinates.findWithinRange(reference, range));
+        QCOMPARE(coordinates.findClosest(index, 5, reference), coordinates.findClosest(5, reference));
+        QVERIFY2(coordinates.findClosestWithinRange(index, reference, CLength(10, CLengthUnit::km())).isNull(), "Nothing within 10km");
+        QCOMPARE(coordinates.findClosestWithinRange(index, reference, CLength(100, CLengthUnit::km())), CCoordinateGeodetic(0, 0));
+
+        // appended and removed coordinates
+        const CCoordinateGeodetic appended(0.31, 0.41);
+        coordinates.push_back(appended);
+        index.append(appended);
+        QCOMPARE(coordinates.findClosestWithinRange(index, reference, range), appended);
+        QVERIFY(index.remove(index.count() - 1));
+        QCOMPARE(coordinates.findClosestWithinRange(index, reference, range), CCoordinateGeodetic(0, 0));
+
+        // moved coordinate, same count, only detected by the explicit check
+        CCoordinateGeodeticList moved(coordinates);
+        moved.front() = CCoordinateGeodetic(5.5, 5.5);
+        QVERIFY(!moved.hasSameCoordinatesAsSpatialIndex(index));
+        QVERIFY(coordinates.hasSameCoordinatesAsSpatialIndex(index));
+
+        // index not updated, falls back to the linear search, which also finds the coordinate removed from the index
+        coordinates.push_back(CCoordinateGeodetic(0.32, 0.42));
+        QVERIFY(!coordinates.hasSameCoordinatesAsSpatialIndex(index));
+        QCOMPARE(coordinates.findClosestWithinRange(index, reference, range), appended);
+        QCOMPARE(coordinates.findWithinRange(index, reference, range), coordinates.findWithinRange(reference, range));
+    }
+
+    void CTestGeo::elevationTileCache()
+    {
+        CElevationTileCache cache;
+        for (int lat = -10; lat <= 10; lat++)
+        {
+            for (int lng = -10; lng <= 10; lng++) { cache.insert(CCoordinateGeodetic(lat, lng, 100), lat >= 0, 1000); }
+        }
+        QCOMPARE(cache.size(), 441);
+        QCOMPARE(cache.sizeOnGround(), 231);
+        QCOMPARE(cache.getTileCount(), 441);
+
+        const CCoordinateGeodetic reference(0.3, 0.4, 0);
+        const CLength range(250, CLengthUnit::km());
+        const CCoordinateGeodeticList all = cache.toList(false);
+        QCOMPARE(cache.findWithinRange(reference, range, false).sizeInt(), all.findWithinRange(reference, range).sizeInt());
+        QVERIFY2(cache.findClosestWithinRange(reference, CLength(10, CLengthUnit::km())).isNull(), "Nothing within 10km");
+
+        CElevationTileCache::Key key;
+        const CCoordinateGeodetic closest = cache.findClosestWithinRange(reference, CLength(100, CLengthUnit::km()), &key);
+        QCOMPARE(closest, CCoordinateGeodetic(0, 0, 100));
+        QVERIFY(cache.isOnGround(key));
+
+        // the recently used elevation is kept
+        cache.touch(key, 2000);
+        QCOMPARE(cache.evict(0, 1), 440);
+        QCOMPARE(cache.findClosestWithinRange(reference, range), closest);
+
+        // across the antimeridian
+        cache.insert(CCoordinateGeodetic(0, 179.99, 5), true, 3000);
+        QCOMPARE(cache.findWithinRange(CCoordinateGeodetic(0, -179.99, 0), CLength(5, CLengthUnit::km()), true).sizeInt(), 1);
+        QCOMPARE(cache.removeOutsideRange(reference, range, true), 1);
+        QCOMPARE(cache.size(), 1);
+
+        // on ground elevations used at least twice are written, the hits are halved when read
+        cache.touch(key, 4000);
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("elevations.bin");
+        QVERIFY(cache.writeToFile(file, 2));
+        CElevationTileCache read;
+        QCOMPARE(read.readFromFile(file), 1);
+        QVERIFY(read.writeToFile(file, 2));
+        CElevationTileCache decayed;
+        QCOMPARE(decayed.readFromFile(file), 0);
+    }
 } // ns
 
 //! main
@@ -1,6 +1,9 @@
 TEMPLATE = subdirs
 SUBDIRS += \
+    testaircraftmodelsetindex \
     testinterpolatorlinear \
     testinterpolatormisc \
     testinterpolatorparts \
+    testinterpolatorspline \
+    testremoteaircraftprovider \
     testxplane \
@@ -0,0 +1,297 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "blackmisc/country.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! The finders of CAircraftModelSetView return the same models as those of CAircraftModelList
+    class CTestAircraftModelSetIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Model string lookup
+        void findByModelString();
+
+        //! ICAO code finders
+        void findByIcaoCodes();
+
+        //! Aircraft type finders
+        void findByAircraftType();
+
+        //! Livery, distributor and flags
+        void findByLiveryDistributorAndFlags();
+
+        //! Airline names and telephony designators
+        void findByAirlineNamesOrTelephonyDesignator();
+
+        //! Removals
+        void removals();
+
+        //! Views on a subset use the same order as the list
+        void subsetViews();
+
+    private:
+        //! Same models in the same order
+        static void compare(const CAircraftModelSetView &view, const CAircraftModelList &models);
+
+        //! Test set
+        static CAircraftModelList models();
+
+        //! Model with codes
+        static CAircraftModel model(const QString &modelString, int dbKey, const CAircraftIcaoCode &aircraft, const CAirlineIcaoCode &airline, const QString &livery = {});
+
+        //! Aircraft ICAO code
+        static CAircraftIcaoCode aircraft(const QString &designator, const QString &combinedType, const QString &manufacturer, const QString &family = {}, bool military = false);
+
+        //! Airline ICAO code
+        static CAirlineIcaoCode airline(const QString &designator, const QString &name, const QString &telephony, int groupId = -1);
+    };
+
+    void CTestAircraftModelSetIndex::findByModelString()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+        QCOMPARE(view.size(), list.size());
+
+        for (const QString &modelString : { "DLH A320", "dlh a320", "LH321", "lh321", "H60", "", "NONE" })
+        {
+            QCOMPARE(view.findFirstByModelStringAliasOrDefault(modelString).getModelString(), list.findFirstByModelStringAliasOrDefault(modelString).getModelString());
+            QCOMPARE(view.findFirstByModelStringAliasOrDefault(modelString, Qt::CaseSensitive).getModelString(), list.findFirstByModelStringAliasOrDefault(modelString, Qt::CaseSensitive).getModelString());
+        }
+    }
+
+    void CTestAircraftModelSetIndex::findByIcaoCodes()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        for (const QString &aircraftDesignator : { "A320", "B738", "C172", "" })
+        {
+            for (const QString &airlineDesignator : { "DLH", "BAW", "EIN", "" })
+            {
+                const CAircraftIcaoCode aircraftIcao(aircraftDesignator);
+                const CAirlineIcaoCode airlineIcao(airlineDesignator);
+                compare(view.findByIcaoDesignators(aircraftIcao, airlineIcao), list.findByIcaoDesignators(aircraftIcao, airlineIcao));
+            }
+            for (const QString &combinedCode : { "DLH", "dlh", "_CC_WHITE_WHITE", "" })
+            {
+                compare(view.findByAircraftDesignatorAndLiveryCombinedCode(aircraftDesignator, combinedCode), list.findByAircraftDesignatorAndLiveryCombinedCode(aircraftDesignator, combinedCode));
+            }
+        }
+
+        for (int groupId : { 1, 2, 3, -1 })
+        {
+            CAirlineIcaoCode group("XXX");
+            group.setGroupId(groupId);
+            compare(view.findByAirlineGroup(group), list.findByAirlineGroup(group));
+        }
+    }
+
+    void CTestAircraftModelSetIndex::findByAircraftType()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        for (const QString &family : { "A320", "a320", "B737", "" })
+        {
+            compare(view.findByFamily(family), list.findByFamily(family));
+        }
+        for (const QString &combinedType : { "L2J", "l2j", "L1P", "H2T", "L*J", "L-J", "*2*", "L2", "" })
+        {
+            compare(view.findByCombinedType(combinedType), list.findByCombinedType(combinedType));
+            compare(view.findByCombinedTypeWithColorLivery(combinedType), list.findByCombinedTypeWithColorLivery(combinedType));
+        }
+        for (const QString &manufacturer : { "AIRBUS", "airbus", "BOEING", "" })
+        {
+            compare(view.findByManufacturer(manufacturer), list.findByManufacturer(manufacturer));
+        }
+        for (const CAircraftIcaoCode &icao : { aircraft("A320", "L2J", "AIRBUS"), aircraft("B738", "L2J", ""), aircraft("C172", "", "CESSNA"), aircraft("H60", "H2T", "BOEING") })
+        {
+            compare(view.findByCombinedAndManufacturer(icao), list.findByCombinedAndManufacturer(icao));
+        }
+    }
+
+    void CTestAircraftModelSetIndex::findByLiveryDistributorAndFlags()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        for (const QString &combinedCode : { "DLH", "BAW", "_CC_WHITE_WHITE", "" })
+        {
+            const CLivery livery(combinedCode, CAirlineIcaoCode(), "");
+            compare(view.findByLiveryCode(livery), list.findByLiveryCode(livery));
+        }
+        for (const QString &distributor : { "FSC", "XCSL", "" })
+        {
+            compare(view.findByDistributor(CDistributor(distributor)), list.findByDistributor(CDistributor(distributor)));
+        }
+        for (bool flag : { true, false })
+        {
+            compare(view.findByMilitaryFlag(flag), list.findByMilitaryFlag(flag));
+            compare(view.findByVtolFlag(flag), list.findByVtolFlag(flag));
+        }
+        QCOMPARE(view.containsVtol(), list.containsVtol());
+        QCOMPARE(view.findByVtolFlag(false).containsVtol(), list.findByVtolFlag(false).containsVtol());
+    }
+
+    void CTestAircraftModelSetIndex::findByAirlineNamesOrTelephonyDesignator()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView view(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        // ETIHAD has no DB key, empty names are contained in all names
+        for (const QString &name : { "Lufthansa", "lufthansa", "hansa", "SPEEDBIRD", "speed", "British Airways", "AerLingus", "Aer Lingus", " aer ", "SHAMROCK", "ETIHAD", "Er", "a", "", " ", "NONE" })
+        {
+            compare(view.findByAirlineNamesOrTelephonyDesignator(name), list.findByAirlineNamesOrTelephonyDesignator(name));
+        }
+    }
+
+    void CTestAircraftModelSetIndex::removals()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView all(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        CAircraftModelSetView view(all);
+        CAircraftModelList models(list);
+        QCOMPARE(view.removeAllWithoutModelString(), models.removeAllWithoutModelString());
+        compare(view, models);
+        QCOMPARE(view.removeIfExcluded(), models.removeIfExcluded());
+        compare(view, models);
+        QCOMPARE(view.removeObjectsWithoutDbKey(), models.removeObjectsWithoutDbKey());
+        compare(view, models);
+        QCOMPARE(view.removeObjectsWithoutDbKey(), 0);
+
+        // the view is a copy, the whole set is unchanged
+        QCOMPARE(all.size(), list.size());
+    }
+
+    void CTestAircraftModelSetIndex::subsetViews()
+    {
+        const CAircraftModelList list = models();
+        const CAircraftModelSetView all(QSharedPointer<const CAircraftModelSetIndex>::create(list));
+
+        // reversed order, so the view order and the set order differ
+        CAircraftModelList reversed = list.findByMilitaryFlag(false);
+        std::reverse(reversed.begin(), reversed.end());
+        const CAircraftModelSetView view = all.withModels(reversed);
+        compare(view, reversed.findBy([](const CAircraftModel &model) { return model.hasModelString(); }));
+        reversed = view.toModelList();
+
+        compare(view.findByIcaoDesignators(CAircraftIcaoCode("A320"), CAirlineIcaoCode("DLH")), reversed.findByIcaoDesignators(CAircraftIcaoCode("A320"), CAirlineIcaoCode("DLH")));
+        compare(view.findByIcaoDesignators(CAircraftIcaoCode(), CAirlineIcaoCode("DLH")), reversed.findByIcaoDesignators(CAircraftIcaoCode(), CAirlineIcaoCode("DLH")));
+        compare(view.findByCombinedType("L2J"), reversed.findByCombinedType("L2J"));
+        compare(view.findByManufacturer("AIRBUS"), reversed.findByManufacturer("AIRBUS"));
+        compare(view.findByVtolFlag(false), reversed.findByVtolFlag(false));
+        compare(view.findByAirlineNamesOrTelephonyDesignator("er"), reversed.findByAirlineNamesOrTelephonyDesignator("er"));
+        compare(view.findByAirlineNamesOrTelephonyDesignator(""), reversed.findByAirlineNamesOrTelephonyDesignator(""));
+        QCOMPARE(view.findFirstByModelStringAliasOrDefault("LH321").getModelString(), reversed.findFirstByModelStringAliasOrDefault("LH321").getModelString());
+
+        // unite and replace keep the list order
+        const CAircraftModelSetView dlh = view.findByIcaoDesignators(CAircraftIcaoCode(), CAirlineIcaoCode("DLH"));
+        const CAircraftModelSetView airbus = view.findByManufacturer("AIRBUS");
+        CAircraftModelList united = dlh.toModelList();
+        for (const CAircraftModel &model : airbus.toModelList())
+        {
+            if (!united.containsModelString(model.getModelString())) { united.push_back(model); }
+        }
+        compare(dlh.unite(airbus), united);
+        CAircraftModelList replaced = airbus.toModelList();
+        replaced.replaceOrAddModelsWithString(dlh.toModelList(), Qt::CaseInsensitive);
+        compare(airbus.replacedOrAdded(dlh), replaced);
+    }
+
+    void CTestAircraftModelSetIndex::compare(const CAircraftModelSetView &view, const CAircraftModelList &models)
+    {
+        QCOMPARE(view.size(), models.sizeInt());
+        QCOMPARE(view.toModelList().getModelStringList(false), models.getModelStringList(false));
+    }
+
+    CAircraftModelList CTestAircraftModelSetIndex::models()
+    {
+        const CAirlineIcaoCode dlh = airline("DLH", "Lufthansa", "LUFTHANSA", 1);
+        const CAirlineIcaoCode baw = airline("BAW", "British Airways", "SPEEDBIRD", 2);
+        const CAirlineIcaoCode ein = airline("EIN", "Aer Lingus", "SHAMROCK", 1);
+        const CAirlineIcaoCode etd = airline("ETD", "Etihad Airways", "ETIHAD");
+        const CAircraftIcaoCode a320 = aircraft("A320", "L2J", "AIRBUS", "A320");
+        const CAircraftIcaoCode a321 = aircraft("A321", "L2J", "AIRBUS", "A320");
+        const CAircraftIcaoCode b738 = aircraft("B738", "L2J", "BOEING", "B737");
+        const CAircraftIcaoCode c172 = aircraft("C172", "L1P", "CESSNA");
+        const CAircraftIcaoCode h60 = aircraft("H60", "H2T", "SIKORSKY", {}, true);
+
+        CAircraftModelList models;
+        models.push_back(model("DLH A320", 1, a320, dlh));
+        CAircraftModel m = model("DLH A321", 2, a321, dlh);
+        m.setModelStringAlias("LH321");
+        m.setDistributor(CDistributor("FSC"));
+        models.push_back(m);
+        m = model("BAW B738", 3, b738, baw);
+        m.setDistributor(CDistributor("XCSL"));
+        models.push_back(m);
+        models.push_back(model("EIN A320", 4, a320, ein));
+        models.push_back(model("C172", -1, c172, CAirlineIcaoCode(), "_CC_WHITE_WHITE"));
+        models.push_back(model("B738 WHITE", 6, b738, CAirlineIcaoCode(), "_CC_WHITE_WHITE"));
+        models.push_back(model("H60", 7, h60, CAirlineIcaoCode()));
+        models.push_back(model("", -1, a320, dlh));
+        m = model("DLH A320 EXCLUDED", 9, a320, dlh);
+        m.setModelMode(CAircraftModel::Exclude);
+        models.push_back(m);
+        models.push_back(model("ETD A320", -1, a320, etd));
+        m = model("DLH A320 FSC", 11, a320, dlh);
+        m.setDistributor(CDistributor("FSC"));
+        models.push_back(m);
+        return models;
+    }
+
+    CAircraftModel CTestAircraftModelSetIndex::model(const QString &modelString, int dbKey, const CAircraftIcaoCode &aircraft, const CAirlineIcaoCode &airline, const QString &livery)
+    {
+        const QString combinedCode = livery.isEmpty() && airline.hasValidDesignator() ? airline.getDesignator() : livery;
+        CAircraftModel model(modelString, CAircraftModel::TypeDatabaseEntry, aircraft, CLivery(combinedCode, airline, "test"));
+        if (dbKey >= 0) { model.setDbKey(dbKey); }
+        return model;
+    }
+
+    CAircraftIcaoCode CTestAircraftModelSetIndex::aircraft(const QString &designator, const QString &combinedType, const QString &manufacturer, const QString &family, bool military)
+    {
+        CAircraftIcaoCode icao(designator, combinedType, manufacturer, "test", "M", true, false, military, 10);
+        icao.setFamily(family);
+        return icao;
+    }
+
+    CAirlineIcaoCode CTestAircraftModelSetIndex::airline(const QString &designator, const QString &name, const QString &telephony, int groupId)
+    {
+        CAirlineIcaoCode icao(designator, name, CCountry("DE", "Germany"), telephony, false, true);
+        icao.setGroupId(groupId);
+        return icao;
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestAircraftModelSetIndex);
+
+#include "testaircraftmodelsetindex.moc"
+
+//! \endcond
@@ -11,7 +11,22 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "blackmisc/simulation/compactsituation.h"
+#include "blackmisc/simulation/interpolationbatch.h"
 #include "blackmisc/simulation/interpolationrenderingsetup.h"
+#include "blackmisc/simulation/interpolatorlinear.h"
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "test.h"
 
 
@@ -19,6 +34,7 @@
 #include <QDebug>
 #include <QTest>
 #include <QtDebug>
+#include <algorithm>
 
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Geo;
@@ -38,6 +54,16 @@ namespace BlackMiscTest
 
         //! Equal situations
         void equalSituationTests();
+
+        //! Compact situation history lookups
+        void compactSituationsTest();
+
+        //! Batch interpolation kernels
+        void batchKernelsTest();
+
+    private:
+        //! Test situation for testing
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
     };
 
     void CTestInterpolatorMisc::setupTests()
@@ -125,6 +151,164 @@ namespace BlackMiscTest
             QVERIFY2(!s1.equalPbhVectorAltitude(s2), "Heading test, expect same PHB/Vector/Altitude");
         }
     }
+
+    void CTestInterpolatorMisc::compactSituationsTest()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+
+        CAircraftSituationList situations;
+        for (int i = 0; i < IRemoteAircraftProvider::MaxSituationsPerCallsign; i++)
+        {
+            situations.push_back(getTestSituation(cs, i, ts, deltaT, offset)); // latest first
+        }
+
+        CCompactSituations compact;
+        compact.setSituations(situations);
+        QCOMPARE(compact.size(), situations.sizeInt());
+        QCOMPARE(compact.adjustedMsSinceEpoch(3), situations[3].getAdjustedMSecsSinceEpoch());
+        QVERIFY(compact.isSameSituations(situations));
+
+        // values in m, m/s and degrees
+        const CompactSituation c3 = CompactSituation::fromSituation(situations[3]);
+        QCOMPARE(c3.adjustedMsSinceEpoch, situations[3].getAdjustedMSecsSinceEpoch());
+        QVERIFY(c3.normalVector == situations[3].getPosition().normalVectorDouble());
+        QVERIFY(qAbs(c3.altitudeM - 3.0) < 1e-6);
+        QVERIFY(qAbs(c3.headingDeg - 30.0) < 1e-6);
+        QVERIFY(qAbs(c3.groundSpeedMps - 30.0 / 3.6) < 1e-6);
+        QVERIFY(c3.hasGroundElevation());
+        QVERIFY(!CompactSituation::fromSituation(CAircraftSituation(cs)).hasGroundElevation());
+        QVERIFY(c3.equalPbhVectorAltitude(compact[3]));
+        QVERIFY(!c3.equalPbhVectorAltitude(compact[2]));
+
+        // lookups as done on the list
+        const qint64 oldest = situations.back().getAdjustedMSecsSinceEpoch();
+        const qint64 latest = situations.front().getAdjustedMSecsSinceEpoch();
+        for (qint64 t = oldest - deltaT; t <= latest + deltaT; t += deltaT / 4)
+        {
+            const auto pivot = std::partition_point(situations.begin(), situations.end(), [ = ](const CAircraftSituation &s) { return s.getAdjustedMSecsSinceEpoch() > t; });
+            QCOMPARE(compact.indexOfFirstNotNewerThanAdjusted(t), static_cast<int>(pivot - situations.begin()));
+
+            const CAircraftSituation before = situations.findObjectBeforeAdjustedOrDefault(t);
+            const int beforeIndex = compact.indexOfFirstBeforeAdjusted(t);
+            if (beforeIndex < 0) { QVERIFY(before == CAircraftSituation()); }
+            else { QCOMPARE(situations[beforeIndex].getAdjustedMSecsSinceEpoch(), before.getAdjustedMSecsSinceEpoch()); }
+        }
+
+        // a new latest situation, the others are kept and their changed values taken over
+        CAircraftSituationList updated = situations;
+        updated.pop_back();
+        updated[2].setGroundElevation(CAltitude({ 100, CLengthUnit::m() }, CAltitude::MeanSeaLevel), CAircraftSituation::Test, true);
+        updated.push_front(getTestSituation(cs, -1, ts, deltaT, offset));
+        compact.update(updated);
+        QVERIFY(compact.isSameSituations(updated));
+        QCOMPARE(compact[0].msSinceEpoch, updated[0].getMSecsSinceEpoch());
+        QVERIFY(compact[0].equalPbhVectorAltitude(CompactSituation::fromSituation(updated[0])));
+        QVERIFY(qAbs(compact[3].groundElevationM - 100.0) < 1e-6);
+        QVERIFY(compact[4].equalPbhVectorAltitude(CompactSituation::fromSituation(updated[4])));
+
+        // scenery offset
+        compact.addAltitudeOffset(-2.0);
+        QVERIFY(qAbs(compact[4].altitudeM - 1.0) < 1e-6);
+
+        compact.clear();
+        QVERIFY(compact.isEmpty());
+        QVERIFY(!compact.isSameSituations(situations));
+        QCOMPARE(compact.indexOfFirstBeforeAdjusted(ts), -1);
+    }
+
+    void CTestInterpolatorMisc::batchKernelsTest()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        const int aircraft = 7; // not a multiple of the SIMD width, covers the scalar tail
+
+        // aircraft n uses the situations n+2 (oldest), n+1, n (latest)
+        InterpolationBatch batch;
+        batch.resize(aircraft);
+        QCOMPARE(batch.size(), aircraft);
+        for (int n = 0; n < aircraft; n++)
+        {
+            batch.setAircraft(n,
+                              CompactSituation::fromSituation(getTestSituation(cs, n + 2, ts, deltaT, offset)),
+                              CompactSituation::fromSituation(getTestSituation(cs, n + 1, ts, deltaT, offset)),
+                              CompactSituation::fromSituation(getTestSituation(cs, n, ts, deltaT, offset)));
+        }
+
+        for (double fraction : { 0.0, 0.3, 0.75, 1.0 })
+        {
+            // the same current time means a different fraction for each aircraft
+            batch.currentTimeMs = static_cast<double>(ts + offset - 2 * deltaT) + fraction * deltaT;
+
+            InterpolationBatchResult linear;
+            InterpolationBatchResult linearScalar;
+            CInterpolatorLinear::interpolateBatch(batch, linear);
+            interpolateLinearBatch(batch, linearScalar, false);
+            QCOMPARE(linear.size(), aircraft);
+            QVERIFY(linear.x == linearScalar.x);
+            QVERIFY(linear.altitude == linearScalar.altitude);
+            QVERIFY(linear.headingDeg == linearScalar.headingDeg);
+
+            for (int n = 0; n < aircraft; n++)
+            {
+                const size_t i = static_cast<size_t>(n);
+                const CAircraftSituation older = getTestSituation(cs, n + 1, ts, deltaT, offset);
+                const CAircraftSituation newer = getTestSituation(cs, n, ts, deltaT, offset);
+                const double tf = linear.timeFraction[i];
+                QVERIFY(tf >= 0.0 && tf <= 1.0);
+
+                // same as the per aircraft interpolation
+                const CInterpolatorLinear::CInterpolant interpolant(older, newer, tf, ts);
+                const CAircraftSituation expected = interpolant.interpolatePositionAndAltitude(older, false);
+                const std::array<double, 3> nv = expected.getPosition().normalVectorDouble();
+                QVERIFY(qAbs(linear.x[i] - nv[0]) < 1e-12);
+                QVERIFY(qAbs(linear.y[i] - nv[1]) < 1e-12);
+                QVERIFY(qAbs(linear.z[i] - nv[2]) < 1e-12);
+                QVERIFY(qAbs(linear.altitude[i] - expected.getAltitude().value(CLengthUnit::m())) < 1e-6);
+                QVERIFY(qAbs(linear.headingDeg[i] - interpolant.pbh().getHeading().value(CAngleUnit::deg())) < 1e-6);
+                QVERIFY(qAbs(linear.bankDeg[i] - interpolant.pbh().getBank().value(CAngleUnit::deg())) < 1e-6);
+                QVERIFY(qAbs(linear.groundSpeed[i] - interpolant.pbh().getGroundSpeed().value(CSpeedUnit::m_s())) < 1e-6);
+            }
+
+            InterpolationBatchResult spline;
+            InterpolationBatchResult splineScalar;
+            CInterpolatorSpline::interpolateBatch(batch, spline);
+            interpolateSplineBatch(batch, splineScalar, false);
+            QVERIFY(spline.x == splineScalar.x);
+            QVERIFY(spline.altitude == splineScalar.altitude);
+            QVERIFY(spline.timeFraction == linear.timeFraction);
+
+            // the spline passes through samples 1 and 2
+            for (int n = 0; n < aircraft; n++)
+            {
+                const size_t i = static_cast<size_t>(n);
+                if (spline.timeFraction[i] <= 0.0) { QVERIFY(qAbs(spline.altitude[i] - batch.samples[1].altitude[i]) < 1e-9); }
+                if (spline.timeFraction[i] >= 1.0) { QVERIFY(qAbs(spline.altitude[i] - batch.samples[2].altitude[i]) < 1e-9); }
+            }
+        }
+    }
+
+    CAircraftSituation CTestInterpolatorMisc::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
+        const CLatitude lat(number, CAngleUnit::deg());
+        const CLongitude lng(180.0 + number, CAngleUnit::deg());
+        const CHeading heading(number * 10, CHeading::True, CAngleUnit::deg());
+        const CAngle bank(number, CAngleUnit::deg());
+        const CAngle pitch(number, CAngleUnit::deg());
+        const CSpeed gs(number * 10, CSpeedUnit::km_h());
+        const CAltitude gndElev({ 0, CLengthUnit::m() }, CAltitude::MeanSeaLevel);
+        const CCoordinateGeodetic c(lat, lng, alt);
+        CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
+        s.setGroundElevation(gndElev, CAircraftSituation::Test);
+        s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
+        s.setTimeOffsetMs(offset);
+        return s;
+    }
 } // namespace
 
 //! main
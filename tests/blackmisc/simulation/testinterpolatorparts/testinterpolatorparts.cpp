@@ -12,9 +12,11 @@
 
 #include "blackmisc/simulation/interpolatorspline.h"
 #include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/timestampringbuffer.h"
 #include "test.h"
 #include <QTest>
 #include <QtDebug>
+#include <algorithm>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -36,6 +38,9 @@ namespace BlackMiscTest
         //! Tests adjusting the ground flag by parts
         void partsToSituationGndFlag();
 
+        //! Ring buffer parts history compared with the list based history
+        void partsHistoryRingBuffer();
+
     private:
         //! Test parts
         static BlackMisc::Aviation::CAircraftParts createTestParts(int number, qint64 ts, qint64 deltaT, bool onGround);
@@ -153,6 +158,80 @@ namespace BlackMiscTest
         QVERIFY2(s1.getOnGroundDetails() == CAircraftSituation::InFromParts, "Wrong details");
     }
 
+    void CTestInterpolatorParts::partsHistoryRingBuffer()
+    {
+        constexpr int Capacity = 10;
+        CTimestampRingBuffer<CAircraftParts, CAircraftPartsList, Capacity> history;
+        CAircraftPartsList list;
+        QVERIFY(history.isEmpty());
+        QVERIFY(history.toList().isEmpty());
+
+        // in order, with small offsets so the offsets need to be adjusted, more values than capacity
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 1000;
+        for (int i = 0; i < 3 * Capacity; i++)
+        {
+            CAircraftParts p = createTestParts(0, ts + i * deltaT, deltaT, i % 2 == 0);
+            p.setTimeOffsetMs(i % 3 == 0 ? 6000 : 2000);
+            history.push_frontKeepLatestFirstAdjustOffset(p);
+            list.push_frontKeepLatestFirstAdjustOffset(p, true, Capacity);
+            QCOMPARE(history.size(), list.sizeInt());
+            QCOMPARE(history.toList(), list);
+        }
+        QVERIFY(history.isFull());
+        QVERIFY(history.toList().isSortedAdjustedLatestFirst());
+
+        // same timestamp replaces, out of order values are sorted in
+        CAircraftParts same = history.front();
+        same.setOnGround(!same.isOnGround());
+        history.push_frontKeepLatestFirstAdjustOffset(same);
+        list.push_frontKeepLatestFirstAdjustOffset(same, true, Capacity);
+        QCOMPARE(history.toList(), list);
+
+        CAircraftParts outOfOrder = createTestParts(0, history[3].getMSecsSinceEpoch() - 1, deltaT, true);
+        outOfOrder.setTimeOffsetMs(history[3].getTimeOffsetMs());
+        history.push_frontKeepLatestFirstAdjustOffset(outOfOrder);
+        list.push_frontKeepLatestFirstAdjustOffset(outOfOrder, true, Capacity);
+        QCOMPARE(history.toList(), list);
+        QCOMPARE(history[4], outOfOrder);
+
+        // lookups by adjusted time, same as the partition the interpolator did on the list
+        const qint64 newest = list.front().getAdjustedMSecsSinceEpoch();
+        const qint64 oldest = list.back().getAdjustedMSecsSinceEpoch();
+        for (qint64 t = oldest - 2 * deltaT; t < newest + 2 * deltaT; t += 250)
+        {
+            const auto pivot = std::partition_point(list.begin(), list.end(), [ = ](const CAircraftParts &p) { return p.getAdjustedMSecsSinceEpoch() > t; });
+            const CAircraftParts expected = pivot == list.end() ? list.back() : *pivot;
+            QCOMPARE(history.findObjectValidAtAdjustedOrDefault(t), expected);
+            QCOMPARE(history.findObjectBeforeAdjustedOrDefault(t), list.findObjectBeforeAdjustedOrDefault(t));
+        }
+
+        // remove outdated, but keep the latest
+        QCOMPARE(history.removeBeforeKeepLatest(history[1].getMSecsSinceEpoch()), Capacity - 2);
+        QCOMPARE(history.size(), 2);
+        QCOMPARE(history.removeBeforeKeepLatest(ts + 100 * deltaT), 1);
+        QCOMPARE(history.size(), 1);
+        history.clear();
+        QVERIFY(history.isEmpty());
+        QCOMPARE(history.findObjectValidAtAdjustedOrDefault(ts), CAircraftParts());
+
+        // provider uses the history
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        for (int i = 0; i < 2 * CRemoteAircraftProviderDummy::MaxPartsPerCallsign; i++)
+        {
+            provider.insertNewAircraftParts(cs, createTestParts(0, ts + i * deltaT, deltaT, true), false);
+        }
+        int count = -1;
+        const CAircraftPartsList parts = provider.remoteAircraftParts(cs);
+        QCOMPARE(parts.sizeInt(), CRemoteAircraftProviderDummy::MaxPartsPerCallsign);
+        QCOMPARE(provider.remoteAircraftPartsValidAt(cs, ts + 75 * deltaT + 1, &count), parts[parts.sizeInt() - 1 - 25]);
+        QCOMPARE(count, CRemoteAircraftProviderDummy::MaxPartsPerCallsign);
+        QCOMPARE(provider.getLatestAircraftParts(cs), parts.front());
+        QCOMPARE(provider.remoteAircraftPartsValidAt(CCallsign("NONE"), ts, &count), CAircraftParts());
+        QCOMPARE(count, 0);
+    }
+
     CAircraftParts CTestInterpolatorParts::createTestParts(int number, qint64 ts, qint64 deltaT, bool onGround)
     {
         CAircraftLights l(true, false, true, false, true, false);
@@ -0,0 +1,152 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/interpolatorspline.h"
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Spline interpolator tests
+    class CTestInterpolatorSpline : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Spline coefficients reused between new situations
+        void splineCoefficientsTest();
+
+        //! Spline coefficients recalculated if a situation is replaced
+        void splineReplacedSituationTest();
+
+    private:
+        //! Test situation for testing
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
+    };
+
+    void CTestInterpolatorSpline::splineCoefficientsTest()
+    {
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        CInterpolatorSpline interpolator(cs, nullptr, nullptr, &provider);
+        interpolator.markAsUnitTest();
+
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+
+        // 50 frames per situation interval, the situations do not change
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        const qint64 step = deltaT / 50;
+        int frames = 0;
+        for (qint64 currentTime = ts - 2 * deltaT + offset; currentTime < ts; currentTime += step)
+        {
+            const CInterpolationResult result = interpolator.getInterpolation(currentTime, setup);
+            QVERIFY(result.getInterpolationStatus().isInterpolated());
+            frames++;
+        }
+
+        const int calculated = interpolator.getCoefficientsCalculated();
+        const int reused = interpolator.getCoefficientsReused();
+        QCOMPARE(calculated + interpolator.getCoefficientsUpdated() + reused, frames);
+        QVERIFY2(calculated >= 1, "Expect calculated coefficients");
+        QVERIFY2(reused > 10 * calculated, "Expect coefficients reused for most frames");
+        QVERIFY(interpolator.getCoefficientsReusedRatio() > 0.9);
+
+        interpolator.resetCoefficientsStatistics();
+        QCOMPARE(interpolator.getCoefficientsReused(), 0);
+    }
+
+    void CTestInterpolatorSpline::splineReplacedSituationTest()
+    {
+        const CCallsign cs("SWIFT");
+        CRemoteAircraftProviderDummy provider;
+        CInterpolatorSpline interpolator(cs, nullptr, nullptr, &provider);
+        interpolator.markAsUnitTest();
+
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign - 1; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+
+        // within the interval towards the latest situation
+        const CInterpolationAndRenderingSetupPerCallsign setup;
+        const qint64 currentTime = ts - deltaT / 2 + offset;
+        QVERIFY(interpolator.getInterpolation(currentTime, setup).getInterpolationStatus().isInterpolated());
+        QVERIFY(interpolator.getInterpolation(currentTime + 10, setup).getInterpolationStatus().isInterpolated());
+        const int calculated = interpolator.getCoefficientsCalculated();
+        QCOMPARE(interpolator.getCoefficientsReused(), 1);
+
+        // latest situation replaced by one with the same timestamp, but another position
+        CAircraftSituation replaced = getTestSituation(cs, 1, ts, deltaT, offset);
+        replaced.setMSecsSinceEpoch(ts);
+        provider.insertNewSituation(replaced);
+        QCOMPARE(provider.remoteAircraftSituation(cs, 0).getLatitude(), replaced.getLatitude());
+
+        QVERIFY(interpolator.getInterpolation(currentTime + 20, setup).getInterpolationStatus().isInterpolated());
+        QCOMPARE(interpolator.getCoefficientsCalculated(), calculated + 1);
+        QCOMPARE(interpolator.getCoefficientsUpdated(), 0);
+    }
+
+    CAircraftSituation CTestInterpolatorSpline::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
+        const CLatitude lat(number, CAngleUnit::deg());
+        const CLongitude lng(180.0 + number, CAngleUnit::deg());
+        const CHeading heading(number * 10, CHeading::True, CAngleUnit::deg());
+        const CAngle bank(number, CAngleUnit::deg());
+        const CAngle pitch(number, CAngleUnit::deg());
+        const CSpeed gs(number * 10, CSpeedUnit::km_h());
+        const CAltitude gndElev({ 0, CLengthUnit::m() }, CAltitude::MeanSeaLevel);
+        const CCoordinateGeodetic c(lat, lng, alt);
+        CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
+        s.setGroundElevation(gndElev, CAircraftSituation::Test);
+        s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
+        s.setTimeOffsetMs(offset);
+        return s;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestInterpolatorSpline);
+
+#include "testinterpolatorspline.moc"
+
+//! \endcond
@@ -0,0 +1,253 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/simulation/compactsituation.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QTest>
+#include <cmath>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Remote aircraft provider tests
+    class CTestRemoteAircraftProvider : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Batch storing of situations
+        void batchStoreTest();
+
+        //! Each change of the situations is a new modification time
+        void situationsLastModifiedTest();
+
+        //! Situation history compared with the list based history
+        void situationHistoryTest();
+
+        //! Compact situations kept next to the situation history
+        void compactSituationsTest();
+
+    private:
+        //! Same values, NaN (null) values are equal
+        static bool equalCompact(const CompactSituation &s1, const CompactSituation &s2);
+
+        //! Test situation for testing
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
+    };
+
+    void CTestRemoteAircraftProvider::batchStoreTest()
+    {
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+        const CCallsignSet callsigns({ "SWIFT1", "SWIFT2", "SWIFT3" });
+
+        // interleaved callsigns, oldest first as received
+        CAircraftSituationList situations;
+        for (int i = IRemoteAircraftProvider::MaxSituationsPerCallsign + 2; i >= 0; i--)
+        {
+            for (const CCallsign &cs : callsigns)
+            {
+                situations.push_back(getTestSituation(cs, i, ts, deltaT, offset));
+            }
+        }
+
+        CRemoteAircraftProviderDummy single;
+        for (const CAircraftSituation &situation : std::as_const(situations)) { single.insertNewSituation(situation); }
+
+        CRemoteAircraftProviderDummy batch;
+        const CAircraftSituationList stored = batch.storeAircraftSituations(situations);
+        QCOMPARE(stored.size(), situations.size());
+
+        for (const CCallsign &cs : callsigns)
+        {
+            const CAircraftSituationList singleSituations = single.remoteAircraftSituations(cs);
+            const CAircraftSituationList batchSituations  = batch.remoteAircraftSituations(cs);
+            QCOMPARE(batchSituations.size(), IRemoteAircraftProvider::MaxSituationsPerCallsign);
+            QCOMPARE(batchSituations.size(), singleSituations.size());
+            for (int i = 0; i < batchSituations.size(); ++i)
+            {
+                QCOMPARE(batchSituations[i].getMSecsSinceEpoch(), singleSituations[i].getMSecsSinceEpoch());
+                QVERIFY(batchSituations[i].getPosition() == singleSituations[i].getPosition());
+            }
+        }
+        QCOMPARE(batch.aircraftSituationsAdded(), single.aircraftSituationsAdded());
+    }
+
+    void CTestRemoteAircraftProvider::situationsLastModifiedTest()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 5000;
+        const qint64 offset = 5000;
+
+        CRemoteAircraftProviderDummy provider;
+        QVERIFY(provider.situationsLastModified(cs) < 0);
+
+        // stored within the same ms, the interpolators still see each change
+        qint64 lastModified = -1;
+        for (int i = 10; i >= 0; i--)
+        {
+            provider.insertNewSituation(getTestSituation(cs, i, ts, deltaT, offset));
+            QVERIFY(provider.situationsLastModified(cs) > lastModified);
+            lastModified = provider.situationsLastModified(cs);
+        }
+
+        // latest situation replaced by one with the same timestamp
+        CAircraftSituation replaced = getTestSituation(cs, 1, ts, deltaT, offset);
+        replaced.setMSecsSinceEpoch(ts);
+        provider.insertNewSituation(replaced);
+        QVERIFY(provider.situationsLastModified(cs) > lastModified);
+        QCOMPARE(provider.remoteAircraftSituation(cs, 0).getLatitude(), replaced.getLatitude());
+    }
+
+    void CTestRemoteAircraftProvider::situationHistoryTest()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 1000;
+        constexpr int Max = IRemoteAircraftProvider::MaxSituationsPerCallsign;
+
+        // first situation prefills the history
+        CRemoteAircraftProviderDummy provider;
+        CAircraftSituationList list;
+        const CAircraftSituation first = getTestSituation(cs, 2 * Max, ts, deltaT, 5000);
+        provider.insertNewSituation(first);
+        list.prefillLatestAdjustedFirst(first, Max);
+        QCOMPARE(provider.remoteAircraftSituationsCount(cs), Max);
+
+        // in order, with changing offsets so the offsets need to be adjusted, more values than capacity
+        for (int i = 2 * Max - 1; i >= 0; i--)
+        {
+            const CAircraftSituation situation = getTestSituation(cs, i, ts, deltaT, i % 3 == 0 ? 6000 : 2000);
+            provider.insertNewSituation(situation);
+            list.push_frontKeepLatestFirstAdjustOffset(situation, true, Max);
+        }
+
+        // same order and offsets, ground flags are guessed by the provider
+        const CAircraftSituationList situations = provider.remoteAircraftSituations(cs);
+        QCOMPARE(situations.size(), list.size());
+        QVERIFY(situations.isSortedAdjustedLatestFirstWithoutNullPositions());
+        for (int i = 0; i < situations.size(); ++i)
+        {
+            QCOMPARE(situations[i].getMSecsSinceEpoch(), list[i].getMSecsSinceEpoch());
+            QCOMPARE(situations[i].getAdjustedMSecsSinceEpoch(), list[i].getAdjustedMSecsSinceEpoch());
+            QVERIFY(situations[i].getPosition() == list[i].getPosition());
+        }
+
+        // access by index without a list copy
+        QCOMPARE(provider.remoteAircraftSituation(cs, 3).getMSecsSinceEpoch(), list[3].getMSecsSinceEpoch());
+        QVERIFY(provider.remoteAircraftSituation(cs, Max).isNull());
+        QVERIFY(provider.remoteAircraftSituation(CCallsign("NONE"), 0).isNull());
+        QCOMPARE(provider.remoteAircraftSituationsCount(CCallsign("NONE")), -1);
+    }
+
+    void CTestRemoteAircraftProvider::compactSituationsTest()
+    {
+        const CCallsign cs("SWIFT");
+        const qint64 ts = 1425000000000;
+        const qint64 deltaT = 1000;
+        constexpr int Max = IRemoteAircraftProvider::MaxSituationsPerCallsign;
+
+        CRemoteAircraftProviderDummy provider;
+        QVERIFY(provider.remoteAircraftSituationsCompact(cs).isEmpty());
+
+        // single and batch stores, changing offsets, a replaced latest situation
+        CAircraftSituationList batch;
+        for (int i = 2 * Max; i >= 0; i--)
+        {
+            const CAircraftSituation situation = getTestSituation(cs, i, ts, deltaT, i % 3 == 0 ? 6000 : 2000);
+            if (i > Max) { provider.insertNewSituation(situation); }
+            else { batch.push_back(situation); }
+        }
+        provider.storeAircraftSituations(batch);
+        CAircraftSituation replaced = getTestSituation(cs, 1, ts, deltaT, 2000);
+        replaced.setMSecsSinceEpoch(ts);
+        provider.insertNewSituation(replaced);
+
+        // ground flags changed in place from parts
+        CAircraftParts parts;
+        parts.setOnGround(true);
+        parts.setMSecsSinceEpoch(ts);
+        parts.setTimeOffsetMs(2000);
+        provider.insertNewAircraftParts(cs, parts, false);
+
+        // same as a full conversion of the situations
+        const CAircraftSituationList situations = provider.remoteAircraftSituations(cs);
+        CCompactSituations expected;
+        expected.setSituations(situations);
+        const CCompactSituations compact = provider.remoteAircraftSituationsCompact(cs);
+        QCOMPARE(compact.size(), Max);
+        QVERIFY(compact.isSameSituations(situations));
+        QCOMPARE(compact[0].onGroundFactor, 1.0);
+        for (int i = 0; i < compact.size(); ++i)
+        {
+            QVERIFY2(equalCompact(compact[i], expected[i]), qPrintable(QString::number(i)));
+        }
+
+        // default implementation of the interface
+        const IRemoteAircraftProvider &base = provider;
+        QVERIFY(base.IRemoteAircraftProvider::remoteAircraftSituationsCompact(cs).isSameSituations(situations));
+    }
+
+    bool CTestRemoteAircraftProvider::equalCompact(const CompactSituation &s1, const CompactSituation &s2)
+    {
+        const auto equal = [](double v1, double v2) { return (std::isnan(v1) && std::isnan(v2)) || v1 == v2; };
+        return s1.msSinceEpoch == s2.msSinceEpoch && s1.adjustedMsSinceEpoch == s2.adjustedMsSinceEpoch && s1.normalVector == s2.normalVector &&
+               equal(s1.altitudeM, s2.altitudeM) && equal(s1.groundElevationM, s2.groundElevationM) && equal(s1.headingDeg, s2.headingDeg) &&
+               equal(s1.pitchDeg, s2.pitchDeg) && equal(s1.bankDeg, s2.bankDeg) && equal(s1.groundSpeedMps, s2.groundSpeedMps) &&
+               equal(s1.onGroundFactor, s2.onGroundFactor);
+    }
+
+    CAircraftSituation CTestRemoteAircraftProvider::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
+    {
+        const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
+        const CLatitude lat(number, CAngleUnit::deg());
+        const CLongitude lng(180.0 + number, CAngleUnit::deg());
+        const CHeading heading(number * 10, CHeading::True, CAngleUnit::deg());
+        const CAngle bank(number, CAngleUnit::deg());
+        const CAngle pitch(number, CAngleUnit::deg());
+        const CSpeed gs(number * 10, CSpeedUnit::km_h());
+        const CAltitude gndElev({ 0, CLengthUnit::m() }, CAltitude::MeanSeaLevel);
+        const CCoordinateGeodetic c(lat, lng, alt);
+        CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
+        s.setGroundElevation(gndElev, CAircraftSituation::Test);
+        s.setMSecsSinceEpoch(ts - deltaT * number); // values in past
+        s.setTimeOffsetMs(offset);
+        return s;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestRemoteAircraftProvider);
+
+#include "testremoteaircraftprovider.moc"
+
+//! \endcond
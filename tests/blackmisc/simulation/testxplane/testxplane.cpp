@@ -10,18 +10,29 @@
 //! \file
 //! \ingroup testblackmisc
 
+#include "blackmisc/simulation/xplane/aircraftmodelloaderxplane.h"
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
+#include "blackmisc/simulation/xplane/sharedtrafficqtfree.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettingsqtfree.inc"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/directoryutils.h"
 #include "test.h"
 
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 #include <QTest>
+#include <thread>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+using namespace BlackMisc::Simulation;
 using namespace BlackMisc::Simulation::Settings;
+using namespace BlackMisc::Simulation::XPlane;
+using namespace BlackMisc::Simulation::XPlane::SharedTraffic;
 
 namespace BlackMiscTest
 {
@@ -38,6 +49,22 @@ namespace BlackMiscTest
         void acfPropertiesTest();
         void xSwiftBusSettingsTest();
         void qtFreeUtils();
+        void sharedTrafficRingOverrun();
+        void sharedTrafficRingTornRead();
+        void incrementalModelLoading();
+
+    private:
+        //! Write a file, directories are created
+        static bool writeFile(const QString &fileName, const QByteArray &content);
+
+        //! Set the modification time of a file
+        static bool touchFile(const QString &fileName, const QDateTime &time);
+
+        //! Unique shared memory name
+        static std::string sharedTrafficName(const char *suffix);
+
+        //! Publish a frame, all records have the frame number as latitude
+        static void publishTrafficFrame(CSharedTrafficRing &writer, std::uint32_t frame, std::uint32_t count);
     };
 
     void CTestXPlane::getFileNameTest()
@@ -178,6 +205,220 @@ namespace BlackMiscTest
         vOut = normalizeValue(-190, -180.0, 180.0);
         QVERIFY2(qFuzzyCompare(170, vOut), "Wrong normalize +-180");
     }
+
+    void CTestXPlane::sharedTrafficRingOverrun()
+    {
+        if (!CSharedTrafficRing::isSupported()) { QSKIP("No shared memory traffic on this platform"); }
+
+        CSharedTrafficRing writer;
+        CSharedTrafficRing reader;
+        QVERIFY(writer.create(sharedTrafficName("overrun")));
+        QVERIFY(reader.open(writer.getName()));
+        QVERIFY(writer.isReaderAttached());
+
+        std::vector<double> frames;
+        const auto handler = [&frames](const PlaneRecord &record)
+        {
+            if (record.handle == 0) { frames.push_back(record.latitudeDeg); }
+        };
+
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::NoNewFrame);
+        publishTrafficFrame(writer, 1, 3);
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::FramesRead);
+        QCOMPARE(frames, std::vector<double>({ 1 }));
+        QVERIFY(!writer.takeResyncRequest());
+
+        // reader fell behind by more than the ring, only the latest frames are read
+        frames.clear();
+        for (std::uint32_t frame = 2; frame <= 6; ++frame) { publishTrafficFrame(writer, frame, 3); }
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::FramesMissed);
+        QCOMPARE(frames, std::vector<double>({ 4, 5, 6 }));
+        QVERIFY(writer.takeResyncRequest());
+        QVERIFY(!writer.takeResyncRequest());
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::NoNewFrame);
+
+        // writer laps the reader while it is reading: frame 8 is overwritten by frame 12 being written
+        frames.clear();
+        for (std::uint32_t frame = 7; frame <= 9; ++frame) { publishTrafficFrame(writer, frame, 3); }
+        bool lapped = false;
+        const auto lappingHandler = [&](const PlaneRecord &record)
+        {
+            handler(record);
+            if (lapped) { return; }
+            lapped = true;
+            publishTrafficFrame(writer, 10, 3);
+            publishTrafficFrame(writer, 11, 3);
+            QVERIFY(writer.beginFrame());
+        };
+        QCOMPARE(reader.readFrames(lappingHandler), CSharedTrafficRing::FramesMissed);
+        QCOMPARE(frames, std::vector<double>({ 7, 9 }));
+        QVERIFY(writer.takeResyncRequest());
+
+        // frame 12 completed without records, reading continues after the lap
+        frames.clear();
+        writer.publishFrame(0);
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::FramesRead);
+        QCOMPARE(frames, std::vector<double>({ 10, 11 }));
+        frames.clear();
+        publishTrafficFrame(writer, 13, 3);
+        QCOMPARE(reader.readFrames(handler), CSharedTrafficRing::FramesRead);
+        QCOMPARE(frames, std::vector<double>({ 13 }));
+
+        reader.close();
+        QVERIFY(!writer.isReaderAttached());
+    }
+
+    void CTestXPlane::sharedTrafficRingTornRead()
+    {
+        if (!CSharedTrafficRing::isSupported()) { QSKIP("No shared memory traffic on this platform"); }
+
+        CSharedTrafficRing writer;
+        CSharedTrafficRing reader;
+        QVERIFY(writer.create(sharedTrafficName("torn")));
+        QVERIFY(reader.open(writer.getName()));
+
+        // the writer overwrites the slots while they are copied, a frame read must never mix records of different frames
+        constexpr std::uint32_t Frames = 20000;
+        constexpr std::uint32_t Count = 64;
+        std::thread writerThread([&writer]
+        {
+            for (std::uint32_t frame = 1; frame <= Frames; ++frame) { publishTrafficFrame(writer, frame, Count); }
+        });
+
+        double frame = 0;
+        std::int32_t nextHandle = 0;
+        int framesRead = 0;
+        int tornRecords = 0;
+        const auto handler = [&](const PlaneRecord &record)
+        {
+            if (record.handle == 0)
+            {
+                if (nextHandle != 0 || record.latitudeDeg <= frame) { tornRecords++; }
+                frame = record.latitudeDeg;
+                framesRead++;
+            }
+            else if (record.handle != nextHandle || record.latitudeDeg != frame || record.longitudeDeg != frame) { tornRecords++; }
+            nextHandle = (record.handle + 1) % static_cast<std::int32_t>(Count);
+        };
+
+        while (frame < Frames)
+        {
+            reader.readFrames(handler);
+            if (tornRecords > 0) { break; }
+        }
+        writerThread.join();
+        reader.readFrames(handler);
+
+        QCOMPARE(tornRecords, 0);
+        QCOMPARE(nextHandle, 0);
+        QCOMPARE(frame, static_cast<double>(Frames));
+        QVERIFY(framesRead > 0);
+    }
+
+    void CTestXPlane::incrementalModelLoading()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString root = dir.filePath("CSL");
+        const QString pkgA = root + "/PkgA/xsb_aircraft.txt";
+        const QString pkgB = root + "/PkgB/xsb_aircraft.txt";
+        const QString acf = root + "/Baron/testaircraft.acf";
+        QVERIFY(writeFile(pkgA, "EXPORT_NAME PKGA\nOBJ8_AIRCRAFT A320_DLH\nOBJ8 SOLID YES PKGA/a320.obj\nICAO A320\n"));
+        QVERIFY(writeFile(root + "/PkgA/a320.obj", "A"));
+        QVERIFY(writeFile(pkgB, "EXPORT_NAME PKGB\nDEPENDENCY PKGA\nOBJ8_AIRCRAFT B738\nOBJ8 SOLID YES PKGA/a320.obj\nICAO B738\n"));
+        QVERIFY(QDir().mkpath(root + "/Baron"));
+        QVERIFY(QFile::copy(CSwiftDirectories::testFilesDirectory() + "/testaircraft.acf", acf));
+
+        CAircraftModelLoaderXPlane loader;
+        loader.setFileIndexFileName(dir.filePath("index.json"));
+        QVERIFY(loader.isIncrementalParsing());
+
+        // first load parses everything
+        CAircraftModelList models = loader.performParsing({ root }, {});
+        QCOMPARE(models.size(), 3);
+        QCOMPARE(loader.m_filesParsed, 3);
+        QCOMPARE(loader.m_filesReused, 0);
+        QVERIFY(QFile::exists(dir.filePath("index.json")));
+        const QStringList modelStrings = models.getModelStringList();
+
+        // nothing changed
+        models = loader.performParsing({ root }, {});
+        QCOMPARE(loader.m_filesParsed, 0);
+        QCOMPARE(loader.m_filesReused, 3);
+        QCOMPARE(models.getModelStringList(), modelStrings);
+
+        // touched with the same content, reused and the index entry gets the new time
+        const QDateTime touched = QFileInfo(pkgA).lastModified().addSecs(-3600);
+        QVERIFY(touchFile(pkgA, touched));
+        models = loader.performParsing({ root }, {});
+        QCOMPARE(loader.m_filesParsed, 0);
+        QCOMPARE(loader.m_filesReused, 3);
+        QCOMPARE(models.getModelStringList(), modelStrings);
+        QCOMPARE(loader.m_fileIndex.find(QFileInfo(pkgA).absoluteFilePath())->lastModifiedMs, QFileInfo(pkgA).lastModified().toMSecsSinceEpoch());
+        QByteArray content;
+        QCOMPARE(loader.m_fileIndex.checkFile(QFileInfo(pkgA), content), CFileIndex::Unchanged);
+
+        // changed package is parsed again
+        QVERIFY(writeFile(pkgB, "EXPORT_NAME PKGB\nDEPENDENCY PKGA\nOBJ8_AIRCRAFT B739_BAW\nOBJ8 SOLID YES PKGA/a320.obj\nICAO B739\n"));
+        models = loader.performParsing({ root }, {});
+        QCOMPARE(loader.m_filesParsed, 1);
+        QCOMPARE(loader.m_filesReused, 2);
+        QCOMPARE(models.size(), 3);
+        QVERIFY(models.containsModelString("PkgB B739_BAW"));
+        QVERIFY(!models.containsModelString("PkgB B738"));
+
+        // a new loader reads the index file
+        CAircraftModelLoaderXPlane reloaded;
+        reloaded.setFileIndexFileName(dir.filePath("index.json"));
+        models = reloaded.performParsing({ root }, {});
+        QCOMPARE(reloaded.m_filesParsed, 0);
+        QCOMPARE(reloaded.m_filesReused, 3);
+        QVERIFY(models.containsModelString("PkgB B739_BAW"));
+
+        // removing the referenced package invalidates the unchanged package referencing it
+        QVERIFY(QDir(root + "/PkgA").removeRecursively());
+        models = reloaded.performParsing({ root }, {});
+        QCOMPARE(reloaded.m_filesParsed, 1);
+        QCOMPARE(reloaded.m_filesReused, 1);
+        QCOMPARE(models.size(), 1);
+        QVERIFY(!reloaded.m_fileIndex.find(QFileInfo(pkgA).absoluteFilePath()));
+        QCOMPARE(reloaded.m_fileIndex.size(), 2);
+    }
+
+    bool CTestXPlane::writeFile(const QString &fileName, const QByteArray &content)
+    {
+        if (!QDir().mkpath(QFileInfo(fileName).absolutePath())) { return false; }
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+        return file.write(content) == content.size();
+    }
+
+    bool CTestXPlane::touchFile(const QString &fileName, const QDateTime &time)
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadWrite)) { return false; }
+        return file.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+    std::string CTestXPlane::sharedTrafficName(const char *suffix)
+    {
+        return QStringLiteral("/swift_testxplane_%1_%2").arg(QCoreApplication::applicationPid()).arg(suffix).toStdString();
+    }
+
+    void CTestXPlane::publishTrafficFrame(CSharedTrafficRing &writer, std::uint32_t frame, std::uint32_t count)
+    {
+        PlaneRecord *records = writer.beginFrame();
+        if (!records) { return; }
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::memset(static_cast<void *>(&records[i]), 0, sizeof(PlaneRecord));
+            records[i].handle = static_cast<std::int32_t>(i);
+            records[i].latitudeDeg = frame;
+            records[i].longitudeDeg = frame;
+            records[i].setFlag(HasPosition, true);
+        }
+        writer.publishFrame(count);
+    }
 }
 
 //! main
@@ -22,6 +22,8 @@ INCLUDEPATH += \
 
 SOURCES += testxplane.cpp
 
+unix:!macx: LIBS += -lrt
+
 DESTDIR = $$DestRoot/bin
 
 load(common_post)
@@ -21,6 +21,8 @@
 #include "blackmisc/collection.h"
 #include "blackmisc/dictionary.h"
 #include "blackmisc/iterator.h"
+#include "blackmisc/jsonarraystreamreader.h"
+#include "blackmisc/lockfree.h"
 #include "blackmisc/range.h"
 #include "blackmisc/registermetadata.h"
 #include "blackmisc/sequence.h"
@@ -33,6 +35,7 @@
 #include <QSet>
 #include <QString>
 #include <QTest>
+#include <QThread>
 #include <QVector>
 #include <QtGlobal>
 #include <algorithm>
@@ -70,6 +73,8 @@ namespace BlackMiscTest
         void dictionaryBasics();
         void timestampList();
         void offsetTimestampList();
+        void spscQueue();
+        void jsonArrayStreamReader();
     };
 
     void CTestContainers::initTestCase()
@@ -424,6 +429,98 @@ namespace BlackMiscTest
             }
         }
     }
+
+    void CTestContainers::spscQueue()
+    {
+        LockFreeSpscQueue<qint64> queue(100);
+        QCOMPARE(queue.capacity(), static_cast<size_t>(128));
+        QVERIFY(queue.isEmpty());
+
+        qint64 v = 0;
+        QVERIFY(!queue.pop(v));
+        for (qint64 i = 0; i < 128; ++i) { QVERIFY(queue.push(i)); }
+        QVERIFY2(!queue.push(128), "Full queue rejects push");
+        QVERIFY(queue.pop(v));
+        QCOMPARE(v, 0LL);
+
+        qint64 batch[200];
+        QCOMPARE(queue.popBatch(batch, 200), static_cast<size_t>(127));
+        QCOMPARE(batch[126], 127LL);
+        QVERIFY(queue.isEmpty());
+
+        // one producer, one consumer, order preserved
+        constexpr qint64 Count = 200000;
+        QThread *producer = QThread::create([&queue]
+        {
+            for (qint64 i = 0; i < Count; ++i)
+            {
+                while (!queue.push(i)) { QThread::yieldCurrentThread(); }
+            }
+        });
+        producer->start();
+
+        qint64 expected = 0;
+        bool ordered = true;
+        while (expected < Count)
+        {
+            const size_t n = queue.popBatch(batch, 200);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (batch[i] != expected++) { ordered = false; }
+            }
+            if (n == 0) { QThread::yieldCurrentThread(); }
+        }
+        producer->wait();
+        delete producer;
+        QVERIFY2(ordered, "Records received in order");
+        QVERIFY(queue.isEmpty());
+    }
+
+    void CTestContainers::jsonArrayStreamReader()
+    {
+        const QByteArray json = R"({ "latest": "2023-01-01 12:00:00", "data": [ {"id": 1, "name": "a\"]}"}, {"id": 2, "nested": {"list": [1, 2, {"x": null}]}}, {"id": 3} ], "restricted": true })";
+
+        // all at once
+        const CJsonArrayStreamReader reader = CJsonArrayStreamReader::fromData(json);
+        QVERIFY(reader.isComplete());
+        QVERIFY(!reader.hasError());
+        QVERIFY(!reader.isTopLevelArray());
+        QCOMPARE(reader.getElementCount(), 3);
+        QCOMPARE(reader.getElement(0).value("name").toString(), QString("a\"]}"));
+        QCOMPARE(reader.getElement(1).value("nested").toObject().value("list").toArray().size(), 3);
+        QCOMPARE(reader.getElement(2).value("id").toInt(), 3);
+        QCOMPARE(reader.getEnvelope().value("latest").toString(), QString("2023-01-01 12:00:00"));
+        QVERIFY(reader.getEnvelope().value("restricted").toBool());
+        QVERIFY(!reader.getEnvelope().contains("data"));
+        QCOMPARE(reader.toJsonArray().size(), 3);
+
+        // byte by byte, as from a network reply
+        CJsonArrayStreamReader chunked;
+        for (const char c : json)
+        {
+            QVERIFY(!chunked.isComplete());
+            chunked.addData(QByteArray(1, c));
+        }
+        QVERIFY(chunked.isComplete());
+        QCOMPARE(chunked.getElementCount(), 3);
+        QCOMPARE(chunked.getElement(0), reader.getElement(0));
+        QCOMPARE(chunked.getElement(1), reader.getElement(1));
+        QCOMPARE(chunked.getEnvelope(), reader.getEnvelope());
+
+        // top level array
+        const CJsonArrayStreamReader array = CJsonArrayStreamReader::fromData("[1, true, \"s\", {}]");
+        QVERIFY(array.isComplete());
+        QVERIFY(array.isTopLevelArray());
+        QCOMPARE(array.getElementCount(), 4);
+        QCOMPARE(array.getElementValue(0).toInt(), 1);
+        QVERIFY(array.getElementValue(1).toBool());
+        QCOMPARE(array.getElementValue(2).toString(), QString("s"));
+
+        // incomplete and malformed
+        QVERIFY(!CJsonArrayStreamReader::fromData(R"({"data": [{"id": 1})").isComplete());
+        QVERIFY(CJsonArrayStreamReader::fromData("<html>PHP error</html>").hasError());
+        QVERIFY(CJsonArrayStreamReader::fromData(R"({"data": [{"id": 1} {"id": 2}]})").hasError());
+    }
 } //namespace
 
 //! main
@@ -14,16 +14,22 @@
  */
 
 #include "blackmisc/registermetadata.h"
+#include "blackmisc/simulation/data/modelbinaryfile.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
+#include "blackmisc/pq/units.h"
 #include "blackmisc/test/testservice.h"
 #include "blackmisc/test/testserviceinterface.h"
 #include "test.h"
 #include <QTest>
 #include <QByteArray>
+#include <cstring>
+#include <limits>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
+using namespace BlackMisc::PhysicalQuantities;
 using namespace BlackMisc::Simulation;
+using namespace BlackMisc::Simulation::Data;
 using namespace BlackMisc::Test;
 
 namespace BlackMiscTest
@@ -39,6 +45,9 @@ namespace BlackMiscTest
 
         //! Test marshaling/unmarshaling
         void marshalUnmarshal();
+
+        //! Binary model container roundtrip
+        void modelBinaryFile();
     };
 
     void CTestDataStream::initTestCase()
@@ -67,6 +76,54 @@ namespace BlackMiscTest
             QVERIFY2(result == testData, "roundtrip marshal/unmarshal compares equal");
         }
     }
+
+    void CTestDataStream::modelBinaryFile()
+    {
+        const CAircraftIcaoCode a320("A320", "L2J");
+        const CLivery livery("DLH", CAirlineIcaoCode("DLH", "Lufthansa", CCountry("DE", "Germany"), "Lufthansa", false, false), "Lufthansa", "white", "blue", false);
+        CAircraftModelList models;
+        for (int i = 0; i < 20; i++)
+        {
+            CAircraftModel model("MODEL " + QString::number(i), CAircraftModel::TypeOwnSimulatorModel, CSimulatorInfo::xplane(), "name", "description", a320, i % 2 ? livery : CLivery());
+            model.setDbKey(i);
+            model.setFileName("/xplane/csl/" + QString::number(i) + ".obj");
+            model.setFileTimestamp(1500000000000 + i);
+            if (i % 3 == 0) { model.setCG(CLength(i, CLengthUnit::ft())); }
+            if (i % 4 == 0) { model.setCallsign(CCallsign("DLH" + QString::number(i))); }
+            models.push_back(model);
+        }
+
+        const QByteArray data = CModelBinaryFile::toBinary(models, 1234);
+        const QByteArray compressed = CModelBinaryFile::toBinary(models, 1234, true);
+        QVERIFY2(compressed.size() < data.size(), "compressed is smaller");
+
+        for (const QByteArray &bytes : { data, compressed })
+        {
+            CModelBinaryFile file;
+            QVERIFY2(file.openData(bytes), "opened");
+            QCOMPARE(file.getTimestamp(), Q_INT64_C(1234));
+            QCOMPARE(file.size(), models.sizeInt());
+            QCOMPARE(file.modelStringAt(5), models[5].getModelString());
+            QVERIFY2(file.toModelList() == models, "roundtrip compares equal");
+            QVERIFY2(file.modelAt(3).getCG() == models[3].getCG(), "CG with unit");
+            QCOMPARE(file.modelAt(7).getFileName(), models[7].getFileName());
+            QCOMPARE(file.modelStrings(), models.getModelStringList(false));
+            QCOMPARE(file.indexOfModelString("model 5"), 5);
+            QCOMPARE(file.indexOfModelString("model 5", Qt::CaseSensitive), -1);
+            QCOMPARE(file.indexOfModelString("MODEL X"), -1);
+        }
+
+        CModelBinaryFile corrupt;
+        QVERIFY2(!corrupt.openData(data.left(data.size() / 2)), "truncated data is rejected");
+        QVERIFY2(!corrupt.isOpen(), "not open");
+
+        // tables size wrapping around when added to the tables offset (header offset 64)
+        QByteArray overflow(data);
+        const quint64 hugeSize = std::numeric_limits<quint64>::max();
+        std::memcpy(overflow.data() + 64, &hugeSize, sizeof(hugeSize));
+        QVERIFY2(!corrupt.openData(overflow), "overflowing size is rejected");
+        QVERIFY2(!corrupt.isOpen(), "not open");
+    }
 }
 
 //! main
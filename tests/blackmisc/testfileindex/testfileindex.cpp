@@ -0,0 +1,171 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/fileindex.h"
+#include "test.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc;
+
+namespace BlackMiscTest
+{
+    //! File index tests
+    class CTestFileIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! States of a file compared with the index
+        void fileStates();
+
+        //! Entries of deleted files are removed
+        void retainOnly();
+
+        //! Save and load
+        void saveAndLoad();
+
+    private:
+        //! Write a file
+        static bool writeFile(const QString &fileName, const QByteArray &content);
+
+        //! Set the modification time of a file
+        static bool touchFile(const QString &fileName, const QDateTime &time);
+
+        //! Index entry for a file
+        static CFileIndex::Entry entry(const QString &fileName, const QString &value);
+    };
+
+    void CTestFileIndex::fileStates()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath("aircraft.cfg");
+        QVERIFY(writeFile(fileName, "[fltsim.0]\ntitle=A320\n"));
+
+        CFileIndex index;
+        QByteArray content;
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content), CFileIndex::NotIndexed);
+        QVERIFY(content.isEmpty());
+
+        index.insert(QFileInfo(fileName).absoluteFilePath(), entry(fileName, "A320"));
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content), CFileIndex::Unchanged);
+        QVERIFY(content.isEmpty());
+        QCOMPARE(index.find(QFileInfo(fileName).absoluteFilePath())->data.value("title").toString(), QStringLiteral("A320"));
+
+        // touched, the content is read and compared
+        QVERIFY(touchFile(fileName, QFileInfo(fileName).lastModified().addSecs(-3600)));
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content), CFileIndex::UnchangedContent);
+        QCOMPARE(content, QByteArray("[fltsim.0]\ntitle=A320\n"));
+        QVERIFY(CFileIndex::isUnchanged(CFileIndex::UnchangedContent));
+
+        // without comparing the content any change of time or size is a change
+        content.clear();
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content, false), CFileIndex::Changed);
+        QVERIFY(content.isEmpty());
+
+        // changed size and content
+        QVERIFY(writeFile(fileName, "[fltsim.0]\ntitle=A320 DLH\n"));
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content), CFileIndex::Changed);
+        QVERIFY(!CFileIndex::isUnchanged(CFileIndex::Changed));
+
+        // same size, changed content
+        index.insert(QFileInfo(fileName).absoluteFilePath(), entry(fileName, "A320 DLH"));
+        QVERIFY(writeFile(fileName, "[fltsim.0]\ntitle=A320 BAW\n"));
+        QVERIFY(touchFile(fileName, QFileInfo(fileName).lastModified().addSecs(-3600)));
+        QCOMPARE(index.checkFile(QFileInfo(fileName), content), CFileIndex::Changed);
+    }
+
+    void CTestFileIndex::retainOnly()
+    {
+        CFileIndex index;
+        index.insert("/a/aircraft.cfg", {});
+        index.insert("/b/aircraft.cfg", {});
+        index.insert("/c/aircraft.cfg", {});
+        QCOMPARE(index.size(), 3);
+
+        QCOMPARE(index.retainOnly({ "/a/aircraft.cfg", "/c/aircraft.cfg", "/d/aircraft.cfg" }), 1);
+        QCOMPARE(index.size(), 2);
+        QVERIFY(index.find("/a/aircraft.cfg"));
+        QVERIFY(!index.find("/b/aircraft.cfg"));
+        QVERIFY(!index.find("/d/aircraft.cfg"));
+
+        QCOMPARE(index.retainOnly({}), 2);
+        QVERIFY(index.isEmpty());
+    }
+
+    void CTestFileIndex::saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath("aircraft.cfg");
+        const QString indexFileName = dir.filePath("index/index.json");
+        QVERIFY(writeFile(fileName, "[fltsim.0]\ntitle=B738\n"));
+
+        CFileIndex index;
+        const QString path = QFileInfo(fileName).absoluteFilePath();
+        index.insert(path, entry(fileName, "B738"));
+        QVERIFY(index.save(indexFileName));
+
+        CFileIndex loaded;
+        QVERIFY(loaded.load(indexFileName));
+        QCOMPARE(loaded.size(), 1);
+        const CFileIndex::Entry *e = loaded.find(path);
+        QVERIFY(e);
+        QCOMPARE(e->lastModifiedMs, index.find(path)->lastModifiedMs);
+        QCOMPARE(e->size, index.find(path)->size);
+        QCOMPARE(e->hash, index.find(path)->hash);
+        QCOMPARE(e->data.value("title").toString(), QStringLiteral("B738"));
+        QByteArray content;
+        QCOMPARE(loaded.checkFile(QFileInfo(fileName), content), CFileIndex::Unchanged);
+
+        // missing and outdated files result in an empty index
+        QVERIFY(!loaded.load(dir.filePath("missing.json")));
+        QVERIFY(loaded.isEmpty());
+        QVERIFY(writeFile(indexFileName, "{\"version\":0,\"files\":[]}"));
+        QVERIFY(!loaded.load(indexFileName));
+        QVERIFY(loaded.isEmpty());
+    }
+
+    bool CTestFileIndex::writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+        return file.write(content) == content.size();
+    }
+
+    bool CTestFileIndex::touchFile(const QString &fileName, const QDateTime &time)
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadWrite)) { return false; }
+        return file.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+    CFileIndex::Entry CTestFileIndex::entry(const QString &fileName, const QString &value)
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) { return {}; }
+        return CFileIndex::createEntry(QFileInfo(fileName), file.readAll(), QJsonObject { { "title", value } });
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestFileIndex);
+
+#include "testfileindex.moc"
+
+//! \endcond
@@ -14,6 +14,7 @@
  */
 
 #include "blackmisc/stringutils.h"
+#include "blackmisc/trigramindex.h"
 #include "test.h"
 
 #include <QTest>
@@ -37,6 +38,7 @@ namespace BlackMiscTest
         void testTimestampParsing();
         void testCodecs();
         void testSimplify();
+        void testTrigramIndex();
     };
 
     void CTestStringUtils::testRemove()
@@ -168,6 +170,56 @@ namespace BlackMiscTest
         QCOMPARE(simplifyAccents(input), output);
         QCOMPARE(simplifyByDecomposition(input), output);
     }
+
+    void CTestStringUtils::testTrigramIndex()
+    {
+        CTrigramIndex index;
+        index.insert(0, "FSX A320 Lufthansa");
+        index.insert(1, "FSX A320NEO Air France");
+        index.insert(2, "AI B738 Ryanair");
+        index.insert(2, "B737-800 Ryanair"); // alias, same id
+        index.insert(3, "A32");
+
+        using Ids = CTrigramIndex::Ids;
+        QCOMPARE(index.size(), 5);
+        QCOMPARE(index.findEqual("fsx a320 LUFTHANSA "), Ids({ 0 }));
+        QCOMPARE(index.findContaining("a320"), Ids({ 0, 1 }));
+        QCOMPARE(index.findContaining("ryanair"), Ids({ 2 }));
+        QCOMPARE(index.findContaining("A3"), Ids({ 0, 1, 3 }));
+        QCOMPARE(index.findStartingWith("fsx"), Ids({ 0, 1 }));
+        QCOMPARE(index.findEndingWith("france"), Ids({ 1 }));
+        QVERIFY2(index.findContaining("A321").isEmpty(), "Trigram not in index");
+
+        QCOMPARE(index.findByWildcard("*320*"), Ids({ 0, 1 }));
+        QCOMPARE(index.findByWildcard("FSX*"), Ids({ 0, 1 }));
+        QCOMPARE(index.findByWildcard("*Ryanair"), Ids({ 2 }));
+        QCOMPARE(index.findByWildcard("FSX*France"), Ids({ 1 }));
+        QCOMPARE(index.findByWildcard("A32"), Ids({ 3 }));
+        QVERIFY2(index.findByWildcard("A320").isEmpty(), "No wildcard means equal");
+
+        const QVector<CTrigramIndex::Match> matches = index.findFuzzy("A320 Lufthansa", 2);
+        QVERIFY2(matches.size() == 2, "Two best matches");
+        QCOMPARE(matches[0].id, 0);
+        QVERIFY2(matches[0].score > matches[1].score, "Ranked by score");
+        QVERIFY2(index.findFuzzy("Lufthanza").front().id == 0, "Typo found");
+        QVERIFY2(index.findFuzzy("xyz").isEmpty(), "Nothing similar");
+
+        // similar texts only if allowed
+        bool similar = true;
+        QCOMPARE(index.findEqualOrMostSimilar("b737-800 ryanair", false, 0.7, &similar), 2);
+        QVERIFY2(!similar, "Equal text");
+        QCOMPARE(index.findEqualOrMostSimilar("FSX A320 Lufthanza", false, 0.7, &similar), -1);
+        QVERIFY2(!similar, "Similar text not allowed");
+        QCOMPARE(index.findEqualOrMostSimilar("FSX A320 Lufthanza", true, 0.7, &similar), 0);
+        QVERIFY2(similar, "Similar text");
+        QCOMPARE(index.findEqualOrMostSimilar("Lufthansa", true, 0.7, &similar), -1);
+        QVERIFY2(!similar, "Not similar enough");
+
+        // 40k strings
+        CTrigramIndex large;
+        for (int i = 0; i < 40000; ++i) { large.insert(i, QStringLiteral("Model %1 Livery %2").arg(i).arg(i % 97)); }
+        QCOMPARE(large.findByWildcard("*Model 1234*").size(), 11);
+    }
 }
 
 //! main
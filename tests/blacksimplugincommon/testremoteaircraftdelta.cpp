@@ -0,0 +1,210 @@
+/* Copyright (C) 2023
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblacksimplugin
+
+#include "plugins/simulator/plugincommon/remoteaircraftdelta.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/transponder.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackSimPlugin::Common;
+
+namespace BlackSimPluginCommonTest
+{
+    //! CRemoteAircraftDelta tests
+    class CTestRemoteAircraftDelta : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Unchanged groups are not sent again
+        void unchanged();
+
+        //! Changes within the tolerances are not sent
+        void tolerances();
+
+        //! Groups are refreshed while all aircraft are updated
+        void refresh();
+
+        //! Disabled, everything is sent
+        void disabled();
+
+        //! Bytes per group, record and callsign
+        void bytes();
+
+    private:
+        //! Situation at position
+        static CAircraftSituation situation(double latDeg, double headingDeg = 90.0, bool onGround = false, const QString &callsign = "DLH123");
+    };
+
+    void CTestRemoteAircraftDelta::unchanged()
+    {
+        CRemoteAircraftDelta delta;
+        const CAircraftSituation s = situation(48.0);
+        const CAircraftParts parts(25);
+        const CTransponder transponder(7000, CTransponder::ModeC);
+
+        delta.beginFrame(false, 1000);
+        QVERIFY(delta.isSending(s));
+        QVERIFY(delta.isSending(s.getCallsign(), parts));
+        QVERIFY(delta.isSending(s.getCallsign(), transponder));
+        delta.finishFrame();
+
+        delta.beginFrame(false, 1100);
+        QVERIFY(!delta.isSending(s));
+        QVERIFY(!delta.isSending(s.getCallsign(), parts));
+        QVERIFY(!delta.isSending(s.getCallsign(), transponder));
+        QVERIFY(delta.isSending(s.getCallsign(), CAircraftParts(50)));
+        QVERIFY(delta.isSending(s.getCallsign(), CTransponder(7000, CTransponder::StateIdent)));
+        delta.finishFrame();
+
+        // everything after a reset
+        delta.reset(s.getCallsign());
+        delta.beginFrame(false, 1200);
+        QVERIFY(delta.isSending(s));
+        delta.finishFrame();
+    }
+
+    void CTestRemoteAircraftDelta::tolerances()
+    {
+        CRemoteAircraftDelta delta;
+        delta.beginFrame(false, 1000);
+        QVERIFY(delta.isSending(situation(48.0)));
+
+        // 1cm are about 9E-8deg latitude
+        QVERIFY(!delta.isSending(situation(48.0 + 4E-8)));
+        QVERIFY(delta.isSending(situation(48.0 + 1E-6)));
+        QVERIFY(!delta.isSending(situation(48.0 + 1E-6, 90.005)));
+        QVERIFY(delta.isSending(situation(48.0 + 1E-6, 90.05)));
+        QVERIFY(delta.isSending(situation(48.0 + 1E-6, 90.05, true)));
+
+        // heading wraps
+        QVERIFY(delta.isSending(situation(48.0, 359.999)));
+        QVERIFY(!delta.isSending(situation(48.0, 0.001)));
+
+        CRemoteAircraftDelta::Tolerances tolerances = delta.getTolerances();
+        tolerances.positionM = 1.0;
+        delta.setTolerances(tolerances);
+        QVERIFY(!delta.isSending(situation(48.0 + 1E-6, 0.001)));
+        delta.finishFrame();
+    }
+
+    void CTestRemoteAircraftDelta::refresh()
+    {
+        CRemoteAircraftDelta delta;
+        const CAircraftSituation s = situation(48.0);
+        delta.beginFrame(true, 1000);
+        QVERIFY(delta.isSending(s));
+        delta.finishFrame();
+
+        delta.beginFrame(true, 1000 + CRemoteAircraftDelta::RefreshMs - 1);
+        QVERIFY(!delta.isSending(s));
+        delta.finishFrame();
+
+        // only refreshed while all aircraft are updated
+        delta.beginFrame(false, 1000 + CRemoteAircraftDelta::RefreshMs);
+        QVERIFY(!delta.isSending(s));
+        delta.finishFrame();
+
+        delta.beginFrame(true, 1000 + CRemoteAircraftDelta::RefreshMs);
+        QVERIFY(delta.isSending(s));
+        delta.finishFrame();
+    }
+
+    void CTestRemoteAircraftDelta::disabled()
+    {
+        CRemoteAircraftDelta delta;
+        delta.setEnabled(false);
+        const CAircraftSituation s = situation(48.0);
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            delta.beginFrame(false, 1000 + frame);
+            QVERIFY(delta.isSending(s));
+            QVERIFY(delta.isSending(s.getCallsign(), CAircraftParts(25)));
+            delta.finishFrame();
+            QCOMPARE(delta.getFrameBytesSaved(), qint64(0));
+        }
+    }
+
+    void CTestRemoteAircraftDelta::bytes()
+    {
+        const CAircraftSituation s = situation(48.0);
+        const CAircraftParts parts(25);
+
+        // groups
+        CRemoteAircraftDelta delta;
+        delta.setWireSizes({ 10, 20, 30 });
+        delta.beginFrame(false, 1000);
+        delta.isSending(s);
+        delta.isSending(s.getCallsign(), parts);
+        delta.finishFrame();
+        QCOMPARE(delta.getFrameBytesSent(), qint64(30));
+        QCOMPARE(delta.getFrameBytesSaved(), qint64(0));
+
+        delta.beginFrame(false, 1100);
+        delta.isSending(s);
+        delta.isSending(s.getCallsign(), CAircraftParts(50));
+        delta.finishFrame();
+        QCOMPARE(delta.getFrameBytesSent(), qint64(20));
+        QCOMPARE(delta.getFrameBytesSaved(), qint64(10));
+
+        // one record per aircraft, whatever it contains
+        CRemoteAircraftDelta ring;
+        ring.setWireSizes({ 0, 0, 0, 96 });
+        ring.beginFrame(false, 1000);
+        ring.isSending(s);
+        ring.isSending(s.getCallsign(), parts);
+        ring.isSending(situation(50.0, 90.0, false, "DLH2"));
+        ring.finishFrame();
+        QCOMPARE(ring.getFrameBytesSent(), qint64(192));
+        QCOMPARE(ring.getFrameBytesSaved(), qint64(0));
+
+        ring.beginFrame(false, 1100);
+        ring.isSending(s);
+        ring.isSending(s.getCallsign(), CAircraftParts(50));
+        ring.isSending(situation(50.0, 90.0, false, "DLH2"));
+        ring.finishFrame();
+        QCOMPARE(ring.getFrameBytesSent(), qint64(96));
+        QCOMPARE(ring.getFrameBytesSaved(), qint64(96));
+
+        // callsign as DBus string, length + 6 characters + NUL
+        CRemoteAircraftDelta keyed;
+        keyed.setWireSizes({ 10, 20, 30, 0, true });
+        keyed.beginFrame(false, 1000);
+        keyed.isSending(s);
+        keyed.finishFrame();
+        QCOMPARE(keyed.getFrameBytesSent(), qint64(10 + 4 + 6 + 1));
+    }
+
+    CAircraftSituation CTestRemoteAircraftDelta::situation(double latDeg, double headingDeg, bool onGround, const QString &callsign)
+    {
+        CAircraftSituation situation(CCallsign(callsign), CCoordinateGeodetic(latDeg, 11.0),
+                                     CHeading(headingDeg, CHeading::True, CAngleUnit::deg()),
+                                     CAngle(2.0, CAngleUnit::deg()), CAngle(0.0, CAngleUnit::deg()),
+                                     CSpeed(250.0, CSpeedUnit::kts()));
+        situation.setAltitude(CAltitude(5000.0, CAltitude::MeanSeaLevel, CLengthUnit::ft()));
+        situation.setOnGround(onGround ? CAircraftSituation::OnGround : CAircraftSituation::NotOnGround);
+        return situation;
+    }
+}
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackSimPluginCommonTest::CTestRemoteAircraftDelta);
+
+#include "testremoteaircraftdelta.moc"
+
+//! \endcond
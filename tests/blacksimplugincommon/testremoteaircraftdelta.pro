@@ -0,0 +1,30 @@
+load(common_pre)
+
+QT += core dbus network xml widgets testlib
+
+TARGET = testremoteaircraftdelta
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blackcore
+CONFIG   += blackgui
+CONFIG   += simulatorplugincommon
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testremoteaircraftdelta.cpp
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
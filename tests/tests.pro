@@ -6,6 +6,8 @@ CONFIG += ordered
 SUBDIRS += blackmisc
 SUBDIRS += blackcore
 SUBDIRS += blackgui
+SUBDIRS += testsimplugincommon
+testsimplugincommon.file = blacksimplugincommon/testremoteaircraftdelta.pro
 
 # testblackmisc.file = blackmisc/testblackmisc.pro
 # testblackcore.file = blackcore/testblackcore.pro